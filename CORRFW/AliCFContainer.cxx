@@ -123,6 +123,35 @@ void AliCFContainer::Fill(const Double_t *var, Int_t istep, Double_t weight)
   fGrid[istep]->Fill(var,weight);
 }
 
+//____________________________________________________________________
+void AliCFContainer::SetFillBufferSize(Int_t size)
+{
+  //
+  // Buffer up to size fills per selection step before filling the grids
+  // (0: no buffering), see AliCFGridSparse::SetFillBufferSize
+  //
+  for (Int_t iStep=0; iStep<fNStep; iStep++) fGrid[iStep]->SetFillBufferSize(size);
+}
+
+//____________________________________________________________________
+void AliCFContainer::FlushFillBuffer() const
+{
+  //
+  // Fill the buffered entries of all the selection steps in the grids
+  //
+  for (Int_t iStep=0; iStep<fNStep; iStep++) fGrid[iStep]->FlushFillBuffer();
+}
+
+//____________________________________________________________________
+void AliCFContainer::SetStorage(AliCFGridSparse::EStorage storage, Long64_t maxDenseCells)
+{
+  //
+  // Select the storage used for the fills of all the selection steps,
+  // see AliCFGridSparse::SetStorage
+  //
+  for (Int_t iStep=0; iStep<fNStep; iStep++) fGrid[iStep]->SetStorage(storage,maxDenseCells);
+}
+
 //____________________________________________________________________
 TH1* AliCFContainer::Project(Int_t istep, Int_t ivar1, Int_t ivar2, Int_t ivar3) const
 {
@@ -62,6 +62,9 @@ class AliCFContainer : public AliCFFrame
   virtual Int_t GetNStep() const {return fNStep;};
   virtual void  SetNStep(Int_t nStep) {fNStep=nStep;}
   virtual void  Fill(const Double_t *var, Int_t istep, Double_t weight=1.) ;
+  virtual void  SetFillBufferSize(Int_t size) ;
+  virtual void  FlushFillBuffer() const ;
+  virtual void  SetStorage(AliCFGridSparse::EStorage storage, Long64_t maxDenseCells=10000000) ;
 
   virtual Float_t  GetOverFlows (Int_t var,Int_t istep,Bool_t excl=kFALSE) const;
   virtual Float_t  GetUnderFlows(Int_t var,Int_t istep,Bool_t excl=kFALSE) const ;
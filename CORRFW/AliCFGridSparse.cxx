@@ -34,6 +34,8 @@
 #include "TH3D.h"
 #include "TAxis.h"
 #include "AliCFUnfolding.h"
+#include "TBuffer.h"
+#include "AliCFSparseFillBuffer.h"
 
 //____________________________________________________________________
 ClassImp(AliCFGridSparse)
@@ -42,7 +44,15 @@ ClassImp(AliCFGridSparse)
 AliCFGridSparse::AliCFGridSparse() : 
   AliCFFrame(),
   fSumW2(kFALSE),
-  fData(0x0)
+  fData(0x0),
+  fFillBufferSize(0),
+  fFillBuffer(0x0),
+  fStorage(kSparseStorage),
+  fMaxDenseCells(10000000),
+  fDense(0x0),
+  fDenseSwitchBins(0),
+  fDenseCells(),
+  fDenseFilled()
 {
   // default constructor
 }
@@ -50,7 +60,15 @@ AliCFGridSparse::AliCFGridSparse() :
 AliCFGridSparse::AliCFGridSparse(const Char_t* name, const Char_t* title) : 
   AliCFFrame(name,title),
   fSumW2(kFALSE),
-  fData(0x0)
+  fData(0x0),
+  fFillBufferSize(0),
+  fFillBuffer(0x0),
+  fStorage(kSparseStorage),
+  fMaxDenseCells(10000000),
+  fDense(0x0),
+  fDenseSwitchBins(0),
+  fDenseCells(),
+  fDenseFilled()
 {
   // default constructor
 }
@@ -58,7 +76,15 @@ AliCFGridSparse::AliCFGridSparse(const Char_t* name, const Char_t* title) :
 AliCFGridSparse::AliCFGridSparse(const Char_t* name, const Char_t* title, Int_t nVarIn, const Int_t * nBinIn) :  
   AliCFFrame(name,title),
   fSumW2(kFALSE),
-  fData(0x0)
+  fData(0x0),
+  fFillBufferSize(0),
+  fFillBuffer(0x0),
+  fStorage(kSparseStorage),
+  fMaxDenseCells(10000000),
+  fDense(0x0),
+  fDenseSwitchBins(0),
+  fDenseCells(),
+  fDenseFilled()
 {
   //
   // main constructor
@@ -74,13 +100,23 @@ AliCFGridSparse::~AliCFGridSparse()
   // destructor
   //
   if (fData) delete fData;
+  if (fFillBuffer) delete fFillBuffer;
+  if (fDense) delete fDense;
 }
 
 //____________________________________________________________________
 AliCFGridSparse::AliCFGridSparse(const AliCFGridSparse& c) :
   AliCFFrame(c),
   fSumW2(kFALSE),
-  fData(0x0)
+  fData(0x0),
+  fFillBufferSize(0),
+  fFillBuffer(0x0),
+  fStorage(kSparseStorage),
+  fMaxDenseCells(10000000),
+  fDense(0x0),
+  fDenseSwitchBins(0),
+  fDenseCells(),
+  fDenseFilled()
 {
   //
   // copy constructor
@@ -104,6 +140,8 @@ void AliCFGridSparse::SetBinLimits(Int_t ivar, Double_t min, Double_t max)
   //
   // set a uniform binning for variable ivar
   //
+  FlushFillBuffer();
+  DeleteDenseAccumulator();
   Int_t nBins = GetNBins(ivar);
   Double_t * array = new Double_t[nBins+1];
   for (Int_t iEdge=0; iEdge<=nBins; iEdge++) array[iEdge] = min + iEdge * (max-min)/nBins ;
@@ -117,6 +155,8 @@ void AliCFGridSparse::SetBinLimits(Int_t ivar, const Double_t *array)
   //
   // setting the arrays containing the bin limits 
   //
+  FlushFillBuffer();
+  DeleteDenseAccumulator();
   fData->SetBinEdges(ivar, array);
 } 
 
@@ -127,8 +167,188 @@ void AliCFGridSparse::Fill(const Double_t *var, Double_t weight)
   // Fill the grid,
   // given a set of values of the input variable, 
   // with weight (by default w=1)
+  // In buffered mode (see SetFillBufferSize) the values are only copied
+  // and filled in the grid when the buffer is flushed
+  // With dense storage (see SetStorage) the fill goes to the dense accumulator
   //
-  fData->Fill(var,weight);
+  if (fStorage!=kSparseStorage && !fDense) {
+    if (fStorage==kDenseStorage || fData->GetNbins()>=fDenseSwitchBins) CreateDenseAccumulator();
+  }
+  if (fDense) {
+    Long64_t cell = fDense->GetBin(var);
+    if (!fDenseFilled.TestBitNumber(cell)) {
+      fDenseFilled.SetBitNumber(cell);
+      fDenseCells.push_back(cell);
+    }
+    fDense->FillBin(cell,weight);
+    return;
+  }
+
+  if (fFillBufferSize<=0) {
+    fData->Fill(var,weight);
+    return;
+  }
+
+  if (!fFillBuffer) fFillBuffer = new AliCFSparseFillBuffer(fData,fFillBufferSize);
+  fFillBuffer->Fill(var,weight);
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::SetFillBufferSize(Int_t size)
+{
+  //
+  // Buffer up to size calls to Fill() before filling the grid (0: no buffering).
+  // The buffer is flushed automatically before any access to the grid content,
+  // when merging and when the grid is written, so the final content is unchanged.
+  //
+  FlushFillBuffer();
+  if (fFillBuffer) delete fFillBuffer;
+  fFillBuffer = 0x0;
+  fFillBufferSize = size>0 ? size : 0;
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::FlushFillBuffer() const
+{
+  //
+  // Fill the buffered entries in the grid, in the order of the Fill() calls
+  // (see AliCFSparseFillBuffer): the content, errors, number of entries and
+  // statistics of the grid are those of the direct fills.
+  //
+  FoldDenseAccumulator();
+  if (fFillBuffer) fFillBuffer->Flush();
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::SetStorage(EStorage storage, Long64_t maxDenseCells)
+{
+  //
+  // Select the storage used for the fills:
+  // kSparseStorage: fills go directly (or through the fill buffer) to the THnSparse
+  // kDenseStorage : fills go to a dense array with one cell per bin (including
+  //                 under/overflows), the filled cells are added to the THnSparse
+  //                 before any access to the content, when merging and when the
+  //                 grid is written.
+  // kAutoStorage  : fills go to the THnSparse until 10% of the cells are filled,
+  //                 then to the dense array
+  // Grids with more than maxDenseCells cells, or with the squared weights summed
+  // (SumW2), stay sparse.
+  //
+  FlushFillBuffer();
+  DeleteDenseAccumulator();
+  fStorage = storage;
+  fMaxDenseCells = maxDenseCells;
+  fDenseSwitchBins = 0;
+  if (fStorage==kSparseStorage || !fData) return;
+
+  Double_t nCells = 1.;
+  for (Int_t iVar=0; iVar<GetNVar(); iVar++) nCells *= GetNBins(iVar)+2;
+  if (nCells > fMaxDenseCells) {
+    AliInfo(Form("%s: %.0f cells, using sparse storage",GetName(),nCells));
+    fStorage = kSparseStorage;
+    return;
+  }
+  if (fStorage==kAutoStorage) fDenseSwitchBins = (Long64_t)TMath::Ceil(0.1*nCells);
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::CreateDenseAccumulator()
+{
+  //
+  // Create the dense accumulator with the binning of the grid.
+  // With errors THnSparse::Fill also sums w*x and w*x*x per axis, which the
+  // folded cells cannot give: such grids fall back to sparse storage.
+  // The buffered sparse fills are flushed first, so that the grid receives
+  // the fills in their original order.
+  //
+  if (fFillBuffer) fFillBuffer->Flush();
+  if (fData->GetCalculateErrors()) {
+    AliInfo(Form("%s: squared weights are summed, using sparse storage",GetName()));
+    fStorage = kSparseStorage;
+    return;
+  }
+
+  const Int_t nVar = GetNVar();
+  Int_t    *nBins = GetNBins();
+  Double_t *xMin  = new Double_t[nVar];
+  Double_t *xMax  = new Double_t[nVar];
+  for (Int_t iVar=0; iVar<nVar; iVar++) {
+    xMin[iVar] = GetAxis(iVar)->GetXmin();
+    xMax[iVar] = GetAxis(iVar)->GetXmax();
+  }
+  fDense = new THnF(Form("%s_dense",GetName()),GetTitle(),nVar,nBins,xMin,xMax);
+  for (Int_t iVar=0; iVar<nVar; iVar++) {
+    if (!GetAxis(iVar)->GetXbins()->GetSize()) continue;
+    fDense->SetBinEdges(iVar,GetAxis(iVar)->GetXbins()->GetArray());
+  }
+  delete [] nBins;
+  delete [] xMin;
+  delete [] xMax;
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::DeleteDenseAccumulator()
+{
+  //
+  // Delete the dense accumulator (its content must have been folded)
+  //
+  if (fDense) delete fDense;
+  fDense = 0x0;
+  fDenseCells.clear();
+  fDenseFilled.Clear();
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::FoldDenseAccumulator() const
+{
+  //
+  // Add the cells of the dense accumulator filled since the last fold to the
+  // THnSparse, in the order of their first fill, and reset them. Without errors
+  // a THnSparse fill only adds to the bin content and counts the entry, so the
+  // grid ends up as with direct fills.
+  //
+  if (!fDense || !fData || fDenseCells.empty()) return;
+
+  Int_t *coord = new Int_t[GetNVar()];
+  for (UInt_t iCell=0; iCell<fDenseCells.size(); iCell++) {
+    const Long64_t cell = fDenseCells[iCell];
+    Double_t content = fDense->GetBinContent(cell,coord);
+    fData->AddBinContent(fData->GetBin(coord,kTRUE),content);
+    fDense->SetBinContent(cell,0.);
+    fDenseFilled.ResetBitNumber(cell);
+  }
+  fData->SetEntries(fData->GetEntries()+fDense->GetEntries());
+  fDense->SetEntries(0.);
+  fDenseCells.clear();
+  delete [] coord;
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::SetGrid(THnSparse* grid)
+{
+  //
+  // Replace the grid content by grid (owned), pending buffered fills are discarded
+  //
+  if (fData) delete fData;
+  fData = grid;
+  if (fFillBuffer) delete fFillBuffer;
+  fFillBuffer = 0x0;
+  DeleteDenseAccumulator();
+  if (fStorage!=kSparseStorage) SetStorage((EStorage)fStorage,fMaxDenseCells);
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::Streamer(TBuffer &R__b)
+{
+  //
+  // Stream an object of class AliCFGridSparse: pending buffered entries are filled before writing
+  //
+  if (R__b.IsReading()) {
+    R__b.ReadClassBuffer(AliCFGridSparse::Class(),this);
+  } else {
+    FlushFillBuffer();
+    R__b.WriteClassBuffer(AliCFGridSparse::Class(),this);
+  }
 }
 
 //___________________________________________________________________
@@ -141,6 +361,7 @@ AliCFGridSparse* AliCFGridSparse::MakeSlice(Int_t nVars, const Int_t* vars, cons
   //
 
   // binning for new grid
+  FlushFillBuffer();
   Int_t* bins = new Int_t[nVars];
   for (Int_t iVar=0; iVar<nVars; iVar++) {
     bins[iVar] = GetNBins(vars[iVar]);
@@ -192,6 +413,7 @@ Float_t AliCFGridSparse::GetEntries() const
   // total entries (including overflows and underflows)
   //
 
+  FlushFillBuffer();
   return fData->GetEntries();
 }
 
@@ -202,6 +424,7 @@ Float_t AliCFGridSparse::GetElement(Long_t index) const
   // Returns content of grid element index 
   //
   
+  FlushFillBuffer();
   return fData->GetBinContent(index);
 }
 //____________________________________________________________________
@@ -210,6 +433,7 @@ Float_t AliCFGridSparse::GetElement(const Int_t *bin) const
   //
   // Get the content in a bin corresponding to a set of bin indexes
   //
+  FlushFillBuffer();
   return fData->GetBinContent(bin);
 
 }  
@@ -220,6 +444,7 @@ Float_t AliCFGridSparse::GetElement(const Double_t *var) const
   // Get the content in a bin corresponding to a set of input variables
   //
 
+  FlushFillBuffer();
   Long_t index = fData->GetBin(var,kFALSE);
   if (index<0) return 0.;
   return fData->GetBinContent(index);
@@ -232,6 +457,7 @@ Float_t AliCFGridSparse::GetElementError(Long_t index) const
   // Returns the error on the content 
   //
 
+  FlushFillBuffer();
   return fData->GetBinError(index);
 }
 //____________________________________________________________________
@@ -240,6 +466,7 @@ Float_t AliCFGridSparse::GetElementError(const Int_t *bin) const
  //
   // Get the error in a bin corresponding to a set of bin indexes
   //
+  FlushFillBuffer();
   return fData->GetBinError(bin);
 
 }  
@@ -250,6 +477,7 @@ Float_t AliCFGridSparse::GetElementError(const Double_t *var) const
   // Get the error in a bin corresponding to a set of input variables
   //
 
+  FlushFillBuffer();
   Long_t index=fData->GetBin(var,kFALSE); //this is the THnSparse index (do not allocate new cells if content is empy)
   if (index<0) return 0.;
   return fData->GetBinError(index);
@@ -261,6 +489,7 @@ void AliCFGridSparse::SetElement(Long_t index, Float_t val)
   //
   // Sets grid element value
   //
+  FlushFillBuffer();
   Int_t* bin = new Int_t[GetNVar()];
   fData->GetBinContent(index,bin); //affects the bin coordinates
   SetElement(bin,val);
@@ -273,6 +502,7 @@ void AliCFGridSparse::SetElement(const Int_t *bin, Float_t val)
   //
   // Sets grid element of bin indeces bin to val
   //
+  FlushFillBuffer();
   fData->SetBinContent(bin,val);
 }
 //____________________________________________________________________
@@ -281,6 +511,7 @@ void AliCFGridSparse::SetElement(const Double_t *var, Float_t val)
   //
   // Set the content in a bin to value val corresponding to a set of input variables
   //
+  FlushFillBuffer();
   Long_t index=fData->GetBin(var,kTRUE); //THnSparse index: allocate the cell
   Int_t *bin = new Int_t[GetNVar()];
   fData->GetBinContent(index,bin); //trick to access the array of bins
@@ -294,6 +525,7 @@ void AliCFGridSparse::SetElementError(Long_t index, Float_t val)
   //
   // Sets grid element iel error to val (linear indexing) in AliCFFrame
   //
+  FlushFillBuffer();
   Int_t *bin = new Int_t[GetNVar()];
   fData->GetBinContent(index,bin);
   SetElementError(bin,val);
@@ -306,6 +538,7 @@ void AliCFGridSparse::SetElementError(const Int_t *bin, Float_t val)
   //
   // Sets grid element error of bin indeces bin to val
   //
+  FlushFillBuffer();
   fData->SetBinError(bin,val);
 }
 //____________________________________________________________________
@@ -314,6 +547,7 @@ void AliCFGridSparse::SetElementError(const Double_t *var, Float_t val)
   //
   // Set the error in a bin to value val corresponding to a set of input variables
   //
+  FlushFillBuffer();
   Long_t index=fData->GetBin(var); //THnSparse index
   Int_t *bin = new Int_t[GetNVar()];
   fData->GetBinContent(index,bin); //trick to access the array of bins
@@ -327,6 +561,8 @@ void AliCFGridSparse::SumW2()
   //
   //set calculation of the squared sum of the weighted entries
   //
+  FlushFillBuffer();
+  DeleteDenseAccumulator();
   if(!fSumW2){
     fData->CalculateErrors(kTRUE); 
   }
@@ -340,6 +576,7 @@ void AliCFGridSparse::Add(const AliCFGridSparse* aGrid, Double_t c)
   //add aGrid to the current one
   //
 
+  FlushFillBuffer();
   if (aGrid->GetNVar() != GetNVar()){
     AliError("Different number of variables, cannot add the grids");
     return;
@@ -356,6 +593,7 @@ void AliCFGridSparse::Add(const AliCFGridSparse* aGrid1, const AliCFGridSparse*
   //Add aGrid1 and aGrid2 and deposit the result into the current one
   //
 
+  FlushFillBuffer();
   if (GetNVar() != aGrid1->GetNVar() || GetNVar() != aGrid2->GetNVar()) {
     AliInfo("Different number of variables, cannot add the grids");
     return;
@@ -375,6 +613,7 @@ void AliCFGridSparse::Multiply(const AliCFGridSparse* aGrid, Double_t c)
   // Multiply aGrid to the current one
   //
 
+  FlushFillBuffer();
   if (aGrid->GetNVar() != GetNVar()) {
     AliError("Different number of variables, cannot multiply the grids");
     return;
@@ -393,6 +632,7 @@ void AliCFGridSparse::Multiply(const AliCFGridSparse* aGrid1, const AliCFGridSpa
   //Multiply aGrid1 and aGrid2 and deposit the result into the current one
   //
 
+  FlushFillBuffer();
   if (GetNVar() != aGrid1->GetNVar() || GetNVar() != aGrid2->GetNVar()) {
     AliError("Different number of variables, cannot multiply the grids");
     return;
@@ -415,6 +655,7 @@ void AliCFGridSparse::Divide(const AliCFGridSparse* aGrid, Double_t c)
   // Divide aGrid to the current one
   //
 
+  FlushFillBuffer();
   if (aGrid->GetNVar() != GetNVar()) {
     AliError("Different number of variables, cannot divide the grids");
     return;
@@ -436,6 +677,7 @@ void AliCFGridSparse::Divide(const AliCFGridSparse* aGrid1, const AliCFGridSpars
   //binomial errors are supported
   //
 
+  FlushFillBuffer();
   if (GetNVar() != aGrid1->GetNVar() || GetNVar() != aGrid2->GetNVar()) {
     AliError("Different number of variables, cannot divide the grids");
     return;
@@ -458,6 +700,8 @@ void AliCFGridSparse::Rebin(const Int_t* group)
   // a given axis has to be divisible by the rebin group.
   //
 
+  FlushFillBuffer();
+  DeleteDenseAccumulator();
   for(Int_t i=0;i<GetNVar();i++){
     if (group[i]!=1) AliInfo(Form(" merging bins along dimension %i in groups of %i bins", i,group[i]));
   }
@@ -465,6 +709,9 @@ void AliCFGridSparse::Rebin(const Int_t* group)
   THnSparse *rebinned =fData->Rebin(group);
   fData->Reset();
   fData = rebinned;
+  if (fFillBuffer) delete fFillBuffer;
+  fFillBuffer = 0x0;
+  if (fStorage!=kSparseStorage) SetStorage((EStorage)fStorage,fMaxDenseCells);
 }
 //____________________________________________________________________
 void AliCFGridSparse::Scale(Long_t index, const Double_t *fact)
@@ -553,6 +800,7 @@ Double_t AliCFGridSparse::GetIntegral() const
   //
   // Get full Integral
   //
+  FlushFillBuffer();
   return fData->ComputeIntegral();  
 } 
 
@@ -564,6 +812,7 @@ Long64_t AliCFGridSparse::Merge(TCollection* list)
   // Returns the number of merged objects (including this).
   //
 
+  FlushFillBuffer();
   if (!list)
     return 0;
   
@@ -603,9 +852,17 @@ void AliCFGridSparse::Copy(TObject& c) const
   //
   // copy function
   //
+  FlushFillBuffer();
   AliCFFrame::Copy(c);
   AliCFGridSparse& target = (AliCFGridSparse &) c;
   target.fSumW2 = fSumW2 ;
+  if (target.fFillBuffer) delete target.fFillBuffer;
+  target.fFillBuffer = 0x0;
+  target.fFillBufferSize = fFillBufferSize;
+  target.DeleteDenseAccumulator();
+  target.fStorage = fStorage;
+  target.fMaxDenseCells = fMaxDenseCells;
+  target.fDenseSwitchBins = fDenseSwitchBins;
   if (fData) {
     target.fData = (THnSparse*)fData->Clone();
   }
@@ -621,6 +878,7 @@ TH1* AliCFGridSparse::Slice(Int_t iVar1, Int_t iVar2, Int_t iVar3, const Double_
   // If useBins=true, varMin and varMax are taken as bin numbers
   // if varmin or varmax point to null, all the range is taken, including over- and underflows
 
+  FlushFillBuffer();
   THnSparse* clone = (THnSparse*)fData->Clone();
   if (varMin != 0x0 && varMax != 0x0) {
     for (Int_t iAxis=0; iAxis<GetNVar(); iAxis++) SetAxisRange(clone->GetAxis(iAxis),varMin[iAxis],varMax[iAxis],useBins);
@@ -746,6 +1004,7 @@ Float_t AliCFGridSparse::GetOverFlows(Int_t ivar, Bool_t exclusive) const
   // Returns overflows in variable ivar
   // Set 'exclusive' to true for an exclusive check on variable ivar
   //
+  FlushFillBuffer();
   Int_t* bin = new Int_t[GetNVar()];
   memset(bin, 0, sizeof(Int_t) * GetNVar());
   Float_t ovfl=0.;
@@ -772,6 +1031,7 @@ Float_t AliCFGridSparse::GetUnderFlows(Int_t ivar, Bool_t exclusive) const
   // Returns exclusive overflows in variable ivar
   // Set 'exclusive' to true for an exclusive check on variable ivar
   //
+  FlushFillBuffer();
   Int_t* bin = new Int_t[GetNVar()];
   memset(bin, 0, sizeof(Int_t) * GetNVar());
   Float_t unfl=0.;
@@ -798,6 +1058,7 @@ void AliCFGridSparse::Smooth() {
   // smoothing function: TO USE WITH CARE
   //
 
+  FlushFillBuffer();
   AliInfo("Your GridSparse is going to be smoothed");
   AliInfo(Form("N TOTAL  BINS : %li",GetNBinsTotal()));
   AliInfo(Form("N FILLED BINS : %li",GetNFilledBins()));
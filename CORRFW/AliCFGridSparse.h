@@ -10,16 +10,24 @@
 
 #include "AliCFFrame.h"
 #include "THnSparse.h"
+#include "THn.h"
 #include "AliLog.h"
 #include "TAxis.h"
+#include "TBits.h"
+#include <vector>
 
 class TH1D;
 class TH2D;
 class TH3D;
+class AliCFSparseFillBuffer;
 
 class AliCFGridSparse : public AliCFFrame
 {
  public:
+  // storage used for the fills: the grid content is always kept in the THnSparse,
+  // with kDenseStorage the fills are accumulated in a dense array folded into it on access
+  enum EStorage {kSparseStorage=0, kDenseStorage, kAutoStorage};
+
   AliCFGridSparse();
   AliCFGridSparse(const Char_t* name, const Char_t* title);
   AliCFGridSparse(const Char_t* name, const Char_t* title, Int_t nVarIn, const Int_t* nBinIn);
@@ -37,7 +45,7 @@ class AliCFGridSparse : public AliCFFrame
   virtual void       GetBinLimits(Int_t ivar, Double_t * array) const ;
   virtual Double_t * GetBinLimits(Int_t ivar) const ;
   virtual Long_t     GetNBinsTotal() const ;
-  virtual Long_t     GetNFilledBins() const {return fData->GetNbins();}
+  virtual Long_t     GetNFilledBins() const {FlushFillBuffer(); return fData->GetNbins();}
   virtual Int_t      GetNBins(Int_t ivar) const {return fData->GetAxis(ivar)->GetNbins();}
   virtual Int_t *    GetNBins() const ;
   virtual Float_t    GetBinCenter(Int_t ivar,Int_t ibin) const ;
@@ -56,6 +64,11 @@ class AliCFGridSparse : public AliCFFrame
   //virtual Int_t      GetBinIndex(Int_t ivar, Int_t ind) const ;
 
   virtual void    Fill(const Double_t *var, Double_t weight=1.);
+  virtual void    SetFillBufferSize(Int_t size);
+  Int_t           GetFillBufferSize() const {return fFillBufferSize;}
+  virtual void    FlushFillBuffer() const;
+  virtual void    SetStorage(EStorage storage, Long64_t maxDenseCells=10000000);
+  EStorage        GetStorage() const {return (EStorage)fStorage;}
   virtual Float_t GetEntries()const;
   virtual Float_t GetElement(Long_t iel)               const; 
   virtual Float_t GetElement(const Int_t *bin)         const; 
@@ -99,8 +112,8 @@ class AliCFGridSparse : public AliCFFrame
   //virtual Double_t GetIntegral(const Double_t *varMin, const Double_t *varMax) const;
   virtual Long64_t Merge(TCollection* list);
 
-  virtual void     SetGrid(THnSparse* grid) {if (fData) delete fData ; fData=grid;}
-  THnSparse   *    GetGrid() const {return fData;}
+  virtual void     SetGrid(THnSparse* grid) ;
+  THnSparse   *    GetGrid() const {FlushFillBuffer(); return fData;}
 
   virtual Float_t GetOverFlows (Int_t var, Bool_t excl=kFALSE) const;
   virtual Float_t GetUnderFlows(Int_t var, Bool_t excl=kFALSE) const;
@@ -123,7 +136,23 @@ class AliCFGridSparse : public AliCFFrame
   Bool_t      fSumW2    ; // Flag to check if calculation of squared weights enabled
   THnSparse  *fData     ; // The data Container: a THnSparse  
 
-  ClassDef(AliCFGridSparse,3);
+  // fill buffer: (variables, weight) tuples waiting to be filled in fData
+  Int_t                  fFillBufferSize ; //! number of tuples kept before flushing (0: direct fill)
+  AliCFSparseFillBuffer *fFillBuffer     ; //! buffered tuples
+
+  // dense fill accumulator
+  Int_t             fStorage        ; //! EStorage used for the fills
+  Long64_t          fMaxDenseCells  ; //! largest number of cells (with under/overflows) for a dense accumulator
+  THnF             *fDense          ; //! dense accumulator, folded into fData by FlushFillBuffer()
+  Long64_t          fDenseSwitchBins; //! number of filled sparse bins from which kAutoStorage fills the dense accumulator
+  mutable std::vector<Long64_t> fDenseCells; //! cells of fDense filled since the last fold, in the order of their first fill
+  mutable TBits     fDenseFilled    ; //! flags the cells listed in fDenseCells
+
+  void     CreateDenseAccumulator();
+  void     DeleteDenseAccumulator();
+  void     FoldDenseAccumulator() const;
+
+  ClassDef(AliCFGridSparse,5);
 };
 
 
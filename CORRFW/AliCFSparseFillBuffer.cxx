@@ -0,0 +1,119 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+//--------------------------------------------------------------------//
+//                                                                    //
+// AliCFSparseFillBuffer Class                                        //
+// Buffer for the fills of a THnSparse. The buffered tuples are       //
+// filled in the order of the Fill() calls, so that the content, the  //
+// errors, the number of entries and the statistics of the histogram  //
+// are the same as with direct fills.                                 //
+//                                                                    //
+//--------------------------------------------------------------------//
+
+#include "AliCFSparseFillBuffer.h"
+#include "THnSparse.h"
+#include "TAxis.h"
+
+//____________________________________________________________________
+ClassImp(AliCFSparseFillBuffer)
+
+//____________________________________________________________________
+AliCFSparseFillBuffer::AliCFSparseFillBuffer() :
+  TObject(),
+  fHisto(0x0),
+  fNVar(0),
+  fSize(0),
+  fNBuffered(0),
+  fBuffer(),
+  fCoord()
+{
+  // default constructor
+}
+
+//____________________________________________________________________
+AliCFSparseFillBuffer::AliCFSparseFillBuffer(THnSparse* histo, Int_t size) :
+  TObject(),
+  fHisto(histo),
+  fNVar(histo ? histo->GetNdimensions() : 0),
+  fSize(size>0 ? size : 1),
+  fNBuffered(0),
+  fBuffer(),
+  fCoord()
+{
+  //
+  // main constructor: buffer up to size fills of histo
+  //
+  fBuffer.resize(fSize*(fNVar+1));
+  fCoord.resize(fSize*fNVar);
+}
+
+//____________________________________________________________________
+void AliCFSparseFillBuffer::Fill(const Double_t *var, Double_t weight)
+{
+  //
+  // Buffer one fill, the buffer is flushed when it is full
+  //
+  if (!fHisto) return;
+  Double_t *entry = &fBuffer[fNBuffered*(fNVar+1)];
+  for (Int_t iVar=0; iVar<fNVar; iVar++) entry[iVar] = var[iVar];
+  entry[fNVar] = weight;
+  if (++fNBuffered >= fSize) Flush();
+}
+
+//____________________________________________________________________
+void AliCFSparseFillBuffer::Flush()
+{
+  //
+  // Fill the buffered tuples in the histogram, in the order of the Fill() calls.
+  // With errors, THnSparse::Fill also sums w*x and w*x*x per axis, so the tuples
+  // are replayed through it. Without errors THnSparse::Fill only finds the bin
+  // and calls FillBin: the bin coordinates are then computed one axis at a time
+  // (directly for fixed-width axes, as TAxis::FindFixBin does) and the bins are
+  // filled with FillBin, which gives the same content, entries and statistics.
+  //
+  if (!fHisto || fNBuffered<=0) return;
+
+  const Int_t nEntries = fNBuffered;
+  const Int_t stride   = fNVar+1;
+  fNBuffered = 0;
+
+  if (fHisto->GetCalculateErrors()) {
+    for (Int_t iEntry=0; iEntry<nEntries; iEntry++) {
+      const Double_t *entry = &fBuffer[iEntry*stride];
+      fHisto->Fill(entry,entry[fNVar]);
+    }
+    return;
+  }
+
+  for (Int_t iVar=0; iVar<fNVar; iVar++) {
+    TAxis *axis = fHisto->GetAxis(iVar);
+    const Bool_t   fixed = (axis->GetXbins()->GetSize()==0);
+    const Int_t    nBins = axis->GetNbins();
+    const Double_t xMin  = axis->GetXmin();
+    const Double_t xMax  = axis->GetXmax();
+    for (Int_t iEntry=0; iEntry<nEntries; iEntry++) {
+      const Double_t x = fBuffer[iEntry*stride+iVar];
+      Int_t bin;
+      if (!fixed)           bin = axis->FindFixBin(x);
+      else if (x < xMin)    bin = 0;
+      else if (!(x < xMax)) bin = nBins+1;
+      else                  bin = 1 + Int_t(nBins*(x-xMin)/(xMax-xMin));
+      fCoord[iEntry*fNVar+iVar] = bin;
+    }
+  }
+  for (Int_t iEntry=0; iEntry<nEntries; iEntry++) {
+    fHisto->FillBin(fHisto->GetBin(&fCoord[iEntry*fNVar],kTRUE),fBuffer[iEntry*stride+fNVar]);
+  }
+}
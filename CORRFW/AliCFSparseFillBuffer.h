@@ -0,0 +1,45 @@
+#ifndef ALICFSPARSEFILLBUFFER_H
+#define ALICFSPARSEFILLBUFFER_H
+//--------------------------------------------------------------------//
+//                                                                    //
+// AliCFSparseFillBuffer Class                                        //
+// Buffer for the fills of a THnSparse: the (variables, weight)       //
+// tuples are kept in a flat array and filled in the histogram in     //
+// their original order when the buffer is full or flushed            //
+//                                                                    //
+//--------------------------------------------------------------------//
+
+#include "TObject.h"
+#include <vector>
+
+class THnSparse;
+
+class AliCFSparseFillBuffer : public TObject
+{
+ public:
+  AliCFSparseFillBuffer();
+  AliCFSparseFillBuffer(THnSparse* histo, Int_t size);
+  virtual ~AliCFSparseFillBuffer() {}
+
+  THnSparse* GetHisto()     const {return fHisto;}
+  Int_t      GetSize()      const {return fSize;}
+  Int_t      GetNBuffered() const {return fNBuffered;}
+
+  void       Fill(const Double_t *var, Double_t weight=1.);
+  void       Flush();
+
+ private:
+  AliCFSparseFillBuffer(const AliCFSparseFillBuffer&);            // not implemented
+  AliCFSparseFillBuffer& operator=(const AliCFSparseFillBuffer&); // not implemented
+
+  THnSparse             *fHisto     ; // histogram filled (not owned)
+  Int_t                  fNVar      ; // number of variables
+  Int_t                  fSize      ; // number of tuples kept before flushing
+  Int_t                  fNBuffered ; // number of tuples in the buffer
+  std::vector<Double_t>  fBuffer    ; // buffered tuples, fNVar+1 values each
+  std::vector<Int_t>     fCoord     ; // bin coordinates of the buffered tuples, fNVar values each
+
+  ClassDef(AliCFSparseFillBuffer,1);
+};
+
+#endif
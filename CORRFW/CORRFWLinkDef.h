@@ -5,7 +5,8 @@
 #pragma link off all functions;
 
 #pragma link C++ class  AliCFFrame+;
-#pragma link C++ class  AliCFGridSparse+;
+#pragma link C++ class  AliCFGridSparse-;
+#pragma link C++ class  AliCFSparseFillBuffer+;
 #pragma link C++ class  AliCFEffGrid+;
 #pragma link C++ class  AliCFDataGrid+;
 #pragma link C++ class  AliCFContainer+;
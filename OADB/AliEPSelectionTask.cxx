@@ -110,6 +110,7 @@ AliAnalysisTaskSE(),
   AliInfo("Event Plane Selection enabled.");
   for(Int_t i = 0; i < 4; ++i) {
      fPhiDist[i] = 0;
+     fPhiWeightDist[i] = 0;
   }
   for(Int_t i = 0; i < 2; ++i) {
      fQDist[i] = 0;
@@ -162,6 +163,7 @@ AliEPSelectionTask::AliEPSelectionTask(const char *name):
   DefineOutput(1, TList::Class());
   for(Int_t i = 0; i < 4; i++) {
      fPhiDist[i] = 0;
+     fPhiWeightDist[i] = 0;
   }
   for(Int_t i = 0; i < 2; ++i) {
      fQDist[i] = 0;
@@ -250,6 +252,7 @@ void AliEPSelectionTask::UserExec(Option_t */*option*/)
 //   fRunNumber = -15;
 
   AliEventplane *esdEP;
+  TVector2 qq;
   TVector2 qq1;
   TVector2 qq2;
   Double_t fRP = 0.; // monte carlo reaction plane angle
@@ -294,11 +297,10 @@ void AliEPSelectionTask::UserExec(Option_t */*option*/)
 
       if (nt>4){
 
-	// qvector full event
-	fQVector = new TVector2(GetQ(esdEP,tracklist));
+	// qvector full event and subevents, in a single pass over the tracks
+	GetQAll(qq, qq1, qq2, tracklist, esdEP);
+	fQVector = new TVector2(qq);
 	fEventplaneQ = fQVector->Phi()/2;
-	// q vector subevents
-	GetQsub(qq1, qq2, tracklist, esdEP);
 	fQsub1 = new TVector2(qq1);
 	fQsub2 = new TVector2(qq2);
 	fQsubRes = (fQsub1->Phi()/2 - fQsub2->Phi()/2);
@@ -388,11 +390,10 @@ void AliEPSelectionTask::UserExec(Option_t */*option*/)
 
       if (NT>4){
 
-	// qvector full event
-	fQVector = new TVector2(GetQ(esdEP,tracklist));
+	// qvector full event and subevents, in a single pass over the tracks
+	GetQAll(qq, qq1, qq2, tracklist, esdEP);
+	fQVector = new TVector2(qq);
 	fEventplaneQ = fQVector->Phi()/2;
-	// q vector subevents
-	GetQsub(qq1, qq2, tracklist, esdEP);
 	fQsub1 = new TVector2(qq1);
 	fQsub2 = new TVector2(qq2);
 	fQsubRes = (fQsub1->Phi()/2 - fQsub2->Phi()/2);
@@ -619,6 +620,92 @@ void AliEPSelectionTask::GetQsub(TVector2 &Q1, TVector2 &Q2, TObjArray* tracklis
   Q2 = mQ[1];
 }
 
+//________________________________________________________________________
+void AliEPSelectionTask::GetQAll(TVector2 &Q, TVector2 &Q1, TVector2 &Q2, TObjArray* tracklist, AliEventplane* EP)
+{
+  // Q vector of the full event and of the two subevents (same as GetQ and
+  // GetQsub) in a single pass over the tracks: weight, cos and sin of the
+  // track are computed only once
+  float mQx=0, mQy=0, mQx1=0, mQy1=0, mQx2=0, mQy2=0;
+  // get recentering values
+  Double_t mean[2], rms[2];
+  Recenter(0, mean);
+  Recenter(1, rms);
+
+  Bool_t splitOK = (fSplitMethod == AliEPSelectionTask::kRandom || fSplitMethod == AliEPSelectionTask::kEta || fSplitMethod == AliEPSelectionTask::kCharge);
+  if (!splitOK) printf("plane resolution determination method not available!\n\n ");
+  Bool_t negID = (fAnalysisInput.CompareTo("AOD")==0) && (fAODfilterbit == 128);
+
+  AliVTrack* track;
+  TRandom2 rn = 0;
+
+  int nt = tracklist->GetEntries();
+  int trackcounter1=0, trackcounter2=0;
+  int idtemp = 0;
+
+  for (Int_t i = 0; i < nt; i++) {
+    track = dynamic_cast<AliVTrack*> (tracklist->At(i));
+    if (!track) continue;
+    Double_t weight = GetWeight(track);
+    Double_t phi = track->Phi();
+    Double_t qx = weight*cos(2*phi)/rms[0];
+    Double_t qy = weight*sin(2*phi)/rms[1];
+    idtemp = track->GetID();
+    if (negID) idtemp = idtemp*(-1) - 1;
+
+    mQx += qx;
+    mQy += qy;
+    if (fSaveTrackContribution){
+      EP->GetQContributionXArray()->AddAt(qx,idtemp);
+      EP->GetQContributionYArray()->AddAt(qy,idtemp);
+    }
+
+    // subevent of the track: 1, 2 or none
+    Int_t sub = 0;
+    if (fSplitMethod == AliEPSelectionTask::kRandom){
+      // splits the track set into 2 random subsets
+      if( trackcounter1 < int(nt/2.) && trackcounter2 < int(nt/2.)){
+        float random = rn.Rndm();
+        sub = (random < .5) ? 1 : 2;
+      }
+      else if( trackcounter1 >= int(nt/2.)) sub = 2;
+      else sub = 1;
+      if (sub == 1) trackcounter1++;
+      else trackcounter2++;
+    } else if (fSplitMethod == AliEPSelectionTask::kEta) {
+      Double_t eta = track->Eta();
+      if (eta > fEtaGap/2.) sub = 1;
+      else if (eta < -1.*fEtaGap/2.) sub = 2;
+    } else if (fSplitMethod == AliEPSelectionTask::kCharge) {
+      Short_t cha = track->Charge();
+      if (cha > 0) sub = 1;
+      else if (cha < 0) sub = 2;
+    }
+
+    if (sub == 1) {
+      mQx1 += qx;
+      mQy1 += qy;
+      if (fSaveTrackContribution){
+        EP->GetQContributionXArraysub1()->AddAt(qx,idtemp);
+        EP->GetQContributionYArraysub1()->AddAt(qy,idtemp);
+      }
+    } else if (sub == 2) {
+      mQx2 += qx;
+      mQy2 += qy;
+      if (fSaveTrackContribution){
+        EP->GetQContributionXArraysub2()->AddAt(qx,idtemp);
+        EP->GetQContributionYArraysub2()->AddAt(qy,idtemp);
+      }
+    }
+  }
+  // apply recenetering
+  Q.Set(mQx-(mean[0]/rms[0]), mQy-(mean[1]/rms[1]));
+  if (splitOK) {
+    Q1.Set(mQx1-(mean[0]/rms[0]), mQy1-(mean[1]/rms[1]));
+    Q2.Set(mQx2-(mean[0]/rms[0]), mQy2-(mean[1]/rms[1]));
+  }
+}
+
 //________________________________________________________________________
 void AliEPSelectionTask::SetPersonalESDtrackCuts(AliESDtrackCuts* trackcuts){
 
@@ -697,6 +784,16 @@ Double_t AliEPSelectionTask::GetPhiWeight(TObject* track1)
   if(track) phiDist = SelectPhiDist(track);
 
   if (fUsePhiWeight && phiDist && track) {
+    // table built in SetPhiWeightTables, unless the distribution changed since
+    for (Int_t i = 0; i < 4; i++) {
+      if (fPhiWeightDist[i] != phiDist) continue;
+      const TArrayD& table = fPhiWeightTable[i];
+      Int_t bin = 1+TMath::FloorNint((track->Phi())*(table.GetSize()-2)/TMath::TwoPi());
+      if (bin < 0) bin = 0;
+      if (bin >= table.GetSize()) bin = table.GetSize()-1;
+      return table[bin];
+    }
+
     Double_t nParticles = phiDist->Integral();
     Double_t nPhibins = phiDist->GetNbinsX();
 
@@ -814,6 +911,29 @@ void AliEPSelectionTask::SetPhiDist()
   AliInfo("No Phi-weights available. All Phi weights set to 1");
   SetUsePhiWeight(kFALSE);
   }
+  SetPhiWeightTables();
+}
+
+//__________________________________________________________________________
+void AliEPSelectionTask::SetPhiWeightTables()
+{
+  // Pre-compute the phi weight of every bin of the phi distributions of the
+  // run, as in GetPhiWeight: the integral and the division are done once
+  // per run instead of once per track
+  for (Int_t i = 0; i < 4; i++) {
+    fPhiWeightDist[i] = fPhiDist[i];
+    if (!fPhiDist[i]) {
+      fPhiWeightTable[i].Set(0);
+      continue;
+    }
+    Double_t nParticles = fPhiDist[i]->Integral();
+    Double_t nPhibins = fPhiDist[i]->GetNbinsX();
+    fPhiWeightTable[i].Set(fPhiDist[i]->GetNbinsX()+2);
+    for (Int_t bin = 0; bin < fPhiWeightTable[i].GetSize(); bin++) {
+      Double_t PhiDistValue = fPhiDist[i]->GetBinContent(bin);
+      fPhiWeightTable[i][bin] = (PhiDistValue > 0) ? nParticles/nPhibins/PhiDistValue : 1.;
+    }
+  }
 }
 
 //__________________________________________________________________________
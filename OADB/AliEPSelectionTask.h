@@ -10,6 +10,7 @@
 //*****************************************************
 
 #include "AliAnalysisTaskSE.h"
+#include <TArrayD.h>
 
 class TFile;
 class TH1F;
@@ -44,6 +45,7 @@ class AliEPSelectionTask : public AliAnalysisTaskSE {
   
   TVector2 GetQ(AliEventplane* EP, TObjArray* event);
   void GetQsub(TVector2& Qsub1, TVector2& Qsub2, TObjArray* event,AliEventplane* EP);
+  void GetQAll(TVector2& Q, TVector2& Qsub1, TVector2& Qsub2, TObjArray* event, AliEventplane* EP);
   Double_t GetWeight(TObject* track1);
   Double_t GetPhiWeight(TObject* track1);
   void Recenter(Int_t var, Double_t * values);
@@ -72,6 +74,7 @@ class AliEPSelectionTask : public AliAnalysisTaskSE {
   TObjArray* GetAODTracksAndMaxID(AliAODEvent* aod, Int_t& maxid);
   void SetOADBandPeriod();
   TH1F* SelectPhiDist(AliVTrack *track);
+  void SetPhiWeightTables();
   TObjArray* GetTracksForLHC11h(AliESDEvent* esd);
 
   TString  fAnalysisInput; 		// "ESD", "AOD"
@@ -100,6 +103,8 @@ class AliEPSelectionTask : public AliAnalysisTaskSE {
   THnSparse *fSparseDist;               //! THn for eta-charge phi-weighting
   TProfile* fQDist[2];			// array of TProfiles with mean+rms for recentering
   TH1F *fHruns;                         // information about runwise statistics of phi-weights
+  TH1F*    fPhiWeightDist[4];		//! phi distributions the weight tables were built from
+  TArrayD  fPhiWeightTable[4];		//! phi weight per bin (incl. under/overflow) of fPhiDist, built once per run
 
   TVector2* fQVector;			//! Q-Vector of the event  
   Double_t* fQContributionX;		//! array of the tracks' contributions to X component of Q-Vector - index = track ID
@@ -119,7 +124,7 @@ class AliEPSelectionTask : public AliAnalysisTaskSE {
   TH2F*	 fHOutDiff;			//! control histogram: Difference of MC RP and EP - only filled if fUseMCRP is true!
   TH2F*  fHOutleadPTPsi;		//! control histogram: emission angle of leading pT track vs EP angle
 
-  ClassDef(AliEPSelectionTask,4); 
+  ClassDef(AliEPSelectionTask,5); 
 };
 
 #endif
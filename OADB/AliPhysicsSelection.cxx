@@ -66,6 +66,7 @@
 //           Michele Floris, CERN
 //-------------------------------------------------------------------------
 #include <vector>
+#include <algorithm>
 
 #include <Riostream.h>
 #include <TH1F.h>
@@ -77,6 +78,7 @@
 #include <TPRegexp.h>
 #include <TParameter.h>
 #include <TInterpreter.h>
+#include <TMath.h>
 
 #if ROOT_VERSION_CODE >= ROOT_VERSION(6,3,0)
 #include <v5/TFormula.h>
@@ -91,6 +93,7 @@
 
 #include "AliVEvent.h"
 #include "AliESDEvent.h"
+#include "AliESDRun.h"
 #include "AliAnalysisTaskSE.h"
 #include "AliAnalysisManager.h"
 #include "TPRegexp.h"
@@ -111,6 +114,26 @@
 
 class StringToRegexp : public std::map<std::string, TPRegexp> {};
 
+// Requirements of one trigger class string (see CheckTriggerClass) resolved
+// into trigger class mask bits for the classes of the current run
+struct TriggerClassMask {
+  std::vector<ULong64_t> fRequired;  // one (first 50, next 50) mask pair per required token
+  ULong64_t fRejected[2];            // classes which must not be present
+  std::vector<Int_t> fBCs;           // allowed bunch crossings, empty if no requirement
+  UInt_t fReturnCode;                // returned bit word
+  Int_t fTriggerLogic;               // index of the trigger logic
+};
+class TriggerClassMasks : public std::vector<TriggerClassMask> {};
+
+namespace {
+  Int_t ParseInt(const char*& str) {
+    Int_t ret = 0;
+    while (*str && *str != ' ')
+      ret = 10 * ret + (*str++ - '0');
+    return ret;
+  }
+}
+
 ClassImp(AliPhysicsSelection)
 
 AliPhysicsSelection::AliPhysicsSelection() :
@@ -132,7 +155,9 @@ fPSOADB(0),
 fFillOADB(0),
 fTriggerOADB(0),
 fTriggerToFormula(new StringToFormula()),
-fTriggerToRegexp(new StringToRegexp())
+fTriggerToRegexp(new StringToRegexp()),
+fClassMasks(new TriggerClassMasks()),
+fClassMasksRun(-1)
 {
   // constructor
   fCollTrigClasses.SetOwner(1);
@@ -162,7 +187,9 @@ AliPhysicsSelection::AliPhysicsSelection(const char *name) :
  fFillOADB(0),
  fTriggerOADB(0),
  fTriggerToFormula(new StringToFormula()),
- fTriggerToRegexp(new StringToRegexp())
+ fTriggerToRegexp(new StringToRegexp()),
+ fClassMasks(new TriggerClassMasks()),
+ fClassMasksRun(-1)
  {
    // constructor
    fCollTrigClasses.SetOwner(1);
@@ -179,17 +206,17 @@ AliPhysicsSelection::~AliPhysicsSelection(){
   if (fTriggerOADB)  delete fTriggerOADB;
   delete fTriggerToFormula;
   delete fTriggerToRegexp;
+  delete fClassMasks;
 }
 
-UInt_t AliPhysicsSelection::CheckTriggerClass(const AliVEvent* event, const char* trigger, Int_t& triggerLogic) const {
+UInt_t AliPhysicsSelection::CheckTriggerClass(const AliVEvent* event, const TString& classes, const char* trigger, Int_t& triggerLogic) const {
   // checks if the given trigger class(es) are found for the current event
   // format of trigger: +TRIGGER1,TRIGGER1b,TRIGGER1c -TRIGGER2 [#XXX] [&YY] [*ZZ]
   //   requires one out of TRIGGER1,TRIGGER1b,TRIGGER1c and rejects TRIGGER2
   //   in bunch crossing XXX
   //   if successful, YY is returned (for association between entry in fCollTrigClasses and AliVEvent::EOfflineTriggerTypes)
   //   triggerLogic is filled with ZZ, defaults to 0
-
-  TString classes = event->GetFiredTriggerClasses();
+  // classes are the fired trigger classes of the event
 
   Bool_t foundBCRequirement = kFALSE;
   Bool_t foundCorrectBC = kFALSE;
@@ -199,15 +226,6 @@ UInt_t AliPhysicsSelection::CheckTriggerClass(const AliVEvent* event, const char
 
   AliDebug(AliLog::kDebug+1, Form("Processing event with triggers %s", classes.Data()));
 
-  struct Util {
-    static Int_t atoi(const char*& str) {
-      Int_t ret = 0;
-      while (*str && *str != ' ')
-        ret = 10 * ret + (*str++ - '0');
-      return ret;
-    }
-  };
-
   std::string str;
   while (true) {
     // finished
@@ -234,19 +252,19 @@ UInt_t AliPhysicsSelection::CheckTriggerClass(const AliVEvent* event, const char
     if (*trigger == '#') {
       foundBCRequirement = kTRUE;
 
-      if (event->GetBunchCrossNumber() == Util::atoi(++trigger))
+      if (event->GetBunchCrossNumber() == ParseInt(++trigger))
         foundCorrectBC = kTRUE;
 
       continue;
     }
     // return value
     if (*trigger == '&') {
-      returnCode = Util::atoi(++trigger);
+      returnCode = ParseInt(++trigger);
       continue;
     }
     // triggerLogic value
     if (*trigger == '*') {
-      triggerLogicLocal = Util::atoi(++trigger);
+      triggerLogicLocal = ParseInt(++trigger);
       continue;
     }
 
@@ -259,17 +277,101 @@ UInt_t AliPhysicsSelection::CheckTriggerClass(const AliVEvent* event, const char
   return returnCode;
 }
 
+Bool_t AliPhysicsSelection::InitializeClassMasks(const AliVEvent* event){
+  // Resolves the requirements of the collision and background trigger class
+  // strings into trigger class mask bits, using the class names of the run.
+  // The fired classes string of an ESD is built from the same class names and
+  // mask, a class requirement is then a few bitwise operations on the mask.
+  // Returns kFALSE (and CheckTriggerClass is used) if the class names are not
+  // available, e.g. for AODs.
+
+  fClassMasks->clear();
+  fClassMasksRun = fCurrentRun;
+
+  if (event->GetDataLayoutType() != AliVEvent::kESD) return kFALSE;
+  const AliESDRun* esdRun = static_cast<const AliESDEvent*>(event)->GetESDRun();
+  if (!esdRun) return kFALSE;
+
+  Int_t nColl = fCollTrigClasses.GetEntries();
+  Int_t nBG   = fBGTrigClasses.GetEntries();
+  std::string str;
+  for (Int_t i=0; i<nColl+nBG; i++) {
+    const char* trigger = i<nColl ? fCollTrigClasses.At(i)->GetName() : fBGTrigClasses.At(i-nColl)->GetName();
+
+    TriggerClassMask classMask;
+    classMask.fRejected[0] = classMask.fRejected[1] = 0;
+    classMask.fReturnCode = AliVEvent::kUserDefined;
+    classMask.fTriggerLogic = 0;
+
+    while (*trigger) {
+      if (*trigger == '+' || *trigger == '-') {
+        Bool_t required = (*trigger == '+');
+        trigger++;
+        const char* begin = trigger;
+        while (*trigger && *trigger != ' ')
+          trigger++;
+        str.assign(begin, trigger);
+
+        // the class names contain no spaces, the regexp matches the fired
+        // classes string if and only if it matches one of the fired classes
+        auto& re = FindRegexp(str);
+        ULong64_t mask[2] = {0, 0};
+        for (Int_t iclass=0; iclass<TMath::Min((Int_t) AliESDRun::kNTriggerClasses, 100); iclass++) {
+          const char* name = esdRun->GetTriggerClass(iclass);
+          if (!name || !*name) continue;
+          if (re.Match(name, "", 0, 1)) mask[iclass/50] |= (1ull << (iclass%50));
+        }
+        if (required) {
+          classMask.fRequired.push_back(mask[0]);
+          classMask.fRequired.push_back(mask[1]);
+        } else {
+          classMask.fRejected[0] |= mask[0];
+          classMask.fRejected[1] |= mask[1];
+        }
+        continue;
+      }
+      if (*trigger == '#') { classMask.fBCs.push_back(ParseInt(++trigger));   continue; }
+      if (*trigger == '&') { classMask.fReturnCode = ParseInt(++trigger);     continue; }
+      if (*trigger == '*') { classMask.fTriggerLogic = ParseInt(++trigger);   continue; }
+      trigger++;
+    }
+    fClassMasks->push_back(classMask);
+  }
+  return kTRUE;
+}
+
+UInt_t AliPhysicsSelection::CheckTriggerClassMask(const AliVEvent* event, Int_t i, Int_t& triggerLogic) const {
+  // same as CheckTriggerClass for the i-th trigger class, using the masks of InitializeClassMasks
+
+  const TriggerClassMask& classMask = (*fClassMasks)[i];
+  const AliVHeader* header = event->GetHeader();
+  ULong64_t mask[2] = {header->GetTriggerMask(), header->GetTriggerMaskNext50()};
+
+  for (size_t j=0; j<classMask.fRequired.size(); j+=2)
+    if (!(mask[0] & classMask.fRequired[j]) && !(mask[1] & classMask.fRequired[j+1])) return kFALSE;
+  if ((mask[0] & classMask.fRejected[0]) || (mask[1] & classMask.fRejected[1])) return kFALSE;
+  if (!classMask.fBCs.empty() &&
+      std::find(classMask.fBCs.begin(), classMask.fBCs.end(), (Int_t) event->GetBunchCrossNumber()) == classMask.fBCs.end())
+    return kFALSE;
+
+  triggerLogic = classMask.fTriggerLogic;
+  return classMask.fReturnCode;
+}
+
 /// Evaluate if the given event fulfills a given trigger logic
 ///
 /// \param event Pointer to the current event
 /// \param triggerAnalysis Pointer to the TriggerAnlysis class
 /// \param triggerLogic Describing trigger logic; e.g. "V0A && V0C && ZDCTime && !TPCHVdip"
 /// \param offline Offline analysis(?)
+/// \param triggerCache Decisions of the triggers already evaluated for this event, -1 if not yet
+///        evaluated; indexed by trigger + kStartOfFlags for the offline triggers. Can be 0.
 ///
 /// \return True if the given event matches the trigger logic
 Bool_t AliPhysicsSelection::EvaluateTriggerLogic(const AliVEvent* event,
 						 AliTriggerAnalysis* triggerAnalysis,
-						 const char* triggerLogic, Bool_t offline){
+						 const char* triggerLogic, Bool_t offline,
+						 Int_t* triggerCache){
   auto& formula_and_bits = FindForumla(triggerLogic);
   auto& trg_formula = formula_and_bits.first;
   auto& bits = formula_and_bits.second;
@@ -280,7 +382,13 @@ Bool_t AliPhysicsSelection::EvaluateTriggerLogic(const AliVEvent* event,
   for (size_t i = 0; i < bits.size(); ++i) {
     typedef AliTriggerAnalysis::Trigger Trigger;
     Trigger bit = static_cast<Trigger>(bits[i] | offline_flag);
-    paras[i] = triggerAnalysis->EvaluateTrigger(event, bit);
+    if (!triggerCache || bits[i] >= AliTriggerAnalysis::kStartOfFlags) {
+      paras[i] = triggerAnalysis->EvaluateTrigger(event, bit);
+      continue;
+    }
+    Int_t& decision = triggerCache[bits[i] + (offline ? AliTriggerAnalysis::kStartOfFlags : 0)];
+    if (decision < 0) decision = triggerAnalysis->EvaluateTrigger(event, bit);
+    paras[i] = decision;
   }
   Double_t dummy_val[] = {0};
   return trg_formula.EvalPar(dummy_val, paras.data());
@@ -305,18 +413,30 @@ UInt_t AliPhysicsSelection::IsCollisionCandidate(const AliVEvent* event){
   UInt_t accept = 0;
   Int_t nColl = fCollTrigClasses.GetEntries();
   Int_t nBG   = fBGTrigClasses.GetEntries();
+
+  if (fClassMasksRun != fCurrentRun) InitializeClassMasks(event);
+  Bool_t useClassMasks = ((Int_t) fClassMasks->size() == nColl+nBG);
+  TString classes = event->GetFiredTriggerClasses();
+
+  // The trigger analysis objects of all classes are configured identically
+  // (see Initialize), each online and offline trigger is evaluated once per
+  // event and the decision is shared by all collision and background classes
+  Int_t triggerCache[2*AliTriggerAnalysis::kStartOfFlags];
+  std::fill_n(triggerCache, 2*AliTriggerAnalysis::kStartOfFlags, -1);
+
   for (Int_t i=0; i<nColl+nBG; i++) {
     const char* triggerClass = i<nColl ? fCollTrigClasses.At(i)->GetName() : fBGTrigClasses.At(i-nColl)->GetName();
     AliDebug(AliLog::kDebug+1, Form("Processing trigger class %s", triggerClass));
     
     AliTriggerAnalysis* triggerAnalysis = static_cast<AliTriggerAnalysis*> (fTriggerAnalysis.At(i));
-    triggerAnalysis->FillTriggerClasses(event);
+    triggerAnalysis->FillTriggerClasses(classes);
     
     Int_t triggerLogic = 0;
-    UInt_t singleTriggerResult = CheckTriggerClass(event, triggerClass, triggerLogic);
+    UInt_t singleTriggerResult = useClassMasks ? CheckTriggerClassMask(event, i, triggerLogic)
+                                               : CheckTriggerClass(event, classes, triggerClass, triggerLogic);
     if (!singleTriggerResult) continue;
-    Bool_t onlineDecision  = EvaluateTriggerLogic(event, triggerAnalysis, fPSOADB->GetHardwareTrigger(triggerLogic), kFALSE);
-    Bool_t offlineDecision = EvaluateTriggerLogic(event, triggerAnalysis, fPSOADB->GetOfflineTrigger(triggerLogic), kTRUE);
+    Bool_t onlineDecision  = EvaluateTriggerLogic(event, triggerAnalysis, fPSOADB->GetHardwareTrigger(triggerLogic), kFALSE, triggerCache);
+    Bool_t offlineDecision = EvaluateTriggerLogic(event, triggerAnalysis, fPSOADB->GetOfflineTrigger(triggerLogic), kTRUE, triggerCache);
     triggerAnalysis->FillHistograms(event,onlineDecision,offlineDecision);
     if (!onlineDecision) continue;
     if (!offlineDecision) continue;
@@ -45,6 +45,7 @@ class AliOADBFillingScheme;
 class AliOADBTriggerAnalysis;
 class TPRegexp;
 class StringToRegexp;
+class TriggerClassMasks;
 
 typedef std::pair<R5TFormula, std::vector<AliTriggerAnalysis::Trigger>> FormulaAndBits;
 typedef std::map<std::string, FormulaAndBits> StringToFormula;
@@ -100,8 +101,10 @@ public:
   void ReadOCDB(Bool_t val) { fReadOCDB=val; }
   Bool_t IsMC() const { return fMC; }
 protected:
-  UInt_t CheckTriggerClass(const AliVEvent* event, const char* trigger, Int_t& triggerLogic) const;
-  Bool_t EvaluateTriggerLogic(const AliVEvent* event, AliTriggerAnalysis* triggerAnalysis, const char* triggerLogic, Bool_t offline);
+  UInt_t CheckTriggerClass(const AliVEvent* event, const TString& classes, const char* trigger, Int_t& triggerLogic) const;
+  Bool_t InitializeClassMasks(const AliVEvent* event);
+  UInt_t CheckTriggerClassMask(const AliVEvent* event, Int_t i, Int_t& triggerLogic) const;
+  Bool_t EvaluateTriggerLogic(const AliVEvent* event, AliTriggerAnalysis* triggerAnalysis, const char* triggerLogic, Bool_t offline, Int_t* triggerCache = 0);
   const char * GetTriggerString(TObjString * obj);
 
   TString fPassName;          // pass name for current run
@@ -128,7 +131,10 @@ protected:
   StringToRegexp* fTriggerToRegexp; //!
   TPRegexp& FindRegexp(const std::string& triggers) const;
 
-  ClassDef(AliPhysicsSelection, 24)
+  TriggerClassMasks* fClassMasks; //! trigger class requirements resolved into class mask bits
+  Int_t fClassMasksRun;           //! run for which fClassMasks were resolved
+
+  ClassDef(AliPhysicsSelection, 25)
 private:
   AliPhysicsSelection(const AliPhysicsSelection&);
   AliPhysicsSelection& operator=(const AliPhysicsSelection&);
@@ -1624,10 +1624,16 @@ void AliTriggerAnalysis::SaveHistograms() const {
 //-------------------------------------------------------------------------------------------------
 void AliTriggerAnalysis::FillTriggerClasses(const AliVEvent* event){
   // fills trigger classes map
-  TParameter<Long64_t>* count = dynamic_cast<TParameter<Long64_t>*> (fTriggerClasses->GetValue(event->GetFiredTriggerClasses().Data()));
+  FillTriggerClasses(event->GetFiredTriggerClasses());
+}
+
+//-------------------------------------------------------------------------------------------------
+void AliTriggerAnalysis::FillTriggerClasses(const TString& firedClasses){
+  // fills trigger classes map with the fired trigger classes of the event
+  TParameter<Long64_t>* count = dynamic_cast<TParameter<Long64_t>*> (fTriggerClasses->GetValue(firedClasses.Data()));
   if (!count) {
-    count = new TParameter<Long64_t>(event->GetFiredTriggerClasses(), 0);
-    fTriggerClasses->Add(new TObjString(event->GetFiredTriggerClasses().Data()), count);
+    count = new TParameter<Long64_t>(firedClasses, 0);
+    fTriggerClasses->Add(new TObjString(firedClasses.Data()), count);
   }
   count->SetVal(count->GetVal() + 1);
 }
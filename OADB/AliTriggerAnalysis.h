@@ -85,6 +85,7 @@ public:
   
   void FillHistograms(const AliVEvent* event, Bool_t onlineDecision, Bool_t offlineDecision);
   void FillTriggerClasses(const AliVEvent* event);
+  void FillTriggerClasses(const TString& firedClasses);
   
   void SetSPDGFOEfficiency(TH1F* hist) { fSPDGFOEfficiency = hist; }
   void SetDoFMD(Bool_t flag = kTRUE) {fDoFMD = flag;}
@@ -20,11 +20,14 @@
 #include "TBrowser.h"
 #include "TFormula.h"
 #include "RVersion.h"
+#include <cctype>
+#include <cstdlib>
 
 ClassImp(AliMultEstimator);
 //________________________________________________________________
 AliMultEstimator::AliMultEstimator() :
   TNamed(), fDefinition(""), fIsInteger(kFALSE), fValue(0), fMean(0), fPercentile(0), fFormula(0),
+fIsCompiled(kFALSE), fOffset(0), fTermIndex(), fTermWeight(),
 fkUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100.0)
 {
   // Constructor
@@ -32,6 +35,7 @@ fkUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100.0)
 }
 AliMultEstimator::AliMultEstimator(const char * name, const char * title, TString lInitDef):
 TNamed(name,title), fDefinition(""), fIsInteger(kFALSE), fValue(0), fMean(0), fPercentile(0), fFormula(0),
+fIsCompiled(kFALSE), fOffset(0), fTermIndex(), fTermWeight(),
 fkUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100.0)
 {
     //Named, titled, definition constructor
@@ -46,6 +50,10 @@ fValue(e.fValue),
 fMean(e.fMean),
 fPercentile(e.fPercentile),
 fFormula(0),
+fIsCompiled(e.fIsCompiled),
+fOffset(e.fOffset),
+fTermIndex(e.fTermIndex),
+fTermWeight(e.fTermWeight),
 fkUseAnchor(e.fkUseAnchor),
 fAnchorPoint(e.fAnchorPoint),
 fAnchorPercentile(e.fAnchorPercentile)
@@ -67,6 +75,10 @@ AliMultEstimator& AliMultEstimator::operator=(const AliMultEstimator& e)
     if (fFormula) delete fFormula;
     fFormula = 0;
     if (e.fFormula) fFormula = new TFormula(*e.fFormula);
+    fIsCompiled  = e.fIsCompiled;
+    fOffset      = e.fOffset;
+    fTermIndex   = e.fTermIndex;
+    fTermWeight  = e.fTermWeight;
     
     //Anchor point configs
     fkUseAnchor         = e.fkUseAnchor;
@@ -107,8 +119,150 @@ Float_t AliMultEstimator::GetZ() const {
     return lReturnVal; 
 }
 //________________________________________________________________
+namespace {
+    //Linear combination of input variables: fConst + sum of fWeight[i]*(variable fIndex[i])
+    struct LinearForm {
+        Double_t              fConst;
+        std::vector<Long_t>   fIndex;
+        std::vector<Double_t> fWeight;
+        LinearForm() : fConst(0), fIndex(), fWeight() {}
+        Bool_t IsConstant() const { return fIndex.empty(); }
+        void Scale(Double_t lFactor) {
+            fConst *= lFactor;
+            for (size_t i = 0; i < fWeight.size(); i++) fWeight[i] *= lFactor;
+        }
+        void Add(const LinearForm& o, Double_t lSign) {
+            fConst += lSign*o.fConst;
+            for (size_t i = 0; i < o.fIndex.size(); i++) {
+                fIndex.push_back(o.fIndex[i]);
+                fWeight.push_back(lSign*o.fWeight[i]);
+            }
+        }
+    };
+    
+    //Recursive descent parser for the definitions which are linear in the
+    //variables: sums, differences, products and ratios with constants.
+    //Anything else (functions, logic operators, products of variables...)
+    //is rejected and left to TFormula.
+    class LinearParser {
+    public:
+        LinearParser(const TString& lDef, const AliMultInput* lInput)
+        : fDef(lDef), fPos(0), fInput(lInput) {}
+        Bool_t Parse(LinearForm& f) {
+            fPos = 0;
+            if (!ParseSum(f)) return kFALSE;
+            SkipSpaces();
+            return fPos == fDef.Length();
+        }
+    private:
+        void SkipSpaces() { while (fPos < fDef.Length() && isspace(fDef[fPos])) fPos++; }
+        Bool_t Next(char c) {
+            SkipSpaces();
+            if (fPos >= fDef.Length() || fDef[fPos] != c) return kFALSE;
+            fPos++;
+            return kTRUE;
+        }
+        Bool_t ParseSum(LinearForm& f) {
+            if (!ParseProduct(f)) return kFALSE;
+            while (kTRUE) {
+                Double_t lSign = 0;
+                if      (Next('+')) lSign = +1;
+                else if (Next('-')) lSign = -1;
+                else return kTRUE;
+                LinearForm o;
+                if (!ParseProduct(o)) return kFALSE;
+                f.Add(o, lSign);
+            }
+        }
+        Bool_t ParseProduct(LinearForm& f) {
+            if (!ParseFactor(f)) return kFALSE;
+            while (kTRUE) {
+                Bool_t lDivide = kFALSE;
+                if      (Next('*')) lDivide = kFALSE;
+                else if (Next('/')) lDivide = kTRUE;
+                else return kTRUE;
+                LinearForm o;
+                if (!ParseFactor(o)) return kFALSE;
+                if (lDivide) {
+                    if (!o.IsConstant() || o.fConst == 0) return kFALSE;
+                    f.Scale(1./o.fConst);
+                } else if (o.IsConstant()) {
+                    f.Scale(o.fConst);
+                } else if (f.IsConstant()) {
+                    o.Scale(f.fConst);
+                    f = o;
+                } else return kFALSE;
+            }
+        }
+        Bool_t ParseFactor(LinearForm& f) {
+            SkipSpaces();
+            if (fPos >= fDef.Length()) return kFALSE;
+            char c = fDef[fPos];
+            if (c == '-' || c == '+') {
+                fPos++;
+                if (!ParseFactor(f)) return kFALSE;
+                if (c == '-') f.Scale(-1);
+                return kTRUE;
+            }
+            if (isdigit(c) || c == '.') {
+                const char* lStart = fDef.Data() + fPos;
+                char*       lEnd   = 0;
+                f.fConst = strtod(lStart, &lEnd);
+                if (lEnd == lStart) return kFALSE;
+                fPos += lEnd - lStart;
+                return kTRUE;
+            }
+            if (c != '(') return kFALSE;
+            fPos++;
+            //Variables are always given in parenthesis: (fAmplitude_V0A)
+            Ssiz_t lEnd = fPos;
+            while (lEnd < fDef.Length() && (isalnum(fDef[lEnd]) || fDef[lEnd] == '_')) lEnd++;
+            if (lEnd > fPos && lEnd < fDef.Length() && fDef[lEnd] == ')' && !isdigit(fDef[fPos])) {
+                TString lVarName(fDef(fPos, lEnd - fPos));
+                for (Long_t i = 0; i < fInput->GetNVariables(); i++) {
+                    if (lVarName != fInput->GetVariable(i)->GetName()) continue;
+                    f.fIndex.push_back(i);
+                    f.fWeight.push_back(1.);
+                    fPos = lEnd + 1;
+                    return kTRUE;
+                }
+                return kFALSE; //unknown name: leave it to TFormula
+            }
+            if (!ParseSum(f)) return kFALSE;
+            return Next(')');
+        }
+        
+        const TString&      fDef;
+        Ssiz_t              fPos;
+        const AliMultInput* fInput;
+    };
+}
+//________________________________________________________________
+Bool_t AliMultEstimator::Compile(const AliMultInput* lInput)
+{
+    //Reduce the definition to a linear combination of the variables, if possible
+    fIsCompiled = kFALSE;
+    fOffset     = 0;
+    fTermIndex.clear();
+    fTermWeight.clear();
+    
+    LinearForm   lForm;
+    LinearParser lParser(fDefinition, lInput);
+    if (!lParser.Parse(lForm)) return kFALSE;
+    
+    fOffset     = lForm.fConst;
+    fTermIndex  = lForm.fIndex;
+    fTermWeight = lForm.fWeight;
+    return fIsCompiled = kTRUE;
+}
+//________________________________________________________________
 void AliMultEstimator::SetupFormula(const AliMultInput* lInput)
 {
+    if (fFormula) delete fFormula;
+    fFormula = 0;
+    //Common case: sum or weighted sum of variables, no TFormula needed
+    if (Compile(lInput)) return;
+    
     TString expr = fDefinition;
     Int_t   nVar = lInput->GetNVariables();
     for (Int_t i = 0; i < nVar; i++) {
@@ -129,12 +283,24 @@ void AliMultEstimator::SetupFormula(const AliMultInput* lInput)
 //________________________________________________________________
 Float_t AliMultEstimator::Evaluate(const AliMultInput* lInput)
 {
-    if (!fFormula) return fValue = 0;
-    for (Int_t i = 0; i < lInput->GetNVariables(); i++) {
+    std::vector<Double_t> lValues(lInput->GetNVariables());
+    for (Long_t i = 0; i < lInput->GetNVariables(); i++) {
         AliMultVariable* v = lInput->GetVariable(i);
-        fFormula->SetParameter(i, v->IsInteger() ?
-                               v->GetValueInteger() :
-                               v->GetValue());
+        lValues[i] = v->IsInteger() ? v->GetValueInteger() : v->GetValue();
+    }
+    return Evaluate(lValues.empty() ? 0 : &lValues[0], lInput->GetNVariables());
+}
+//________________________________________________________________
+Float_t AliMultEstimator::Evaluate(const Double_t* lValues, Long_t lNValues)
+{
+    if (fIsCompiled) {
+        Double_t lValue = fOffset;
+        for (size_t i = 0; i < fTermIndex.size(); i++)
+            lValue += fTermWeight[i]*lValues[fTermIndex[i]];
+        return fValue = lValue;
     }
+    if (!fFormula) return fValue = 0;
+    for (Long_t i = 0; i < lNValues; i++)
+        fFormula->SetParameter(i, lValues[i]);
     return fValue = fFormula->Eval(0);
 }
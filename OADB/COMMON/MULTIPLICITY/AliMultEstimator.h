@@ -1,6 +1,7 @@
 #ifndef AliMultEstimator_H
 #define AliMultEstimator_H
 #include <TNamed.h>
+#include <vector>
 class AliMultInput;
 class TFormula;
 
@@ -43,8 +44,15 @@ public:
     //Pre-processing for speed
     void SetupFormula(const AliMultInput* lInput);
     Float_t Evaluate(const AliMultInput* lInput);
+    //Fast evaluation from AliMultInput::FillValues
+    Float_t Evaluate(const Double_t* lValues, Long_t lNValues);
+    //Definition reduced to a linear combination of the variables (no TFormula)
+    Bool_t  IsCompiled() const { return fIsCompiled; }
     
 private:
+    Bool_t Compile(const AliMultInput* lInput);
+    
+
     TString fDefinition; //How to evaluate based on AliMultVariables
     Bool_t fIsInteger; //Requires special treatment when calibrating
     
@@ -53,11 +61,17 @@ private:
     Float_t fPercentile;   //Percentile
     TFormula* fFormula; //!
     
+    //Compiled definition: fOffset + sum of fTermWeight[i]*(variable fTermIndex[i])
+    Bool_t                fIsCompiled; //!
+    Double_t              fOffset;     //!
+    std::vector<Long_t>   fTermIndex;  //!
+    std::vector<Double_t> fTermWeight; //!
+    
     //Anchor point definition
     Bool_t  fkUseAnchor;        //Use Anchor Logic (default: No)
     Float_t fAnchorPoint;       //Raw value below which
     Float_t fAnchorPercentile;  //Percentile of X-section at anchor point
     
-    ClassDef(AliMultEstimator, 1)
+    ClassDef(AliMultEstimator, 2)
 };
 #endif
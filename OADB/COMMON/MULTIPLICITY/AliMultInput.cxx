@@ -17,21 +17,21 @@
 ClassImp(AliMultInput);
 
 AliMultInput::AliMultInput() :
-  TNamed(), fNVars(0), fVariableList(0x0)
+  TNamed(), fNVars(0), fVariableList(0x0), fValues()
 {
   // Constructor
     fVariableList = new TList();
 }
 
 AliMultInput::AliMultInput(const char * name, const char * title):
-TNamed(name,title), fNVars(0), fVariableList(0x0)
+TNamed(name,title), fNVars(0), fVariableList(0x0), fValues()
 {
   // Constructor
     fVariableList = new TList();
 }
 
 AliMultInput::AliMultInput(const AliMultInput& o)
-: TNamed(o), fNVars(0), fVariableList(0x0)
+: TNamed(o), fNVars(0), fVariableList(0x0), fValues()
 {
     // Constructor
     fVariableList = new TList();
@@ -92,6 +92,20 @@ AliMultVariable* AliMultInput::GetVariable (Long_t iIdx) const
     return static_cast<AliMultVariable*>(fVariableList->At(iIdx));
 }
 
+const Double_t* AliMultInput::FillValues()
+{
+    //Copy the current values of all variables in a flat array, in the
+    //order of GetVariable(iIdx); integer variables are converted
+    fValues.resize(fNVars);
+    if (!fVariableList || fNVars == 0) return 0;
+    TIter next(fVariableList);
+    AliMultVariable* v = 0;
+    Long_t iIdx = 0;
+    while ((v = static_cast<AliMultVariable*>(next())) && iIdx < fNVars)
+        fValues[iIdx++] = v->IsInteger() ? v->GetValueInteger() : v->GetValue();
+    return &fValues[0];
+}
+
 void AliMultInput::Clear(Option_t* option)
 {
     TIter next(fVariableList);
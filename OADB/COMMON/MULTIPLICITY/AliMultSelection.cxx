@@ -240,10 +240,13 @@ void AliMultSelection::Evaluate( AliMultInput *lInput )
 //a set of input variables. Error handling to be done with care...
 {
     //Loop over estimators defined in the acquired list
+    //Variable values are gathered once, then shared by all estimators
+    const Double_t*   lValues  = lInput->FillValues();
+    Long_t            lNValues = lInput->GetNVariables();
     AliMultEstimator* estimator = 0;
     TIter             next(fEstimatorList);
     while ((estimator = static_cast<AliMultEstimator*>(next())))
-        estimator->Evaluate(lInput);
+        estimator->Evaluate(lValues, lNValues);
 
 //deprecated evaluation
 #if 0
@@ -26,6 +26,14 @@
 #include "TList.h"
 #include "TFile.h"
 #include "TStopwatch.h"
+#include "TTree.h"
+#include "TH1F.h"
+#include "TMath.h"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
 
 ClassImp(AliMultSelectionCalibrator);
 
@@ -33,7 +41,8 @@ AliMultSelectionCalibrator::AliMultSelectionCalibrator() :
     TNamed(), fInputFileName(""), fBufferFileName("buffer.root"),
     fOutputFileName(""), fInput(0), fSelection(0), fMultSelectionCuts(0), fCalibHists(0),
     lNDesiredBoundaries(0), lDesiredBoundaries(0), fRunToUseAsDefault(-1),
-    fNRunRanges(0), fRunRangesMap(), fMultSelectionList(0)
+    fNRunRanges(0), fRunRangesMap(), fMultSelectionList(0),
+    fkStreamingMode(kFALSE), fNThreads(0)
 {
     // Constructor
 
@@ -60,7 +69,8 @@ AliMultSelectionCalibrator::AliMultSelectionCalibrator(const char * name, const
     TNamed(name,title), fInputFileName(""), fBufferFileName("buffer.root"),
     fOutputFileName(""), fInput(0), fSelection(0), fMultSelectionCuts(0), fCalibHists(0),
     lNDesiredBoundaries(0), lDesiredBoundaries(0), fRunToUseAsDefault(-1),
-    fNRunRanges(0), fRunRangesMap(), fMultSelectionList(0)
+    fNRunRanges(0), fRunRangesMap(), fMultSelectionList(0),
+    fkStreamingMode(kFALSE), fNThreads(0)
 {
     // Named Constructor
 
@@ -236,6 +246,8 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
     Long64_t lNEv = fTree->GetEntries();
     cout<<"(1) File opened, event count is "<<lNEv<<endl;
     
+    if ( fkStreamingMode ) return CalibrateStreaming( fTree, lAutoDiscover );
+    
     cout<<"(2) Creating buffer, computing averages"<<endl;
     const int lMax = 1000;
     const int lMaxQuantiles = 10000;
@@ -745,6 +757,378 @@ Bool_t AliMultSelectionCalibrator::Calibrate() {
     return kTRUE;
 }
 //________________________________________________________________
+namespace {
+    //Calibration of one estimator in one run range (streaming mode)
+    struct EstimatorColumn {
+        Bool_t   fIsInteger;
+        Bool_t   fUseAnchor;
+        Double_t fAnchorPoint;
+        Double_t fAnchorPercentile;
+        std::vector<Float_t> fValues;     //estimator value of each selected event
+        //Results
+        Double_t fAverage;
+        Double_t fMin;
+        Double_t fMax;
+        Bool_t   fInsane;
+        Long64_t fStats;
+        std::vector<Double_t> fBoundaries; //floating point engine: raw boundaries
+        std::vector<Float_t>  fCumulative; //integer engine: cumulative distribution
+        
+        EstimatorColumn() : fIsInteger(kFALSE), fUseAnchor(kFALSE), fAnchorPoint(0), fAnchorPercentile(100),
+        fValues(), fAverage(-1), fMin(0), fMax(0), fInsane(kTRUE), fStats(0), fBoundaries(), fCumulative() {}
+    };
+    
+    //Place the element ranked lPos (decreasing order) at base+lPos for all
+    //sorted, unique positions in [lPosFirst, lPosLast), elements in [lFirst, lLast)
+    void SelectPositions(Float_t *lBase, Float_t *lFirst, Float_t *lLast,
+                         const Long64_t *lPosFirst, const Long64_t *lPosLast)
+    {
+        if ( lPosFirst >= lPosLast || lFirst >= lLast ) return;
+        const Long64_t *lPosMid = lPosFirst + (lPosLast-lPosFirst)/2;
+        Float_t *lNth = lBase + *lPosMid;
+        std::nth_element(lFirst, lNth, lLast, std::greater<Float_t>());
+        SelectPositions(lBase, lFirst, lNth, lPosFirst, lPosMid);
+        SelectPositions(lBase, lNth+1, lLast, lPosMid+1, lPosLast);
+    }
+    
+    //Same boundaries as the buffer file engine, from the in-memory column
+    void ProcessColumn(EstimatorColumn &c, Long_t lNDesiredBoundaries, const Double_t *lDesiredBoundaries)
+    {
+        const Long64_t ntot = c.fValues.size();
+        c.fStats = ntot;
+        if ( ntot < 1 ) return; //insane, no information
+        
+        Double_t lSum = 0;
+        c.fMin = c.fMax = c.fValues[0];
+        for( Long64_t iEntry=0; iEntry<ntot; iEntry++) {
+            Float_t lThisVal = c.fValues[iEntry];
+            lSum += lThisVal;
+            if( lThisVal < c.fMin ) c.fMin = lThisVal;
+            if( lThisVal > c.fMax ) c.fMax = lThisVal;
+        }
+        c.fAverage = lSum / ( (Double_t) ntot );
+        c.fInsane  = ( TMath::Abs( c.fMin - c.fMax ) < 1e-6 );
+        
+        if( !c.fIsInteger ) {
+            //==== Floating Point Calibration Engine ====
+            Double_t lScalingFactor = 1.0;
+            if( c.fUseAnchor ) {
+                Long64_t lAcceptedEvents = 0;
+                for( Long64_t iEntry=0; iEntry<ntot; iEntry++) if( c.fValues[iEntry] > c.fAnchorPoint ) lAcceptedEvents++;
+                c.fStats = lAcceptedEvents;
+                lScalingFactor = (((Double_t) lAcceptedEvents )/((Double_t) ntot))/((0.01)*c.fAnchorPercentile);
+            }
+            c.fBoundaries.assign(lNDesiredBoundaries, 0.0);
+            //Overwrite lower boundary in case this has a negative minimum...
+            if ( c.fMin < 0 ) c.fBoundaries[0] = c.fMin;
+            
+            std::vector<Long64_t> lPositions(lNDesiredBoundaries, 0);
+            for( Long_t lB=1; lB<lNDesiredBoundaries; lB++) {
+                Long64_t position = (Long64_t) ( ( 0.01 * ((Double_t)(ntot)* lDesiredBoundaries[lB] ) ) * lScalingFactor );
+                if( position > ntot-1 ) position = ntot-1; //protection !
+                if( position < 0 ) position = 0;
+                lPositions[lB] = position;
+            }
+            std::vector<Long64_t> lSorted(lPositions.begin()+1, lPositions.end());
+            std::sort(lSorted.begin(), lSorted.end());
+            lSorted.erase(std::unique(lSorted.begin(), lSorted.end()), lSorted.end());
+            if ( !lSorted.empty() )
+                SelectPositions(&c.fValues[0], &c.fValues[0], &c.fValues[0]+ntot, &lSorted[0], &lSorted[0]+lSorted.size());
+            for( Long_t lB=1; lB<lNDesiredBoundaries; lB++) c.fBoundaries[lB] = c.fValues[lPositions[lB]];
+            
+            //Cross-check correct rejection of anything beyond anchor point
+            if( c.fUseAnchor ){
+                for( Long_t lB=0; lB<lNDesiredBoundaries-1; lB++) {
+                    if (c.fBoundaries[lB+1]>c.fAnchorPoint && c.fBoundaries[lB]<c.fAnchorPoint){
+                        c.fBoundaries[lB] = c.fAnchorPoint;
+                    }
+                }
+            }
+        } else {
+            //==== Integer Value Calibration Engine ====
+            const Long_t   lNBins    = c.fMax-c.fMin+1;
+            const Double_t lLowEdge  = c.fMin-0.5;
+            const Double_t lHighEdge = c.fMax+0.5;
+            std::vector<Long64_t> lCounts(lNBins, 0);
+            for( Long64_t iEntry=0; iEntry<ntot; iEntry++) {
+                Long_t iB = (Long_t) ( lNBins*(c.fValues[iEntry]-lLowEdge)/(lHighEdge-lLowEdge) );
+                if( iB >= 0 && iB < lNBins ) lCounts[iB]++;
+            }
+            //Normalized to unity, cumulative function
+            c.fCumulative.assign(lNBins+1, 0);
+            for(Long_t iB=1; iB<lNBins+1; iB++) {
+                Float_t lContent = lCounts[iB-1]*(1./((double)(ntot)));
+                c.fCumulative[iB] = c.fCumulative[iB-1]+lContent;
+            }
+        }
+        //Column no longer needed
+        std::vector<Float_t>().swap(c.fValues);
+    }
+}
+
+//________________________________________________________________
+Bool_t AliMultSelectionCalibrator::CalibrateStreaming( TTree *fTree, Bool_t lAutoDiscover ) {
+    // Streaming calibration, same output as the buffer file procedure:
+    //  (2) Single pass over the input: event selection, evaluation of all
+    //      estimators, values stored in per-run-range in-memory columns
+    //  (3) Averages and boundaries per run range and estimator, in
+    //      parallel worker threads (nth_element instead of full sorts)
+    //  (4) Save Quantiles + AliMultSelectionCuts to OADB File
+    
+    if ( lNDesiredBoundaries < 2 || !lDesiredBoundaries ) {
+        cout<<"Error: no boundaries configured, please call SetBoundaries(...)!"<<endl;
+        return kFALSE;
+    }
+    
+    //Event Selection Variables
+    Bool_t fEvSel_IsNotPileupInMultBins      = kFALSE ;
+    Bool_t fEvSel_Triggered                  = kFALSE ;
+    Bool_t fEvSel_INELgtZERO                 = kFALSE ;
+    Bool_t fEvSel_PassesTrackletVsCluster    = kFALSE ;
+    Bool_t fEvSel_HasNoInconsistentVertices  = kFALSE ;
+    Bool_t fEvSel_IsNotAsymmetricInVZERO     = kFALSE ;
+    Bool_t fEvSel_IsNotIncompleteDAQ         = kFALSE ;
+    Bool_t fEvSel_HasGoodVertex2016          = kFALSE ;
+    Int_t fRunNumber;
+    
+    //FIXME/CAUTION: non-zero if using tree without that branch
+    Int_t fnContributors = 1000;
+    
+    fTree->SetBranchAddress("fEvSel_IsNotPileupInMultBins",&fEvSel_IsNotPileupInMultBins);
+    fTree->SetBranchAddress("fEvSel_PassesTrackletVsCluster",&fEvSel_PassesTrackletVsCluster);
+    fTree->SetBranchAddress("fEvSel_HasNoInconsistentVertices",&fEvSel_HasNoInconsistentVertices);
+    fTree->SetBranchAddress("fEvSel_Triggered",&fEvSel_Triggered);
+    fTree->SetBranchAddress("fEvSel_INELgtZERO",&fEvSel_INELgtZERO);
+    fTree->SetBranchAddress("fRunNumber",&fRunNumber);
+    fTree->SetBranchAddress("fnContributors", &fnContributors);
+    fTree->SetBranchAddress("fEvSel_IsNotAsymmetricInVZERO", &fEvSel_IsNotAsymmetricInVZERO);
+    fTree->SetBranchAddress("fEvSel_IsNotIncompleteDAQ", &fEvSel_IsNotIncompleteDAQ);
+    fTree->SetBranchAddress("fEvSel_HasGoodVertex2016", &fEvSel_HasGoodVertex2016);
+    
+    //Estimator definitions per run range, set up once
+    //(auto-discovered runs all share fSelection)
+    std::vector<AliMultSelection*> lSelections;
+    std::vector< std::vector<AliMultEstimator*> > lEstimators;
+    std::vector< std::vector<EstimatorColumn> >   lColumns;
+    std::vector<Int_t> lRunNumbers;
+    
+    if ( lAutoDiscover ) {
+        fSelection->Setup ( fInput );
+    } else {
+        for(Int_t iRun=0; iRun<fNRunRanges; iRun++) {
+            AliMultSelection *lSel = (AliMultSelection*) fMultSelectionList->At(iRun);
+            lSel->Setup ( fInput );
+            lSelections.push_back( lSel );
+            lRunNumbers.push_back( 0 );
+        }
+    }
+    //Columns of a run range, matching the estimators of its AliMultSelection
+    auto lBookRunRange = [&]( AliMultSelection *lSel ) {
+        std::vector<AliMultEstimator*> lEst;
+        std::vector<EstimatorColumn>   lCol(lSel->GetNEstimators());
+        for(Long_t iEst=0; iEst<lSel->GetNEstimators(); iEst++) {
+            AliMultEstimator *e = lSel->GetEstimator(iEst);
+            lEst.push_back( e );
+            lCol[iEst].fIsInteger        = e->IsInteger();
+            lCol[iEst].fUseAnchor        = e->GetUseAnchor();
+            lCol[iEst].fAnchorPoint      = e->GetAnchorPoint();
+            lCol[iEst].fAnchorPercentile = e->GetAnchorPercentile();
+        }
+        lEstimators.push_back( lEst );
+        lColumns.push_back( lCol );
+    };
+    for(size_t iRun=0; iRun<lSelections.size(); iRun++) lBookRunRange( lSelections[iRun] );
+    
+    cout<<"(2) Streaming input into in-memory estimator columns"<<endl;
+    TStopwatch* timer = new TStopwatch();
+    timer->Start ( kTRUE );
+    
+    AliMultVariable *lVtxZLocalPointer = fInput -> GetVariable("fEvSel_VtxZ");
+    const Long64_t lNEv = fTree->GetEntries();
+    for(Long64_t iEv = 0; iEv<lNEv; iEv++) {
+        if ( iEv % 1000000 == 0 ) {
+            timer->Stop();
+            Double_t time = timer->RealTime();
+            timer->Start ( kFALSE );
+            cout << "Event # " << iEv << "/" << lNEv << " (" << 100. * ( double ) ( iEv ) / ( double ) ( lNEv ) << "%), working at "<<( ( Double_t ) ( iEv ) )/time<<" Events/s..." << endl;
+        }
+        fTree->GetEntry(iEv);
+        
+        //Check Selections as they are in the fMultSelectionCuts Object
+        if( fMultSelectionCuts->GetTriggerCut()    && ! fEvSel_Triggered  ) continue;
+        if( fMultSelectionCuts->GetINELgtZEROCut() && ! fEvSel_INELgtZERO ) continue;
+        if( TMath::Abs( lVtxZLocalPointer->GetValue() ) > fMultSelectionCuts->GetVzCut()      ) continue;
+        if( fMultSelectionCuts->GetRejectPileupInMultBinsCut() && ! fEvSel_IsNotPileupInMultBins    ) continue;
+        if( fMultSelectionCuts->GetTrackletsVsClustersCut()    && ! fEvSel_PassesTrackletVsCluster  ) continue;
+        if( fMultSelectionCuts->GetVertexConsistencyCut()      && ! fEvSel_HasNoInconsistentVertices) continue;
+        if( fMultSelectionCuts->GetNonZeroNContribs()          &&  fnContributors < 1 ) continue;
+        if( fMultSelectionCuts->GetIsNotAsymmetricInVZERO()    && ! fEvSel_IsNotAsymmetricInVZERO) continue;
+        if( fMultSelectionCuts->GetIsNotIncompleteDAQ()        && ! fEvSel_IsNotIncompleteDAQ) continue;
+        if( fMultSelectionCuts->GetHasGoodVertex2016()         && ! fEvSel_HasGoodVertex2016) continue;
+        
+        Int_t lIndex = -1;
+        std::map<int, int>::const_iterator it = fRunRangesMap.find( fRunNumber );
+        if ( it != fRunRangesMap.end() ) {
+            lIndex = it->second;
+        } else if ( lAutoDiscover ) {
+            lIndex = fNRunRanges;
+            cout<<"(Autodiscover) New Run Found: "<<fRunNumber<<", added as #"<<lIndex<<endl;
+            fRunRangesMap.insert( std::pair<int,int>(fRunNumber,lIndex));
+            lRunNumbers.push_back( fRunNumber );
+            lSelections.push_back( fSelection );
+            lBookRunRange( fSelection );
+            fNRunRanges++;
+        } else continue;
+        
+        //Evaluate all estimators of this run range and store them
+        lSelections[lIndex]->Evaluate ( fInput );
+        std::vector<AliMultEstimator*> &lEst = lEstimators[lIndex];
+        std::vector<EstimatorColumn>   &lCol = lColumns[lIndex];
+        for(size_t iEst=0; iEst<lEst.size(); iEst++) lCol[iEst].fValues.push_back( lEst[iEst]->GetValue() );
+    }
+    timer->Stop();
+    cout<<"(2) Done in "<<timer->RealTime()<<" s"<<endl;
+    delete timer;
+    
+    //=========================================
+    // Determine Calibration Information
+    //=========================================
+    std::vector< std::pair<Int_t,Int_t> > lJobs;
+    for(Int_t iRun=0; iRun<fNRunRanges; iRun++)
+        for(size_t iEst=0; iEst<lColumns[iRun].size(); iEst++) lJobs.push_back( std::pair<Int_t,Int_t>(iRun, iEst) );
+    
+    Int_t nThreads = fNThreads;
+    if( nThreads<=0 ) nThreads = std::thread::hardware_concurrency();
+    if( nThreads>(Int_t)lJobs.size() ) nThreads = lJobs.size();
+    if( nThreads<1 ) nThreads = 1;
+    cout<<"(3) Determining boundaries for "<<fNRunRanges<<" run ranges on "<<nThreads<<" threads"<<endl;
+    
+    //Workers only touch their own columns: no ROOT objects involved
+    std::atomic<size_t> lNextJob(0);
+    auto worker = [&]() {
+        for(size_t iJob=lNextJob++; iJob<lJobs.size(); iJob=lNextJob++)
+            ProcessColumn( lColumns[lJobs[iJob].first][lJobs[iJob].second], lNDesiredBoundaries, lDesiredBoundaries );
+    };
+    std::vector<std::thread> pool;
+    for(Int_t ith=0; ith<nThreads; ith++) pool.emplace_back(worker);
+    for(auto& th : pool) th.join();
+    
+    //Middle of percentile bins
+    std::vector<Double_t> lMiddleOfBins(lNDesiredBoundaries > 1 ? lNDesiredBoundaries-1 : 0);
+    for( Long_t lB=1; lB<lNDesiredBoundaries; lB++)
+        lMiddleOfBins[lB-1] = 0.5*(lDesiredBoundaries[lB]+lDesiredBoundaries[lB-1]);
+    
+    //Calibration histogram of estimator iEst in run range iRun
+    auto lCalibHisto = [&]( Int_t iRun, Int_t iEst, const char *lName ) -> TH1F* {
+        const EstimatorColumn &c = lColumns[iRun][iEst];
+        AliMultEstimator *e = lEstimators[iRun][iEst];
+        TH1F *h = 0x0;
+        if( !c.fIsInteger ) {
+            if( !c.fInsane ) {
+                h = new TH1F(lName,"",lNDesiredBoundaries-1,&c.fBoundaries[0]);
+                h->SetDirectory(0);
+                h->SetBinContent(0,100.5); //Just in case correction functions screw up the values ...
+                for(Long_t ibin=1; ibin<h->GetNbinsX()+1; ibin++){
+                    h->SetBinContent(ibin, lMiddleOfBins[ibin-1]);
+                    //override in case anchored!
+                    if( e->GetUseAnchor() && h->GetBinCenter(ibin) < e->GetAnchorPoint() ) h->SetBinContent(ibin, 100.5);
+                }
+            } else {
+                h = new TH1F(lName,"",1,0,1);
+                h->SetDirectory(0);
+                //There was insufficient information to generate a meaningful calibration for this estimator!
+                h->SetBinContent(0,AliMultSelectionCuts::kNoCalib);
+                h->SetBinContent(1,AliMultSelectionCuts::kNoCalib);
+                h->SetBinContent(2,AliMultSelectionCuts::kNoCalib);
+            }
+        } else {
+            if( c.fStats < 1 ) {
+                //Case of an empty run!
+                h = new TH1F(lName,"",1,0,1);
+                h->SetDirectory(0);
+            } else {
+                const Long_t lNBins = c.fCumulative.size()-1;
+                Float_t lLowEdge  = c.fMin-0.5;
+                Float_t lHighEdge = c.fMax+0.5;
+                h = new TH1F(lName,"",lNBins,lLowEdge,lHighEdge);
+                h->SetDirectory(0);
+                for(Long_t ibin=1; ibin<h->GetNbinsX()+1; ibin++) h->SetBinContent(ibin, 100.0-50.0*(c.fCumulative[ibin-1]+c.fCumulative[ibin]));
+            }
+        }
+        return h;
+    };
+    
+    //Open output OADB file, generate everything within loop
+    TFile * f = new TFile (fOutputFileName.Data(), "recreate");
+    AliOADBContainer * oadbContMS = new AliOADBContainer("MultSel");
+    
+    cout<<"(4) Saving calibration objects"<<endl;
+    for(Int_t iRun=0; iRun<fNRunRanges; iRun++) {
+        fSelection = lSelections[iRun];
+        const Int_t lNEstimatorsThis = lColumns[iRun].size();
+        
+        //Run statistics: as in buffer mode, taken from the last estimator
+        Long64_t lRunStats = lNEstimatorsThis > 0 ? lColumns[iRun][lNEstimatorsThis-1].fStats : 0;
+        if ( !lAutoDiscover ){
+            cout<<"--- Run range "<<fFirstRun[iRun]<<"-"<<fLastRun[iRun]<<" ("<<iRun<<"/"<<fNRunRanges<<"), with "<<lRunStats<<" events"<<endl;
+        }else{
+            cout<<"--- Run "<<lRunNumbers[iRun]<<" ("<<iRun<<"/"<<fNRunRanges<<"), with "<<lRunStats<<" events"<<endl;
+        }
+        for(Int_t iEst=0; iEst<lNEstimatorsThis; iEst++) {
+            const EstimatorColumn &c = lColumns[iRun][iEst];
+            cout<<"    "<<fSelection->GetEstimator(iEst)->GetName()<<": Min = "<<c.fMin<<", Max = "<<c.fMax<<", Av = "<<c.fAverage<<(c.fInsane?" (no calibration)":"")<<endl;
+        }
+        
+        Bool_t lThisIsReference = kFALSE;
+        if(!lAutoDiscover){
+            if ( fFirstRun[iRun] <= fRunToUseAsDefault && fRunToUseAsDefault <= fLastRun[iRun]) lThisIsReference = kTRUE;
+        }else{
+            if ( lRunNumbers[iRun] == fRunToUseAsDefault ) lThisIsReference = kTRUE;
+        }
+        //Objects to be saved: this run range and, if needed, the default
+        for( Int_t iObj=0; iObj<2; iObj++) {
+            if( iObj == 0 && lRunStats <= 1000 ) continue; //insufficient statistics
+            if( iObj == 1 && !lThisIsReference ) continue;
+            
+            AliOADBMultSelection *oadbMultSelection = iObj == 0 ? new AliOADBMultSelection() : new AliOADBMultSelection("Default");
+            AliMultSelection     *fsels             = new AliMultSelection( fSelection );
+            oadbMultSelection->SetEventCuts    ( new AliMultSelectionCuts(*fMultSelectionCuts) );
+            oadbMultSelection->SetMultSelection( fsels );
+            for ( Int_t iEst=0; iEst<lNEstimatorsThis; iEst++) {
+                fsels->GetEstimator(iEst)->SetMean( lColumns[iRun][iEst].fAverage );
+                oadbMultSelection->AddCalibHisto( lCalibHisto( iRun, iEst, Form("hCalib_%s",fSelection->GetEstimator(iEst)->GetName()) ) );
+            }
+            if( iObj == 1 ) {
+                cout<<" Detected that this particular run / run range is special, will save it as default"<<endl;
+                oadbContMS->AddDefaultObject(oadbMultSelection);
+            } else if ( !lAutoDiscover ) {
+                oadbContMS->AppendObject(oadbMultSelection, fFirstRun[iRun], fLastRun[iRun] );
+            } else {
+                oadbContMS->AppendObject(oadbMultSelection, lRunNumbers[iRun], lRunNumbers[iRun] );
+            }
+        }
+    }
+    
+    if( fRunToUseAsDefault < 0 && fNRunRanges > 0 ){
+        //Default: last calibrated run range
+        cout<<" Warning: default object corresponds to the last calibrated run!"<<endl;
+        Int_t iRun = fNRunRanges-1;
+        fSelection = lSelections[iRun];
+        AliOADBMultSelection *oadbMultSelection = new AliOADBMultSelection("Default");
+        oadbMultSelection->SetEventCuts    ( new AliMultSelectionCuts(*fMultSelectionCuts) );
+        oadbMultSelection->SetMultSelection( new AliMultSelection( fSelection ) );
+        for ( Int_t iEst=0; iEst<(Int_t)lColumns[iRun].size(); iEst++)
+            oadbMultSelection->AddCalibHisto( lCalibHisto( iRun, iEst, Form("hCalib_%s",fSelection->GetEstimator(iEst)->GetName()) ) );
+        oadbContMS->AddDefaultObject(oadbMultSelection);
+    }
+    
+    cout<<"All done, will write OADB..."<<endl;
+    f->cd();
+    oadbContMS->Write();
+    cout<<" Done!"<<endl;
+    return kTRUE;
+}
+//________________________________________________________________
 Float_t AliMultSelectionCalibrator::MinVal( Float_t A, Float_t B ) {
     if( A < B ) {
         return A;
@@ -8,6 +8,7 @@
 
 using namespace std;
 class AliESDEvent;
+class TTree;
 class AliMultSelectionCalibrator : public TNamed {
     
 public:
@@ -61,6 +62,16 @@ public:
     //Configure standard input
     void SetupStandardInput();
     
+    //Streaming mode: the input tree is read once into in-memory columns of
+    //estimator values (no buffer file), boundaries are determined with a
+    //selection algorithm instead of a full sort, and the run ranges are
+    //processed in parallel worker threads
+    void SetStreamingMode ( Bool_t lVal ) { fkStreamingMode = lVal; }
+    Bool_t GetStreamingMode() const { return fkStreamingMode; }
+    //Number of worker threads for streaming mode (<=0: hardware concurrency)
+    void SetNumberOfThreads ( Int_t lVal ) { fNThreads = lVal; }
+    Int_t GetNumberOfThreads() const { return fNThreads; }
+    
     //Master Function in this Class: To be called once filenames are set
     Bool_t Calibrate();
     
@@ -68,6 +79,9 @@ public:
     Float_t MinVal( Float_t A, Float_t B );
     
 private:
+    //Streaming mode implementation, called by Calibrate
+    Bool_t CalibrateStreaming( TTree *fTree, Bool_t lAutoDiscover );
+    
     AliMultInput     *fInput;     //Object for all input
     AliMultSelection *fSelection; //(current) transient pointer object
 
@@ -94,11 +108,15 @@ private:
     
     // TList object for storing histograms
     TList *fCalibHists; 
+    
+    Bool_t fkStreamingMode; // Single pass, in-memory calibration
+    Int_t  fNThreads;       // Worker threads for streaming mode
 
-    ClassDef(AliMultSelectionCalibrator, 2);
+    ClassDef(AliMultSelectionCalibrator, 3);
     //(this classdef is only for bookkeeping, class will not usually
     // be streamed according to current workflow except in very specific
     // tests!) 
     //2 - Adjustments of extra event selections
+    //3 - Streaming calibration mode
 };
 #endif
@@ -1553,24 +1553,20 @@ void AliMultSelectionTask::UserExec(Option_t *)
         fEvSelCode = lSelection->GetEvSelCode();
 
         //Determine Quantiles from calibration histogram
-        TH1F *lThisCalibHisto = 0x0;
-        TString lThisCalibHistoName;
+        //(look-up tables built once per run in AliOADBMultSelection::Setup)
         Float_t lThisQuantile = -1;
         for(Long_t iEst=0; iEst<lSelection->GetNEstimators(); iEst++) {
             //Changed: no need for run number, object already matches required one
-            lThisCalibHistoName = Form("hCalib_%s",lSelection->GetEstimator(iEst)->GetName());
-            lThisCalibHisto = 0x0;
-            lThisCalibHisto = fOadbMultSelection->GetCalibHisto( lThisCalibHistoName );
-            if ( ! lThisCalibHisto ) {
+            AliMultEstimator* lThisEstimator = lSelection->GetEstimator(iEst);
+            if ( ! fOadbMultSelection->GetCalibPercentile( iEst, lThisEstimator->GetValue(), lThisQuantile ) ) {
                 lThisQuantile = AliMultSelectionCuts::kNoCalib;
                 if( iEst < fNDebug ) fQuantiles[iEst] = lThisQuantile;
-                lSelection->GetEstimator(iEst)->SetPercentile(lThisQuantile);
+                lThisEstimator->SetPercentile(lThisQuantile);
             } else {
-                lThisQuantile = lThisCalibHisto->GetBinContent( lThisCalibHisto->FindBin( lSelection->GetEstimator(iEst)->GetValue() ));
                 if( iEst < fNDebug ) {
                     fQuantiles[iEst] = lThisQuantile; //Debug, please
                 }
-                lSelection->GetEstimator(iEst)->SetPercentile(lThisQuantile);
+                lThisEstimator->SetPercentile(lThisQuantile);
             }
         }
 
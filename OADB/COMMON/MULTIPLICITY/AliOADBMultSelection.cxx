@@ -1,5 +1,6 @@
 #include "AliOADBMultSelection.h"
 #include "TH1F.h"
+#include "TMath.h"
 #include "TList.h"
 #include "AliMultEstimator.h"
 #include "AliMultVariable.h"
@@ -11,13 +12,49 @@
 #include "TBrowser.h"
 #include <TMap.h>
 #include <TROOT.h>
+#include <algorithm>
+#include <vector>
 
 ClassImp(AliOADBMultSelection);
 
+//________________________________________________________________
+//Calibration histogram flattened for the per-event percentile look-up:
+//direct index for uniform binning, binary search on the edges otherwise
+struct MultCalibTable {
+    Bool_t   fValid;
+    Int_t    fNbins;
+    Double_t fXmin;
+    Double_t fXmax;
+    std::vector<Double_t> fEdges;    // bin edges, variable binning only
+    std::vector<Double_t> fContents; // underflow, bins, overflow
+    
+    MultCalibTable() : fValid(kFALSE), fNbins(0), fXmin(0), fXmax(0), fEdges(), fContents() {}
+    MultCalibTable(const TH1* h) : fValid(kTRUE), fNbins(0), fXmin(0), fXmax(0), fEdges(), fContents() {
+        const TAxis* a = h->GetXaxis();
+        fNbins = a->GetNbins();
+        fXmin  = a->GetXmin();
+        fXmax  = a->GetXmax();
+        if (a->GetXbins()->GetSize() > 0)
+            fEdges.assign(a->GetXbins()->GetArray(), a->GetXbins()->GetArray() + a->GetXbins()->GetSize());
+        fContents.resize(fNbins+2);
+        for (Int_t iBin = 0; iBin < fNbins+2; iBin++) fContents[iBin] = h->GetBinContent(iBin);
+    }
+    //Same bin as TAxis::FindBin
+    Double_t Lookup(Double_t x) const {
+        Int_t lBin = 0;
+        if      (x < fXmin)      lBin = 0;
+        else if (!(x < fXmax))   lBin = fNbins+1;
+        else if (fEdges.empty()) lBin = TMath::Min(1 + Int_t(fNbins*(x-fXmin)/(fXmax-fXmin)), fNbins);
+        else                     lBin = std::upper_bound(fEdges.begin(), fEdges.end(), x) - fEdges.begin();
+        return fContents[lBin];
+    }
+};
+class MultCalibTables : public std::vector<MultCalibTable> {};
+
 //________________________________________________________________
 //Constructors/Destructor
 AliOADBMultSelection::AliOADBMultSelection() :
-TNamed("multSel",""), fCalibList(0), fEventCuts(0), fSelection(0), fMap(0)
+TNamed("multSel",""), fCalibList(0), fEventCuts(0), fSelection(0), fMap(0), fTables(0)
 {
     // constructor
     // fCalibList = new TList();
@@ -29,7 +66,8 @@ AliOADBMultSelection::AliOADBMultSelection(const AliOADBMultSelection& o)
 fCalibList(0),
 fEventCuts(0),
 fSelection(0),
-fMap(0)
+fMap(0),
+fTables(0)
 {
     fCalibList = new TList();
     fCalibList->SetOwner (kTRUE);
@@ -41,7 +79,7 @@ fMap(0)
 }
 //________________________________________________________________
 AliOADBMultSelection::AliOADBMultSelection(const char * name, const char * title) :
-TNamed(name, title), fCalibList(0), fEventCuts(0), fSelection(0), fMap(0)
+TNamed(name, title), fCalibList(0), fEventCuts(0), fSelection(0), fMap(0), fTables(0)
 {
     // constructor
     fCalibList = new TList();
@@ -61,6 +99,10 @@ AliOADBMultSelection& AliOADBMultSelection::operator=(const AliOADBMultSelection
         delete fMap;
         fMap = 0;
     }
+    if (fTables) {
+        delete fTables;
+        fTables = 0;
+    }
     fCalibList = new TList();
     fCalibList->SetOwner (kTRUE);
     TIter next(o.fCalibList);
@@ -75,6 +117,7 @@ AliOADBMultSelection::~AliOADBMultSelection(){
     // Destructor
     if(fEventCuts)     delete fEventCuts;
     if(fSelection)     delete fSelection;
+    if(fTables)        delete fTables;
     
     //if( fCalibList) {
     //    fCalibList -> Delete();
@@ -231,11 +274,17 @@ void AliOADBMultSelection::Setup()
         delete fMap;
         fMap = 0;
     }
+    if (fTables) {
+        delete fTables;
+        fTables = 0;
+    }
     AliMultSelection* sel = GetMultSelection();
     if (!sel) return;
     
     fMap = new TMap;
     fMap->SetOwner(false);
+    fTables = new MultCalibTables;
+    fTables->resize(sel->GetNEstimators());
     
     for(Long_t iEst=0; iEst<sel->GetNEstimators(); iEst++) {
         AliMultEstimator* e = sel->GetEstimator(iEst);
@@ -246,7 +295,25 @@ void AliOADBMultSelection::Setup()
         if (!h) continue;
         
         fMap->Add(e, h);
+        (*fTables)[iEst] = MultCalibTable(h);
+    }
+}
+//________________________________________________________________
+Bool_t AliOADBMultSelection::GetCalibPercentile(Long_t iEst, Double_t lValue, Float_t& lPercentile) const
+{
+    if (!fTables) {
+        //Setup() not called: look the histogram up by name
+        AliMultEstimator* e = fSelection ? fSelection->GetEstimator(iEst) : 0;
+        TH1F* h = e ? GetCalibHisto(TString(Form("hCalib_%s", e->GetName()))) : 0;
+        if (!h) return kFALSE;
+        lPercentile = h->GetBinContent(h->FindBin(lValue));
+        return kTRUE;
     }
+    if (iEst < 0 || iEst >= Long_t(fTables->size())) return kFALSE;
+    const MultCalibTable& t = (*fTables)[iEst];
+    if (!t.fValid) return kFALSE;
+    lPercentile = t.Lookup(lValue);
+    return kTRUE;
 }
 
 
@@ -9,6 +9,7 @@ class TList;
 class AliMultSelectionCuts;
 class AliMultEstimator;
 class TMap;
+class MultCalibTables;
 
 class AliOADBMultSelection : public TNamed {
     
@@ -39,6 +40,10 @@ public:
     //Use internal map
     void Setup();
     TH1F* FindHisto(AliMultEstimator* e);
+    //Percentile of estimator iEst for a given estimator value; same result as
+    //FindBin/GetBinContent on its calibration histogram, from look-up tables
+    //built in Setup(). Returns kFALSE if there is no calibration histogram.
+    Bool_t GetCalibPercentile(Long_t iEst, Double_t lValue, Float_t& lPercentile) const;
     void Print(Option_t* option="") const;
     
 private:
@@ -46,7 +51,8 @@ private:
     AliMultSelectionCuts * fEventCuts; // EventCuts
     AliMultSelection     * fSelection; // Definition of Estimators
     TMap*                  fMap; //! Map estimator to histogram
-    ClassDef(AliOADBMultSelection, 1)
+    MultCalibTables*       fTables; //! Look-up tables of calibration histograms, per estimator index
+    ClassDef(AliOADBMultSelection, 2)
     
     
 };
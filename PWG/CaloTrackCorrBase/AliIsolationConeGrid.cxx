@@ -0,0 +1,255 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+// --- ROOT system ---
+#include <TMath.h>
+
+// --- CaloTrackCorrelations ---
+#include "AliIsolationConeGrid.h"
+
+/// \cond CLASSIMP
+ClassImp(AliIsolationConeGrid) ;
+/// \endcond
+
+//____________________________________
+/// Default constructor.
+//____________________________________
+AliIsolationConeGrid::AliIsolationConeGrid() :
+TObject(),
+fSource(0x0), fNEntries(-1), fEvent(-1), fConfig(-1),
+fEtaMin(0.), fEtaStep(0.1), fPhiStep(TMath::TwoPi()/64), fNEta(0), fNPhi(64),
+fPt(), fEta(), fPhi(), fObject(), fIDIndex(),
+fCellStart(), fCellList(), fRowSum(), fColumnSum()
+{
+}
+
+//____________________________________
+/// Remove the particles of the previous event.
+//____________________________________
+void AliIsolationConeGrid::Clear(Option_t *)
+{
+  fSource   = 0x0;
+  fNEntries = -1;
+  fEvent    = -1;
+  fConfig   = -1;
+  fNEta     = 0;
+
+  fPt    .clear();
+  fEta   .clear();
+  fPhi   .clear();
+  fObject.clear();
+  fIDIndex.clear();
+
+  fCellStart.clear();
+  fCellList .clear();
+  fRowSum   .clear();
+  fColumnSum.clear();
+}
+
+//_____________________________________________________________________________________
+/// \return kTRUE if the index was built from this list, event and selection configuration.
+//_____________________________________________________________________________________
+Bool_t AliIsolationConeGrid::IsSource(const TObject * list, Int_t nEntries, Int_t event, Int_t config) const
+{
+  return list == fSource && nEntries == fNEntries && event == fEvent && config == fConfig;
+}
+
+//_____________________________________________________________________________________
+/// Record the list, event and selection configuration the index is being built from.
+//_____________________________________________________________________________________
+void AliIsolationConeGrid::SetSource(const TObject * list, Int_t nEntries, Int_t event, Int_t config)
+{
+  fSource   = list;
+  fNEntries = nEntries;
+  fEvent    = event;
+  fConfig   = config;
+}
+
+//_____________________________________________________________________________________
+/// Add one track or cluster, before Build().
+/// \param obj: track or cluster, returned for the AOD references.
+/// \param pt: transverse momentum.
+/// \param eta: pseudorapidity.
+/// \param phi: azimuthal angle, in [0, 2pi[.
+/// \param id: track or cluster ID, used to remove the candidate from the cone.
+/// \param hasID: kFALSE for mixed event particles, which cannot be the candidate.
+//_____________________________________________________________________________________
+void AliIsolationConeGrid::Add(TObject * obj, Float_t pt, Float_t eta, Float_t phi, Int_t id, Bool_t hasID)
+{
+  if ( hasID ) fIDIndex[id] = fPt.size();
+
+  fPt    .push_back(pt);
+  fEta   .push_back(eta);
+  fPhi   .push_back(phi);
+  fObject.push_back(obj);
+}
+
+//____________________________________
+/// Sort the particles in cells and compute the pT sums per row and column.
+//____________________________________
+void AliIsolationConeGrid::Build()
+{
+  Int_t nParticles = fPt.size();
+
+  Float_t etaMax = 0;
+  fEtaMin = 0;
+  for(Int_t i = 0; i < nParticles; i++)
+  {
+    if ( i == 0 || fEta[i] < fEtaMin ) fEtaMin = fEta[i];
+    if ( i == 0 || fEta[i] > etaMax  ) etaMax  = fEta[i];
+  }
+
+  fNEta = TMath::Min(Int_t((etaMax-fEtaMin)/fEtaStep)+1, 1000);
+
+  Int_t nCells = fNEta*fNPhi;
+  fCellStart.assign(nCells+1, 0);
+  fCellList .assign(nParticles, 0);
+  fRowSum   .assign(fNEta, 0.);
+  fColumnSum.assign(fNPhi, 0.);
+
+  std::vector<Int_t> cell(nParticles);
+  for(Int_t i = 0; i < nParticles; i++)
+  {
+    Int_t row    = EtaCell(fEta[i]);
+    Int_t column = PhiCell(fPhi[i]);
+    cell[i] = row*fNPhi+column;
+    fCellStart[cell[i]+1]++;
+    fRowSum   [row]    += fPt[i];
+    fColumnSum[column] += fPt[i];
+  }
+
+  for(Int_t icell = 0; icell < nCells; icell++) fCellStart[icell+1] += fCellStart[icell];
+
+  std::vector<Int_t> next(fCellStart.begin(), fCellStart.end()-1);
+  for(Int_t i = 0; i < nParticles; i++) fCellList[next[cell[i]]++] = i;
+}
+
+//_____________________________________________________________________________________
+/// Eta row of the cell, clamped to the grid.
+//_____________________________________________________________________________________
+Int_t AliIsolationConeGrid::EtaCell(Float_t eta) const
+{
+  Float_t x = (eta-fEtaMin)/fEtaStep;
+  if ( x < 0     ) return 0;
+  if ( x >= fNEta ) return fNEta-1;
+  return Int_t(x);
+}
+
+//_____________________________________________________________________________________
+/// Phi column of the cell, clamped to the grid.
+//_____________________________________________________________________________________
+Int_t AliIsolationConeGrid::PhiCell(Float_t phi) const
+{
+  Float_t x = phi/fPhiStep;
+  if ( x < 0     ) return 0;
+  if ( x >= fNPhi ) return fNPhi-1;
+  return Int_t(x);
+}
+
+//_____________________________________________________________________________________
+/// Add to list the particles of the cells overlapping the eta-phi region.
+/// The phi range can extend below 0 or above 2pi, the cells on the other side are then used.
+/// The particles are not checked to be inside the region.
+//_____________________________________________________________________________________
+void AliIsolationConeGrid::GetParticlesInRegion(Float_t etaMin, Float_t etaMax,
+                                                Float_t phiMin, Float_t phiMax, std::vector<Int_t> & list) const
+{
+  if ( fNEta == 0 ) return;
+
+  Int_t row0 = EtaCell(etaMin);
+  Int_t row1 = EtaCell(etaMax);
+
+  Int_t column0 = Int_t(TMath::Floor(phiMin/fPhiStep));
+  Int_t nColumns = Int_t(TMath::Floor(phiMax/fPhiStep)) - column0 + 1;
+  if ( nColumns > fNPhi ) nColumns = fNPhi;
+
+  for(Int_t row = row0; row <= row1; row++)
+  {
+    for(Int_t icol = 0; icol < nColumns; icol++)
+    {
+      Int_t column = (column0+icol) % fNPhi;
+      if ( column < 0 ) column += fNPhi;
+
+      Int_t icell = row*fNPhi+column;
+      for(Int_t k = fCellStart[icell]; k < fCellStart[icell+1]; k++) list.push_back(fCellList[k]);
+    }
+  }
+}
+
+//_____________________________________________________________________________________
+/// \return pT sum of the particles with etaMin < eta < etaMax.
+/// The complete rows inside the range use the row sums, only the boundary rows are looped.
+//_____________________________________________________________________________________
+Float_t AliIsolationConeGrid::SumInEtaRange(Float_t etaMin, Float_t etaMax) const
+{
+  if ( fNEta == 0 || etaMax <= etaMin ) return 0;
+
+  Int_t row0 = EtaCell(etaMin);
+  Int_t row1 = EtaCell(etaMax);
+
+  Double_t sum = 0;
+  for(Int_t row = row0+1; row < row1; row++) sum += fRowSum[row];
+
+  for(Int_t row = row0; row <= row1; row += TMath::Max(row1-row0, 1))
+  {
+    for(Int_t k = fCellStart[row*fNPhi]; k < fCellStart[(row+1)*fNPhi]; k++)
+    {
+      Int_t i = fCellList[k];
+      if ( fEta[i] > etaMin && fEta[i] < etaMax ) sum += fPt[i];
+    }
+  }
+
+  return sum;
+}
+
+//_____________________________________________________________________________________
+/// \return pT sum of the particles with phiMin < phi < phiMax, no wrapping around 2pi.
+/// The complete columns inside the range use the column sums, only the boundary columns are looped.
+//_____________________________________________________________________________________
+Float_t AliIsolationConeGrid::SumInPhiRange(Float_t phiMin, Float_t phiMax) const
+{
+  if ( fNEta == 0 || phiMax <= phiMin ) return 0;
+
+  Int_t column0 = PhiCell(phiMin);
+  Int_t column1 = PhiCell(phiMax);
+
+  Double_t sum = 0;
+  for(Int_t column = column0+1; column < column1; column++) sum += fColumnSum[column];
+
+  for(Int_t column = column0; column <= column1; column += TMath::Max(column1-column0, 1))
+  {
+    for(Int_t row = 0; row < fNEta; row++)
+    {
+      Int_t icell = row*fNPhi+column;
+      for(Int_t k = fCellStart[icell]; k < fCellStart[icell+1]; k++)
+      {
+        Int_t i = fCellList[k];
+        if ( fPhi[i] > phiMin && fPhi[i] < phiMax ) sum += fPt[i];
+      }
+    }
+  }
+
+  return sum;
+}
+
+//_____________________________________________________________________________________
+/// \return index of the particle with this track or cluster ID, -1 if not found.
+//_____________________________________________________________________________________
+Int_t AliIsolationConeGrid::FindID(Int_t id) const
+{
+  std::map<Int_t,Int_t>::const_iterator it = fIDIndex.find(id);
+  if ( it == fIDIndex.end() ) return -1;
+  return it->second;
+}
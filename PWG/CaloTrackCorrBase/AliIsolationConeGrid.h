@@ -0,0 +1,100 @@
+#ifndef ALIISOLATIONCONEGRID_H
+#define ALIISOLATIONCONEGRID_H
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice     */
+
+//_________________________________________________________________________
+/// \class AliIsolationConeGrid
+/// \ingroup CaloTrackCorrelationsBase
+/// \brief Eta-phi cell index of the tracks or clusters of an event, used for the isolation cone sums.
+///
+/// The kinematics of the filtered tracks or clusters of the event are stored once,
+/// sorted in eta-phi cells. The pT sums per cell, per eta row and per phi column
+/// are computed when the index is built, so that the cone and UE band sums of
+/// AliIsolationCut only look at the particles in the cells around the candidate
+/// and at the boundary rows/columns of the bands, whatever the number of
+/// candidates and cone sizes studied in the event.
+///
+/// Phi is expected in [0, 2pi[, as in AliIsolationCut.
+//_________________________________________________________________________
+
+#include <map>
+#include <vector>
+
+#include <TObject.h>
+
+class AliIsolationConeGrid : public TObject {
+
+ public:
+
+  AliIsolationConeGrid() ;
+
+  /// Virtual destructor.
+  virtual ~AliIsolationConeGrid() { ; }
+
+  void       Clear(Option_t * opt = "") ;
+
+  Bool_t     IsSource(const TObject * list, Int_t nEntries, Int_t event, Int_t config) const ;
+
+  void       SetSource(const TObject * list, Int_t nEntries, Int_t event, Int_t config) ;
+
+  void       Add(TObject * obj, Float_t pt, Float_t eta, Float_t phi, Int_t id, Bool_t hasID = kTRUE) ;
+
+  void       Build() ;
+
+  void       GetParticlesInRegion(Float_t etaMin, Float_t etaMax,
+                                  Float_t phiMin, Float_t phiMax, std::vector<Int_t> & list) const ;
+
+  Float_t    SumInEtaRange(Float_t etaMin, Float_t etaMax) const ;
+
+  Float_t    SumInPhiRange(Float_t phiMin, Float_t phiMax) const ;
+
+  Int_t      FindID(Int_t id) const ;
+
+  Int_t      GetNParticles()   const { return fPt.size()   ; }
+  Float_t    GetPt (Int_t i)   const { return fPt [i]      ; }
+  Float_t    GetEta(Int_t i)   const { return fEta[i]      ; }
+  Float_t    GetPhi(Int_t i)   const { return fPhi[i]      ; }
+  TObject *  GetObject(Int_t i)const { return fObject[i]   ; }
+
+ private:
+
+  Int_t      EtaCell(Float_t eta) const ;
+
+  Int_t      PhiCell(Float_t phi) const ;
+
+  const TObject *        fSource;      //!<! List the index was built from.
+  Int_t                  fNEntries;    //!<! Number of entries of the list the index was built from.
+  Int_t                  fEvent;       //!<! Event number the index was built for.
+  Int_t                  fConfig;      //!<! Selection configuration the index was built with.
+
+  Float_t                fEtaMin;      //!<! Lower eta edge of the first row.
+  Float_t                fEtaStep;     //!<! Eta size of the cells.
+  Float_t                fPhiStep;     //!<! Phi size of the cells.
+  Int_t                  fNEta;        //!<! Number of eta rows.
+  Int_t                  fNPhi;        //!<! Number of phi columns.
+
+  std::vector<Float_t>   fPt;          //!<! pT of each particle.
+  std::vector<Float_t>   fEta;         //!<! Eta of each particle.
+  std::vector<Float_t>   fPhi;         //!<! Phi of each particle.
+  std::vector<TObject*>  fObject;      //!<! Track or cluster of each particle.
+  std::map<Int_t,Int_t>  fIDIndex;     //!<! Particle index of each track/cluster ID.
+
+  std::vector<Int_t>     fCellStart;   //!<! First entry of each cell (row*fNPhi+column) in fCellList.
+  std::vector<Int_t>     fCellList;    //!<! Particle indices sorted by cell.
+  std::vector<Double_t>  fRowSum;      //!<! pT sum per eta row.
+  std::vector<Double_t>  fColumnSum;   //!<! pT sum per phi column.
+
+  /// Copy constructor not implemented.
+  AliIsolationConeGrid(              const AliIsolationConeGrid & g) ;
+
+  /// Assignment operator not implemented.
+  AliIsolationConeGrid & operator = (const AliIsolationConeGrid & g) ;
+
+  /// \cond CLASSIMP
+  ClassDef(AliIsolationConeGrid,1) ;
+  /// \endcond
+
+} ;
+
+#endif //ALIISOLATIONCONEGRID_H
@@ -14,6 +14,7 @@
  **************************************************************************/
 
 // --- ROOT system ---
+#include <algorithm>
 #include <TObjArray.h>
 
 // --- AliRoot system ---
@@ -31,6 +32,7 @@
 #include "AliCaloPID.h"
 #include "AliFiducialCut.h"
 #include "AliIsolationCut.h"
+#include "AliIsolationConeGrid.h"
 
 /// \cond CLASSIMP
 ClassImp(AliIsolationCut) ;
@@ -53,12 +55,25 @@ fDebug(0),
 fFracIsThresh(1),
 fIsTMClusterInConeRejected(1),
 fDistMinToTrigger(-1.),
+fUseConeGrid(kTRUE),
 fMomentum(),
-fTrackVector()
+fTrackVector(),
+fTrackGrid(0x0),
+fClusterGrid(0x0),
+fGridParticles()
 {
   InitParameters();
 }
 
+//____________________________________
+/// Destructor.
+//____________________________________
+AliIsolationCut::~AliIsolationCut()
+{
+  delete fTrackGrid;
+  delete fClusterGrid;
+}
+
 //_________________________________________________________________________________________________________________________________
 /// Get normalization of cluster background band.
 //_________________________________________________________________________________________________________________________________
@@ -453,11 +468,56 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   Int_t       ntrackrefs   = 0;
   Int_t       nclusterrefs = 0;
   
+  // --------------------------------
+  // Use the eta-phi index of the reader lists, built once per event,
+  // instead of looping over all the tracks/clusters for each candidate.
+  // The UE bands are only needed for the background subtraction method.
+  // --------------------------------
+  
+  Bool_t doBands        = (fICMethod == kSumBkgSubIC);
+  Bool_t trackGridUsed   = kFALSE;
+  Bool_t clusterGridUsed = kFALSE;
+  
+  if(fUseConeGrid && plCTS && plCTS == reader->GetCTSTracks() &&
+     (fPartInCone==kOnlyCharged || fPartInCone==kNeutralAndCharged))
+  {
+    FillTrackGrid(plCTS, reader);
+    
+    // In case of isolation of single tracks or conversion photon (2 tracks) or pi0 (4 tracks),
+    // do not count the candidate or the daughters of the candidate
+    Int_t excluded[4];
+    Int_t nExcluded = 0;
+    if ( pCandidate->GetDetectorTag() == AliFiducialCut::kCTS )
+    {
+      for(Int_t i = 0; i < 4; i++) excluded[nExcluded++] = pCandidate->GetTrackLabel(i);
+    }
+    
+    ConeSumFromGrid(fTrackGrid, excluded, nExcluded, etaC, phiC, doBands,
+                    coneptsumTrack, ptLead, etaBandPtSumTrack, phiBandPtSumTrack,
+                    bFillAOD, aodArrayRefName+"Tracks", reftracks);
+    trackGridUsed = kTRUE;
+  }
+  
+  if(fUseConeGrid && plNe &&
+     (plNe == reader->GetEMCALClusters() || plNe == reader->GetDCALClusters() || plNe == reader->GetPHOSClusters()) &&
+     (fPartInCone==kOnlyNeutral || fPartInCone==kNeutralAndCharged))
+  {
+    FillClusterGrid(plNe, reader, pid);
+    
+    // Do not count the candidate (photon or pi0) or the daughters of the candidate
+    Int_t excluded[2] = { pCandidate->GetCaloLabel(0), pCandidate->GetCaloLabel(1) };
+    
+    ConeSumFromGrid(fClusterGrid, excluded, 2, etaC, phiC, doBands,
+                    coneptsumCluster, ptLead, etaBandPtSumCluster, phiBandPtSumCluster,
+                    bFillAOD, aodArrayRefName+"Clusters", refclusters);
+    clusterGridUsed = kTRUE;
+  }
+  
   // --------------------------------
   // Check charged tracks in cone.
   // --------------------------------
   
-  if(plCTS &&
+  if(plCTS && !trackGridUsed &&
      (fPartInCone==kOnlyCharged || fPartInCone==kNeutralAndCharged))
   {
     for(Int_t ipr = 0;ipr < plCTS->GetEntries() ; ipr ++ )
@@ -602,7 +662,7 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   // Check calorimeter clusters in cone.
   // --------------------------------
   
-  if(plNe &&
+  if(plNe && !clusterGridUsed &&
      (fPartInCone==kOnlyNeutral || fPartInCone==kNeutralAndCharged))
   {
     
@@ -878,6 +938,231 @@ void  AliIsolationCut::MakeIsolationCut(TObjArray * plCTS,
   }
 }
 
+//________________________________________________________________________________
+/// Build the eta-phi index of the reader track list, if not done yet for this event.
+///
+/// \param plCTS: List of tracks, as filtered by the reader.
+/// \param reader: pointer to AliCaloTrackReader. Needed to access event info.
+//________________________________________________________________________________
+void AliIsolationCut::FillTrackGrid(TObjArray * plCTS, AliCaloTrackReader * reader)
+{
+  if ( !fTrackGrid ) fTrackGrid = new AliIsolationConeGrid();
+  
+  Int_t nTracks = plCTS->GetEntries();
+  
+  if ( fTrackGrid->IsSource(plCTS, nTracks, reader->GetEventNumber(), 0) ) return;
+  
+  fTrackGrid->Clear();
+  fTrackGrid->SetSource(plCTS, nTracks, reader->GetEventNumber(), 0);
+  
+  for(Int_t ipr = 0;ipr < nTracks ; ipr ++ )
+  {
+    AliVTrack* track = dynamic_cast<AliVTrack*>(plCTS->At(ipr)) ;
+    
+    if(track)
+    {
+      fTrackVector.SetXYZ(track->Px(),track->Py(),track->Pz());
+      Float_t phi = fTrackVector.Phi() ;
+      if ( phi < 0 ) phi+=TMath::TwoPi();
+      
+      // needed instead of track->GetID() since AOD needs some manipulations
+      fTrackGrid->Add(track, fTrackVector.Pt(), fTrackVector.Eta(), phi, reader->GetTrackID(track));
+    }
+    else
+    {// Mixed event stored in AliCaloTrackParticles
+      AliCaloTrackParticle * trackmix = dynamic_cast<AliCaloTrackParticle*>(plCTS->At(ipr)) ;
+      if(!trackmix)
+      {
+        AliWarning("Wrong track data type, continue");
+        continue;
+      }
+      
+      Float_t phi = trackmix->Phi() ;
+      if ( phi < 0 ) phi+=TMath::TwoPi();
+      
+      fTrackGrid->Add(trackmix, trackmix->Pt(), trackmix->Eta(), phi, -1, kFALSE);
+    }
+  }
+  
+  fTrackGrid->Build();
+}
+
+//________________________________________________________________________________
+/// Build the eta-phi index of the reader cluster list, if not done yet for this event.
+/// The clusters matched with tracks are not stored when they are rejected from the cone.
+///
+/// \param plNe: List of clusters, as filtered by the reader.
+/// \param reader: pointer to AliCaloTrackReader. Needed to access event info.
+/// \param pid: pointer to AliCaloPID. Needed to reject matched clusters in isolation cone.
+//________________________________________________________________________________
+void AliIsolationCut::FillClusterGrid(TObjArray * plNe, AliCaloTrackReader * reader, AliCaloPID * pid)
+{
+  if ( !fClusterGrid ) fClusterGrid = new AliIsolationConeGrid();
+  
+  Int_t nClusters = plNe->GetEntries();
+  
+  Bool_t rejectTM = fIsTMClusterInConeRejected && fPartInCone == kNeutralAndCharged;
+  
+  if ( fClusterGrid->IsSource(plNe, nClusters, reader->GetEventNumber(), rejectTM) ) return;
+  
+  fClusterGrid->Clear();
+  fClusterGrid->SetSource(plNe, nClusters, reader->GetEventNumber(), rejectTM);
+  
+  for(Int_t ipr = 0;ipr < nClusters ; ipr ++ )
+  {
+    AliVCluster * calo = dynamic_cast<AliVCluster *>(plNe->At(ipr)) ;
+    
+    if(calo)
+    {
+      // Get the index where the cluster comes, to retrieve the corresponding vertex
+      Int_t evtIndex = 0 ;
+      if (reader->GetMixedEvent())
+        evtIndex=reader->GetMixedEvent()->EventIndexForCaloCluster(calo->GetID()) ;
+      
+      // Skip matched clusters with tracks in case of neutral+charged analysis
+      if( rejectTM && pid->IsTrackMatched(calo,reader->GetCaloUtils(),reader->GetInputEvent()) ) continue ;
+      
+      // Assume that come from vertex in straight line
+      calo->GetMomentum(fMomentum,reader->GetVertex(evtIndex)) ;
+      
+      Float_t phi = fMomentum.Phi() ;
+      if ( phi < 0 ) phi+=TMath::TwoPi();
+      
+      fClusterGrid->Add(calo, fMomentum.Pt(), fMomentum.Eta(), phi, calo->GetID());
+    }
+    else
+    {// Mixed event stored in AliCaloTrackParticles
+      AliCaloTrackParticle * calomix = dynamic_cast<AliCaloTrackParticle*>(plNe->At(ipr)) ;
+      if(!calomix)
+      {
+        AliWarning("Wrong calo data type, continue");
+        continue;
+      }
+      
+      Float_t phi = calomix->Phi() ;
+      if ( phi < 0 ) phi+=TMath::TwoPi();
+      
+      fClusterGrid->Add(calomix, calomix->Pt(), calomix->Eta(), phi, -1, kFALSE);
+    }
+  }
+  
+  fClusterGrid->Build();
+}
+
+//________________________________________________________________________________
+/// Sum of pT in the cone and in the UE bands using the eta-phi index of the event.
+/// Same selection as the loops in MakeIsolationCut(): only the cells around the candidate
+/// are looped; the bands are the pT sums of the eta/phi strips, taken from the row/column
+/// sums of the index, minus the particles in the cone or rejected.
+///
+/// \param grid: eta-phi index of the tracks or clusters.
+/// \param excludedIDs: IDs of the candidate and its daughters, not counted.
+/// \param nExcluded: number of IDs in excludedIDs.
+/// \param etaC: pseudorapidity of candidate particle.
+/// \param phiC: azimuthal angle of candidate particle, in [0, 2pi[.
+/// \param doBands: compute the UE band sums.
+/// \param coneptsum: sum of pT in cone, incremented.
+/// \param ptLead: pT of leading particle in cone, updated.
+/// \param etaBandPtSum: sum of pT in eta band, incremented.
+/// \param phiBandPtSum: sum of pT in phi band, incremented.
+/// \param bFillAOD: Indicate if particles in cone must be added to the reference array.
+/// \param refName: Name of the reference array.
+/// \param refs: reference array, created if needed.
+//________________________________________________________________________________
+void AliIsolationCut::ConeSumFromGrid(const AliIsolationConeGrid * grid, const Int_t * excludedIDs, Int_t nExcluded,
+                                      Float_t etaC, Float_t phiC, Bool_t doBands,
+                                      Float_t & coneptsum, Float_t & ptLead,
+                                      Float_t & etaBandPtSum, Float_t & phiBandPtSum,
+                                      Bool_t bFillAOD, TString refName, TObjArray *& refs)
+{
+  // Index of the candidate and daughters in the grid
+  Int_t excluded[4];
+  Int_t nExcludedIndex = 0;
+  for(Int_t i = 0; i < nExcluded && i < 4; i++)
+  {
+    Int_t index = grid->FindID(excludedIDs[i]);
+    if ( index < 0 ) continue;
+    
+    Bool_t found = kFALSE;
+    for(Int_t j = 0; j < nExcludedIndex; j++) if ( excluded[j] == index ) found = kTRUE;
+    if ( !found ) excluded[nExcludedIndex++] = index;
+  }
+  
+  // Particles in the cells that can be at less than the cone size or the minimum distance to the candidate,
+  // in the order of the input list
+  Float_t rMax = TMath::Max(fConeSize, fDistMinToTrigger);
+  fGridParticles.clear();
+  grid->GetParticlesInRegion(etaC-rMax, etaC+rMax, phiC-rMax, phiC+rMax, fGridParticles);
+  std::sort(fGridParticles.begin(), fGridParticles.end());
+  
+  // ** For the background out of cone **
+  // All the particles in the strips, the ones in the cone or rejected are removed below
+  if ( doBands )
+  {
+    phiBandPtSum += grid->SumInEtaRange(etaC-fConeSize, etaC+fConeSize);
+    etaBandPtSum += grid->SumInPhiRange(phiC-fConeSize, phiC+fConeSize);
+  }
+  
+  for(UInt_t ip = 0; ip < fGridParticles.size(); ip++)
+  {
+    Int_t   i   = fGridParticles[ip];
+    Float_t pt  = grid->GetPt (i);
+    Float_t eta = grid->GetEta(i);
+    Float_t phi = grid->GetPhi(i);
+    
+    Bool_t rejected = kFALSE;
+    for(Int_t j = 0; j < nExcludedIndex; j++) if ( excluded[j] == i ) rejected = kTRUE;
+    
+    Float_t rad = Radius(etaC, phiC, eta, phi);
+    
+    // ** Exclude particles too close to the candidate, inactive by default **
+    if ( rad < fDistMinToTrigger ) rejected = kTRUE;
+    
+    if ( doBands && (rejected || rad <= fConeSize) )
+    {
+      if(eta > (etaC-fConeSize) && eta < (etaC+fConeSize)) phiBandPtSum -= pt;
+      if(phi > (phiC-fConeSize) && phi < (phiC+fConeSize)) etaBandPtSum -= pt;
+    }
+    
+    if ( rejected || rad >= fConeSize ) continue ;
+    
+    // Only the particles at the same side of candidate
+    if(TMath::Abs(phi-phiC) > TMath::PiOver2()) continue ;
+    
+    AliDebug(2,Form("\t Particle %d, pT %2.2f, eta %1.2f, phi %2.2f, R candidate %2.2f, inside candidate cone", i,pt,eta,phi,rad));
+    
+    if(bFillAOD)
+    {
+      if(!refs)
+      {
+        refs = new TObjArray(0);
+        refs->SetName(refName);
+        refs->SetOwner(kFALSE);
+      }
+      refs->Add(grid->GetObject(i));
+    }
+    
+    coneptsum+=pt;
+    
+    if( ptLead < pt ) ptLead = pt;
+  }
+  
+  // Rejected particles outside the cells looped above are still in the band sums
+  if ( doBands )
+  {
+    for(Int_t j = 0; j < nExcludedIndex; j++)
+    {
+      if ( std::binary_search(fGridParticles.begin(), fGridParticles.end(), excluded[j]) ) continue;
+      
+      Float_t pt  = grid->GetPt (excluded[j]);
+      Float_t eta = grid->GetEta(excluded[j]);
+      Float_t phi = grid->GetPhi(excluded[j]);
+      if(eta > (etaC-fConeSize) && eta < (etaC+fConeSize)) phiBandPtSum -= pt;
+      if(phi > (phiC-fConeSize) && phi < (phiC+fConeSize)) etaBandPtSum -= pt;
+    }
+  }
+}
+
 //_____________________________________________________
 /// Print some relevant parameters set for the analysis.
 //_____________________________________________________
@@ -896,6 +1181,7 @@ void AliIsolationCut::Print(const Option_t * opt) const
   printf("particle type in cone =  %d\n",    fPartInCone ) ;
   printf("using fraction for high pt leading instead of frac ? %i\n",fFracIsThresh);
   printf("minimum distance to candidate, R>%1.2f\n",fDistMinToTrigger);
+  printf("use eta-phi cell index for cone sums ? %d\n",fUseConeGrid);
   printf("    \n") ;
 }
 
@@ -19,6 +19,7 @@
 //_________________________________________________________________________
 
 // --- ROOT system ---
+#include <vector>
 #include <TObject.h>
 class TObjArray ;
 #include <TLorentzVector.h>
@@ -27,6 +28,7 @@ class TObjArray ;
 class AliCaloTrackParticleCorrelation ;
 class AliCaloTrackReader ;
 class AliCaloPID;
+class AliIsolationConeGrid;
 
 class AliIsolationCut : public TObject {
 
@@ -34,8 +36,7 @@ class AliIsolationCut : public TObject {
 
   AliIsolationCut() ;  // default ctor
 
-  /// Virtual destructor.
-  virtual ~AliIsolationCut() { ; }
+  virtual ~AliIsolationCut() ;
 
   // Enums
 
@@ -96,6 +97,7 @@ class AliIsolationCut : public TObject {
   Int_t      GetDebug()               const { return fDebug          ; }
   Bool_t     GetFracIsThresh()        const { return fFracIsThresh   ; }
   Float_t    GetMinDistToTrigger()    const { return fDistMinToTrigger ; }
+  Bool_t     IsConeGridUsed()         const { return fUseConeGrid    ; }
 
   void       SetConeSize(Float_t r)                            { fConeSize          = r    ; }
   void       SetPtThreshold(Float_t pt)                        { fPtThreshold       = pt   ; }
@@ -109,9 +111,20 @@ class AliIsolationCut : public TObject {
   void       SetFracIsThresh(Bool_t f )                        { fFracIsThresh      = f    ; }
   void       SetTrackMatchedClusterRejectionInCone(Bool_t tm)  { fIsTMClusterInConeRejected = tm ; }
   void       SetMinDistToTrigger(Float_t md)                   { fDistMinToTrigger  = md   ; }
+  void       SetUseConeGrid(Bool_t use)                        { fUseConeGrid       = use  ; }
     
  private:
 
+  void       FillTrackGrid  (TObjArray * plCTS, AliCaloTrackReader * reader) ;
+
+  void       FillClusterGrid(TObjArray * plNe,  AliCaloTrackReader * reader, AliCaloPID * pid) ;
+
+  void       ConeSumFromGrid(const AliIsolationConeGrid * grid, const Int_t * excludedIDs, Int_t nExcluded,
+                             Float_t etaC, Float_t phiC, Bool_t doBands,
+                             Float_t & coneptsum, Float_t & ptLead,
+                             Float_t & etaBandPtSum, Float_t & phiBandPtSum,
+                             Bool_t bFillAOD, TString refName, TObjArray *& refs) ;
+
   Float_t    fConeSize ;         ///< Size of the isolation cone
 
   Float_t    fPtThreshold ;      ///< Minimum pt of the particles in the cone or sum in cone (UE pt mean in the forward region cone)
@@ -136,10 +149,18 @@ class AliIsolationCut : public TObject {
   
   Float_t    fDistMinToTrigger;  ///<  Minimal distance between isolation candidate particle and particles in cone to count them for this isolation.
   
+  Bool_t     fUseConeGrid;       ///< Use an eta-phi cell index of the reader track and cluster lists, built once per event, for the cone and UE band sums.
+
   TLorentzVector fMomentum;      //!<! Momentum of cluster, temporal object.
 
   TVector3   fTrackVector;       //!<! Track moment, temporal object.
 
+  AliIsolationConeGrid * fTrackGrid;   //!<! Eta-phi index of the reader tracks of the current event.
+
+  AliIsolationConeGrid * fClusterGrid; //!<! Eta-phi index of the reader clusters of the current event.
+
+  std::vector<Int_t> fGridParticles;   //!<! Particles in the cells around the candidate, temporal object.
+
   /// Copy constructor not implemented.
   AliIsolationCut(              const AliIsolationCut & g) ;
 
@@ -147,7 +168,7 @@ class AliIsolationCut : public TObject {
   AliIsolationCut & operator = (const AliIsolationCut & g) ; 
 
   /// \cond CLASSIMP
-  ClassDef(AliIsolationCut,11) ;
+  ClassDef(AliIsolationCut,12) ;
   /// \endcond
 
 } ;
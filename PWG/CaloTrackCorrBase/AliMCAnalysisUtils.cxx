@@ -23,6 +23,7 @@
 //---- ANALYSIS system ----
 #include "AliMCAnalysisUtils.h"
 #include "AliMCEvent.h"
+#include "AliMCGenealogyIndex.h"
 #include "AliGenPythiaEventHeader.h"
 #include "AliVParticle.h"
 #include "AliLog.h"
@@ -234,25 +235,32 @@ Int_t AliMCAnalysisUtils::CheckOrigin(const Int_t *labels, Int_t nlabels,
   
   // Most significant particle contributing to the cluster
   Int_t label=labels[0];
+  
+  // Mother labels, PDG codes and primary flags are resolved once per event
+  // by the shared genealogy index, the particles are only accessed for the status
+  AliMCGenealogyIndex * genealogy = AliMCGenealogyIndex::Instance();
+  genealogy->Update(const_cast<AliMCEvent*>(mcevent));
     
   // Mother
   AliVParticle * mom = mcevent->GetTrack(label);
   Int_t iMom     = label;
-  Int_t mPdgSign = mom->PdgCode();
+  Int_t mPdgSign = genealogy->GetPdgCode(label);
   Int_t mPdg     = TMath::Abs(mPdgSign);
   Int_t mStatus  = mom->MCStatusCode() ;
-  Int_t iParent  = mom->GetMother() ;
+  Int_t iParent  = genealogy->GetMother(label) ;
   
   //if(label < 8 && fMCGenerator != kBoxLike) AliDebug(1,Form("Mother is parton %d\n",iParent));
   
   //GrandParent
   AliVParticle * parent = NULL ;
+  Int_t iParentP = -1; // label of parent
   Int_t pPdg    =-1;
   Int_t pStatus =-1;
   if(iParent >= 0)
   {
     parent = mcevent->GetTrack(iParent);
-    pPdg = TMath::Abs(parent->PdgCode());
+    iParentP = iParent;
+    pPdg = TMath::Abs(genealogy->GetPdgCode(iParent));
     pStatus = parent->MCStatusCode();  
   }
   else AliDebug(1,Form("Parent with label %d",iParent));
@@ -269,10 +277,11 @@ Int_t AliMCAnalysisUtils::CheckOrigin(const Int_t *labels, Int_t nlabels,
     SetTagBit(tag,kMCConversion);
     
     // Check if the mother is photon or electron with status not stable
-    while ((pPdg == 22 || pPdg == 11) && !mom->IsPhysicalPrimary())
+    Int_t iMomP = iMom; // label of mom
+    while ((pPdg == 22 || pPdg == 11) && !genealogy->IsPhysicalPrimary(iMomP))
     {
       // Mother
-      iMom  = mom->GetMother();
+      iMom  = genealogy->GetMother(iMomP);
       
       if(iMom < 0) 
       {
@@ -280,25 +289,32 @@ Int_t AliMCAnalysisUtils::CheckOrigin(const Int_t *labels, Int_t nlabels,
         break;
       }
       
-      mom      = mcevent->GetTrack(iMom);
-      mPdgSign = mom->PdgCode();
+      iMomP    = iMom;
+      mPdgSign = genealogy->GetPdgCode(iMom);
       mPdg     = TMath::Abs(mPdgSign);
-      mStatus  = mom->MCStatusCode() ;
-      iParent  = mom->GetMother() ;
+      iParent  = genealogy->GetMother(iMom) ;
       //if(label < 8 ) AliDebug(1, Form("AliMCAnalysisUtils::CheckOriginInAOD() - Mother is parton %d\n",iParent));
       
       // GrandParent
       if(iParent >= 0 && parent)
       {
-        parent = mcevent->GetTrack(iParent);
-        pPdg = TMath::Abs(parent->PdgCode());
-        pStatus = parent->MCStatusCode();  
+        iParentP = iParent;
+        pPdg = TMath::Abs(genealogy->GetPdgCode(iParent));
       }
-      // printf("\t While Mother label %d, pdg %d, Primary? %d, Physical Primary? %d\n",iMom, mPdg, mom->IsPrimary(), mom->IsPhysicalPrimary());
-      // printf("\t While Parent label %d, pdg %d, Primary? %d, Physical Primary? %d\n",iParent, pPdg, parent->IsPrimary(), parent->IsPhysicalPrimary()); 
+      // printf("\t While Mother label %d, pdg %d, Physical Primary? %d\n",iMom, mPdg, genealogy->IsPhysicalPrimary(iMom));
+      // printf("\t While Parent label %d, pdg %d, Physical Primary? %d\n",iParent, pPdg, genealogy->IsPhysicalPrimary(iParent)); 
       
     }//while	
     
+    // particles at the end of the chain
+    mom     = mcevent->GetTrack(iMomP);
+    mStatus = mom->MCStatusCode() ;
+    if(parent)
+    {
+      parent  = mcevent->GetTrack(iParentP);
+      pStatus = parent->MCStatusCode();
+    }
+    
     AliDebug(2,"Converted photon/electron:");
     AliDebug(2,Form("\t Mother label %d, pdg %d, status %d, Primary? %d, Physical Primary? %d"
                     ,iMom   , mPdg, mStatus, mom->IsPrimary()             , mom->IsPhysicalPrimary()));
@@ -313,7 +329,7 @@ Int_t AliMCAnalysisUtils::CheckOrigin(const Int_t *labels, Int_t nlabels,
        pPdg == 2212 ||  pPdg == 130 ||  pPdg == 13 )
     {
       SetTagBit(tag,kMCConversion);
-      iMom     = mom->GetMother();
+      iMom     = genealogy->GetMother(iMom);
       
       if(iMom < 0) 
       {
@@ -322,7 +338,7 @@ Int_t AliMCAnalysisUtils::CheckOrigin(const Int_t *labels, Int_t nlabels,
       else
       {
         mom      = mcevent->GetTrack(iMom);
-        mPdgSign = mom->PdgCode();
+        mPdgSign = genealogy->GetPdgCode(iMom);
         mPdg     = TMath::Abs(mPdgSign);
         mStatus  = mom->MCStatusCode() ;
 
@@ -480,11 +496,10 @@ Int_t AliMCAnalysisUtils::CheckOrigin(const Int_t *labels, Int_t nlabels,
     //electron
     if(pPdg == 11 && parent)
     {
-      Int_t iGrandma = parent->GetMother();
+      Int_t iGrandma = genealogy->GetMother(iParentP);
       if(iGrandma >= 0)
       {
-        AliVParticle * gma = mcevent->GetTrack(iGrandma);
-        Int_t gPdg = TMath::Abs(gma->PdgCode());
+        Int_t gPdg = TMath::Abs(genealogy->GetPdgCode(iGrandma));
         
         if      (gPdg == 23) { SetTagBit(tag,kMCZDecay); } //parent is Z-boson
         else if (gPdg == 24) { SetTagBit(tag,kMCWDecay); } //parent is W-boson
@@ -503,11 +518,10 @@ Int_t AliMCAnalysisUtils::CheckOrigin(const Int_t *labels, Int_t nlabels,
       //c-hadron decay check
       if(parent)
       {
-        Int_t iGrandma = parent->GetMother();
+        Int_t iGrandma = genealogy->GetMother(iParentP);
         if(iGrandma >= 0)
         {
-          AliVParticle * gma = mcevent->GetTrack(iGrandma); //charm's mother
-          Int_t gPdg = TMath::Abs(gma->PdgCode());
+          Int_t gPdg = TMath::Abs(genealogy->GetPdgCode(iGrandma)); //charm's mother
           if((499 < gPdg && gPdg < 600)||(4999 < gPdg && gPdg < 6000)) SetTagBit(tag,kMCEFromCFromB); //b-->c-->e decay
           else SetTagBit(tag,kMCEFromC); //c-hadron decay
         }
@@ -41,7 +41,16 @@ AliNanoAODTrack::AliNanoAODTrack() :
   fLabel(0),
   fProdVertex(0),
   fCharge(0),
-  fAODEvent(NULL)
+  fAODEvent(NULL),
+  fKinPt(0),
+  fKinPhi(0),
+  fKinTheta(0),
+  fKinPx(0),
+  fKinPy(0),
+  fKinPz(0),
+  fKinP(0),
+  fKinEta(0),
+  fKinCached(kFALSE)
 {
   // default constructor
   // The default constructor should not allocate memory! You risk an infinite loop here.
@@ -63,7 +72,16 @@ AliNanoAODTrack::AliNanoAODTrack(AliAODTrack * aodTrack, const char * vars) :
   fLabel(0),
   fProdVertex(0),
   fCharge(0),
-  fAODEvent(NULL)
+  fAODEvent(NULL),
+  fKinPt(0),
+  fKinPhi(0),
+  fKinTheta(0),
+  fKinPx(0),
+  fKinPy(0),
+  fKinPz(0),
+  fKinP(0),
+  fKinEta(0),
+  fKinCached(kFALSE)
 {
   // constructor
 
@@ -145,7 +163,16 @@ AliNanoAODTrack::AliNanoAODTrack(AliESDTrack * /*esdTrack*/, const char * /*vars
   fLabel(0),
   fProdVertex(0),
   fCharge(0),
-  fAODEvent(NULL)
+  fAODEvent(NULL),
+  fKinPt(0),
+  fKinPhi(0),
+  fKinTheta(0),
+  fKinPx(0),
+  fKinPy(0),
+  fKinPz(0),
+  fKinP(0),
+  fKinEta(0),
+  fKinCached(kFALSE)
 {
   // ctor: Creates a special track by copying the requested variables from an ESD track
   AliFatal("To be Implemented");
@@ -158,7 +185,16 @@ AliNanoAODTrack::AliNanoAODTrack(const char * vars) :
   fLabel(0),
   fProdVertex(0),
   fCharge(0),
-  fAODEvent(NULL)
+  fAODEvent(NULL),
+  fKinPt(0),
+  fKinPhi(0),
+  fKinTheta(0),
+  fKinPx(0),
+  fKinPy(0),
+  fKinPz(0),
+  fKinP(0),
+  fKinEta(0),
+  fKinCached(kFALSE)
 {
    // ctor: Creates a special track simply allocating the required variables
   AliNanoAODTrackMapping::GetInstance(vars);
@@ -197,7 +233,16 @@ AliNanoAODTrack::AliNanoAODTrack(const AliNanoAODTrack& trk) :
   fLabel(trk.fLabel),
   fProdVertex(trk.fProdVertex),
   fCharge(trk.fCharge),
-  fAODEvent(trk.fAODEvent)
+  fAODEvent(trk.fAODEvent),
+  fKinPt(0),
+  fKinPhi(0),
+  fKinTheta(0),
+  fKinPx(0),
+  fKinPy(0),
+  fKinPz(0),
+  fKinP(0),
+  fKinEta(0),
+  fKinCached(kFALSE)
 {
   // Copy constructor
   // std::cout << "Copy Ctor" << std::endl;
@@ -223,6 +268,7 @@ AliNanoAODTrack& AliNanoAODTrack::operator=(const AliNanoAODTrack& trk)
     fProdVertex = trk.fProdVertex;
     fCharge     = trk.fCharge;
     fAODEvent   = trk.fAODEvent;
+    fKinCached  = kFALSE;
     
   }
 
@@ -560,4 +606,39 @@ void  AliNanoAODTrack::Clear(Option_t * /*opt*/) {
   // empty storage
   fVars.clear();
   fNVars = 0;
+  fKinCached = kFALSE;
+}
+
+//_______________________________________________________
+void AliNanoAODTrack::ComputeKinematics(Double_t pt, Double_t phi, Double_t theta,
+					Double_t &px, Double_t &py, Double_t &pz, Double_t &p, Double_t &eta)
+{
+  // derived kinematics from the stored pt, phi and theta
+  px  = pt * TMath::Cos(phi);
+  py  = pt * TMath::Sin(phi);
+  pz  = pt / TMath::Tan(theta);
+  p   = TMath::Sqrt(pt*pt+pz*pz);
+  eta = -TMath::Log(TMath::Tan(0.5 * theta));
+}
+
+//_______________________________________________________
+void AliNanoAODTrack::UpdateKinematics() const
+{
+  // Fill the cache of the derived kinematics, if the stored pt, phi or
+  // theta changed since it was filled. The stored values are compared
+  // rather than relying only on the setters: tracks are reused by the
+  // TClonesArray when a new event is read, and SetVar does not know
+  // about the cache.
+  AliNanoAODTrackMapping * mapping = AliNanoAODTrackMapping::GetInstance();
+  Double_t pt    = GetVar(mapping->GetPt());
+  Double_t phi   = GetVar(mapping->GetPhi());
+  Double_t theta = GetVar(mapping->GetTheta());
+
+  if (fKinCached && pt == fKinPt && phi == fKinPhi && theta == fKinTheta) return;
+
+  ComputeKinematics(pt, phi, theta, fKinPx, fKinPy, fKinPz, fKinP, fKinEta);
+  fKinPt     = pt;
+  fKinPhi    = phi;
+  fKinTheta  = theta;
+  fKinCached = kTRUE;
 }
@@ -89,11 +89,12 @@ public:
   virtual Double_t Phi()       const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPhi());   }
   virtual Double_t Theta()     const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetTheta()); }
   
-  virtual Double_t Px() const { return Pt() * TMath::Cos(Phi()); }
-  virtual Double_t Py() const { return Pt() * TMath::Sin(Phi()); }
-  virtual Double_t Pz() const { return Pt() / TMath::Tan(Theta()); }
+  // Px, Py, Pz, P and Eta are derived from pt, phi and theta once and cached, see UpdateKinematics()
+  virtual Double_t Px() const { UpdateKinematics(); return fKinPx; }
+  virtual Double_t Py() const { UpdateKinematics(); return fKinPy; }
+  virtual Double_t Pz() const { UpdateKinematics(); return fKinPz; }
   virtual Double_t Pt() const { return GetVar(AliNanoAODTrackMapping::GetInstance()->GetPt()); }
-  virtual Double_t P()  const { return TMath::Sqrt(Pt()*Pt()+Pz()*Pz()); }
+  virtual Double_t P()  const { UpdateKinematics(); return fKinP; }
   virtual Bool_t   PxPyPz(Double_t p[3]) const { p[0] = Px(); p[1] = Py(); p[2] = Pz(); return kTRUE; }
 
   virtual Double_t Xv() const { return GetProdVertex() ? GetProdVertex()->GetX() : -999.; }
@@ -113,7 +114,7 @@ public:
   Double_t Y(AliAODTrack::AODTrkPID_t pid) const;
   Double_t Y(Double_t m) const;
   
-  virtual Double_t Eta() const { return -TMath::Log(TMath::Tan(0.5 * Theta())); }
+  virtual Double_t Eta() const { UpdateKinematics(); return fKinEta; }
   virtual Short_t  Charge() const {return fCharge; } // FIXME: leave like this? Create shorts array?
   virtual Double_t GetSign() const {return fCharge; }
   virtual Bool_t   PropagateToDCA(const AliVVertex *vtx, 
@@ -369,10 +370,15 @@ void SetChi2perNDF(Double_t chi2perNDF) { fVars[AliNanoAODTrackMapping::GetInsta
   virtual Int_t    GetNcls(Int_t /*idet*/) const {AliFatal("Not Implemented"); return 0;}; 
   virtual const Double_t *PID() const {AliFatal("Not Implemented"); return 0;}; 
 
+  // derived kinematics, shared with AliNanoAODTrackColumns
+  static void ComputeKinematics(Double_t pt, Double_t phi, Double_t theta,
+				Double_t &px, Double_t &py, Double_t &pz, Double_t &p, Double_t &eta);
+
 
 
 private :
 
+  void UpdateKinematics() const;
 
 
   // Momentum & position
@@ -383,7 +389,18 @@ private :
   Short_t       fCharge; // track charge
   const AliAODEvent* fAODEvent;     //! 
 
-  ClassDef(AliNanoAODTrack, 1);
+  // cache of the derived kinematics
+  mutable Double_t   fKinPt;        //! pt the cache was computed from
+  mutable Double_t   fKinPhi;       //! phi the cache was computed from
+  mutable Double_t   fKinTheta;     //! theta the cache was computed from
+  mutable Double_t   fKinPx;        //! cached px
+  mutable Double_t   fKinPy;        //! cached py
+  mutable Double_t   fKinPz;        //! cached pz
+  mutable Double_t   fKinP;         //! cached p
+  mutable Double_t   fKinEta;       //! cached eta
+  mutable Bool_t     fKinCached;    //! kTRUE if the cache is filled
+
+  ClassDef(AliNanoAODTrack, 2);
 };
 
 // inline Bool_t  AliNanoAODTrack::IsPrimaryCandidate() const
@@ -0,0 +1,103 @@
+/**************************************************************************
+ * Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+
+//-------------------------------------------------------------------------
+//     Columnar view of the NanoAOD tracks of an event
+//-------------------------------------------------------------------------
+
+#include "TClonesArray.h"
+
+#include "AliNanoAODTrack.h"
+#include "AliNanoAODTrackColumns.h"
+
+ClassImp(AliNanoAODTrackColumns)
+
+//______________________________________________________________________________
+AliNanoAODTrackColumns::AliNanoAODTrackColumns() :
+  TObject(),
+  fTracks(0),
+  fNTracks(0),
+  fNVars(0),
+  fColumns(),
+  fDerived(),
+  fCharge(),
+  fLabel()
+{
+  // default constructor
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrackColumns::Clear(Option_t * /*opt*/)
+{
+  // forget the tracks of the previous event, keeping the allocated memory
+  fTracks  = 0;
+  fNTracks = 0;
+  fColumns.clear();
+  fDerived.clear();
+  fCharge.clear();
+  fLabel.clear();
+}
+
+//______________________________________________________________________________
+void AliNanoAODTrackColumns::Fill(const TClonesArray * tracks)
+{
+  // Copy the variables of the tracks of the event in the columns and
+  // compute the derived kinematics. To be called once per event.
+
+  Clear();
+  if (!tracks) return;
+
+  AliNanoAODTrackMapping * mapping = AliNanoAODTrackMapping::GetInstance();
+
+  fTracks  = tracks;
+  fNTracks = tracks->GetEntriesFast();
+  fNVars   = mapping->GetSize();
+
+  fColumns.resize(fNVars*fNTracks);
+  fDerived.resize(kNDerived*fNTracks);
+  fCharge.resize(fNTracks);
+  fLabel.resize(fNTracks);
+
+  for (Int_t itrack = 0; itrack < fNTracks; itrack++) {
+    const AliNanoAODTrack * track = static_cast<const AliNanoAODTrack*>(tracks->UncheckedAt(itrack));
+    for (Int_t ivar = 0; ivar < fNVars; ivar++) fColumns[ivar*fNTracks+itrack] = track->GetVar(ivar);
+    fCharge[itrack] = track->Charge();
+    fLabel[itrack]  = track->GetLabel();
+  }
+
+  const Double_t * pt    = GetColumn(mapping->GetPt());
+  const Double_t * phi   = GetColumn(mapping->GetPhi());
+  const Double_t * theta = GetColumn(mapping->GetTheta());
+  if (!pt || !phi || !theta) return; // kinematics not stored
+
+  Double_t * px  = &fDerived[kPx*fNTracks];
+  Double_t * py  = &fDerived[kPy*fNTracks];
+  Double_t * pz  = &fDerived[kPz*fNTracks];
+  Double_t * p   = &fDerived[kP*fNTracks];
+  Double_t * eta = &fDerived[kEta*fNTracks];
+  for (Int_t itrack = 0; itrack < fNTracks; itrack++) {
+    AliNanoAODTrack::ComputeKinematics(pt[itrack], phi[itrack], theta[itrack],
+				       px[itrack], py[itrack], pz[itrack], p[itrack], eta[itrack]);
+  }
+}
+
+//______________________________________________________________________________
+AliNanoAODTrack * AliNanoAODTrackColumns::GetTrack(Int_t i) const
+{
+  // track the i-th entry of the columns was filled from
+  if (!fTracks || i < 0 || i >= fNTracks) return 0;
+  return static_cast<AliNanoAODTrack*>(fTracks->UncheckedAt(i));
+}
@@ -0,0 +1,85 @@
+#ifndef AliNanoAODTrackColumns_H
+#define AliNanoAODTrackColumns_H
+/* Copyright(c) 1998-2007, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+
+//-------------------------------------------------------------------------
+//     Columnar view of the NanoAOD tracks of an event
+//
+//     The variables of all the AliNanoAODTrack of the event are copied
+//     once in memory, one contiguous array per variable (in the order
+//     of AliNanoAODTrackMapping), together with the charge, the label
+//     and the derived kinematics (px, py, pz, p, eta), which are
+//     computed once when the event is filled.
+//
+//     Tasks looping over all the tracks can then use the arrays
+//     directly, without the per track virtual calls and mapping lookups:
+//
+//       columns.Fill(nanoTracks); // once per event
+//       const Double_t * pt  = columns.GetPt();
+//       const Double_t * eta = columns.GetEta();
+//       for (Int_t i = 0; i < columns.GetNTracks(); i++) { ... pt[i] ... eta[i] ... }
+//
+//     The arrays are valid until the next call to Fill or Clear.
+//-------------------------------------------------------------------------
+
+#include <vector>
+
+#include "TObject.h"
+#include "AliNanoAODTrackMapping.h"
+
+class TClonesArray;
+class AliNanoAODTrack;
+
+class AliNanoAODTrackColumns : public TObject {
+
+public:
+
+  enum EDerived { kPx, kPy, kPz, kP, kEta, kNDerived };
+
+  AliNanoAODTrackColumns();
+  virtual ~AliNanoAODTrackColumns() {;}
+
+  virtual void Clear(Option_t * opt = "");
+
+  void Fill(const TClonesArray * tracks);
+
+  Int_t GetNTracks() const { return fNTracks; }
+  Int_t GetNVars()   const { return fNVars;   }
+  AliNanoAODTrack * GetTrack(Int_t i) const;
+
+  // contiguous array of variable varIndex (index of AliNanoAODTrackMapping) for all tracks
+  const Double_t * GetColumn(Int_t varIndex) const
+  { return (fNTracks > 0 && varIndex >= 0 && varIndex < fNVars) ? &fColumns[varIndex*fNTracks] : 0; }
+  const Double_t * GetDerived(EDerived var) const
+  { return fNTracks > 0 ? &fDerived[var*fNTracks] : 0; }
+
+  const Double_t * GetPt()    const { return GetColumn(AliNanoAODTrackMapping::GetInstance()->GetPt());    }
+  const Double_t * GetPhi()   const { return GetColumn(AliNanoAODTrackMapping::GetInstance()->GetPhi());   }
+  const Double_t * GetTheta() const { return GetColumn(AliNanoAODTrackMapping::GetInstance()->GetTheta()); }
+  const Double_t * GetPx()    const { return GetDerived(kPx);  }
+  const Double_t * GetPy()    const { return GetDerived(kPy);  }
+  const Double_t * GetPz()    const { return GetDerived(kPz);  }
+  const Double_t * GetP()     const { return GetDerived(kP);   }
+  const Double_t * GetEta()   const { return GetDerived(kEta); }
+  const Short_t  * GetCharge() const { return fNTracks > 0 ? &fCharge[0] : 0; }
+  const Int_t    * GetLabel()  const { return fNTracks > 0 ? &fLabel[0]  : 0; }
+
+private:
+
+  AliNanoAODTrackColumns(const AliNanoAODTrackColumns&); // not implemented
+  AliNanoAODTrackColumns& operator=(const AliNanoAODTrackColumns&); // not implemented
+
+  const TClonesArray *  fTracks;    //! tracks the columns were filled from
+  Int_t                 fNTracks;   //! number of tracks
+  Int_t                 fNVars;     //! number of variables per track
+  std::vector<Double_t> fColumns;   //! variables, fNTracks consecutive values per variable
+  std::vector<Double_t> fDerived;   //! derived kinematics, fNTracks consecutive values per EDerived
+  std::vector<Short_t>  fCharge;    //! charge of each track
+  std::vector<Int_t>    fLabel;     //! label of each track
+
+  ClassDef(AliNanoAODTrackColumns, 1);
+};
+
+#endif
@@ -32,6 +32,7 @@
 #include "AliEMCALTriggerRawPatch.h"
 #include "AliEmcalTriggerMakerKernel.h"
 #include "AliEmcalTriggerSetupInfo.h"
+#include "AliEmcalTriggerSummedAreaPatchFinder.h"
 #include "AliLog.h"
 #include "AliVCaloCells.h"
 #include "AliVCaloTrigger.h"
@@ -50,6 +51,8 @@ AliEmcalTriggerMakerKernel::AliEmcalTriggerMakerKernel():
   fTriggerBitConfig(nullptr),
   fPatchFinder(nullptr),
   fLevel0PatchFinder(nullptr),
+  fSummedAreaPatchFinder(nullptr),
+  fUseSummedAreaTables(kFALSE),
   fL0MinTime(7),
   fL0MaxTime(10),
   fMinCellAmp(0),
@@ -89,6 +92,7 @@ AliEmcalTriggerMakerKernel::~AliEmcalTriggerMakerKernel() {
   delete fTriggerBitMap;
   delete fPatchFinder;
   delete fLevel0PatchFinder;
+  delete fSummedAreaPatchFinder;
   if(fTriggerBitConfig) delete fTriggerBitConfig;
 }
 
@@ -128,6 +132,8 @@ void AliEmcalTriggerMakerKernel::AddL1TriggerAlgorithm(Int_t rowmin, Int_t rowma
   trigger->SetPatchSize(patchSize);
   trigger->SetSubregionSize(subregionSize);
   fPatchFinder->AddTriggerAlgorithm(trigger);
+  if (!fSummedAreaPatchFinder) fSummedAreaPatchFinder = new AliEmcalTriggerSummedAreaPatchFinder;
+  fSummedAreaPatchFinder->AddTriggerAlgorithm(rowmin, rowmax, bitmask, patchSize, subregionSize, kL1AlgorithmGroup);
 }
 
 void AliEmcalTriggerMakerKernel::SetL0TriggerAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize)
@@ -136,6 +142,9 @@ void AliEmcalTriggerMakerKernel::SetL0TriggerAlgorithm(Int_t rowmin, Int_t rowma
   fLevel0PatchFinder = new AliEMCALTriggerAlgorithm<double>(rowmin, rowmax, bitmask);
   fLevel0PatchFinder->SetPatchSize(patchSize);
   fLevel0PatchFinder->SetSubregionSize(subregionSize);
+  if (!fSummedAreaPatchFinder) fSummedAreaPatchFinder = new AliEmcalTriggerSummedAreaPatchFinder;
+  fSummedAreaPatchFinder->RemoveTriggerAlgorithms(kL0AlgorithmGroup);
+  fSummedAreaPatchFinder->AddTriggerAlgorithm(rowmin, rowmax, bitmask, patchSize, subregionSize, kL0AlgorithmGroup);
 }
 
 void AliEmcalTriggerMakerKernel::ConfigureForPbPb2015()
@@ -146,6 +155,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPbPb2015()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  if (fSummedAreaPatchFinder) fSummedAreaPatchFinder->RemoveTriggerAlgorithms(kL1AlgorithmGroup);
 
   SetL0TriggerAlgorithm(0, 103, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -163,6 +173,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP2015()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  if (fSummedAreaPatchFinder) fSummedAreaPatchFinder->RemoveTriggerAlgorithms(kL1AlgorithmGroup);
 
   SetL0TriggerAlgorithm(0, 103, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -180,6 +191,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP20158x8()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  if (fSummedAreaPatchFinder) fSummedAreaPatchFinder->RemoveTriggerAlgorithms(kL1AlgorithmGroup);
 
   SetL0TriggerAlgorithm(0, 103, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -197,6 +209,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPPb2013()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  if (fSummedAreaPatchFinder) fSummedAreaPatchFinder->RemoveTriggerAlgorithms(kL1AlgorithmGroup);
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit() | 1<<fTriggerBitConfig->GetGammaLowBit(), 2, 1);
@@ -212,6 +225,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP2012()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  if (fSummedAreaPatchFinder) fSummedAreaPatchFinder->RemoveTriggerAlgorithms(kL1AlgorithmGroup);
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit(), 2, 1);
@@ -227,6 +241,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPbPb2011()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  if (fSummedAreaPatchFinder) fSummedAreaPatchFinder->RemoveTriggerAlgorithms(kL1AlgorithmGroup);
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   AddL1TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetGammaHighBit(), 2, 1);
@@ -242,6 +257,7 @@ void AliEmcalTriggerMakerKernel::ConfigureForPP2011()
   // Initialize patch finder
   if (fPatchFinder) delete fPatchFinder;
   fPatchFinder = new AliEMCALTriggerPatchFinder<double>;
+  if (fSummedAreaPatchFinder) fSummedAreaPatchFinder->RemoveTriggerAlgorithms(kL1AlgorithmGroup);
 
   SetL0TriggerAlgorithm(0, 63, 1<<fTriggerBitConfig->GetLevel0Bit(), 2, 1);
   fConfigured = true;
@@ -504,8 +520,16 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
   bkgPatchMask = 1 << fTriggerBitConfig->GetBkgBit();
       //l0PatchMask = 1 << fTriggerBitConfig->GetLevel0Bit();
 
+  // With the summed-area tables each data grid is summed once, and the sums are
+  // shared by all the patch types and by the smeared energies
+  Bool_t useSummedArea = fUseSummedAreaTables && fSummedAreaPatchFinder;
+  if (useSummedArea) fSummedAreaPatchFinder->Reset();
+
   std::vector<AliEMCALTriggerRawPatch> patches;
-  if (fPatchFinder) {
+  if (useSummedArea) {
+    patches = fSummedAreaPatchFinder->FindPatches(useL0amp ? *fPatchAmplitudes : *fPatchADC, *fPatchADCSimple, kL1AlgorithmGroup);
+  }
+  else if (fPatchFinder) {
     if (useL0amp) {
       patches = fPatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple);
     }
@@ -548,9 +572,13 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
     if(fPatchEnergySimpleSmeared){
       // Add smeared energy
       double energysmear = 0;
-      for(int icol = 0; icol < fullpatch.GetPatchSize(); icol++){
-        for(int irow = 0; irow < fullpatch.GetPatchSize(); irow++){
-          energysmear += (*fPatchEnergySimpleSmeared)(fullpatch.GetColStart() + icol, fullpatch.GetRowStart() + irow);
+      if(useSummedArea){
+        energysmear = fSummedAreaPatchFinder->GetPatchSum(*fPatchEnergySimpleSmeared, fullpatch.GetColStart(), fullpatch.GetRowStart(), fullpatch.GetPatchSize());
+      } else {
+        for(int icol = 0; icol < fullpatch.GetPatchSize(); icol++){
+          for(int irow = 0; irow < fullpatch.GetPatchSize(); irow++){
+            energysmear += (*fPatchEnergySimpleSmeared)(fullpatch.GetColStart() + icol, fullpatch.GetRowStart() + irow);
+          }
         }
       }
       AliDebugStream(1) << "Patch size(" << fullpatch.GetPatchSize() <<") energy " << fullpatch.GetPatchE() << " smeared " << energysmear << std::endl;
@@ -561,7 +589,8 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
 
   // Find Level0 patches
   std::vector<AliEMCALTriggerRawPatch> l0patches;
-  if (fLevel0PatchFinder) l0patches = fLevel0PatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple);
+  if (useSummedArea) l0patches = fSummedAreaPatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple, kL0AlgorithmGroup);
+  else if (fLevel0PatchFinder) l0patches = fLevel0PatchFinder->FindPatches(*fPatchAmplitudes, *fPatchADCSimple);
   for(std::vector<AliEMCALTriggerRawPatch>::iterator patchit = l0patches.begin(); patchit != l0patches.end(); ++patchit){
     Int_t offlinebits = 0, onlinebits = 0;
     if(HasPHOSOverlap(*patchit)) continue;
@@ -579,9 +608,13 @@ void AliEmcalTriggerMakerKernel::CreateTriggerPatches(const AliVEvent *inputeven
     if(fPatchEnergySimpleSmeared){
       // Add smeared energy
       double energysmear = 0;
-      for(int icol = 0; icol < fullpatch.GetPatchSize(); icol++){
-        for(int irow = 0; irow < fullpatch.GetPatchSize(); irow++){
-          energysmear += (*fPatchEnergySimpleSmeared)(fullpatch.GetColStart() + icol, fullpatch.GetRowStart() + irow);
+      if(useSummedArea){
+        energysmear = fSummedAreaPatchFinder->GetPatchSum(*fPatchEnergySimpleSmeared, fullpatch.GetColStart(), fullpatch.GetRowStart(), fullpatch.GetPatchSize());
+      } else {
+        for(int icol = 0; icol < fullpatch.GetPatchSize(); icol++){
+          for(int irow = 0; irow < fullpatch.GetPatchSize(); irow++){
+            energysmear += (*fPatchEnergySimpleSmeared)(fullpatch.GetColStart() + icol, fullpatch.GetRowStart() + irow);
+          }
         }
       }
       fullpatch.SetSmearedEnergy(energysmear);
@@ -21,6 +21,7 @@ class AliVCaloTrigger;
 class AliVEvent;
 class AliVVZERO;
 class AliEMCALTriggerBitConfig;
+class AliEmcalTriggerSummedAreaPatchFinder;
 template<class T> class AliEMCALTriggerDataGrid;
 template<class T> class AliEMCALTriggerAlgorithm;
 template<class T> class AliEMCALTriggerPatchFinder;
@@ -370,6 +371,17 @@ public:
    */
   void SetL0TriggerAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize);
 
+  /**
+   * @brief Use summed-area tables to find the patches
+   *
+   * The sliding-window sums of all L1 and L0 trigger algorithms (and the
+   * smeared patch energies) are obtained from summed-area tables built once
+   * per data grid and event (see AliEmcalTriggerSummedAreaPatchFinder),
+   * instead of being recomputed by each AliEMCALTriggerAlgorithm.
+   * @param[in] doUse If true the summed-area table patch finder is used
+   */
+  void SetUseSummedAreaTables(Bool_t doUse = kTRUE) { fUseSummedAreaTables = doUse; }
+
   /**
    * @brief Set energy-dependent models for gaussian energy smearing
    * @param[in] mean Parameterization of the mean
@@ -434,6 +446,10 @@ protected:
   enum{
     kColsEta = 48
   };
+  enum{
+    kL1AlgorithmGroup = 0,                  ///< Group of the L1 algorithms in the summed-area table patch finder
+    kL0AlgorithmGroup = 1                   ///< Group of the L0 algorithm in the summed-area table patch finder
+  };
 
   /**
    * @brief Accept trigger patch as Level0 patch.
@@ -480,6 +496,8 @@ protected:
 
   AliEMCALTriggerPatchFinder<double>       *fPatchFinder;                 ///< The actual patch finder
   AliEMCALTriggerAlgorithm<double>         *fLevel0PatchFinder;           ///< Patch finder for Level0 patches
+  AliEmcalTriggerSummedAreaPatchFinder     *fSummedAreaPatchFinder;       ///< Patch finder based on summed-area tables (L1 and L0 algorithms)
+  Bool_t                                    fUseSummedAreaTables;         ///< Switch to find the patches with the summed-area tables
   Int_t                                     fL0MinTime;                   ///< Minimum L0 time
   Int_t                                     fL0MaxTime;                   ///< Maximum L0 time
   Int_t                                     fMinCellAmp;                  ///< Minimum offline amplitude of the cells used to generate the patches
@@ -510,7 +528,7 @@ protected:
   Double_t                                  fADCtoGeV;                    //!<! Conversion factor from ADC to GeV
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalTriggerMakerKernel, 4);
+  ClassDef(AliEmcalTriggerMakerKernel, 5);
   /// \endcond
 };
 
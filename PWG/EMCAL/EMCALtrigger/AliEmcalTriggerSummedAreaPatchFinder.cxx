@@ -0,0 +1,193 @@
+/**************************************************************************
+ * Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include <algorithm>
+
+#include "AliEMCALTriggerDataGrid.h"
+#include "AliEMCALTriggerRawPatch.h"
+#include "AliEmcalTriggerSummedAreaPatchFinder.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalTriggerSummedAreaPatchFinder)
+/// \endcond
+
+AliEmcalTriggerSummedAreaPatchFinder::AliEmcalTriggerSummedAreaPatchFinder():
+  TObject(),
+  fRowMin(),
+  fRowMax(),
+  fBitMask(),
+  fPatchSize(),
+  fSubregionSize(),
+  fGroup(),
+  fThreshold(),
+  fOfflineThreshold(),
+  fNTables(0),
+  fWindowADC(),
+  fWindowOfflineADC()
+{
+  for(int itable = 0; itable < kMaxTables; itable++){
+    fTableGrid[itable] = nullptr;
+    fTableCols[itable] = 0;
+    fTableRows[itable] = 0;
+  }
+}
+
+void AliEmcalTriggerSummedAreaPatchFinder::AddTriggerAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize,
+    Int_t group, Double_t threshold, Double_t offlineThreshold)
+{
+  fRowMin.push_back(rowmin);
+  fRowMax.push_back(rowmax);
+  fBitMask.push_back(bitmask);
+  fPatchSize.push_back(patchSize);
+  fSubregionSize.push_back(subregionSize);
+  fGroup.push_back(group);
+  fThreshold.push_back(threshold);
+  fOfflineThreshold.push_back(offlineThreshold);
+}
+
+void AliEmcalTriggerSummedAreaPatchFinder::RemoveTriggerAlgorithms(Int_t group){
+  size_t nkeep = 0;
+  for(size_t ialgo = 0; ialgo < fGroup.size(); ialgo++){
+    if(fGroup[ialgo] == group) continue;
+    fRowMin[nkeep] = fRowMin[ialgo];
+    fRowMax[nkeep] = fRowMax[ialgo];
+    fBitMask[nkeep] = fBitMask[ialgo];
+    fPatchSize[nkeep] = fPatchSize[ialgo];
+    fSubregionSize[nkeep] = fSubregionSize[ialgo];
+    fGroup[nkeep] = fGroup[ialgo];
+    fThreshold[nkeep] = fThreshold[ialgo];
+    fOfflineThreshold[nkeep] = fOfflineThreshold[ialgo];
+    nkeep++;
+  }
+  fRowMin.resize(nkeep);
+  fRowMax.resize(nkeep);
+  fBitMask.resize(nkeep);
+  fPatchSize.resize(nkeep);
+  fSubregionSize.resize(nkeep);
+  fGroup.resize(nkeep);
+  fThreshold.resize(nkeep);
+  fOfflineThreshold.resize(nkeep);
+}
+
+Bool_t AliEmcalTriggerSummedAreaPatchFinder::HasTriggerAlgorithms(Int_t group) const {
+  return std::find(fGroup.begin(), fGroup.end(), group) != fGroup.end();
+}
+
+void AliEmcalTriggerSummedAreaPatchFinder::Reset(){
+  // the tables keep their memory for the next event
+  fNTables = 0;
+  for(int itable = 0; itable < kMaxTables; itable++) fTableGrid[itable] = nullptr;
+}
+
+std::vector<AliEMCALTriggerRawPatch> AliEmcalTriggerSummedAreaPatchFinder::FindPatches(const AliEMCALTriggerDataGrid<double> &adc,
+    const AliEMCALTriggerDataGrid<double> &offlineAdc, Int_t group)
+{
+  std::vector<AliEMCALTriggerRawPatch> result;
+  if(!HasTriggerAlgorithms(group)) return result;
+  Int_t tableADC = GetTable(adc), tableOfflineADC = GetTable(offlineAdc);
+
+  for(size_t ialgo = 0; ialgo < fGroup.size(); ialgo++){
+    if(fGroup[ialgo] != group) continue;
+    Int_t patchSize = fPatchSize[ialgo], subregionSize = fSubregionSize[ialgo];
+    if(subregionSize <= 0) continue;
+    Int_t rowStartMax = fRowMax[ialgo] - (patchSize - 1),
+          colStartMax = adc.GetNumberOfCols() - patchSize;
+    if(colStartMax < 0) continue;
+    Int_t nwindows = colStartMax / subregionSize + 1;
+    if(static_cast<Int_t>(fWindowADC.size()) < nwindows){
+      fWindowADC.resize(nwindows);
+      fWindowOfflineADC.resize(nwindows);
+    }
+    for(int irow = fRowMin[ialgo]; irow <= rowStartMax; irow += subregionSize){
+      GetRowOfWindowSums(tableADC, irow, patchSize, subregionSize, nwindows, &fWindowADC[0]);
+      GetRowOfWindowSums(tableOfflineADC, irow, patchSize, subregionSize, nwindows, &fWindowOfflineADC[0]);
+      for(int iwindow = 0; iwindow < nwindows; iwindow++){
+        if(fWindowADC[iwindow] > fThreshold[ialgo] || fWindowOfflineADC[iwindow] > fOfflineThreshold[ialgo]){
+          AliEMCALTriggerRawPatch recpatch(iwindow * subregionSize, irow, patchSize, fWindowADC[iwindow], fWindowOfflineADC[iwindow]);
+          recpatch.SetBitmask(fBitMask[ialgo]);
+          result.push_back(recpatch);
+        }
+      }
+    }
+  }
+  return result;
+}
+
+Double_t AliEmcalTriggerSummedAreaPatchFinder::GetPatchSum(const AliEMCALTriggerDataGrid<double> &grid, Int_t col, Int_t row, Int_t size){
+  return GetRectangleSum(GetTable(grid), col, col + size, row, row + size);
+}
+
+Int_t AliEmcalTriggerSummedAreaPatchFinder::GetTable(const AliEMCALTriggerDataGrid<double> &grid){
+  Int_t nbuilt = std::min(fNTables, static_cast<Int_t>(kMaxTables));
+  for(int itable = 0; itable < nbuilt; itable++){
+    if(fTableGrid[itable] == &grid) return itable;
+  }
+
+  // tables are reused in turn if more grids than kMaxTables are summed in the same event
+  Int_t itable = fNTables % kMaxTables;
+  fNTables++;
+  Int_t ncols = grid.GetNumberOfCols(), nrows = grid.GetNumberOfRows(), stride = ncols + 1;
+  fTableGrid[itable] = &grid;
+  fTableCols[itable] = ncols;
+  fTableRows[itable] = nrows;
+  std::vector<Double_t> &sum = fTableSum[itable];
+  std::vector<Int_t> &nonzero = fTableNonZero[itable];
+  sum.assign((nrows + 1) * stride, 0.);
+  nonzero.assign((nrows + 1) * stride, 0);
+  for(int irow = 0; irow < nrows; irow++){
+    const Double_t *sumbelow = &sum[irow * stride];
+    const Int_t *nonzerobelow = &nonzero[irow * stride];
+    Double_t *sumrow = &sum[(irow + 1) * stride];
+    Int_t *nonzerorow = &nonzero[(irow + 1) * stride];
+    Double_t rowsum = 0.;
+    Int_t rownonzero = 0;
+    for(int icol = 0; icol < ncols; icol++){
+      Double_t value = grid(icol, irow);
+      rowsum += value;
+      if(value != 0.) rownonzero++;
+      sumrow[icol + 1] = sumbelow[icol + 1] + rowsum;
+      nonzerorow[icol + 1] = nonzerobelow[icol + 1] + rownonzero;
+    }
+  }
+  return itable;
+}
+
+Double_t AliEmcalTriggerSummedAreaPatchFinder::GetRectangleSum(Int_t itable, Int_t c0, Int_t c1, Int_t r0, Int_t r1) const {
+  Int_t ncols = fTableCols[itable], nrows = fTableRows[itable], stride = ncols + 1;
+  c0 = std::max(c0, 0); c1 = std::min(c1, ncols);
+  r0 = std::max(r0, 0); r1 = std::min(r1, nrows);
+  if(c1 <= c0 || r1 <= r0) return 0.;
+  const std::vector<Double_t> &sum = fTableSum[itable];
+  const std::vector<Int_t> &nonzero = fTableNonZero[itable];
+  // windows without any non-zero channel are exactly 0, not a rounding residual
+  if(!(nonzero[r1 * stride + c1] - nonzero[r0 * stride + c1] - nonzero[r1 * stride + c0] + nonzero[r0 * stride + c0])) return 0.;
+  return sum[r1 * stride + c1] - sum[r0 * stride + c1] - sum[r1 * stride + c0] + sum[r0 * stride + c0];
+}
+
+void AliEmcalTriggerSummedAreaPatchFinder::GetRowOfWindowSums(Int_t itable, Int_t row, Int_t patchSize, Int_t subregionSize, Int_t nwindows, Double_t *sums) const {
+  Int_t ncols = fTableCols[itable], nrows = fTableRows[itable], stride = ncols + 1;
+  Int_t r0 = std::max(row, 0), r1 = std::min(row + patchSize, nrows);
+  if(r1 <= r0){
+    std::fill(sums, sums + nwindows, 0.);
+    return;
+  }
+  const Double_t *sumtop = &fTableSum[itable][r1 * stride], *sumbottom = &fTableSum[itable][r0 * stride];
+  const Int_t *nonzerotop = &fTableNonZero[itable][r1 * stride], *nonzerobottom = &fTableNonZero[itable][r0 * stride];
+  for(int iwindow = 0; iwindow < nwindows; iwindow++){
+    Int_t c0 = std::min(iwindow * subregionSize, ncols), c1 = std::min(c0 + patchSize, ncols);
+    Int_t nonzero = nonzerotop[c1] - nonzerobottom[c1] - nonzerotop[c0] + nonzerobottom[c0];
+    Double_t sum = sumtop[c1] - sumbottom[c1] - sumtop[c0] + sumbottom[c0];
+    sums[iwindow] = nonzero ? sum : 0.;
+  }
+}
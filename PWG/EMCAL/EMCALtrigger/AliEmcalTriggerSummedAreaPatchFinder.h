@@ -0,0 +1,177 @@
+#ifndef ALIEMCALTRIGGERSUMMEDAREAPATCHFINDER_H
+#define ALIEMCALTRIGGERSUMMEDAREAPATCHFINDER_H
+/* Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <vector>
+
+#include <TObject.h>
+
+class AliEMCALTriggerRawPatch;
+template<class T> class AliEMCALTriggerDataGrid;
+
+/**
+ * @class AliEmcalTriggerSummedAreaPatchFinder
+ * @brief Trigger patch finder based on summed-area tables
+ * @ingroup EMCALTRGFW
+ *
+ * Patch finder equivalent to an AliEMCALTriggerPatchFinder<double> running
+ * a set of AliEMCALTriggerAlgorithm<double>: for each algorithm, windows of
+ * patchSize x patchSize channels are placed every subregionSize channels in
+ * column and row, and the windows for which the ADC or the offline ADC sum is
+ * above threshold are returned as raw patches, in the same order as the
+ * algorithms.
+ *
+ * Instead of summing all the channels of every window, a summed-area table
+ * (integral image) is built once per data grid, and each window sum is obtained
+ * from four entries of the table. All windows starting in the same row are
+ * evaluated in one loop over contiguous memory. Tables are cached until the
+ * next call of Reset(), so that a grid used by several patch types (e.g. the
+ * offline ADC grid shared by L1 and L0 patches, or the smeared energies used
+ * for all patch sizes) is only summed once per event.
+ *
+ * Windows without any non-zero channel are reported with an exact sum 0, other
+ * sums agree with the direct summation up to the rounding of the table.
+ *
+ * ~~~{.cxx}
+ * AliEmcalTriggerSummedAreaPatchFinder finder;
+ * finder.AddTriggerAlgorithm(0, 63, 1 << 8, 16, 4);   // jet patches
+ * finder.AddTriggerAlgorithm(0, 63, 1 << 2, 2, 1);    // gamma patches
+ * // in the event loop, after the data grids were filled
+ * finder.Reset();
+ * std::vector<AliEMCALTriggerRawPatch> patches = finder.FindPatches(adcgrid, offlinegrid);
+ * ~~~
+ */
+class AliEmcalTriggerSummedAreaPatchFinder : public TObject {
+public:
+
+  /**
+   * @brief Constructor
+   */
+  AliEmcalTriggerSummedAreaPatchFinder();
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~AliEmcalTriggerSummedAreaPatchFinder() {}
+
+  /**
+   * @brief Add a trigger algorithm
+   * @param[in] rowmin Minimum row value
+   * @param[in] rowmax Maximum row value
+   * @param[in] bitmask Offline bit mask to be applied to the patches
+   * @param[in] patchSize Size of the patches
+   * @param[in] subregionSize Size of the sliding sub region
+   * @param[in] group Group of the algorithm, only algorithms of the same group are run together in FindPatches
+   * @param[in] threshold Threshold on the ADC sum of the patch
+   * @param[in] offlineThreshold Threshold on the offline ADC sum of the patch
+   */
+  void AddTriggerAlgorithm(Int_t rowmin, Int_t rowmax, UInt_t bitmask, Int_t patchSize, Int_t subregionSize,
+      Int_t group = 0, Double_t threshold = 0., Double_t offlineThreshold = 0.);
+
+  /**
+   * @brief Remove all the trigger algorithms of a given group
+   * @param[in] group Group of the algorithms to be removed
+   */
+  void RemoveTriggerAlgorithms(Int_t group);
+
+  /**
+   * @brief Check whether trigger algorithms are defined for a given group
+   * @param[in] group Group of algorithms
+   * @return True if at least one algorithm belongs to the group
+   */
+  Bool_t HasTriggerAlgorithms(Int_t group) const;
+
+  /**
+   * @brief Forget the summed-area tables
+   *
+   * Has to be called each time the content of the data grids changes
+   * (i.e. once per event).
+   */
+  void Reset();
+
+  /**
+   * @brief Run the trigger algorithms of a group on the data grids
+   * @param[in] adc Data grid with the (online) ADC values
+   * @param[in] offlineAdc Data grid with the offline ADC values
+   * @param[in] group Group of the algorithms to run
+   * @return Raw patches found by the algorithms
+   */
+  std::vector<AliEMCALTriggerRawPatch> FindPatches(const AliEMCALTriggerDataGrid<double> &adc, const AliEMCALTriggerDataGrid<double> &offlineAdc, Int_t group = 0);
+
+  /**
+   * @brief Get the sum of the channels of a patch
+   *
+   * Channels outside the data grid are ignored.
+   * @param[in] grid Data grid
+   * @param[in] col Starting column of the patch
+   * @param[in] row Starting row of the patch
+   * @param[in] size Size of the patch
+   * @return Sum of the channels within the patch
+   */
+  Double_t GetPatchSum(const AliEMCALTriggerDataGrid<double> &grid, Int_t col, Int_t row, Int_t size);
+
+protected:
+  enum {
+    kMaxTables = 4
+  };
+
+  /**
+   * @brief Get the index of the summed-area table of a data grid, building it if needed
+   * @param[in] grid Data grid
+   * @return Index of the table
+   */
+  Int_t GetTable(const AliEMCALTriggerDataGrid<double> &grid);
+
+  /**
+   * @brief Sum of the channels in the rectangle [c0, c1) x [r0, r1), clipped to the grid
+   * @param[in] itable Index of the table
+   * @param[in] c0 First column
+   * @param[in] c1 Column after the last one
+   * @param[in] r0 First row
+   * @param[in] r1 Row after the last one
+   * @return Sum of the channels
+   */
+  Double_t GetRectangleSum(Int_t itable, Int_t c0, Int_t c1, Int_t r0, Int_t r1) const;
+
+  /**
+   * @brief Sums of all the windows starting at a given row
+   *
+   * Windows start at columns 0, subregionSize, 2 * subregionSize, ...
+   * @param[in] itable Index of the table
+   * @param[in] row Starting row of the windows
+   * @param[in] patchSize Size of the windows
+   * @param[in] subregionSize Step between two windows
+   * @param[in] nwindows Number of windows
+   * @param[out] sums Sums of the windows
+   */
+  void GetRowOfWindowSums(Int_t itable, Int_t row, Int_t patchSize, Int_t subregionSize, Int_t nwindows, Double_t *sums) const;
+
+  std::vector<Int_t>                        fRowMin;                      ///< Minimum row of each algorithm
+  std::vector<Int_t>                        fRowMax;                      ///< Maximum row of each algorithm
+  std::vector<UInt_t>                       fBitMask;                     ///< Offline bit mask of each algorithm
+  std::vector<Int_t>                        fPatchSize;                   ///< Patch size of each algorithm
+  std::vector<Int_t>                        fSubregionSize;               ///< Size of the sliding sub region of each algorithm
+  std::vector<Int_t>                        fGroup;                       ///< Group of each algorithm
+  std::vector<Double_t>                     fThreshold;                   ///< Threshold on the ADC sum of each algorithm
+  std::vector<Double_t>                     fOfflineThreshold;            ///< Threshold on the offline ADC sum of each algorithm
+
+  Int_t                                     fNTables;                     //!<! Number of summed-area tables built since the last reset
+  const AliEMCALTriggerDataGrid<double>    *fTableGrid[kMaxTables];       //!<! Data grid of each table
+  Int_t                                     fTableCols[kMaxTables];       //!<! Number of columns of the data grid of each table
+  Int_t                                     fTableRows[kMaxTables];       //!<! Number of rows of the data grid of each table
+  std::vector<Double_t>                     fTableSum[kMaxTables];        //!<! Summed-area tables, (cols + 1) x (rows + 1), row by row
+  std::vector<Int_t>                        fTableNonZero[kMaxTables];    //!<! Summed-area tables of the number of non-zero channels
+  std::vector<Double_t>                     fWindowADC;                   //!<! Buffer with the ADC sums of a row of windows
+  std::vector<Double_t>                     fWindowOfflineADC;            //!<! Buffer with the offline ADC sums of a row of windows
+
+private:
+  AliEmcalTriggerSummedAreaPatchFinder(const AliEmcalTriggerSummedAreaPatchFinder &);
+  AliEmcalTriggerSummedAreaPatchFinder &operator=(const AliEmcalTriggerSummedAreaPatchFinder &);
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalTriggerSummedAreaPatchFinder, 1);
+  /// \endcond
+};
+
+#endif
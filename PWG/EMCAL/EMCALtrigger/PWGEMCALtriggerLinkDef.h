@@ -8,6 +8,7 @@
 #pragma link C++ class AliEmcalTriggerMakerKernel+;
 #pragma link C++ class AliEmcalTriggerMakerTask+;
 #pragma link C++ class AliEmcalTriggerSetupInfo+;
+#pragma link C++ class AliEmcalTriggerSummedAreaPatchFinder+;
 #pragma link C++ class AliEmcalTriggerQATask+;
 #pragma link C++ class AliEMCALTriggerOfflineQAPP+;
 #pragma link C++ class AliEMCALTriggerOfflineLightQAPP+;
@@ -88,7 +88,19 @@ AliFlowEventSimple::AliFlowEventSimple():
   fZPAM(0.),
   fAbsOrbit(0),
   fNumberOfPOItypes(2),
-  fNumberOfPOIs(NULL)
+  fNumberOfPOIs(NULL),
+  fNumberOfColumnTracks(0),
+  fFilledColumns(0),
+  fColumnsTrackCounter(0),
+  fColumnPhi(),
+  fColumnPt(),
+  fColumnEta(),
+  fColumnWeight(),
+  fColumnMass(),
+  fColumnCharge(),
+  fColumnPOItype(),
+  fColumnSubevent(),
+  fColumnMask()
 {
   fZNCQ = AliFlowVector();
   fZNAQ = AliFlowVector();
@@ -147,7 +159,19 @@ AliFlowEventSimple::AliFlowEventSimple( Int_t n,
   fZPAM(0.),
   fAbsOrbit(0),
   fNumberOfPOItypes(2),
-  fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
+  fNumberOfPOIs(new Int_t[fNumberOfPOItypes]),
+  fNumberOfColumnTracks(0),
+  fFilledColumns(0),
+  fColumnsTrackCounter(0),
+  fColumnPhi(),
+  fColumnPt(),
+  fColumnEta(),
+  fColumnWeight(),
+  fColumnMass(),
+  fColumnCharge(),
+  fColumnPOItype(),
+  fColumnSubevent(),
+  fColumnMask()
 {
   //ctor
   // if second argument is set to AliFlowEventSimple::kGenerate
@@ -210,7 +234,19 @@ AliFlowEventSimple::AliFlowEventSimple(const AliFlowEventSimple& anEvent):
   fZPAM(anEvent.fZPAM),
   fAbsOrbit(anEvent.fAbsOrbit),
   fNumberOfPOItypes(anEvent.fNumberOfPOItypes),
-  fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
+  fNumberOfPOIs(new Int_t[fNumberOfPOItypes]),
+  fNumberOfColumnTracks(0),
+  fFilledColumns(0),
+  fColumnsTrackCounter(0),
+  fColumnPhi(),
+  fColumnPt(),
+  fColumnEta(),
+  fColumnWeight(),
+  fColumnMass(),
+  fColumnCharge(),
+  fColumnPOItype(),
+  fColumnSubevent(),
+  fColumnMask()
 {
   //copy constructor
   memcpy(fNumberOfPOIs,anEvent.fNumberOfPOIs,fNumberOfPOItypes*sizeof(Int_t));
@@ -306,6 +342,7 @@ AliFlowEventSimple& AliFlowEventSimple::operator=(const AliFlowEventSimple& anEv
     fV0A[i] = anEvent.fV0A[i];
   }
   delete [] fShuffledIndexes;
+  InvalidateTrackColumns(); //the columns are not copied, refill them if needed
   return *this;
 }
 
@@ -441,6 +478,7 @@ void AliFlowEventSimple::ShuffleTracks()
   }
   //shuffle
   std::random_shuffle(&fShuffledIndexes[0], &fShuffledIndexes[fNumberOfTracks]);
+  InvalidateTrackColumns();
   Printf("Tracks shuffled! tracks: %i",fNumberOfTracks);
 }
 
@@ -467,6 +505,7 @@ void AliFlowEventSimple::TrackAdded()
 {
   //book keeping after a new track has been added
   fNumberOfTracks++;
+  InvalidateTrackColumns();
   if (fShuffledIndexes)
   {
     delete [] fShuffledIndexes;
@@ -485,6 +524,71 @@ AliFlowTrackSimple* AliFlowEventSimple::MakeNewTrack()
    return t;
 }
 
+//-----------------------------------------------------------------------
+UInt_t AliFlowEventSimple::GetFilledTrackColumns() const
+{
+  //TrackColumn bits of the columns in sync with the tracks
+  if (fNumberOfColumnTracks!=fNumberOfTracks) return 0;
+  if (fColumnsTrackCounter!=AliFlowTrackSimple::GetModificationCounter()) return 0;
+  return fFilledColumns;
+}
+
+//-----------------------------------------------------------------------
+void AliFlowEventSimple::FillTrackColumns(UInt_t columns)
+{
+  //copy the requested variables (TrackColumn bits) of the track collection
+  //in contiguous per track arrays, one per variable, so that loops over all
+  //tracks can read them directly instead of dereferencing every track.
+  //Columns already filled are kept. The columns are in the order of the
+  //collection (not shuffled); they are invalidated by the methods of the event
+  //changing the collection and by any change of a track through its setters
+  //(see AliFlowTrackSimple::GetModificationCounter()).
+  //Empty slots of the collection get zeroes and no flow bits
+  if (fNumberOfColumnTracks!=fNumberOfTracks || fColumnsTrackCounter!=AliFlowTrackSimple::GetModificationCounter())
+  {
+    fFilledColumns = 0;
+    fNumberOfColumnTracks = fNumberOfTracks;
+    fColumnsTrackCounter = AliFlowTrackSimple::GetModificationCounter();
+  }
+  columns &= kAllColumns & ~fFilledColumns;
+  if (!columns) return;
+  if (columns&kPhiColumn) fColumnPhi.resize(fNumberOfTracks);
+  if (columns&kPtColumn) fColumnPt.resize(fNumberOfTracks);
+  if (columns&kEtaColumn) fColumnEta.resize(fNumberOfTracks);
+  if (columns&kWeightColumn) fColumnWeight.resize(fNumberOfTracks);
+  if (columns&kMassColumn) fColumnMass.resize(fNumberOfTracks);
+  if (columns&kChargeColumn) fColumnCharge.resize(fNumberOfTracks);
+  if (columns&kPOItypeColumn) fColumnPOItype.resize(fNumberOfTracks);
+  if (columns&kSubeventColumn) fColumnSubevent.resize(fNumberOfTracks);
+  for (Int_t i=0; i<fNumberOfTracks; i++)
+  {
+    const AliFlowTrackSimple* track = static_cast<const AliFlowTrackSimple*>(fTrackCollection->UncheckedAt(i));
+    if (columns&kPhiColumn) fColumnPhi[i] = track?track->Phi():0.;
+    if (columns&kPtColumn) fColumnPt[i] = track?track->Pt():0.;
+    if (columns&kEtaColumn) fColumnEta[i] = track?track->Eta():0.;
+    if (columns&kWeightColumn) fColumnWeight[i] = track?track->Weight():0.;
+    if (columns&kMassColumn) fColumnMass[i] = track?track->Mass():0.;
+    if (columns&kChargeColumn) fColumnCharge[i] = track?track->Charge():0;
+    if (columns&kPOItypeColumn)
+    {
+      UInt_t poiBits = 0;
+      if (track)
+      {
+        const TBits* bits = track->GetPOItype();
+        for (UInt_t b=bits->FirstSetBit(); b<bits->GetNbits() && b<32; b=bits->FirstSetBit(b+1)) poiBits |= (1u<<b);
+      }
+      fColumnPOItype[i] = poiBits;
+    }
+    if (columns&kSubeventColumn)
+    {
+      UChar_t subeventBits = 0;
+      if (track) for (Int_t b=0; b<8; b++) if (track->InSubevent(b)) subeventBits |= (1<<b);
+      fColumnSubevent[i] = subeventBits;
+    }
+  }
+  fFilledColumns |= columns;
+}
+
 //-----------------------------------------------------------------------
 AliFlowVector AliFlowEventSimple::GetQ( Int_t n,
                                         TList *weightsList,
@@ -505,8 +609,6 @@ AliFlowVector AliFlowEventSimple::GetQ( Int_t n,
   Double_t dEta = 0.;
   Double_t dWeight = 1.;
 
-  AliFlowTrackSimple* pTrack = NULL;
-
   Int_t nBinsPhi = 0;
   Double_t dBinWidthPt = 0.;
   Double_t dPtMin = 0.;
@@ -548,48 +650,46 @@ AliFlowVector AliFlowEventSimple::GetQ( Int_t n,
     }
   } // end of if(weightsList)
 
-  // loop over tracks
+  // loop over the track columns
+  FillTrackColumns(kPhiColumn|kPtColumn|kEtaColumn|kWeightColumn|kPOItypeColumn);
+  const Double_t* phi = GetPhiColumn();
+  const Double_t* pt = GetPtColumn();
+  const Double_t* eta = GetEtaColumn();
+  const Double_t* weight = GetWeightColumn();
+  const UInt_t* poiType = GetPOItypeColumn();
   for(Int_t i=0; i<fNumberOfTracks; i++)
   {
-    pTrack = (AliFlowTrackSimple*)fTrackCollection->At(i);
-    if(pTrack)
+    if(poiType[i] & (1u<<AliFlowTrackSimple::kRP))
     {
-      if(pTrack->InRPSelection())
-      {
-        dPhi = pTrack->Phi();
-        dPt  = pTrack->Pt();
-        dEta = pTrack->Eta();
-	      dWeight = pTrack->Weight();
+      dPhi = phi[i];
+      dPt  = pt[i];
+      dEta = eta[i];
+      dWeight = weight[i];
 
-        // determine Phi weight: (to be improved, I should here only access it + the treatment of gaps in the if statement)
-        if(phiWeights && nBinsPhi)
-        {
-          wPhi = phiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*nBinsPhi/TMath::TwoPi())));
-        }
-        // determine v'(pt) weight:
-        if(ptWeights && dBinWidthPt)
-        {
-          wPt=ptWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-dPtMin)/dBinWidthPt)));
-        }
-        // determine v'(eta) weight:
-        if(etaWeights && dBinWidthEta)
-        {
-          wEta=etaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-dEtaMin)/dBinWidthEta)));
-        }
+      // determine Phi weight: (to be improved, I should here only access it + the treatment of gaps in the if statement)
+      if(phiWeights && nBinsPhi)
+      {
+        wPhi = phiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*nBinsPhi/TMath::TwoPi())));
+      }
+      // determine v'(pt) weight:
+      if(ptWeights && dBinWidthPt)
+      {
+        wPt=ptWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-dPtMin)/dBinWidthPt)));
+      }
+      // determine v'(eta) weight:
+      if(etaWeights && dBinWidthEta)
+      {
+        wEta=etaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-dEtaMin)/dBinWidthEta)));
+      }
 
-        // building up the weighted Q-vector:
-        dQX += dWeight*wPhi*wPt*wEta*TMath::Cos(iOrder*dPhi);
-        dQY += dWeight*wPhi*wPt*wEta*TMath::Sin(iOrder*dPhi);
+      // building up the weighted Q-vector:
+      dQX += dWeight*wPhi*wPt*wEta*TMath::Cos(iOrder*dPhi);
+      dQY += dWeight*wPhi*wPt*wEta*TMath::Sin(iOrder*dPhi);
 
-        // weighted multiplicity:
-        sumOfWeights += dWeight*wPhi*wPt*wEta;
+      // weighted multiplicity:
+      sumOfWeights += dWeight*wPhi*wPt*wEta;
 
-      } // end of if (pTrack->InRPSelection())
-    } // end of if (pTrack)
-    else
-    {
-      cerr << "no particle!!!"<<endl;
-    }
+    } // end of if RP
   } // loop over particles
 
   vQ.Set(dQX,dQY);
@@ -622,8 +722,6 @@ void AliFlowEventSimple::Get2Qsub( AliFlowVector* Qarray,
   Double_t dEta = 0.;
   Double_t dWeight = 1.;
 
-  AliFlowTrackSimple* pTrack = NULL;
-
   Int_t    iNbinsPhiSub0 = 0;
   Int_t    iNbinsPhiSub1 = 0;
   Double_t dBinWidthPt = 0.;
@@ -673,24 +771,27 @@ void AliFlowEventSimple::Get2Qsub( AliFlowVector* Qarray,
     }
   } // end of if(weightsList)
 
+  // the track columns are shared by both subevents
+  FillTrackColumns(kPhiColumn|kPtColumn|kEtaColumn|kWeightColumn|kPOItypeColumn|kSubeventColumn);
+  const Double_t* phi = GetPhiColumn();
+  const Double_t* pt = GetPtColumn();
+  const Double_t* eta = GetEtaColumn();
+  const Double_t* weight = GetWeightColumn();
+  const UInt_t* poiType = GetPOItypeColumn();
+  const UChar_t* subevent = GetSubeventColumn();
+
   //loop over the two subevents
   for (Int_t s=0; s<2; s++)
   {
     // loop over tracks
     for(Int_t i=0; i<fNumberOfTracks; i++)
     {
-      pTrack = (AliFlowTrackSimple*)fTrackCollection->At(i);
-      if(!pTrack)
-      {
-        cerr << "no particle!!!"<<endl;
-        continue;
-      }
-      if(pTrack->InRPSelection() && (pTrack->InSubevent(s)))
+      if((poiType[i] & (1u<<AliFlowTrackSimple::kRP)) && (subevent[i] & (1<<s)))
       {
-        dPhi    = pTrack->Phi();
-        dPt     = pTrack->Pt();
-        dEta    = pTrack->Eta();
-        dWeight = pTrack->Weight();
+        dPhi    = phi[i];
+        dPt     = pt[i];
+        dEta    = eta[i];
+        dWeight = weight[i];
 
         // determine Phi weight: (to be improved, I should here only access it + the treatment of gaps in the if statement)
         //subevent 0
@@ -731,7 +832,7 @@ void AliFlowEventSimple::Get2Qsub( AliFlowVector* Qarray,
         // weighted multiplicity:
         sumOfWeights+=dWeight*dWphi*dWpt*dWeta;
 
-      } // end of if (pTrack->InRPSelection())
+      } // end of if RP in subevent s
     } // loop over particles
 
     Qarray[s].Set(dQX,dQY);
@@ -894,7 +995,19 @@ AliFlowEventSimple::AliFlowEventSimple( TTree* inputTree,
   fZPAM(0.),
   fAbsOrbit(0),
   fNumberOfPOItypes(2),
-  fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
+  fNumberOfPOIs(new Int_t[fNumberOfPOItypes]),
+  fNumberOfColumnTracks(0),
+  fFilledColumns(0),
+  fColumnsTrackCounter(0),
+  fColumnPhi(),
+  fColumnPt(),
+  fColumnEta(),
+  fColumnWeight(),
+  fColumnMass(),
+  fColumnCharge(),
+  fColumnPOItype(),
+  fColumnSubevent(),
+  fColumnMask()
 {
   //constructor, fills the event from a TTree of kinematic.root files
   //applies RP and POI cuts, tags the tracks
@@ -980,6 +1093,7 @@ void AliFlowEventSimple::ResolutionPt(Double_t res)
     if (track) track->ResolutionPt(res);
   }
   SetUserModified();
+  InvalidateTrackColumns(kPtColumn);
 }
 
 //_____________________________________________________________________________
@@ -998,6 +1112,7 @@ void AliFlowEventSimple::TagSubeventsInEta( Double_t etaMinA,
     if (eta >= etaMinA && eta <= etaMaxA) track->SetForSubevent(0);
     if (eta >= etaMinB && eta <= etaMaxB) track->SetForSubevent(1);
   }
+  InvalidateTrackColumns(kSubeventColumn);
 }
 
 //_____________________________________________________________________________
@@ -1013,6 +1128,7 @@ void AliFlowEventSimple::TagSubeventsByCharge()
     if (charge<0) track->SetForSubevent(0);
     if (charge>0) track->SetForSubevent(1);
   }
+  InvalidateTrackColumns(kSubeventColumn);
 }
 
 //_____________________________________________________________________________
@@ -1030,6 +1146,7 @@ void AliFlowEventSimple::AddV1( Double_t v1 )
     }
   }
   SetUserModified();
+  InvalidateTrackColumns(kPhiColumn);
 }
 
 //_____________________________________________________________________________
@@ -1047,6 +1164,7 @@ void AliFlowEventSimple::AddV2( Double_t v2 )
     }
   }
   SetUserModified();
+  InvalidateTrackColumns(kPhiColumn);
 }
 
 //_____________________________________________________________________________
@@ -1064,6 +1182,7 @@ void AliFlowEventSimple::AddV3( Double_t v3 )
     }
   }
   SetUserModified();
+  InvalidateTrackColumns(kPhiColumn);
 }
 
 //_____________________________________________________________________________
@@ -1081,6 +1200,7 @@ void AliFlowEventSimple::AddV4( Double_t v4 )
     }
   }
   SetUserModified();
+  InvalidateTrackColumns(kPhiColumn);
 }
 
 //_____________________________________________________________________________
@@ -1098,6 +1218,7 @@ void AliFlowEventSimple::AddV5( Double_t v5 )
     }
   }
   SetUserModified();
+  InvalidateTrackColumns(kPhiColumn);
 }
 
 //_____________________________________________________________________________
@@ -1111,6 +1232,7 @@ void AliFlowEventSimple::AddFlow( Double_t v1, Double_t v2, Double_t v3, Double_
     if (track) track->AddFlow(v1,v2,v3,v4,v5,rp1,rp2,rp3,rp4,rp5,fAfterBurnerPrecision);
   }
   SetUserModified();
+  InvalidateTrackColumns(kPhiColumn);
 }
 
 //_____________________________________________________________________________
@@ -1123,6 +1245,7 @@ void AliFlowEventSimple::AddFlow( Double_t v1, Double_t v2, Double_t v3, Double_
     if (track) track->AddFlow(v1,v2,v3,v4,v5,fMCReactionPlaneAngle, fAfterBurnerPrecision);
   }
   SetUserModified();
+  InvalidateTrackColumns(kPhiColumn);
 }
 
 //_____________________________________________________________________________
@@ -1137,6 +1260,7 @@ void AliFlowEventSimple::AddV2( TF1* ptDepV2 )
     track->AddV2(v2, fMCReactionPlaneAngle, fAfterBurnerPrecision);
   }
   SetUserModified();
+  InvalidateTrackColumns(kPhiColumn);
 }
 
 //_____________________________________________________________________________
@@ -1151,17 +1275,23 @@ void AliFlowEventSimple::AddV2( TF2* ptEtaDepV2 )
     track->AddV2(v2, fMCReactionPlaneAngle, fAfterBurnerPrecision);
   }
   SetUserModified();
+  InvalidateTrackColumns(kPhiColumn);
 }
 
 //_____________________________________________________________________________
 void AliFlowEventSimple::TagRP( const AliFlowTrackSimpleCuts* cuts )
 {
   //tag tracks as reference particles (RPs)
+  //the cuts are evaluated for all the tracks at once on the track columns
+  FillTrackColumns(cuts->GetUsedColumns());
+  fColumnMask.resize(fNumberOfTracks);
+  for (Int_t i=0; i<fNumberOfTracks; i++) fColumnMask[i] = (fTrackCollection->UncheckedAt(i)!=NULL);
+  if (fNumberOfTracks>0) cuts->PassesCuts(this,&fColumnMask[0]);
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
     if (!track) continue;
-    Bool_t pass=cuts->PassesCuts(track);
+    Bool_t pass=fColumnMask[i];
     Bool_t rpTrack=track->InRPSelection();
     if (pass)
     {
@@ -1173,17 +1303,23 @@ void AliFlowEventSimple::TagRP( const AliFlowTrackSimpleCuts* cuts )
     }
     track->SetForRPSelection(pass);
   }
+  InvalidateTrackColumns(kPOItypeColumn);
 }
 
 //_____________________________________________________________________________
 void AliFlowEventSimple::TagPOI( const AliFlowTrackSimpleCuts* cuts, Int_t poiType )
 {
   //tag tracks as particles of interest (POIs)
+  //the cuts are evaluated for all the tracks at once on the track columns
+  FillTrackColumns(cuts->GetUsedColumns());
+  fColumnMask.resize(fNumberOfTracks);
+  for (Int_t i=0; i<fNumberOfTracks; i++) fColumnMask[i] = (fTrackCollection->UncheckedAt(i)!=NULL);
+  if (fNumberOfTracks>0) cuts->PassesCuts(this,&fColumnMask[0]);
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
     AliFlowTrackSimple* track = static_cast<AliFlowTrackSimple*>(fTrackCollection->At(i));
     if (!track) continue;
-    Bool_t pass=cuts->PassesCuts(track);
+    Bool_t pass=fColumnMask[i];
     Bool_t poiTrack=track->InPOISelection();
     if (pass)
     {
@@ -1195,6 +1331,7 @@ void AliFlowEventSimple::TagPOI( const AliFlowTrackSimpleCuts* cuts, Int_t poiTy
     }
     track->Tag(poiType,pass);
   }
+  InvalidateTrackColumns(kPOItypeColumn);
 }
 
 //_____________________________________________________________________________
@@ -1227,6 +1364,7 @@ void AliFlowEventSimple::DefineDeadZone( Double_t etaMin,
       track->ResetPOItype();
     }
   }
+  InvalidateTrackColumns(kPOItypeColumn);
 }
 
 //_____________________________________________________________________________
@@ -1244,6 +1382,7 @@ Int_t AliFlowEventSimple::CleanUpDeadTracks()
   fTrackCollection->Compress(); //clean up empty slots
   fNumberOfTracks-=ncleaned; //update number of tracks
   delete [] fShuffledIndexes; fShuffledIndexes=NULL;
+  InvalidateTrackColumns();
   return ncleaned;
 }
 
@@ -1283,4 +1422,5 @@ void AliFlowEventSimple::ClearFast()
   fAfterBurnerPrecision = 0.001;
   fUserModified = kFALSE;
   delete [] fShuffledIndexes; fShuffledIndexes=NULL;
+  InvalidateTrackColumns();
 }
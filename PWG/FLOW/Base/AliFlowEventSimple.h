@@ -16,6 +16,7 @@
 #ifndef ALIFLOWEVENTSIMPLE_H
 #define ALIFLOWEVENTSIMPLE_H
 
+#include <vector>
 #include "TObject.h"
 #include "TParameter.h"
 #include "TMath.h"
@@ -31,6 +32,9 @@ class AliFlowEventSimple: public TObject {
  public:
 
   enum ConstructionMethod {kEmpty,kGenerate};
+  enum TrackColumn {kPhiColumn=BIT(0), kPtColumn=BIT(1), kEtaColumn=BIT(2), kWeightColumn=BIT(3),
+                    kMassColumn=BIT(4), kChargeColumn=BIT(5), kPOItypeColumn=BIT(6), kSubeventColumn=BIT(7),
+                    kAllColumns=0xff};
 
   AliFlowEventSimple();
   AliFlowEventSimple( Int_t nParticles,
@@ -117,6 +121,22 @@ class AliFlowEventSimple: public TObject {
   void TrackAdded();
   AliFlowTrackSimple* MakeNewTrack();
 
+  // contiguous per track arrays (structure of arrays) of the track collection,
+  // filled by FillTrackColumns() for the requested TrackColumn bits and valid
+  // until the tracks are changed; a getter returns NULL if its column is not filled
+  void FillTrackColumns(UInt_t columns=kAllColumns);
+  void InvalidateTrackColumns(UInt_t columns=kAllColumns) { fFilledColumns &= ~columns; }
+  UInt_t          GetFilledTrackColumns() const;
+  Int_t           GetNumberOfColumnTracks() const   { return GetFilledTrackColumns()?fNumberOfColumnTracks:0; }
+  const Double_t* GetPhiColumn() const              { return GetColumn(fColumnPhi,kPhiColumn); }
+  const Double_t* GetPtColumn() const               { return GetColumn(fColumnPt,kPtColumn); }
+  const Double_t* GetEtaColumn() const              { return GetColumn(fColumnEta,kEtaColumn); }
+  const Double_t* GetWeightColumn() const           { return GetColumn(fColumnWeight,kWeightColumn); }
+  const Double_t* GetMassColumn() const             { return GetColumn(fColumnMass,kMassColumn); }
+  const Int_t*    GetChargeColumn() const           { return GetColumn(fColumnCharge,kChargeColumn); }
+  const UInt_t*   GetPOItypeColumn() const          { return GetColumn(fColumnPOItype,kPOItypeColumn); }
+  const UChar_t*  GetSubeventColumn() const         { return GetColumn(fColumnSubevent,kSubeventColumn); }
+
   virtual AliFlowVector GetQ(Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
   virtual void Get2Qsub(AliFlowVector* Qarray, Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
   virtual void GetZDC2Qsub(AliFlowVector* Qarray);
@@ -206,10 +226,25 @@ class AliFlowEventSimple: public TObject {
   UInt_t                  fAbsOrbit;                  // Absolute orbit number
 
  private:
+  template <class T> const T* GetColumn(const std::vector<T>& column, UInt_t bit) const
+  { return (fNumberOfColumnTracks>0 && (GetFilledTrackColumns()&bit))?&column[0]:NULL; }
+
   Int_t                   fNumberOfPOItypes;    // how many different flow particle types do we have? (RP,POI,POI_2,...)
   Int_t*                  fNumberOfPOIs;          //[fNumberOfPOItypes] number of tracks that have passed the POI selection
-
-  ClassDef(AliFlowEventSimple,7)
+  Int_t                   fNumberOfColumnTracks;  //! number of tracks in the columns
+  UInt_t                  fFilledColumns;         //! TrackColumn bits of the filled columns
+  ULong64_t               fColumnsTrackCounter;   //! AliFlowTrackSimple::GetModificationCounter() when the columns were filled
+  std::vector<Double_t>   fColumnPhi;             //! phi of the tracks
+  std::vector<Double_t>   fColumnPt;              //! pt of the tracks
+  std::vector<Double_t>   fColumnEta;             //! eta of the tracks
+  std::vector<Double_t>   fColumnWeight;          //! weight of the tracks
+  std::vector<Double_t>   fColumnMass;            //! mass of the tracks
+  std::vector<Int_t>      fColumnCharge;          //! charge of the tracks
+  std::vector<UInt_t>     fColumnPOItype;         //! bit n set if the track is of poi type n (RP=0), for n<32
+  std::vector<UChar_t>    fColumnSubevent;        //! bit i set if the track is in subevent i, for i<8
+  std::vector<UChar_t>    fColumnMask;            //! selection mask used by TagRP() and TagPOI()
+
+  ClassDef(AliFlowEventSimple,8)
 };
 
 #endif
@@ -31,6 +31,8 @@
 
 ClassImp(AliFlowTrackSimple)
 
+ULong64_t AliFlowTrackSimple::fgModificationCounter = 0;
+
 //-----------------------------------------------------------------------
 AliFlowTrackSimple::AliFlowTrackSimple():
   TObject(),
@@ -46,6 +48,7 @@ AliFlowTrackSimple::AliFlowTrackSimple():
   fITStype(0)
 {
   //constructor 
+  fgModificationCounter++;
 }
 
 //-----------------------------------------------------------------------
@@ -63,6 +66,7 @@ AliFlowTrackSimple::AliFlowTrackSimple(Double_t phi, Double_t eta, Double_t pt,
   fITStype(0)
 {
   //constructor
+  fgModificationCounter++;
 }
 
 //-----------------------------------------------------------------------
@@ -83,6 +87,7 @@ AliFlowTrackSimple::AliFlowTrackSimple( TParticle* p ):
   TParticlePDG* ppdg = p->GetPDG();
   fCharge = TMath::Nint(ppdg->Charge()/3.0);
   fMass = ppdg->Mass();
+  fgModificationCounter++;
 }
 
 //-----------------------------------------------------------------------
@@ -97,6 +102,7 @@ void AliFlowTrackSimple::Set(TParticle* p)
   fCharge = TMath::Nint(ppdg->Charge()/3.0);
   fMass = ppdg->Mass();
   fITStype = 0;
+  fgModificationCounter++;
 }
 
 //-----------------------------------------------------------------------
@@ -114,6 +120,7 @@ AliFlowTrackSimple::AliFlowTrackSimple(const AliFlowTrackSimple& aTrack):
   fITStype(aTrack.fITStype)
 {
   //copy constructor 
+  fgModificationCounter++;
 }
 
 //-----------------------------------------------------------------------
@@ -138,6 +145,7 @@ AliFlowTrackSimple& AliFlowTrackSimple::operator=(const AliFlowTrackSimple& aTra
   fSubEventBits = aTrack.fSubEventBits;
   fID = aTrack.fID;
   fITStype = aTrack.fITStype;
+  fgModificationCounter++;
 
   return *this;
 }
@@ -154,6 +162,7 @@ void AliFlowTrackSimple::ResolutionPt(Double_t res)
 {
   //smear the pt by a gaussian with sigma=res
   fPt += gRandom->Gaus(0.,res);
+  fgModificationCounter++;
 }
 
 //----------------------------------------------------------------------- 
@@ -176,6 +185,7 @@ void AliFlowTrackSimple::AddV1( Double_t v1,
     fPhi -= f/fp;
     if (TMath::AreEqualAbs(phiprev,fPhi,precisionPhi)) break;
   }
+  fgModificationCounter++;
 }
 
 //----------------------------------------------------------------------- 
@@ -198,6 +208,7 @@ void AliFlowTrackSimple::AddV2( Double_t v2,
     fPhi -= f/fp;
     if (TMath::AreEqualAbs(phiprev,fPhi,precisionPhi)) break;
   }
+  fgModificationCounter++;
 }
 
 //----------------------------------------------------------------------- 
@@ -220,6 +231,7 @@ void AliFlowTrackSimple::AddV3( Double_t v3,
     fPhi -= f/fp;
     if (TMath::AreEqualAbs(phiprev,fPhi,precisionPhi)) break;
   }
+  fgModificationCounter++;
 }
 
 //----------------------------------------------------------------------- 
@@ -242,6 +254,7 @@ void AliFlowTrackSimple::AddV4( Double_t v4,
     fPhi -= f/fp;
     if (TMath::AreEqualAbs(phiprev,fPhi,precisionPhi)) break;
   }
+  fgModificationCounter++;
 }
 
 //----------------------------------------------------------------------- 
@@ -264,6 +277,7 @@ void AliFlowTrackSimple::AddV5( Double_t v5,
     fPhi -= f/fp;
     if (TMath::AreEqualAbs(phiprev,fPhi,precisionPhi)) break;
   }
+  fgModificationCounter++;
 }
 
 //______________________________________________________________________________
@@ -307,6 +321,7 @@ void AliFlowTrackSimple::AddFlow( Double_t v1,
     fPhi -= f/fp;
     if (TMath::AreEqualAbs(phiprev,fPhi,precisionPhi)) break;
   }
+  fgModificationCounter++;
 }
 
 //______________________________________________________________________________
@@ -357,6 +372,7 @@ void AliFlowTrackSimple::AddFlow( Double_t v1,
     fPhi -= f/fp;
     if (TMath::AreEqualAbs(phiprev,fPhi,precisionPhi)) break;
   }
+  fgModificationCounter++;
 }
 
 //______________________________________________________________________________
@@ -387,4 +403,5 @@ void AliFlowTrackSimple::Clear(Option_t*)
   fSubEventBits.ResetAllBits();
   fID=-1;
   fITStype=0;
+  fgModificationCounter++;
 }
@@ -53,11 +53,11 @@ public:
   Bool_t InSubevent(Int_t i) const;
   void TagRP(Bool_t b=kTRUE) {SetForRPSelection(b);} 
   void TagPOI(Bool_t b=kTRUE) {SetForPOISelection(b);} 
-  void Tag(Int_t n, Bool_t b=kTRUE) {fPOItype.SetBitNumber(n,b);}
+  void Tag(Int_t n, Bool_t b=kTRUE) {fPOItype.SetBitNumber(n,b); fgModificationCounter++;}
   Bool_t CheckTag(Int_t n) {return fPOItype.TestBitNumber(n);}
   void SetForSubevent(Int_t i); 
-  void ResetPOItype() {fPOItype.ResetAllBits();}
-  void ResetSubEventTags() {fSubEventBits.ResetAllBits();}
+  void ResetPOItype() {fPOItype.ResetAllBits(); fgModificationCounter++;}
+  void ResetSubEventTags() {fSubEventBits.ResetAllBits(); fgModificationCounter++;}
   Bool_t IsDead() const {return (fPOItype.CountBits()==0);}
       
   void SetEta(Double_t eta);
@@ -133,6 +133,10 @@ public:
   virtual void SetDaughter(Int_t /*value*/, AliFlowTrackSimple* /*track*/) {}
   virtual AliFlowTrackSimple *GetDaughter(Int_t /*value*/) const {return NULL;}
 
+  // incremented by every change of the kinematics, weight, charge, mass or tags of any track,
+  // lets AliFlowEventSimple detect that its track columns are out of date
+  static ULong64_t GetModificationCounter() {return fgModificationCounter;}
+
  private:
   AliFlowTrackSimple(Double_t phi, Double_t eta, Double_t pt, Double_t weight, Int_t charge, Double_t mass=-1);
   Double_t fEta;         // eta
@@ -146,6 +150,8 @@ public:
   Int_t    fID;          // Unique track ID, point back to the ESD track
   Int_t    fITStype;     // ITS hits identifier (test purpose only)
 
+  static ULong64_t fgModificationCounter; //! number of track changes, see GetModificationCounter()
+
   ClassDef(AliFlowTrackSimple,2)                 // macro for rootcint
 
 };
@@ -177,30 +183,30 @@ inline Bool_t AliFlowTrackSimple::InSubevent(Int_t i) const {
 
 //Setters
 inline void AliFlowTrackSimple::SetEta(Double_t val) {
-  fEta = val; }
+  fEta = val; fgModificationCounter++; }
 inline void AliFlowTrackSimple::SetPt(Double_t val) {
-  fPt = val; }
+  fPt = val; fgModificationCounter++; }
 inline void AliFlowTrackSimple::SetPhi(Double_t val) {
-  fPhi = val; }
+  fPhi = val; fgModificationCounter++; }
 inline void AliFlowTrackSimple::SetWeight(Double_t val) {
-  fTrackWeight = val; }
+  fTrackWeight = val; fgModificationCounter++; }
 inline void AliFlowTrackSimple::SetCharge(Int_t val) {
-  fCharge = val; }
+  fCharge = val; fgModificationCounter++; }
 inline void AliFlowTrackSimple::SetMass(Double_t val) {
-  fMass = val; }
+  fMass = val; fgModificationCounter++; }
 inline void AliFlowTrackSimple::SetITStype(Int_t val) {
-  fITStype = val; }
+  fITStype = val; fgModificationCounter++; }
 
   //TBits
 inline void AliFlowTrackSimple::SetForRPSelection(Bool_t val) {
-  fPOItype.SetBitNumber(kRP,val); }
+  fPOItype.SetBitNumber(kRP,val); fgModificationCounter++; }
 inline void AliFlowTrackSimple::SetForPOISelection(Bool_t val) {
-  fPOItype.SetBitNumber(kPOI,val); }
+  fPOItype.SetBitNumber(kPOI,val); fgModificationCounter++; }
 inline void AliFlowTrackSimple::SetForSubevent(Int_t i) {
-  fSubEventBits.SetBitNumber(i,kTRUE); }
+  fSubEventBits.SetBitNumber(i,kTRUE); fgModificationCounter++; }
 
 inline void AliFlowTrackSimple::SetPOItype(Int_t poiType, Bool_t b) {
-  fPOItype.SetBitNumber(poiType,b); }
+  fPOItype.SetBitNumber(poiType,b); fgModificationCounter++; }
 
 #endif
 
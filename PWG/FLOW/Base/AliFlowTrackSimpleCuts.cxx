@@ -32,6 +32,7 @@
 #include "TParticlePDG.h"
 #include "AliFlowTrackSimpleCuts.h"
 #include "AliFlowTrackSimple.h"
+#include "AliFlowEventSimple.h"
 
 ClassImp(AliFlowTrackSimpleCuts)
 
@@ -134,6 +135,60 @@ Bool_t AliFlowTrackSimpleCuts::PassesCuts(const AliFlowTrackSimple *track) const
   return kTRUE;
 }
 
+//----------------------------------------------------------------------- 
+UInt_t AliFlowTrackSimpleCuts::GetUsedColumns() const
+{
+  //track columns of AliFlowEventSimple (TrackColumn bits) read by
+  //PassesCuts(const AliFlowEventSimple*, UChar_t*) with the cuts set
+  UInt_t columns = 0;
+  if(fCutPt) columns |= AliFlowEventSimple::kPtColumn;
+  if(fCutEta || fCutEtaGap) columns |= AliFlowEventSimple::kEtaColumn;
+  if(fCutPhi) columns |= AliFlowEventSimple::kPhiColumn;
+  if(fCutCharge) columns |= AliFlowEventSimple::kChargeColumn;
+  if(fCutMass) columns |= AliFlowEventSimple::kMassColumn;
+  if(fCutEtaPhiEff) columns |= AliFlowEventSimple::kEtaColumn | AliFlowEventSimple::kPhiColumn;
+  return columns;
+}
+
+//----------------------------------------------------------------------- 
+Int_t AliFlowTrackSimpleCuts::PassesCuts(const AliFlowEventSimple* event, UChar_t* mask) const
+{
+  //batched version of PassesCuts(const AliFlowTrackSimple*) on the track
+  //columns of the event (see AliFlowEventSimple::FillTrackColumns()):
+  //mask[i] must be set for the tracks to test and is cleared for the tracks
+  //failing the cuts. Each cut is applied to the whole array in one loop, the
+  //efficiency map draws its random numbers for the same tracks in the same
+  //order as the per track method. The columns of GetUsedColumns() have to be
+  //filled. Returns the number of selected tracks, -1 if a column is missing
+  Int_t n = event->NumberOfTracks();
+  if (n<=0) return 0;
+  UInt_t columns = GetUsedColumns();
+  if ((event->GetFilledTrackColumns() & columns) != columns) return -1;
+  const Double_t* pt = event->GetPtColumn();
+  const Double_t* eta = event->GetEtaColumn();
+  const Double_t* phi = event->GetPhiColumn();
+  const Double_t* mass = event->GetMassColumn();
+  const Int_t* charge = event->GetChargeColumn();
+  if(fCutPt) {for (Int_t i=0; i<n; i++) mask[i] = mask[i] && !(pt[i] < fPtMin || pt[i] >= fPtMax);}
+  if(fCutEta) {for (Int_t i=0; i<n; i++) mask[i] = mask[i] && !(eta[i] < fEtaMin || eta[i] >= fEtaMax);}
+  if(fCutPhi) {for (Int_t i=0; i<n; i++) mask[i] = mask[i] && !(phi[i] < fPhiMin || phi[i] >= fPhiMax);}
+  if(fCutCharge) {for (Int_t i=0; i<n; i++) mask[i] = mask[i] && (charge[i] == fCharge);}
+  if(fCutMass) {for (Int_t i=0; i<n; i++) mask[i] = mask[i] && !(mass[i] < fMassMin || mass[i] >= fMassMax);}
+  if(fCutEtaGap) {for (Int_t i=0; i<n; i++) mask[i] = mask[i] && !(eta[i] > fEtaGapMin && eta[i] < fEtaGapMax);}
+  if(fCutEtaPhiEff) {
+    Double_t maximum = fEtaPhiEff->GetMaximum();
+    Double_t phiOffset = fEtaPhiEff->GetYaxis()->GetXmin();
+    for (Int_t i=0; i<n; i++) {
+      if (!mask[i]) continue;
+      Int_t binX(fEtaPhiEff->GetXaxis()->FindBin(eta[i])), binY(fEtaPhiEff->GetYaxis()->FindBin(phi[i]+phiOffset));
+      if(fEtaPhiEff->GetBinContent(binX, binY) < gRandom->Uniform(0,1)*maximum) mask[i]=0;
+    }
+  }
+  Int_t nSelected = 0;
+  for (Int_t i=0; i<n; i++) nSelected += mask[i];
+  return nSelected;
+}
+
 //----------------------------------------------------------------------- 
 Bool_t AliFlowTrackSimpleCuts::PassesCuts(TParticle* track) const
 {
@@ -14,6 +14,7 @@
 #include "TNamed.h"
 
 class AliFlowTrackSimple;
+class AliFlowEventSimple;
 class TParticle;
 class TH2;
 
@@ -57,6 +58,8 @@ class AliFlowTrackSimpleCuts : public TNamed {
   //simple method to check if the simple track passes the simple cuts:
   Bool_t PassesCuts(const AliFlowTrackSimple *track) const;
   Bool_t PassesCuts(TParticle* p) const;
+  Int_t  PassesCuts(const AliFlowEventSimple* event, UChar_t* mask) const;
+  UInt_t GetUsedColumns() const;
 
   Int_t GetPOItype() const {return fPOItype;}
   void SetPOItype(Int_t t) {fPOItype=t;}
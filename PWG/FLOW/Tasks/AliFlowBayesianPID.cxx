@@ -33,10 +33,11 @@ ClassImp(AliFlowBayesianPID)
 TH2D* AliFlowBayesianPID::fghPriors[fgkNspecies] = {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL}; // histo with priors (hardcoded)
 TSpline3* AliFlowBayesianPID::fgMism = NULL; // function for mismatch
 TH1D* AliFlowBayesianPID::fgHtofChannelDist=NULL;
+const Float_t AliFlowBayesianPID::fgkTabRange=7.0; // range (in Nsigmas) of the response tables
 
 //________________________________________________________________________
 AliFlowBayesianPID::AliFlowBayesianPID(AliESDpid *esdpid) 
-  :      AliPIDResponse(), fPIDesd(NULL), fDB(TDatabasePDG::Instance()), fNewTrackParam(0), fTOFresolution(84.0), fTOFResponseF(NULL), fTPCResponseF(NULL),fWTofMism(0.0), fProbTofMism(0.0), fZ(0) ,fMassTOF(0), fBBdata(NULL),fCurrCentrality(100),fPsi(999),fPsiRes(999),fIsMC(kFALSE),fForceOldDedx(kFALSE),fDedx(0.0),fIsTOFheaderAOD(0)
+  :      AliPIDResponse(), fPIDesd(NULL), fDB(TDatabasePDG::Instance()), fNewTrackParam(0), fTOFresolution(84.0), fTOFResponseF(NULL), fTPCResponseF(NULL),fWTofMism(0.0), fProbTofMism(0.0), fZ(0) ,fMassTOF(0), fBBdata(NULL),fCurrCentrality(100),fPsi(999),fPsiRes(999),fIsMC(kFALSE),fForceOldDedx(kFALSE),fDedx(0.0),fIsTOFheaderAOD(0),fTabulated(kFALSE),fTabTolerance(1E-4),fTabStep(0.0),fTabDeviation(0.0),fTabTPC(),fTabTOF(),fPriorCentrBin(-1),fPriorCache()
 {
   // Constructor
   Bool_t redopriors = kFALSE;
@@ -540,6 +541,7 @@ Float_t AliFlowBayesianPID::GetExpDeDx(const AliVTrack *t,Float_t mass) const{
 //________________________________________________________________________
 void AliFlowBayesianPID::ComputeWeights(const AliESDtrack *t){
   // compute Detector weights for Bayesian probablities
+  if(fTabulated && fTabTPC.empty()) BuildResponseTables(); // e.g. after reading the object from file
   Float_t centr = fCurrCentrality;
 
   Float_t pt = t->Pt();
@@ -633,7 +635,7 @@ void AliFlowBayesianPID::ComputeWeights(const AliESDtrack *t){
       else if(centr < 70) resolutionTPC *= 0.88;
       else resolutionTPC *= 0.83;
       
-      fWeights[0][iS] = fTPCResponseF->Eval((dedx - dedxExp)/resolutionTPC)/resolutionTPC;
+      fWeights[0][iS] = EvalResponse(fTPCResponseF,fTabTPC,(dedx - dedxExp)/resolutionTPC)/resolutionTPC;
     }
     fMaskCurrent[0] = kTRUE;
   }
@@ -674,7 +676,7 @@ void AliFlowBayesianPID::ComputeWeights(const AliESDtrack *t){
       if (TMath::Abs(delta) > 5*expsigma) {
 	fWeights[1][iS] = mismfrac*mismweight;
       } else
-	fWeights[1][iS] = fTOFResponseF->Eval(delta/expsigma)/expsigma + mismfrac*mismweight;
+	fWeights[1][iS] = EvalResponse(fTOFResponseF,fTabTOF,delta/expsigma)/expsigma + mismfrac*mismweight;
     }
     fMaskCurrent[1] = kTRUE;
   }
@@ -695,6 +697,7 @@ void AliFlowBayesianPID::ComputeWeights(const AliESDtrack *t){
 //________________________________________________________________________
 void AliFlowBayesianPID::ComputeWeights(const AliAODTrack *t,const AliAODEvent *aod){
   // compute Detector weights for Bayesian probablities
+  if(fTabulated && fTabTPC.empty()) BuildResponseTables(); // e.g. after reading the object from file
   Float_t centr = fCurrCentrality;
 
   Float_t pt = t->Pt();
@@ -782,7 +785,7 @@ void AliFlowBayesianPID::ComputeWeights(const AliAODTrack *t,const AliAODEvent *
       else if(centr < 70) resolutionTPC *= 0.88;
       else resolutionTPC *= 0.83;
       
-      fWeights[0][iS] = fTPCResponseF->Eval((dedx - dedxExp)/resolutionTPC)/resolutionTPC;
+      fWeights[0][iS] = EvalResponse(fTPCResponseF,fTabTPC,(dedx - dedxExp)/resolutionTPC)/resolutionTPC;
     }
     fMaskCurrent[0] = kTRUE;
   }
@@ -850,7 +853,7 @@ void AliFlowBayesianPID::ComputeWeights(const AliAODTrack *t,const AliAODEvent *
       if (TMath::Abs(delta) > 5*expsigma) {
 	fWeights[1][iS] = mismfrac*mismweight;
       } else
-	fWeights[1][iS] = fTOFResponseF->Eval(delta/expsigma)/expsigma + mismfrac*mismweight;
+	fWeights[1][iS] = EvalResponse(fTOFResponseF,fTabTOF,delta/expsigma)/expsigma + mismfrac*mismweight;
     }
     fMaskCurrent[1] = kTRUE;
   }
@@ -875,9 +878,7 @@ void AliFlowBayesianPID::ComputeProb(const AliESDtrack *t,Float_t /*centrObsolet
   Float_t priors[fgkNspecies];
   fProbTofMism = 0;
 
-  Float_t centr = fCurrCentrality;
-
-  for(Int_t iS=0;iS<fgkNspecies;iS++) priors[iS] = fghPriors[iS]->GetBinContent(fghPriors[iS]->GetXaxis()->FindBin(centr),fghPriors[iS]->GetYaxis()->FindBin(t->Pt()));
+  GetPriors(t->Pt(),priors);
 
 
   if((!fMaskAND[0] || fMaskCurrent[0]) && (!fMaskAND[1] || fMaskCurrent[1])){
@@ -938,9 +939,7 @@ void AliFlowBayesianPID::ComputeProb(const AliAODTrack *t, const AliAODEvent *ao
   Float_t priors[fgkNspecies];
   fProbTofMism = 0;
 
-  Float_t centr = fCurrCentrality;
-
-  for(Int_t iS=0;iS<fgkNspecies;iS++) priors[iS] = fghPriors[iS]->GetBinContent(fghPriors[iS]->GetXaxis()->FindBin(centr),fghPriors[iS]->GetYaxis()->FindBin(t->Pt()));
+  GetPriors(t->Pt(),priors);
 
 
   if((!fMaskAND[0] || fMaskCurrent[0]) && (!fMaskAND[1] || fMaskCurrent[1])){
@@ -994,6 +993,91 @@ void AliFlowBayesianPID::ComputeProb(const AliAODTrack *t, const AliAODEvent *ao
   
 }
 //________________________________________________________________________
+void AliFlowBayesianPID::GetPriors(Float_t pt,Float_t *priors){
+  // priors of all the species for the current centrality
+  Float_t centr = fCurrCentrality;
+
+  if(!fTabulated){
+    for(Int_t iS=0;iS<fgkNspecies;iS++) priors[iS] = fghPriors[iS]->GetBinContent(fghPriors[iS]->GetXaxis()->FindBin(centr),fghPriors[iS]->GetYaxis()->FindBin(pt));
+    return;
+  }
+
+  // all the prior histos share the same binning: cache the pT row of the current centrality bin
+  // (species contiguous) and read it with a single bin search per track
+  Int_t binCentr = fghPriors[0]->GetXaxis()->FindBin(centr);
+  Int_t nbinsPt = fghPriors[0]->GetNbinsY()+2;
+  if(binCentr != fPriorCentrBin){
+    fPriorCache.resize(nbinsPt*fgkNspecies);
+    for(Int_t ipt=0;ipt < nbinsPt;ipt++)
+      for(Int_t iS=0;iS<fgkNspecies;iS++) fPriorCache[ipt*fgkNspecies+iS] = fghPriors[iS]->GetBinContent(binCentr,ipt);
+    fPriorCentrBin = binCentr;
+  }
+  const Float_t *row = &fPriorCache[fghPriors[0]->GetYaxis()->FindBin(pt)*fgkNspecies];
+  for(Int_t iS=0;iS<fgkNspecies;iS++) priors[iS] = row[iS];
+}
+//________________________________________________________________________
+void AliFlowBayesianPID::SetTabulated(Bool_t flag,Float_t tolerance){
+  // switch on/off the tabulated response functions and the cached priors
+  fTabulated = flag;
+  fTabTolerance = tolerance;
+  fTabTPC.clear();
+  fTabTOF.clear();
+  fPriorCentrBin = -1;
+  if(fTabulated) BuildResponseTables();
+}
+//________________________________________________________________________
+Float_t AliFlowBayesianPID::GetTabulatedDeviation(){
+  // max deviation of the response tables from the response functions (relative to their maximum)
+  if(fTabulated && fTabTPC.empty()) BuildResponseTables();
+  return fTabDeviation;
+}
+//________________________________________________________________________
+Float_t AliFlowBayesianPID::EvalResponse(const TF1 *f,const std::vector<Float_t> &table,Float_t x) const{
+  // response function in x (Nsigmas), linearly interpolated in the table if available
+  if(!fTabulated || table.empty()) return f->Eval(x);
+  Float_t u = (x + fgkTabRange)/fTabStep;
+  if(!(u >= 0) || u >= table.size()-1) return f->Eval(x); // outside the table (or nan)
+  Int_t i = Int_t(u);
+  return table[i] + (u - i)*(table[i+1] - table[i]);
+}
+//________________________________________________________________________
+void AliFlowBayesianPID::BuildResponseTables(){
+  // tabulate the TPC and TOF response functions in [-7,7] Nsigmas; the step is halved
+  // until the linear interpolation in the middle of each step agrees with the
+  // functions within fTabTolerance (relative to their maximum)
+  const TF1 *func[2] = {fTPCResponseF,fTOFResponseF};
+  std::vector<Float_t> *table[2] = {&fTabTPC,&fTabTOF};
+
+  Int_t npoints = 1401;
+  for(Int_t iter=0;iter < 8;iter++){
+    fTabStep = 2*fgkTabRange/(npoints-1);
+    fTabDeviation = 0;
+    for(Int_t j=0;j < 2;j++){
+      std::vector<Float_t> &tab = *(table[j]);
+      tab.resize(npoints);
+      Float_t fmax = 0;
+      for(Int_t i=0;i < npoints;i++){
+        Double_t x = -fgkTabRange + i*fTabStep;
+        tab[i] = func[j]->Eval(x);
+        // the formula is null exactly at the junction of the gaussian and of the tail
+        if(tab[i] <= 0) tab[i] = func[j]->Eval(x + 1E-6*fTabStep);
+        if(tab[i] > fmax) fmax = tab[i];
+      }
+      if(fmax <= 0) fmax = 1;
+      for(Int_t i=0;i < npoints-1;i++){
+        Double_t x = -fgkTabRange + (i+0.5)*fTabStep;
+        Float_t dev = TMath::Abs(0.5*(tab[i]+tab[i+1]) - func[j]->Eval(x))/fmax;
+        if(dev > fTabDeviation) fTabDeviation = dev;
+      }
+    }
+    if(fTabDeviation <= fTabTolerance) break;
+    npoints = 2*npoints-1;
+  }
+
+  if(fTabDeviation > fTabTolerance)
+    printf("AliFlowBayesianPID::BuildResponseTables -> Warning -> max deviation %g above the tolerance %g\n",fTabDeviation,fTabTolerance);
+}
+//________________________________________________________________________
 void AliFlowBayesianPID::SetPsiCorrectionDeDx(Float_t psi,Float_t res){
   fPsi=psi;
   fPsiRes=res;
@@ -7,6 +7,7 @@
 #ifndef ALIFLOWBAYESIANPID_H
 #define ALIFLOWBAYESIANPID_H
 
+#include <vector>
 #include "AliESDpid.h"
 #include "AliPIDResponse.h"
 
@@ -68,6 +69,12 @@ More details:
      TH2D *hPr = mypid->GetHistoPriors(isp); // 2D (centrality - pT) histo for the priors of specie-isp (centrality < 0 means pp collisions)
                                              // all the priors are normalized to the pion ones
 
+tabulated mode (faster, to be set before the track loop)
+
+     mypid->SetTabulated(kTRUE,1E-4); // TPC and TOF response functions (in Nsigmas) interpolated in tables built with a max deviation of 1E-4
+                                      // priors read from the pT row of the current centrality bin, cached once per centrality bin
+     Float_t dev = mypid->GetTabulatedDeviation(); // max deviation of the tables from the exact response functions
+
 */
 
 class AliFlowBayesianPID : public AliPIDResponse{
@@ -88,6 +95,7 @@ class AliFlowBayesianPID : public AliPIDResponse{
   void ResetDetOR(Int_t idet){if(idet < fgkNdetectors && idet >= 0) fMaskOR[idet] = kFALSE;};
   void SetPsiCorrectionDeDx(Float_t psi,Float_t res);
   void SetMC(Bool_t flag){fIsMC=flag;};
+  void SetTabulated(Bool_t flag=kTRUE,Float_t tolerance=1E-4);
 
   // getter
   AliESDpid* GetESDpid(){return fPIDesd;};
@@ -104,6 +112,9 @@ class AliFlowBayesianPID : public AliPIDResponse{
   Bool_t GetDetANDstatus(Int_t idet) const {if(idet < fgkNdetectors && idet >= 0){return fMaskAND[idet];} else{return kFALSE;} };
   Bool_t GetDetORstatus(Int_t idet) const {if(idet < fgkNdetectors && idet >= 0){return fMaskOR[idet];} else{return kFALSE;} };
   Bool_t GetCurrentMask(Int_t idet) const {if(idet < fgkNdetectors && idet >= 0){return fMaskCurrent[idet];} else{return kFALSE;} };
+  Bool_t GetTabulated() const {return fTabulated;};
+  Float_t GetTabulatedTolerance() const {return fTabTolerance;};
+  Float_t GetTabulatedDeviation();
 
   Float_t GetExpDeDx(const AliVTrack *t,Int_t iS) const;
   Float_t GetExpDeDx(const AliVTrack *t,Float_t m) const;
@@ -123,6 +134,9 @@ class AliFlowBayesianPID : public AliPIDResponse{
 
  private: 
   void SetPriors();
+  void BuildResponseTables();
+  void GetPriors(Float_t pt,Float_t *priors);
+  Float_t EvalResponse(const TF1 *f,const std::vector<Float_t> &table,Float_t x) const;
 
   static const Int_t fgkNdetectors = 2; // Number of detector used for PID
   static const Int_t fgkNspecies = 9;// 0=el, 1=mu, 2=pi, 3=ka, 4=pr, 5=deuteron, 6=triton, 7=He3 
@@ -164,7 +178,18 @@ class AliFlowBayesianPID : public AliPIDResponse{
 
   static TH1D *fgHtofChannelDist; // channel distance from IP
 
-  ClassDef(AliFlowBayesianPID, 10); // example of analysis
+  static const Float_t fgkTabRange; // range (in Nsigmas) of the response tables
+
+  Bool_t fTabulated; // switch for tabulated response functions and cached priors
+  Float_t fTabTolerance; // max deviation allowed for the tabulated response functions
+  Float_t fTabStep; //! step (in Nsigmas) of the response tables
+  Float_t fTabDeviation; //! max deviation of the response tables from the response functions
+  std::vector<Float_t> fTabTPC; //! tabulated TPC response function (in Nsigmas)
+  std::vector<Float_t> fTabTOF; //! tabulated TOF response function (in Nsigmas)
+  Int_t fPriorCentrBin; //! centrality bin of the cached priors
+  std::vector<Float_t> fPriorCache; //! priors of the cached centrality bin, per pT bin and specie
+
+  ClassDef(AliFlowBayesianPID, 11); // example of analysis
 };
 
 #endif
@@ -62,6 +62,7 @@
 #include "AliFlowTrackSimple.h"
 #include "AliFlowTrack.h"
 #include "AliFlowTrackCuts.h"
+#include "AliFlowEventSimple.h"
 #include "AliLog.h"
 #include "AliESDpid.h"
 #include "AliESDPmdTrack.h"
@@ -889,6 +890,19 @@ Bool_t AliFlowTrackCuts::PassesCuts(const AliFlowTrackSimple* track)
   return AliFlowTrackSimpleCuts::PassesCuts(track);
 }
 
+//-----------------------------------------------------------------------
+Int_t AliFlowTrackCuts::PassesCuts(const AliFlowEventSimple* event, UChar_t* mask)
+{
+  //check cuts on all the flow tracks of an event at once, using the track
+  //columns of the event (AliFlowEventSimple::FillTrackColumns()): on input
+  //mask[i] selects the tracks to test, on output it flags the ones passing.
+  //Returns the number of tracks passing the cuts
+
+  //clean up from last iteration
+  ClearTrack();
+  return AliFlowTrackSimpleCuts::PassesCuts(event,mask);
+}
+
 //-----------------------------------------------------------------------
 Bool_t AliFlowTrackCuts::PassesCuts(const AliMultiplicity* tracklet, Int_t id)
 {
@@ -28,6 +28,7 @@ class TArrayD;
 class AliVParticle;
 class AliMCParticle;
 class AliFlowTrack;
+class AliFlowEventSimple;
 class AliMCEvent;
 class AliInputEventHandler;
 class AliVEvent;
@@ -289,6 +290,7 @@ class AliFlowTrackCuts : public AliFlowTrackSimpleCuts {
   Bool_t PassesPMDcuts(const AliESDPmdTrack* track);
   Bool_t PassesVZEROcuts(Int_t id);
   Bool_t PassesCuts(const AliFlowTrackSimple* track);
+  Int_t  PassesCuts(const AliFlowEventSimple* event, UChar_t* mask);
   Bool_t PassesCuts(const AliMultiplicity* track, Int_t id);
   Bool_t PassesCuts(const AliAODTracklets* track, Int_t id);  // XZhang 20120615
   Bool_t PassesCuts(const AliESDkink* kink);
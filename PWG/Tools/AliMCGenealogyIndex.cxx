@@ -0,0 +1,287 @@
+/**************************************************************************
+ * Copyright(c) 1998-2019, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+//
+// Per-event index of the MC genealogy: mother, ultimate ancestor, heavy-flavour
+// content of the mother chain and primary/secondary flags, computed lazily and
+// memoized until the MC event changes.
+//
+
+#include <TClonesArray.h>
+#include <TMath.h>
+#include "AliAnalysisManager.h"
+#include "AliAODMCParticle.h"
+#include "AliMCEvent.h"
+#include "AliMCGenealogyIndex.h"
+#include "AliVParticle.h"
+
+ClassImp(AliMCGenealogyIndex)
+
+AliMCGenealogyIndex *AliMCGenealogyIndex::fgInstance = 0x0;
+
+//________________________________________________________________________
+AliMCGenealogyIndex::AliMCGenealogyIndex() :
+  TObject(),
+  fMCEvent(0x0),
+  fArrayMC(0x0),
+  fEntry(-1),
+  fFirstPx(0.),
+  fMother(),
+  fPdg(),
+  fAncestor(),
+  fChain(),
+  fStatus()
+{
+}
+
+//________________________________________________________________________
+AliMCGenealogyIndex *AliMCGenealogyIndex::Instance()
+{
+  if(!fgInstance) fgInstance = new AliMCGenealogyIndex();
+  return fgInstance;
+}
+
+//________________________________________________________________________
+UInt_t AliMCGenealogyIndex::PdgFlags(Int_t pdg)
+{
+  Int_t abspdg = TMath::Abs(pdg);
+  UInt_t flags = 0;
+  if((abspdg > 500 && abspdg < 600) || (abspdg > 5000 && abspdg < 6000)) flags |= kBeautyHadron;
+  if((abspdg > 400 && abspdg < 500) || (abspdg > 4000 && abspdg < 5000)) flags |= kCharmHadron;
+  if(abspdg == 5) flags |= kBeautyQuark;
+  if(abspdg == 4) flags |= kCharmQuark;
+  return flags;
+}
+
+//________________________________________________________________________
+Bool_t AliMCGenealogyIndex::IsStale(const TObject *source, Int_t nParticles, Double_t firstPx) const
+{
+  if(source != (fMCEvent ? (const TObject *)fMCEvent : (const TObject *)fArrayMC)) return kTRUE;
+  if(nParticles != (Int_t)fMother.size()) return kTRUE;
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  if(mgr && mgr->GetCurrentEntry() != fEntry) return kTRUE;
+  return firstPx != fFirstPx;
+}
+
+//________________________________________________________________________
+void AliMCGenealogyIndex::Prepare(Int_t nParticles, Double_t firstPx)
+{
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  fEntry = mgr ? mgr->GetCurrentEntry() : -1;
+  fFirstPx = firstPx;
+  fMother.assign(nParticles, -1);
+  fPdg.assign(nParticles, 0);
+  fAncestor.assign(nParticles, -1);
+  fChain.assign(nParticles, -1);
+  fStatus.assign(nParticles, 0);
+}
+
+//________________________________________________________________________
+Bool_t AliMCGenealogyIndex::Update(AliMCEvent *mcEvent)
+{
+  /// Attach the index to an MC event (ESD or AOD); the memoized entries are dropped if the event changed.
+  /// Returns kTRUE if the index was reset.
+  if(!mcEvent) {
+    Reset();
+    return kTRUE;
+  }
+  Int_t nParticles = mcEvent->GetNumberOfTracks();
+  AliVParticle *first = nParticles > 0 ? mcEvent->GetTrack(0) : 0x0;
+  Double_t firstPx = first ? first->Px() : 0.;
+  if(!IsStale(mcEvent, nParticles, firstPx)) return kFALSE;
+  fMCEvent = mcEvent;
+  fArrayMC = 0x0;
+  Prepare(nParticles, firstPx);
+  return kTRUE;
+}
+
+//________________________________________________________________________
+Bool_t AliMCGenealogyIndex::Update(TClonesArray *arrayMC)
+{
+  /// Attach the index to an AOD MC particle array; the memoized entries are dropped if the event changed.
+  /// Returns kTRUE if the index was reset.
+  if(!arrayMC) {
+    Reset();
+    return kTRUE;
+  }
+  Int_t nParticles = arrayMC->GetEntriesFast();
+  AliAODMCParticle *first = nParticles > 0 ? dynamic_cast<AliAODMCParticle *>(arrayMC->UncheckedAt(0)) : 0x0;
+  Double_t firstPx = first ? first->Px() : 0.;
+  if(!IsStale(arrayMC, nParticles, firstPx)) return kFALSE;
+  fMCEvent = 0x0;
+  fArrayMC = arrayMC;
+  Prepare(nParticles, firstPx);
+  return kTRUE;
+}
+
+//________________________________________________________________________
+void AliMCGenealogyIndex::Reset()
+{
+  fMCEvent = 0x0;
+  fArrayMC = 0x0;
+  fEntry = -1;
+  fFirstPx = 0.;
+  fMother.clear();
+  fPdg.clear();
+  fAncestor.clear();
+  fChain.clear();
+  fStatus.clear();
+}
+
+//________________________________________________________________________
+void AliMCGenealogyIndex::LoadParticle(Int_t label)
+{
+  if(fStatus[label] & kParticleKnown) return;
+  fStatus[label] |= kParticleKnown;
+  if(fMCEvent) {
+    AliVParticle *part = fMCEvent->GetTrack(label);
+    if(!part) return;
+    fMother[label] = part->GetMother();
+    fPdg[label] = part->PdgCode();
+  } else {
+    AliAODMCParticle *part = dynamic_cast<AliAODMCParticle *>(fArrayMC->UncheckedAt(label));
+    if(!part) return;
+    fMother[label] = part->GetMother();
+    fPdg[label] = part->GetPdgCode();
+  }
+  // labels outside the stack end the chain
+  if(fMother[label] >= (Int_t)fMother.size()) fMother[label] = -1;
+}
+
+//________________________________________________________________________
+void AliMCGenealogyIndex::LoadStatus(Int_t label)
+{
+  if(fStatus[label] & kStatusKnown) return;
+  fStatus[label] |= kStatusKnown;
+  if(fMCEvent) {
+    // through the particle, so that AliMCEvent on top of AOD MC particles also works
+    AliVParticle *part = fMCEvent->GetTrack(label);
+    if(!part) return;
+    if(part->IsPhysicalPrimary()) fStatus[label] |= kPhysPrimary;
+    if(fMCEvent->IsSecondaryFromWeakDecay(label)) fStatus[label] |= kSecFromWeak;
+  } else {
+    AliAODMCParticle *part = dynamic_cast<AliAODMCParticle *>(fArrayMC->UncheckedAt(label));
+    if(!part) return;
+    if(part->IsPhysicalPrimary()) fStatus[label] |= kPhysPrimary;
+    if(part->IsSecondaryFromWeakDecay()) fStatus[label] |= kSecFromWeak;
+  }
+}
+
+//________________________________________________________________________
+Int_t AliMCGenealogyIndex::GetMother(Int_t label)
+{
+  if(!Valid(label)) return -1;
+  LoadParticle(label);
+  return fMother[label];
+}
+
+//________________________________________________________________________
+Int_t AliMCGenealogyIndex::GetPdgCode(Int_t label)
+{
+  if(!Valid(label)) return 0;
+  LoadParticle(label);
+  return fPdg[label];
+}
+
+//________________________________________________________________________
+Int_t AliMCGenealogyIndex::GetUltimateAncestor(Int_t label)
+{
+  /// Label of the first particle of the mother chain (the particle itself if it has no mother)
+  if(!Valid(label)) return -1;
+  if(fAncestor[label] >= 0) return fAncestor[label];
+
+  // walk up until a particle with a known ancestor or without mother, then propagate down
+  std::vector<Int_t> chain;
+  Int_t current = label;
+  Int_t ancestor = -1;
+  Int_t nsteps = fMother.size();
+  while(nsteps-- > 0) {
+    if(fAncestor[current] >= 0) {
+      ancestor = fAncestor[current];
+      break;
+    }
+    chain.push_back(current);
+    Int_t mother = GetMother(current);
+    if(mother < 0 || mother == current) {
+      ancestor = current;
+      break;
+    }
+    current = mother;
+  }
+  if(ancestor < 0) ancestor = current;
+  for(UInt_t i = 0; i < chain.size(); i++) fAncestor[chain[i]] = ancestor;
+  return ancestor;
+}
+
+//________________________________________________________________________
+UInt_t AliMCGenealogyIndex::GetChainFlags(Int_t label)
+{
+  /// EChainFlag bits of the particle itself and of all its ancestors with label > 0
+  if(!Valid(label) || label == 0) return 0;
+  if(fChain[label] >= 0) return fChain[label];
+
+  std::vector<Int_t> chain;
+  Int_t current = label;
+  UInt_t flags = 0;
+  Int_t nsteps = fMother.size();
+  while(current > 0 && nsteps-- > 0) {
+    if(fChain[current] >= 0) {
+      flags = fChain[current];
+      break;
+    }
+    chain.push_back(current);
+    Int_t mother = GetMother(current);
+    if(mother == current) break;
+    current = mother;
+  }
+  for(Int_t i = chain.size() - 1; i >= 0; i--) {
+    flags |= PdgFlags(fPdg[chain[i]]);
+    fChain[chain[i]] = flags;
+  }
+  return flags;
+}
+
+//________________________________________________________________________
+Int_t AliMCGenealogyIndex::GetQuarkOrigin(Int_t label, Bool_t searchUpToQuark)
+{
+  /// 4 (charm) or 5 (beauty) depending on the heavy-flavour content of the mothers of the particle,
+  /// 0 if searchUpToQuark is set and no charm or beauty quark is found in the chain
+  Int_t mother = GetMother(label);
+  return QuarkOrigin(mother > 0 ? GetChainFlags(mother) : 0, searchUpToQuark);
+}
+
+//________________________________________________________________________
+Int_t AliMCGenealogyIndex::QuarkOrigin(UInt_t chainFlags, Bool_t searchUpToQuark)
+{
+  if(searchUpToQuark && !(chainFlags & (kBeautyQuark | kCharmQuark))) return 0;
+  if(chainFlags & kBeautyHadron) return 5;
+  return 4;
+}
+
+//________________________________________________________________________
+Bool_t AliMCGenealogyIndex::IsPhysicalPrimary(Int_t label)
+{
+  if(!Valid(label)) return kFALSE;
+  LoadStatus(label);
+  return (fStatus[label] & kPhysPrimary) != 0;
+}
+
+//________________________________________________________________________
+Bool_t AliMCGenealogyIndex::IsSecondaryFromWeakDecay(Int_t label)
+{
+  if(!Valid(label)) return kFALSE;
+  LoadStatus(label);
+  return (fStatus[label] & kSecFromWeak) != 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * \file AliMCGenealogyIndex.h
+ * \brief Declaration of class AliMCGenealogyIndex
+ *
+ * Per-event index of the MC genealogy, shared by the truth-matching helpers.
+ * For every particle of the MC stack (AliMCEvent, or AOD array of AliAODMCParticle)
+ * the mother label, PDG code, ultimate ancestor, heavy-flavour content of the mother
+ * chain and the physical-primary / secondary-from-weak-decay flags are stored in flat
+ * arrays. The entries are computed the first time they are requested and then memoized,
+ * so that the mother chains are walked at most once per event, whatever the number of
+ * tasks and candidates asking for them.
+ */
+#ifndef ALIMCGENEALOGYINDEX_H
+#define ALIMCGENEALOGYINDEX_H
+
+/* Copyright(c) 1998-2019, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <vector>
+#include <TObject.h>
+
+class TClonesArray;
+class AliMCEvent;
+
+class AliMCGenealogyIndex : public TObject {
+public:
+  /// Content of a mother chain, see GetChainFlags()
+  enum EChainFlag {
+    kBeautyHadron = BIT(0),
+    kCharmHadron  = BIT(1),
+    kBeautyQuark  = BIT(2),
+    kCharmQuark   = BIT(3)
+  };
+
+  AliMCGenealogyIndex();
+  virtual ~AliMCGenealogyIndex() {}
+
+  static AliMCGenealogyIndex *Instance();
+
+  Bool_t Update(AliMCEvent *mcEvent);
+  Bool_t Update(TClonesArray *arrayMC);
+  void Reset();
+
+  Int_t GetNParticles() const { return fMother.size(); }
+  Int_t GetMother(Int_t label);
+  Int_t GetPdgCode(Int_t label);
+  Int_t GetUltimateAncestor(Int_t label);
+  UInt_t GetChainFlags(Int_t label);
+  Int_t GetQuarkOrigin(Int_t label, Bool_t searchUpToQuark);
+  Bool_t IsPhysicalPrimary(Int_t label);
+  Bool_t IsSecondaryFromWeakDecay(Int_t label);
+
+  static UInt_t PdgFlags(Int_t pdg);
+  static Int_t QuarkOrigin(UInt_t chainFlags, Bool_t searchUpToQuark);
+
+private:
+  AliMCGenealogyIndex(const AliMCGenealogyIndex &);
+  AliMCGenealogyIndex &operator=(const AliMCGenealogyIndex &);
+
+  enum EStatus {
+    kStatusKnown     = BIT(0),
+    kPhysPrimary     = BIT(1),
+    kSecFromWeak     = BIT(2),
+    kParticleKnown   = BIT(3)
+  };
+
+  Bool_t IsStale(const TObject *source, Int_t nParticles, Double_t firstPx) const;
+  void Prepare(Int_t nParticles, Double_t firstPx);
+  Bool_t Valid(Int_t label) const { return label >= 0 && label < (Int_t)fMother.size(); }
+  void LoadParticle(Int_t label);
+  void LoadStatus(Int_t label);
+
+  static AliMCGenealogyIndex *fgInstance;   ///< shared instance
+
+  AliMCEvent                 *fMCEvent;     //!<! ESD source of the current event
+  TClonesArray               *fArrayMC;     //!<! AOD source of the current event
+  Long64_t                    fEntry;       //!<! analysis manager entry the index was built for
+  Double_t                    fFirstPx;     //!<! px of the first particle, to detect a new event outside the analysis manager
+  std::vector<Int_t>          fMother;      //!<! mother label
+  std::vector<Int_t>          fPdg;         //!<! PDG code
+  std::vector<Int_t>          fAncestor;    //!<! ultimate ancestor label (-1 if not yet computed)
+  std::vector<Int_t>          fChain;       //!<! chain flags of the particle and its ancestors (-1 if not yet computed)
+  std::vector<UChar_t>        fStatus;      //!<! EStatus bits
+
+  ClassDef(AliMCGenealogyIndex, 1); // Per-event index of the MC genealogy
+};
+
+#endif /* ALIMCGENEALOGYINDEX_H */
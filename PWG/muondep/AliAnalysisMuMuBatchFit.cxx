@@ -0,0 +1,625 @@
+/**************************************************************************
+ * Copyright(c) 1998-2019, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+#include "AliAnalysisMuMuBatchFit.h"
+
+#include "TH1.h"
+#include "TMath.h"
+#include "TROOT.h"
+#include "Fit/Fitter.h"
+#include "AliLog.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+namespace {
+
+  const Double_t kDeltaMassPsiPJPsi = 3.68609-3.096916;
+
+  //____________________________________________________________________________
+  void AddCrystalBallExtended(const Double_t* x, Int_t n, const Double_t* p,
+                              const Int_t* index, const Double_t* chain,
+                              Double_t* y, Double_t* dy, Int_t stride)
+  {
+    /// Add the extended crystal ball p[0..6] to y, and its derivatives
+    /// (times chain[i]) to dy[index[i]*stride+k] if dy is not null.
+    /// Same definition as AliAnalysisMuMuJpsiResult::FitFunctionSignalCrystalBallExtended
+
+    const Double_t norm = p[0];
+    const Double_t mean = p[1];
+    const Double_t sigma = p[2];
+    const Double_t sign = ( p[3] < 0 ) ? -1.0 : 1.0;
+    const Double_t absAlpha = std::fabs(p[3]);
+    const Double_t nL = p[4];
+    const Double_t absAlpha2 = std::fabs(p[5]);
+    const Double_t nR = p[6];
+    const Double_t signAlpha2 = ( p[5] < 0 ) ? -1.0 : 1.0;
+
+    const Double_t logA = nL*std::log(nL/absAlpha) - 0.5*absAlpha*absAlpha;
+    const Double_t b = nL/absAlpha - absAlpha;
+    const Double_t logC = nR*std::log(nR/absAlpha2) - 0.5*absAlpha2*absAlpha2;
+    const Double_t d = nR/absAlpha2 - absAlpha2;
+
+    for ( Int_t k = 0; k < n; ++k )
+    {
+      const Double_t t = sign*(x[k]-mean)/sigma;
+      Double_t shape(0.);
+      Double_t dLogdt(0.), dLogdn(0.), dLogdAlpha(0.), dLogdn2(0.), dLogdAlpha2(0.);
+
+      if ( t >= -absAlpha && t < absAlpha2 ) // gaussian core
+      {
+        shape = std::exp(-0.5*t*t);
+        dLogdt = -t;
+      }
+      else if ( t < -absAlpha ) // left tail
+      {
+        const Double_t bt = b - t;
+        shape = std::exp(logA - nL*std::log(bt));
+        dLogdt = nL/bt;
+        dLogdn = std::log(nL/absAlpha) + 1.0 - std::log(bt) - nL/bt/absAlpha;
+        dLogdAlpha = sign*( -nL/absAlpha - absAlpha + nL/bt*(nL/(absAlpha*absAlpha)+1.0) );
+      }
+      else // right tail
+      {
+        const Double_t dt = d + t;
+        shape = std::exp(logC - nR*std::log(dt));
+        dLogdt = -nR/dt;
+        dLogdn2 = std::log(nR/absAlpha2) + 1.0 - std::log(dt) - nR/dt/absAlpha2;
+        dLogdAlpha2 = signAlpha2*( -nR/absAlpha2 - absAlpha2 + nR/dt*(nR/(absAlpha2*absAlpha2)+1.0) );
+      }
+
+      const Double_t f = norm*shape;
+      y[k] += f;
+
+      if (!dy) continue;
+
+      const Double_t dfdt = f*dLogdt;
+      dy[index[0]*stride+k] += chain[0]*shape;
+      dy[index[1]*stride+k] += chain[1]*dfdt*(-sign/sigma);
+      dy[index[2]*stride+k] += chain[2]*dfdt*(-t/sigma);
+      dy[index[3]*stride+k] += chain[3]*f*dLogdAlpha;
+      dy[index[4]*stride+k] += chain[4]*f*dLogdn;
+      dy[index[5]*stride+k] += chain[5]*f*dLogdAlpha2;
+      dy[index[6]*stride+k] += chain[6]*f*dLogdn2;
+    }
+  }
+
+  //____________________________________________________________________________
+  void AddNA60New(const Double_t* x, Int_t n, const Double_t* p, Double_t* y)
+  {
+    /// Add the NA60 (new) function p[0..10] to y.
+    /// Same definition as AliAnalysisMuMuJpsiResult::FitFunctionNA60New
+
+    for ( Int_t k = 0; k < n; ++k )
+    {
+      const Double_t t = (x[k]-p[1])/p[2];
+
+      Double_t sigmaRatio(1.);
+      if ( t < p[9] ) sigmaRatio = ( 1.0 + TMath::Power( p[3]*(p[9]-t), p[4]-p[5]*TMath::Sqrt(p[9] - t) ) );
+      else if ( t >= p[10] ) sigmaRatio = ( 1.0 + TMath::Power( p[6]*(t-p[10]), p[7]-p[8]*TMath::Sqrt(t - p[10]) ) );
+
+      const Double_t r = t/sigmaRatio;
+      y[k] += p[0]*std::exp(-0.5*r*r);
+    }
+  }
+
+  //____________________________________________________________________________
+  void AddVWG(const Double_t* x, Int_t n, const Double_t* p, Int_t npar, Double_t* y, Double_t* dy, Int_t stride)
+  {
+    /// Add the variable width gaussian p[0..3] (VWG) or p[0..4] (VWG2, npar=5) to y,
+    /// and its derivatives to dy[i*stride+k] if dy is not null
+
+    const Double_t k0 = p[0];
+    const Double_t m = p[1];
+    const Double_t s3 = ( npar > 4 ) ? p[4] : 0.0;
+
+    for ( Int_t k = 0; k < n; ++k )
+    {
+      const Double_t u = x[k]-m;
+      const Double_t r = u/m;
+      const Double_t s = p[2] + p[3]*r + s3*r*r;
+      const Double_t e = std::exp(-u*u/(2.*s*s));
+      const Double_t f = k0*e;
+      y[k] += f;
+
+      if (!dy) continue;
+
+      const Double_t dlnfds = u*u/(s*s*s);
+      const Double_t dsdm = (p[3] + 2.*s3*r)*(-x[k]/(m*m));
+      dy[k] += e;
+      dy[stride+k] += f*(u/(s*s) + dlnfds*dsdm);
+      dy[2*stride+k] += f*dlnfds;
+      dy[3*stride+k] += f*dlnfds*r;
+      if ( npar > 4 ) dy[4*stride+k] += f*dlnfds*r*r;
+    }
+  }
+
+  //____________________________________________________________________________
+  void AddPol1Pol2(const Double_t* x, Int_t n, const Double_t* p, Double_t* y, Double_t* dy, Int_t stride)
+  {
+    /// Add (p0*x+p1)/(p2*x*x+p3*x+p4) to y, and its derivatives to dy if not null
+
+    for ( Int_t k = 0; k < n; ++k )
+    {
+      const Double_t xx = x[k];
+      const Double_t den = p[2]*xx*xx + p[3]*xx + p[4];
+      const Double_t f = (p[0]*xx + p[1])/den;
+      y[k] += f;
+
+      if (!dy) continue;
+
+      dy[k] += xx/den;
+      dy[stride+k] += 1.0/den;
+      dy[2*stride+k] += -f*xx*xx/den;
+      dy[3*stride+k] += -f*xx/den;
+      dy[4*stride+k] += -f/den;
+    }
+  }
+
+  //____________________________________________________________________________
+  void AddPol2Exp(const Double_t* x, Int_t n, const Double_t* p, Double_t* y, Double_t* dy, Int_t stride)
+  {
+    /// Add (p0+p1*x+p2*x*x)*exp(p3*x) to y, and its derivatives to dy if not null
+
+    for ( Int_t k = 0; k < n; ++k )
+    {
+      const Double_t xx = x[k];
+      const Double_t e = std::exp(p[3]*xx);
+      const Double_t f = (p[0] + p[1]*xx + p[2]*xx*xx)*e;
+      y[k] += f;
+
+      if (!dy) continue;
+
+      dy[k] += e;
+      dy[stride+k] += xx*e;
+      dy[2*stride+k] += xx*xx*e;
+      dy[3*stride+k] += xx*f;
+    }
+  }
+
+  //____________________________________________________________________________
+  Int_t NofBackgroundParameters(Int_t model)
+  {
+    switch (model)
+    {
+      case AliAnalysisMuMuBatchFit::kTwoCB2VWG:
+      case AliAnalysisMuMuBatchFit::kTwoCB2Pol2Exp:
+      case AliAnalysisMuMuBatchFit::kTwoNA60NewVWG:
+      case AliAnalysisMuMuBatchFit::kTwoNA60NewPol2Exp:
+        return 4;
+      case AliAnalysisMuMuBatchFit::kTwoCB2VWG2:
+      case AliAnalysisMuMuBatchFit::kTwoCB2Pol1Pol2:
+      case AliAnalysisMuMuBatchFit::kTwoNA60NewPol1Pol2:
+        return 5;
+      default:
+        return 0;
+    }
+  }
+}
+
+//_____________________________________________________________________________
+AliAnalysisMuMuBatchFit::AliAnalysisMuMuBatchFit(const TH1& h, Int_t model, Double_t xmin, Double_t xmax,
+                                                 Double_t sigmaPsiPFactor, Bool_t likelihood, Bool_t binIntegral)
+: ROOT::Math::IMultiGradFunction(),
+fModel(model),
+fNofParameters(NofParameters(model)),
+fSigmaPsiPFactor(sigmaPsiPFactor),
+fLikelihood(likelihood),
+fNodesPerBin(binIntegral ? 3 : 1),
+fX(),
+fW(),
+fCenter(),
+fContent(),
+fError2(),
+fUse(),
+fValue(),
+fDerivative()
+{
+  /// ctor : copy the bins of h within [xmin,xmax] into flat arrays
+
+  // 3-point Gauss-Legendre nodes and weights on [-1,1], weights normalized to 1
+  const Double_t gaussNodes[3] = { -0.774596669241483377, 0.0, 0.774596669241483377 };
+  const Double_t gaussWeights[3] = { 5.0/18.0, 8.0/18.0, 5.0/18.0 };
+
+  const TAxis* axis = h.GetXaxis();
+  Int_t first = axis->FindFixBin(xmin);
+  Int_t last = axis->FindFixBin(xmax);
+  if ( first < 1 ) first = 1;
+  if ( last > axis->GetNbins() ) last = axis->GetNbins();
+
+  for ( Int_t ib = first; ib <= last; ++ib )
+  {
+    const Double_t center = axis->GetBinCenter(ib);
+    // same convention as TH1::Fit with option R : bin centers within the range
+    if ( center < xmin || center > xmax ) continue;
+
+    const Double_t content = h.GetBinContent(ib);
+    const Double_t error = h.GetBinError(ib);
+
+    fCenter.push_back(center);
+    fContent.push_back(content);
+    fError2.push_back(error*error);
+    // empty bins are skipped in chi2 fits, as in TH1::Fit
+    fUse.push_back( fLikelihood || error > 0 );
+
+    if ( fNodesPerBin == 1 )
+    {
+      fX.push_back(center);
+      fW.push_back(1.0);
+    }
+    else
+    {
+      const Double_t halfWidth = 0.5*axis->GetBinWidth(ib);
+      for ( Int_t in = 0; in < fNodesPerBin; ++in )
+      {
+        fX.push_back(center + halfWidth*gaussNodes[in]);
+        fW.push_back(gaussWeights[in]);
+      }
+    }
+  }
+
+  fValue.resize(fX.size());
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuBatchFit::SetRejectRange(Double_t a, Double_t b)
+{
+  /// Exclude from the fit the bins with center within ]a,b[
+
+  for ( size_t ib = 0; ib < fCenter.size(); ++ib )
+  {
+    if ( fCenter[ib] > a && fCenter[ib] < b ) fUse[ib] = kFALSE;
+  }
+}
+
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuBatchFit::NofFitPoints() const
+{
+  /// Number of bins entering the fit
+
+  Int_t n(0);
+  for ( size_t ib = 0; ib < fUse.size(); ++ib )
+  {
+    if ( fUse[ib] ) ++n;
+  }
+  return n;
+}
+
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuBatchFit::NofParameters(Int_t model)
+{
+  /// Number of parameters of a model
+
+  switch (model)
+  {
+    case kTwoCB2VWG:
+    case kTwoCB2Pol2Exp:
+      return 12;
+    case kTwoCB2VWG2:
+    case kTwoCB2Pol1Pol2:
+      return 13;
+    case kTwoNA60NewVWG:
+    case kTwoNA60NewPol2Exp:
+      return 16;
+    case kTwoNA60NewPol1Pol2:
+      return 17;
+    default:
+      return 0;
+  }
+}
+
+//_____________________________________________________________________________
+Bool_t AliAnalysisMuMuBatchFit::HasAnalyticGradient(Int_t model)
+{
+  /// Whether the gradient of the model is computed analytically
+
+  return ( model == kTwoCB2VWG || model == kTwoCB2VWG2 ||
+           model == kTwoCB2Pol1Pol2 || model == kTwoCB2Pol2Exp );
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuBatchFit::EvaluatePoints(const Double_t* par, Bool_t withGradient) const
+{
+  /// Evaluate the model (and optionally its gradient) on all the evaluation points
+
+  const Int_t n = fX.size();
+  const Double_t* x = &fX[0];
+
+  std::fill(fValue.begin(),fValue.end(),0.0);
+
+  Double_t* dy(0x0);
+  if ( withGradient )
+  {
+    fDerivative.assign(fNofParameters*n,0.0);
+    dy = &fDerivative[0];
+  }
+
+  const Int_t nbck = NofBackgroundParameters(fModel);
+
+  // background
+  switch (fModel)
+  {
+    case kTwoCB2VWG:
+    case kTwoNA60NewVWG:
+      AddVWG(x,n,par,4,&fValue[0],dy,n);
+      break;
+    case kTwoCB2VWG2:
+      AddVWG(x,n,par,5,&fValue[0],dy,n);
+      break;
+    case kTwoCB2Pol1Pol2:
+    case kTwoNA60NewPol1Pol2:
+      AddPol1Pol2(x,n,par,&fValue[0],dy,n);
+      break;
+    case kTwoCB2Pol2Exp:
+    case kTwoNA60NewPol2Exp:
+      AddPol2Exp(x,n,par,&fValue[0],dy,n);
+      break;
+    default:
+      AliFatalGeneral("AliAnalysisMuMuBatchFit",Form("Unknown model %d",fModel));
+      return;
+  }
+
+  // signals : J/psi with free parameters, psi' with mean and width tied to the J/psi ones
+  if ( HasAnalyticGradient(fModel) )
+  {
+    const Int_t iJPsi = nbck;
+    const Int_t iPsiP = nbck+7;
+
+    const Int_t indexJPsi[7] = { iJPsi, iJPsi+1, iJPsi+2, iJPsi+3, iJPsi+4, iJPsi+5, iJPsi+6 };
+    const Int_t indexPsiP[7] = { iPsiP, iJPsi+1, iJPsi+2, iJPsi+3, iJPsi+4, iJPsi+5, iJPsi+6 };
+    const Double_t chainJPsi[7] = { 1., 1., 1., 1., 1., 1., 1. };
+    const Double_t chainPsiP[7] = { 1., 1., fSigmaPsiPFactor, 1., 1., 1., 1. };
+
+    const Double_t parPsiP[7] = {
+      par[iPsiP],
+      par[iJPsi+1]+kDeltaMassPsiPJPsi,
+      par[iJPsi+2]*fSigmaPsiPFactor,
+      par[iJPsi+3],
+      par[iJPsi+4],
+      par[iJPsi+5],
+      par[iJPsi+6]
+    };
+
+    AddCrystalBallExtended(x,n,&par[iJPsi],indexJPsi,chainJPsi,&fValue[0],dy,n);
+    AddCrystalBallExtended(x,n,parPsiP,indexPsiP,chainPsiP,&fValue[0],dy,n);
+  }
+  else
+  {
+    const Int_t iJPsi = nbck;
+    const Int_t iPsiP = nbck+11;
+
+    Double_t parPsiP[11];
+    parPsiP[0] = par[iPsiP];
+    parPsiP[1] = par[iJPsi+1]+kDeltaMassPsiPJPsi;
+    parPsiP[2] = par[iJPsi+2]*fSigmaPsiPFactor;
+    for ( Int_t i = 3; i < 11; ++i ) parPsiP[i] = par[iJPsi+i];
+
+    AddNA60New(x,n,&par[iJPsi],&fValue[0]);
+    AddNA60New(x,n,parPsiP,&fValue[0]);
+  }
+}
+
+//_____________________________________________________________________________
+Double_t AliAnalysisMuMuBatchFit::Reduce(Double_t* grad) const
+{
+  /// Combine the point values (and gradients, if grad is not null) into the
+  /// chi2 or the Baker-Cousins likelihood chi2 = 2*sum(f-n+n*log(n/f))
+
+  const Int_t nbins = fContent.size();
+  const Int_t npoints = fX.size();
+  const Double_t epsilon = 1E-300;
+
+  if (grad) std::fill(grad,grad+fNofParameters,0.0);
+
+  Double_t stat(0.);
+
+  for ( Int_t ib = 0; ib < nbins; ++ib )
+  {
+    if ( !fUse[ib] ) continue;
+
+    const Int_t first = ib*fNodesPerBin;
+
+    Double_t f(0.);
+    for ( Int_t in = 0; in < fNodesPerBin; ++in ) f += fW[first+in]*fValue[first+in];
+
+    const Double_t content = fContent[ib];
+    Double_t dstatdf(0.);
+
+    if ( fLikelihood )
+    {
+      if ( f < epsilon ) f = epsilon;
+      stat += 2.0*(f - content);
+      if ( content > 0 ) stat += 2.0*content*std::log(content/f);
+      dstatdf = 2.0*(1.0 - content/f);
+    }
+    else
+    {
+      const Double_t diff = content - f;
+      stat += diff*diff/fError2[ib];
+      dstatdf = -2.0*diff/fError2[ib];
+    }
+
+    if (!grad) continue;
+
+    for ( Int_t ip = 0; ip < fNofParameters; ++ip )
+    {
+      const Double_t* d = &fDerivative[ip*npoints+first];
+      Double_t dfdp(0.);
+      for ( Int_t in = 0; in < fNodesPerBin; ++in ) dfdp += fW[first+in]*d[in];
+      grad[ip] += dstatdf*dfdp;
+    }
+  }
+
+  return stat;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuBatchFit::Evaluate(const Double_t* par, Double_t* y) const
+{
+  /// Model value for each bin (weighted average of the nodes of the bin)
+
+  EvaluatePoints(par,kFALSE);
+
+  for ( Int_t ib = 0; ib < NofBins(); ++ib )
+  {
+    y[ib] = 0.0;
+    for ( Int_t in = 0; in < fNodesPerBin; ++in )
+    {
+      y[ib] += fW[ib*fNodesPerBin+in]*fValue[ib*fNodesPerBin+in];
+    }
+  }
+}
+
+//_____________________________________________________________________________
+double AliAnalysisMuMuBatchFit::DoEval(const double* par) const
+{
+  /// Value of the statistic
+
+  EvaluatePoints(par,kFALSE);
+  return Reduce(0x0);
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuBatchFit::FdF(const double* par, double& f, double* grad) const
+{
+  /// Value and gradient of the statistic in one pass
+
+  if ( !HasAnalyticGradient(fModel) )
+  {
+    f = DoEval(par);
+    for ( Int_t ip = 0; ip < fNofParameters; ++ip ) grad[ip] = DoDerivative(par,ip);
+    return;
+  }
+
+  EvaluatePoints(par,kTRUE);
+  f = Reduce(grad);
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuBatchFit::Gradient(const double* par, double* grad) const
+{
+  /// Gradient of the statistic
+
+  Double_t f;
+  FdF(par,f,grad);
+}
+
+//_____________________________________________________________________________
+double AliAnalysisMuMuBatchFit::DoDerivative(const double* par, unsigned int icoord) const
+{
+  /// Derivative along one coordinate
+
+  if ( HasAnalyticGradient(fModel) )
+  {
+    std::vector<Double_t> grad(fNofParameters);
+    Gradient(par,&grad[0]);
+    return grad[icoord];
+  }
+
+  // central difference
+  std::vector<Double_t> p(par,par+fNofParameters);
+  const Double_t h = 1E-6*TMath::Max(1.0,std::fabs(par[icoord]));
+  p[icoord] = par[icoord]+h;
+  const Double_t fplus = DoEval(&p[0]);
+  p[icoord] = par[icoord]-h;
+  const Double_t fminus = DoEval(&p[0]);
+  return (fplus-fminus)/(2.*h);
+}
+
+//_____________________________________________________________________________
+Bool_t AliAnalysisMuMuBatchFit::Fit(Job& job)
+{
+  /// Perform one fit with Minuit2, result stored in job
+
+  TString option(job.fOption.c_str());
+  option.ToUpper();
+
+  Bool_t likelihood = option.Contains("L");
+
+  AliAnalysisMuMuBatchFit fcn(*job.fHisto,job.fModel,job.fXmin,job.fXmax,job.fSigmaPsiPFactor,
+                              likelihood,option.Contains("I"));
+
+  if ( job.fParameters.size() != static_cast<size_t>(fcn.NDim()) )
+  {
+    AliErrorGeneral("AliAnalysisMuMuBatchFit",Form("Model %d needs %d parameters but %d given",job.fModel,fcn.NDim(),(Int_t)job.fParameters.size()));
+    return kFALSE;
+  }
+
+  ROOT::Fit::Fitter fitter;
+  fitter.Config().SetMinimizer("Minuit2","Migrad");
+  fitter.Config().MinimizerOptions().SetErrorDef(1.0);
+  fitter.Config().MinimizerOptions().SetPrintLevel(option.Contains("V") ? 1 : 0);
+  fitter.Config().SetMinosErrors(option.Contains("E"));
+  fitter.Config().SetParamsSettings(job.fParameters);
+
+  Int_t nfree(0);
+  for ( size_t i = 0; i < job.fParameters.size(); ++i )
+  {
+    if ( !job.fParameters[i].IsFixed() ) ++nfree;
+  }
+
+  job.fNofPoints = fcn.NofFitPoints();
+
+  Bool_t ok(kFALSE);
+  if ( HasAnalyticGradient(job.fModel) )
+  {
+    ok = fitter.FitFCN(static_cast<const ROOT::Math::IMultiGradFunction&>(fcn),0,job.fNofPoints,!likelihood);
+  }
+  else
+  {
+    ok = fitter.FitFCN(static_cast<const ROOT::Math::IMultiGenFunction&>(fcn),0,job.fNofPoints,!likelihood);
+  }
+
+  job.fResult = fitter.Result();
+  job.fChi2 = fcn(job.fResult.GetParams());
+
+  if ( !option.Contains("Q") )
+  {
+    AliInfoGeneral("AliAnalysisMuMuBatchFit",Form("model %d status %d chi2/ndf %e/%d",job.fModel,job.fResult.Status(),job.fChi2,job.fNofPoints-nfree));
+  }
+
+  return ok;
+}
+
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuBatchFit::FitConcurrently(std::vector<Job>& jobs, Int_t nThreads)
+{
+  /// Fit independent jobs in nThreads worker threads (hardware concurrency if nThreads<=0)
+  /// Return the number of successful fits
+
+  if ( nThreads <= 0 ) nThreads = std::thread::hardware_concurrency();
+  if ( nThreads > static_cast<Int_t>(jobs.size()) ) nThreads = jobs.size();
+  if ( nThreads < 1 ) nThreads = 1;
+
+  ROOT::EnableThreadSafety();
+
+  std::atomic<size_t> next(0);
+  std::atomic<Int_t> nok(0);
+
+  auto worker = [&]()
+  {
+    for ( size_t i = next++; i < jobs.size(); i = next++ )
+    {
+      if ( Fit(jobs[i]) ) ++nok;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for ( Int_t i = 0; i < nThreads; ++i ) threads.emplace_back(worker);
+  for ( auto& t : threads ) t.join();
+
+  return nok;
+}
@@ -0,0 +1,131 @@
+#ifndef ALIANALYSISMUMUBATCHFIT_H
+#define ALIANALYSISMUMUBATCHFIT_H
+
+/* Copyright(c) 1998-2019, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/**
+
+@ingroup pwg_muondep_mumu
+
+@class AliAnalysisMuMuBatchFit
+
+@brief Batched evaluation of the J/psi + psi' invariant mass fit functions
+
+Alternative fitting backend for AliAnalysisMuMuJpsiResult. The histogram is converted
+once into flat arrays (evaluation points, bin contents and squared errors) and the
+model is evaluated over all the points of the fit range in a single call, instead of one
+TF1 callback per bin. When the bin integral is requested (fit option "I") each bin is
+described by a fixed set of Gauss-Legendre nodes computed once.
+
+The parameter layout of each model is the one of the corresponding
+AliAnalysisMuMuJpsiResult::FitFunctionTotalTwoXXX method. The CB2 based models
+provide analytic gradients to the minimizer, the NA60 based ones rely on the numerical
+derivatives of Minuit2.
+
+Independent spectra (centrality/pT bins, fit combinations) can be fitted concurrently
+with FitConcurrently().
+*/
+
+#include <Rtypes.h>
+#include <string>
+#include <vector>
+#include "Math/IFunction.h"
+#include "Fit/FitResult.h"
+#include "Fit/ParameterSettings.h"
+
+class TH1;
+
+class AliAnalysisMuMuBatchFit : public ROOT::Math::IMultiGradFunction
+{
+public:
+
+  enum EModel
+  {
+    kNoModel=-1,
+    kTwoCB2VWG=0,        ///< 2 extended crystal balls + VWG (12 parameters)
+    kTwoCB2VWG2,         ///< 2 extended crystal balls + VWG2 (13 parameters)
+    kTwoCB2Pol1Pol2,     ///< 2 extended crystal balls + pol1/pol2 (13 parameters)
+    kTwoCB2Pol2Exp,      ///< 2 extended crystal balls + pol2 x exp (12 parameters)
+    kTwoNA60NewVWG,      ///< 2 NA60 (new) + VWG (16 parameters)
+    kTwoNA60NewPol1Pol2, ///< 2 NA60 (new) + pol1/pol2 (17 parameters)
+    kTwoNA60NewPol2Exp,  ///< 2 NA60 (new) + pol2 x exp (16 parameters)
+    kNModels
+  };
+
+  /// Description (and outcome) of one independent fit
+  struct Job
+  {
+    Job() : fHisto(0x0), fModel(kNoModel), fXmin(0), fXmax(0), fSigmaPsiPFactor(1.0),
+    fOption(), fParameters(), fResult(), fChi2(0), fNofPoints(0) {}
+
+    const TH1* fHisto; ///< histogram to fit (not owned)
+    Int_t fModel; ///< one of EModel
+    Double_t fXmin; ///< lower edge of the fit range
+    Double_t fXmax; ///< upper edge of the fit range
+    Double_t fSigmaPsiPFactor; ///< ratio of the psi' to J/psi widths
+    std::string fOption; ///< TH1::Fit-like options (L, I, E, Q, V are used)
+    std::vector<ROOT::Fit::ParameterSettings> fParameters; ///< initial values, limits, fixed flags
+    ROOT::Fit::FitResult fResult; ///< result of the fit
+    Double_t fChi2; ///< chi2 (Baker-Cousins for likelihood fits)
+    Int_t fNofPoints; ///< number of bins used in the fit
+  };
+
+  AliAnalysisMuMuBatchFit(const TH1& h, Int_t model, Double_t xmin, Double_t xmax,
+                          Double_t sigmaPsiPFactor, Bool_t likelihood, Bool_t binIntegral);
+
+  virtual ~AliAnalysisMuMuBatchFit() {}
+
+  virtual ROOT::Math::IMultiGenFunction* Clone() const { return new AliAnalysisMuMuBatchFit(*this); }
+
+  virtual unsigned int NDim() const { return fNofParameters; }
+
+  virtual void Gradient(const double* par, double* grad) const;
+
+  virtual void FdF(const double* par, double& f, double* grad) const;
+
+  void SetRejectRange(Double_t a, Double_t b);
+
+  /// Model value (averaged over the bin if bin integral is used) for each bin
+  void Evaluate(const Double_t* par, Double_t* y) const;
+
+  Int_t NofBins() const { return fContent.size(); }
+
+  Int_t NofFitPoints() const;
+
+  static Int_t NofParameters(Int_t model);
+
+  static Bool_t HasAnalyticGradient(Int_t model);
+
+  static Bool_t Fit(Job& job);
+
+  static Int_t FitConcurrently(std::vector<Job>& jobs, Int_t nThreads=0);
+
+private:
+
+  virtual double DoEval(const double* par) const;
+
+  virtual double DoDerivative(const double* par, unsigned int icoord) const;
+
+  void EvaluatePoints(const Double_t* par, Bool_t withGradient) const;
+
+  Double_t Reduce(Double_t* grad) const;
+
+  Int_t fModel; ///< one of EModel
+  Int_t fNofParameters; ///< number of parameters of the model
+  Double_t fSigmaPsiPFactor; ///< ratio of the psi' to J/psi widths
+  Bool_t fLikelihood; ///< Poisson likelihood (Baker-Cousins) instead of chi2
+  Int_t fNodesPerBin; ///< evaluation points per bin (1 = bin center)
+
+  std::vector<Double_t> fX; ///< evaluation points, fNodesPerBin per bin
+  std::vector<Double_t> fW; ///< weight of each evaluation point (sum to 1 in a bin)
+  std::vector<Double_t> fCenter; ///< bin centers
+  std::vector<Double_t> fContent; ///< bin contents
+  std::vector<Double_t> fError2; ///< squared bin errors
+  std::vector<Bool_t> fUse; ///< whether the bin enters the fit
+
+  mutable std::vector<Double_t> fValue; ///< scratch : model value per point
+  mutable std::vector<Double_t> fDerivative; ///< scratch : d(model)/d(par) per point, parameter-major
+};
+
+#endif
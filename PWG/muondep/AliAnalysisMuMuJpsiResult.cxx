@@ -30,6 +30,7 @@ ClassImp(AliAnalysisMuMuJpsiResult)
 #include "TMethodCall.h"
 #include "TObjArray.h"
 #include "TParameter.h"
+#include "AliAnalysisMuMuBatchFit.h"
 #include "AliAnalysisMuMuBinning.h"
 #include "AliLog.h"
 #include <map>
@@ -86,6 +87,7 @@ namespace {
   const TString kKeyWeight    = "Weight";
   const TString kKeySPsiP     = "FSigmaPsiP"; //Factor to fix the psi' sigma to sigmaJPsi*SigmaPsiP (Usually factor SigmaPsiP = 1, 0.9 and 1.1)
   const TString kKeyMinvRS    = "MinvRS"; // FIXME: not very correct since "MinvRS" is in AliAnalysisMuMu::GetParametersFromResult
+  const TString kKeyBatch     = "Batch"; // use the batched fit backend (AliAnalysisMuMuBatchFit) when available
 
 }
 
@@ -2477,7 +2479,7 @@ void AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMECB2VWG()
 
 
   //_____________First fit attempt
-  TFitResultPtr fitResult = fHisto->Fit(fitTotal,fitOption,"");
+  TFitResultPtr fitResult = FitMinv(fitTotal,fitOption,AliAnalysisMuMuBatchFit::kTwoCB2VWG);
 
   std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
   std::cout << "CovMatrixStatus = " << fitResult->CovMatrixStatus() << std::endl;
@@ -2485,7 +2487,7 @@ void AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMECB2VWG()
 
 
   //___________ Further attempts to fit if the first one fails
-  if ( ( static_cast<int>(fitResult) && static_cast<int>(fitResult)!=4000 ) ||  static_cast<int>(fitResult->CovMatrixStatus())!=3 ) ProcessMinvFit(fitResult,fitTotal,bckInit,fitOption,11,3);
+  if ( ( static_cast<int>(fitResult) && static_cast<int>(fitResult)!=4000 ) ||  static_cast<int>(fitResult->CovMatrixStatus())!=3 ) ProcessMinvFit(fitResult,fitTotal,bckInit,fitOption,11,3,AliAnalysisMuMuBatchFit::kTwoCB2VWG);
   Set("FitResult",static_cast<int>(fitResult),0);
   Set("CovMatrixStatus",static_cast<int>(fitResult->CovMatrixStatus()),0);
   printf("\n -_-_-_-_-_-_-_-_-_-_-_-_-_-_\n");
@@ -2760,7 +2762,7 @@ void AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMECB2VWG2()
 
 
   //_____________First fit attempt
-  TFitResultPtr fitResult = fHisto->Fit(fitTotal,fitOption,"");
+  TFitResultPtr fitResult = FitMinv(fitTotal,fitOption,AliAnalysisMuMuBatchFit::kTwoCB2VWG2);
 
   std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
   std::cout << "CovMatrixStatus = " << fitResult->CovMatrixStatus() << std::endl;
@@ -2768,7 +2770,7 @@ void AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMECB2VWG2()
 
 
   //___________ Further attempts to fit if the first one fails
-  if ( ( static_cast<int>(fitResult) && static_cast<int>(fitResult)!=4000 ) ||  static_cast<int>(fitResult->CovMatrixStatus())!=3 ) ProcessMinvFit(fitResult,fitTotal,bckInit,fitOption,12,4);
+  if ( ( static_cast<int>(fitResult) && static_cast<int>(fitResult)!=4000 ) ||  static_cast<int>(fitResult->CovMatrixStatus())!=3 ) ProcessMinvFit(fitResult,fitTotal,bckInit,fitOption,12,4,AliAnalysisMuMuBatchFit::kTwoCB2VWG2);
   Set("FitResult",static_cast<int>(fitResult),0);
   Set("CovMatrixStatus",static_cast<int>(fitResult->CovMatrixStatus()),0);
   printf("\n -_-_-_-_-_-_-_-_-_-_-_-_-_-_\n");
@@ -3091,7 +3093,7 @@ void AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMECB2POL1POL2()
 
 
   //_____________First fit attempt
-  TFitResultPtr fitResult = fHisto->Fit(fitTotal,fitOption,"");
+  TFitResultPtr fitResult = FitMinv(fitTotal,fitOption,AliAnalysisMuMuBatchFit::kTwoCB2Pol1Pol2);
   // CheckRoots(fitResult,fitTotal,2,fitTotal->GetParameter(2),fitTotal->GetParameter(3),fitTotal->GetParameter(4),0.,fitOption);
 
   std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
@@ -3100,7 +3102,7 @@ void AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMECB2POL1POL2()
 
 
   //___________ Further attempts to fit if the first one fails
-  if ( ( static_cast<int>(fitResult) && static_cast<int>(fitResult)!=4000 ) ||  static_cast<int>(fitResult->CovMatrixStatus())!=3 ) ProcessMinvFit(fitResult,fitTotal,bckInit,fitOption,12,4);
+  if ( ( static_cast<int>(fitResult) && static_cast<int>(fitResult)!=4000 ) ||  static_cast<int>(fitResult->CovMatrixStatus())!=3 ) ProcessMinvFit(fitResult,fitTotal,bckInit,fitOption,12,4,AliAnalysisMuMuBatchFit::kTwoCB2Pol1Pol2);
   Set("FitResult",static_cast<int>(fitResult),0);
   Set("CovMatrixStatus",static_cast<int>(fitResult->CovMatrixStatus()),0);
   printf("\n -_-_-_-_-_-_-_-_-_-_-_-_-_-_\n");
@@ -4233,14 +4235,14 @@ void AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMECB2POL2EXP()
 
 
   //_____________First fit attempt
-  TFitResultPtr fitResult = fHisto->Fit(fitTotal,fitOption,"");
+  TFitResultPtr fitResult = FitMinv(fitTotal,fitOption,AliAnalysisMuMuBatchFit::kTwoCB2Pol2Exp);
 
   std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
   std::cout << "CovMatrixStatus = " << fitResult->CovMatrixStatus() << std::endl;
   //___________
 
   //___________ Further attempts to fit if the first one fails
-  if ( ( static_cast<int>(fitResult) && static_cast<int>(fitResult)!=4000 ) ||  static_cast<int>(fitResult->CovMatrixStatus())!=3 ) ProcessMinvFit(fitResult,fitTotal,bckInit,fitOption,11,3);
+  if ( ( static_cast<int>(fitResult) && static_cast<int>(fitResult)!=4000 ) ||  static_cast<int>(fitResult->CovMatrixStatus())!=3 ) ProcessMinvFit(fitResult,fitTotal,bckInit,fitOption,11,3,AliAnalysisMuMuBatchFit::kTwoCB2Pol2Exp);
   Set("FitResult",static_cast<int>(fitResult),0);
   Set("CovMatrixStatus",static_cast<int>(fitResult->CovMatrixStatus()),0);
   printf("\n -_-_-_-_-_-_-_-_-_-_-_-_-_-_\n");
@@ -4791,14 +4793,14 @@ void AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMENA60NEWVWG()
   // fitTotal->SetParLimits(15, 0.,fHisto->GetBinContent(bin));
 
   //_____________First fit attempt
-  TFitResultPtr fitResult = fHisto->Fit(fitTotal,fitOption,"");
+  TFitResultPtr fitResult = FitMinv(fitTotal,fitOption,AliAnalysisMuMuBatchFit::kTwoNA60NewVWG);
 
   std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
   std::cout << "CovMatrixStatus = " << fitResult->CovMatrixStatus() << std::endl;
   //___________
 
   //___________ Further attempts to fit if the first one fails
-  if ( static_cast<int>(fitResult) ||  (!static_cast<int>(fitResult)&&static_cast<int>(fitResult->CovMatrixStatus())!=3) ) ProcessMinvFit(fitResult,fitTotal,bckInit,fitOption,15,3);
+  if ( static_cast<int>(fitResult) ||  (!static_cast<int>(fitResult)&&static_cast<int>(fitResult->CovMatrixStatus())!=3) ) ProcessMinvFit(fitResult,fitTotal,bckInit,fitOption,15,3,AliAnalysisMuMuBatchFit::kTwoNA60NewVWG);
   Set("FitResult",static_cast<int>(fitResult),0);
   Set("CovMatrixStatus",static_cast<int>(fitResult->CovMatrixStatus()),0);
   printf("\n -_-_-_-_-_-_-_-_-_-_-_-_-_-_\n");
@@ -5372,14 +5374,14 @@ void AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMENA60NEWPOL1POL2()
   // fitTotal->SetParLimits(16, 0.,fHisto->GetBinContent(bin));
 
   //_____________First fit attempt
-  TFitResultPtr fitResult = fHisto->Fit(fitTotal,fitOption,"");
+  TFitResultPtr fitResult = FitMinv(fitTotal,fitOption,AliAnalysisMuMuBatchFit::kTwoNA60NewPol1Pol2);
 
   std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
   std::cout << "CovMatrixStatus = " << fitResult->CovMatrixStatus() << std::endl;
   //___________
 
   //___________ Further attempts to fit if the first one fails
-  if ( ( static_cast<int>(fitResult) && static_cast<int>(fitResult)!=4000 ) ||  static_cast<int>(fitResult->CovMatrixStatus())!=3 ) ProcessMinvFit(fitResult,fitTotal,bckInit,fitOption,16,4);
+  if ( ( static_cast<int>(fitResult) && static_cast<int>(fitResult)!=4000 ) ||  static_cast<int>(fitResult->CovMatrixStatus())!=3 ) ProcessMinvFit(fitResult,fitTotal,bckInit,fitOption,16,4,AliAnalysisMuMuBatchFit::kTwoNA60NewPol1Pol2);
   Set("FitResult",static_cast<int>(fitResult),0);
   Set("CovMatrixStatus",static_cast<int>(fitResult->CovMatrixStatus()),0);
   printf("\n -_-_-_-_-_-_-_-_-_-_-_-_-_-_\n");
@@ -5960,14 +5962,14 @@ void AliAnalysisMuMuJpsiResult::FitPSIPSIPRIMENA60NEWPOL2EXP()
   fitTotal->SetParLimits(15, fHisto->GetBinContent(bin)*0.01,fHisto->GetBinContent(bin));
 
   //_____________First fit attempt
-  TFitResultPtr fitResult = fHisto->Fit(fitTotal,fitOption,"");
+  TFitResultPtr fitResult = FitMinv(fitTotal,fitOption,AliAnalysisMuMuBatchFit::kTwoNA60NewPol2Exp);
 
   std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
   std::cout << "CovMatrixStatus = " << fitResult->CovMatrixStatus() << std::endl;
   //___________
 
   //___________ Further attempts to fit if the first one fails
-  if ( ( static_cast<int>(fitResult) && static_cast<int>(fitResult)!=4000 ) ||  static_cast<int>(fitResult->CovMatrixStatus())!=3 ) ProcessMinvFit(fitResult,fitTotal,bckInit,fitOption,15,3);
+  if ( ( static_cast<int>(fitResult) && static_cast<int>(fitResult)!=4000 ) ||  static_cast<int>(fitResult->CovMatrixStatus())!=3 ) ProcessMinvFit(fitResult,fitTotal,bckInit,fitOption,15,3,AliAnalysisMuMuBatchFit::kTwoNA60NewPol2Exp);
   Set("FitResult",static_cast<int>(fitResult),0);
   Set("CovMatrixStatus",static_cast<int>(fitResult->CovMatrixStatus()),0);
   printf("\n -_-_-_-_-_-_-_-_-_-_-_-_-_-_\n");
@@ -12673,6 +12675,7 @@ void AliAnalysisMuMuJpsiResult::DecodeFitType(const char* fitType)
     else if ( key.CompareTo(kKeySPsiP,TString::kIgnoreCase) == 0 )paramSPsiP = value.Atof();
     else if ( key.CompareTo(kKeyWeight,TString::kIgnoreCase) == 0 )Weight = value.Atof();
     else if ( key.CompareTo(kKeyMinvRS,TString::kIgnoreCase) == 0 )fMinvRS = value.Data();
+    else if ( key.CompareTo(kKeyBatch,TString::kIgnoreCase) == 0 )Set(kKeyBatch,value.Atof(),0.0);
 
     else Set(key.Data(),value.Atof(),0.0);
 
@@ -12808,7 +12811,85 @@ void AliAnalysisMuMuJpsiResult::PrintParticle(const char* particle, const char*
 }
 
 //________________________
-void AliAnalysisMuMuJpsiResult::ProcessMinvFit(TFitResultPtr& fitResult, TF1* fitTotal, TF1* bckInit, const char* fitOption, Int_t iParKPsip, Int_t iLastParBkg)
+TFitResultPtr AliAnalysisMuMuJpsiResult::FitMinv(TF1* fitTotal, const char* fitOption, Int_t batchModel)
+{
+  /// Fit the minv histogram with fitTotal.
+  ///
+  /// If the fit type contains batch=1 and the model of fitTotal is known to
+  /// AliAnalysisMuMuBatchFit (batchModel), the fit is done with the batched backend
+  /// (all bins evaluated in one call, analytic gradients for the CB2 models) and the
+  /// result is propagated to fitTotal as TH1::Fit would do. Otherwise TH1::Fit is used.
+
+  Double_t batch = GetValue(kKeyBatch);
+
+  if ( batchModel == AliAnalysisMuMuBatchFit::kNoModel || !IsValidValue(batch) || batch <= 0 )
+  {
+    return fHisto->Fit(fitTotal,fitOption,"");
+  }
+
+  TString option(fitOption);
+  option.ToUpper();
+
+  AliAnalysisMuMuBatchFit::Job job;
+  job.fHisto = fHisto;
+  job.fModel = batchModel;
+  job.fSigmaPsiPFactor = GetValue(kKeySPsiP);
+  job.fOption = option.Data();
+
+  if ( option.Contains("R") ) fitTotal->GetRange(job.fXmin,job.fXmax);
+  else
+  {
+    job.fXmin = fHisto->GetXaxis()->GetXmin();
+    job.fXmax = fHisto->GetXaxis()->GetXmax();
+  }
+
+  // same conventions as TH1::Fit for the initial step, limits and fixed parameters
+  for ( Int_t i = 0; i < fitTotal->GetNpar(); ++i )
+  {
+    Double_t value = fitTotal->GetParameter(i);
+    Double_t step = fitTotal->GetParError(i);
+    if ( step <= 0 ) step = ( value != 0 ) ? 0.3*TMath::Abs(value) : 0.1;
+
+    ROOT::Fit::ParameterSettings settings(fitTotal->GetParName(i),value,step);
+
+    Double_t low, up;
+    fitTotal->GetParLimits(i,low,up);
+    if ( low*up != 0 && low >= up ) settings.Fix();
+    else if ( low < up ) settings.SetLimits(low,up);
+
+    job.fParameters.push_back(settings);
+  }
+
+  AliAnalysisMuMuBatchFit::Fit(job);
+
+  fitTotal->SetFitResult(job.fResult);
+  fitTotal->SetChisquare(job.fChi2);
+
+  if ( !option.Contains("N") )
+  {
+    if ( !option.Contains("+") )
+    {
+      TIter next(fHisto->GetListOfFunctions());
+      TObject* o;
+      while ( ( o = next() ) )
+      {
+        if ( o->InheritsFrom(TF1::Class()) )
+        {
+          fHisto->GetListOfFunctions()->Remove(o);
+          delete o;
+        }
+      }
+    }
+    TF1* fstored = static_cast<TF1*>(fitTotal->Clone());
+    fstored->SetBit(TF1::kNotDraw,option.Contains("0"));
+    fHisto->GetListOfFunctions()->Add(fstored);
+  }
+
+  return TFitResultPtr(new TFitResult(job.fResult));
+}
+
+//________________________
+void AliAnalysisMuMuJpsiResult::ProcessMinvFit(TFitResultPtr& fitResult, TF1* fitTotal, TF1* bckInit, const char* fitOption, Int_t iParKPsip, Int_t iLastParBkg, Int_t batchModel)
 {
   // If a Minv fit fails this algorithm changes some initial parameters to get the fit converged
 
@@ -12834,7 +12915,7 @@ void AliAnalysisMuMuJpsiResult::ProcessMinvFit(TFitResultPtr& fitResult, TF1* fi
     std::cout << "================================\\" << std::endl;
     std::cout << "======== Refitting again =======\\" << std::endl;
     std::cout << "================================\\" << std::endl;
-    fitResult = fHisto->Fit(fitTotal,fitOption,"");
+    fitResult = FitMinv(fitTotal,fitOption,batchModel);
     std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
     std::cout << "CovMatrixStatus = " << fitResult->CovMatrixStatus() << std::endl;
 
@@ -12863,7 +12944,7 @@ void AliAnalysisMuMuJpsiResult::ProcessMinvFit(TFitResultPtr& fitResult, TF1* fi
     std::cout << "================================\\" << std::endl;
     std::cout << "======== Refitting again =======\\" << std::endl;
     std::cout << "================================\\" << std::endl;
-    fitResult = fHisto->Fit(fitTotal,fitOption,"");
+    fitResult = FitMinv(fitTotal,fitOption,batchModel);
     std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
     std::cout << "CovMatrixStatus = " << fitResult->CovMatrixStatus() << std::endl;
 
@@ -12882,7 +12963,7 @@ void AliAnalysisMuMuJpsiResult::ProcessMinvFit(TFitResultPtr& fitResult, TF1* fi
 
     for ( Int_t i = 0; i < iLastParBkg+1 ; ++i ) fitTotal->SetParameter(i, bckInit->GetParameter(i)); //set initial background parameters
 
-    fitResult = fHisto->Fit(fitTotal,fitOption,"");
+    fitResult = FitMinv(fitTotal,fitOption,batchModel);
     std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
     std::cout << "CovMatrixStatus = " << fitResult->CovMatrixStatus() << std::endl;
 
@@ -12902,7 +12983,7 @@ void AliAnalysisMuMuJpsiResult::ProcessMinvFit(TFitResultPtr& fitResult, TF1* fi
 
     for ( Int_t i = 0; i < iLastParBkg+1 ; ++i ) fitTotal->SetParameter(i, bckInit->GetParameter(i)); //set initial background parameters
 
-    fitResult = fHisto->Fit(fitTotal,fitOption,"");
+    fitResult = FitMinv(fitTotal,fitOption,batchModel);
     std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
     std::cout << "CovMatrixStatus = " << fitResult->CovMatrixStatus() << std::endl;
 
@@ -12934,7 +13015,7 @@ void AliAnalysisMuMuJpsiResult::ProcessMinvFit(TFitResultPtr& fitResult, TF1* fi
 
     std::cout << "================================\\" << std::endl;
     std::cout << "======== Refitting again =======\\" << std::endl;
-    std::cout << "================================\\" << std::endl;    fitResult = fHisto->Fit(fitTotal,fitOption,"");
+    std::cout << "================================\\" << std::endl;    fitResult = FitMinv(fitTotal,fitOption,batchModel);
 
     std::cout << "FitResult = " << static_cast<int>(fitResult) << std::endl;
     std::cout << "CovMatrixStatus = " << fitResult->CovMatrixStatus() << std::endl;
@@ -8,6 +8,8 @@
 
 #include <TH3F.h>
 
+#include <algorithm>
+
 #ifdef __ROOT__
   /// \cond CLASSIMP
   ClassImp(AliFemtoCorrFctn3DLCMSSym);
@@ -24,6 +26,9 @@ AliFemtoCorrFctn3DLCMSSym::AliFemtoCorrFctn3DLCMSSym(const char* title,
   , fNumeratorW(NULL)
   , fDenominatorW(NULL)
   , fUseLCMS(1)
+  , fMixedPairBuffer(0)
+  , fDirectFill(kFALSE)
+  , fMixedPairs()
 {
   // Basic constructor
   TString hist_title = TString::Format("%s; q_{out} (GeV); q_{side} (GeV); q_{long} (GeV)", title);
@@ -61,6 +66,8 @@ AliFemtoCorrFctn3DLCMSSym::AliFemtoCorrFctn3DLCMSSym(const char* title,
   fDenominator->Sumw2();
   fNumeratorW->Sumw2();
   fDenominatorW->Sumw2();
+
+  SetupDirectFill();
 }
 
 AliFemtoCorrFctn3DLCMSSym::AliFemtoCorrFctn3DLCMSSym(const AliFemtoCorrFctn3DLCMSSym& aCorrFctn):
@@ -70,12 +77,19 @@ AliFemtoCorrFctn3DLCMSSym::AliFemtoCorrFctn3DLCMSSym(const AliFemtoCorrFctn3DLCM
   , fNumeratorW(new TH3F(*aCorrFctn.fNumeratorW))
   , fDenominatorW(new TH3F(*aCorrFctn.fDenominatorW))
   , fUseLCMS(aCorrFctn.fUseLCMS)
+  , fMixedPairBuffer(aCorrFctn.fMixedPairBuffer)
+  , fDirectFill(kFALSE)
+  , fMixedPairs(aCorrFctn.fMixedPairs)
 {
   // Copy constructor
   fNumerator->Sumw2();
   fDenominator->Sumw2();
   fNumeratorW->Sumw2();
   fDenominatorW->Sumw2();
+
+  SetupDirectFill();
+  std::copy(&aCorrFctn.fFillStats[0][0], &aCorrFctn.fFillStats[0][0] + kNHisto*11, &fFillStats[0][0]);
+  std::copy(aCorrFctn.fFillEntries, aCorrFctn.fFillEntries + kNHisto, fFillEntries);
 }
 //____________________________
 AliFemtoCorrFctn3DLCMSSym::~AliFemtoCorrFctn3DLCMSSym()
@@ -108,12 +122,18 @@ AliFemtoCorrFctn3DLCMSSym& AliFemtoCorrFctn3DLCMSSym::operator=(const AliFemtoCo
   fDenominatorW = new TH3F(*aCorrFctn.fDenominatorW);
 
   fUseLCMS = aCorrFctn.fUseLCMS;
+  fMixedPairBuffer = aCorrFctn.fMixedPairBuffer;
 
   fNumerator->Sumw2();
   fDenominator->Sumw2();
   fNumeratorW->Sumw2();
   fDenominatorW->Sumw2();
 
+  SetupDirectFill();
+  std::copy(&aCorrFctn.fFillStats[0][0], &aCorrFctn.fFillStats[0][0] + kNHisto*11, &fFillStats[0][0]);
+  std::copy(aCorrFctn.fFillEntries, aCorrFctn.fFillEntries + kNHisto, fFillEntries);
+  fMixedPairs = aCorrFctn.fMixedPairs;
+
   return *this;
 }
 
@@ -121,6 +141,7 @@ AliFemtoCorrFctn3DLCMSSym& AliFemtoCorrFctn3DLCMSSym::operator=(const AliFemtoCo
 void AliFemtoCorrFctn3DLCMSSym::WriteOutHistos()
 {
   // Write out all histograms to file
+  Commit();
   fNumerator->Write();
   fDenominator->Write();
   fNumeratorW->Write();
@@ -130,6 +151,7 @@ void AliFemtoCorrFctn3DLCMSSym::WriteOutHistos()
 TList* AliFemtoCorrFctn3DLCMSSym::GetOutputList()
 {
   // Prepare the list of objects to be written to the output
+  Commit();
   TList *tOutputList = new TList();
 
   tOutputList->Add(fNumerator);
@@ -144,12 +166,21 @@ TList* AliFemtoCorrFctn3DLCMSSym::GetOutputList()
 void AliFemtoCorrFctn3DLCMSSym::Finish()
 {
   // here is where we should normalize, fit, etc...
+  Commit();
+}
+
+//_________________________
+void AliFemtoCorrFctn3DLCMSSym::EventEnd(const AliFemtoEvent* /* aEvent */)
+{
+  // fill the buffered pairs and the statistics of the histograms
+  Commit();
 }
 
 //____________________________
 AliFemtoString AliFemtoCorrFctn3DLCMSSym::Report()
 {
   // Construct the report
+  Commit();
   TString report = "LCMS Frame Bertsch-Pratt 3D Correlation Function Report:\n";
   report += TString::Format("Number of entries in numerator:\t%E\n", fNumerator->GetEntries());
   report += TString::Format("Number of entries in denominator:\t%E\n", fDenominator->GetEntries());
@@ -171,23 +202,23 @@ void AliFemtoCorrFctn3DLCMSSym::AddRealPair(AliFemtoPair* pair)
     return;
   }
 
-  if (fUseLCMS) {
-    const Double_t qout = pair->QOutCMS(),
-                  qside = pair->QSideCMS(),
-                  qlong = pair->QLongCMS();
-
-    fNumerator->Fill(qout, qside, qlong, 1.0);
-    fNumeratorW->Fill(qout, qside, qlong, pair->QInv());
-  }
-  else {
-    const Double_t qout = pair->QOutPf(),
-                  qside = pair->QSidePf(),
-                  qlong = pair->QLongPf();
+  const Double_t qout = fUseLCMS ? pair->QOutCMS() : pair->QOutPf(),
+                qside = fUseLCMS ? pair->QSideCMS() : pair->QSidePf(),
+                qlong = fUseLCMS ? pair->QLongCMS() : pair->QLongPf(),
+                 qinv = pair->QInv();
 
+  if (!fDirectFill) {
     fNumerator->Fill(qout, qside, qlong, 1.0);
-    fNumeratorW->Fill(qout, qside, qlong, pair->QInv());
+    fNumeratorW->Fill(qout, qside, qlong, qinv);
+    return;
   }
 
+  Bool_t inRange;
+  const Int_t bin = FindQBin(qout, qside, qlong, inRange);
+  FillBin(fNumerator, bin, 1.0);
+  FillBin(fNumeratorW, bin, qinv);
+  AddStats(kNum, 1.0, qout, qside, qlong, inRange);
+  AddStats(kNumW, qinv, qout, qside, qlong, inRange);
 }
 //____________________________
 void AliFemtoCorrFctn3DLCMSSym::AddMixedPair(AliFemtoPair* pair)
@@ -197,23 +228,160 @@ void AliFemtoCorrFctn3DLCMSSym::AddMixedPair(AliFemtoPair* pair)
     return;
   }
 
-  if (fUseLCMS) {
-    const Double_t qout = pair->QOutCMS(),
-                  qside = pair->QSideCMS(),
-                  qlong = pair->QLongCMS();
+  const Double_t qout = fUseLCMS ? pair->QOutCMS() : pair->QOutPf(),
+                qside = fUseLCMS ? pair->QSideCMS() : pair->QSidePf(),
+                qlong = fUseLCMS ? pair->QLongCMS() : pair->QLongPf(),
+                 qinv = pair->QInv();
 
+  if (!fDirectFill) {
     fDenominator->Fill(qout, qside, qlong, 1.0);
-    fDenominatorW->Fill(qout, qside, qlong, pair->QInv());
+    fDenominatorW->Fill(qout, qside, qlong, qinv);
+    return;
   }
-  else {
-    const Double_t qout = pair->QOutPf(),
-                  qside = pair->QSidePf(),
-                  qlong = pair->QLongPf();
 
-    fDenominator->Fill(qout, qside, qlong, 1.0);
-    fDenominatorW->Fill(qout, qside, qlong, pair->QInv());
+  Bool_t inRange;
+  const Int_t bin = FindQBin(qout, qside, qlong, inRange);
+  AddStats(kDen, 1.0, qout, qside, qlong, inRange);
+  AddStats(kDenW, qinv, qout, qside, qlong, inRange);
+
+  if (fMixedPairBuffer > 0) {
+    fMixedPairs.push_back(std::make_pair(bin, qinv));
+    if ((int)fMixedPairs.size() >= fMixedPairBuffer) {
+      CommitMixedPairs();
+    }
+    return;
+  }
+
+  FillBin(fDenominator, bin, 1.0);
+  FillBin(fDenominatorW, bin, qinv);
+}
+
+//____________________________
+void AliFemtoCorrFctn3DLCMSSym::SetupDirectFill()
+{
+  // Check that the four histograms share the same uniform binning and
+  // keep the axes parameters for FindQBin. The statistics of the
+  // histograms become the starting point of the direct fill.
+  TH3F *histos[kNHisto] = { fNumerator, fDenominator, fNumeratorW, fDenominatorW };
+
+  fDirectFill = kTRUE;
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    const TAxis *axis = (iaxis == 0) ? fNumerator->GetXaxis()
+                      : (iaxis == 1) ? fNumerator->GetYaxis()
+                                     : fNumerator->GetZaxis();
+    fQNBins[iaxis] = axis->GetNbins();
+    fQLow[iaxis] = axis->GetXmin();
+    fQHigh[iaxis] = axis->GetXmax();
+    fDirectFill &= (axis->GetXbins()->GetSize() == 0);
+  }
+  for (int ihist = 0; ihist < kNHisto; ihist++) {
+    for (int iaxis = 0; iaxis < 3; iaxis++) {
+      const TAxis *axis = (iaxis == 0) ? histos[ihist]->GetXaxis()
+                        : (iaxis == 1) ? histos[ihist]->GetYaxis()
+                                       : histos[ihist]->GetZaxis();
+      fDirectFill &= (axis->GetNbins() == fQNBins[iaxis]
+                      && axis->GetXmin() == fQLow[iaxis]
+                      && axis->GetXmax() == fQHigh[iaxis]
+                      && axis->GetXbins()->GetSize() == 0);
+    }
+    fDirectFill &= (histos[ihist]->GetSumw2N() > 0);
+    histos[ihist]->GetStats(fFillStats[ihist]);
+    fFillEntries[ihist] = histos[ihist]->GetEntries();
   }
+}
 
+//____________________________
+Int_t AliFemtoCorrFctn3DLCMSSym::FindQBin(Double_t qout, Double_t qside, Double_t qlong, Bool_t &aInRange) const
+{
+  // global bin of the histograms, as TH3::Fill would find it
+  const Double_t q[3] = { qout, qside, qlong };
+  Int_t bin[3];
+  aInRange = kTRUE;
+  for (int iaxis = 0; iaxis < 3; iaxis++) {
+    if (q[iaxis] < fQLow[iaxis]) {
+      bin[iaxis] = 0;
+      aInRange = kFALSE;
+    } else if (!(q[iaxis] < fQHigh[iaxis])) {
+      bin[iaxis] = fQNBins[iaxis] + 1;
+      aInRange = kFALSE;
+    } else {
+      bin[iaxis] = 1 + int(fQNBins[iaxis] * (q[iaxis] - fQLow[iaxis]) / (fQHigh[iaxis] - fQLow[iaxis]));
+    }
+  }
+  return bin[0] + (fQNBins[0] + 2) * (bin[1] + (fQNBins[1] + 2) * bin[2]);
+}
+
+//____________________________
+void AliFemtoCorrFctn3DLCMSSym::FillBin(TH3F *aHisto, Int_t aBin, Double_t aWeight)
+{
+  // bin content and error of TH3::Fill, the statistics are kept aside
+  aHisto->fArray[aBin] += Float_t(aWeight);
+  aHisto->GetSumw2()->fArray[aBin] += aWeight * aWeight;
+}
+
+//____________________________
+void AliFemtoCorrFctn3DLCMSSym::AddStats(EHisto aHisto, Double_t w,
+                                         Double_t x, Double_t y, Double_t z,
+                                         Bool_t aInRange)
+{
+  // accumulate the statistics TH3::Fill would accumulate
+  fFillEntries[aHisto]++;
+  if (!aInRange && !TH1::GetStatOverflows()) {
+    return;
+  }
+  Double_t *stats = fFillStats[aHisto];
+  stats[0] += w;
+  stats[1] += w*w;
+  stats[2] += w*x;
+  stats[3] += w*x*x;
+  stats[4] += w*y;
+  stats[5] += w*y*y;
+  stats[6] += w*x*y;
+  stats[7] += w*z;
+  stats[8] += w*z*z;
+  stats[9] += w*x*z;
+  stats[10] += w*y*z;
+}
+
+//____________________________
+void AliFemtoCorrFctn3DLCMSSym::CommitMixedPairs()
+{
+  // Fill the buffered mixed pairs. They are sorted by bin first (stable,
+  // so the pairs of a bin are summed in the order they came) to walk
+  // through the histograms once.
+  if (fMixedPairs.empty()) {
+    return;
+  }
+  std::stable_sort(fMixedPairs.begin(), fMixedPairs.end(),
+                   [](const std::pair<Int_t, Double_t> &a, const std::pair<Int_t, Double_t> &b)
+                   { return a.first < b.first; });
+  for (const auto &mixed : fMixedPairs) {
+    FillBin(fDenominator, mixed.first, 1.0);
+    FillBin(fDenominatorW, mixed.first, mixed.second);
+  }
+  fMixedPairs.clear();
+}
+
+//____________________________
+void AliFemtoCorrFctn3DLCMSSym::Commit()
+{
+  // fill the buffered mixed pairs and put the statistics in the histograms
+  if (!fDirectFill) {
+    return;
+  }
+  CommitMixedPairs();
+
+  TH3F *histos[kNHisto] = { fNumerator, fDenominator, fNumeratorW, fDenominatorW };
+  for (int ihist = 0; ihist < kNHisto; ihist++) {
+    histos[ihist]->PutStats(fFillStats[ihist]);
+    histos[ihist]->SetEntries(fFillEntries[ihist]);
+  }
+}
+
+void AliFemtoCorrFctn3DLCMSSym::SetMixedPairBuffer(int aSize)
+{
+  CommitMixedPairs();
+  fMixedPairBuffer = aSize;
 }
 
 void AliFemtoCorrFctn3DLCMSSym::SetUseLCMS(int aUseLCMS)
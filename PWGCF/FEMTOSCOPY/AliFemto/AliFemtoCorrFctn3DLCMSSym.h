@@ -12,10 +12,20 @@ class AliFemtoPairCut;
 // include headers
 #include "AliFemtoCorrFctn.h"
 
+#include <vector>
+#include <utility>
+
 /// \class AliFemtoCorrFctn3DLCMSSym
 /// \brief A class to calculate 3D correlation functions for pairs of identical
 ///        particles vs. Bertsh-Pratt coordinates.
 ///
+/// The q components of a pair are computed once and the global bin of the
+/// (uniformly binned) histograms is derived directly from them; the plain
+/// and the qinv weighted histograms are updated through that index. The
+/// histogram statistics are committed at the end of each event.
+///
+/// With SetMixedPairBuffer(n) the mixed pairs are accumulated and
+/// committed n at a time, in bin order.
 ///
 class AliFemtoCorrFctn3DLCMSSym : public AliFemtoCorrFctn {
 public:
@@ -44,22 +54,47 @@ public:
   void WriteOutHistos();
   virtual TList* GetOutputList();
 
+  virtual void EventEnd(const AliFemtoEvent* aEvent);
+
   void SetUseLCMS(int);
   int  GetUseLCMS();
+
+  /// Number of mixed pairs accumulated before filling the denominators,
+  /// 0 (default) to fill them pair by pair
+  void SetMixedPairBuffer(int aSize);
+  int  GetMixedPairBuffer() const;
   virtual AliFemtoCorrFctn* Clone();
 
 private:
 
+  enum EHisto { kNum, kDen, kNumW, kDenW, kNHisto };
+
+  void  SetupDirectFill();
+  Int_t FindQBin(Double_t qout, Double_t qside, Double_t qlong, Bool_t &aInRange) const;
+  void  AddStats(EHisto aHisto, Double_t aWeight, Double_t qout, Double_t qside, Double_t qlong, Bool_t aInRange);
+  void  FillBin(TH3F *aHisto, Int_t aBin, Double_t aWeight);
+  void  CommitMixedPairs();
+  void  Commit();
+
   TH3F* fNumerator;     ///< Numerator
   TH3F* fDenominator;   ///< Denominator
   TH3F* fNumeratorW;    ///< Weighted numerator
   TH3F* fDenominatorW;  ///< Weighted denominator
 
   int    fUseLCMS;      ///< 0 - Use PRF, 1 - Use LCMS
+  int    fMixedPairBuffer; ///< Number of mixed pairs buffered before filling
+
+  Bool_t   fDirectFill;                   //!<! Histograms binning allows the direct fill
+  Int_t    fQNBins[3];                    //!<! Number of bins of the q axes
+  Double_t fQLow[3];                      //!<! Lower edge of the q axes
+  Double_t fQHigh[3];                     //!<! Upper edge of the q axes
+  Double_t fFillStats[kNHisto][11];       //!<! Statistics of the directly filled histograms
+  Double_t fFillEntries[kNHisto];         //!<! Entries of the directly filled histograms
+  std::vector< std::pair<Int_t, Double_t> > fMixedPairs; //!<! Buffered mixed pairs (bin, qinv)
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
-  ClassDef(AliFemtoCorrFctn3DLCMSSym, 1);
+  ClassDef(AliFemtoCorrFctn3DLCMSSym, 2);
   /// \endcond
 #endif
 };
@@ -71,20 +106,29 @@ inline AliFemtoCorrFctn* AliFemtoCorrFctn3DLCMSSym::Clone()
   return new AliFemtoCorrFctn3DLCMSSym(self);
 }
 
+inline int AliFemtoCorrFctn3DLCMSSym::GetMixedPairBuffer() const
+{
+  return fMixedPairBuffer;
+}
+
 inline  TH3F* AliFemtoCorrFctn3DLCMSSym::Numerator()
 {
+  Commit();
   return fNumerator;
 }
 inline  TH3F* AliFemtoCorrFctn3DLCMSSym::Denominator()
 {
+  Commit();
   return fDenominator;
 }
 inline  TH3F* AliFemtoCorrFctn3DLCMSSym::NumeratorW()
 {
+  Commit();
   return fNumeratorW;
 }
 inline  TH3F* AliFemtoCorrFctn3DLCMSSym::DenominatorW()
 {
+  Commit();
   return fDenominatorW;
 }
 #endif
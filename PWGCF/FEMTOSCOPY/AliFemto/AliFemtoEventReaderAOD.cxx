@@ -19,6 +19,7 @@
 #include "SystemOfUnits.h"
 
 #include "AliFemtoEvent.h"
+#include "AliFemtoTrackCut.h"
 #include "AliFemtoModelHiddenInfo.h"
 #include "AliFemtoModelGlobalHiddenInfo.h"
 #include "AliPID.h"
@@ -94,7 +95,9 @@ AliFemtoEventReaderAOD::AliFemtoEventReaderAOD():
   fIsKaonAnalysis(kFALSE),
   fIsProtonAnalysis(kFALSE),
   fIsPionAnalysis(kFALSE),
-  fIsElectronAnalysis(kFALSE)
+  fIsElectronAnalysis(kFALSE),
+  fTrackPreCut(NULL),
+  fTrackArena(NULL)
 {
   // default constructor
   fAllTrue.ResetAllBits(kTRUE);
@@ -148,8 +151,9 @@ AliFemtoEventReaderAOD::AliFemtoEventReaderAOD(const AliFemtoEventReaderAOD &aRe
   fIsKaonAnalysis(aReader.fIsKaonAnalysis),
   fIsProtonAnalysis(aReader.fIsProtonAnalysis),
   fIsPionAnalysis(aReader.fIsPionAnalysis),
-  fIsElectronAnalysis(aReader.fIsElectronAnalysis)
-
+  fIsElectronAnalysis(aReader.fIsElectronAnalysis),
+  fTrackPreCut(aReader.fTrackPreCut),
+  fTrackArena(NULL)
 {
   // copy constructor
   fAllTrue.ResetAllBits(kTRUE);
@@ -166,6 +170,7 @@ AliFemtoEventReaderAOD::~AliFemtoEventReaderAOD()
   delete fTree;
   delete fEvent;
   delete fAodFile;
+  delete fTrackArena;
 //   if (fPWG2AODTracks) {
 //     fPWG2AODTracks->Delete();
 //     delete fPWG2AODTracks;
@@ -223,6 +228,7 @@ AliFemtoEventReaderAOD &AliFemtoEventReaderAOD::operator=(const AliFemtoEventRea
   fIsProtonAnalysis = aReader.fIsProtonAnalysis;
   fIsPionAnalysis = aReader.fIsPionAnalysis;
   fIsElectronAnalysis = aReader.fIsElectronAnalysis;
+  fTrackPreCut = aReader.fTrackPreCut;
 
   return *this;
 }
@@ -430,8 +436,11 @@ AliFemtoEvent *AliFemtoEventReaderAOD::CopyAODtoFemtoEvent()
   // i.e. labels[Event->GetTrack(x)->GetID()] == x
   std::map<int, int> labels;
 
+  // TPC-only tracks take the PID information of the global tracks
+  const bool tpcOnlyTracks = (fFilterBit == (1 << 7) || fFilterMask == 128);
+
   // looking for global tracks and saving their numbers to copy from them PID information to TPC-only tracks in the main loop over tracks
-  for (int i = 0; i < nofTracks; i++) {
+  for (int i = 0; tpcOnlyTracks && i < nofTracks; i++) {
     const AliAODTrack *aodtrack = dynamic_cast<const AliAODTrack *>(fEvent->GetTrack(i));
     assert(aodtrack && "Not a standard AOD");
     if (!aodtrack->TestFilterBit(fFilterBit)) {
@@ -532,7 +541,16 @@ AliFemtoEvent *AliFemtoEventReaderAOD::CopyAODtoFemtoEvent()
     tEvent->SetNormalizedMult(norm_mult);
 
     
-    AliFemtoTrack *trackCopy = CopyAODtoFemtoTrack(aodtrack);
+    AliFemtoTrack *trackCopy = NULL;
+    if (fTrackPreCut) {
+      // pre-selected tracks are filled in the reused track first
+      if (!fTrackArena) fTrackArena = new AliFemtoTrack();
+      else *fTrackArena = AliFemtoTrack();
+      FillAODtoFemtoTrack(aodtrack, fTrackArena);
+      trackCopy = fTrackArena;
+    } else {
+      trackCopy = CopyAODtoFemtoTrack(aodtrack);
+    }
    
     trackCopy->SetMultiplicity(norm_mult);
     trackCopy->SetZvtx(fV1[2]);
@@ -542,7 +560,7 @@ AliFemtoEvent *AliFemtoEventReaderAOD::CopyAODtoFemtoEvent()
 
 
     // For TPC Only tracks we have to copy PID information from corresponding global tracks
-    const Int_t pid_track_id = (fFilterBit == (1 << 7) || fFilterMask == 128)
+    const Int_t pid_track_id = tpcOnlyTracks
                              ? labels[-1 - fEvent->GetTrack(i)->GetID()]
                              : i;
     AliAODTrack *aodtrackpid = dynamic_cast<AliAODTrack *>(fEvent->GetTrack(pid_track_id));
@@ -694,6 +712,14 @@ AliFemtoEvent *AliFemtoEventReaderAOD::CopyAODtoFemtoEvent()
     //AliExternalTrackParam *param = new AliExternalTrackParam(*aodtrack->GetInnerParam());
     trackCopy->SetInnerMomentum(aodtrack->GetTPCmomentum());
 
+    if (fTrackPreCut) {
+      if (!fTrackPreCut->Pass(trackCopy)) {
+        continue;
+      }
+      trackCopy = new AliFemtoTrack(*fTrackArena);
+      FillNominalTPCPoints(aodtrack, trackCopy);
+    }
+
     //Special MC analysis for pi,K,p,e slected by PDG code -->
     if(fIsKaonAnalysis || fIsProtonAnalysis || fIsPionAnalysis || fIsElectronAnalysis) {
       Int_t pdg = ((AliFemtoModelHiddenInfo*)trackCopy->GetHiddenInfo())->GetPDGPid();
@@ -959,6 +985,14 @@ AliFemtoTrack *AliFemtoEventReaderAOD::CopyAODtoFemtoTrack(AliAODTrack *tAodTrac
   // Copy the track information from the AOD into the internal AliFemtoTrack
   // If it exists, use the additional information from the PWG2 AOD
   AliFemtoTrack *tFemtoTrack = new AliFemtoTrack();
+  FillAODtoFemtoTrack(tAodTrack, tFemtoTrack);
+  FillNominalTPCPoints(tAodTrack, tFemtoTrack);
+  return tFemtoTrack;
+}
+
+void AliFemtoEventReaderAOD::FillAODtoFemtoTrack(AliAODTrack *tAodTrack, AliFemtoTrack *tFemtoTrack)
+{
+  // Fill the track information from the AOD, except the nominal TPC points
 
   // Primary Vertex position
 
@@ -1014,55 +1048,6 @@ AliFemtoTrack *AliFemtoEventReaderAOD::CopyAODtoFemtoTrack(AliAODTrack *tAodTrac
   tFemtoTrack->SetTPCClusterMap(tAodTrack->GetTPCClusterMap());
   tFemtoTrack->SetTPCSharedMap(tAodTrack->GetTPCSharedMap());
 
-  float globalPositionsAtRadii[9][3];
-  float bfield = 5 * fMagFieldSign;
-
-  GetGlobalPositionAtGlobalRadiiThroughTPC(tAodTrack, bfield, globalPositionsAtRadii);
-  double tpcEntrance[3] = {globalPositionsAtRadii[0][0], globalPositionsAtRadii[0][1], globalPositionsAtRadii[0][2]};
-  double **tpcPositions;
-  tpcPositions = new double*[9];
-
-  for (int i = 0; i < 9; i++) {
-    tpcPositions[i] = new double[3];
-  }
-
-  double tpcExit[3] = {globalPositionsAtRadii[8][0], globalPositionsAtRadii[8][1], globalPositionsAtRadii[8][2]};
-  for (int i = 0; i < 9; i++) {
-    tpcPositions[i][0] = globalPositionsAtRadii[i][0];
-    tpcPositions[i][1] = globalPositionsAtRadii[i][1];
-    tpcPositions[i][2] = globalPositionsAtRadii[i][2];
-  }
-
-  if (fPrimaryVertexCorrectionTPCPoints) {
-    tpcEntrance[0] -= fV1[0];
-    tpcEntrance[1] -= fV1[1];
-    tpcEntrance[2] -= fV1[2];
-
-    tpcExit[0] -= fV1[0];
-    tpcExit[1] -= fV1[1];
-    tpcExit[2] -= fV1[2];
-
-    for (int i = 0; i < 9; i++) {
-      tpcPositions[i][0] -= fV1[0];
-      tpcPositions[i][1] -= fV1[1];
-      tpcPositions[i][2] -= fV1[2];
-    }
-  }
-
-  tFemtoTrack->SetNominalTPCEntrancePoint(tpcEntrance);
-  tFemtoTrack->SetNominalTPCPoints(tpcPositions);
-  tFemtoTrack->SetNominalTPCExitPoint(tpcExit);
-
-  if (fShiftPosition > 0.) {
-    Float_t posShifted[3];
-    SetShiftedPositions(tAodTrack, bfield, posShifted, fShiftPosition);
-    tFemtoTrack->SetNominalTPCPointShifted(posShifted);
-  }
-
-  for (int i = 0; i < 9; i++) {
-    delete [] tpcPositions[i];
-  }
-  delete [] tpcPositions;
 
 
   int indexes[3];
@@ -1112,9 +1097,56 @@ AliFemtoTrack *AliFemtoEventReaderAOD::CopyAODtoFemtoTrack(AliAODTrack *tAodTrac
     tFemtoTrack->SetCorrectionAll(f1DcorrectionsAll->GetBinContent(f1DcorrectionsAll->FindFixBin(tAodTrack->Pt())));
   }
   else tFemtoTrack->SetCorrectionAll(1.0);
+}
 
+void AliFemtoEventReaderAOD::FillNominalTPCPoints(AliAODTrack *tAodTrack, AliFemtoTrack *tFemtoTrack)
+{
+  // Nominal TPC entrance, exit and intermediate points of the track,
+  // and its shifted position
+  float globalPositionsAtRadii[9][3];
+  float bfield = 5 * fMagFieldSign;
 
-  return tFemtoTrack;
+  GetGlobalPositionAtGlobalRadiiThroughTPC(tAodTrack, bfield, globalPositionsAtRadii);
+  double tpcEntrance[3] = {globalPositionsAtRadii[0][0], globalPositionsAtRadii[0][1], globalPositionsAtRadii[0][2]};
+  double tpcPositionsData[9][3];
+  double *tpcPositions[9];
+
+  for (int i = 0; i < 9; i++) {
+    tpcPositions[i] = tpcPositionsData[i];
+  }
+
+  double tpcExit[3] = {globalPositionsAtRadii[8][0], globalPositionsAtRadii[8][1], globalPositionsAtRadii[8][2]};
+  for (int i = 0; i < 9; i++) {
+    tpcPositions[i][0] = globalPositionsAtRadii[i][0];
+    tpcPositions[i][1] = globalPositionsAtRadii[i][1];
+    tpcPositions[i][2] = globalPositionsAtRadii[i][2];
+  }
+
+  if (fPrimaryVertexCorrectionTPCPoints) {
+    tpcEntrance[0] -= fV1[0];
+    tpcEntrance[1] -= fV1[1];
+    tpcEntrance[2] -= fV1[2];
+
+    tpcExit[0] -= fV1[0];
+    tpcExit[1] -= fV1[1];
+    tpcExit[2] -= fV1[2];
+
+    for (int i = 0; i < 9; i++) {
+      tpcPositions[i][0] -= fV1[0];
+      tpcPositions[i][1] -= fV1[1];
+      tpcPositions[i][2] -= fV1[2];
+    }
+  }
+
+  tFemtoTrack->SetNominalTPCEntrancePoint(tpcEntrance);
+  tFemtoTrack->SetNominalTPCPoints(tpcPositions);
+  tFemtoTrack->SetNominalTPCExitPoint(tpcExit);
+
+  if (fShiftPosition > 0.) {
+    Float_t posShifted[3];
+    SetShiftedPositions(tAodTrack, bfield, posShifted, fShiftPosition);
+    tFemtoTrack->SetNominalTPCPointShifted(posShifted);
+  }
 }
 
 AliFemtoV0 *AliFemtoEventReaderAOD::CopyAODtoFemtoV0(AliAODv0 *tAODv0)
@@ -2015,6 +2047,11 @@ void AliFemtoEventReaderAOD::SetShiftedPositions(const AliAODTrack *track
   } // End of coarse propagation loop
 }
 
+void AliFemtoEventReaderAOD::SetTrackPreSelection(AliFemtoTrackCut *aCut)
+{
+  fTrackPreCut = aCut;
+}
+
 void AliFemtoEventReaderAOD::SetpA2013(Bool_t pa2013)
 {
   fpA2013 = pa2013;
@@ -29,6 +29,7 @@
 
 class AliFemtoEvent;
 class AliFemtoTrack;
+class AliFemtoTrackCut;
 
 class AliFemtoEventReaderAOD : public AliFemtoEventReader {
 public:
@@ -98,12 +99,21 @@ public:
   void SetProtonAnalysis(Bool_t aSetProtonAna);
   void SetElectronAnalysis(Bool_t aSetElectronAna);
   //Special MC analysis for pi,K,p,e slected by PDG code <--
+
+  /// Tracks failing aCut are dropped before the expensive part of the
+  /// conversion (nominal TPC points, shifted position) and without
+  /// allocating an AliFemtoTrack. aCut is applied to the track with all
+  /// the other information filled (PID, MC), it must be at most as tight
+  /// as the particle cuts of the analyses and is not owned by the reader.
+  void SetTrackPreSelection(AliFemtoTrackCut *aCut);
   
 protected:
   virtual AliFemtoEvent *CopyAODtoFemtoEvent();
   virtual AliFemtoTrack *CopyAODtoFemtoTrack(AliAODTrack *tAodTrack
       //            AliPWG2AODTrack *tPWG2AODTrack
                                             );
+  virtual void FillAODtoFemtoTrack(AliAODTrack *tAodTrack, AliFemtoTrack *tFemtoTrack);
+  void FillNominalTPCPoints(AliAODTrack *tAodTrack, AliFemtoTrack *tFemtoTrack);
   virtual AliFemtoV0 *CopyAODtoFemtoV0(AliAODv0 *tAODv0);
   virtual AliFemtoXi *CopyAODtoFemtoXi(AliAODcascade *tAODxi);
   virtual void CopyPIDtoFemtoTrack(AliAODTrack *tAodTrack, AliFemtoTrack *tFemtoTrack);
@@ -164,10 +174,13 @@ private:
   Bool_t fIsElectronAnalysis; // e+e- are taken (for gamma cut tuning)
   //Special MC analysis for pi,K,p,e slected by PDG code <--
 
+  AliFemtoTrackCut *fTrackPreCut; ///< pre-selection of the tracks before the full conversion (not owned)
+  AliFemtoTrack *fTrackArena;     //!<! track reused for the conversion of the pre-selected tracks
+
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
-  ClassDef(AliFemtoEventReaderAOD, 12);
+  ClassDef(AliFemtoEventReaderAOD, 13);
   /// \endcond
 #endif
 
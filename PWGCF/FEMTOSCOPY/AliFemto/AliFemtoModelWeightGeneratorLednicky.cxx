@@ -20,6 +20,13 @@
 //#include <stream>
 //#include <iomanip>
 #include <sstream>
+#include <cmath>
+
+#include <TFile.h>
+#include <TH3F.h>
+#include <TVectorD.h>
+#include <TRandom.h>
+#include <TMath.h>
 
 #ifdef SOLARIS
 # ifndef false
@@ -114,7 +121,12 @@ AliFemtoModelWeightGeneratorLednicky::AliFemtoModelWeightGeneratorLednicky() :
   fSphereApp(false),fT0App(false) ,
   fLL(0), fNuclChargeSign(1), fSwap(0), fLLMax(30), fLLName(0), 
   fNumProcessPair(0), fNumbNonId(0),
-  fKpKmModel(14),fPhi_OffOn(1)
+  fKpKmModel(14),fPhi_OffOn(1),
+  fTabulated(false),
+  fTableNK(150),fTableKMin(0.001),fTableKMax(0.3),
+  fTableNR(150),fTableRMin(0.05),fTableRMax(30.),
+  fTableNCos(41),
+  fTables(),fTableState()
 {
   // default constructor
   fLLName=new char*[fLLMax+1];
@@ -163,7 +175,12 @@ AliFemtoModelWeightGeneratorLednicky::AliFemtoModelWeightGeneratorLednicky(const
   fSphereApp(false),fT0App(false) ,
   fLL(0), fNuclChargeSign(1), fSwap(0), fLLMax(30), fLLName(0), 
   fNumProcessPair(0), fNumbNonId(0),
-  fKpKmModel(14),fPhi_OffOn(1)
+  fKpKmModel(14),fPhi_OffOn(1),
+  fTabulated(aWeight.fTabulated),
+  fTableNK(aWeight.fTableNK),fTableKMin(aWeight.fTableKMin),fTableKMax(aWeight.fTableKMax),
+  fTableNR(aWeight.fTableNR),fTableRMin(aWeight.fTableRMin),fTableRMax(aWeight.fTableRMax),
+  fTableNCos(aWeight.fTableNCos),
+  fTables(aWeight.fTables),fTableState(aWeight.fTableState)
 {
   // copy constructor
   fWei = aWeight.fWei; 
@@ -258,6 +275,16 @@ AliFemtoModelWeightGeneratorLednicky& AliFemtoModelWeightGeneratorLednicky::oper
   fNumProcessPair=new int[fLLMax+1];
   fKpKmModel = aWeight.fKpKmModel;
   fPhi_OffOn = aWeight.fPhi_OffOn;
+  fTabulated = aWeight.fTabulated;
+  fTableNK = aWeight.fTableNK;
+  fTableKMin = aWeight.fTableKMin;
+  fTableKMax = aWeight.fTableKMax;
+  fTableNR = aWeight.fTableNR;
+  fTableRMin = aWeight.fTableRMin;
+  fTableRMax = aWeight.fTableRMax;
+  fTableNCos = aWeight.fTableNCos;
+  fTables = aWeight.fTables;
+  fTableState = aWeight.fTableState;
   int i;
   for (i=1;i<=fLLMax;i++) {fLLName[i]=new char[40];fNumProcessPair[i]=0;}
   strncpy( fLLName[1],"neutron neutron",40);
@@ -421,11 +448,6 @@ Double_t tDTime =inf1->GetEmissionPoint()->t()  - inf2->GetEmissionPoint()->t();
       fWeightDen=0.;
       return 0;  
     } 
-    if (fSwap) {
-      fsimomentum(*p2,*p1);
-    } else {
-      fsimomentum(*p1,*p2);
-    }
     AliFemtoLorentzVector* tPoint;
 //    tPoint=((AliFemtoModelHiddenInfo*)inf1->GetHiddenInfo())->GetEmissionPoint();
     tPoint=inf1->GetEmissionPoint();
@@ -444,9 +466,18 @@ Double_t tDTime =inf1->GetEmissionPoint()->t()  - inf2->GetEmissionPoint()->t();
       fWeightDen=0.;
       return 0;  
     } 
+    if (fTabulated) {
+      double tWeight;
+      if (TableWeight(tWeight)) {
+        fWei = fWein = tWeight;
+        return tWeight;
+      }
+    }
     if (fSwap) {
+      fsimomentum(*p2,*p1);
       fsiposition(*x2,*x1);
     } else {
+      fsimomentum(*p1,*p2);
       fsiposition(*x1,*x2);
     }
     FsiSetLL();
@@ -483,6 +514,15 @@ AliFemtoString AliFemtoModelWeightGeneratorLednicky::Report() {
   }
   if (fNumbNonId)
     tStr << "         "<< fNumbNonId << " Non Identified" << endl;
+  if (fTabulated) {
+    tStr << "    Tabulated weights : " << fTableNK << " k* points in [" << fTableKMin << "," << fTableKMax << "] GeV/c, "
+         << fTableNR << " r* points in [" << fTableRMin << "," << fTableRMax << "] fm, "
+         << fTableNCos << " cos(theta) points" << endl;
+    for(i=1;i<(int)fTableState.size();i++) {
+      if (fTableState[i]==1)
+        tStr << "         table for " << fLLName[i] << endl;
+    }
+  }
   AliFemtoString returnThis = tStr.str();
   return returnThis;
 }
@@ -517,13 +557,8 @@ void AliFemtoModelWeightGeneratorLednicky::FsiNucl(){
 
 void AliFemtoModelWeightGeneratorLednicky::FsiSetLL(){
   // set internal pair type for the module
-  int tNS;
-  if (fSphereApp||(fLL>5)) {
-    if (fT0App) { tNS=4;} 
-    else {tNS=2;}
-  } else { tNS=1;}
+  int tNS=FsiNS();
   //cout<<"*********************** AliFemtoModelWeightGeneratorLednicky::FsiSetLL() *********************"<<endl;
-  if(fNS_4==4) tNS=4;//K+K- analisys
   //cout <<"fLL dans FsiSetLL() = "<< fLL << endl;
   //cout <<"tNS dans FsiSetLL() = "<< tNS << endl;
   //cout <<"fItest dans FsiSetLL() = "<< fItest << endl;
@@ -534,6 +569,17 @@ void AliFemtoModelWeightGeneratorLednicky::FsiSetLL(){
   llini(fLL,tNS,fItest);
  // cout<<" end of FsiSetLL"<<endl;
 }
+
+int AliFemtoModelWeightGeneratorLednicky::FsiNS() const {
+  // approximation used for the Bethe-Salpeter amplitude of the current pair type
+  int tNS;
+  if (fSphereApp||(fLL>5)) {
+    if (fT0App) { tNS=4;} 
+    else {tNS=2;}
+  } else { tNS=1;}
+  if(fNS_4==4) tNS=4;//K+K- analisys
+  return tNS;
+}
          
 bool AliFemtoModelWeightGeneratorLednicky::SetPid(const int aPid1,const int aPid2) {
   // set calculated system for basing on particles' pids
@@ -720,27 +766,300 @@ void     AliFemtoModelWeightGeneratorLednicky::SetPairTypeFromPair(AliFemtoPair
 }
 
 //K+K- model type
-void AliFemtoModelWeightGeneratorLednicky::SetKpKmModelType(const int aModelType, const int aPhi_OffOn) {fKpKmModel=aModelType; fPhi_OffOn=aPhi_OffOn; fNS_4=4; FsiSetKpKmModelType();}
+void AliFemtoModelWeightGeneratorLednicky::SetKpKmModelType(const int aModelType, const int aPhi_OffOn) {fKpKmModel=aModelType; fPhi_OffOn=aPhi_OffOn; fNS_4=4; FsiSetKpKmModelType(); ClearTables();}
 
 void AliFemtoModelWeightGeneratorLednicky::SetNuclCharge(const double aNuclCharge) {fNuclCharge=aNuclCharge;FsiNucl();}
 void AliFemtoModelWeightGeneratorLednicky::SetNuclMass(const double aNuclMass){fNuclMass=aNuclMass;FsiNucl();}
 
-void AliFemtoModelWeightGeneratorLednicky::SetSphere(){fSphereApp=true;}
-void AliFemtoModelWeightGeneratorLednicky::SetSquare(){fSphereApp=false;}
-void AliFemtoModelWeightGeneratorLednicky::SetT0ApproxOn(){ fT0App=true;}
-void AliFemtoModelWeightGeneratorLednicky::SetT0ApproxOff(){ fT0App=false;}
+void AliFemtoModelWeightGeneratorLednicky::SetSphere(){fSphereApp=true;ClearTables();}
+void AliFemtoModelWeightGeneratorLednicky::SetSquare(){fSphereApp=false;ClearTables();}
+void AliFemtoModelWeightGeneratorLednicky::SetT0ApproxOn(){ fT0App=true;ClearTables();}
+void AliFemtoModelWeightGeneratorLednicky::SetT0ApproxOff(){ fT0App=false;ClearTables();}
 void AliFemtoModelWeightGeneratorLednicky::SetDefaultCalcPar(){
   fItest=1;fIqs=1;fIsi=1;fI3c=0;fIch=1;FsiInit();
-  fSphereApp=false;fT0App=false;}
-
-void AliFemtoModelWeightGeneratorLednicky::SetCoulOn()    {fItest=1;fIch=1;FsiInit();}
-void AliFemtoModelWeightGeneratorLednicky::SetCoulOff()   {fItest=1;fIch=0;FsiInit();}
-void AliFemtoModelWeightGeneratorLednicky::SetQuantumOn() {fItest=1;fIqs=1;FsiInit();}
-void AliFemtoModelWeightGeneratorLednicky::SetQuantumOff(){fItest=1;fIqs=0;FsiInit();}
-void AliFemtoModelWeightGeneratorLednicky::SetStrongOn()  {fItest=1;fIsi=1;FsiInit();}
-void AliFemtoModelWeightGeneratorLednicky::SetStrongOff() {fItest=1;fIsi=0;FsiInit();}
-void AliFemtoModelWeightGeneratorLednicky::Set3BodyOn()   {fItest=1;fI3c=1;FsiInit();FsiNucl();}
-void AliFemtoModelWeightGeneratorLednicky::Set3BodyOff()  {fItest=1;fI3c=0;FsiInit();fWeightDen=1.;FsiNucl();}
+  fSphereApp=false;fT0App=false;ClearTables();}
+
+void AliFemtoModelWeightGeneratorLednicky::SetCoulOn()    {fItest=1;fIch=1;FsiInit();ClearTables();}
+void AliFemtoModelWeightGeneratorLednicky::SetCoulOff()   {fItest=1;fIch=0;FsiInit();ClearTables();}
+void AliFemtoModelWeightGeneratorLednicky::SetQuantumOn() {fItest=1;fIqs=1;FsiInit();ClearTables();}
+void AliFemtoModelWeightGeneratorLednicky::SetQuantumOff(){fItest=1;fIqs=0;FsiInit();ClearTables();}
+void AliFemtoModelWeightGeneratorLednicky::SetStrongOn()  {fItest=1;fIsi=1;FsiInit();ClearTables();}
+void AliFemtoModelWeightGeneratorLednicky::SetStrongOff() {fItest=1;fIsi=0;FsiInit();ClearTables();}
+void AliFemtoModelWeightGeneratorLednicky::Set3BodyOn()   {fItest=1;fI3c=1;FsiInit();FsiNucl();ClearTables();}
+void AliFemtoModelWeightGeneratorLednicky::Set3BodyOff()  {fItest=1;fI3c=0;FsiInit();fWeightDen=1.;FsiNucl();ClearTables();}
+
+//_____________________________________________
+// Tabulated weights
+void AliFemtoModelWeightGeneratorLednicky::SetTabulatedOn()  {fTabulated=true;}
+void AliFemtoModelWeightGeneratorLednicky::SetTabulatedOff() {fTabulated=false;}
+
+void AliFemtoModelWeightGeneratorLednicky::SetTableKStarRange(const int aNPoints, const double aKStarMin, const double aKStarMax)
+{
+  // k* points of the tables, in GeV/c
+  fTableNK=aNPoints; fTableKMin=aKStarMin; fTableKMax=aKStarMax;
+  ClearTables();
+}
+
+void AliFemtoModelWeightGeneratorLednicky::SetTableRStarRange(const int aNPoints, const double aRStarMin, const double aRStarMax)
+{
+  // r* points of the tables, in fm
+  fTableNR=aNPoints; fTableRMin=aRStarMin; fTableRMax=aRStarMax;
+  ClearTables();
+}
+
+void AliFemtoModelWeightGeneratorLednicky::SetTableCosThetaPoints(const int aNPoints)
+{
+  // number of cos(theta) points of the tables, in [-1,1]
+  fTableNCos=aNPoints;
+  ClearTables();
+}
+
+void AliFemtoModelWeightGeneratorLednicky::ClearTables()
+{
+  // forget the tables, the calculation setup changed
+  fTables.clear();
+  fTableState.clear();
+}
+
+std::vector<double> AliFemtoModelWeightGeneratorLednicky::TableSetup() const
+{
+  // calculation parameters the tables depend on
+  std::vector<double> tSetup;
+  tSetup.push_back(fItest);
+  tSetup.push_back(fIch);
+  tSetup.push_back(fIqs);
+  tSetup.push_back(fIsi);
+  tSetup.push_back(fSphereApp);
+  tSetup.push_back(fT0App);
+  tSetup.push_back(fNS_4==4);
+  tSetup.push_back(fKpKmModel);
+  tSetup.push_back(fPhi_OffOn);
+  return tSetup;
+}
+
+bool AliFemtoModelWeightGeneratorLednicky::SetTablePid(const int aPid1, const int aPid2)
+{
+  // set the pair type without counting a processed pair
+  bool tKnown=SetPid(aPid1,aPid2);
+  (fNumProcessPair[0])--;
+  if (tKnown) (fNumProcessPair[fLL])--;
+  else fNumbNonId--;
+  return tKnown;
+}
+
+double AliFemtoModelWeightGeneratorLednicky::ExactWeight(const double aKStar, const double aRStar, const double aCosTheta)
+{
+  // Exact weight of the current pair type (FsiSetLL called) for given
+  // k*, r* and angle between them in the pair rest frame, at t*=0.
+  // The pair is put at rest: without the 3rd body the weight does not
+  // depend on the pair velocity.
+  double tSinTheta=::sqrt(TMath::Max(0.,1.-aCosTheta*aCosTheta));
+  double p1[]={0.,0.,aKStar};
+  double p2[]={0.,0.,-aKStar};
+  double x1[]={aRStar*tSinTheta,0.,aRStar*aCosTheta,0.};
+  double x2[]={0.,0.,0.,0.};
+  fsimomentum(*p1,*p2);
+  fsiposition(*x1,*x2);
+  ltran12();
+  fsiw(1,fWeif,fWei,fWein);
+  return fWein;
+}
+
+bool AliFemtoModelWeightGeneratorLednicky::BuildTable(const int aPid1, const int aPid2)
+{
+  // fill the weight table of the given pair type
+  if (!SetTablePid(aPid1,aPid2)) return false;
+  return BuildTable();
+}
+
+bool AliFemtoModelWeightGeneratorLednicky::BuildTable()
+{
+  // fill the weight table of the current pair type with the exact calculation
+  if ((int)fTableState.size()!=fLLMax+1) {
+    fTables.assign(fLLMax+1,std::vector<float>());
+    fTableState.assign(fLLMax+1,0);
+  }
+  if (fI3c || FsiNS()==2) {
+    cout << "AliFemtoModelWeightGeneratorLednicky: " << fLLName[fLL]
+         << " weight depends on t* or on the 3rd body, not tabulated (see SetT0ApproxOn())" << endl;
+    fTableState[fLL]=-1;
+    return false;
+  }
+  if (fTableNK<2 || fTableNR<2 || fTableNCos<2 || fTableKMin<=0. || fTableRMin<=0. ||
+      fTableKMax<=fTableKMin || fTableRMax<=fTableRMin) {
+    cout << "AliFemtoModelWeightGeneratorLednicky: bad table binning, " << fLLName[fLL] << " not tabulated" << endl;
+    fTableState[fLL]=-1;
+    return false;
+  }
+
+  FsiSetLL();
+  const double tDK=(fTableKMax-fTableKMin)/(fTableNK-1);
+  const double tDR=(fTableRMax-fTableRMin)/(fTableNR-1);
+  const double tDCos=2./(fTableNCos-1);
+  std::vector<float> &tTable=fTables[fLL];
+  tTable.resize(fTableNK*fTableNR*fTableNCos);
+  int tIndex=0;
+  for (int ik=0; ik<fTableNK; ik++)
+    for (int ir=0; ir<fTableNR; ir++)
+      for (int ic=0; ic<fTableNCos; ic++)
+        tTable[tIndex++]=ExactWeight(fTableKMin+ik*tDK,fTableRMin+ir*tDR,-1.+ic*tDCos);
+  fTableState[fLL]=1;
+  cout << "AliFemtoModelWeightGeneratorLednicky: " << tTable.size() << " points weight table built for " << fLLName[fLL] << endl;
+  return true;
+}
+
+double AliFemtoModelWeightGeneratorLednicky::InterpolateWeight(const std::vector<float> &aTable, const double aKStar,
+                                                               const double aRStar, const double aCosTheta) const
+{
+  // trilinear interpolation in the table, the point must be inside
+  double tX=(aKStar-fTableKMin)/(fTableKMax-fTableKMin)*(fTableNK-1);
+  int tIK=TMath::Min((int)tX,fTableNK-2);
+  const double tWK=tX-tIK;
+  tX=(aRStar-fTableRMin)/(fTableRMax-fTableRMin)*(fTableNR-1);
+  int tIR=TMath::Min((int)tX,fTableNR-2);
+  const double tWR=tX-tIR;
+  tX=(aCosTheta+1.)*0.5*(fTableNCos-1);
+  int tIC=TMath::Max(0,TMath::Min((int)tX,fTableNCos-2));
+  const double tWC=TMath::Max(0.,TMath::Min(1.,tX-tIC));
+
+  const int tStepR=fTableNCos;
+  const int tStepK=fTableNR*fTableNCos;
+  const float *tP=&aTable[tIK*tStepK+tIR*tStepR+tIC];
+  const double tW00=tP[0]              *(1.-tWC)+tP[1]              *tWC;
+  const double tW01=tP[tStepR]         *(1.-tWC)+tP[tStepR+1]       *tWC;
+  const double tW10=tP[tStepK]         *(1.-tWC)+tP[tStepK+1]       *tWC;
+  const double tW11=tP[tStepK+tStepR]  *(1.-tWC)+tP[tStepK+tStepR+1]*tWC;
+  return (tW00*(1.-tWR)+tW01*tWR)*(1.-tWK)+(tW10*(1.-tWR)+tW11*tWR)*tWK;
+}
+
+bool AliFemtoModelWeightGeneratorLednicky::TableWeight(double &aWeight)
+{
+  // weight of the current pair interpolated in the table of its type,
+  // false if the pair has to be calculated exactly
+  if (fI3c) return false;
+  if ((int)fTableState.size()!=fLLMax+1 || fTableState[fLL]==0) BuildTable();
+  if (fTableState[fLL]!=1) return false;
+  if (fKStar<fTableKMin || fKStar>fTableKMax || fRStar<fTableRMin || fRStar>fTableRMax) return false;
+
+  const double tCosTheta=(fKStarOut*fRStarOut+fKStarSide*fRStarSide+fKStarLong*fRStarLong)/(fKStar*fRStar);
+  aWeight=InterpolateWeight(fTables[fLL],fKStar,fRStar,tCosTheta);
+  return true;
+}
+
+double AliFemtoModelWeightGeneratorLednicky::CheckTable(const int aPid1, const int aPid2, const int aNPoints)
+{
+  // Compare the table of the given pair type with the exact calculation
+  // at aNPoints random points inside the table. Returns the maximal
+  // absolute deviation, -1 if there is no table.
+  if (!SetTablePid(aPid1,aPid2)) return -1.;
+  if ((int)fTableState.size()!=fLLMax+1 || fTableState[fLL]==0) BuildTable();
+  if (fTableState[fLL]!=1) return -1.;
+
+  FsiSetLL();
+  double tMaxDev=0., tSumDev=0.;
+  for (int i=0; i<aNPoints; i++) {
+    const double tKStar=fTableKMin+gRandom->Rndm()*(fTableKMax-fTableKMin);
+    const double tRStar=fTableRMin+gRandom->Rndm()*(fTableRMax-fTableRMin);
+    const double tCosTheta=-1.+2.*gRandom->Rndm();
+    const double tDev=fabs(InterpolateWeight(fTables[fLL],tKStar,tRStar,tCosTheta)-
+                           ExactWeight(tKStar,tRStar,tCosTheta));
+    tSumDev+=tDev;
+    if (tDev>tMaxDev) tMaxDev=tDev;
+  }
+  cout << "AliFemtoModelWeightGeneratorLednicky: " << fLLName[fLL] << " table deviation from the exact weight, mean "
+       << (aNPoints>0 ? tSumDev/aNPoints : 0.) << " max " << tMaxDev << endl;
+  return tMaxDev;
+}
+
+bool AliFemtoModelWeightGeneratorLednicky::SaveTables(const char *aFileName) const
+{
+  // write the built tables, one TH3F per pair type with bins centered on
+  // the table points, and the calculation setup
+  TFile tFile(aFileName,"RECREATE");
+  if (tFile.IsZombie()) return false;
+
+  const std::vector<double> tSetup=TableSetup();
+  TVectorD tSetupVector(tSetup.size(),&tSetup[0]);
+  tFile.WriteTObject(&tSetupVector,"LednickyWeightSetup");
+
+  const double tDK=(fTableKMax-fTableKMin)/(fTableNK-1);
+  const double tDR=(fTableRMax-fTableRMin)/(fTableNR-1);
+  const double tDCos=2./(fTableNCos-1);
+  for (int ll=1; ll<(int)fTableState.size(); ll++) {
+    if (fTableState[ll]!=1) continue;
+    TH3F *tHist=new TH3F(Form("LednickyWeightLL%d",ll),fLLName[ll],
+                         fTableNK,fTableKMin-0.5*tDK,fTableKMax+0.5*tDK,
+                         fTableNR,fTableRMin-0.5*tDR,fTableRMax+0.5*tDR,
+                         fTableNCos,-1.-0.5*tDCos,1.+0.5*tDCos);
+    tHist->SetDirectory(0);
+    tHist->GetXaxis()->SetTitle("k* (GeV/c)");
+    tHist->GetYaxis()->SetTitle("r* (fm)");
+    tHist->GetZaxis()->SetTitle("cos(#theta)");
+    const std::vector<float> &tTable=fTables[ll];
+    int tIndex=0;
+    for (int ik=0; ik<fTableNK; ik++)
+      for (int ir=0; ir<fTableNR; ir++)
+        for (int ic=0; ic<fTableNCos; ic++)
+          tHist->SetBinContent(ik+1,ir+1,ic+1,tTable[tIndex++]);
+    tFile.WriteTObject(tHist);
+    delete tHist;
+  }
+  tFile.Close();
+  return true;
+}
+
+bool AliFemtoModelWeightGeneratorLednicky::LoadTables(const char *aFileName)
+{
+  // read tables written by SaveTables, the calculation setup must match
+  TFile *tFile=TFile::Open(aFileName);
+  if (!tFile || tFile->IsZombie()) {
+    delete tFile;
+    return false;
+  }
+  TVectorD *tSetupVector=dynamic_cast<TVectorD*>(tFile->Get("LednickyWeightSetup"));
+  const std::vector<double> tSetup=TableSetup();
+  bool tMatch=(tSetupVector && tSetupVector->GetNoElements()==(int)tSetup.size());
+  for (int i=0; tMatch && i<(int)tSetup.size(); i++) tMatch=((*tSetupVector)[i]==tSetup[i]);
+  delete tSetupVector;
+  if (!tMatch) {
+    cout << "AliFemtoModelWeightGeneratorLednicky: " << aFileName << " tables made with another calculation setup, not loaded" << endl;
+    tFile->Close();
+    delete tFile;
+    return false;
+  }
+
+  ClearTables();
+  fTables.assign(fLLMax+1,std::vector<float>());
+  fTableState.assign(fLLMax+1,0);
+  bool tFirst=true;
+  for (int ll=1; ll<=fLLMax; ll++) {
+    TH3F *tHist=dynamic_cast<TH3F*>(tFile->Get(Form("LednickyWeightLL%d",ll)));
+    if (!tHist) continue;
+    if (tFirst) {
+      fTableNK=tHist->GetNbinsX();
+      fTableKMin=tHist->GetXaxis()->GetBinCenter(1);
+      fTableKMax=tHist->GetXaxis()->GetBinCenter(fTableNK);
+      fTableNR=tHist->GetNbinsY();
+      fTableRMin=tHist->GetYaxis()->GetBinCenter(1);
+      fTableRMax=tHist->GetYaxis()->GetBinCenter(fTableNR);
+      fTableNCos=tHist->GetNbinsZ();
+      tFirst=false;
+    } else if (tHist->GetNbinsX()!=fTableNK || tHist->GetNbinsY()!=fTableNR || tHist->GetNbinsZ()!=fTableNCos) {
+      continue;
+    }
+    std::vector<float> &tTable=fTables[ll];
+    tTable.resize(fTableNK*fTableNR*fTableNCos);
+    int tIndex=0;
+    for (int ik=0; ik<fTableNK; ik++)
+      for (int ir=0; ir<fTableNR; ir++)
+        for (int ic=0; ic<fTableNCos; ic++)
+          tTable[tIndex++]=tHist->GetBinContent(ik+1,ir+1,ic+1);
+    fTableState[ll]=1;
+  }
+  tFile->Close();
+  delete tFile;
+  return true;
+}
 
 Double_t AliFemtoModelWeightGeneratorLednicky::GetKStar() const {return AliFemtoModelWeightGenerator::GetKStar();}
 Double_t AliFemtoModelWeightGeneratorLednicky::GetKStarOut() const { return AliFemtoModelWeightGenerator::GetKStarOut(); }
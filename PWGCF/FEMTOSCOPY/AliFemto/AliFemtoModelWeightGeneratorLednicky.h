@@ -11,6 +11,8 @@
 #ifndef ALIFEMTOMODELWEIGHTGENERATORLEDNICKY_H
 #define ALIFEMTOMODELWEIGHTGENERATORLEDNICKY_H
 
+#include <vector>
+
 #include "AliFemtoTypes.h"
 #include "AliFemtoModelWeightGenerator.h"
 
@@ -66,6 +68,23 @@ class AliFemtoModelWeightGeneratorLednicky : public  AliFemtoModelWeightGenerato
 
   void SetKpKmModelType(const int aModelType, const int aPhi_OffOn);  // K+K- model type,Phi off/on
 
+// >>> Tabulated mode
+// The weight is interpolated in a table of k*, r* and cos(k*,r*) in the
+// pair rest frame, filled once per pair type with the exact calculation.
+// Only used for equal time calculations without 3-body effects (no
+// t* dependence): square well pairs or SetT0ApproxOn(). Pairs outside
+// the table fall back to the exact calculation.
+  void SetTabulatedOn();
+  void SetTabulatedOff();
+  void SetTableKStarRange(const int aNPoints, const double aKStarMin, const double aKStarMax); // GeV/c
+  void SetTableRStarRange(const int aNPoints, const double aRStarMin, const double aRStarMax); // fm
+  void SetTableCosThetaPoints(const int aNPoints);
+
+  bool   BuildTable(const int aPid1, const int aPid2);   // otherwise built at the first pair of the type
+  double CheckTable(const int aPid1, const int aPid2, const int aNPoints=10000); // max deviation from the exact weight
+  bool   SaveTables(const char *aFileName) const;
+  bool   LoadTables(const char *aFileName);
+
   virtual AliFemtoString Report();
 
 protected:
@@ -103,15 +122,37 @@ protected:
   int       fPhi_OffOn;      //0->Phi Off,1->Phi On
   int       fNS_4;           //set NS is equal to 4
 
+  // Tabulated weights
+  bool      fTabulated;      // interpolate the weight in the tables
+  int       fTableNK;        // number of k* points
+  double    fTableKMin;      // first k* point
+  double    fTableKMax;      // last k* point
+  int       fTableNR;        // number of r* points
+  double    fTableRMin;      // first r* point
+  double    fTableRMax;      // last r* point
+  int       fTableNCos;      // number of cos(theta) points in [-1,1]
+  std::vector<std::vector<float> > fTables; //! weight tables for each pair type, cos fastest
+  std::vector<int>  fTableState;            //! 0 - not built, 1 - built, -1 - not tabulable
+
+  bool   SetTablePid(const int aPid1, const int aPid2);
+  bool   TableWeight(double &aWeight);
+  bool   BuildTable();
+  void   ClearTables();
+  std::vector<double> TableSetup() const;
+  double ExactWeight(const double aKStar, const double aRStar, const double aCosTheta);
+  double InterpolateWeight(const std::vector<float> &aTable, const double aKStar,
+                           const double aRStar, const double aCosTheta) const;
+
   // Interface to the fortran functions
   void FsiSetKpKmModelType();  //// initialize K+K- model type
   void FsiInit();
   void FsiSetLL();
   void FsiNucl();
+  int  FsiNS() const;
   bool SetPid(const int aPid1,const int aPid2);
 
 #ifdef __ROOT__
-  ClassDef(AliFemtoModelWeightGeneratorLednicky,1)
+  ClassDef(AliFemtoModelWeightGeneratorLednicky,2)
 #endif
 };
 
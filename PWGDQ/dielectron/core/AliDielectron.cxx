@@ -69,6 +69,7 @@ The names are available via the function PairClassName(Int_t i)
 #include "AliDielectronMixingHandler.h"
 #include "AliDielectronPairLegCuts.h"
 #include "AliDielectronV0Cuts.h"
+#include "AliDielectronVarCuts.h"
 #include "AliDielectronPID.h"
 #include "AliDielectronHistos.h"
 
@@ -134,6 +135,9 @@ AliDielectron::AliDielectron() :
   fHistos(0x0),
   fUsedVars(new TBits(AliDielectronVarManager::kNMaxValues)),
   fPairCandidates(new TObjArray(11)),
+  fPairPool(new TObjArray),
+  fPairCutVars(new TBits(AliDielectronVarManager::kNMaxValues)),
+  fPairCutsOnValues(kFALSE),
   fCfManagerPair(0x0),
   fTrackRotator(0x0),
   fRotatePP(kFALSE),
@@ -211,6 +215,9 @@ AliDielectron::AliDielectron(const char* name, const char* title) :
   fHistos(0x0),
   fUsedVars(new TBits(AliDielectronVarManager::kNMaxValues)),
   fPairCandidates(new TObjArray(11)),
+  fPairPool(new TObjArray),
+  fPairCutVars(new TBits(AliDielectronVarManager::kNMaxValues)),
+  fPairCutsOnValues(kFALSE),
   fCfManagerPair(0x0),
   fTrackRotator(0x0),
   fRotatePP(kFALSE),
@@ -270,6 +277,11 @@ AliDielectron::~AliDielectron()
   if (fHistos) delete fHistos;
   if (fUsedVars) delete fUsedVars;
   if (fPairCandidates && fEventProcess) delete fPairCandidates;
+  if (fPairPool) {
+    fPairPool->Delete();
+    delete fPairPool;
+  }
+  if (fPairCutVars) delete fPairCutVars;
   if (fDebugTree) delete fDebugTree;
   if (fMixing) delete fMixing;
   if (fEvtVsTrkHist) delete fEvtVsTrkHist;
@@ -331,6 +343,8 @@ void AliDielectron::Init()
     fPairFilter.AddCuts(trk2leg);
   }
 
+  InitPairCutVars();
+
   if (fCutQA) {
     fQAmonitor = new AliDielectronCutQA(Form("QAcuts_%s",GetName()),"QAcuts");
     fQAmonitor->AddTrackFilter(&fTrackFilter);
@@ -1415,8 +1429,7 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
   Int_t ntrack1=arrTracks1.GetEntriesFast();
   Int_t ntrack2=arrTracks2.GetEntriesFast();
 
-  AliDielectronPair *candidate=new AliDielectronPair;
-  candidate->SetKFUsage(fUseKF);
+  AliDielectronPair *candidate=NewPairCandidate();
 
   UInt_t selectedMask=(1<<fPairFilter.GetCuts()->GetEntries())-1;
 
@@ -1443,7 +1456,7 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
       }
 
       //pair cuts
-      UInt_t cutMask=fPairFilter.IsSelected(candidate);
+      UInt_t cutMask=fPairCutsOnValues ? PairCutMask(candidate) : fPairFilter.IsSelected(candidate);
 
       //CF manager for the pair
       if (fCfManagerPair) fCfManagerPair->Fill(cutMask,candidate);
@@ -1463,12 +1476,93 @@ void AliDielectron::FillPairArrays(Int_t arr1, Int_t arr2, const AliVEvent *ev)
       //add the candidate to the candidate array
       PairArray(pairIndex)->Add(candidate);
       //get a new candidate
-      candidate=new AliDielectronPair;
-      candidate->SetKFUsage(fUseKF);
+      candidate=NewPairCandidate();
+    }
+  }
+  //keep the surplus candidate for the next call
+  fPairPool->Add(candidate);
+}
+
+//________________________________________________________________
+AliDielectronPair* AliDielectron::NewPairCandidate()
+{
+  //
+  // get a pair candidate from the pool of pairs of the previous events,
+  // allocate a new one only if the pool is empty
+  //
+  AliDielectronPair *pair=0x0;
+  Int_t npool=fPairPool->GetEntriesFast();
+  if (npool>0) pair=static_cast<AliDielectronPair*>(fPairPool->RemoveAt(npool-1));
+  else pair=new AliDielectronPair;
+  pair->SetKFUsage(fUseKF);
+  return pair;
+}
+
+//________________________________________________________________
+void AliDielectron::InitPairCutVars()
+{
+  //
+  // Collect the variables requested by the pair cuts.
+  // If all the pair cuts are plain variable cuts, the pair variables are
+  // filled only once per candidate and all cuts are evaluated on them
+  // (see PairCutMask), instead of one full fill per cut object
+  //
+  fPairCutVars->ResetAllBits();
+  fPairCutsOnValues=kTRUE;
+
+  TIter nextCut(fPairFilter.GetCuts());
+  while (AliAnalysisCuts *cut=static_cast<AliAnalysisCuts*>(nextCut())) {
+    if (cut->IsA()!=AliDielectronVarCuts::Class() || cut->GetFilterMask()>0 ||
+        static_cast<AliDielectronVarCuts*>(cut)->GetCutOnMCtruth()) {
+      fPairCutsOnValues=kFALSE;
+      break;
+    }
+    (*fPairCutVars)|=(*static_cast<AliDielectronVarCuts*>(cut)->GetUsedVars());
+  }
+}
+
+//________________________________________________________________
+UInt_t AliDielectron::PairCutMask(AliDielectronPair *pair)
+{
+  //
+  // same decision as fPairFilter.IsSelected(pair), but with a single
+  // fill of the variables needed by all pair cuts
+  //
+  Double_t values[AliDielectronVarManager::kNMaxValues];
+  AliDielectronVarManager::SetFillMap(fPairCutVars);
+  AliDielectronVarManager::Fill(pair, values);
+
+  UInt_t cutMask=0;
+  Int_t iCut=0;
+  TIter nextCut(fPairFilter.GetCuts());
+  while (AliDielectronVarCuts *cut=static_cast<AliDielectronVarCuts*>(nextCut())) {
+    if (cut->IsSelected(values)) SETBIT(cutMask,iCut);
+    ++iCut;
+  }
+  return cutMask;
+}
+
+//________________________________________________________________
+void AliDielectron::ClearArrays()
+{
+  //
+  // Reset the Arrays
+  // the pair candidates are kept in the pool and reused in the next event
+  //
+  for (Int_t i=0;i<4;++i){
+    fTracks[i].Clear();
+  }
+  for (Int_t i=0;i<11;++i){
+    TObjArray *arr=PairArray(i);
+    if (!arr) continue;
+    Int_t npairs=arr->GetEntriesFast();
+    for (Int_t ipair=0; ipair<npairs; ++ipair){
+      TObject *obj=arr->UncheckedAt(ipair);
+      if (obj && obj->IsA()==AliDielectronPair::Class()) fPairPool->Add(obj);
+      else delete obj;
     }
+    arr->Clear();
   }
-  //delete the surplus candidate
-  delete candidate;
 }
 
 //________________________________________________________________
@@ -244,6 +244,9 @@ private:
 
   TObjArray *fPairCandidates;     //! Pair candidate arrays
                                   //TODO: better way to store it? TClonesArray?
+  TObjArray *fPairPool;           //! Pair candidates recycled from previous events
+  TBits *fPairCutVars;            //! variables needed by the pair cuts
+  Bool_t fPairCutsOnValues;       //! all pair cuts are variable cuts, evaluated on one fill per candidate
 
   AliDielectronCF *fCfManagerPair;//Correction Framework Manager for the Pair
   AliDielectronTrackRotator *fTrackRotator; //Track rotator
@@ -283,8 +286,12 @@ private:
   Int_t GetPairIndex(Int_t arr1, Int_t arr2) const {return arr1>=arr2?arr1*(arr1+1)/2+arr2:arr2*(arr2+1)/2+arr1;}
 
   void InitPairCandidateArrays();
+  void InitPairCutVars();
   void ClearArrays();
 
+  AliDielectronPair* NewPairCandidate();
+  UInt_t PairCutMask(AliDielectronPair *pair);
+
   TObjArray* PairArray(Int_t i);
   TObject* InitEffMap(TString filename, TString generatedname, TString foundname);
 
@@ -312,7 +319,7 @@ private:
   AliDielectron(const AliDielectron &c);
   AliDielectron &operator=(const AliDielectron &c);
 
-  ClassDef(AliDielectron,17);
+  ClassDef(AliDielectron,18);
 };
 
 inline void AliDielectron::InitPairCandidateArrays()
@@ -336,17 +343,4 @@ inline TObjArray* AliDielectron::PairArray(Int_t i)
   return static_cast<TObjArray*>(fPairCandidates->UncheckedAt(i));
 }
 
-inline void AliDielectron::ClearArrays()
-{
-  //
-  // Reset the Arrays
-  //
-  for (Int_t i=0;i<4;++i){
-    fTracks[i].Clear();
-  }
-  for (Int_t i=0;i<11;++i){
-    if (PairArray(i)) PairArray(i)->Delete();
-  }
-}
-
 #endif
@@ -36,6 +36,7 @@
 #include <AliESDtrack.h>
 #include <AliAODTrack.h>
 #include <AliLog.h>
+#include <AliMCGenealogyIndex.h>
 
 #include <AliGenCocktailEventHeader.h>
 #include <AliGenHijingEventHeader.h>
@@ -366,9 +367,11 @@ Int_t AliDielectronMC::GetMotherPDG( const AliESDtrack* _track)
   //
   // return PDG code of the mother track from the MC truth info
   //
-  AliMCParticle* mcmother = GetMCTrackMother(_track);
-  if (!mcmother) return -999;
-  return mcmother->PdgCode();
+  AliMCGenealogyIndex *genealogy = GetGenealogyIndex();
+  if (!genealogy) return -999;
+  Int_t labelMother = genealogy->GetMother(TMath::Abs(_track->GetLabel()));
+  if (labelMother<0) return -999;
+  return genealogy->GetPdgCode(labelMother);
 }
 
 //________________________________________________________
@@ -377,9 +380,11 @@ Int_t AliDielectronMC::GetMotherPDG( const AliAODTrack* _track)
   //
   // return PDG code of the mother track from the MC truth info
   //
-  AliAODMCParticle* mcmother = GetMCTrackMother(_track);
-  if (!mcmother) return -999;
-  return mcmother->PdgCode();
+  AliMCGenealogyIndex *genealogy = GetGenealogyIndex();
+  if (!genealogy) return -999;
+  Int_t labelMother = genealogy->GetMother(TMath::Abs(_track->GetLabel()));
+  if (labelMother<0) return -999;
+  return genealogy->GetPdgCode(labelMother);
 }
 
 //________________________________________________________
@@ -388,9 +393,11 @@ Int_t AliDielectronMC::GetMotherPDG( const AliMCParticle* _track)
   //
   // return PDG code of the mother track from the MC truth info
   //
-  AliMCParticle* mcmother = GetMCTrackMother(_track);
-  if (!mcmother) return -999;
-  return mcmother->PdgCode();
+  AliMCGenealogyIndex *genealogy = GetGenealogyIndex();
+  if (!genealogy) return -999;
+  Int_t labelMother = genealogy->GetMother(_track->GetLabel());
+  if (labelMother<0) return -999;
+  return genealogy->GetPdgCode(labelMother);
 }
 
 //________________________________________________________
@@ -399,9 +406,11 @@ Int_t AliDielectronMC::GetMotherPDG( const AliAODMCParticle* _track)
   //
   // return PDG code of the mother track from the MC truth info
   //
-  AliAODMCParticle* mcmother = GetMCTrackMother(_track);
-  if (!mcmother) return -999;
-  return mcmother->PdgCode();
+  AliMCGenealogyIndex *genealogy = GetGenealogyIndex();
+  if (!genealogy) return -999;
+  Int_t labelMother = genealogy->GetMother(_track->GetLabel());
+  if (labelMother<0) return -999;
+  return genealogy->GetPdgCode(labelMother);
 }
 
 //____________________________________________________________
@@ -695,6 +704,24 @@ void AliDielectronMC::GetDaughters(const TObject *mother, AliVParticle* &d1, Ali
 }
 
 
+//________________________________________________________________________________
+AliMCGenealogyIndex* AliDielectronMC::GetGenealogyIndex() const {
+  //
+  //  Shared index of the MC genealogy, attached to the MC particles of the current event.
+  //  Mother labels, PDG codes and primary/secondary flags are then looked up only once
+  //  per event, whatever the number of signals and legs checked.
+  //
+  AliMCGenealogyIndex *genealogy = AliMCGenealogyIndex::Instance();
+  if (fAnaType==kAOD) {
+    if (!fMcArray) return 0x0;
+    genealogy->Update(fMcArray);
+  } else if (fAnaType==kESD) {
+    if (!fMCEvent) return 0x0;
+    genealogy->Update(fMCEvent);
+  } else return 0x0;
+  return genealogy;
+}
+
 //________________________________________________________________________________
 Int_t AliDielectronMC::GetMothersLabel(Int_t daughterLabel) const {
   //
@@ -702,16 +729,9 @@ Int_t AliDielectronMC::GetMothersLabel(Int_t daughterLabel) const {
   //  NOTE: for tracks, the absolute label should be passed
   //
   if(daughterLabel<0) return -1;
-  if (fAnaType==kAOD) {
-    if(!fMcArray) return -1;
-    if(GetMCTrackFromMCEvent(daughterLabel))
-      return (static_cast<AliAODMCParticle*>(GetMCTrackFromMCEvent(daughterLabel)))->GetMother();
-  } else if(fAnaType==kESD) {
-    if (!fMCEvent) return -1;
-    if(GetMCTrackFromMCEvent(daughterLabel))
-      return (static_cast<AliMCParticle*>(GetMCTrackFromMCEvent(daughterLabel)))->GetMother();
-  }
-  return -1;
+  AliMCGenealogyIndex *genealogy = GetGenealogyIndex();
+  if (!genealogy) return -1;
+  return genealogy->GetMother(daughterLabel);
 }
 
 
@@ -1007,14 +1027,9 @@ Bool_t AliDielectronMC::IsPhysicalPrimary(Int_t label) const {
   // 6.) includes products of directly produced beauty hadron decays
   //
   if(label<0) return kFALSE;
-  if(fAnaType==kAOD) {
-    if(!fMcArray) return kFALSE;
-    return (static_cast<AliAODMCParticle*>(GetMCTrackFromMCEvent(label)))->IsPhysicalPrimary();
-  } else if(fAnaType==kESD) {
-    if (!fMCEvent) return kFALSE;
-    return fMCEvent->IsPhysicalPrimary(label);
-  }
-  return kFALSE;
+  AliMCGenealogyIndex *genealogy = GetGenealogyIndex();
+  if (!genealogy) return kFALSE;
+  return genealogy->IsPhysicalPrimary(label);
 }
 
 //________________________________________________________________________________
@@ -1055,14 +1070,9 @@ Bool_t AliDielectronMC::IsSecondaryFromWeakDecay(Int_t label) const {
   // definition in AliStack::IsSecondaryFromWeakDecay(Int_t label)
   //
   if(label<0) return kFALSE;
-  if(fAnaType==kAOD) {
-    if(!fMcArray) return kFALSE;
-    return (static_cast<AliAODMCParticle*>(GetMCTrackFromMCEvent(label)))->IsSecondaryFromWeakDecay();
-  } else if(fAnaType==kESD) {
-    if (!fMCEvent) return kFALSE;
-    return fMCEvent->IsSecondaryFromWeakDecay(label);
-  }
-  return kFALSE;
+  AliMCGenealogyIndex *genealogy = GetGenealogyIndex();
+  if (!genealogy) return kFALSE;
+  return genealogy->IsSecondaryFromWeakDecay(label);
 }
 
 //________________________________________________________________________________
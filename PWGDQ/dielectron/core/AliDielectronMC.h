@@ -25,6 +25,7 @@ class TParticle;
 class AliMCParticle;
 class AliAODMCParticle;
 class AliAODMCHeader;
+class AliMCGenealogyIndex;
 
 #include "AliDielectronSignalMC.h"
 #include "AliDielectronPair.h"
@@ -132,6 +133,8 @@ private:
   AliDielectronMC(const AliDielectronMC &c);
   AliDielectronMC &operator=(const AliDielectronMC &c);
 
+  AliMCGenealogyIndex* GetGenealogyIndex() const;
+
   Bool_t IsMCMotherToEEesd(const AliMCParticle *particle, Int_t pdgMother);
   Bool_t IsMCMotherToEEaod(const AliAODMCParticle *particle, Int_t pdgMother);
 
@@ -59,12 +59,14 @@ public:
   CutType GetCutType()      const { return fCutType;      }
 
   Int_t GetNCuts() { return fNActiveCuts; }
+  TBits*  GetUsedVars()     const { return fUsedVars;     }
 
   //
   //Analysis cuts interface
   //
   virtual Bool_t IsSelected(TObject* track);
   virtual Bool_t IsSelected(TList*   /* list */ ) {return kFALSE;}
+  Bool_t IsSelected(const Double_t * const values);
 
 //   virtual Bool_t IsSelected(TObject* track, TObject */*event*/=0);
 //   virtual Long64_t Merge(TCollection* /* list */)      { return 0; }
@@ -652,47 +652,142 @@ const char* AliDielectronVarManager::fgkParticleNames[AliDielectronVarManager::k
   {"LegSource",              "Leg source",                                         ""}
 };
 
-AliPIDResponse* AliDielectronVarManager::fgPIDResponse      = 0x0;
-AliVEvent*      AliDielectronVarManager::fgEvent            = 0x0;
-AliEventplane*  AliDielectronVarManager::fgTPCEventPlane    = 0x0;
-AliKFVertex*    AliDielectronVarManager::fgKFVertex         = 0x0;
-TProfile*       AliDielectronVarManager::fgMultEstimatorAvg[7][9] = {{0x0}};
-TH3D*           AliDielectronVarManager::fgTRDpidEff[10][4] = {{0x0}};
-TObject*        AliDielectronVarManager::fgLegEffMap           = 0x0;
-TObject*        AliDielectronVarManager::fgPairEffMap          = 0x0;
-TBits*          AliDielectronVarManager::fgFillMap          = 0x0;
-Double_t        AliDielectronVarManager::fgTRDpidEffCentRanges[10][4] = {{0.0}};
-TString         AliDielectronVarManager::fgVZEROCalibrationFile = "";
-TString         AliDielectronVarManager::fgVZERORecenteringFile = "";
-TString         AliDielectronVarManager::fgZDCRecenteringFile = "";
-TProfile2D*     AliDielectronVarManager::fgVZEROCalib[64] = {0x0};
-TProfile2D*     AliDielectronVarManager::fgVZERORecentering[2][2] = {{0x0,0x0},{0x0,0x0}};
-TProfile3D*     AliDielectronVarManager::fgZDCRecentering[3][2] = {{0x0,0x0},{0x0,0x0},{0x0,0x0}};
-AliDielectronQnEPcorrection* AliDielectronVarManager::fgQnEPacRemoval = 0x0;
-Bool_t          AliDielectronVarManager::fgEventPlaneACremoval = kFALSE;
-TString         AliDielectronVarManager::fgQnVectorNorm = "";
-Int_t           AliDielectronVarManager::fgCurrentRun = -1;
-Double_t        AliDielectronVarManager::fgData[AliDielectronVarManager::kNMaxValues] = {0.};
+AliDielectronVarManager::Context AliDielectronVarManager::fgDefaultContext;
+#if !defined(__CINT__)
+// context installed by SetContext in the calling thread (0x0: default context)
+static thread_local AliDielectronVarManager::Context *gDielectronVarManagerContext = 0x0;
+#endif
+
 //________________________________________________________________
-AliDielectronVarManager::AliDielectronVarManager() :
-  TNamed("AliDielectronVarManager","AliDielectronVarManager")
+AliDielectronVarManager::Context::Context() :
+  fPIDResponse(0x0),
+  fEvent(0x0),
+  fTPCEventPlane(0x0),
+  fKFVertex(0x0),
+  fLegEffMap(0x0),
+  fPairEffMap(0x0),
+  fFillMap(0x0),
+  fQnEPacRemoval(0x0),
+  fEventPlaneACremoval(kFALSE),
+  fQnVectorNorm(""),
+  fVZEROCalibrationFile(""),
+  fVZERORecenteringFile(""),
+  fZDCRecenteringFile(""),
+  fCurrentRun(-1)
 {
   //
   // Default constructor
   //
-  for(Int_t i=0; i<6; ++i)
-    for(Int_t j=0; j<9; ++j)
-      fgMultEstimatorAvg[i][j] = 0x0;
-  for(Int_t i=0; i<10; ++i)
-    for(Int_t j=0; j<4; ++j)
-      fgTRDpidEff[i][j] = 0x0;
-  for(Int_t i=0; i<64; ++i) fgVZEROCalib[i] = 0x0;
-  for(Int_t i=0; i<2; ++i) {
-    for(Int_t j=0; j<2; ++j) fgVZERORecentering[i][j] = 0x0;
+  for (Int_t i=0; i<kNMaxValues; ++i) fData[i]=0.;
+  for (Int_t i=0; i<7; ++i)
+    for (Int_t j=0; j<9; ++j) fMultEstimatorAvg[i][j]=0x0;
+  for (Int_t i=0; i<10; ++i) {
+    for (Int_t j=0; j<4; ++j) {
+      fTRDpidEffCentRanges[i][j]=0.;
+      fTRDpidEff[i][j]=0x0;
+    }
   }
-  for(Int_t i=0; i<3; ++i)
-    for(Int_t j=0; j<2; ++j) fgZDCRecentering[i][j] = 0x0;
+  for (Int_t i=0; i<64; ++i) fVZEROCalib[i]=0x0;
+  for (Int_t i=0; i<2; ++i)
+    for (Int_t j=0; j<2; ++j) fVZERORecentering[i][j]=0x0;
+  for (Int_t i=0; i<3; ++i)
+    for (Int_t j=0; j<2; ++j) fZDCRecentering[i][j]=0x0;
+}
 
+//________________________________________________________________
+AliDielectronVarManager::Context::Context(const Context &c) :
+  fPIDResponse(c.fPIDResponse),
+  fEvent(0x0),
+  fTPCEventPlane(0x0),
+  fKFVertex(0x0),
+  fLegEffMap(c.fLegEffMap),
+  fPairEffMap(c.fPairEffMap),
+  fFillMap(c.fFillMap),
+  fQnEPacRemoval(c.fQnEPacRemoval),
+  fEventPlaneACremoval(c.fEventPlaneACremoval),
+  fQnVectorNorm(c.fQnVectorNorm),
+  fVZEROCalibrationFile(c.fVZEROCalibrationFile),
+  fVZERORecenteringFile(c.fVZERORecenteringFile),
+  fZDCRecenteringFile(c.fZDCRecenteringFile),
+  fCurrentRun(-1)
+{
+  //
+  // Copy the configuration (PID response, efficiency maps, fill map, Qn settings)
+  // and clones of the estimator averages and TRD pid efficiencies.
+  // The event related information is not copied, the run-wise VZERO/ZDC
+  // calibrations are loaded again from the files at the first event.
+  //
+  for (Int_t i=0; i<kNMaxValues; ++i) fData[i]=0.;
+  for (Int_t i=0; i<7; ++i) {
+    for (Int_t j=0; j<9; ++j) {
+      fMultEstimatorAvg[i][j]=0x0;
+      if (!c.fMultEstimatorAvg[i][j]) continue;
+      fMultEstimatorAvg[i][j]=static_cast<TProfile*>(c.fMultEstimatorAvg[i][j]->Clone());
+      fMultEstimatorAvg[i][j]->SetDirectory(0x0);
+    }
+  }
+  for (Int_t i=0; i<10; ++i) {
+    for (Int_t j=0; j<4; ++j) {
+      fTRDpidEffCentRanges[i][j]=c.fTRDpidEffCentRanges[i][j];
+      fTRDpidEff[i][j]=0x0;
+      if (!c.fTRDpidEff[i][j]) continue;
+      fTRDpidEff[i][j]=static_cast<TH3D*>(c.fTRDpidEff[i][j]->Clone());
+      fTRDpidEff[i][j]->SetDirectory(0x0);
+    }
+  }
+  for (Int_t i=0; i<64; ++i) fVZEROCalib[i]=0x0;
+  for (Int_t i=0; i<2; ++i)
+    for (Int_t j=0; j<2; ++j) fVZERORecentering[i][j]=0x0;
+  for (Int_t i=0; i<3; ++i)
+    for (Int_t j=0; j<2; ++j) fZDCRecentering[i][j]=0x0;
+}
+
+//________________________________________________________________
+AliDielectronVarManager::Context::~Context()
+{
+  //
+  // Default destructor
+  //
+  if (fKFVertex) delete fKFVertex;
+  for (Int_t i=0; i<7; ++i)
+    for (Int_t j=0; j<9; ++j) delete fMultEstimatorAvg[i][j];
+  for (Int_t i=0; i<10; ++i)
+    for (Int_t j=0; j<4; ++j) delete fTRDpidEff[i][j];
+  for (Int_t i=0; i<64; ++i) delete fVZEROCalib[i];
+  for (Int_t i=0; i<2; ++i)
+    for (Int_t j=0; j<2; ++j) delete fVZERORecentering[i][j];
+  for (Int_t i=0; i<3; ++i)
+    for (Int_t j=0; j<2; ++j) delete fZDCRecentering[i][j];
+}
+
+//________________________________________________________________
+AliDielectronVarManager::Context* AliDielectronVarManager::GetContext()
+{
+  //
+  // Context of the calling thread
+  //
+  return (gDielectronVarManagerContext ? gDielectronVarManagerContext : &fgDefaultContext);
+}
+
+//________________________________________________________________
+AliDielectronVarManager::Context* AliDielectronVarManager::SetContext(Context *ctx)
+{
+  //
+  // Install ctx as context of the calling thread (0x0: default context),
+  // returns the previous one
+  //
+  Context *old=GetContext();
+  gDielectronVarManagerContext=(ctx==&fgDefaultContext ? 0x0 : ctx);
+  return old;
+}
+
+//________________________________________________________________
+AliDielectronVarManager::AliDielectronVarManager() :
+  TNamed("AliDielectronVarManager","AliDielectronVarManager")
+{
+  //
+  // Default constructor
+  //
   gRandom->SetSeed();
 }
 
@@ -703,20 +798,6 @@ AliDielectronVarManager::AliDielectronVarManager(const char* name, const char* t
   //
   // Named constructor
   //
-  for(Int_t i=0; i<6; ++i)
-    for(Int_t j=0; j<9; ++j)
-      fgMultEstimatorAvg[i][j] = 0x0;
-  for(Int_t i=0; i<10; ++i)
-    for(Int_t j=0; j<4; ++j)
-      fgTRDpidEff[i][j] = 0x0;
-  for(Int_t i=0; i<64; ++i) fgVZEROCalib[i] = 0x0;
-  for(Int_t i=0; i<2; ++i)
-    for(Int_t j=0; j<2; ++j)
-      fgVZERORecentering[i][j] = 0x0;
-  for(Int_t i=0; i<3; ++i)
-    for(Int_t j=0; j<2; ++j) fgZDCRecentering[i][j] = 0x0;
-
-
   gRandom->SetSeed();
 }
 
@@ -726,21 +807,6 @@ AliDielectronVarManager::~AliDielectronVarManager()
   //
   // Default destructor
   //
-  for(Int_t i=0; i<6; ++i)
-    for(Int_t j=0; j<9; ++j)
-      if(fgMultEstimatorAvg[i][j]) delete fgMultEstimatorAvg[i][j];
-  for(Int_t i=0; i<10; ++i)
-    for(Int_t j=0; j<4; ++j)
-      if(fgTRDpidEff[i][j]) delete fgTRDpidEff[i][j];
-  for(Int_t i=0; i<64; ++i)
-    if(fgVZEROCalib[i]) delete fgVZEROCalib[i];
-  for(Int_t i=0; i<2; ++i)
-    for(Int_t j=0; j<2; ++j)
-      if(fgVZERORecentering[i][j]) delete fgVZERORecentering[i][j];
-  for(Int_t i=0; i<3; ++i)
-    for(Int_t j=0; j<2; ++j)
-      if(fgZDCRecentering[i][j]) delete fgZDCRecentering[i][j];
-
 }
 
 //________________________________________________________________
@@ -686,6 +686,48 @@ public:
   };
 
 
+  //
+  // State of the variable manager: current event, fill map, PID response,
+  // efficiency maps, event data and the calibration tables (estimator averages,
+  // TRD pid efficiencies, VZERO/ZDC calibrations) with the run they belong to.
+  // The static interface works on the context of the calling thread (the default
+  // one unless SetContext is called), so that several dielectron instances or
+  // worker threads can each own one. The Fill functions look the context up once
+  // per call.
+  //
+  class Context {
+  public:
+    Context();
+    Context(const Context &c);
+    ~Context();
+
+    AliPIDResponse  *fPIDResponse;        // PID response object
+    AliVEvent       *fEvent;              // current event pointer
+    AliEventplane   *fTPCEventPlane;      // current event tpc plane pointer
+    AliKFVertex     *fKFVertex;           // kf vertex (owned)
+    TObject         *fLegEffMap;          // single electron efficiencies
+    TObject         *fPairEffMap;         // pair efficiencies
+    TBits           *fFillMap;            // map for requested variable filling
+    AliDielectronQnEPcorrection *fQnEPacRemoval; // filter for auto correlation removal within Qn Framework
+    Bool_t           fEventPlaneACremoval;
+    TString          fQnVectorNorm;       // normalisation for the QnVector if the non-default AddTask is used
+    Double_t         fData[kNMaxValues];  // event data
+
+    TProfile        *fMultEstimatorAvg[7][9];       // multiplicity estimator averages (7 periods x 18 estimators, owned)
+    Double_t         fTRDpidEffCentRanges[10][4];   // centrality ranges for the TRD pid efficiency histograms
+    TH3D            *fTRDpidEff[10][4];             // TRD pid efficiencies from conversion electrons (owned)
+    TString          fVZEROCalibrationFile;         // file with VZERO channel-by-channel calibrations
+    TString          fVZERORecenteringFile;         // file with VZERO Q-vector averages needed for event plane recentering
+    TString          fZDCRecenteringFile;           // file with ZDC Q-vector averages needed for event plane recentering
+    TProfile2D      *fVZEROCalib[64];               // 1 histogram per VZERO channel (owned)
+    TProfile2D      *fVZERORecentering[2][2];       // 2 VZERO sides x 2 Q-vector components (owned)
+    TProfile3D      *fZDCRecentering[3][2];         // 3 ZDC sides x 2 Q-vector components (owned)
+    Int_t            fCurrentRun;                   // run of the VZERO/ZDC calibrations
+
+  private:
+    Context &operator=(const Context &c);
+  };
+
   AliDielectronVarManager();
   AliDielectronVarManager(const char* name, const char* title);
   virtual ~AliDielectronVarManager();
@@ -698,47 +740,51 @@ public:
   static void InitEstimatorAvg(const Char_t* filename);
   static void InitEstimatorObjArrayAvg(const TObjArray* array);
   static void InitTRDpidEffHistograms(const Char_t* filename);
-  static void SetLegEffMap( TObject *map) { fgLegEffMap=map; }
-  static void SetPairEffMap(TObject *map) { fgPairEffMap=map; }
-  static void SetFillMap(   TBits   *map) { fgFillMap=map; }
-  static void SetVZEROCalibrationFile(const Char_t* filename) {fgVZEROCalibrationFile = filename;}
-
-  static void SetVZERORecenteringFile(const Char_t* filename) {fgVZERORecenteringFile = filename;}
-  static void SetZDCRecenteringFile(const Char_t* filename) {fgZDCRecenteringFile = filename;}
-  static void SetPIDResponse(AliPIDResponse *pidResponse) {fgPIDResponse=pidResponse;}
-  static AliPIDResponse* GetPIDResponse() { return fgPIDResponse; }
+  static void SetLegEffMap( TObject *map) { GetContext()->fLegEffMap=map; }
+  static void SetPairEffMap(TObject *map) { GetContext()->fPairEffMap=map; }
+  static void SetFillMap(   TBits   *map) { GetContext()->fFillMap=map; }
+  static void SetVZEROCalibrationFile(const Char_t* filename) {GetContext()->fVZEROCalibrationFile = filename;}
+
+  static void SetVZERORecenteringFile(const Char_t* filename) {GetContext()->fVZERORecenteringFile = filename;}
+  static void SetZDCRecenteringFile(const Char_t* filename) {GetContext()->fZDCRecenteringFile = filename;}
+  static void SetPIDResponse(AliPIDResponse *pidResponse) {GetContext()->fPIDResponse=pidResponse;}
+  static AliPIDResponse* GetPIDResponse() { return GetContext()->fPIDResponse; }
   static void SetEvent(AliVEvent * const ev);
   static void SetEventData(const Double_t data[AliDielectronVarManager::kNMaxValues]);
   static Bool_t GetDCA(const AliAODTrack *track, Double_t* d0z0, Double_t* covd0z0=0);
   static void SetTPCEventPlane(AliEventplane *const evplane);
-  static void SetTPCEventPlaneACremoval(AliDielectronQnEPcorrection *acCuts) {fgQnEPacRemoval = acCuts; fgEventPlaneACremoval = kTRUE;}
-  static void SetQnVectorNormalisation(TString qnNorm) {fgQnVectorNorm = qnNorm;}
+  static void SetTPCEventPlaneACremoval(AliDielectronQnEPcorrection *acCuts) {GetContext()->fQnEPacRemoval = acCuts; GetContext()->fEventPlaneACremoval = kTRUE;}
+  static void SetQnVectorNormalisation(TString qnNorm) {GetContext()->fQnVectorNorm = qnNorm;}
   static void GetVzeroRP(const AliVEvent* event, Double_t* qvec, Int_t sideOption);      // 0- V0A; 1- V0C; 2- V0A+V0C
   static void GetZDCRP(const AliVEvent* event, Double_t qvec[][2]);
   static AliAODVertex* GetVertex(const AliAODEvent *event, AliAODVertex::AODVtx_t vtype);
-  static TProfile* GetEstimatorHistogram(Int_t period, Int_t type) {return fgMultEstimatorAvg[period][type];}
+  static TProfile* GetEstimatorHistogram(Int_t period, Int_t type) {return GetContext()->fMultEstimatorAvg[period][type];}
   static Double_t GetTRDpidEfficiency(Int_t runNo, Double_t centrality, Double_t eta, Double_t trdPhi, Double_t pout, Double_t& effErr);
   static Double_t GetSingleLegEff(Double_t * const values);
   static Double_t GetPairEff(Double_t * const values);
 
-  static const AliKFVertex* GetKFVertex() {return fgKFVertex;}
+  static const AliKFVertex* GetKFVertex() {return GetContext()->fKFVertex;}
 
   static const char* GetValueName(Int_t i) { return (i>=0&&i<kNMaxValues)?fgkParticleNames[i][0]:""; }
   static const char* GetValueLabel(Int_t i) { return (i>=0&&i<kNMaxValues)?fgkParticleNames[i][1]:""; }
   static const char* GetValueUnit(Int_t i) { return (i>=0&&i<kNMaxValues)?fgkParticleNames[i][2]:""; }
   static UInt_t GetValueType(const char* valname);
-  static const Double_t* GetData() {return fgData;}
-  static AliVEvent* GetCurrentEvent() {return fgEvent;}
+  static const Double_t* GetData() {return GetContext()->fData;}
+  static AliVEvent* GetCurrentEvent() {return GetContext()->fEvent;}
 
-  static Double_t GetValue(ValueTypes var) {return fgData[var];}
-  static void SetValue(ValueTypes var, Double_t val) { fgData[var]=val; }
+  static Double_t GetValue(ValueTypes var) {return GetContext()->fData[var];}
+  static void SetValue(ValueTypes var, Double_t val) { GetContext()->fData[var]=val; }
+
+  static Context* GetDefaultContext() { return &fgDefaultContext; }
+  static Context* GetContext();
+  static Context* SetContext(Context *ctx);
 
 
 private:
 
   static const char* fgkParticleNames[kNMaxValues][3];  //variable names
 
-  static Bool_t Req(ValueTypes var) { return (fgFillMap ? fgFillMap->TestBitNumber(var) : kTRUE); }
+  static Bool_t Req(const Context *ctx, ValueTypes var) { return (ctx->fFillMap ? ctx->fFillMap->TestBitNumber(var) : kTRUE); }
   static void FillVarESDtrack(const AliESDtrack *particle,           Double_t * const values);
   static void FillVarAODTrack(const AliAODTrack *particle,           Double_t * const values);
   static void FillVarVTrdTrack(const AliVParticle *particle,         Double_t * const values);
@@ -758,34 +804,11 @@ private:
   static void InitVZERORecenteringHistograms(Int_t runNo);
   static void InitZDCRecenteringHistograms(Int_t runNo);
 
-  static AliPIDResponse  *fgPIDResponse;        // PID response object
-  static AliVEvent       *fgEvent;              // current event pointer
-  static AliEventplane   *fgTPCEventPlane;      // current event tpc plane pointer
-  static AliKFVertex     *fgKFVertex;           // kf vertex
-  static TProfile        *fgMultEstimatorAvg[7][9];  // multiplicity estimator averages (7 periods x 18 estimators)
-  static Double_t         fgTRDpidEffCentRanges[10][4];   // centrality ranges for the TRD pid efficiency histograms
-  static TH3D            *fgTRDpidEff[10][4];   // TRD pid efficiencies from conversion electrons
-  static TObject         *fgLegEffMap;             // single electron efficiencies
-  static TObject         *fgPairEffMap;             // pair efficiencies
-  static TBits           *fgFillMap;             // map for requested variable filling
-  static TString          fgVZEROCalibrationFile;  // file with VZERO channel-by-channel calibrations
-  static TString          fgVZERORecenteringFile;  // file with VZERO Q-vector averages needed for event plane recentering
-  static TProfile2D      *fgVZEROCalib[64];           // 1 histogram per VZERO channel
-  static TProfile2D      *fgVZERORecentering[2][2];   // 2 VZERO sides x 2 Q-vector components
-  static Int_t            fgCurrentRun;               // current run number
-
-  static TString          fgZDCRecenteringFile; // file with ZDC Q-vector averages needed for event plane recentering
-  static TProfile3D      *fgZDCRecentering[3][2];   // 2 VZERO sides x 2 Q-vector components
-
-  static AliDielectronQnEPcorrection *fgQnEPacRemoval; //! filter for auto correlation removal within Qn Framework
-  static Bool_t fgEventPlaneACremoval;
-  static TString fgQnVectorNorm;                       // String containing the normalisation for the QnVector if the non-default AddTask is used
-
-
   static Double_t CalculateEPDiff(Double_t detArp, Double_t detBrp);
 
+  static Context                 fgDefaultContext;  //! context used when none is set
+
 
-  static Double_t fgData[kNMaxValues];        //! data
 
   AliDielectronVarManager(const AliDielectronVarManager &c);
   AliDielectronVarManager &operator=(const AliDielectronVarManager &c);
@@ -823,6 +846,7 @@ inline void AliDielectronVarManager::FillVarVParticle(const AliVParticle *partic
   /// Fill track information available in AliVParticle into an array
   /// Also fill event information from local buffer into the array
   ///
+  Context *ctx = GetContext();
   values[AliDielectronVarManager::kPx]        = particle->Px();
   values[AliDielectronVarManager::kPy]        = particle->Py();
   values[AliDielectronVarManager::kPz]        = particle->Pz();
@@ -848,7 +872,7 @@ inline void AliDielectronVarManager::FillVarVParticle(const AliVParticle *partic
 
   values[AliDielectronVarManager::kRndm]      = gRandom->Rndm();
 
-  if(Req(kPtMC)||Req(kPMC)||Req(kPhiMC)||Req(kEtaMC)){
+  if(Req(ctx,kPtMC)||Req(ctx,kPMC)||Req(ctx,kPhiMC)||Req(ctx,kEtaMC)){
     values[AliDielectronVarManager::kPtMC]      = -999.;
     values[AliDielectronVarManager::kPMC]       = -999.;
     values[AliDielectronVarManager::kPhiMC]     = -999.;
@@ -864,9 +888,9 @@ inline void AliDielectronVarManager::FillVarVParticle(const AliVParticle *partic
     }
   }
 
-//   if ( fgEvent ) AliDielectronVarManager::Fill(fgEvent, values);
+//   if ( ctx->fEvent ) AliDielectronVarManager::Fill(ctx->fEvent, values);
   for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i)
-    values[i]=fgData[i];
+    values[i]=ctx->fData[i];
 }
 
 inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle, Double_t * const values)
@@ -874,6 +898,7 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   //
   // Fill track information available for histogramming into an array
   //
+  Context *ctx = GetContext();
 
   // Fill common AliVParticle interface information
   FillVarVParticle(particle, values);
@@ -985,7 +1010,7 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
     if (mc->GetMCTrack(particle)) {
       Int_t trkLbl = TMath::Abs(particle->GetLabel());
 
-      if (Req(kMCLegSource)){
+      if (Req(ctx,kMCLegSource)){
         values[AliDielectronVarManager::kMCLegSource] = 0;
         if (mc->CheckParticleSource(trkLbl, AliDielectronSignalMC::kPrimary)) values[AliDielectronVarManager::kMCLegSource] += 1;
         if (mc->CheckParticleSource(trkLbl, AliDielectronSignalMC::kFinalState)) values[AliDielectronVarManager::kMCLegSource] += 2;
@@ -995,16 +1020,16 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
         if (mc->CheckParticleSource(trkLbl, AliDielectronSignalMC::kSecondaryFromMaterial)) values[AliDielectronVarManager::kMCLegSource] +=32;
       }
 
-      if (Req(kPdgCode))           values[AliDielectronVarManager::kPdgCode]           =mc->GetMCTrack(particle)->PdgCode();
-      if (Req(kHasCocktailMother)) values[AliDielectronVarManager::kHasCocktailMother] =mc->CheckParticleSource(trkLbl, AliDielectronSignalMC::kDirect);
-      if (Req(kPdgCodeMother))     values[AliDielectronVarManager::kPdgCodeMother]     =mc->GetMotherPDG(particle);
-      if (Req(kPdgCodeGrandMother)){
+      if (Req(ctx,kPdgCode))           values[AliDielectronVarManager::kPdgCode]           =mc->GetMCTrack(particle)->PdgCode();
+      if (Req(ctx,kHasCocktailMother)) values[AliDielectronVarManager::kHasCocktailMother] =mc->CheckParticleSource(trkLbl, AliDielectronSignalMC::kDirect);
+      if (Req(ctx,kPdgCodeMother))     values[AliDielectronVarManager::kPdgCodeMother]     =mc->GetMotherPDG(particle);
+      if (Req(ctx,kPdgCodeGrandMother)){
         AliMCParticle *motherMC=mc->GetMCTrackMother(particle); //mother
         if(motherMC) values[AliDielectronVarManager::kPdgCodeGrandMother]=mc->GetMotherPDG(motherMC);
       }
       // Fill distance of primary vertex to secondary vertex (as an alternative to the IP)
       // Pure MC variable by intention, no reconstucted value filled.
-      if (Req(kDistPrimToSecVtxXYMC) || Req(kDistPrimToSecVtxZMC)) {
+      if (Req(ctx,kDistPrimToSecVtxXYMC) || Req(ctx,kDistPrimToSecVtxZMC)) {
         AliMCParticle *MCpart = mc->GetMCTrack(particle);
         values[AliDielectronVarManager::kDistPrimToSecVtxXYMC] = TMath::Sqrt(  TMath::Power(MCpart->Xv() - values[AliDielectronVarManager::kXvPrimMCtruth],2) + TMath::Power(MCpart->Yv() - values[AliDielectronVarManager::kYvPrimMCtruth],2));
         values[AliDielectronVarManager::kDistPrimToSecVtxZMC] = TMath::Abs(MCpart->Zv() - values[AliDielectronVarManager::kZvPrimMCtruth]);
@@ -1047,15 +1072,15 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   const AliExternalTrackParam *out=particle->GetOuterParam();
   if(out) values[AliDielectronVarManager::kPOut] = out->GetP();
   else values[AliDielectronVarManager::kPOut] = mom;
-  if(out && fgEvent) {
+  if(out && ctx->fEvent) {
     Double_t localCoord[3]={0.0};
-    Bool_t localCoordGood = out->GetXYZAt(298.0, ((AliESDEvent*)fgEvent)->GetMagneticField(), localCoord);
+    Bool_t localCoordGood = out->GetXYZAt(298.0, ((AliESDEvent*)ctx->fEvent)->GetMagneticField(), localCoord);
     values[AliDielectronVarManager::kTRDphi] = (localCoordGood && TMath::Abs(localCoord[0])>1.0e-6 && TMath::Abs(localCoord[1])>1.0e-6 ? TMath::ATan2(localCoord[1], localCoord[0]) : -999.);
   }
-  if(mc->HasMC() && fgTRDpidEff[0][0]) {
-    Int_t runNo = (fgEvent ? fgEvent->GetRunNumber() : -1);
+  if(mc->HasMC() && ctx->fTRDpidEff[0][0]) {
+    Int_t runNo = (ctx->fEvent ? ctx->fEvent->GetRunNumber() : -1);
     Float_t centrality=-1.0;
-    AliCentrality *esdCentrality = (fgEvent ? fgEvent->GetCentrality() : 0x0);
+    AliCentrality *esdCentrality = (ctx->fEvent ? ctx->fEvent->GetCentrality() : 0x0);
     if(esdCentrality) centrality = esdCentrality->GetCentralityPercentile("V0M");
     Double_t effErr=0.0;
     values[kTRDpidEffLeg] = GetTRDpidEfficiency(runNo, centrality, values[AliDielectronVarManager::kEta],
@@ -1073,7 +1098,7 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
 
   Double_t l = particle->GetIntegratedLength();  // cm
   Double_t t = particle->GetTOFsignal();
-  Double_t t0 = fgPIDResponse->GetTOFResponse().GetTimeZero(); // ps
+  Double_t t0 = ctx->fPIDResponse->GetTOFResponse().GetTimeZero(); // ps
 
   if( (l < 360. || l > 800.) || (t <= 0.) || (t0 >999990.0) ) {
 	values[AliDielectronVarManager::kTOFbeta]=0.0;
@@ -1089,41 +1114,41 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   }
   values[AliDielectronVarManager::kTOFPIDBit]=(particle->GetStatus()&AliESDtrack::kTOFpid? 1: 0);
 
-  values[AliDielectronVarManager::kTOFmismProb] = fgPIDResponse->GetTOFMismatchProbability(particle);
+  values[AliDielectronVarManager::kTOFmismProb] = ctx->fPIDResponse->GetTOFMismatchProbability(particle);
 
   // nsigma to Electron band
   // TODO: for the moment we set the bethe bloch parameters manually
   //       this should be changed in future!
-  values[AliDielectronVarManager::kTPCnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kTPCnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron) - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle)) / AliDielectronPID::GetWdthCorr(particle);
+  values[AliDielectronVarManager::kTPCnSigmaEleRaw]= ctx->fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron);
+  values[AliDielectronVarManager::kTPCnSigmaEle]   =(ctx->fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron) - AliDielectronPID::GetCorrVal() - AliDielectronPID::GetCntrdCorr(particle)) / AliDielectronPID::GetWdthCorr(particle);
 
-  values[AliDielectronVarManager::kTPCnSigmaPio]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kPion);
-  values[AliDielectronVarManager::kTPCnSigmaMuo]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kMuon);
-  values[AliDielectronVarManager::kTPCnSigmaKao]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kKaon);
-  values[AliDielectronVarManager::kTPCnSigmaPro]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kProton);
+  values[AliDielectronVarManager::kTPCnSigmaPio]=ctx->fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kPion);
+  values[AliDielectronVarManager::kTPCnSigmaMuo]=ctx->fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kMuon);
+  values[AliDielectronVarManager::kTPCnSigmaKao]=ctx->fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kKaon);
+  values[AliDielectronVarManager::kTPCnSigmaPro]=ctx->fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kProton);
 
-  values[AliDielectronVarManager::kITSnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kITSnSigmaEle]   =(fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron)
+  values[AliDielectronVarManager::kITSnSigmaEleRaw]= ctx->fPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron);
+  values[AliDielectronVarManager::kITSnSigmaEle]   =(ctx->fPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron)
                                                      -AliDielectronPID::GetCntrdCorrITS(particle)
                                                      ) / AliDielectronPID::GetWdthCorrITS(particle);
 
-  values[AliDielectronVarManager::kITSnSigmaPio]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kPion);
-  values[AliDielectronVarManager::kITSnSigmaMuo]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kMuon);
-  values[AliDielectronVarManager::kITSnSigmaKao]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kKaon);
-  values[AliDielectronVarManager::kITSnSigmaPro]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kProton);
+  values[AliDielectronVarManager::kITSnSigmaPio]=ctx->fPIDResponse->NumberOfSigmasITS(particle,AliPID::kPion);
+  values[AliDielectronVarManager::kITSnSigmaMuo]=ctx->fPIDResponse->NumberOfSigmasITS(particle,AliPID::kMuon);
+  values[AliDielectronVarManager::kITSnSigmaKao]=ctx->fPIDResponse->NumberOfSigmasITS(particle,AliPID::kKaon);
+  values[AliDielectronVarManager::kITSnSigmaPro]=ctx->fPIDResponse->NumberOfSigmasITS(particle,AliPID::kProton);
 
-  values[AliDielectronVarManager::kTOFnSigmaEleRaw]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kTOFnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrTOF(particle)) / AliDielectronPID::GetWdthCorrTOF(particle);
-  values[AliDielectronVarManager::kTOFnSigmaPio]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kPion);
-  values[AliDielectronVarManager::kTOFnSigmaMuo]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kMuon);
-  values[AliDielectronVarManager::kTOFnSigmaKao]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kKaon);
-  values[AliDielectronVarManager::kTOFnSigmaPro]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kProton);
+  values[AliDielectronVarManager::kTOFnSigmaEleRaw]=ctx->fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron);
+  values[AliDielectronVarManager::kTOFnSigmaEle]   =(ctx->fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrTOF(particle)) / AliDielectronPID::GetWdthCorrTOF(particle);
+  values[AliDielectronVarManager::kTOFnSigmaPio]=ctx->fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kPion);
+  values[AliDielectronVarManager::kTOFnSigmaMuo]=ctx->fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kMuon);
+  values[AliDielectronVarManager::kTOFnSigmaKao]=ctx->fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kKaon);
+  values[AliDielectronVarManager::kTOFnSigmaPro]=ctx->fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kProton);
 
   //EMCAL PID information
   Double_t eop=0;
   Double_t showershape[4]={0.,0.,0.,0.};
-//   values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron);
-  values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron,eop,showershape);
+//   values[AliDielectronVarManager::kEMCALnSigmaEle]  = ctx->fPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron);
+  values[AliDielectronVarManager::kEMCALnSigmaEle]  = ctx->fPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron,eop,showershape);
   values[AliDielectronVarManager::kEMCALEoverP]     = eop;
   values[AliDielectronVarManager::kEMCALE]          = eop*values[AliDielectronVarManager::kP];
   values[AliDielectronVarManager::kEMCALNCells]     = showershape[0];
@@ -1137,22 +1162,22 @@ inline void AliDielectronVarManager::FillVarESDtrack(const AliESDtrack *particle
   if (esdTrack) esdTrack->SetTPCsignal(origdEdx,esdTrack->GetTPCsignalSigma(),esdTrack->GetTPCsignalN());
 
   //fill info from AliVTrdTrack
-  if(Req(kTRDonlineA)||Req(kTRDonlineLayerMask)||Req(kTRDonlinePID)||Req(kTRDonlinePt)||Req(kTRDonlineStack)||Req(kTRDonlineTrackInTime)||Req(kTRDonlineSector)||Req(kTRDonlineFlagsTiming)||Req(kTRDonlineLabel)||Req(kTRDonlineNTracklets)||Req(kTRDonlineFirstLayer))
+  if(Req(ctx,kTRDonlineA)||Req(ctx,kTRDonlineLayerMask)||Req(ctx,kTRDonlinePID)||Req(ctx,kTRDonlinePt)||Req(ctx,kTRDonlineStack)||Req(ctx,kTRDonlineTrackInTime)||Req(ctx,kTRDonlineSector)||Req(ctx,kTRDonlineFlagsTiming)||Req(ctx,kTRDonlineLabel)||Req(ctx,kTRDonlineNTracklets)||Req(ctx,kTRDonlineFirstLayer))
     FillVarVTrdTrack(particle,values);
 
-  if( fgEvent && fgEvent->GetMagneticField() ){
+  if( ctx->fEvent && ctx->fEvent->GetMagneticField() ){
     if(out){
       AliExternalTrackParam out_tmp(*out);
-      out_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), fgEvent->GetMagneticField());
+      out_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), ctx->fEvent->GetMagneticField());
       values[AliDielectronVarManager::kTRDeta] = out_tmp.Eta();
     }
     else{
       AliESDtrack particle_tmp(*particle);
-      particle_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), fgEvent->GetMagneticField());
+      particle_tmp.PropagateTo(AliTRDgeometry::GetXtrdBeg(), ctx->fEvent->GetMagneticField());
       values[AliDielectronVarManager::kTRDeta] = particle_tmp.Eta();
     }
     int mode = particle->GetInnerParam() ? 1:0;
-    values[kTPCActiveLength] = particle->GetLengthInActiveZone(mode, 2., 220., fgEvent->GetMagneticField());
+    values[kTPCActiveLength] = particle->GetLengthInActiveZone(mode, 2., 220., ctx->fEvent->GetMagneticField());
     values[kTPCGeomLength] = values[kTPCActiveLength] / ( 130 - TMath::Power( TMath::Abs( particle->GetSigned1Pt() ),1.5 ) );
     values[AliDielectronVarManager::kInTRDacceptance] = TMath::Abs( values[AliDielectronVarManager::kTRDeta] )<0.85 && (  (values[AliDielectronVarManager::kCharge]<0&&(  values[AliDielectronVarManager::kPhi]<1.32 || (values[AliDielectronVarManager::kPhi]>1.98 && values[AliDielectronVarManager::kPhi]<4.10)||  ( values[AliDielectronVarManager::kPhi]>5.12  && values[AliDielectronVarManager::kPhi]<5.48  && TMath::Abs( values[AliDielectronVarManager::kTRDeta] )>0.155 )  || values[AliDielectronVarManager::kPhi]>5.48 )) ||   (values[AliDielectronVarManager::kCharge]>0&&(  values[AliDielectronVarManager::kPhi]<1.52 || (values[AliDielectronVarManager::kPhi]>2.20 && values[AliDielectronVarManager::kPhi]<4.32)||  ( values[AliDielectronVarManager::kPhi]>5.32  && values[AliDielectronVarManager::kPhi]<5.68  && TMath::Abs( values[AliDielectronVarManager::kTRDeta]  )>0.155 )  || values[AliDielectronVarManager::kPhi]>5.68 )) )  ? 1: 0;
   }
@@ -1164,47 +1189,48 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
   //
   // Fill track information available for histogramming into an array
   //
+  Context *ctx = GetContext();
 
   // Fill common AliVParticle interface information
   FillVarVParticle(particle, values);
   Double_t tpcNcls=particle->GetTPCNcls();
 
-  if(Req(kQnDeltaPhiTrackTPCrpH2))   values[AliDielectronVarManager::kQnDeltaPhiTrackTPCrpH2]  = TVector2::Phi_mpi_pi(values[AliDielectronVarManager::kPhi] - values[AliDielectronVarManager::kQnTPCrpH2]);
-  if(Req(kQnDeltaPhiTrackV0CrpH2))   values[AliDielectronVarManager::kQnDeltaPhiTrackV0CrpH2]  = TVector2::Phi_mpi_pi(values[AliDielectronVarManager::kPhi] - values[AliDielectronVarManager::kQnV0CrpH2]);
+  if(Req(ctx,kQnDeltaPhiTrackTPCrpH2))   values[AliDielectronVarManager::kQnDeltaPhiTrackTPCrpH2]  = TVector2::Phi_mpi_pi(values[AliDielectronVarManager::kPhi] - values[AliDielectronVarManager::kQnTPCrpH2]);
+  if(Req(ctx,kQnDeltaPhiTrackV0CrpH2))   values[AliDielectronVarManager::kQnDeltaPhiTrackV0CrpH2]  = TVector2::Phi_mpi_pi(values[AliDielectronVarManager::kPhi] - values[AliDielectronVarManager::kQnV0CrpH2]);
 
   Double_t tpcNclsS = -99.;
-  if(Req(kNclsSTPC) || Req(kNclsSFracTPC)) tpcNclsS = particle->GetTPCnclsS();
+  if(Req(ctx,kNclsSTPC) || Req(ctx,kNclsSFracTPC)) tpcNclsS = particle->GetTPCnclsS();
 
   // Reset AliESDtrack interface specific information
-  if(Req(kNclsITS) || Req(kNclsSFracITS))      values[AliDielectronVarManager::kNclsITS]       = particle->GetITSNcls();
-  if(Req(kITSchi2Cl))    values[AliDielectronVarManager::kITSchi2Cl]     = (particle->GetITSNcls()>0)? particle->GetITSchi2() / particle->GetITSNcls() : 0;
-  if(Req(kNclsTPC))      values[AliDielectronVarManager::kNclsTPC]       = tpcNcls;
-  if(Req(kNclsSTPC) || Req(kNclsSFracTPC))     values[AliDielectronVarManager::kNclsSTPC]      = tpcNclsS;
-  if(Req(kNclsSFracTPC)) values[AliDielectronVarManager::kNclsSFracTPC]  = tpcNcls>0?tpcNclsS/tpcNcls:0;
-  if(Req(kNclsTPCiter1)) values[AliDielectronVarManager::kNclsTPCiter1]  = tpcNcls; // not really available in AOD
-  if(Req(kNFclsTPC)  || Req(kNFclsTPCfCross))  values[AliDielectronVarManager::kNFclsTPC]      = particle->GetTPCNclsF();
-  if(Req(kNFclsTPCr) || Req(kNFclsTPCfCross))  values[AliDielectronVarManager::kNFclsTPCr]     = particle->GetTPCClusterInfo(2,1);
-  if(Req(kNFclsTPCrFrac))  values[AliDielectronVarManager::kNFclsTPCrFrac] = particle->GetTPCClusterInfo(2);
-  if(Req(kNFclsTPCfCross)) values[AliDielectronVarManager::kNFclsTPCfCross]= (values[kNFclsTPC]>0)?(values[kNFclsTPCr]/values[kNFclsTPC]):0;
-  if(Req(kChi2TPCConstrainedVsGlobal)) values[AliDielectronVarManager::kChi2TPCConstrainedVsGlobal] = particle->GetChi2TPCConstrainedVsGlobal();
-  if(Req(kNclsTRD))        values[AliDielectronVarManager::kNclsTRD]       = particle->GetNcls(2);
-  if(Req(kTRDntracklets))  values[AliDielectronVarManager::kTRDntracklets] = 0;
-  if(Req(kTRDpidQuality))  values[AliDielectronVarManager::kTRDpidQuality] = particle->GetTRDntrackletsPID();
-  if(Req(kTRDchi2))        values[AliDielectronVarManager::kTRDchi2]       = (particle->GetTRDntrackletsPID()!=0.?particle->GetTRDchi2():-1);
-  if(Req(kTRDchi2Trklt))   values[AliDielectronVarManager::kTRDchi2Trklt]  = (particle->GetTRDntrackletsPID()>0 ? particle->GetTRDchi2() / particle->GetTRDntrackletsPID() : -1.);
-  if(Req(kTRDsignal))      values[AliDielectronVarManager::kTRDsignal]     = particle->GetTRDsignal();
-
-  if(Req(kNclsSITS) || Req(kNclsSFracITS) || Req(kNclsSMapITS)){
+  if(Req(ctx,kNclsITS) || Req(ctx,kNclsSFracITS))      values[AliDielectronVarManager::kNclsITS]       = particle->GetITSNcls();
+  if(Req(ctx,kITSchi2Cl))    values[AliDielectronVarManager::kITSchi2Cl]     = (particle->GetITSNcls()>0)? particle->GetITSchi2() / particle->GetITSNcls() : 0;
+  if(Req(ctx,kNclsTPC))      values[AliDielectronVarManager::kNclsTPC]       = tpcNcls;
+  if(Req(ctx,kNclsSTPC) || Req(ctx,kNclsSFracTPC))     values[AliDielectronVarManager::kNclsSTPC]      = tpcNclsS;
+  if(Req(ctx,kNclsSFracTPC)) values[AliDielectronVarManager::kNclsSFracTPC]  = tpcNcls>0?tpcNclsS/tpcNcls:0;
+  if(Req(ctx,kNclsTPCiter1)) values[AliDielectronVarManager::kNclsTPCiter1]  = tpcNcls; // not really available in AOD
+  if(Req(ctx,kNFclsTPC)  || Req(ctx,kNFclsTPCfCross))  values[AliDielectronVarManager::kNFclsTPC]      = particle->GetTPCNclsF();
+  if(Req(ctx,kNFclsTPCr) || Req(ctx,kNFclsTPCfCross))  values[AliDielectronVarManager::kNFclsTPCr]     = particle->GetTPCClusterInfo(2,1);
+  if(Req(ctx,kNFclsTPCrFrac))  values[AliDielectronVarManager::kNFclsTPCrFrac] = particle->GetTPCClusterInfo(2);
+  if(Req(ctx,kNFclsTPCfCross)) values[AliDielectronVarManager::kNFclsTPCfCross]= (values[kNFclsTPC]>0)?(values[kNFclsTPCr]/values[kNFclsTPC]):0;
+  if(Req(ctx,kChi2TPCConstrainedVsGlobal)) values[AliDielectronVarManager::kChi2TPCConstrainedVsGlobal] = particle->GetChi2TPCConstrainedVsGlobal();
+  if(Req(ctx,kNclsTRD))        values[AliDielectronVarManager::kNclsTRD]       = particle->GetNcls(2);
+  if(Req(ctx,kTRDntracklets))  values[AliDielectronVarManager::kTRDntracklets] = 0;
+  if(Req(ctx,kTRDpidQuality))  values[AliDielectronVarManager::kTRDpidQuality] = particle->GetTRDntrackletsPID();
+  if(Req(ctx,kTRDchi2))        values[AliDielectronVarManager::kTRDchi2]       = (particle->GetTRDntrackletsPID()!=0.?particle->GetTRDchi2():-1);
+  if(Req(ctx,kTRDchi2Trklt))   values[AliDielectronVarManager::kTRDchi2Trklt]  = (particle->GetTRDntrackletsPID()>0 ? particle->GetTRDchi2() / particle->GetTRDntrackletsPID() : -1.);
+  if(Req(ctx,kTRDsignal))      values[AliDielectronVarManager::kTRDsignal]     = particle->GetTRDsignal();
+
+  if(Req(ctx,kNclsSITS) || Req(ctx,kNclsSFracITS) || Req(ctx,kNclsSMapITS)){
     Double_t itsNclsS = 0.;
     for(int i=0; i<6; i++){
       if( particle->HasSharedPointOnITSLayer(i) ) itsNclsS ++;
     }
     values[AliDielectronVarManager::kNclsSITS]     = itsNclsS;
-    if(Req(kNclsSMapITS))  values[AliDielectronVarManager::kNclsSMapITS]  = particle->GetITSSharedClusterMap();  //not implemented in AODs
-    if(Req(kNclsSFracITS)) values[AliDielectronVarManager::kNclsSFracITS] = itsNclsS > 0. ? itsNclsS / particle->GetITSNcls() : 0.;
+    if(Req(ctx,kNclsSMapITS))  values[AliDielectronVarManager::kNclsSMapITS]  = particle->GetITSSharedClusterMap();  //not implemented in AODs
+    if(Req(ctx,kNclsSFracITS)) values[AliDielectronVarManager::kNclsSFracITS] = itsNclsS > 0. ? itsNclsS / particle->GetITSNcls() : 0.;
   }
 
-  if(Req(kITSsignalSSD1) || Req(kITSsignalSSD2) || Req(kITSsignalSDD1) || Req(kITSsignalSDD2) ){
+  if(Req(ctx,kITSsignalSSD1) || Req(ctx,kITSsignalSSD2) || Req(ctx,kITSsignalSDD1) || Req(ctx,kITSsignalSDD2) ){
     Double_t itsdEdx[4];
     particle->GetITSdEdxSamples(itsdEdx);
     values[AliDielectronVarManager::kITSsignalSSD1]   =   itsdEdx[0];
@@ -1219,7 +1245,7 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
   UChar_t threshold = 5;
 
   values[AliDielectronVarManager::kTPCclsSegments] = 0.0;
-  if(Req(kTPCclsSegments)) {
+  if(Req(ctx,kTPCclsSegments)) {
     for(UChar_t i=0; i<8; ++i) {
       n=0;
       for(j=i*20; j<(i+1)*20 && j<159; ++j) n+=tpcClusterMap.TestBitNumber(j);
@@ -1228,7 +1254,7 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
   }
 
   values[AliDielectronVarManager::kTPCclsIRO]=0.;
-  if(Req(kTPCclsIRO)) {
+  if(Req(ctx,kTPCclsIRO)) {
     n=0;
     threshold=0;
     for(j=0; j<63; ++j) n+=tpcClusterMap.TestBitNumber(j);
@@ -1236,7 +1262,7 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
   }
 
   values[AliDielectronVarManager::kTPCclsORO]=0.;
-  if(Req(kTPCclsORO)) {
+  if(Req(ctx,kTPCclsORO)) {
     n=0;
     threshold=0;
     for(j=63; j<159; ++j) n+=tpcClusterMap.TestBitNumber(j);
@@ -1244,9 +1270,9 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
   }
 
   // it is stored as normalized to tpcNcls-5 (see AliAnalysisTaskESDfilter)
-  if(Req(kTPCchi2Cl))   values[AliDielectronVarManager::kTPCchi2Cl]     = (tpcNcls>0)?particle->Chi2perNDF()*(tpcNcls-5)/tpcNcls:-1.;
-  if(Req(kTrackStatus)) values[AliDielectronVarManager::kTrackStatus]   = (Double_t)particle->GetStatus();
-  if(Req(kFilterBit))   values[AliDielectronVarManager::kFilterBit]     = (Double_t)particle->GetFilterMap();
+  if(Req(ctx,kTPCchi2Cl))   values[AliDielectronVarManager::kTPCchi2Cl]     = (tpcNcls>0)?particle->Chi2perNDF()*(tpcNcls-5)/tpcNcls:-1.;
+  if(Req(ctx,kTrackStatus)) values[AliDielectronVarManager::kTrackStatus]   = (Double_t)particle->GetStatus();
+  if(Req(ctx,kFilterBit))   values[AliDielectronVarManager::kFilterBit]     = (Double_t)particle->GetFilterMap();
 
   //TRD pidProbs
   values[AliDielectronVarManager::kTRDprobEle]    = 0;
@@ -1259,7 +1285,7 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
   //
   Int_t v0Index=-1;
   Int_t kinkIndex=-1;
-  if( (Req(kV0Index0) || Req(kKinkIndex0)) && particle->GetProdVertex()) {
+  if( (Req(ctx,kV0Index0) || Req(ctx,kKinkIndex0)) && particle->GetProdVertex()) {
     v0Index   = particle->GetProdVertex()->GetType()==AliAODVertex::kV0   ? 1 : 0;
     kinkIndex = particle->GetProdVertex()->GetType()==AliAODVertex::kKink ? 1 : 0;
   }
@@ -1268,7 +1294,7 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
 
   Double_t d0z0[2]={-999.0,-999.0};
   Double_t dcaRes[3] = {-999.,-999.,-999.};
-  if(Req(kImpactParXY) || Req(kImpactParZ) || Req(kImpactParXYsigma) || Req(kImpactParZsigma) ) GetDCA(particle, d0z0, dcaRes);
+  if(Req(ctx,kImpactParXY) || Req(ctx,kImpactParZ) || Req(ctx,kImpactParXYsigma) || Req(ctx,kImpactParZsigma) ) GetDCA(particle, d0z0, dcaRes);
   values[AliDielectronVarManager::kImpactParXY]   = d0z0[0];
   values[AliDielectronVarManager::kImpactParZ]    = d0z0[1];
   values[AliDielectronVarManager::kImpactParXYsigma] = -999.0;
@@ -1300,12 +1326,12 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
   values[AliDielectronVarManager::kTOFnSigmaKao]=0;
   values[AliDielectronVarManager::kTOFnSigmaPro]=0;
 
-  if(Req(kITSsignal))        values[AliDielectronVarManager::kITSsignal]        =   particle->GetITSsignal();
-  if(Req(kITSclusterMap))    values[AliDielectronVarManager::kITSclusterMap]    =   particle->GetITSClusterMap();
-  if(Req(kITSLayerFirstCls)) values[AliDielectronVarManager::kITSLayerFirstCls] = -1.;
+  if(Req(ctx,kITSsignal))        values[AliDielectronVarManager::kITSsignal]        =   particle->GetITSsignal();
+  if(Req(ctx,kITSclusterMap))    values[AliDielectronVarManager::kITSclusterMap]    =   particle->GetITSClusterMap();
+  if(Req(ctx,kITSLayerFirstCls)) values[AliDielectronVarManager::kITSLayerFirstCls] = -1.;
   for (Int_t iC=0; iC<6; iC++) {
     if (((particle->GetITSClusterMap()) & (1<<(iC))) > 0) {
-      if(Req(kITSLayerFirstCls)) values[AliDielectronVarManager::kITSLayerFirstCls] = iC;
+      if(Req(ctx,kITSLayerFirstCls)) values[AliDielectronVarManager::kITSLayerFirstCls] = iC;
       break;
     }
   }
@@ -1317,25 +1343,25 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
     pid->SetTPCsignal(origdEdx/AliDielectronPID::GetEtaCorr(particle)/AliDielectronPID::GetCorrValdEdx());
 
     Double_t tpcSignalN=0.0;
-    if(Req(kTPCsignalN) || Req(kTPCsignalNfrac) || Req(kTPCclsDiff)) tpcSignalN = pid->GetTPCsignalN();
+    if(Req(ctx,kTPCsignalN) || Req(ctx,kTPCsignalNfrac) || Req(ctx,kTPCclsDiff)) tpcSignalN = pid->GetTPCsignalN();
     values[AliDielectronVarManager::kTPCsignalN]     = tpcSignalN;
     values[AliDielectronVarManager::kTPCsignalNfrac] = tpcNcls>0?tpcSignalN/tpcNcls:0;
     values[AliDielectronVarManager::kTPCclsDiff]     = tpcSignalN-tpcNcls;
 
     values[AliDielectronVarManager::kPIn]         = pid->GetTPCmomentum();
-    if(Req(kTPCsignal))   values[AliDielectronVarManager::kTPCsignal]   = pid->GetTPCsignal();
-    if(Req(kTOFsignal))   values[AliDielectronVarManager::kTOFsignal]   = pid->GetTOFsignal();
-    if(Req(kTOFmismProb)) values[AliDielectronVarManager::kTOFmismProb] = fgPIDResponse->GetTOFMismatchProbability(particle);
+    if(Req(ctx,kTPCsignal))   values[AliDielectronVarManager::kTPCsignal]   = pid->GetTPCsignal();
+    if(Req(ctx,kTOFsignal))   values[AliDielectronVarManager::kTOFsignal]   = pid->GetTOFsignal();
+    if(Req(ctx,kTOFmismProb)) values[AliDielectronVarManager::kTOFmismProb] = ctx->fPIDResponse->GetTOFMismatchProbability(particle);
 
     // TOF beta calculation
-    if(Req(kTOFbeta)) {
+    if(Req(ctx,kTOFbeta)) {
       Double32_t expt[5];
       particle->GetIntegratedTimes(expt);         // ps
       Double_t l  = TMath::C()* expt[0]*1e-12;    // m
       Double_t t  = pid->GetTOFsignal();          // ps start time subtracted (until v5-02-Rev09)
       AliTOFHeader* tofH=0x0;                     // from v5-02-Rev10 on subtract the start time
-      if(fgEvent) tofH = (AliTOFHeader*)fgEvent->GetTOFHeader();
-      if(tofH) t -= fgPIDResponse->GetTOFResponse().GetStartTime(particle->P()); // ps
+      if(ctx->fEvent) tofH = (AliTOFHeader*)ctx->fEvent->GetTOFHeader();
+      if(tofH) t -= ctx->fPIDResponse->GetTOFResponse().GetStartTime(particle->P()); // ps
 
     if( (l < 360.e-2 || l > 800.e-2) || (t <= 0.) ) {
       values[AliDielectronVarManager::kTOFbeta]  =0;
@@ -1350,56 +1376,56 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
     }
 
     // nsigma for various detectors
-    if(Req(kTPCnSigmaEleRaw)) values[kTPCnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron);
-    if(Req(kTPCnSigmaEle))    values[kTPCnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron)-AliDielectronPID::GetCorrVal()-AliDielectronPID::GetCntrdCorr(particle)) / AliDielectronPID::GetWdthCorr(particle);
+    if(Req(ctx,kTPCnSigmaEleRaw)) values[kTPCnSigmaEleRaw]= ctx->fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron);
+    if(Req(ctx,kTPCnSigmaEle))    values[kTPCnSigmaEle]   =(ctx->fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kElectron)-AliDielectronPID::GetCorrVal()-AliDielectronPID::GetCntrdCorr(particle)) / AliDielectronPID::GetWdthCorr(particle);
 
-    if(Req(kTPCnSigmaPio)) values[kTPCnSigmaPio]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kPion);
-    if(Req(kTPCnSigmaMuo)) values[kTPCnSigmaMuo]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kMuon);
-    if(Req(kTPCnSigmaKao)) values[kTPCnSigmaKao]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kKaon);
-    if(Req(kTPCnSigmaPro)) values[kTPCnSigmaPro]=fgPIDResponse->NumberOfSigmasTPC(particle,AliPID::kProton);
+    if(Req(ctx,kTPCnSigmaPio)) values[kTPCnSigmaPio]=ctx->fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kPion);
+    if(Req(ctx,kTPCnSigmaMuo)) values[kTPCnSigmaMuo]=ctx->fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kMuon);
+    if(Req(ctx,kTPCnSigmaKao)) values[kTPCnSigmaKao]=ctx->fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kKaon);
+    if(Req(ctx,kTPCnSigmaPro)) values[kTPCnSigmaPro]=ctx->fPIDResponse->NumberOfSigmasTPC(particle,AliPID::kProton);
 
-    if(Req(kITSnSigmaEleRaw)) values[kITSnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron);
-    if(Req(kITSnSigmaEle))    values[kITSnSigmaEle]   =(fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrITS(particle)) / AliDielectronPID::GetWdthCorrITS(particle);
+    if(Req(ctx,kITSnSigmaEleRaw)) values[kITSnSigmaEleRaw]= ctx->fPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron);
+    if(Req(ctx,kITSnSigmaEle))    values[kITSnSigmaEle]   =(ctx->fPIDResponse->NumberOfSigmasITS(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrITS(particle)) / AliDielectronPID::GetWdthCorrITS(particle);
 
-    if(Req(kITSnSigmaPio)) values[kITSnSigmaPio]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kPion);
-    if(Req(kITSnSigmaMuo)) values[kITSnSigmaMuo]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kMuon);
-    if(Req(kITSnSigmaKao)) values[kITSnSigmaKao]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kKaon);
-    if(Req(kITSnSigmaPro)) values[kITSnSigmaPro]=fgPIDResponse->NumberOfSigmasITS(particle,AliPID::kProton);
+    if(Req(ctx,kITSnSigmaPio)) values[kITSnSigmaPio]=ctx->fPIDResponse->NumberOfSigmasITS(particle,AliPID::kPion);
+    if(Req(ctx,kITSnSigmaMuo)) values[kITSnSigmaMuo]=ctx->fPIDResponse->NumberOfSigmasITS(particle,AliPID::kMuon);
+    if(Req(ctx,kITSnSigmaKao)) values[kITSnSigmaKao]=ctx->fPIDResponse->NumberOfSigmasITS(particle,AliPID::kKaon);
+    if(Req(ctx,kITSnSigmaPro)) values[kITSnSigmaPro]=ctx->fPIDResponse->NumberOfSigmasITS(particle,AliPID::kProton);
 
-    if(Req(kTOFnSigmaEleRaw)) values[kTOFnSigmaEleRaw]= fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron);
-    if(Req(kTOFnSigmaEle))    values[kTOFnSigmaEle]   =(fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrTOF(particle)) / AliDielectronPID::GetWdthCorrTOF(particle);
+    if(Req(ctx,kTOFnSigmaEleRaw)) values[kTOFnSigmaEleRaw]= ctx->fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron);
+    if(Req(ctx,kTOFnSigmaEle))    values[kTOFnSigmaEle]   =(ctx->fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kElectron) - AliDielectronPID::GetCntrdCorrTOF(particle)) / AliDielectronPID::GetWdthCorrTOF(particle);
 
-    if(Req(kTOFnSigmaPio)) values[kTOFnSigmaPio]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kPion);
-    if(Req(kTOFnSigmaMuo)) values[kTOFnSigmaMuo]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kMuon);
-    if(Req(kTOFnSigmaKao)) values[kTOFnSigmaKao]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kKaon);
-    if(Req(kTOFnSigmaPro)) values[kTOFnSigmaPro]=fgPIDResponse->NumberOfSigmasTOF(particle,AliPID::kProton);
+    if(Req(ctx,kTOFnSigmaPio)) values[kTOFnSigmaPio]=ctx->fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kPion);
+    if(Req(ctx,kTOFnSigmaMuo)) values[kTOFnSigmaMuo]=ctx->fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kMuon);
+    if(Req(ctx,kTOFnSigmaKao)) values[kTOFnSigmaKao]=ctx->fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kKaon);
+    if(Req(ctx,kTOFnSigmaPro)) values[kTOFnSigmaPro]=ctx->fPIDResponse->NumberOfSigmasTOF(particle,AliPID::kProton);
 
     Double_t prob[AliPID::kSPECIES]={0.0};
     // switch computation off since it takes 70% of the CPU time for filling all AODtrack variables
     // TODO: find a solution when this is needed (maybe at fill time in histos, CFcontainer and cut selection)
     // 1D TRD PID
-    if( Req(kTRDprobEle) || Req(kTRDprobPio) ){
-      fgPIDResponse->ComputeTRDProbability(particle,AliPID::kSPECIES,prob);
+    if( Req(ctx,kTRDprobEle) || Req(ctx,kTRDprobPio) ){
+      ctx->fPIDResponse->ComputeTRDProbability(particle,AliPID::kSPECIES,prob);
       values[AliDielectronVarManager::kTRDprobEle]      = prob[AliPID::kElectron];
       values[AliDielectronVarManager::kTRDprobPio]      = prob[AliPID::kPion];
     }
     // 2D TRD PID
-    if( Req(kTRDprob2DEle) || Req(kTRDprob2DPio) || Req(kTRDprob2DPro) ){
-      fgPIDResponse->ComputeTRDProbability(particle,AliPID::kSPECIES,prob, AliTRDPIDResponse::kLQ2D);
+    if( Req(ctx,kTRDprob2DEle) || Req(ctx,kTRDprob2DPio) || Req(ctx,kTRDprob2DPro) ){
+      ctx->fPIDResponse->ComputeTRDProbability(particle,AliPID::kSPECIES,prob, AliTRDPIDResponse::kLQ2D);
       values[AliDielectronVarManager::kTRDprob2DEle]    = prob[AliPID::kElectron];
       values[AliDielectronVarManager::kTRDprob2DPio]    = prob[AliPID::kPion];
       values[AliDielectronVarManager::kTRDprob2DPro]    = prob[AliPID::kProton];
     }
     // 3D TRD PID
-     if( Req(kTRDprob3DEle) || Req(kTRDprob3DPio) || Req(kTRDprob3DPro) ){
-       fgPIDResponse->ComputeTRDProbability(particle,AliPID::kSPECIES,prob, AliTRDPIDResponse::kLQ3D);
+     if( Req(ctx,kTRDprob3DEle) || Req(ctx,kTRDprob3DPio) || Req(ctx,kTRDprob3DPro) ){
+       ctx->fPIDResponse->ComputeTRDProbability(particle,AliPID::kSPECIES,prob, AliTRDPIDResponse::kLQ3D);
        values[AliDielectronVarManager::kTRDprob3DEle]    = prob[AliPID::kElectron];
        values[AliDielectronVarManager::kTRDprob3DPio]    = prob[AliPID::kPion];
        values[AliDielectronVarManager::kTRDprob3DPro]    = prob[AliPID::kProton];
      }
     // 7D TRD PID
-     if( Req(kTRDprob7DEle) || Req(kTRDprob7DPio) || Req(kTRDprob7DPro) ){
-       fgPIDResponse->ComputeTRDProbability(particle,AliPID::kSPECIES,prob, AliTRDPIDResponse::kLQ7D);
+     if( Req(ctx,kTRDprob7DEle) || Req(ctx,kTRDprob7DPio) || Req(ctx,kTRDprob7DPro) ){
+       ctx->fPIDResponse->ComputeTRDProbability(particle,AliPID::kSPECIES,prob, AliTRDPIDResponse::kLQ7D);
        values[AliDielectronVarManager::kTRDprob7DEle]    = prob[AliPID::kElectron];
        values[AliDielectronVarManager::kTRDprob7DPio]    = prob[AliPID::kPion];
        values[AliDielectronVarManager::kTRDprob7DPro]    = prob[AliPID::kProton];
@@ -1413,10 +1439,10 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
   //EMCAL PID information
   Double_t eop=0;
   Double_t showershape[4]={0.,0.,0.,0.};
-//   if(Req()) values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron);
-  if(Req(kEMCALnSigmaEle) || Req(kEMCALE) || Req(kEMCALEoverP) ||
-     Req(kEMCALNCells) || Req(kEMCALM02) || Req(kEMCALM20) || Req(kEMCALDispersion))
-    values[AliDielectronVarManager::kEMCALnSigmaEle]  = fgPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron,eop,showershape);
+//   if(Req(ctx,)) values[AliDielectronVarManager::kEMCALnSigmaEle]  = ctx->fPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron);
+  if(Req(ctx,kEMCALnSigmaEle) || Req(ctx,kEMCALE) || Req(ctx,kEMCALEoverP) ||
+     Req(ctx,kEMCALNCells) || Req(ctx,kEMCALM02) || Req(ctx,kEMCALM20) || Req(ctx,kEMCALDispersion))
+    values[AliDielectronVarManager::kEMCALnSigmaEle]  = ctx->fPIDResponse->NumberOfSigmasEMCAL(particle,AliPID::kElectron,eop,showershape);
   values[AliDielectronVarManager::kEMCALEoverP]     = eop;
   values[AliDielectronVarManager::kEMCALE]          = eop*values[AliDielectronVarManager::kP];
   values[AliDielectronVarManager::kEMCALNCells]     = showershape[0];
@@ -1438,7 +1464,7 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
 
       Int_t trkLbl = particle->GetLabel();
 
-      if (Req(kMCLegSource)){
+      if (Req(ctx,kMCLegSource)){
         values[AliDielectronVarManager::kMCLegSource] = 0;
         if (mc->CheckParticleSource(trkLbl, AliDielectronSignalMC::kPrimary)) values[AliDielectronVarManager::kMCLegSource] += 1;
         if (mc->CheckParticleSource(trkLbl, AliDielectronSignalMC::kFinalState)) values[AliDielectronVarManager::kMCLegSource] += 2;
@@ -1448,27 +1474,27 @@ inline void AliDielectronVarManager::FillVarAODTrack(const AliAODTrack *particle
         if (mc->CheckParticleSource(trkLbl, AliDielectronSignalMC::kSecondaryFromMaterial)) values[AliDielectronVarManager::kMCLegSource] +=32;
       }
 
-      if (Req(kPdgCode))           values[AliDielectronVarManager::kPdgCode]           =mc->GetMCTrack(particle)->PdgCode();
-      if (Req(kHasCocktailMother)) values[AliDielectronVarManager::kHasCocktailMother] =mc->CheckParticleSource(trkLbl, AliDielectronSignalMC::kDirect);
-      if (Req(kPdgCodeMother))     values[AliDielectronVarManager::kPdgCodeMother]     =mc->GetMotherPDG(particle);
-      if (Req(kPdgCodeGrandMother)){
+      if (Req(ctx,kPdgCode))           values[AliDielectronVarManager::kPdgCode]           =mc->GetMCTrack(particle)->PdgCode();
+      if (Req(ctx,kHasCocktailMother)) values[AliDielectronVarManager::kHasCocktailMother] =mc->CheckParticleSource(trkLbl, AliDielectronSignalMC::kDirect);
+      if (Req(ctx,kPdgCodeMother))     values[AliDielectronVarManager::kPdgCodeMother]     =mc->GetMotherPDG(particle);
+      if (Req(ctx,kPdgCodeGrandMother)){
         AliAODMCParticle *motherMC=mc->GetMCTrackMother(particle); //mother
         if(motherMC) values[AliDielectronVarManager::kPdgCodeGrandMother]=mc->GetMotherPDG(motherMC);
       }
     }
-    if (Req(kNumberOfDaughters)) values[AliDielectronVarManager::kNumberOfDaughters]=mc->NumberOfDaughters(particle);
+    if (Req(ctx,kNumberOfDaughters)) values[AliDielectronVarManager::kNumberOfDaughters]=mc->NumberOfDaughters(particle);
   } //if(mc->HasMC())
 
-  if(Req(kTOFPIDBit))     values[AliDielectronVarManager::kTOFPIDBit]=(particle->GetStatus()&AliESDtrack::kTOFpid? 1: 0);
+  if(Req(ctx,kTOFPIDBit))     values[AliDielectronVarManager::kTOFPIDBit]=(particle->GetStatus()&AliESDtrack::kTOFpid? 1: 0);
   values[AliDielectronVarManager::kLegEff]=0.0;
   values[AliDielectronVarManager::kOneOverLegEff]=0.0;
-  if(Req(kLegEff) || Req(kOneOverLegEff)) {
+  if(Req(ctx,kLegEff) || Req(ctx,kOneOverLegEff)) {
     values[AliDielectronVarManager::kLegEff] = GetSingleLegEff(values);
     values[AliDielectronVarManager::kOneOverLegEff] = (values[AliDielectronVarManager::kLegEff]>0.0 ? 1./values[AliDielectronVarManager::kLegEff] : 0.0);
   }
 
   //fill info from AliVTrdTrack
-  if(Req(kTRDonlineA)||Req(kTRDonlineLayerMask)||Req(kTRDonlinePID)||Req(kTRDonlinePt)||Req(kTRDonlineStack)||Req(kTRDonlineSector)||Req(kTRDonlineTrackInTime)||Req(kTRDonlineFlagsTiming)||Req(kTRDonlineLabel)||Req(kTRDonlineNTracklets)||Req(kTRDonlineFirstLayer))
+  if(Req(ctx,kTRDonlineA)||Req(ctx,kTRDonlineLayerMask)||Req(ctx,kTRDonlinePID)||Req(ctx,kTRDonlinePt)||Req(ctx,kTRDonlineStack)||Req(ctx,kTRDonlineSector)||Req(ctx,kTRDonlineTrackInTime)||Req(ctx,kTRDonlineFlagsTiming)||Req(ctx,kTRDonlineLabel)||Req(ctx,kTRDonlineNTracklets)||Req(ctx,kTRDonlineFirstLayer))
     FillVarVTrdTrack(particle,values);
 }
 
@@ -1539,6 +1565,7 @@ inline void AliDielectronVarManager::FillVarMCParticle(const AliMCParticle *part
   //
   // Fill track information available for histogramming into an array
   //
+  Context *ctx = GetContext();
   values[AliDielectronVarManager::kNclsITS]       = 0;
   values[AliDielectronVarManager::kITSchi2Cl]     = 0;
   values[AliDielectronVarManager::kNclsTPC]       = 0;
@@ -1586,7 +1613,7 @@ inline void AliDielectronVarManager::FillVarMCParticle(const AliMCParticle *part
   FillVarVParticle(particle, values);
 
   // Fill distance of primary vertex to secondary vertex (as a well-defined alternative to the IP-approximation below)
-  if (Req(kDistPrimToSecVtxXYMC) || Req(kDistPrimToSecVtxZMC)) {
+  if (Req(ctx,kDistPrimToSecVtxXYMC) || Req(ctx,kDistPrimToSecVtxZMC)) {
     values[AliDielectronVarManager::kDistPrimToSecVtxXYMC] = TMath::Sqrt(  TMath::Power(particle->Xv() - values[AliDielectronVarManager::kXvPrim],2)
                                                                          + TMath::Power(particle->Yv() - values[AliDielectronVarManager::kYvPrim],2));
     values[AliDielectronVarManager::kDistPrimToSecVtxZMC] = TMath::Abs(particle->Zv() - values[AliDielectronVarManager::kZvPrim]);
@@ -1623,6 +1650,7 @@ inline void AliDielectronVarManager::FillVarMCParticle2(const AliVParticle *p1,
   //
   // fill 2 track information starting from MC legs
   //
+  Context *ctx = GetContext();
   values[AliDielectronVarManager::kNclsITS]       = 0;
   values[AliDielectronVarManager::kITSchi2Cl]     = -1;
   values[AliDielectronVarManager::kNclsTPC]       = 0;
@@ -1708,7 +1736,7 @@ inline void AliDielectronVarManager::FillVarMCParticle2(const AliVParticle *p1,
   //values[AliDielectronVarManager::kMMC] = values[AliDielectronVarManager::kM];
   //values[AliDielectronVarManager::kPtMC] = values[AliDielectronVarManager::kPt];
 
-  if ( fgEvent ) AliDielectronVarManager::Fill(fgEvent, values);
+  if ( ctx->fEvent ) AliDielectronVarManager::Fill(ctx->fEvent, values);
 
   values[AliDielectronVarManager::kThetaHE]   = AliDielectronPair::ThetaPhiCM(p1,p2,kTRUE,  kTRUE);
   values[AliDielectronVarManager::kPhiHE]     = AliDielectronPair::ThetaPhiCM(p1,p2,kTRUE,  kFALSE);
@@ -1728,6 +1756,7 @@ inline void AliDielectronVarManager::FillVarAODMCParticle(const AliAODMCParticle
   //
   // Fill track information available for histogramming into an array
   //
+  Context *ctx = GetContext();
 
   values[AliDielectronVarManager::kNclsITS]       = 0;
   values[AliDielectronVarManager::kITSchi2Cl]     = -1;
@@ -1782,7 +1811,7 @@ inline void AliDielectronVarManager::FillVarAODMCParticle(const AliAODMCParticle
   values[AliDielectronVarManager::kNumberOfDaughters]=mc->NumberOfDaughters(particle);
 
   // using AODMCHEader information
-  AliAODMCHeader *mcHeader = (AliAODMCHeader*)fgEvent->FindListObject(AliAODMCHeader::StdBranchName());
+  AliAODMCHeader *mcHeader = (AliAODMCHeader*)ctx->fEvent->FindListObject(AliAODMCHeader::StdBranchName());
   if(mcHeader) {
     values[AliDielectronVarManager::kImpactParZ]  = mcHeader->GetVtxZ()-particle->Zv();
     values[AliDielectronVarManager::kImpactParXY] = TMath::Sqrt(TMath::Power(mcHeader->GetVtxX()-particle->Xv(),2) +
@@ -1796,6 +1825,7 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   //
   // Fill pair information available for histogramming into an array
   //
+  Context *ctx = GetContext();
 
   values[AliDielectronVarManager::kPdgCode]=-1;
   values[AliDielectronVarManager::kPdgCodeMother]=-1;
@@ -1827,7 +1857,7 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   Double_t phiHE=0;
   Double_t thetaCS=0;
   Double_t phiCS=0;
-  if(Req(kThetaHE) || Req(kPhiHE) || Req(kThetaCS) || Req(kPhiCS)) {
+  if(Req(ctx,kThetaHE) || Req(ctx,kPhiHE) || Req(ctx,kThetaCS) || Req(ctx,kPhiCS)) {
     pair->GetThetaPhiCM(thetaHE,phiHE,thetaCS,phiCS);
 
     values[AliDielectronVarManager::kThetaHE]      = thetaHE;
@@ -1842,39 +1872,39 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
     values[AliDielectronVarManager::kCosTilPhiCS]  = (thetaCS>0)?(TMath::Cos(phiCS-TMath::Pi()/4.)):(TMath::Cos(phiCS-3*TMath::Pi()/4.));
   }
 
-  if(Req(kChi2NDF))          values[AliDielectronVarManager::kChi2NDF]          = kfPair.GetChi2()/kfPair.GetNDF();
-  if(Req(kDecayLength))      values[AliDielectronVarManager::kDecayLength]      = kfPair.GetDecayLength();
-  if(Req(kR))                values[AliDielectronVarManager::kR]                = kfPair.GetR();
-  if(Req(kOpeningAngle))     values[AliDielectronVarManager::kOpeningAngle]     = pair->OpeningAngle();
-  if(Req(kOpeningAngleXY))     values[AliDielectronVarManager::kOpeningAngleXY] = pair->OpeningAngleXY();
-  if(Req(kOpeningAngleRZ))     values[AliDielectronVarManager::kOpeningAngleRZ] = pair->OpeningAngleRZ();
-  if(Req(kCosPointingAngle)) values[AliDielectronVarManager::kCosPointingAngle] = fgEvent ? pair->GetCosPointingAngle(fgEvent->GetPrimaryVertex()) : -1;
+  if(Req(ctx,kChi2NDF))          values[AliDielectronVarManager::kChi2NDF]          = kfPair.GetChi2()/kfPair.GetNDF();
+  if(Req(ctx,kDecayLength))      values[AliDielectronVarManager::kDecayLength]      = kfPair.GetDecayLength();
+  if(Req(ctx,kR))                values[AliDielectronVarManager::kR]                = kfPair.GetR();
+  if(Req(ctx,kOpeningAngle))     values[AliDielectronVarManager::kOpeningAngle]     = pair->OpeningAngle();
+  if(Req(ctx,kOpeningAngleXY))     values[AliDielectronVarManager::kOpeningAngleXY] = pair->OpeningAngleXY();
+  if(Req(ctx,kOpeningAngleRZ))     values[AliDielectronVarManager::kOpeningAngleRZ] = pair->OpeningAngleRZ();
+  if(Req(ctx,kCosPointingAngle)) values[AliDielectronVarManager::kCosPointingAngle] = ctx->fEvent ? pair->GetCosPointingAngle(ctx->fEvent->GetPrimaryVertex()) : -1;
 
-  if(Req(kLegDist))   values[AliDielectronVarManager::kLegDist]      = pair->DistanceDaughters();
-  if(Req(kLegDistXY)) values[AliDielectronVarManager::kLegDistXY]    = pair->DistanceDaughtersXY();
-  if(Req(kDeltaEta))  values[AliDielectronVarManager::kDeltaEta]     = pair->DeltaEta();
-  if(Req(kDeltaPhi))  values[AliDielectronVarManager::kDeltaPhi]     = pair->DeltaPhi();
-  if(Req(kMerr))      values[AliDielectronVarManager::kMerr]         = kfPair.GetErrMass()>1e-30&&kfPair.GetMass()>1e-30?kfPair.GetErrMass()/kfPair.GetMass():1000000;
+  if(Req(ctx,kLegDist))   values[AliDielectronVarManager::kLegDist]      = pair->DistanceDaughters();
+  if(Req(ctx,kLegDistXY)) values[AliDielectronVarManager::kLegDistXY]    = pair->DistanceDaughtersXY();
+  if(Req(ctx,kDeltaEta))  values[AliDielectronVarManager::kDeltaEta]     = pair->DeltaEta();
+  if(Req(ctx,kDeltaPhi))  values[AliDielectronVarManager::kDeltaPhi]     = pair->DeltaPhi();
+  if(Req(ctx,kMerr))      values[AliDielectronVarManager::kMerr]         = kfPair.GetErrMass()>1e-30&&kfPair.GetMass()>1e-30?kfPair.GetErrMass()/kfPair.GetMass():1000000;
 
   values[AliDielectronVarManager::kPairType]     = pair->GetType();
   // Armenteros-Podolanski quantities
-  if(Req(kArmAlpha)) values[AliDielectronVarManager::kArmAlpha]     = pair->GetArmAlpha();
-  if(Req(kArmPt))    values[AliDielectronVarManager::kArmPt]        = pair->GetArmPt();
-
-  if(Req(kPsiPair))  values[AliDielectronVarManager::kPsiPair]      = fgEvent ? pair->PsiPair(fgEvent->GetMagneticField()) : -5;
-  if(Req(kPhivPair)) values[AliDielectronVarManager::kPhivPair]      = fgEvent ? pair->PhivPair(fgEvent->GetMagneticField()) : -5;
-  if(Req(kDeltaCotTheta)) values[kDeltaCotTheta] =  pair->DeltaCotTheta();
-  if(Req(kTriangularConversionCut)) values[AliDielectronVarManager::kTriangularConversionCut] = fgEvent ? pair->PhivPair(fgEvent->GetMagneticField()) - 21. * pair->M() : -999.;
-  if(Req(kPseudoProperTime) || Req(kPseudoProperTimeErr)) {
+  if(Req(ctx,kArmAlpha)) values[AliDielectronVarManager::kArmAlpha]     = pair->GetArmAlpha();
+  if(Req(ctx,kArmPt))    values[AliDielectronVarManager::kArmPt]        = pair->GetArmPt();
+
+  if(Req(ctx,kPsiPair))  values[AliDielectronVarManager::kPsiPair]      = ctx->fEvent ? pair->PsiPair(ctx->fEvent->GetMagneticField()) : -5;
+  if(Req(ctx,kPhivPair)) values[AliDielectronVarManager::kPhivPair]      = ctx->fEvent ? pair->PhivPair(ctx->fEvent->GetMagneticField()) : -5;
+  if(Req(ctx,kDeltaCotTheta)) values[kDeltaCotTheta] =  pair->DeltaCotTheta();
+  if(Req(ctx,kTriangularConversionCut)) values[AliDielectronVarManager::kTriangularConversionCut] = ctx->fEvent ? pair->PhivPair(ctx->fEvent->GetMagneticField()) - 21. * pair->M() : -999.;
+  if(Req(ctx,kPseudoProperTime) || Req(ctx,kPseudoProperTimeErr)) {
     values[AliDielectronVarManager::kPseudoProperTime] =
-      fgEvent ? kfPair.GetPseudoProperDecayTime(*(fgEvent->GetPrimaryVertex()), TDatabasePDG::Instance()->GetParticle(443)->Mass(), &errPseudoProperTime2 ) : -1e10;
-  // values[AliDielectronVarManager::kPseudoProperTime] = fgEvent ? pair->GetPseudoProperTime(fgEvent->GetPrimaryVertex()): -1e10;
+      ctx->fEvent ? kfPair.GetPseudoProperDecayTime(*(ctx->fEvent->GetPrimaryVertex()), TDatabasePDG::Instance()->GetParticle(443)->Mass(), &errPseudoProperTime2 ) : -1e10;
+  // values[AliDielectronVarManager::kPseudoProperTime] = ctx->fEvent ? pair->GetPseudoProperTime(ctx->fEvent->GetPrimaryVertex()): -1e10;
     values[AliDielectronVarManager::kPseudoProperTimeErr] = (errPseudoProperTime2 > 0) ? TMath::Sqrt(errPseudoProperTime2) : -1e10;
   }
 
   // impact parameter
   Double_t d0z0[2]={-999., -999.};
-  if( (Req(kImpactParXY) || Req(kImpactParZ)) && fgEvent) pair->GetDCA(fgEvent->GetPrimaryVertex(), d0z0);
+  if( (Req(ctx,kImpactParXY) || Req(ctx,kImpactParZ)) && ctx->fEvent) pair->GetDCA(ctx->fEvent->GetPrimaryVertex(), d0z0);
   values[AliDielectronVarManager::kImpactParXY]   = d0z0[0];
   values[AliDielectronVarManager::kImpactParZ]    = d0z0[1];
 
@@ -1893,8 +1923,8 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   values[AliDielectronVarManager::kLeg1DCAresXY]     = -999.;
 
   // check if calculation is requested
-  if(Req(kPairDCAsigXY) || Req(kPairDCAsigZ) || Req(kPairDCAabsXY) || Req(kPairDCAabsZ) ||
-     Req(kPairLinDCAsigXY) || Req(kPairLinDCAsigZ) || Req(kPairLinDCAabsXY) || Req(kPairLinDCAabsZ)) {
+  if(Req(ctx,kPairDCAsigXY) || Req(ctx,kPairDCAsigZ) || Req(ctx,kPairDCAabsXY) || Req(ctx,kPairDCAabsZ) ||
+     Req(ctx,kPairLinDCAsigXY) || Req(ctx,kPairLinDCAsigZ) || Req(ctx,kPairLinDCAabsXY) || Req(ctx,kPairLinDCAabsZ)) {
 
     // get track references from pair
     AliVParticle* d1 = pair-> GetFirstDaughterP();
@@ -2043,11 +2073,11 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
 	values[AliDielectronVarManager::kDeltaEta]     = TMath::Abs(feta1 -feta2 );
 	values[AliDielectronVarManager::kDeltaPhi]     = lv1.DeltaPhi(lv2);
 
-       if( Req(kDeltaPhiChargeOrdered) && fgEvent ) values[AliDielectronVarManager::kDeltaPhiChargeOrdered] = fD1.GetQ() * fgEvent->GetMagneticField() > 0 ? lv1.Phi() - lv2.Phi() :lv2.Phi() - lv1.Phi() ;
+       if( Req(ctx,kDeltaPhiChargeOrdered) && ctx->fEvent ) values[AliDielectronVarManager::kDeltaPhiChargeOrdered] = fD1.GetQ() * ctx->fEvent->GetMagneticField() > 0 ? lv1.Phi() - lv2.Phi() :lv2.Phi() - lv1.Phi() ;
 	values[AliDielectronVarManager::kPairType]     = pair->GetType();
 
         // Calculate pair variables for corresponding generated pair
-        if(AliDielectronMC::Instance()->HasMC() && (Req(kMMC)||Req(kPtMC)||Req(kPMC)||Req(kEtaMC)||Req(kPhiMC))){
+        if(AliDielectronMC::Instance()->HasMC() && (Req(ctx,kMMC)||Req(ctx,kPtMC)||Req(ctx,kPMC)||Req(ctx,kEtaMC)||Req(ctx,kPhiMC))){
           values[AliDielectronVarManager::kMMC]   = -999.;
           values[AliDielectronVarManager::kPtMC]  = -999.;
           values[AliDielectronVarManager::kPMC]   = -999.;
@@ -2095,14 +2125,14 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
 
 	 */
 
-    if(Req(kOpeningAngleCorr)) {
+    if(Req(ctx,kOpeningAngleCorr)) {
       Float_t a = 1.54e-01;
       values[AliDielectronVarManager::kOpeningAngleCorr]  =
         values[AliDielectronVarManager::kOpeningAngle]
         - a * TMath::Sqrt(  values[AliDielectronVarManager::kPairDCAabsXY] * values[AliDielectronVarManager::kOneOverPt] );
     }
 
-    if(Req(kMCorr)) {
+    if(Req(ctx,kMCorr)) {
       Float_t a =  7.59e-02;
       values[AliDielectronVarManager::kMCorr]  =
         values[AliDielectronVarManager::kM]
@@ -2114,21 +2144,21 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
 
   // Flow quantities
   Double_t phi=values[AliDielectronVarManager::kPhi];
-  if(Req(kCosPhiH2)) values[AliDielectronVarManager::kCosPhiH2] = TMath::Cos(2*phi);
-  if(Req(kSinPhiH2)) values[AliDielectronVarManager::kSinPhiH2] = TMath::Sin(2*phi);
+  if(Req(ctx,kCosPhiH2)) values[AliDielectronVarManager::kCosPhiH2] = TMath::Cos(2*phi);
+  if(Req(ctx,kSinPhiH2)) values[AliDielectronVarManager::kSinPhiH2] = TMath::Sin(2*phi);
   Double_t delta=0.0;
   // v2 with respect to VZERO-A event plane
-  delta = TVector2::Phi_mpi_pi(phi - fgData[AliDielectronVarManager::kV0ArpH2]);
-  if(Req(kV0ArpH2FlowV2))   values[AliDielectronVarManager::kV0ArpH2FlowV2] = TMath::Cos(2.0*delta);  // 2nd harmonic flow coefficient
-  if(Req(kDeltaPhiV0ArpH2)) values[AliDielectronVarManager::kDeltaPhiV0ArpH2] = delta;
+  delta = TVector2::Phi_mpi_pi(phi - ctx->fData[AliDielectronVarManager::kV0ArpH2]);
+  if(Req(ctx,kV0ArpH2FlowV2))   values[AliDielectronVarManager::kV0ArpH2FlowV2] = TMath::Cos(2.0*delta);  // 2nd harmonic flow coefficient
+  if(Req(ctx,kDeltaPhiV0ArpH2)) values[AliDielectronVarManager::kDeltaPhiV0ArpH2] = delta;
   // v2 with respect to VZERO-C event plane
-  delta = TVector2::Phi_mpi_pi(phi - fgData[AliDielectronVarManager::kV0CrpH2]);
-  if(Req(kV0CrpH2FlowV2))   values[AliDielectronVarManager::kV0CrpH2FlowV2] = TMath::Cos(2.0*delta);  // 2nd harmonic flow coefficient
-  if(Req(kDeltaPhiV0CrpH2)) values[AliDielectronVarManager::kDeltaPhiV0CrpH2] = delta;
+  delta = TVector2::Phi_mpi_pi(phi - ctx->fData[AliDielectronVarManager::kV0CrpH2]);
+  if(Req(ctx,kV0CrpH2FlowV2))   values[AliDielectronVarManager::kV0CrpH2FlowV2] = TMath::Cos(2.0*delta);  // 2nd harmonic flow coefficient
+  if(Req(ctx,kDeltaPhiV0CrpH2)) values[AliDielectronVarManager::kDeltaPhiV0CrpH2] = delta;
   // v2 with respect to the combined VZERO-A and VZERO-C event plane
-  delta = TVector2::Phi_mpi_pi(phi - fgData[AliDielectronVarManager::kV0ACrpH2]);
-  if(Req(kV0ACrpH2FlowV2))   values[AliDielectronVarManager::kV0ACrpH2FlowV2] = TMath::Cos(2.0*delta);  // 2nd harmonic flow coefficient
-  if(Req(kDeltaPhiV0ACrpH2)) values[AliDielectronVarManager::kDeltaPhiV0ACrpH2] = delta;
+  delta = TVector2::Phi_mpi_pi(phi - ctx->fData[AliDielectronVarManager::kV0ACrpH2]);
+  if(Req(ctx,kV0ACrpH2FlowV2))   values[AliDielectronVarManager::kV0ACrpH2FlowV2] = TMath::Cos(2.0*delta);  // 2nd harmonic flow coefficient
+  if(Req(ctx,kDeltaPhiV0ACrpH2)) values[AliDielectronVarManager::kDeltaPhiV0ACrpH2] = delta;
 
 
   // quantities using the values of  AliEPSelectionTask , interval [-pi,+pi]
@@ -2143,23 +2173,23 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   values[AliDielectronVarManager::kTPCrpH2FlowV2Sin] = TMath::Sin( 2.*values[AliDielectronVarManager::kDeltaPhiTPCrpH2] );
 
   //calculate inner product of strong Mag and ee plane
-  if(Req(kPairPlaneMagInPro)) values[AliDielectronVarManager::kPairPlaneMagInPro] = pair->PairPlaneMagInnerProduct(values[AliDielectronVarManager::kZDCACrpH1]);
+  if(Req(ctx,kPairPlaneMagInPro)) values[AliDielectronVarManager::kPairPlaneMagInPro] = pair->PairPlaneMagInnerProduct(values[AliDielectronVarManager::kZDCACrpH1]);
 
   //Calculate the angle between electrons decay plane and variables 1-4
-  if(Req(kPairPlaneAngle1A)) values[AliDielectronVarManager::kPairPlaneAngle1A] = pair->GetPairPlaneAngle(values[kv0ArpH2],1);
-  if(Req(kPairPlaneAngle2A)) values[AliDielectronVarManager::kPairPlaneAngle2A] = pair->GetPairPlaneAngle(values[kv0ArpH2],2);
-  if(Req(kPairPlaneAngle3A)) values[AliDielectronVarManager::kPairPlaneAngle3A] = pair->GetPairPlaneAngle(values[kv0ArpH2],3);
-  if(Req(kPairPlaneAngle4A)) values[AliDielectronVarManager::kPairPlaneAngle4A] = pair->GetPairPlaneAngle(values[kv0ArpH2],4);
+  if(Req(ctx,kPairPlaneAngle1A)) values[AliDielectronVarManager::kPairPlaneAngle1A] = pair->GetPairPlaneAngle(values[kv0ArpH2],1);
+  if(Req(ctx,kPairPlaneAngle2A)) values[AliDielectronVarManager::kPairPlaneAngle2A] = pair->GetPairPlaneAngle(values[kv0ArpH2],2);
+  if(Req(ctx,kPairPlaneAngle3A)) values[AliDielectronVarManager::kPairPlaneAngle3A] = pair->GetPairPlaneAngle(values[kv0ArpH2],3);
+  if(Req(ctx,kPairPlaneAngle4A)) values[AliDielectronVarManager::kPairPlaneAngle4A] = pair->GetPairPlaneAngle(values[kv0ArpH2],4);
 
-  if(Req(kPairPlaneAngle1C)) values[AliDielectronVarManager::kPairPlaneAngle1C] = pair->GetPairPlaneAngle(values[kv0CrpH2],1);
-  if(Req(kPairPlaneAngle2C)) values[AliDielectronVarManager::kPairPlaneAngle2C] = pair->GetPairPlaneAngle(values[kv0CrpH2],2);
-  if(Req(kPairPlaneAngle3C)) values[AliDielectronVarManager::kPairPlaneAngle3C] = pair->GetPairPlaneAngle(values[kv0CrpH2],3);
-  if(Req(kPairPlaneAngle4C)) values[AliDielectronVarManager::kPairPlaneAngle4C] = pair->GetPairPlaneAngle(values[kv0CrpH2],4);
+  if(Req(ctx,kPairPlaneAngle1C)) values[AliDielectronVarManager::kPairPlaneAngle1C] = pair->GetPairPlaneAngle(values[kv0CrpH2],1);
+  if(Req(ctx,kPairPlaneAngle2C)) values[AliDielectronVarManager::kPairPlaneAngle2C] = pair->GetPairPlaneAngle(values[kv0CrpH2],2);
+  if(Req(ctx,kPairPlaneAngle3C)) values[AliDielectronVarManager::kPairPlaneAngle3C] = pair->GetPairPlaneAngle(values[kv0CrpH2],3);
+  if(Req(ctx,kPairPlaneAngle4C)) values[AliDielectronVarManager::kPairPlaneAngle4C] = pair->GetPairPlaneAngle(values[kv0CrpH2],4);
 
-  if(Req(kPairPlaneAngle1AC)) values[AliDielectronVarManager::kPairPlaneAngle1AC] = pair->GetPairPlaneAngle(values[kv0ACrpH2],1);
-  if(Req(kPairPlaneAngle2AC)) values[AliDielectronVarManager::kPairPlaneAngle2AC] = pair->GetPairPlaneAngle(values[kv0ACrpH2],2);
-  if(Req(kPairPlaneAngle3AC)) values[AliDielectronVarManager::kPairPlaneAngle3AC] = pair->GetPairPlaneAngle(values[kv0ACrpH2],3);
-  if(Req(kPairPlaneAngle4AC)) values[AliDielectronVarManager::kPairPlaneAngle4AC] = pair->GetPairPlaneAngle(values[kv0ACrpH2],4);
+  if(Req(ctx,kPairPlaneAngle1AC)) values[AliDielectronVarManager::kPairPlaneAngle1AC] = pair->GetPairPlaneAngle(values[kv0ACrpH2],1);
+  if(Req(ctx,kPairPlaneAngle2AC)) values[AliDielectronVarManager::kPairPlaneAngle2AC] = pair->GetPairPlaneAngle(values[kv0ACrpH2],2);
+  if(Req(ctx,kPairPlaneAngle3AC)) values[AliDielectronVarManager::kPairPlaneAngle3AC] = pair->GetPairPlaneAngle(values[kv0ACrpH2],3);
+  if(Req(ctx,kPairPlaneAngle4AC)) values[AliDielectronVarManager::kPairPlaneAngle4AC] = pair->GetPairPlaneAngle(values[kv0ACrpH2],4);
 
   //Random reaction plane
   values[AliDielectronVarManager::kRandomRP] = gRandom->Uniform(-TMath::Pi()/2.0,TMath::Pi()/2.0);
@@ -2169,38 +2199,38 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   if ( values[AliDielectronVarManager::kDeltaPhiRandomRP] > TMath::Pi() )
     values[AliDielectronVarManager::kDeltaPhiRandomRP] -= TMath::TwoPi();
 
-  if(Req(kPairPlaneAngle1Ran)) values[AliDielectronVarManager::kPairPlaneAngle1Ran]= pair->GetPairPlaneAngle(values[kRandomRP],1);
-  if(Req(kPairPlaneAngle2Ran)) values[AliDielectronVarManager::kPairPlaneAngle2Ran]= pair->GetPairPlaneAngle(values[kRandomRP],2);
-  if(Req(kPairPlaneAngle3Ran)) values[AliDielectronVarManager::kPairPlaneAngle3Ran]= pair->GetPairPlaneAngle(values[kRandomRP],3);
-  if(Req(kPairPlaneAngle4Ran)) values[AliDielectronVarManager::kPairPlaneAngle4Ran]= pair->GetPairPlaneAngle(values[kRandomRP],4);
+  if(Req(ctx,kPairPlaneAngle1Ran)) values[AliDielectronVarManager::kPairPlaneAngle1Ran]= pair->GetPairPlaneAngle(values[kRandomRP],1);
+  if(Req(ctx,kPairPlaneAngle2Ran)) values[AliDielectronVarManager::kPairPlaneAngle2Ran]= pair->GetPairPlaneAngle(values[kRandomRP],2);
+  if(Req(ctx,kPairPlaneAngle3Ran)) values[AliDielectronVarManager::kPairPlaneAngle3Ran]= pair->GetPairPlaneAngle(values[kRandomRP],3);
+  if(Req(ctx,kPairPlaneAngle4Ran)) values[AliDielectronVarManager::kPairPlaneAngle4Ran]= pair->GetPairPlaneAngle(values[kRandomRP],4);
 
   // Calculate v2 of Jpsi using the EP from the 2016 est. qVecQnFramework
   Double_t qnTPCeventplane = values[AliDielectronVarManager::kQnTPCrpH2];
-  if(fgEventPlaneACremoval)
-    if(fgQnEPacRemoval->IsSelected(pair)){
+  if(ctx->fEventPlaneACremoval)
+    if(ctx->fQnEPacRemoval->IsSelected(pair)){
       AliAnalysisManager *man=AliAnalysisManager::GetAnalysisManager();
       if( AliAnalysisTaskFlowVectorCorrections *flowQnVectorTask = dynamic_cast<AliAnalysisTaskFlowVectorCorrections*> (man->GetTask("FlowQnVectorCorrections")) ){
         if(flowQnVectorTask != NULL){
           AliQnCorrectionsManager *flowQnVectorMgr = flowQnVectorTask->GetAliQnCorrectionsManager();
           TList *qnlist = flowQnVectorMgr->GetQnVectorList();
           if(qnlist != NULL){
-            qnTPCeventplane = fgQnEPacRemoval->GetACcorrectedQnTPCEventplane(pair, qnlist); // Remove auto correlations from the eventplane for the given pair
+            qnTPCeventplane = ctx->fQnEPacRemoval->GetACcorrectedQnTPCEventplane(pair, qnlist); // Remove auto correlations from the eventplane for the given pair
           }
           if(TMath::AreEqualRel(qnTPCeventplane, -999., 1e-12)) qnTPCeventplane = values[AliDielectronVarManager::kQnTPCrpH2];
         }
       }
     }
 
-  if(Req(kQnDeltaPhiTPCrpH2) || Req(kQnTPCrpH2FlowV2))   values[AliDielectronVarManager::kQnDeltaPhiTPCrpH2]  = TVector2::Phi_mpi_pi(phi - qnTPCeventplane);
-  if(Req(kQnDeltaPhiV0ArpH2) || Req(kQnV0ArpH2FlowV2))   values[AliDielectronVarManager::kQnDeltaPhiV0ArpH2]  = TVector2::Phi_mpi_pi(phi - values[AliDielectronVarManager::kQnV0ArpH2]);
-  if(Req(kQnDeltaPhiV0CrpH2) || Req(kQnV0CrpH2FlowV2))   values[AliDielectronVarManager::kQnDeltaPhiV0CrpH2]  = TVector2::Phi_mpi_pi(phi - values[AliDielectronVarManager::kQnV0CrpH2]);
-  if(Req(kQnDeltaPhiV0rpH2) || Req(kQnV0rpH2FlowV2))   values[AliDielectronVarManager::kQnDeltaPhiV0rpH2]  = TVector2::Phi_mpi_pi(phi - values[AliDielectronVarManager::kQnV0rpH2]);
-  if(Req(kQnDeltaPhiSPDrpH2) || Req(kQnSPDrpH2FlowV2))   values[AliDielectronVarManager::kQnDeltaPhiSPDrpH2]  = TVector2::Phi_mpi_pi(phi - values[AliDielectronVarManager::kQnSPDrpH2]);
-  if(Req(kQnTPCrpH2FlowV2)) values[AliDielectronVarManager::kQnTPCrpH2FlowV2]    = TMath::Cos( 2.*values[AliDielectronVarManager::kQnDeltaPhiTPCrpH2] );
-  if(Req(kQnV0ArpH2FlowV2)) values[AliDielectronVarManager::kQnV0ArpH2FlowV2]    = TMath::Cos( 2.*values[AliDielectronVarManager::kQnDeltaPhiV0ArpH2] );
-  if(Req(kQnV0CrpH2FlowV2)) values[AliDielectronVarManager::kQnV0CrpH2FlowV2]    = TMath::Cos( 2.*values[AliDielectronVarManager::kQnDeltaPhiV0CrpH2] );
-  if(Req(kQnV0rpH2FlowV2)) values[AliDielectronVarManager::kQnV0rpH2FlowV2]    = TMath::Cos( 2.*values[AliDielectronVarManager::kQnDeltaPhiV0rpH2] );
-  if(Req(kQnSPDrpH2FlowV2)) values[AliDielectronVarManager::kQnSPDrpH2FlowV2]    = TMath::Cos( 2.*values[AliDielectronVarManager::kQnDeltaPhiSPDrpH2] );
+  if(Req(ctx,kQnDeltaPhiTPCrpH2) || Req(ctx,kQnTPCrpH2FlowV2))   values[AliDielectronVarManager::kQnDeltaPhiTPCrpH2]  = TVector2::Phi_mpi_pi(phi - qnTPCeventplane);
+  if(Req(ctx,kQnDeltaPhiV0ArpH2) || Req(ctx,kQnV0ArpH2FlowV2))   values[AliDielectronVarManager::kQnDeltaPhiV0ArpH2]  = TVector2::Phi_mpi_pi(phi - values[AliDielectronVarManager::kQnV0ArpH2]);
+  if(Req(ctx,kQnDeltaPhiV0CrpH2) || Req(ctx,kQnV0CrpH2FlowV2))   values[AliDielectronVarManager::kQnDeltaPhiV0CrpH2]  = TVector2::Phi_mpi_pi(phi - values[AliDielectronVarManager::kQnV0CrpH2]);
+  if(Req(ctx,kQnDeltaPhiV0rpH2) || Req(ctx,kQnV0rpH2FlowV2))   values[AliDielectronVarManager::kQnDeltaPhiV0rpH2]  = TVector2::Phi_mpi_pi(phi - values[AliDielectronVarManager::kQnV0rpH2]);
+  if(Req(ctx,kQnDeltaPhiSPDrpH2) || Req(ctx,kQnSPDrpH2FlowV2))   values[AliDielectronVarManager::kQnDeltaPhiSPDrpH2]  = TVector2::Phi_mpi_pi(phi - values[AliDielectronVarManager::kQnSPDrpH2]);
+  if(Req(ctx,kQnTPCrpH2FlowV2)) values[AliDielectronVarManager::kQnTPCrpH2FlowV2]    = TMath::Cos( 2.*values[AliDielectronVarManager::kQnDeltaPhiTPCrpH2] );
+  if(Req(ctx,kQnV0ArpH2FlowV2)) values[AliDielectronVarManager::kQnV0ArpH2FlowV2]    = TMath::Cos( 2.*values[AliDielectronVarManager::kQnDeltaPhiV0ArpH2] );
+  if(Req(ctx,kQnV0CrpH2FlowV2)) values[AliDielectronVarManager::kQnV0CrpH2FlowV2]    = TMath::Cos( 2.*values[AliDielectronVarManager::kQnDeltaPhiV0CrpH2] );
+  if(Req(ctx,kQnV0rpH2FlowV2)) values[AliDielectronVarManager::kQnV0rpH2FlowV2]    = TMath::Cos( 2.*values[AliDielectronVarManager::kQnDeltaPhiV0rpH2] );
+  if(Req(ctx,kQnSPDrpH2FlowV2)) values[AliDielectronVarManager::kQnSPDrpH2FlowV2]    = TMath::Cos( 2.*values[AliDielectronVarManager::kQnDeltaPhiSPDrpH2] );
 
   AliDielectronMC *mc=AliDielectronMC::Instance();
 
@@ -2213,11 +2243,11 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
     // fill kPseudoProperTimeResolution
     values[AliDielectronVarManager::kPseudoProperTimeResolution] = -1e10;
     // values[AliDielectronVarManager::kPseudoProperTimePull] = -1e10;
-    if(samemother && fgEvent) {
+    if(samemother && ctx->fEvent) {
       if(pair->GetFirstDaughterP()->GetLabel() > 0) {
         const AliVParticle *motherMC = 0x0;
-        if(fgEvent->IsA() == AliESDEvent::Class())  motherMC = (AliMCParticle*)mc->GetMCTrackMother((AliESDtrack*)pair->GetFirstDaughterP());
-        else if(fgEvent->IsA() == AliAODEvent::Class())  motherMC = (AliAODMCParticle*)mc->GetMCTrackMother((AliAODTrack*)pair->GetFirstDaughterP());
+        if(ctx->fEvent->IsA() == AliESDEvent::Class())  motherMC = (AliMCParticle*)mc->GetMCTrackMother((AliESDtrack*)pair->GetFirstDaughterP());
+        else if(ctx->fEvent->IsA() == AliAODEvent::Class())  motherMC = (AliAODMCParticle*)mc->GetMCTrackMother((AliAODTrack*)pair->GetFirstDaughterP());
         Double_t vtxX, vtxY, vtxZ;
 	if(motherMC && mc->GetPrimaryVertex(vtxX,vtxY,vtxZ)) {
 	  Int_t motherLbl = motherMC->GetLabel();
@@ -2233,7 +2263,7 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
     }
 
 	values[AliDielectronVarManager::kTRDpidEffPair] = 0.;
-	if (fgTRDpidEff[0][0]){
+	if (ctx->fTRDpidEff[0][0]){
 	  Double_t valuesLeg1[AliDielectronVarManager::kNMaxValues];
 	  Double_t valuesLeg2[AliDielectronVarManager::kNMaxValues];
 	  AliVParticle* leg1 = pair->GetFirstDaughterP();
@@ -2264,15 +2294,15 @@ inline void AliDielectronVarManager::FillVarDielectronPair(const AliDielectronPa
   values[AliDielectronVarManager::kPairEff]=0.0;
   values[AliDielectronVarManager::kOneOverPairEff]=0.0;
   values[AliDielectronVarManager::kOneOverPairEffSq]=0.0;
-  if (leg1 && leg2 && fgLegEffMap) {
+  if (leg1 && leg2 && ctx->fLegEffMap) {
     Fill(leg1, valuesLeg1);
     Fill(leg2, valuesLeg2);
     values[AliDielectronVarManager::kPairEff] = valuesLeg1[AliDielectronVarManager::kLegEff] *valuesLeg2[AliDielectronVarManager::kLegEff];
   }
-  else if(fgPairEffMap) {
+  else if(ctx->fPairEffMap) {
     values[AliDielectronVarManager::kPairEff] = GetPairEff(values);
   }
-  if(fgLegEffMap || fgPairEffMap) {
+  if(ctx->fLegEffMap || ctx->fPairEffMap) {
     values[AliDielectronVarManager::kOneOverPairEff] = (values[AliDielectronVarManager::kPairEff]>0.0 ? 1./values[AliDielectronVarManager::kPairEff] : 1.0);
     values[AliDielectronVarManager::kOneOverPairEffSq] = (values[AliDielectronVarManager::kPairEff]>0.0 ? 1./values[AliDielectronVarManager::kPairEff]/values[AliDielectronVarManager::kPairEff] : 1.0);
   }
@@ -2285,6 +2315,7 @@ inline void AliDielectronVarManager::FillVarKFParticle(const AliKFParticle *part
   //
   // Fill track information available in AliVParticle into an array
   //
+  Context *ctx = GetContext();
   values[AliDielectronVarManager::kPx]        = particle->GetPx();
   values[AliDielectronVarManager::kPy]        = particle->GetPy();
   values[AliDielectronVarManager::kPz]        = particle->GetPz();
@@ -2345,9 +2376,9 @@ inline void AliDielectronVarManager::FillVarKFParticle(const AliKFParticle *part
   values[AliDielectronVarManager::kHasCocktailMother]=0;
   values[AliDielectronVarManager::kHasCocktailGrandMother]=0;
 
-//   if ( fgEvent ) AliDielectronVarManager::Fill(fgEvent, values);
+//   if ( ctx->fEvent ) AliDielectronVarManager::Fill(ctx->fEvent, values);
   for (Int_t i=AliDielectronVarManager::kPairMax; i<AliDielectronVarManager::kNMaxValues; ++i)
-    values[i]=fgData[i];
+    values[i]=ctx->fData[i];
 
 }
 
@@ -2356,12 +2387,13 @@ inline void AliDielectronVarManager::FillVarVEvent(const AliVEvent *event, Doubl
   //
   // Fill event information available for histogramming into an array
   //
+  Context *ctx = GetContext();
   values[AliDielectronVarManager::kRunNumber]    = event->GetRunNumber();
-  if(fgCurrentRun!=event->GetRunNumber()) {
-    if(fgVZEROCalibrationFile.Contains(".root")) InitVZEROCalibrationHistograms(event->GetRunNumber());
-    if(fgVZERORecenteringFile.Contains(".root")) InitVZERORecenteringHistograms(event->GetRunNumber());
-    if(fgZDCRecenteringFile.Contains(".root")) InitZDCRecenteringHistograms(event->GetRunNumber());
-    fgCurrentRun=event->GetRunNumber();
+  if(ctx->fCurrentRun!=event->GetRunNumber()) {
+    if(ctx->fVZEROCalibrationFile.Contains(".root")) InitVZEROCalibrationHistograms(event->GetRunNumber());
+    if(ctx->fVZERORecenteringFile.Contains(".root")) InitVZERORecenteringHistograms(event->GetRunNumber());
+    if(ctx->fZDCRecenteringFile.Contains(".root")) InitZDCRecenteringHistograms(event->GetRunNumber());
+    ctx->fCurrentRun=event->GetRunNumber();
   }
 
   values[AliDielectronVarManager::kMixingBin]=0;
@@ -2435,41 +2467,41 @@ inline void AliDielectronVarManager::FillVarVEvent(const AliVEvent *event, Doubl
   for(Int_t i=0; i<30; i++) { if(maskOff==BIT(i)) values[AliDielectronVarManager::kTriggerExclOFF]=i; }
 
   values[AliDielectronVarManager::kNTrk]            = event->GetNumberOfTracks();
-  if(Req(kNacc))            values[AliDielectronVarManager::kNacc]            = AliDielectronHelper::GetNacc(event);
+  if(Req(ctx,kNacc))            values[AliDielectronVarManager::kNacc]            = AliDielectronHelper::GetNacc(event);
 
-  if(Req(kMatchEffITSTPCinPlane) || Req(kMatchEffITSTPCoutPlane)){
+  if(Req(ctx,kMatchEffITSTPCinPlane) || Req(ctx,kMatchEffITSTPCoutPlane)){
 
     Double_t efficiencies[2] = {-1.};
     values[AliDielectronVarManager::kMatchEffITSTPC]  = AliDielectronHelper::GetITSTPCMatchEff(event, efficiencies, kTRUE);
     values[AliDielectronVarManager::kMatchEffITSTPCinPlane]  = efficiencies[0];
     values[AliDielectronVarManager::kMatchEffITSTPCoutPlane]  = efficiencies[1];
   }
-  if(Req(kMatchEffITSTPCinPlaneV0C) || Req(kMatchEffITSTPCoutPlaneV0C)){
+  if(Req(ctx,kMatchEffITSTPCinPlaneV0C) || Req(ctx,kMatchEffITSTPCoutPlaneV0C)){
 
     Double_t efficiencies[2] = {-1.};
     values[AliDielectronVarManager::kMatchEffITSTPC]  = AliDielectronHelper::GetITSTPCMatchEff(event, efficiencies, kTRUE, kTRUE);
     values[AliDielectronVarManager::kMatchEffITSTPCinPlaneV0C]  = efficiencies[0];
     values[AliDielectronVarManager::kMatchEffITSTPCoutPlaneV0C]  = efficiencies[1];
   }
-  else if(Req(kMatchEffITSTPC))  values[AliDielectronVarManager::kMatchEffITSTPC]  = AliDielectronHelper::GetITSTPCMatchEff(event);
-  if(Req(kNaccTrcklts) || Req(kNaccTrckltsCorr))  values[AliDielectronVarManager::kNaccTrcklts]     = AliDielectronHelper::GetNaccTrcklts(event,1.6);
-  if(Req(kNaccTrcklts09))
+  else if(Req(ctx,kMatchEffITSTPC))  values[AliDielectronVarManager::kMatchEffITSTPC]  = AliDielectronHelper::GetITSTPCMatchEff(event);
+  if(Req(ctx,kNaccTrcklts) || Req(ctx,kNaccTrckltsCorr))  values[AliDielectronVarManager::kNaccTrcklts]     = AliDielectronHelper::GetNaccTrcklts(event,1.6);
+  if(Req(ctx,kNaccTrcklts09))
       values[AliDielectronVarManager::kNaccTrcklts09]     = AliDielectronHelper::GetNaccTrcklts(event,0.9);
-  if(Req(kNaccTrcklts10) || Req(kNaccTrcklts10Corr))
+  if(Req(ctx,kNaccTrcklts10) || Req(ctx,kNaccTrcklts10Corr))
     values[AliDielectronVarManager::kNaccTrcklts10]   = AliDielectronHelper::GetNaccTrcklts(event,1.0);
-  if(Req(kNaccTrcklts0916))
+  if(Req(ctx,kNaccTrcklts0916))
     values[AliDielectronVarManager::kNaccTrcklts0916] = AliDielectronHelper::GetNaccTrcklts(event,1.6)-AliDielectronHelper::GetNaccTrcklts(event,.9);
-  if(Req(kNaccTrckltsCorr))
+  if(Req(ctx,kNaccTrckltsCorr))
   values[AliDielectronVarManager::kNaccTrckltsCorr] =
     AliDielectronHelper::GetNaccTrckltsCorrected(event, values[AliDielectronVarManager::kNaccTrcklts],
 						 values[AliDielectronVarManager::kZvPrim],2);
-  if(Req(kNaccTrcklts10Corr))
+  if(Req(ctx,kNaccTrcklts10Corr))
   values[AliDielectronVarManager::kNaccTrcklts10Corr] =
     AliDielectronHelper::GetNaccTrckltsCorrected(event, values[AliDielectronVarManager::kNaccTrcklts10],
 						 values[AliDielectronVarManager::kZvPrim],1);
 
   Double_t ptMaxEv    = -1., phiptMaxEv= -1.;
-  if(Req(kMaxPt) || Req(kPhiMaxPt)) AliDielectronHelper::GetMaxPtAndPhi(event, ptMaxEv, phiptMaxEv);
+  if(Req(ctx,kMaxPt) || Req(ctx,kPhiMaxPt)) AliDielectronHelper::GetMaxPtAndPhi(event, ptMaxEv, phiptMaxEv);
   values[AliDielectronVarManager::kPhiMaxPt]          = phiptMaxEv;
   values[AliDielectronVarManager::kMaxPt]             = ptMaxEv;
 
@@ -2669,6 +2701,7 @@ inline void AliDielectronVarManager::FillVarESDEvent(const AliESDEvent *event, D
   //
   // Fill event information available for histogramming into an array
   //
+  Context *ctx = GetContext();
 
   // Fill common AliVEvent interface information
   FillVarVEvent(event, values);
@@ -2705,7 +2738,7 @@ inline void AliDielectronVarManager::FillVarESDEvent(const AliESDEvent *event, D
 
   // The true vertex is needed for the pair DCA analysis (needs DCA of reco track w.r.t. true vertex).
   if (AliDielectronMC::Instance()->HasMC()){
-    if (Req(kDistPrimToSecVtxXYMC) || Req(kDistPrimToSecVtxZMC) || Req(kXvPrimMCtruth) || Req(kYvPrimMCtruth) || Req(kZvPrimMCtruth)) {
+    if (Req(ctx,kDistPrimToSecVtxXYMC) || Req(ctx,kDistPrimToSecVtxZMC) || Req(ctx,kXvPrimMCtruth) || Req(ctx,kYvPrimMCtruth) || Req(ctx,kZvPrimMCtruth)) {
       AliMCEvent* mcevent = AliDielectronMC::Instance()->GetMCEvent();
       const AliVVertex* mcvtx = (mcevent ? mcevent->GetPrimaryVertex() : 0);
       values[AliDielectronVarManager::kXvPrimMCtruth] = (mcvtx ? mcvtx->GetX() : 0.0);
@@ -2764,6 +2797,7 @@ inline void AliDielectronVarManager::FillVarAODEvent(const AliAODEvent *event, D
   //
   // Fill event information available for histogramming into an array
   //
+  Context *ctx = GetContext();
 
   // Fill common AliVEvent interface information
   FillVarVEvent(event, values);
@@ -2804,13 +2838,13 @@ inline void AliDielectronVarManager::FillVarAODEvent(const AliAODEvent *event, D
 
   values[AliDielectronVarManager::kRefMult]        = header->GetRefMultiplicity();        // similar to Ntrk
   values[AliDielectronVarManager::kRefMultTPConly] = header->GetTPConlyRefMultiplicity(); // similar to Nacc
-  if(Req(kNTPCtrkswITSout)) values[AliDielectronVarManager::kNTPCtrkswITSout] = header->GetNumberOfTPCTracks();
-  if(Req(kNTPCclsEvent)) values[AliDielectronVarManager::kNTPCclsEvent] = header->GetNumberOfTPCClusters();
+  if(Req(ctx,kNTPCtrkswITSout)) values[AliDielectronVarManager::kNTPCtrkswITSout] = header->GetNumberOfTPCTracks();
+  if(Req(ctx,kNTPCclsEvent)) values[AliDielectronVarManager::kNTPCclsEvent] = header->GetNumberOfTPCClusters();
   values[AliDielectronVarManager::kRefMultOvRefMultTPConly] = (values[AliDielectronVarManager::kRefMultTPConly] > 0. ? (values[AliDielectronVarManager::kRefMult]/values[AliDielectronVarManager::kRefMultTPConly]) : 0.);
 
   // The true vertex is needed for the pair DCA analysis (needs DCA of reco track w.r.t. true vertex).
   if (AliDielectronMC::Instance()->HasMC()){
-    if (Req(kDistPrimToSecVtxXYMC) || Req(kDistPrimToSecVtxZMC) || Req(kXvPrimMCtruth) || Req(kYvPrimMCtruth) || Req(kZvPrimMCtruth)) {
+    if (Req(ctx,kDistPrimToSecVtxXYMC) || Req(ctx,kDistPrimToSecVtxZMC) || Req(ctx,kXvPrimMCtruth) || Req(ctx,kYvPrimMCtruth) || Req(ctx,kZvPrimMCtruth)) {
       // @TODO: adopt the code from FillVarESDEvent() for AOD...
       printf("WARNING: filling of MC true vertex not implemented for AOD tracks!\n");
       values[AliDielectronVarManager::kXvPrimMCtruth] = 0.;
@@ -2835,7 +2869,7 @@ inline void AliDielectronVarManager::FillVarAODEvent(const AliAODEvent *event, D
     // TPC
 
     TList *qnlist = (TList*) event->FindListObject("qnVectorList");
-    if((Req(kQnTPCrpH2) || Req(kQnV0rpH2)) && qnlist == NULL){
+    if((Req(ctx,kQnTPCrpH2) || Req(ctx,kQnV0rpH2)) && qnlist == NULL){
       for (Int_t i = AliDielectronVarManager::kQnTPCrpH2; i <= AliDielectronVarManager::kQnCorrFMDAy_FMDCy; i++) {
         values[i] = -999.;
       }
@@ -3001,8 +3035,9 @@ inline void AliDielectronVarManager::InitESDpid(Int_t type)
   // initialize PID parameters
   // type=0 is simulation
   // type=1 is data
+  Context *ctx = GetContext();
 
-  if (!fgPIDResponse) fgPIDResponse=new AliESDpid((Bool_t)(type==0));
+  if (!ctx->fPIDResponse) ctx->fPIDResponse=new AliESDpid((Bool_t)(type==0));
   Double_t alephParameters[5];
   // simulation
   alephParameters[0] = 2.15898e+00/50.;
@@ -3010,7 +3045,7 @@ inline void AliDielectronVarManager::InitESDpid(Int_t type)
   alephParameters[2] = 3.40030e-09;
   alephParameters[3] = 1.96178e+00;
   alephParameters[4] = 3.91720e+00;
-  fgPIDResponse->GetTOFResponse().SetTimeResolution(80.);
+  ctx->fPIDResponse->GetTOFResponse().SetTimeResolution(80.);
 
   // data
   if (type==1){
@@ -3019,20 +3054,21 @@ inline void AliDielectronVarManager::InitESDpid(Int_t type)
     alephParameters[2] = 5.04114e-11;
     alephParameters[3] = 2.12543e+00;
     alephParameters[4] = 4.88663e+00;
-    fgPIDResponse->GetTOFResponse().SetTimeResolution(130.);
-    fgPIDResponse->GetTPCResponse().SetMip(50.);
+    ctx->fPIDResponse->GetTOFResponse().SetTimeResolution(130.);
+    ctx->fPIDResponse->GetTPCResponse().SetMip(50.);
   }
 
-  fgPIDResponse->GetTPCResponse().SetBetheBlochParameters(
+  ctx->fPIDResponse->GetTPCResponse().SetBetheBlochParameters(
     alephParameters[0],alephParameters[1],alephParameters[2],
     alephParameters[3],alephParameters[4]);
 
-  fgPIDResponse->GetTPCResponse().SetSigma(3.79301e-03, 2.21280e+04);
+  ctx->fPIDResponse->GetTPCResponse().SetSigma(3.79301e-03, 2.21280e+04);
 }
 
 inline void AliDielectronVarManager::InitAODpidUtil(Int_t type)
 {
-  if (!fgPIDResponse) fgPIDResponse=new AliAODpidUtil;
+  Context *ctx = GetContext();
+  if (!ctx->fPIDResponse) ctx->fPIDResponse=new AliAODpidUtil;
   Double_t alephParameters[5];
   // simulation
   alephParameters[0] = 2.15898e+00/50.;
@@ -3040,7 +3076,7 @@ inline void AliDielectronVarManager::InitAODpidUtil(Int_t type)
   alephParameters[2] = 3.40030e-09;
   alephParameters[3] = 1.96178e+00;
   alephParameters[4] = 3.91720e+00;
-  fgPIDResponse->GetTOFResponse().SetTimeResolution(80.);
+  ctx->fPIDResponse->GetTOFResponse().SetTimeResolution(80.);
 
   // data
   if (type==1){
@@ -3049,15 +3085,15 @@ inline void AliDielectronVarManager::InitAODpidUtil(Int_t type)
     alephParameters[2] = 5.04114e-11;
     alephParameters[3] = 2.12543e+00;
     alephParameters[4] = 4.88663e+00;
-    fgPIDResponse->GetTOFResponse().SetTimeResolution(130.);
-    fgPIDResponse->GetTPCResponse().SetMip(50.);
+    ctx->fPIDResponse->GetTOFResponse().SetTimeResolution(130.);
+    ctx->fPIDResponse->GetTPCResponse().SetMip(50.);
   }
 
-  fgPIDResponse->GetTPCResponse().SetBetheBlochParameters(
+  ctx->fPIDResponse->GetTPCResponse().SetBetheBlochParameters(
     alephParameters[0],alephParameters[1],alephParameters[2],
     alephParameters[3],alephParameters[4]);
 
-  fgPIDResponse->GetTPCResponse().SetSigma(3.79301e-03, 2.21280e+04);
+  ctx->fPIDResponse->GetTPCResponse().SetSigma(3.79301e-03, 2.21280e+04);
 }
 
 
@@ -3066,6 +3102,7 @@ inline void AliDielectronVarManager::InitEstimatorAvg(const Char_t* filename) //
   //
   // initialize the profile histograms neccessary for the correction of the multiplicity estimators in pp collisions
   //
+  Context *ctx = GetContext();
 
   const Char_t* estimatorNames[9] = {"SPDmult05","SPDmult10","SPDmult16",
 				     "ITSTPC05", "ITSTPC10", "ITSTPC16",
@@ -3076,7 +3113,8 @@ inline void AliDielectronVarManager::InitEstimatorAvg(const Char_t* filename) //
 
   for(Int_t ip=0; ip<7; ++ip) {
     for(Int_t ie=0; ie<9; ++ie) {
-      fgMultEstimatorAvg[ip][ie] = (TProfile*)(file->Get(Form("%s_%s",estimatorNames[ie],periodNames[ip]))->Clone(Form("%s_%s_clone",estimatorNames[ie],periodNames[ip])));
+      ctx->fMultEstimatorAvg[ip][ie] = (TProfile*)(file->Get(Form("%s_%s",estimatorNames[ie],periodNames[ip]))->Clone(Form("%s_%s_clone",estimatorNames[ie],periodNames[ip])));
+      ctx->fMultEstimatorAvg[ip][ie]->SetDirectory(0x0);  // owned by the context
     }
   }
 }
@@ -3088,6 +3126,7 @@ inline void AliDielectronVarManager::InitEstimatorObjArrayAvg(const TObjArray* a
   // initialize the profile histograms neccessary for the correction of the multiplicity estimators in pp collisions
   // SPDmult05 does not exist yet for Pass4 AODs
   // ITS correction maps do not exist yet for Pass4 AODs
+  Context *ctx = GetContext();
 
   const Char_t* estimatorNames[9] = {"SPDmult05","SPDmult10","SPDmult16",
 				     "ITSTPC05", "ITSTPC10", "ITSTPC16",
@@ -3102,13 +3141,15 @@ inline void AliDielectronVarManager::InitEstimatorObjArrayAvg(const TObjArray* a
     for(Int_t ie=0; ie<ieTotal; ++ie) {
       key = Form("%s_%s",estimatorNames[ie],periodNames[ip]);
       if(array->FindObject(key.Data())){
-	fgMultEstimatorAvg[ip][ie] = (TProfile*)(array->FindObject(key.Data()))->Clone((key+"_clone").Data());
+	ctx->fMultEstimatorAvg[ip][ie] = (TProfile*)(array->FindObject(key.Data()))->Clone((key+"_clone").Data());
+	ctx->fMultEstimatorAvg[ip][ie]->SetDirectory(0x0);  // owned by the context
 	continue;
       }
       key += Form("_Pass4_AOD");
       if(array->FindObject(key.Data())){
 	printf("ip = %d, ie = %d\n estimator = %s, period = %s\n key = %s\n", ip, ie, estimatorNames[ie], periodNames[ip], key.Data());
-        fgMultEstimatorAvg[ip][ie] = (TProfile*)(array->FindObject(key.Data()))->Clone((key+"_clone").Data());
+        ctx->fMultEstimatorAvg[ip][ie] = (TProfile*)(array->FindObject(key.Data()))->Clone((key+"_clone").Data());
+        ctx->fMultEstimatorAvg[ip][ie]->SetDirectory(0x0);  // owned by the context
       }
     }
   }
@@ -3118,17 +3159,18 @@ inline void AliDielectronVarManager::InitTRDpidEffHistograms(const Char_t* filen
   //
   // initialize the 3D histograms with the TRD pid efficiency histograms
   //
+  Context *ctx = GetContext();
 
   // reset the centrality ranges and the efficiency histograms
   for(Int_t i=0; i<10; ++i) {         // centrality ranges
-    for(Int_t j=0; j<4; ++j) fgTRDpidEffCentRanges[i][j] = -1.;
-    if(fgTRDpidEff[i][0]) {
-      delete fgTRDpidEff[i][0];
-      fgTRDpidEff[i][0] = 0x0;
+    for(Int_t j=0; j<4; ++j) ctx->fTRDpidEffCentRanges[i][j] = -1.;
+    if(ctx->fTRDpidEff[i][0]) {
+      delete ctx->fTRDpidEff[i][0];
+      ctx->fTRDpidEff[i][0] = 0x0;
     }
-    if(fgTRDpidEff[i][1]) {
-      delete fgTRDpidEff[i][1];
-      fgTRDpidEff[i][1] = 0x0;
+    if(ctx->fTRDpidEff[i][1]) {
+      delete ctx->fTRDpidEff[i][1];
+      ctx->fTRDpidEff[i][1] = 0x0;
     }
   }
 
@@ -3150,15 +3192,17 @@ inline void AliDielectronVarManager::InitTRDpidEffHistograms(const Char_t* filen
     TString centMaxStr = arr->At(3)->GetName();
     delete arr;
     if(isBplus) {
-      fgTRDpidEffCentRanges[idxp][2] = centMinStr.Atof();
-      fgTRDpidEffCentRanges[idxp][3] = centMaxStr.Atof();
-      fgTRDpidEff[idxp][1] = (TH3D*)(file->Get(name.Data())->Clone(Form("%s_clone",name.Data())));
+      ctx->fTRDpidEffCentRanges[idxp][2] = centMinStr.Atof();
+      ctx->fTRDpidEffCentRanges[idxp][3] = centMaxStr.Atof();
+      ctx->fTRDpidEff[idxp][1] = (TH3D*)(file->Get(name.Data())->Clone(Form("%s_clone",name.Data())));
+      ctx->fTRDpidEff[idxp][1]->SetDirectory(0x0);  // owned by the context
       ++idxp;
     }
     else {
-      fgTRDpidEffCentRanges[idxn][0] = centMinStr.Atof();
-      fgTRDpidEffCentRanges[idxn][1] = centMaxStr.Atof();
-      fgTRDpidEff[idxn][0] = (TH3D*)(file->Get(name.Data())->Clone(Form("%s_clone",name.Data())));
+      ctx->fTRDpidEffCentRanges[idxn][0] = centMinStr.Atof();
+      ctx->fTRDpidEffCentRanges[idxn][1] = centMaxStr.Atof();
+      ctx->fTRDpidEff[idxn][0] = (TH3D*)(file->Get(name.Data())->Clone(Form("%s_clone",name.Data())));
+      ctx->fTRDpidEff[idxn][0]->SetDirectory(0x0);  // owned by the context
       ++idxn;
     }
   }
@@ -3168,10 +3212,11 @@ inline Double_t AliDielectronVarManager::GetSingleLegEff(Double_t * const values
   //
   // get the single leg efficiency for a given particle
   //
-  if(!fgLegEffMap) return -1.;
+  Context *ctx = GetContext();
+  if(!ctx->fLegEffMap) return -1.;
 
-  if(fgLegEffMap->InheritsFrom(THnBase::Class())) {
-    THnBase *eff = static_cast<THnBase*>(fgLegEffMap);
+  if(ctx->fLegEffMap->InheritsFrom(THnBase::Class())) {
+    THnBase *eff = static_cast<THnBase*>(ctx->fLegEffMap);
     Int_t dim=eff->GetNdimensions();
     Int_t idx[dim];
     for(Int_t idim=0; idim<dim; idim++) {
@@ -3189,10 +3234,11 @@ inline Double_t AliDielectronVarManager::GetPairEff(Double_t * const values) {
   //
   // get the pair efficiency for given pair kinematics
   //
-  if(!fgPairEffMap) return -1.;
+  Context *ctx = GetContext();
+  if(!ctx->fPairEffMap) return -1.;
 
-  if(fgPairEffMap->IsA()== THnBase::Class()) {
-    THnBase *eff = static_cast<THnBase*>(fgPairEffMap);
+  if(ctx->fPairEffMap->IsA()== THnBase::Class()) {
+    THnBase *eff = static_cast<THnBase*>(ctx->fPairEffMap);
     Int_t dim=eff->GetNdimensions();
     Int_t idx[dim];
     for(Int_t idim=0; idim<dim; idim++) {
@@ -3203,8 +3249,8 @@ inline Double_t AliDielectronVarManager::GetPairEff(Double_t * const values) {
     const Double_t ret=(eff->GetBinContent(idx));
     return ret;
   }
-  if(fgPairEffMap->IsA()== TSpline3::Class()) {
-    TSpline3 *eff = static_cast<TSpline3*>(fgPairEffMap);
+  if(ctx->fPairEffMap->IsA()== TSpline3::Class()) {
+    TSpline3 *eff = static_cast<TSpline3*>(ctx->fPairEffMap);
     if(!eff->GetHistogram()) { printf("no histogram added to the spline\n"); return -1.;}
     UInt_t var = GetValueType(eff->GetHistogram()->GetXaxis()->GetName());
     return (eff->Eval(values[var]));
@@ -3218,21 +3264,22 @@ inline void AliDielectronVarManager::InitVZEROCalibrationHistograms(Int_t runNo)
   //
   // Initialize the VZERO channel-by-channel calibration histograms
   //
+  Context *ctx = GetContext();
 
   //initialize only once
-  if(fgVZEROCalib[0]) return;
+  if(ctx->fVZEROCalib[0]) return;
 
   for(Int_t i=0; i<64; ++i)
-    if(fgVZEROCalib[i]) {
-      delete fgVZEROCalib[i];
-      fgVZEROCalib[i] = 0x0;
+    if(ctx->fVZEROCalib[i]) {
+      delete ctx->fVZEROCalib[i];
+      ctx->fVZEROCalib[i] = 0x0;
     }
 
-  TFile file(fgVZEROCalibrationFile.Data());
+  TFile file(ctx->fVZEROCalibrationFile.Data());
 
   for(Int_t i=0; i<64; ++i){
-    fgVZEROCalib[i] = (TProfile2D*)(file.Get(Form("RUN%d_ch%d_VtxCent", runNo, i)));
-    if (fgVZEROCalib[i]) fgVZEROCalib[i]->SetDirectory(0x0);
+    ctx->fVZEROCalib[i] = (TProfile2D*)(file.Get(Form("RUN%d_ch%d_VtxCent", runNo, i)));
+    if (ctx->fVZEROCalib[i]) ctx->fVZEROCalib[i]->SetDirectory(0x0);
   }
 }
 
@@ -3241,62 +3288,64 @@ inline void AliDielectronVarManager::InitVZERORecenteringHistograms(Int_t runNo)
   //
   // Initialize the VZERO event plane recentering histograms
   //
+  Context *ctx = GetContext();
 
   //initialize only once
-  if(fgVZERORecentering[0][0]) return;
+  if(ctx->fVZERORecentering[0][0]) return;
 
   for(Int_t i=0; i<2; ++i)
     for(Int_t j=0; j<2; ++j)
-      if(fgVZERORecentering[i][j]) {
-        delete fgVZERORecentering[i][j];
-        fgVZERORecentering[i][j] = 0x0;
+      if(ctx->fVZERORecentering[i][j]) {
+        delete ctx->fVZERORecentering[i][j];
+        ctx->fVZERORecentering[i][j] = 0x0;
       }
 
-  TFile file(fgVZERORecenteringFile.Data());
+  TFile file(ctx->fVZERORecenteringFile.Data());
   if (!file.IsOpen()) return;
 
-  fgVZERORecentering[0][0] = (TProfile2D*)(file.Get(Form("RUN%d_QxA_CentVtx", runNo)));
-  fgVZERORecentering[0][1] = (TProfile2D*)(file.Get(Form("RUN%d_QyA_CentVtx", runNo)));
-  fgVZERORecentering[1][0] = (TProfile2D*)(file.Get(Form("RUN%d_QxC_CentVtx", runNo)));
-  fgVZERORecentering[1][1] = (TProfile2D*)(file.Get(Form("RUN%d_QyC_CentVtx", runNo)));
+  ctx->fVZERORecentering[0][0] = (TProfile2D*)(file.Get(Form("RUN%d_QxA_CentVtx", runNo)));
+  ctx->fVZERORecentering[0][1] = (TProfile2D*)(file.Get(Form("RUN%d_QyA_CentVtx", runNo)));
+  ctx->fVZERORecentering[1][0] = (TProfile2D*)(file.Get(Form("RUN%d_QxC_CentVtx", runNo)));
+  ctx->fVZERORecentering[1][1] = (TProfile2D*)(file.Get(Form("RUN%d_QyC_CentVtx", runNo)));
 
-  if (fgVZERORecentering[0][0]) fgVZERORecentering[0][0]->SetDirectory(0x0);
-  if (fgVZERORecentering[0][1]) fgVZERORecentering[0][1]->SetDirectory(0x0);
-  if (fgVZERORecentering[1][0]) fgVZERORecentering[1][0]->SetDirectory(0x0);
-  if (fgVZERORecentering[1][1]) fgVZERORecentering[1][1]->SetDirectory(0x0);
+  if (ctx->fVZERORecentering[0][0]) ctx->fVZERORecentering[0][0]->SetDirectory(0x0);
+  if (ctx->fVZERORecentering[0][1]) ctx->fVZERORecentering[0][1]->SetDirectory(0x0);
+  if (ctx->fVZERORecentering[1][0]) ctx->fVZERORecentering[1][0]->SetDirectory(0x0);
+  if (ctx->fVZERORecentering[1][1]) ctx->fVZERORecentering[1][1]->SetDirectory(0x0);
 
 }
 
 inline void AliDielectronVarManager::InitZDCRecenteringHistograms(Int_t runNo) {
+  Context *ctx = GetContext();
 
   //initialize only once
-  if(fgZDCRecentering[0][0]) return;
+  if(ctx->fZDCRecentering[0][0]) return;
 
   for(Int_t i=0; i<2; ++i)
     for(Int_t j=0; j<2; ++j)
-      if(fgZDCRecentering[i][j]) {
-        delete fgZDCRecentering[i][j];
-        fgZDCRecentering[i][j] = 0x0;
+      if(ctx->fZDCRecentering[i][j]) {
+        delete ctx->fZDCRecentering[i][j];
+        ctx->fZDCRecentering[i][j] = 0x0;
       }
 
-  TFile* file=TFile::Open(fgZDCRecenteringFile.Data());
+  TFile* file=TFile::Open(ctx->fZDCRecenteringFile.Data());
   if(!file) return;
 
 
-  fgZDCRecentering[0][0] = (TProfile3D*)file->Get(Form("RUN%06d_QxA_Recent", runNo));
-  fgZDCRecentering[0][1] = (TProfile3D*)file->Get(Form("RUN%06d_QyA_Recent", runNo));
-  fgZDCRecentering[1][0] = (TProfile3D*)file->Get(Form("RUN%06d_QxC_Recent", runNo));
-  fgZDCRecentering[1][1] = (TProfile3D*)file->Get(Form("RUN%06d_QyC_Recent", runNo));
-  fgZDCRecentering[2][0] = (TProfile3D*)file->Get(Form("RUN%06d_QxAC_Recent", runNo));
-  fgZDCRecentering[2][1] = (TProfile3D*)file->Get(Form("RUN%06d_QyAC_Recent", runNo));
+  ctx->fZDCRecentering[0][0] = (TProfile3D*)file->Get(Form("RUN%06d_QxA_Recent", runNo));
+  ctx->fZDCRecentering[0][1] = (TProfile3D*)file->Get(Form("RUN%06d_QyA_Recent", runNo));
+  ctx->fZDCRecentering[1][0] = (TProfile3D*)file->Get(Form("RUN%06d_QxC_Recent", runNo));
+  ctx->fZDCRecentering[1][1] = (TProfile3D*)file->Get(Form("RUN%06d_QyC_Recent", runNo));
+  ctx->fZDCRecentering[2][0] = (TProfile3D*)file->Get(Form("RUN%06d_QxAC_Recent", runNo));
+  ctx->fZDCRecentering[2][1] = (TProfile3D*)file->Get(Form("RUN%06d_QyAC_Recent", runNo));
 
 
-  if (fgZDCRecentering[0][0]) fgZDCRecentering[0][0]->SetDirectory(0x0);
-  if (fgZDCRecentering[0][1]) fgZDCRecentering[0][1]->SetDirectory(0x0);
-  if (fgZDCRecentering[1][0]) fgZDCRecentering[1][0]->SetDirectory(0x0);
-  if (fgZDCRecentering[1][1]) fgZDCRecentering[1][1]->SetDirectory(0x0);
-  if (fgZDCRecentering[2][0]) fgZDCRecentering[2][0]->SetDirectory(0x0);
-  if (fgZDCRecentering[2][1]) fgZDCRecentering[2][1]->SetDirectory(0x0);
+  if (ctx->fZDCRecentering[0][0]) ctx->fZDCRecentering[0][0]->SetDirectory(0x0);
+  if (ctx->fZDCRecentering[0][1]) ctx->fZDCRecentering[0][1]->SetDirectory(0x0);
+  if (ctx->fZDCRecentering[1][0]) ctx->fZDCRecentering[1][0]->SetDirectory(0x0);
+  if (ctx->fZDCRecentering[1][1]) ctx->fZDCRecentering[1][1]->SetDirectory(0x0);
+  if (ctx->fZDCRecentering[2][0]) ctx->fZDCRecentering[2][0]->SetDirectory(0x0);
+  if (ctx->fZDCRecentering[2][1]) ctx->fZDCRecentering[2][1]->SetDirectory(0x0);
 
   delete file;
 
@@ -3310,6 +3359,7 @@ inline Double_t AliDielectronVarManager::GetTRDpidEfficiency(Int_t runNo, Double
   // return the efficiency in the given phase space cell
   //
   // LHC10h data----------------------------------------------
+  Context *ctx = GetContext();
   Bool_t isBplus = kTRUE;
   if(runNo<=138275) isBplus = kFALSE;
   // TODO: check magnetic polarity for runs in 2011 data
@@ -3317,13 +3367,13 @@ inline Double_t AliDielectronVarManager::GetTRDpidEfficiency(Int_t runNo, Double
   Int_t centIdx = -1;
   for(Int_t icent=0; icent<10; ++icent) {
     if(isBplus) {
-      if(centrality>=fgTRDpidEffCentRanges[icent][2] && centrality<fgTRDpidEffCentRanges[icent][3]) {
+      if(centrality>=ctx->fTRDpidEffCentRanges[icent][2] && centrality<ctx->fTRDpidEffCentRanges[icent][3]) {
  	centIdx = icent;
  	break;
       }
     }
     else {
-      if(centrality>=fgTRDpidEffCentRanges[icent][0] && centrality<fgTRDpidEffCentRanges[icent][1]) {
+      if(centrality>=ctx->fTRDpidEffCentRanges[icent][0] && centrality<ctx->fTRDpidEffCentRanges[icent][1]) {
  	centIdx = icent;
  	break;
       }
@@ -3332,7 +3382,7 @@ inline Double_t AliDielectronVarManager::GetTRDpidEfficiency(Int_t runNo, Double
   //TODO: chek logick
   if (centIdx<0) return 1;
 
-  TH3D* effH = fgTRDpidEff[centIdx][(isBplus ? 1 : 0)];
+  TH3D* effH = ctx->fTRDpidEff[centIdx][(isBplus ? 1 : 0)];
   if(!effH) {effErr=0x0; return 1.0;}
   Int_t etaBin = effH->GetXaxis()->FindBin(eta);
   if(eta<effH->GetXaxis()->GetXmin()) etaBin=1;
@@ -3355,25 +3405,28 @@ inline Double_t AliDielectronVarManager::GetTRDpidEfficiency(Int_t runNo, Double
 
 inline void AliDielectronVarManager::SetEvent(AliVEvent * const ev)
 {
-  fgEvent = ev;
-  if (fgKFVertex) delete fgKFVertex;
-  fgKFVertex=0x0;
+  Context *ctx = GetContext();
+  ctx->fEvent = ev;
+  if (ctx->fKFVertex) delete ctx->fKFVertex;
+  ctx->fKFVertex=0x0;
   if (!ev) return;
-  if (ev->GetPrimaryVertex()) fgKFVertex=new AliKFVertex(*ev->GetPrimaryVertex());
-  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues;++i) fgData[i]=0.;
-  AliDielectronVarManager::Fill(fgEvent, fgData);
+  if (ev->GetPrimaryVertex()) ctx->fKFVertex=new AliKFVertex(*ev->GetPrimaryVertex());
+  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues;++i) ctx->fData[i]=0.;
+  AliDielectronVarManager::Fill(ctx->fEvent, ctx->fData);
 }
 
 inline void AliDielectronVarManager::SetEventData(const Double_t data[AliDielectronVarManager::kNMaxValues])
 {
-  for (Int_t i=0; i<kNMaxValues;++i) fgData[i]=0.;
-  for (Int_t i=kPairMax; i<kNMaxValues;++i) fgData[i]=data[i];
+  Context *ctx = GetContext();
+  for (Int_t i=0; i<kNMaxValues;++i) ctx->fData[i]=0.;
+  for (Int_t i=kPairMax; i<kNMaxValues;++i) ctx->fData[i]=data[i];
 }
 
 
 //______________________________________________________________________________
 inline Bool_t AliDielectronVarManager::GetDCA(const AliAODTrack *track, Double_t* d0z0, Double_t* covd0z0)
 {
+  Context *ctx = GetContext();
   if(track->TestBit(AliAODTrack::kIsDCA)){
     d0z0[0]=track->DCA();
     d0z0[1]=track->ZAtDCA();
@@ -3382,7 +3435,7 @@ inline Bool_t AliDielectronVarManager::GetDCA(const AliAODTrack *track, Double_t
   }
 
   Bool_t ok=kFALSE;
-  if(fgEvent) {
+  if(ctx->fEvent) {
     AliExternalTrackParam etp; etp.CopyFromVTrack(track);
 
     Float_t xstart = etp.GetX();
@@ -3392,8 +3445,8 @@ inline Bool_t AliDielectronVarManager::GetDCA(const AliAODTrack *track, Double_t
       return kFALSE;
     }
 
-    AliAODVertex *vtx =(AliAODVertex*)(fgEvent->GetPrimaryVertex());
-    Double_t fBzkG = fgEvent->GetMagneticField(); // z componenent of field in kG
+    AliAODVertex *vtx =(AliAODVertex*)(ctx->fEvent->GetPrimaryVertex());
+    Double_t fBzkG = ctx->fEvent->GetMagneticField(); // z componenent of field in kG
     ok = etp.PropagateToDCA(vtx,fBzkG,kVeryBig,d0z0,covd0z0);
   }
   if(!ok){
@@ -3405,11 +3458,12 @@ inline Bool_t AliDielectronVarManager::GetDCA(const AliAODTrack *track, Double_t
 
 inline void AliDielectronVarManager::SetTPCEventPlane(AliEventplane *const evplane)
 {
+  Context *ctx = GetContext();
 
-  fgTPCEventPlane = evplane;
-  FillVarTPCEventPlane(evplane,fgData);
-  //  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues;++i) fgData[i]=0.;
-  //  AliDielectronVarManager::Fill(fgEvent, fgData);
+  ctx->fTPCEventPlane = evplane;
+  FillVarTPCEventPlane(evplane,ctx->fData);
+  //  for (Int_t i=0; i<AliDielectronVarManager::kNMaxValues;++i) ctx->fData[i]=0.;
+  //  AliDielectronVarManager::Fill(ctx->fEvent, ctx->fData);
 }
 
 
@@ -3430,6 +3484,7 @@ inline void AliDielectronVarManager::GetVzeroRP(const AliVEvent* event, Double_t
   //        channel 8: 22.5
   //        channel 9: 22.5 + 45
   //               ...
+  Context *ctx = GetContext();
   const Double_t kX[8] = {0.92388, 0.38268, -0.38268, -0.92388, -0.92388, -0.38268, 0.38268, 0.92388};    // cosines of the angles of the VZERO sectors (8 per ring)
   const Double_t kY[8] = {0.38268, 0.92388, 0.92388, 0.38268, -0.38268, -0.92388, -0.92388, -0.38268};    // sines     -- " --
   Int_t phi;
@@ -3469,9 +3524,9 @@ inline void AliDielectronVarManager::GetVzeroRP(const AliVEvent* event, Double_t
   if(centralitySPD<0. || centralitySPD>80.) return;
 
   Int_t binCent = -1; Int_t binVtx = -1;
-  if(fgVZEROCalib[0]) {
-    binVtx = fgVZEROCalib[0]->GetXaxis()->FindBin(vtxZ);
-    binCent = fgVZEROCalib[0]->GetYaxis()->FindBin(centralitySPD);
+  if(ctx->fVZEROCalib[0]) {
+    binVtx = ctx->fVZEROCalib[0]->GetXaxis()->FindBin(vtxZ);
+    binCent = ctx->fVZEROCalib[0]->GetYaxis()->FindBin(centralitySPD);
   }
   AliVVZERO* vzero = event->GetVZEROData();
   Double_t average = 0.0;
@@ -3480,8 +3535,8 @@ inline void AliDielectronVarManager::GetVzeroRP(const AliVEvent* event, Double_t
     if(iChannel>=32 && sideOption==1) continue;
     phi=iChannel%8;
     mult = vzero->GetMultiplicity(iChannel);
-    if(fgVZEROCalib[iChannel])
-      average = fgVZEROCalib[iChannel]->GetBinContent(binVtx, binCent);
+    if(ctx->fVZEROCalib[iChannel])
+      average = ctx->fVZEROCalib[iChannel]->GetBinContent(binVtx, binCent);
     if(average>1.0e-10 && mult>0.5)
       mult /= average;
     else
@@ -3492,24 +3547,24 @@ inline void AliDielectronVarManager::GetVzeroRP(const AliVEvent* event, Double_t
   }    // end loop over channels
 
   // do recentering
-  if(fgVZERORecentering[0][0]) {
-//     printf("vzero: %p\n",fgVZERORecentering[0][0]);
+  if(ctx->fVZERORecentering[0][0]) {
+//     printf("vzero: %p\n",ctx->fVZERORecentering[0][0]);
     Int_t binCentRecenter = -1; Int_t binVtxRecenter = -1;
-    binCentRecenter = fgVZERORecentering[0][0]->GetXaxis()->FindBin(centralitySPD);
-    binVtxRecenter = fgVZERORecentering[0][0]->GetYaxis()->FindBin(vtxZ);
+    binCentRecenter = ctx->fVZERORecentering[0][0]->GetXaxis()->FindBin(centralitySPD);
+    binVtxRecenter = ctx->fVZERORecentering[0][0]->GetYaxis()->FindBin(vtxZ);
     if(sideOption==0) {  // side A
-      qvec[0] -= fgVZERORecentering[0][0]->GetBinContent(binCentRecenter, binVtxRecenter);
-      qvec[1] -= fgVZERORecentering[0][1]->GetBinContent(binCentRecenter, binVtxRecenter);
+      qvec[0] -= ctx->fVZERORecentering[0][0]->GetBinContent(binCentRecenter, binVtxRecenter);
+      qvec[1] -= ctx->fVZERORecentering[0][1]->GetBinContent(binCentRecenter, binVtxRecenter);
     }
     if(sideOption==1) {  // side C
-      qvec[0] -= fgVZERORecentering[1][0]->GetBinContent(binCentRecenter, binVtxRecenter);
-      qvec[1] -= fgVZERORecentering[1][1]->GetBinContent(binCentRecenter, binVtxRecenter);
+      qvec[0] -= ctx->fVZERORecentering[1][0]->GetBinContent(binCentRecenter, binVtxRecenter);
+      qvec[1] -= ctx->fVZERORecentering[1][1]->GetBinContent(binCentRecenter, binVtxRecenter);
     }
     if(sideOption==2) {  // side A and C together
-      qvec[0] -= fgVZERORecentering[0][0]->GetBinContent(binCentRecenter, binVtxRecenter);
-      qvec[0] -= fgVZERORecentering[1][0]->GetBinContent(binCentRecenter, binVtxRecenter);
-      qvec[1] -= fgVZERORecentering[0][1]->GetBinContent(binCentRecenter, binVtxRecenter);
-      qvec[1] -= fgVZERORecentering[1][1]->GetBinContent(binCentRecenter, binVtxRecenter);
+      qvec[0] -= ctx->fVZERORecentering[0][0]->GetBinContent(binCentRecenter, binVtxRecenter);
+      qvec[0] -= ctx->fVZERORecentering[1][0]->GetBinContent(binCentRecenter, binVtxRecenter);
+      qvec[1] -= ctx->fVZERORecentering[0][1]->GetBinContent(binCentRecenter, binVtxRecenter);
+      qvec[1] -= ctx->fVZERORecentering[1][1]->GetBinContent(binCentRecenter, binVtxRecenter);
     }
   }
 
@@ -3518,6 +3573,7 @@ inline void AliDielectronVarManager::GetVzeroRP(const AliVEvent* event, Double_t
     qvec[2] = TMath::ATan2(qvec[1],qvec[0])/2.0;
 }
 inline void AliDielectronVarManager::GetZDCRP(const AliVEvent* event, Double_t qvec[][2]) {
+  Context *ctx = GetContext();
 
   //
   // Get the reaction plane from the ZDC detector for first harmonic
@@ -3584,7 +3640,7 @@ inline void AliDielectronVarManager::GetZDCRP(const AliVEvent* event, Double_t q
 
   }
 
-  if(fgZDCRecentering[0][0]){
+  if(ctx->fZDCRecentering[0][0]){
     const AliAODEvent* aodEv = static_cast<const AliAODEvent*>(event);
     AliAODHeader *header = dynamic_cast<AliAODHeader*>(aodEv->GetHeader());
     if(!header) return;
@@ -3601,8 +3657,8 @@ inline void AliDielectronVarManager::GetZDCRP(const AliVEvent* event, Double_t q
 
     for(int j = 0; j < nZDCplanes; j++)
       if(qvecDEN[j] != 0){
-        qvec[j][0] -= fgZDCRecentering[j][0] -> GetBinContent(multiBin, vtxXBin, vtxYBin);
-        qvec[j][1] -= fgZDCRecentering[j][1] -> GetBinContent(multiBin, vtxXBin, vtxYBin);
+        qvec[j][0] -= ctx->fZDCRecentering[j][0] -> GetBinContent(multiBin, vtxXBin, vtxYBin);
+        qvec[j][1] -= ctx->fZDCRecentering[j][1] -> GetBinContent(multiBin, vtxXBin, vtxYBin);
       }
   }
 
@@ -3655,13 +3711,14 @@ inline void AliDielectronVarManager::FillValues(const TParticle *particle, Doubl
 
 //________________________________________________________________
 inline void AliDielectronVarManager::FillQnEventplanes(TList *qnlist, Double_t * const values){
+  Context *ctx = GetContext();
   Bool_t bTPCqVector(kFALSE), bTPCaSideqVector(kFALSE), bTPCcSideqVector(kFALSE), bV0AqVector(kFALSE), bV0CqVector(kFALSE), bV0qVector(kFALSE),bSPDqVector(kFALSE), bFMDAqVector(kFALSE), bFMDCqVector(kFALSE);
   for (Int_t i = AliDielectronVarManager::kQnTPCrpH2; i <= AliDielectronVarManager::kQnCorrFMDAy_FMDCy; i++) {
     values[i] = -999.;
   }
   TString qnListDetector;
   // TPC Eventplane q-Vector
-  qnListDetector = "TPC" + fgQnVectorNorm;
+  qnListDetector = "TPC" + ctx->fQnVectorNorm;
   const AliQnCorrectionsQnVector *qVecQnFrameworkTPC = AliDielectronQnEPcorrection::GetQnVectorFromList(qnlist,qnListDetector.Data(),"latest","latest");
   TVector2 *qVectorTPC = new TVector2(-200.,-200.);
   if(qVecQnFrameworkTPC != NULL){
@@ -3674,7 +3731,7 @@ inline void AliDielectronVarManager::FillQnEventplanes(TList *qnlist, Double_t *
   delete qVectorTPC;
 
   // TPC A-Side/Neg. Eta Eventplane q-Vector
-  qnListDetector = "TPCNegEta" + fgQnVectorNorm;
+  qnListDetector = "TPCNegEta" + ctx->fQnVectorNorm;
   const AliQnCorrectionsQnVector *qVecQnFrameworkTPCaSide = AliDielectronQnEPcorrection::GetQnVectorFromList(qnlist,qnListDetector.Data(),"latest","latest");
   TVector2 *qVectorTPCaSide = new TVector2(-200.,-200.);
   if(qVecQnFrameworkTPCaSide != NULL){
@@ -3687,7 +3744,7 @@ inline void AliDielectronVarManager::FillQnEventplanes(TList *qnlist, Double_t *
   delete qVectorTPCaSide;
 
   // TPC C-Side/Pos. Eta Eventplane q-Vector
-  qnListDetector = "TPCPosEta" + fgQnVectorNorm;
+  qnListDetector = "TPCPosEta" + ctx->fQnVectorNorm;
   const AliQnCorrectionsQnVector *qVecQnFrameworkTPCcSide = AliDielectronQnEPcorrection::GetQnVectorFromList(qnlist,qnListDetector.Data(),"latest","latest");
   TVector2 *qVectorTPCcSide = new TVector2(-200.,-200.);
   if(qVecQnFrameworkTPCcSide != NULL){
@@ -3700,7 +3757,7 @@ inline void AliDielectronVarManager::FillQnEventplanes(TList *qnlist, Double_t *
   delete qVectorTPCcSide;
 
   // VZEROA Eventplane q-Vector
-  qnListDetector = "VZEROA" + fgQnVectorNorm;
+  qnListDetector = "VZEROA" + ctx->fQnVectorNorm;
   const AliQnCorrectionsQnVector *qVecQnFrameworkV0A = AliDielectronQnEPcorrection::GetQnVectorFromList(qnlist,qnListDetector.Data(),"latest","latest");
   TVector2 *qVectorV0A = new TVector2(-200.,-200.);
   if(qVecQnFrameworkV0A != NULL){
@@ -3713,7 +3770,7 @@ inline void AliDielectronVarManager::FillQnEventplanes(TList *qnlist, Double_t *
   delete qVectorV0A;
 
   // VZEROC Eventplane q-Vector
-  qnListDetector = "VZEROC" + fgQnVectorNorm;
+  qnListDetector = "VZEROC" + ctx->fQnVectorNorm;
   const AliQnCorrectionsQnVector *qVecQnFrameworkV0C = AliDielectronQnEPcorrection::GetQnVectorFromList(qnlist,qnListDetector.Data(),"latest","latest");
   TVector2 *qVectorV0C = new TVector2(-200.,-200.);
   if(qVecQnFrameworkV0C != NULL){
@@ -3726,7 +3783,7 @@ inline void AliDielectronVarManager::FillQnEventplanes(TList *qnlist, Double_t *
   delete qVectorV0C;
 
   // VZERO Eventplane q-Vector only accessible with NewDetConfig AddTask for QnFramework
-  qnListDetector = "VZERO" + fgQnVectorNorm;
+  qnListDetector = "VZERO" + ctx->fQnVectorNorm;
   const AliQnCorrectionsQnVector *qVecQnFrameworkV0 = AliDielectronQnEPcorrection::GetQnVectorFromList(qnlist,qnListDetector.Data(),"latest","latest");
   TVector2 *qVectorV0 = new TVector2(-200.,-200.);
   if(qVecQnFrameworkV0 != NULL){
@@ -3739,7 +3796,7 @@ inline void AliDielectronVarManager::FillQnEventplanes(TList *qnlist, Double_t *
   delete qVectorV0;
 
   // SPD Eventplane q-Vector
-  qnListDetector = "SPD" + fgQnVectorNorm;
+  qnListDetector = "SPD" + ctx->fQnVectorNorm;
   const AliQnCorrectionsQnVector *qVecQnFrameworkSPD = AliDielectronQnEPcorrection::GetQnVectorFromList(qnlist,qnListDetector.Data(),"latest","latest");
   TVector2 *qVectorSPD = new TVector2(-200.,-200.);
   if(qVecQnFrameworkSPD != NULL){
@@ -3752,7 +3809,7 @@ inline void AliDielectronVarManager::FillQnEventplanes(TList *qnlist, Double_t *
   delete qVectorSPD;
 
   // FMDA Eventplane q-Vector
-  qnListDetector = "FMDA" + fgQnVectorNorm;
+  qnListDetector = "FMDA" + ctx->fQnVectorNorm;
   const AliQnCorrectionsQnVector *qVecQnFrameworkFMDA = AliDielectronQnEPcorrection::GetQnVectorFromList(qnlist,qnListDetector.Data(),"latest","latest");
   TVector2 *qVectorFMDA = new TVector2(-200.,-200.);
   if(qVecQnFrameworkFMDA != NULL){
@@ -3765,7 +3822,7 @@ inline void AliDielectronVarManager::FillQnEventplanes(TList *qnlist, Double_t *
   delete qVectorFMDA;
 
   // FMDC Eventplane q-Vector
-  qnListDetector = "FMDC" + fgQnVectorNorm;
+  qnListDetector = "FMDC" + ctx->fQnVectorNorm;
   const AliQnCorrectionsQnVector *qVecQnFrameworkFMDC = AliDielectronQnEPcorrection::GetQnVectorFromList(qnlist,qnListDetector.Data(),"latest","latest");
   TVector2 *qVectorFMDC = new TVector2(-200.,-200.);
   if(qVecQnFrameworkFMDC != NULL){
@@ -30,6 +30,7 @@ Instructions in AddTask_EPcorrectionsExample.C
 #include "AliHistogramManager.h"
 #include "AliReducedAnalysisTaskSE.h"
 #include "AliReducedEventInputHandler.h"
+#include "AliReducedColumnarTree.h"
 
 using std::cout;
 using std::endl;
@@ -124,6 +125,7 @@ void AliAnalysisTaskReducedEventProcessor::UserExec(Option_t *){
   // Main loop. Called for every event
   //   
   AliReducedBaseEvent* event = NULL;
+  AliReducedColumnarTree* columns = NULL;
   if(fRunningMode==kUseOnTheFlyReducedEvents) 
      event = dynamic_cast<AliReducedBaseEvent*>(GetInputData(0)); 
   
@@ -134,13 +136,16 @@ void AliAnalysisTaskReducedEventProcessor::UserExec(Option_t *){
         fInputHandler = dynamic_cast<AliInputEventHandler *>(fMultiInputHandler->GetFirstInputEventHandler());
      
      AliReducedEventInputHandler* handler = dynamic_cast<AliReducedEventInputHandler *>(fInputHandler);
-     if(handler)
+     if(handler) {
        event = handler->GetReducedEvent();
+       columns = handler->GetColumnarInput();
+     }
   }
   
-  if(!event) return;
+  if(!event && !columns) return;
     
   fReducedTask->SetEvent(event);
+  fReducedTask->SetColumnarEvent(columns);
   fReducedTask->Process();
   PostData(1, fReducedTask->GetHistogramManager()->GetHistogramOutputList());
   
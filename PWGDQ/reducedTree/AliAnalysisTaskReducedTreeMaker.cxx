@@ -72,6 +72,7 @@
 #include "AliReducedCaloClusterInfo.h"
 #include "AliReducedFMDInfo.h"
 #include "AliReducedEventPlaneInfo.h"
+#include "AliReducedColumnarTree.h"
 #include "AliAnalysisTaskReducedTreeMaker.h"
 
 #include <iostream>
@@ -133,6 +134,7 @@ AliAnalysisTaskReducedTreeMaker::AliAnalysisTaskReducedTreeMaker() :
   fTree(0x0),
   fReducedEvent(0x0),
   fUsedVars(0x0),
+  fColumnarTree(0x0),
   fNevents(0)
 {
   //
@@ -192,6 +194,7 @@ AliAnalysisTaskReducedTreeMaker::AliAnalysisTaskReducedTreeMaker(const char *nam
   fTree(0x0),
   fReducedEvent(0x0),
   fUsedVars(0x0),
+  fColumnarTree(0x0),
   fNevents(0)
 {
   //
@@ -210,6 +213,15 @@ AliAnalysisTaskReducedTreeMaker::AliAnalysisTaskReducedTreeMaker(const char *nam
     DefineOutput(2, TTree::Class());   // reduced information tree
 }
 
+//_________________________________________________________________________________
+AliAnalysisTaskReducedTreeMaker::~AliAnalysisTaskReducedTreeMaker()
+{
+  //
+  // Destructor
+  //
+  if(fColumnarTree) delete fColumnarTree;
+}
+
 
 //_________________________________________________________________________________
 void AliAnalysisTaskReducedTreeMaker::UserCreateOutputObjects()
@@ -242,28 +254,33 @@ void AliAnalysisTaskReducedTreeMaker::UserCreateOutputObjects()
         break;
   };
  
-  if(fWriteTree)
+  if(fWriteTree && fColumnarTree) {
+    // column-oriented output: one branch per event and per track variable
+    fColumnarTree->CreateBranches(fTree);
+  }
+  else if(fWriteTree) {
     fTree->Branch("Event",&fReducedEvent,16000,99);
 
-  // if user set active branches
-  TObjArray* aractive=fActiveBranches.Tokenize(";");
-  if(aractive->GetEntries()>0) {fTree->SetBranchStatus("*", 0);}
-  for(Int_t i=0; i<aractive->GetEntries(); i++){
-    fTree->SetBranchStatus(aractive->At(i)->GetName(), 1);
-  }
+    // if user set active branches
+    TObjArray* aractive=fActiveBranches.Tokenize(";");
+    if(aractive->GetEntries()>0) {fTree->SetBranchStatus("*", 0);}
+    for(Int_t i=0; i<aractive->GetEntries(); i++){
+      fTree->SetBranchStatus(aractive->At(i)->GetName(), 1);
+    }
   
-  // if user set inactive branches
-  TObjArray* arinactive=fInactiveBranches.Tokenize(";");
-  for(Int_t i=0; i<arinactive->GetEntries(); i++){
-    fTree->SetBranchStatus(arinactive->At(i)->GetName(), 0);
-  }
+    // if user set inactive branches
+    TObjArray* arinactive=fInactiveBranches.Tokenize(";");
+    for(Int_t i=0; i<arinactive->GetEntries(); i++){
+      fTree->SetBranchStatus(arinactive->At(i)->GetName(), 0);
+    }
  
-  // if MC info is not requested, then set the respective branches off
-  if(!fFillMCInfo) {
-    fTree->SetBranchStatus("fTracks.fMC*", 0); 
-  }
-  if(!fFillEventPlaneInfo) {
-    fTree->SetBranchStatus("fEventPlane.*", 0);   
+    // if MC info is not requested, then set the respective branches off
+    if(!fFillMCInfo) {
+      fTree->SetBranchStatus("fTracks.fMC*", 0); 
+    }
+    if(!fFillEventPlaneInfo) {
+      fTree->SetBranchStatus("fEventPlane.*", 0);   
+    }
   }
  
   /*if(fFillBayesianPIDInfo) {
@@ -359,8 +376,9 @@ void AliAnalysisTaskReducedTreeMaker::UserExec(Option_t *option)
   if(fFillTrackInfo) FillTrackInfo();
  
   if(fWriteTree) {
-    if(fWriteEventsWithNoSelectedTracks) fTree->Fill();
-    if(!fWriteEventsWithNoSelectedTracks && fReducedEvent->fNtracks[1]>0) fTree->Fill();
+    Bool_t writeEvent = (fWriteEventsWithNoSelectedTracks || fReducedEvent->fNtracks[1]>0);
+    if(writeEvent && fColumnarTree) fColumnarTree->FillColumns(fReducedEvent);
+    if(writeEvent) fTree->Fill();
   }
         
   // if there are candidate pairs, add the information to the reduced tree
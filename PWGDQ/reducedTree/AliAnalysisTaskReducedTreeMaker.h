@@ -18,6 +18,7 @@ class AliESDv0KineCuts;
 class AliKFVertex;
 class AliReducedBaseEvent;
 class AliReducedPairInfo;
+class AliReducedColumnarTree;
 class AliAnalysisUtils;
 class AliFlowTrackCuts;
 //class AliFlowBayesianPID;
@@ -36,7 +37,7 @@ public:
 public:
   AliAnalysisTaskReducedTreeMaker();
   AliAnalysisTaskReducedTreeMaker(const char *name, Bool_t writeTree=kTRUE);
-  virtual ~AliAnalysisTaskReducedTreeMaker(){  }
+  virtual ~AliAnalysisTaskReducedTreeMaker();
 
   virtual void UserExec(Option_t *option);
   virtual void UserCreateOutputObjects();
@@ -82,6 +83,8 @@ public:
   // Suppress writing the tree to disk
   void SetWriteTree(Bool_t option=kTRUE)  {fWriteTree = option;}
   Bool_t WriteTree() const {return fWriteTree;}
+  // Write the output tree in the column-oriented format instead of AliReducedBaseEvent objects
+  void SetColumnarOutput(AliReducedColumnarTree* columns) {fColumnarTree = columns;}   // the task takes ownership
   
   // Toggle on/off information branches
   void SetFillTrackInfo(Bool_t flag=kTRUE)        {fFillTrackInfo = flag;}
@@ -166,6 +169,7 @@ public:
 
   AliReducedBaseEvent *fReducedEvent;     //! reduced event wise information
   TBits* fUsedVars;                // used variables for the AliDielectronVarManager
+  AliReducedColumnarTree* fColumnarTree;   // column-oriented output (optional)
   
   void FillEventInfo();                     // fill reduced event information
   void FillTrackInfo();                     // fill reduced track information
@@ -181,6 +185,6 @@ public:
   AliAnalysisTaskReducedTreeMaker(const AliAnalysisTaskReducedTreeMaker &c);
   AliAnalysisTaskReducedTreeMaker& operator= (const AliAnalysisTaskReducedTreeMaker &c);
 
-  ClassDef(AliAnalysisTaskReducedTreeMaker, 4); //Analysis Task for creating a reduced event information tree 
+  ClassDef(AliAnalysisTaskReducedTreeMaker, 5); //Analysis Task for creating a reduced event information tree 
 };
 #endif
@@ -19,6 +19,7 @@ AliReducedAnalysisTaskSE::AliReducedAnalysisTaskSE() :
   fName(""),
   fTitle(""),
   fEvent(0x0),
+  fColumnarEvent(0x0),
   fFilteredTree(0x0),
   fActiveBranches(""),
   fInactiveBranches(""),
@@ -41,6 +42,7 @@ AliReducedAnalysisTaskSE::AliReducedAnalysisTaskSE(const Char_t* name, const Cha
   fName(name),
   fTitle(title),
   fEvent(0x0),
+  fColumnarEvent(0x0),
   fFilteredTree(0x0),
   fActiveBranches(""),
   fInactiveBranches(""),
@@ -18,6 +18,8 @@
 #include "AliHistogramManager.h"
 #include "AliReducedBaseEvent.h"
 
+class AliReducedColumnarTree;
+
 //________________________________________________________________
 class AliReducedAnalysisTaskSE : public TObject {
   
@@ -46,6 +48,7 @@ public:
   
   // setters
   void SetEvent(AliReducedBaseEvent* event) {fEvent = event;}
+  void SetColumnarEvent(AliReducedColumnarTree* columns) {fColumnarEvent = columns;}
   
   void SetFilteredTreeWritingOption(Int_t option)         {fFilteredTreeWritingOption = option;}
   void SetFilteredTreeActiveBranch(TString b)   {fActiveBranches+=b+";";}
@@ -54,6 +57,7 @@ public:
   // getters
   virtual AliHistogramManager* GetHistogramManager() const = 0;
   AliReducedBaseEvent* GetEvent() const {return fEvent;}
+  AliReducedColumnarTree* GetColumnarEvent() const {return fColumnarEvent;}
   TTree* GetFilteredTree() {return fFilteredTree;}
   Int_t GetFilteredTreeWritingOption() const {return fFilteredTreeWritingOption;}
   
@@ -65,6 +69,7 @@ protected:
   TString fTitle;                // title
     
   AliReducedBaseEvent* fEvent;           //! current event to be processed
+  AliReducedColumnarTree* fColumnarEvent;   //! current event columns when running over column-oriented trees (fEvent is then 0x0)
   Float_t fValues[AliReducedVarManager::kNVars];   // array of values to hold information for histograms
   
   TTree *fFilteredTree;                          //! tree to hold filtered reduced events
@@ -75,7 +80,7 @@ protected:
   
   ULong_t fEventCounter;   // event counter
   
-  ClassDef(AliReducedAnalysisTaskSE, 3)
+  ClassDef(AliReducedAnalysisTaskSE, 4)
 };
 
 #endif
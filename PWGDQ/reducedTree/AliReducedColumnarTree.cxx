@@ -0,0 +1,319 @@
+/*
+***********************************************************
+  Implementation of AliReducedColumnarTree class.
+  Column-oriented writer/reader for reduced event and track information
+  *********************************************************
+*/
+
+#ifndef ALIREDUCEDCOLUMNARTREE_H
+#include "AliReducedColumnarTree.h"
+#endif
+
+#include <cstring>
+#include <iostream>
+using std::cout;
+using std::endl;
+
+#include <TTree.h>
+#include <TBranch.h>
+#include <TList.h>
+#include <TObjString.h>
+#include <TMath.h>
+#include <map>
+
+#include "AliReducedBaseEvent.h"
+#include "AliReducedBaseTrack.h"
+
+ClassImp(AliReducedColumnarTree)
+
+//____________________________________________________________________________
+AliReducedColumnarTree::AliReducedColumnarTree() :
+  TObject(),
+  fEventVars(),
+  fEventBits(),
+  fTrackVars(),
+  fTrackBits(),
+  fTree(0x0),
+  fEventBranches(),
+  fTrackBranches(),
+  fNTracks(0),
+  fTrackCapacity(0),
+  fEventBuffer(),
+  fTrackBuffers(),
+  fValues(0x0)
+{
+  //
+  // Constructor
+  //
+}
+
+//____________________________________________________________________________
+AliReducedColumnarTree::~AliReducedColumnarTree()
+{
+  //
+  // Destructor
+  //
+  if(fValues) delete [] fValues;
+}
+
+//____________________________________________________________________________
+void AliReducedColumnarTree::AddEventColumn(AliReducedVarManager::Variables var, Int_t nMantissaBits /*=23*/)
+{
+  //
+  // add an event column
+  //
+  fEventVars.push_back(var);
+  fEventBits.push_back(TMath::Max(0, TMath::Min(nMantissaBits, 23)));
+}
+
+//____________________________________________________________________________
+void AliReducedColumnarTree::AddTrackColumn(AliReducedVarManager::Variables var, Int_t nMantissaBits /*=23*/)
+{
+  //
+  // add a track column
+  //
+  fTrackVars.push_back(var);
+  fTrackBits.push_back(TMath::Max(0, TMath::Min(nMantissaBits, 23)));
+}
+
+//____________________________________________________________________________
+void AliReducedColumnarTree::InitBuffers()
+{
+  //
+  // allocate the column buffers
+  //
+  fEventBuffer.assign(fEventVars.size(), 0.0);
+  fTrackCapacity = 1000;
+  fTrackBuffers.assign(fTrackVars.size(), std::vector<Float_t>(fTrackCapacity, 0.0));
+  fNTracks = 0;
+}
+
+//____________________________________________________________________________
+void AliReducedColumnarTree::GrowTrackBuffers(Int_t nTracks)
+{
+  //
+  // enlarge the track column buffers and update the branch addresses
+  //
+  while(fTrackCapacity<nTracks) fTrackCapacity *= 2;
+  for(UInt_t i=0; i<fTrackVars.size(); ++i) {
+    fTrackBuffers[i].resize(fTrackCapacity, 0.0);
+    if(fTree) fTree->SetBranchAddress(fTrackBranches[i].Data(), &fTrackBuffers[i][0]);
+  }
+}
+
+//____________________________________________________________________________
+Float_t AliReducedColumnarTree::Truncate(Float_t value, Int_t nMantissaBits) const
+{
+  //
+  // round the float mantissa to nMantissaBits bits; the zeroed low bits compress well
+  //
+  if(nMantissaBits>=23) return value;
+  UInt_t bits = 0;
+  memcpy(&bits, &value, sizeof(Float_t));
+  if((bits & 0x7f800000)==0x7f800000) return value;   // inf or nan
+  const UInt_t drop = 23 - nMantissaBits;
+  bits += (UInt_t(1)<<(drop-1));
+  bits &= ~((UInt_t(1)<<drop)-1);
+  memcpy(&value, &bits, sizeof(Float_t));
+  return value;
+}
+
+//____________________________________________________________________________
+void AliReducedColumnarTree::GetColumnNames(std::vector<TString>& names)
+{
+  //
+  // name of each AliReducedVarManager variable in the column lists: the variable name, followed
+  // by ";<n>" for the n-th variable of a name shared by several variables (e.g. kRunNo and kRunID)
+  //
+  if(AliReducedVarManager::fgVariableNames[AliReducedVarManager::kRunNo].IsNull())
+    AliReducedVarManager::SetDefaultVarNames();
+  std::map<TString, Int_t> counts;
+  for(Int_t ivar=0; ivar<AliReducedVarManager::kNVars; ++ivar)
+    counts[AliReducedVarManager::fgVariableNames[ivar]] += 1;
+  std::map<TString, Int_t> ranks;
+  names.assign(AliReducedVarManager::kNVars, "");
+  for(Int_t ivar=0; ivar<AliReducedVarManager::kNVars; ++ivar) {
+    const TString& name = AliReducedVarManager::fgVariableNames[ivar];
+    if(counts[name]==1) names[ivar] = name;
+    else names[ivar] = Form("%s;%d", name.Data(), ranks[name]++);
+  }
+}
+
+//____________________________________________________________________________
+void AliReducedColumnarTree::CreateBranches(TTree* tree)
+{
+  //
+  // create the column branches in the output tree, record the variable of each column
+  // in the tree UserInfo and enable the needed variables
+  //
+  if(!tree) return;
+  fTree = tree;
+  InitBuffers();
+  if(!fValues) fValues = new Float_t[AliReducedVarManager::kNVars];
+
+  std::vector<TString> names;
+  GetColumnNames(names);
+  TList* eventColumns = new TList();
+  eventColumns->SetName("EventColumns");
+  eventColumns->SetOwner(kTRUE);
+  TList* trackColumns = new TList();
+  trackColumns->SetName("TrackColumns");
+  trackColumns->SetOwner(kTRUE);
+  fTree->GetUserInfo()->Add(eventColumns);
+  fTree->GetUserInfo()->Add(trackColumns);
+
+  fEventBranches.clear();
+  for(UInt_t i=0; i<fEventVars.size(); ++i) {
+    AliReducedVarManager::SetUseVariable((AliReducedVarManager::Variables)fEventVars[i]);
+    eventColumns->Add(new TObjString(names[fEventVars[i]]));
+    fEventBranches.push_back(Form("ev%d", i));
+    fTree->Branch(fEventBranches[i].Data(), &fEventBuffer[i], Form("ev%d/F", i));
+  }
+  fTree->Branch("NTracks", &fNTracks, "NTracks/I");
+  fTrackBranches.clear();
+  for(UInt_t i=0; i<fTrackVars.size(); ++i) {
+    AliReducedVarManager::SetUseVariable((AliReducedVarManager::Variables)fTrackVars[i]);
+    trackColumns->Add(new TObjString(names[fTrackVars[i]]));
+    fTrackBranches.push_back(Form("tr%d", i));
+    fTree->Branch(fTrackBranches[i].Data(), &fTrackBuffers[i][0], Form("tr%d[NTracks]/F", i));
+  }
+}
+
+//____________________________________________________________________________
+void AliReducedColumnarTree::FillColumns(AliReducedBaseEvent* event)
+{
+  //
+  // fill the column buffers for this event; the tree itself is filled by the caller
+  //
+  if(!event || !fValues) return;
+
+  AliReducedVarManager::SetEvent(event);
+  AliReducedVarManager::FillEventInfo(event, fValues);
+  for(UInt_t i=0; i<fEventVars.size(); ++i)
+    fEventBuffer[i] = Truncate(fValues[fEventVars[i]], fEventBits[i]);
+
+  fNTracks = 0;
+  if(fTrackVars.empty()) return;
+  Int_t nTracks = event->NTracks();
+  if(nTracks>fTrackCapacity) GrowTrackBuffers(nTracks);
+  for(Int_t it=0; it<nTracks; ++it) {
+    AliReducedBaseTrack* track = event->GetTrack(it);
+    if(!track) continue;
+    AliReducedVarManager::FillTrackInfo(track, fValues);
+    for(UInt_t i=0; i<fTrackVars.size(); ++i)
+      fTrackBuffers[i][fNTracks] = Truncate(fValues[fTrackVars[i]], fTrackBits[i]);
+    ++fNTracks;
+  }
+}
+
+//____________________________________________________________________________
+Bool_t AliReducedColumnarTree::ConnectTree(TTree* tree)
+{
+  //
+  // connect the reader to a tree (or chain) written with CreateBranches()
+  // the columns are matched by variable name through the column lists in the tree UserInfo;
+  // only the NTracks counter and the requested columns are activated
+  //
+  if(!tree) return kFALSE;
+  fTree = tree;
+  if(fTree->LoadTree(0)<0 || !fTree->GetBranch("NTracks")) {
+    cout << "AliReducedColumnarTree::ConnectTree() ERROR: the tree has no NTracks branch" << endl;
+    return kFALSE;
+  }
+  TTree* current = (fTree->GetTree() ? fTree->GetTree() : fTree);
+  TList* eventColumns = (TList*)current->GetUserInfo()->FindObject("EventColumns");
+  TList* trackColumns = (TList*)current->GetUserInfo()->FindObject("TrackColumns");
+  if(!eventColumns || !trackColumns) {
+    cout << "AliReducedColumnarTree::ConnectTree() ERROR: the tree UserInfo has no column lists" << endl;
+    return kFALSE;
+  }
+
+  fTree->SetBranchStatus("*", 0);
+  fTree->SetBranchStatus("NTracks", 1);
+  fTree->SetBranchAddress("NTracks", &fNTracks);
+  const Bool_t allColumns = (fEventVars.empty() && fTrackVars.empty());
+  if(!ConnectColumns(eventColumns, kFALSE, allColumns)) return kFALSE;
+  if(!ConnectColumns(trackColumns, kTRUE, allColumns)) return kFALSE;
+
+  InitBuffers();
+  for(UInt_t i=0; i<fEventVars.size(); ++i) fTree->SetBranchAddress(fEventBranches[i].Data(), &fEventBuffer[i]);
+  for(UInt_t i=0; i<fTrackVars.size(); ++i) fTree->SetBranchAddress(fTrackBranches[i].Data(), &fTrackBuffers[i][0]);
+  return kTRUE;
+}
+
+//____________________________________________________________________________
+Bool_t AliReducedColumnarTree::ConnectColumns(TList* columns, Bool_t isTrack, Bool_t allColumns)
+{
+  //
+  // find the branch of each requested event or track column and activate it;
+  // with allColumns, every column of a variable known to AliReducedVarManager is requested
+  //
+  std::vector<TString> names;
+  GetColumnNames(names);
+  std::vector<Int_t>& vars = (isTrack ? fTrackVars : fEventVars);
+  std::vector<TString>& branches = (isTrack ? fTrackBranches : fEventBranches);
+  const Char_t* prefix = (isTrack ? "tr" : "ev");
+
+  if(allColumns) {
+    std::map<TString, Int_t> variables;
+    for(Int_t ivar=0; ivar<AliReducedVarManager::kNVars; ++ivar) variables[names[ivar]] = ivar;
+    for(Int_t i=0; i<columns->GetEntries(); ++i) {
+      TString name = columns->At(i)->GetName();
+      if(variables.find(name)==variables.end()) {
+        cout << "AliReducedColumnarTree::ConnectTree() WARNING: column " << name.Data() << " is not an AliReducedVarManager variable, skipped" << endl;
+        continue;
+      }
+      if(isTrack) AddTrackColumn((AliReducedVarManager::Variables)variables[name]);
+      else AddEventColumn((AliReducedVarManager::Variables)variables[name]);
+    }
+  }
+
+  branches.clear();
+  for(UInt_t i=0; i<vars.size(); ++i) {
+    TObject* column = columns->FindObject(names[vars[i]].Data());
+    if(!column) {
+      cout << "AliReducedColumnarTree::ConnectTree() ERROR: " << (isTrack ? "track" : "event")
+           << " column " << names[vars[i]].Data() << " not found" << endl;
+      return kFALSE;
+    }
+    branches.push_back(Form("%s%d", prefix, columns->IndexOf(column)));
+    fTree->SetBranchStatus(branches[i].Data(), 1);
+  }
+  return kTRUE;
+}
+
+//____________________________________________________________________________
+Int_t AliReducedColumnarTree::GetEntry(Long64_t entry)
+{
+  //
+  // read the requested columns of one entry
+  // the track counter is read first so that the track buffers can be enlarged before reading the arrays
+  //
+  if(!fTree) return 0;
+  Long64_t localEntry = fTree->LoadTree(entry);
+  if(localEntry<0) return 0;
+  TBranch* counter = fTree->GetTree()->GetBranch("NTracks");
+  if(!counter) return 0;
+  counter->GetEntry(localEntry);
+  if(fNTracks>fTrackCapacity) GrowTrackBuffers(fNTracks);
+  return fTree->GetEntry(entry);
+}
+
+//____________________________________________________________________________
+void AliReducedColumnarTree::FillEventValues(Float_t* values) const
+{
+  //
+  // copy the event columns into an AliReducedVarManager value array
+  //
+  for(UInt_t i=0; i<fEventVars.size(); ++i) values[fEventVars[i]] = fEventBuffer[i];
+}
+
+//____________________________________________________________________________
+void AliReducedColumnarTree::FillTrackValues(Int_t itrack, Float_t* values) const
+{
+  //
+  // copy the track columns of track itrack into an AliReducedVarManager value array
+  //
+  if(itrack<0 || itrack>=fNTracks) return;
+  for(UInt_t i=0; i<fTrackVars.size(); ++i) values[fTrackVars[i]] = fTrackBuffers[i][itrack];
+}
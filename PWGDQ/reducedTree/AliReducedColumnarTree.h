@@ -0,0 +1,78 @@
+// Column-oriented storage of reduced event and track information
+//
+// Event variables are written as one scalar branch per column and track variables as one
+// variable-length array branch per column, all sharing the "NTracks" counter. The values are
+// the AliReducedVarManager variables, so a reader only touches the branches of the requested
+// variables and gets them directly into the AliReducedVarManager value arrays, without
+// deserializing AliReducedTrackInfo objects.
+// The precision of each column can be reduced by truncating the float mantissa, which
+// improves the compression of the output.
+// Branches are named "ev<i>" and "tr<i>", with <i> the column index. The tree UserInfo holds the
+// "EventColumns" and "TrackColumns" lists with the AliReducedVarManager variable name of each
+// column, and the reader matches the columns by these names, so the files stay readable when
+// the AliReducedVarManager::Variables list changes.
+
+#ifndef ALIREDUCEDCOLUMNARTREE_H
+#define ALIREDUCEDCOLUMNARTREE_H
+
+#include <vector>
+#include <TObject.h>
+#include <TString.h>
+#include "AliReducedVarManager.h"
+
+class TTree;
+class TList;
+class AliReducedBaseEvent;
+
+//_________________________________________________________________________
+class AliReducedColumnarTree : public TObject {
+
+ public:
+  AliReducedColumnarTree();
+  virtual ~AliReducedColumnarTree();
+
+  // configuration; nMantissaBits=23 keeps the full float precision
+  void AddEventColumn(AliReducedVarManager::Variables var, Int_t nMantissaBits=23);
+  void AddTrackColumn(AliReducedVarManager::Variables var, Int_t nMantissaBits=23);
+  Int_t GetNEventColumns() const {return fEventVars.size();}
+  Int_t GetNTrackColumns() const {return fTrackVars.size();}
+
+  // writing
+  void CreateBranches(TTree* tree);
+  void FillColumns(AliReducedBaseEvent* event);
+
+  // reading: only the configured columns are read (all columns found in the tree if none are configured)
+  Bool_t ConnectTree(TTree* tree);
+  Int_t GetEntry(Long64_t entry);
+  Int_t GetNTracks() const {return fNTracks;}
+  void FillEventValues(Float_t* values) const;
+  void FillTrackValues(Int_t itrack, Float_t* values) const;
+
+ private:
+  AliReducedColumnarTree(const AliReducedColumnarTree &c);
+  AliReducedColumnarTree& operator= (const AliReducedColumnarTree &c);
+
+  void InitBuffers();
+  void GrowTrackBuffers(Int_t nTracks);
+  Float_t Truncate(Float_t value, Int_t nMantissaBits) const;
+  static void GetColumnNames(std::vector<TString>& names);
+  Bool_t ConnectColumns(TList* columns, Bool_t isTrack, Bool_t allColumns);
+
+  std::vector<Int_t> fEventVars;       // event columns (AliReducedVarManager::Variables)
+  std::vector<Int_t> fEventBits;       // mantissa bits kept for each event column
+  std::vector<Int_t> fTrackVars;       // track columns (AliReducedVarManager::Variables)
+  std::vector<Int_t> fTrackBits;       // mantissa bits kept for each track column
+
+  TTree* fTree;                                  //! tree being written or read
+  std::vector<TString> fEventBranches;           //! branch name of each event column
+  std::vector<TString> fTrackBranches;           //! branch name of each track column
+  Int_t fNTracks;                                //! number of tracks in the current event
+  Int_t fTrackCapacity;                          //! size of the track column buffers
+  std::vector<Float_t> fEventBuffer;             //! event column buffer
+  std::vector<std::vector<Float_t> > fTrackBuffers;  //! track column buffers
+  Float_t* fValues;                              //! AliReducedVarManager value array used when writing
+
+  ClassDef(AliReducedColumnarTree, 1);
+};
+
+#endif
@@ -8,6 +8,7 @@
 #include "AliReducedEventInputHandler.h"
 #include "AliReducedBaseEvent.h"
 #include "AliReducedEventInfo.h"
+#include "AliReducedColumnarTree.h"
 
 ClassImp(AliReducedEventInputHandler)
 
@@ -15,7 +16,8 @@ ClassImp(AliReducedEventInputHandler)
 AliReducedEventInputHandler::AliReducedEventInputHandler() :
     AliInputEventHandler(),
     fEventInputOption(kReducedBaseEvent),
-    fReducedEvent(0)
+    fReducedEvent(0),
+    fColumnarTree(0)
 {
   // Default constructor
 }
@@ -24,7 +26,8 @@ AliReducedEventInputHandler::AliReducedEventInputHandler() :
 AliReducedEventInputHandler::AliReducedEventInputHandler(const char* name, const char* title):
   AliInputEventHandler(name, title),
   fEventInputOption(kReducedBaseEvent),
-  fReducedEvent(0)
+  fReducedEvent(0),
+  fColumnarTree(0)
  {
     // Constructor
 }
@@ -33,6 +36,7 @@ AliReducedEventInputHandler::AliReducedEventInputHandler(const char* name, const
 AliReducedEventInputHandler::~AliReducedEventInputHandler() 
 {
 // Destructor
+  if(fColumnarTree) delete fColumnarTree;
 }
 
 //______________________________________________________________________________
@@ -46,6 +50,9 @@ Bool_t AliReducedEventInputHandler::Init(TTree* tree, Option_t* opt)
     SwitchOffBranches();
     SwitchOnBranches();
     
+    // column-oriented input: only the requested columns are read
+    if (fColumnarTree) return fColumnarTree->ConnectTree(tree);
+    
     // Get pointer to the event
     if (!fReducedEvent) {
        switch(fEventInputOption) {
@@ -67,6 +74,7 @@ Bool_t AliReducedEventInputHandler::Init(TTree* tree, Option_t* opt)
 Bool_t AliReducedEventInputHandler::BeginEvent(Long64_t entry)
 {
     // Begin event
+    if (fColumnarTree) return (fColumnarTree->GetEntry(entry)>0);
     static Int_t prevRunNumber = -1;
     if (prevRunNumber != fReducedEvent->RunNo() ) {
       prevRunNumber = fReducedEvent->RunNo();
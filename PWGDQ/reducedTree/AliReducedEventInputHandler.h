@@ -10,6 +10,7 @@
 #include "AliReducedBaseEvent.h"
 //#include "AliReducedEventInfo.h"
 class TTree;
+class AliReducedColumnarTree;
 
 class AliReducedEventInputHandler : public AliInputEventHandler {
   public:
@@ -33,6 +34,9 @@ class AliReducedEventInputHandler : public AliInputEventHandler {
              
                  void                                SetInputEventType(Int_t type) {fEventInputOption = type;} ;
                  Int_t                               GetInputEventType() const {return fEventInputOption;};
+                 // read column-oriented trees written with AliReducedColumnarTree instead of reduced events (the handler takes ownership)
+                 void                                SetColumnarInput(AliReducedColumnarTree* columns) {fColumnarTree = columns;}
+                 AliReducedColumnarTree*             GetColumnarInput() const {return fColumnarTree;}
                  
  private:
     AliReducedEventInputHandler(const AliReducedEventInputHandler& handler);             
@@ -40,9 +44,10 @@ class AliReducedEventInputHandler : public AliInputEventHandler {
     
     Int_t  fEventInputOption;                          // one of the options listed in EReducedEventInputType
     AliReducedBaseEvent* fReducedEvent;   //! Pointer to the event
+    AliReducedColumnarTree* fColumnarTree;   // reader of column-oriented trees (optional)
     //AliReducedEventInfo* fReducedEvent;   //! Pointer to the event
     
-    ClassDef(AliReducedEventInputHandler, 2);
+    ClassDef(AliReducedEventInputHandler, 3);
 };
 
 #endif
@@ -129,44 +129,157 @@ const Double_t AliReducedVarManager::fgkVZEROminMult = 0.5;   // minimum VZERO c
 const Float_t  AliReducedVarManager::fgkTPCQvecRapGap = 0.8;    // symmetric interval in the middle of the TPC excluded from EP calculation
       Float_t  AliReducedVarManager::fgBeamMomentum = 1380.;   // beam momentum in GeV/c
      
-Int_t      AliReducedVarManager::fgCurrentRunNumber = -1;
 TString AliReducedVarManager::fgVariableNames[AliReducedVarManager::kNVars] = {""};
 TString AliReducedVarManager::fgVariableUnits[AliReducedVarManager::kNVars] = {""};
-AliReducedBaseEvent* AliReducedVarManager::fgEvent = 0x0;
-AliReducedEventPlaneInfo* AliReducedVarManager::fgEventPlane = 0x0;
-Bool_t AliReducedVarManager::fgUsedVars[AliReducedVarManager::kNVars] = {kFALSE};
-TH2F* AliReducedVarManager::fgTPCelectronCentroidMap = 0x0;
-TH2F* AliReducedVarManager::fgTPCelectronWidthMap = 0x0;
-AliReducedVarManager::Variables AliReducedVarManager::fgVarDependencyX = kNothing;
-AliReducedVarManager::Variables AliReducedVarManager::fgVarDependencyY = kNothing;
-TH2F* AliReducedVarManager::fgPairEffMap = 0x0;
-AliReducedVarManager::Variables AliReducedVarManager::fgEffMapVarDependencyX = kNothing;
-AliReducedVarManager::Variables AliReducedVarManager::fgEffMapVarDependencyY = kNothing;
-TH1F* AliReducedVarManager::fgRunTotalLuminosity = 0x0;
-TH1F* AliReducedVarManager::fgRunTotalIntensity0 = 0x0;
-TH1F* AliReducedVarManager::fgRunTotalIntensity1 = 0x0;
-TH1I* AliReducedVarManager::fgRunLHCFillNumber = 0x0;
-TH1I* AliReducedVarManager::fgRunDipolePolarity = 0x0;
-TH1I* AliReducedVarManager::fgRunL3Polarity = 0x0;
-TH1I* AliReducedVarManager::fgRunTimeStart = 0x0;
-TH1I* AliReducedVarManager::fgRunTimeEnd = 0x0;
-std::vector<Int_t>  AliReducedVarManager::fgRunNumbers;
-Int_t AliReducedVarManager::fgRunID = -1;
-TH1* AliReducedVarManager::fgAvgMultVsVtxGlobal      [kNMultiplicityEstimators] = {0x0};
-TH1* AliReducedVarManager::fgAvgMultVsVtxRunwise     [kNMultiplicityEstimators] = {0x0};
-TH1* AliReducedVarManager::fgAvgMultVsRun            [kNMultiplicityEstimators] = {0x0};
-TH2* AliReducedVarManager::fgAvgMultVsVtxAndRun      [kNMultiplicityEstimators] = {0x0};
-
-Double_t AliReducedVarManager::fgRefMultVsVtxGlobal  [kNMultiplicityEstimators] [kNReferenceMultiplicities] = {0.};
-Double_t AliReducedVarManager::fgRefMultVsVtxRunwise [kNMultiplicityEstimators] [kNReferenceMultiplicities] = {0.};
-Double_t AliReducedVarManager::fgRefMultVsRun        [kNMultiplicityEstimators] [kNReferenceMultiplicities] = {0.};
-Double_t AliReducedVarManager::fgRefMultVsVtxAndRun  [kNMultiplicityEstimators] [kNReferenceMultiplicities] = {0.};
-
-TString AliReducedVarManager::fgVZEROCalibrationPath = "";
-TProfile2D* AliReducedVarManager::fgAvgVZEROChannelMult[64] = {0x0};
-TProfile2D* AliReducedVarManager::fgVZEROqVecRecentering[4] = {0x0};
-Bool_t AliReducedVarManager::fgOptionCalibrateVZEROqVec = kFALSE;
-Bool_t AliReducedVarManager::fgOptionRecenterVZEROqVec = kFALSE;
+AliReducedVarManager::Context AliReducedVarManager::fgDefaultContext;
+#if !defined(__CINT__)
+// context installed by SetContext() in the calling thread (0x0: default context)
+static thread_local AliReducedVarManager::Context* gReducedVarManagerContext = 0x0;
+#endif
+
+//__________________________________________________________________
+template <class T> static T* CloneCalibration(const T* h) {
+  //
+  // owned copy of a calibration histogram
+  //
+  if(!h) return 0x0;
+  T* c = (T*)h->Clone();
+  c->SetDirectory(0x0);
+  return c;
+}
+
+//__________________________________________________________________
+AliReducedVarManager::Context::Context() :
+  fEvent(0x0),
+  fEventPlane(0x0),
+  fCurrentRunNumber(-1),
+  fRunID(-1),
+  fRunNumbers(),
+  fTPCelectronCentroidMap(0x0),
+  fTPCelectronWidthMap(0x0),
+  fVarDependencyX(kNothing),
+  fVarDependencyY(kNothing),
+  fPairEffMap(0x0),
+  fEffMapVarDependencyX(kNothing),
+  fEffMapVarDependencyY(kNothing),
+  fRunTotalLuminosity(0x0),
+  fRunTotalIntensity0(0x0),
+  fRunTotalIntensity1(0x0),
+  fRunLHCFillNumber(0x0),
+  fRunDipolePolarity(0x0),
+  fRunL3Polarity(0x0),
+  fRunTimeStart(0x0),
+  fRunTimeEnd(0x0),
+  fVZEROCalibrationPath(""),
+  fOptionCalibrateVZEROqVec(kFALSE),
+  fOptionRecenterVZEROqVec(kFALSE)
+{
+  //
+  // constructor
+  //
+  for(Int_t i=0; i<kNVars; ++i) fUsedVars[i] = kFALSE;
+  for(Int_t i=0; i<kNMultiplicityEstimators; ++i) {
+    fAvgMultVsVtxGlobal[i] = 0x0;
+    fAvgMultVsVtxRunwise[i] = 0x0;
+    fAvgMultVsRun[i] = 0x0;
+    fAvgMultVsVtxAndRun[i] = 0x0;
+    for(Int_t j=0; j<kNReferenceMultiplicities; ++j) {
+      fRefMultVsVtxGlobal[i][j] = 0.;
+      fRefMultVsVtxRunwise[i][j] = 0.;
+      fRefMultVsRun[i][j] = 0.;
+      fRefMultVsVtxAndRun[i][j] = 0.;
+    }
+  }
+  for(Int_t i=0; i<64; ++i) fAvgVZEROChannelMult[i] = 0x0;
+  for(Int_t i=0; i<4; ++i) fVZEROqVecRecentering[i] = 0x0;
+}
+
+//__________________________________________________________________
+AliReducedVarManager::Context::Context(const Context& c) :
+  fEvent(0x0),
+  fEventPlane(0x0),
+  fCurrentRunNumber(-1),
+  fRunID(-1),
+  fRunNumbers(c.fRunNumbers),
+  fTPCelectronCentroidMap(CloneCalibration(c.fTPCelectronCentroidMap)),
+  fTPCelectronWidthMap(CloneCalibration(c.fTPCelectronWidthMap)),
+  fVarDependencyX(c.fVarDependencyX),
+  fVarDependencyY(c.fVarDependencyY),
+  fPairEffMap(CloneCalibration(c.fPairEffMap)),
+  fEffMapVarDependencyX(c.fEffMapVarDependencyX),
+  fEffMapVarDependencyY(c.fEffMapVarDependencyY),
+  fRunTotalLuminosity(CloneCalibration(c.fRunTotalLuminosity)),
+  fRunTotalIntensity0(CloneCalibration(c.fRunTotalIntensity0)),
+  fRunTotalIntensity1(CloneCalibration(c.fRunTotalIntensity1)),
+  fRunLHCFillNumber(CloneCalibration(c.fRunLHCFillNumber)),
+  fRunDipolePolarity(CloneCalibration(c.fRunDipolePolarity)),
+  fRunL3Polarity(CloneCalibration(c.fRunL3Polarity)),
+  fRunTimeStart(CloneCalibration(c.fRunTimeStart)),
+  fRunTimeEnd(CloneCalibration(c.fRunTimeEnd)),
+  fVZEROCalibrationPath(c.fVZEROCalibrationPath),
+  fOptionCalibrateVZEROqVec(c.fOptionCalibrateVZEROqVec),
+  fOptionRecenterVZEROqVec(c.fOptionRecenterVZEROqVec)
+{
+  //
+  // copy the variable configuration and the calibration inputs of another context
+  // (e.g. the default one for a worker thread). The run-wise quantities (VZERO calibration,
+  // multiplicity references) are computed again at the first event.
+  //
+  for(Int_t i=0; i<kNVars; ++i) fUsedVars[i] = c.fUsedVars[i];
+  for(Int_t i=0; i<kNMultiplicityEstimators; ++i) {
+    fAvgMultVsVtxGlobal[i] = 0x0;
+    fAvgMultVsVtxRunwise[i] = 0x0;
+    fAvgMultVsRun[i] = 0x0;
+    fAvgMultVsVtxAndRun[i] = CloneCalibration(c.fAvgMultVsVtxAndRun[i]);
+    for(Int_t j=0; j<kNReferenceMultiplicities; ++j) {
+      fRefMultVsVtxGlobal[i][j] = 0.;
+      fRefMultVsVtxRunwise[i][j] = 0.;
+      fRefMultVsRun[i][j] = 0.;
+      fRefMultVsVtxAndRun[i][j] = c.fRefMultVsVtxAndRun[i][j];
+    }
+  }
+  for(Int_t i=0; i<64; ++i) fAvgVZEROChannelMult[i] = 0x0;
+  for(Int_t i=0; i<4; ++i) fVZEROqVecRecentering[i] = 0x0;
+}
+
+//__________________________________________________________________
+AliReducedVarManager::Context::~Context() {
+  //
+  // destructor, the calibration histograms are owned
+  //
+  delete fTPCelectronCentroidMap;
+  delete fTPCelectronWidthMap;
+  delete fPairEffMap;
+  delete fRunTotalLuminosity;
+  delete fRunTotalIntensity0;
+  delete fRunTotalIntensity1;
+  delete fRunLHCFillNumber;
+  delete fRunDipolePolarity;
+  delete fRunL3Polarity;
+  delete fRunTimeStart;
+  delete fRunTimeEnd;
+  for(Int_t i=0; i<kNMultiplicityEstimators; ++i) delete fAvgMultVsVtxAndRun[i];
+  for(Int_t i=0; i<64; ++i) delete fAvgVZEROChannelMult[i];
+  for(Int_t i=0; i<4; ++i) delete fVZEROqVecRecentering[i];
+}
+
+//__________________________________________________________________
+AliReducedVarManager::Context* AliReducedVarManager::GetContext() {
+  //
+  // context of the calling thread
+  //
+  return (gReducedVarManagerContext ? gReducedVarManagerContext : &fgDefaultContext);
+}
+
+//__________________________________________________________________
+AliReducedVarManager::Context* AliReducedVarManager::SetContext(Context* ctx) {
+  //
+  // install ctx as context of the calling thread (0x0: default context), return the previous one
+  //
+  Context* old = GetContext();
+  gReducedVarManagerContext = (ctx==&fgDefaultContext ? 0x0 : ctx);
+  return old;
+}
 
 //__________________________________________________________________
 AliReducedVarManager::AliReducedVarManager() :
@@ -200,124 +313,125 @@ void AliReducedVarManager::SetVariableDependencies() {
   //
   // Set as used those variables on which other variables calculation depends
   //
-  if(fgUsedVars[kDeltaVtxZ]) {
-    fgUsedVars[kVtxZ] = kTRUE;
-    fgUsedVars[kVtxZtpc] = kTRUE;
+  Context* ctx = GetContext();
+  if(ctx->fUsedVars[kDeltaVtxZ]) {
+    ctx->fUsedVars[kVtxZ] = kTRUE;
+    ctx->fUsedVars[kVtxZtpc] = kTRUE;
   }
-  if(fgUsedVars[kRap]) {
-    fgUsedVars[kMass] = kTRUE;
-    fgUsedVars[kP] = kTRUE;
+  if(ctx->fUsedVars[kRap]) {
+    ctx->fUsedVars[kMass] = kTRUE;
+    ctx->fUsedVars[kP] = kTRUE;
   }
-  if(fgUsedVars[kEta]) fgUsedVars[kP] = kTRUE;
+  if(ctx->fUsedVars[kEta]) ctx->fUsedVars[kP] = kTRUE;
   
   for(Int_t ih=0; ih<6; ++ih) {
-    if(fgUsedVars[kVZEROQvecX+2*6+ih]) {
-      fgUsedVars[kVZEROQvecX+0*6+ih] = kTRUE;
-      fgUsedVars[kVZEROQvecX+1*6+ih] = kTRUE;
+    if(ctx->fUsedVars[kVZEROQvecX+2*6+ih]) {
+      ctx->fUsedVars[kVZEROQvecX+0*6+ih] = kTRUE;
+      ctx->fUsedVars[kVZEROQvecX+1*6+ih] = kTRUE;
     }
-    if(fgUsedVars[kVZEROQvecY+2*6+ih]) {
-      fgUsedVars[kVZEROQvecY+0*6+ih] = kTRUE;
-      fgUsedVars[kVZEROQvecY+1*6+ih] = kTRUE;
+    if(ctx->fUsedVars[kVZEROQvecY+2*6+ih]) {
+      ctx->fUsedVars[kVZEROQvecY+0*6+ih] = kTRUE;
+      ctx->fUsedVars[kVZEROQvecY+1*6+ih] = kTRUE;
     }
-    if(fgUsedVars[kVZERORP+2*6+ih]) {
-      fgUsedVars[kVZEROQvecX+2*6+ih] = kTRUE; fgUsedVars[kVZEROQvecY+2*6+ih] = kTRUE;
-      fgUsedVars[kVZEROQvecX+0*6+ih] = kTRUE; fgUsedVars[kVZEROQvecX+1*6+ih] = kTRUE;
-      fgUsedVars[kVZEROQvecY+0*6+ih] = kTRUE; fgUsedVars[kVZEROQvecY+1*6+ih] = kTRUE;
+    if(ctx->fUsedVars[kVZERORP+2*6+ih]) {
+      ctx->fUsedVars[kVZEROQvecX+2*6+ih] = kTRUE; ctx->fUsedVars[kVZEROQvecY+2*6+ih] = kTRUE;
+      ctx->fUsedVars[kVZEROQvecX+0*6+ih] = kTRUE; ctx->fUsedVars[kVZEROQvecX+1*6+ih] = kTRUE;
+      ctx->fUsedVars[kVZEROQvecY+0*6+ih] = kTRUE; ctx->fUsedVars[kVZEROQvecY+1*6+ih] = kTRUE;
     }
-    if(fgUsedVars[kVZEROQaQcSP+ih] || fgUsedVars[kVZEROQaQcSPsine+ih]) {
-      fgUsedVars[kVZERORP+0*6+ih]    = kTRUE; fgUsedVars[kVZERORP+1*6+ih]    = kTRUE;
-      fgUsedVars[kVZEROQvecX+0*6+ih] = kTRUE; fgUsedVars[kVZEROQvecX+1*6+ih] = kTRUE;
-      fgUsedVars[kVZEROQvecY+0*6+ih] = kTRUE; fgUsedVars[kVZEROQvecY+1*6+ih] = kTRUE;
+    if(ctx->fUsedVars[kVZEROQaQcSP+ih] || ctx->fUsedVars[kVZEROQaQcSPsine+ih]) {
+      ctx->fUsedVars[kVZERORP+0*6+ih]    = kTRUE; ctx->fUsedVars[kVZERORP+1*6+ih]    = kTRUE;
+      ctx->fUsedVars[kVZEROQvecX+0*6+ih] = kTRUE; ctx->fUsedVars[kVZEROQvecX+1*6+ih] = kTRUE;
+      ctx->fUsedVars[kVZEROQvecY+0*6+ih] = kTRUE; ctx->fUsedVars[kVZEROQvecY+1*6+ih] = kTRUE;
     }
-    if(fgUsedVars[kRPXtpcXvzeroa+ih]) {
-      fgUsedVars[kTPCQvecX+ih] = kTRUE; fgUsedVars[kVZEROQvecX+ih] = kTRUE;
+    if(ctx->fUsedVars[kRPXtpcXvzeroa+ih]) {
+      ctx->fUsedVars[kTPCQvecX+ih] = kTRUE; ctx->fUsedVars[kVZEROQvecX+ih] = kTRUE;
     }
-    if(fgUsedVars[kRPXtpcXvzeroc+ih]) {
-      fgUsedVars[kTPCQvecX+ih] = kTRUE; fgUsedVars[kVZEROQvecX+6+ih] = kTRUE;
+    if(ctx->fUsedVars[kRPXtpcXvzeroc+ih]) {
+      ctx->fUsedVars[kTPCQvecX+ih] = kTRUE; ctx->fUsedVars[kVZEROQvecX+6+ih] = kTRUE;
     }
-    if(fgUsedVars[kRPYtpcYvzeroa+ih]) {
-      fgUsedVars[kTPCQvecY+ih] = kTRUE; fgUsedVars[kVZEROQvecY+ih] = kTRUE;
+    if(ctx->fUsedVars[kRPYtpcYvzeroa+ih]) {
+      ctx->fUsedVars[kTPCQvecY+ih] = kTRUE; ctx->fUsedVars[kVZEROQvecY+ih] = kTRUE;
     }
-    if(fgUsedVars[kRPYtpcYvzeroc+ih]) {
-      fgUsedVars[kTPCQvecY+ih] = kTRUE; fgUsedVars[kVZEROQvecY+6+ih] = kTRUE;
+    if(ctx->fUsedVars[kRPYtpcYvzeroc+ih]) {
+      ctx->fUsedVars[kTPCQvecY+ih] = kTRUE; ctx->fUsedVars[kVZEROQvecY+6+ih] = kTRUE;
     }  
-    if(fgUsedVars[kRPXtpcYvzeroa+ih]) {
-      fgUsedVars[kTPCQvecX+ih] = kTRUE; fgUsedVars[kVZEROQvecY+ih] = kTRUE;
+    if(ctx->fUsedVars[kRPXtpcYvzeroa+ih]) {
+      ctx->fUsedVars[kTPCQvecX+ih] = kTRUE; ctx->fUsedVars[kVZEROQvecY+ih] = kTRUE;
     }  
-    if(fgUsedVars[kRPXtpcYvzeroc+ih]) {
-      fgUsedVars[kTPCQvecX+ih] = kTRUE; fgUsedVars[kVZEROQvecY+6+ih] = kTRUE;
+    if(ctx->fUsedVars[kRPXtpcYvzeroc+ih]) {
+      ctx->fUsedVars[kTPCQvecX+ih] = kTRUE; ctx->fUsedVars[kVZEROQvecY+6+ih] = kTRUE;
     }  
-    if(fgUsedVars[kRPYtpcXvzeroa+ih]) {
-      fgUsedVars[kTPCQvecY+ih] = kTRUE; fgUsedVars[kVZEROQvecX+ih] = kTRUE;
+    if(ctx->fUsedVars[kRPYtpcXvzeroa+ih]) {
+      ctx->fUsedVars[kTPCQvecY+ih] = kTRUE; ctx->fUsedVars[kVZEROQvecX+ih] = kTRUE;
     }  
-    if(fgUsedVars[kRPYtpcXvzeroc+ih]) {
-      fgUsedVars[kTPCQvecY+ih] = kTRUE; fgUsedVars[kVZEROQvecX+6+ih] = kTRUE;
+    if(ctx->fUsedVars[kRPYtpcXvzeroc+ih]) {
+      ctx->fUsedVars[kTPCQvecY+ih] = kTRUE; ctx->fUsedVars[kVZEROQvecX+6+ih] = kTRUE;
     }  
-    if(fgUsedVars[kRPdeltaVZEROAtpc+ih]) {
-      fgUsedVars[kVZERORP+0*6+ih] = kTRUE; fgUsedVars[kTPCRP+ih] = kTRUE;
+    if(ctx->fUsedVars[kRPdeltaVZEROAtpc+ih]) {
+      ctx->fUsedVars[kVZERORP+0*6+ih] = kTRUE; ctx->fUsedVars[kTPCRP+ih] = kTRUE;
     }
-    if(fgUsedVars[kRPdeltaVZEROCtpc+ih]) {
-      fgUsedVars[kVZERORP+1*6+ih] = kTRUE; fgUsedVars[kTPCRP+ih] = kTRUE;
+    if(ctx->fUsedVars[kRPdeltaVZEROCtpc+ih]) {
+      ctx->fUsedVars[kVZERORP+1*6+ih] = kTRUE; ctx->fUsedVars[kTPCRP+ih] = kTRUE;
     }
-    if(fgUsedVars[kTPCsubResCos+ih]) {
-      fgUsedVars[kTPCRPleft+ih] = kTRUE; fgUsedVars[kTPCRPright+ih] = kTRUE;
+    if(ctx->fUsedVars[kTPCsubResCos+ih]) {
+      ctx->fUsedVars[kTPCRPleft+ih] = kTRUE; ctx->fUsedVars[kTPCRPright+ih] = kTRUE;
     }
     for(Int_t iVZEROside=0; iVZEROside<3; ++iVZEROside) {
-      if(fgUsedVars[kVZEROFlowVn+iVZEROside*6+ih] || fgUsedVars[kVZEROFlowSine+iVZEROside*6+ih] ||
-	 fgUsedVars[kVZEROuQ+iVZEROside*6+ih] || fgUsedVars[kVZEROuQsine+iVZEROside*6+ih]) {
-	fgUsedVars[kPhi] = kTRUE; fgUsedVars[kVZERORP+iVZEROside*6+ih] = kTRUE;
-	if(iVZEROside<2 && (fgUsedVars[kVZEROuQ+iVZEROside*6+ih] || fgUsedVars[kVZEROuQsine+iVZEROside*6+ih])) {
-	  fgUsedVars[kVZEROQvecX+0*6+ih] = kTRUE; fgUsedVars[kVZEROQvecX+1*6+ih] = kTRUE;
-          fgUsedVars[kVZEROQvecY+0*6+ih] = kTRUE; fgUsedVars[kVZEROQvecY+1*6+ih] = kTRUE;
+      if(ctx->fUsedVars[kVZEROFlowVn+iVZEROside*6+ih] || ctx->fUsedVars[kVZEROFlowSine+iVZEROside*6+ih] ||
+	 ctx->fUsedVars[kVZEROuQ+iVZEROside*6+ih] || ctx->fUsedVars[kVZEROuQsine+iVZEROside*6+ih]) {
+	ctx->fUsedVars[kPhi] = kTRUE; ctx->fUsedVars[kVZERORP+iVZEROside*6+ih] = kTRUE;
+	if(iVZEROside<2 && (ctx->fUsedVars[kVZEROuQ+iVZEROside*6+ih] || ctx->fUsedVars[kVZEROuQsine+iVZEROside*6+ih])) {
+	  ctx->fUsedVars[kVZEROQvecX+0*6+ih] = kTRUE; ctx->fUsedVars[kVZEROQvecX+1*6+ih] = kTRUE;
+          ctx->fUsedVars[kVZEROQvecY+0*6+ih] = kTRUE; ctx->fUsedVars[kVZEROQvecY+1*6+ih] = kTRUE;
 	}
         if(iVZEROside==2) {
-	  fgUsedVars[kVZEROQvecX+2*6+ih] = kTRUE; fgUsedVars[kVZEROQvecY+2*6+ih] = kTRUE;
-          fgUsedVars[kVZEROQvecX+0*6+ih] = kTRUE; fgUsedVars[kVZEROQvecX+1*6+ih] = kTRUE;
-          fgUsedVars[kVZEROQvecY+0*6+ih] = kTRUE; fgUsedVars[kVZEROQvecY+1*6+ih] = kTRUE;
+	  ctx->fUsedVars[kVZEROQvecX+2*6+ih] = kTRUE; ctx->fUsedVars[kVZEROQvecY+2*6+ih] = kTRUE;
+          ctx->fUsedVars[kVZEROQvecX+0*6+ih] = kTRUE; ctx->fUsedVars[kVZEROQvecX+1*6+ih] = kTRUE;
+          ctx->fUsedVars[kVZEROQvecY+0*6+ih] = kTRUE; ctx->fUsedVars[kVZEROQvecY+1*6+ih] = kTRUE;
 	}
       }
     }
-    if(fgUsedVars[kTPCFlowVn+ih] || fgUsedVars[kTPCFlowSine+ih] || fgUsedVars[kTPCuQ+ih] || fgUsedVars[kTPCuQsine+ih]) {
-      fgUsedVars[kPhi] = kTRUE;
-      fgUsedVars[kTPCQvecXtotal+ih] = kTRUE;
-      fgUsedVars[kTPCQvecYtotal+ih] = kTRUE;
+    if(ctx->fUsedVars[kTPCFlowVn+ih] || ctx->fUsedVars[kTPCFlowSine+ih] || ctx->fUsedVars[kTPCuQ+ih] || ctx->fUsedVars[kTPCuQsine+ih]) {
+      ctx->fUsedVars[kPhi] = kTRUE;
+      ctx->fUsedVars[kTPCQvecXtotal+ih] = kTRUE;
+      ctx->fUsedVars[kTPCQvecYtotal+ih] = kTRUE;
     }
    
   } // end loop over harmonics
   for(Int_t ich=0; ich<64; ++ich) {
-    if(fgUsedVars[kVZEROflowV2TPC+ich]) {
-      fgUsedVars[kVZEROChannelMult+ich] = kTRUE; fgUsedVars[kTPCRP+1] = kTRUE;
+    if(ctx->fUsedVars[kVZEROflowV2TPC+ich]) {
+      ctx->fUsedVars[kVZEROChannelMult+ich] = kTRUE; ctx->fUsedVars[kTPCRP+1] = kTRUE;
     }
   }
-  if(fgUsedVars[kPtSquared]) fgUsedVars[kPt]=kTRUE;  
-  if(fgUsedVars[kTPCnSigCorrected+kElectron]) {
-     fgUsedVars[kTPCnSig+kElectron] = kTRUE; 
-     fgUsedVars[fgVarDependencyX] = kTRUE; 
-     fgUsedVars[fgVarDependencyY] = kTRUE;
+  if(ctx->fUsedVars[kPtSquared]) ctx->fUsedVars[kPt]=kTRUE;  
+  if(ctx->fUsedVars[kTPCnSigCorrected+kElectron]) {
+     ctx->fUsedVars[kTPCnSig+kElectron] = kTRUE; 
+     ctx->fUsedVars[ctx->fVarDependencyX] = kTRUE; 
+     ctx->fUsedVars[ctx->fVarDependencyY] = kTRUE;
   }
-  if(fgUsedVars[kPairEff] || fgUsedVars[kOneOverPairEff]){
-    fgUsedVars[fgEffMapVarDependencyX] = kTRUE;
-    fgUsedVars[fgEffMapVarDependencyY] = kTRUE;
+  if(ctx->fUsedVars[kPairEff] || ctx->fUsedVars[kOneOverPairEff]){
+    ctx->fUsedVars[ctx->fEffMapVarDependencyX] = kTRUE;
+    ctx->fUsedVars[ctx->fEffMapVarDependencyY] = kTRUE;
   }
-  if(fgUsedVars[kNTracksITSoutVsSPDtracklets] || fgUsedVars[kNTracksTPCoutVsSPDtracklets] ||
-     fgUsedVars[kNTracksTOFoutVsSPDtracklets] || fgUsedVars[kNTracksTRDoutVsSPDtracklets])
-     fgUsedVars[kSPDntracklets] = kTRUE;
+  if(ctx->fUsedVars[kNTracksITSoutVsSPDtracklets] || ctx->fUsedVars[kNTracksTPCoutVsSPDtracklets] ||
+     ctx->fUsedVars[kNTracksTOFoutVsSPDtracklets] || ctx->fUsedVars[kNTracksTRDoutVsSPDtracklets])
+     ctx->fUsedVars[kSPDntracklets] = kTRUE;
   
-  if(fgUsedVars[kRapMC]) fgUsedVars[kMassMC] = kTRUE;
+  if(ctx->fUsedVars[kRapMC]) ctx->fUsedVars[kMassMC] = kTRUE;
 
-  if(fgUsedVars[kPairPhiV]){
-    fgUsedVars[kL3Polarity] = kTRUE;
+  if(ctx->fUsedVars[kPairPhiV]){
+    ctx->fUsedVars[kL3Polarity] = kTRUE;
   }
-  if(fgUsedVars[kMassDcaPtCorr] ) {
-    fgUsedVars[kMass]          = kTRUE;
-    fgUsedVars[kPt]            = kTRUE;
-    fgUsedVars[kPairDcaXYSqrt] = kTRUE;
+  if(ctx->fUsedVars[kMassDcaPtCorr] ) {
+    ctx->fUsedVars[kMass]          = kTRUE;
+    ctx->fUsedVars[kPt]            = kTRUE;
+    ctx->fUsedVars[kPairDcaXYSqrt] = kTRUE;
   }
-  if(fgUsedVars[kOpAngDcaPtCorr] ) {
-    fgUsedVars[kPairOpeningAngle] = kTRUE;
-    fgUsedVars[kOneOverSqrtPt]    = kTRUE;
-    fgUsedVars[kPt]               = kTRUE;
-    fgUsedVars[kPairDcaXYSqrt]    = kTRUE;
+  if(ctx->fUsedVars[kOpAngDcaPtCorr] ) {
+    ctx->fUsedVars[kPairOpeningAngle] = kTRUE;
+    ctx->fUsedVars[kOneOverSqrtPt]    = kTRUE;
+    ctx->fUsedVars[kPt]               = kTRUE;
+    ctx->fUsedVars[kPairDcaXYSqrt]    = kTRUE;
   }
 }
 
@@ -326,7 +440,8 @@ void AliReducedVarManager::FillEventInfo(Float_t* values) {
   //
   // Fill event information
   //
-  FillEventInfo(fgEvent, values, fgEventPlane);
+  Context* ctx = GetContext();
+  FillEventInfo(ctx->fEvent, values, ctx->fEventPlane);
 }
 
 //__________________________________________________________________
@@ -334,6 +449,7 @@ void AliReducedVarManager::FillEventInfo(BASEEVENT* baseEvent, Float_t* values,
   //
   // fill event wise info
   //
+  Context* ctx = GetContext();
   // Basic event information
 
   values[kVtxX]                      = baseEvent->Vertex(0);
@@ -360,105 +476,105 @@ void AliReducedVarManager::FillEventInfo(BASEEVENT* baseEvent, Float_t* values,
   EVENT* event = (EVENT*)baseEvent;
   
   // Update run wise information if available (needed for the first event filled and whenever the run changes)
-  if(fgCurrentRunNumber!=baseEvent->RunNo()) {
-    fgCurrentRunNumber = baseEvent->RunNo();
+  if(ctx->fCurrentRunNumber!=baseEvent->RunNo()) {
+    ctx->fCurrentRunNumber = baseEvent->RunNo();
     // GRP and LHC information
-    if(fgRunTotalLuminosity) values[kTotalLuminosity] = fgRunTotalLuminosity->GetBinContent(fgRunTotalLuminosity->GetXaxis()->FindBin(Form("%d",fgCurrentRunNumber)));
-    if(fgRunTotalIntensity0) values[kBeamIntensity0] = fgRunTotalIntensity0->GetBinContent(fgRunTotalIntensity0->GetXaxis()->FindBin(Form("%d",fgCurrentRunNumber)));
-    if(fgRunTotalIntensity1) values[kBeamIntensity1] = fgRunTotalIntensity1->GetBinContent(fgRunTotalIntensity1->GetXaxis()->FindBin(Form("%d",fgCurrentRunNumber)));
-    if(fgRunLHCFillNumber) values[kLHCFillNumber] = fgRunLHCFillNumber->GetBinContent(fgRunLHCFillNumber->GetXaxis()->FindBin(Form("%d",fgCurrentRunNumber)));
-    if(fgRunDipolePolarity) values[kDipolePolarity] = fgRunDipolePolarity->GetBinContent(fgRunDipolePolarity->GetXaxis()->FindBin(Form("%d",fgCurrentRunNumber)));
-    if(fgRunL3Polarity) values[kL3Polarity] = fgRunL3Polarity->GetBinContent(fgRunL3Polarity->GetXaxis()->FindBin(Form("%d",fgCurrentRunNumber)));
-    if(fgRunTimeStart) values[kRunTimeStart] = fgRunTimeStart->GetBinContent(fgRunTimeStart->GetXaxis()->FindBin(Form("%d",fgCurrentRunNumber)));
-    if(fgRunTimeEnd) values[kRunTimeEnd] = fgRunTimeEnd->GetBinContent(fgRunTimeEnd->GetXaxis()->FindBin(Form("%d",fgCurrentRunNumber)));
+    if(ctx->fRunTotalLuminosity) values[kTotalLuminosity] = ctx->fRunTotalLuminosity->GetBinContent(ctx->fRunTotalLuminosity->GetXaxis()->FindBin(Form("%d",ctx->fCurrentRunNumber)));
+    if(ctx->fRunTotalIntensity0) values[kBeamIntensity0] = ctx->fRunTotalIntensity0->GetBinContent(ctx->fRunTotalIntensity0->GetXaxis()->FindBin(Form("%d",ctx->fCurrentRunNumber)));
+    if(ctx->fRunTotalIntensity1) values[kBeamIntensity1] = ctx->fRunTotalIntensity1->GetBinContent(ctx->fRunTotalIntensity1->GetXaxis()->FindBin(Form("%d",ctx->fCurrentRunNumber)));
+    if(ctx->fRunLHCFillNumber) values[kLHCFillNumber] = ctx->fRunLHCFillNumber->GetBinContent(ctx->fRunLHCFillNumber->GetXaxis()->FindBin(Form("%d",ctx->fCurrentRunNumber)));
+    if(ctx->fRunDipolePolarity) values[kDipolePolarity] = ctx->fRunDipolePolarity->GetBinContent(ctx->fRunDipolePolarity->GetXaxis()->FindBin(Form("%d",ctx->fCurrentRunNumber)));
+    if(ctx->fRunL3Polarity) values[kL3Polarity] = ctx->fRunL3Polarity->GetBinContent(ctx->fRunL3Polarity->GetXaxis()->FindBin(Form("%d",ctx->fCurrentRunNumber)));
+    if(ctx->fRunTimeStart) values[kRunTimeStart] = ctx->fRunTimeStart->GetBinContent(ctx->fRunTimeStart->GetXaxis()->FindBin(Form("%d",ctx->fCurrentRunNumber)));
+    if(ctx->fRunTimeEnd) values[kRunTimeEnd] = ctx->fRunTimeEnd->GetBinContent(ctx->fRunTimeEnd->GetXaxis()->FindBin(Form("%d",ctx->fCurrentRunNumber)));
     
     // VZERO calibration
-    if(fgVZEROCalibrationPath.Data()[0]!='\0') {
-       cout << "AliReducedVarManager::Info  Attempting to load VZERO calibration and/or recentering histograms from path: " << endl << fgVZEROCalibrationPath.Data() << endl;
-      TFile* calibFile = TFile::Open(Form("%s/000%d/dstAnalysisHistograms.root", fgVZEROCalibrationPath.Data(), fgCurrentRunNumber));
+    if(ctx->fVZEROCalibrationPath.Data()[0]!='\0') {
+       cout << "AliReducedVarManager::Info  Attempting to load VZERO calibration and/or recentering histograms from path: " << endl << ctx->fVZEROCalibrationPath.Data() << endl;
+      TFile* calibFile = TFile::Open(Form("%s/000%d/dstAnalysisHistograms.root", ctx->fVZEROCalibrationPath.Data(), ctx->fCurrentRunNumber));
       THashList* mainList = (THashList*)calibFile->Get("jpsi2eeHistos");
       THashList* calibList = (THashList*)mainList->FindObject("Event_AfterCuts");
       if(!calibList) {
-         cout << "AliReducedVarManager::Info  Cannot open calibration file for run " << fgCurrentRunNumber << endl;
+         cout << "AliReducedVarManager::Info  Cannot open calibration file for run " << ctx->fCurrentRunNumber << endl;
          cout << "                        Will run uncalibrated and not-recentered!" << endl;
-         fgOptionCalibrateVZEROqVec = kFALSE;
-         fgOptionRecenterVZEROqVec = kFALSE;
+         ctx->fOptionCalibrateVZEROqVec = kFALSE;
+         ctx->fOptionRecenterVZEROqVec = kFALSE;
       }
-      cout << "AliReducedVarManager::Info  Loading VZERO calibration and/or recentering parameters for run " << fgCurrentRunNumber << endl;
-      if(fgOptionCalibrateVZEROqVec) {
+      cout << "AliReducedVarManager::Info  Loading VZERO calibration and/or recentering parameters for run " << ctx->fCurrentRunNumber << endl;
+      if(ctx->fOptionCalibrateVZEROqVec) {
         for(Int_t iCh=0; iCh<64; ++iCh) {
            
-           fgAvgVZEROChannelMult[iCh] = (TProfile2D*)calibList->FindObject(Form("VZEROmult_ch%d_VtxCent_prof", iCh))->Clone(Form("run%d_ch%d", fgCurrentRunNumber, iCh));
-           fgAvgVZEROChannelMult[iCh]->SetDirectory(0x0);
+           ctx->fAvgVZEROChannelMult[iCh] = (TProfile2D*)calibList->FindObject(Form("VZEROmult_ch%d_VtxCent_prof", iCh))->Clone(Form("run%d_ch%d", ctx->fCurrentRunNumber, iCh));
+           ctx->fAvgVZEROChannelMult[iCh]->SetDirectory(0x0);
         }
       }
-      if(fgOptionRecenterVZEROqVec) {
-         fgVZEROqVecRecentering[0] = (TProfile2D*)calibList->FindObject(Form("QvecX_sideA_h2_CentSPDVtxZ_prof"))->Clone(Form("run%d_QvecX_VZEROA", fgCurrentRunNumber));
-         fgVZEROqVecRecentering[0]->SetDirectory(0x0);
-         fgVZEROqVecRecentering[1] = (TProfile2D*)calibList->FindObject(Form("QvecY_sideA_h2_CentSPDVtxZ_prof"))->Clone(Form("run%d_QvecY_VZEROA", fgCurrentRunNumber));
-         fgVZEROqVecRecentering[1]->SetDirectory(0x0);
-         fgVZEROqVecRecentering[2] = (TProfile2D*)calibList->FindObject(Form("QvecX_sideC_h2_CentSPDVtxZ_prof"))->Clone(Form("run%d_QvecX_VZEROC", fgCurrentRunNumber));
-         fgVZEROqVecRecentering[2]->SetDirectory(0x0);
-         fgVZEROqVecRecentering[3] = (TProfile2D*)calibList->FindObject(Form("QvecY_sideC_h2_CentSPDVtxZ_prof"))->Clone(Form("run%d_QvecY_VZEROC", fgCurrentRunNumber));
-         fgVZEROqVecRecentering[3]->SetDirectory(0x0);
+      if(ctx->fOptionRecenterVZEROqVec) {
+         ctx->fVZEROqVecRecentering[0] = (TProfile2D*)calibList->FindObject(Form("QvecX_sideA_h2_CentSPDVtxZ_prof"))->Clone(Form("run%d_QvecX_VZEROA", ctx->fCurrentRunNumber));
+         ctx->fVZEROqVecRecentering[0]->SetDirectory(0x0);
+         ctx->fVZEROqVecRecentering[1] = (TProfile2D*)calibList->FindObject(Form("QvecY_sideA_h2_CentSPDVtxZ_prof"))->Clone(Form("run%d_QvecY_VZEROA", ctx->fCurrentRunNumber));
+         ctx->fVZEROqVecRecentering[1]->SetDirectory(0x0);
+         ctx->fVZEROqVecRecentering[2] = (TProfile2D*)calibList->FindObject(Form("QvecX_sideC_h2_CentSPDVtxZ_prof"))->Clone(Form("run%d_QvecX_VZEROC", ctx->fCurrentRunNumber));
+         ctx->fVZEROqVecRecentering[2]->SetDirectory(0x0);
+         ctx->fVZEROqVecRecentering[3] = (TProfile2D*)calibList->FindObject(Form("QvecY_sideC_h2_CentSPDVtxZ_prof"))->Clone(Form("run%d_QvecY_VZEROC", ctx->fCurrentRunNumber));
+         ctx->fVZEROqVecRecentering[3]->SetDirectory(0x0);
       }
       calibFile->Close();
     }
 
-    if(fgUsedVars[kRunID] && fgRunNumbers.size() && fgRunID < 0  ){
-      for( fgRunID = 0; fgRunNumbers[ fgRunID ] != fgCurrentRunNumber && fgRunID< (Int_t) fgRunNumbers.size() ; ++fgRunID );
+    if(ctx->fUsedVars[kRunID] && ctx->fRunNumbers.size() && ctx->fRunID < 0  ){
+      for( ctx->fRunID = 0; ctx->fRunNumbers[ ctx->fRunID ] != ctx->fCurrentRunNumber && ctx->fRunID< (Int_t) ctx->fRunNumbers.size() ; ++ctx->fRunID );
     }
     for( int iEstimator =0 ; iEstimator < kNMultiplicityEstimators ; ++iEstimator ){
-      if( fgAvgMultVsVtxAndRun[iEstimator] ){
-        Bool_t fillGlobal = !fgAvgMultVsVtxGlobal[iEstimator];
-        fgAvgMultVsVtxRunwise  [iEstimator] = fgAvgMultVsVtxAndRun[iEstimator]->ProfileY( Form("AvgMultVsVtxRunwise%d",iEstimator )   , fgRunID, fgRunID);
+      if( ctx->fAvgMultVsVtxAndRun[iEstimator] ){
+        Bool_t fillGlobal = !ctx->fAvgMultVsVtxGlobal[iEstimator];
+        ctx->fAvgMultVsVtxRunwise  [iEstimator] = ctx->fAvgMultVsVtxAndRun[iEstimator]->ProfileY( Form("AvgMultVsVtxRunwise%d",iEstimator )   , ctx->fRunID, ctx->fRunID);
         if( fillGlobal ){
-          fgAvgMultVsVtxGlobal [iEstimator] = fgAvgMultVsVtxAndRun[iEstimator]->ProfileY( Form("AvgMultVsVtxGlobal%d", iEstimator)    );
-          fgAvgMultVsRun       [iEstimator] = fgAvgMultVsVtxAndRun[iEstimator]->ProfileX( Form("AvgMultVsRun%d", iEstimator)  );
+          ctx->fAvgMultVsVtxGlobal [iEstimator] = ctx->fAvgMultVsVtxAndRun[iEstimator]->ProfileY( Form("AvgMultVsVtxGlobal%d", iEstimator)    );
+          ctx->fAvgMultVsRun       [iEstimator] = ctx->fAvgMultVsVtxAndRun[iEstimator]->ProfileX( Form("AvgMultVsRun%d", iEstimator)  );
         }
         for( int iReference = 0; iReference < kNReferenceMultiplicities; ++ iReference  ){
           Double_t refVsVtx, refVsVtxGlobal, refVsRun;
           switch ( iReference ){
             case kMaximumMultiplicity :
-              refVsVtx = fgAvgMultVsVtxRunwise[iEstimator]->GetMaximum();
+              refVsVtx = ctx->fAvgMultVsVtxRunwise[iEstimator]->GetMaximum();
               if( fillGlobal ){
-                refVsVtxGlobal = fgAvgMultVsVtxGlobal[iEstimator]->GetMaximum();
-                refVsRun       = fgAvgMultVsVtxAndRun[iEstimator]->GetMaximum();
+                refVsVtxGlobal = ctx->fAvgMultVsVtxGlobal[iEstimator]->GetMaximum();
+                refVsRun       = ctx->fAvgMultVsVtxAndRun[iEstimator]->GetMaximum();
               }
               break;
             case kMinimumMultiplicity :
-              refVsVtx = fgAvgMultVsVtxRunwise[iEstimator]->GetMinimum();
+              refVsVtx = ctx->fAvgMultVsVtxRunwise[iEstimator]->GetMinimum();
               if( fillGlobal ){
-                refVsVtxGlobal = fgAvgMultVsVtxGlobal[iEstimator]->GetMinimum();
-                refVsRun       = fgAvgMultVsVtxAndRun[iEstimator]->GetMinimum();
+                refVsVtxGlobal = ctx->fAvgMultVsVtxGlobal[iEstimator]->GetMinimum();
+                refVsRun       = ctx->fAvgMultVsVtxAndRun[iEstimator]->GetMinimum();
               }
               break;
             case kMeanMultiplicity :
-              refVsVtx = 0.5 * ( fgAvgMultVsVtxRunwise[iEstimator]->GetMaximum() +  fgAvgMultVsVtxRunwise[iEstimator]->GetMinimum() );
+              refVsVtx = 0.5 * ( ctx->fAvgMultVsVtxRunwise[iEstimator]->GetMaximum() +  ctx->fAvgMultVsVtxRunwise[iEstimator]->GetMinimum() );
               if( fillGlobal ){
-                refVsVtxGlobal = 0.5 * ( fgAvgMultVsVtxGlobal[iEstimator]->GetMaximum() + fgAvgMultVsVtxGlobal[iEstimator]->GetMinimum() ) ;
-                refVsRun       = 0.5 * ( fgAvgMultVsVtxAndRun[iEstimator]->GetMaximum() + fgAvgMultVsVtxAndRun[iEstimator]->GetMinimum() );
+                refVsVtxGlobal = 0.5 * ( ctx->fAvgMultVsVtxGlobal[iEstimator]->GetMaximum() + ctx->fAvgMultVsVtxGlobal[iEstimator]->GetMinimum() ) ;
+                refVsRun       = 0.5 * ( ctx->fAvgMultVsVtxAndRun[iEstimator]->GetMaximum() + ctx->fAvgMultVsVtxAndRun[iEstimator]->GetMinimum() );
               }
               break;
           }
-          fgRefMultVsVtxRunwise  [iEstimator][iReference] = refVsVtx;
+          ctx->fRefMultVsVtxRunwise  [iEstimator][iReference] = refVsVtx;
           if(fillGlobal){
-            fgRefMultVsVtxGlobal [iEstimator][iReference] = refVsVtxGlobal;
-            fgRefMultVsRun       [iEstimator][iReference] = refVsRun;
+            ctx->fRefMultVsVtxGlobal [iEstimator][iReference] = refVsVtxGlobal;
+            ctx->fRefMultVsRun       [iEstimator][iReference] = refVsRun;
           }
         }
       }
     }
   }
 
-  values[kRunNo] = fgCurrentRunNumber;
-  values[kRunID] = fgRunID;
+  values[kRunNo] = ctx->fCurrentRunNumber;
+  values[kRunID] = ctx->fRunID;
   
   values[kEventNumberInFile]    = event->EventNumberInFile();
   values[kBC]                   = event->BC();
   values[kTimeStamp]            = event->TimeStamp();
-  if(fgUsedVars[kTimeRelativeSOR]) values[kTimeRelativeSOR] = (event->TimeStamp() - values[kRunTimeStart]) / 60.;
-  if(fgUsedVars[kTimeRelativeSORfraction] && 
+  if(ctx->fUsedVars[kTimeRelativeSOR]) values[kTimeRelativeSOR] = (event->TimeStamp() - values[kRunTimeStart]) / 60.;
+  if(ctx->fUsedVars[kTimeRelativeSORfraction] && 
      (values[kRunTimeEnd]-values[kRunTimeStart])>1.)   // the run should be longer than 1 second ... 
     values[kTimeRelativeSORfraction] = (event->TimeStamp() - values[kRunTimeStart]) / (values[kRunTimeEnd] - values[kRunTimeStart]);
   values[kEventType]            = event->EventType();
@@ -487,27 +603,27 @@ void AliReducedVarManager::FillEventInfo(BASEEVENT* baseEvent, Float_t* values,
   values[kVtxZspd]              = event->VertexSPD(2);
   values[kNVtxSPDContributors]  = event->VertexSPDContributors();
   
-  if(fgUsedVars[kDeltaVtxZ]) values[kDeltaVtxZ] = values[kVtxZ] - values[kVtxZtpc];
-  if(fgUsedVars[kDeltaVtxZspd]) values[kDeltaVtxZspd] = values[kVtxZ] - values[kVtxZspd];
+  if(ctx->fUsedVars[kDeltaVtxZ]) values[kDeltaVtxZ] = values[kVtxZ] - values[kVtxZtpc];
+  if(ctx->fUsedVars[kDeltaVtxZspd]) values[kDeltaVtxZspd] = values[kVtxZ] - values[kVtxZspd];
   
   for(Int_t iflag=0;iflag<32;++iflag) 
     values[kNTracksPerTrackingStatus+iflag] = event->TracksPerTrackingFlag(iflag);
   
-  // set the fgUsedVars to true as these might have been set to false in the previous event
-  fgUsedVars[kNTracksTPCoutVsITSout] = kTRUE;
-  fgUsedVars[kNTracksTRDoutVsITSout] = kTRUE;
-  fgUsedVars[kNTracksTOFoutVsITSout] = kTRUE;
-  fgUsedVars[kNTracksTRDoutVsTPCout] = kTRUE;
-  fgUsedVars[kNTracksTOFoutVsTPCout] = kTRUE;
-  fgUsedVars[kNTracksTOFoutVsTRDout] = kTRUE;
+  // set the ctx->fUsedVars to true as these might have been set to false in the previous event
+  ctx->fUsedVars[kNTracksTPCoutVsITSout] = kTRUE;
+  ctx->fUsedVars[kNTracksTRDoutVsITSout] = kTRUE;
+  ctx->fUsedVars[kNTracksTOFoutVsITSout] = kTRUE;
+  ctx->fUsedVars[kNTracksTRDoutVsTPCout] = kTRUE;
+  ctx->fUsedVars[kNTracksTOFoutVsTPCout] = kTRUE;
+  ctx->fUsedVars[kNTracksTOFoutVsTRDout] = kTRUE;
   if(TMath::Abs(values[kNTracksPerTrackingStatus+kITSout])>0.01) {
     values[kNTracksTPCoutVsITSout] = values[kNTracksPerTrackingStatus+kTPCout]/values[kNTracksPerTrackingStatus+kITSout];
     values[kNTracksTRDoutVsITSout] = values[kNTracksPerTrackingStatus+kTRDout]/values[kNTracksPerTrackingStatus+kITSout]; 
     values[kNTracksTOFoutVsITSout] = values[kNTracksPerTrackingStatus+kTOFout]/values[kNTracksPerTrackingStatus+kITSout];
   }
   else {
-     // if these values are undefined, set fgUsedVars as false such that the values are not filled in histograms
-     fgUsedVars[kNTracksTPCoutVsITSout] = kFALSE; fgUsedVars[kNTracksTRDoutVsITSout] = kFALSE; fgUsedVars[kNTracksTOFoutVsITSout] = kFALSE;
+     // if these values are undefined, set ctx->fUsedVars as false such that the values are not filled in histograms
+     ctx->fUsedVars[kNTracksTPCoutVsITSout] = kFALSE; ctx->fUsedVars[kNTracksTRDoutVsITSout] = kFALSE; ctx->fUsedVars[kNTracksTOFoutVsITSout] = kFALSE;
   }
   
   if(TMath::Abs(values[kNTracksPerTrackingStatus+kTPCout])>0.01) {
@@ -515,13 +631,13 @@ void AliReducedVarManager::FillEventInfo(BASEEVENT* baseEvent, Float_t* values,
     values[kNTracksTOFoutVsTPCout] = values[kNTracksPerTrackingStatus+kTOFout]/values[kNTracksPerTrackingStatus+kTPCout];
   }
   else {
-     fgUsedVars[kNTracksTRDoutVsTPCout] = kFALSE; fgUsedVars[kNTracksTOFoutVsTPCout] = kFALSE; 
+     ctx->fUsedVars[kNTracksTRDoutVsTPCout] = kFALSE; ctx->fUsedVars[kNTracksTOFoutVsTPCout] = kFALSE; 
   }
   
   if(TMath::Abs(values[kNTracksPerTrackingStatus+kTRDout])>0.01)
     values[kNTracksTOFoutVsTRDout] = values[kNTracksPerTrackingStatus+kTOFout]/values[kNTracksPerTrackingStatus+kTRDout];
   else
-     fgUsedVars[kNTracksTOFoutVsTRDout] = kFALSE;
+     ctx->fUsedVars[kNTracksTOFoutVsTRDout] = kFALSE;
 
   // Multiplicity estimators
 
@@ -549,7 +665,7 @@ void AliReducedVarManager::FillEventInfo(BASEEVENT* baseEvent, Float_t* values,
   for( Int_t iEstimator = 0; iEstimator < kNMultiplicityEstimators; ++iEstimator){
     Int_t estimator = kMultiplicity + iEstimator;
     if( estimator == kVZEROACTotalMult || estimator == kSPDnTracklets10EtaVtxCorr ){
-       if( fgAvgMultVsVtxAndRun[iEstimator] ){
+       if( ctx->fAvgMultVsVtxAndRun[iEstimator] ){
          for( Int_t iCorrection = 0; iCorrection < kNCorrections; ++iCorrection  ){
             for(Int_t iReference = 0 ; iReference <  kNReferenceMultiplicities; ++iReference ){
                Int_t indexNotSmeared = GetCorrectedMultiplicity( estimator, iCorrection, iReference, kNoSmearing );
@@ -561,8 +677,8 @@ void AliReducedVarManager::FillEventInfo(BASEEVENT* baseEvent, Float_t* values,
                      Int_t indexBinNotSmeared = GetCorrectedMultiplicity( kSPDntrackletsEtaBin+ieta, iCorrection, iReference, kNoSmearing );
                      Int_t indexBinSmeared    = GetCorrectedMultiplicity( kSPDntrackletsEtaBin+ieta, iCorrection, iReference, kPoissonSmearing );
                 
-                     if( fgUsedVars[indexBinNotSmeared]) values[ indexNotSmeared ] += values[ indexBinNotSmeared ];
-                     if( fgUsedVars[indexBinSmeared]) values[ indexSmeared ] += values[ indexBinSmeared ];
+                     if( ctx->fUsedVars[indexBinNotSmeared]) values[ indexNotSmeared ] += values[ indexBinNotSmeared ];
+                     if( ctx->fUsedVars[indexBinSmeared]) values[ indexSmeared ] += values[ indexBinSmeared ];
                   }
                }
                else{
@@ -581,9 +697,9 @@ void AliReducedVarManager::FillEventInfo(BASEEVENT* baseEvent, Float_t* values,
     }  // end if VZEROAC || kSPDnTracklets10EtaVtxCorr estimators
     
     else{
-      if( fgAvgMultVsVtxAndRun[iEstimator] ){
-        Int_t vtxBin = fgAvgMultVsVtxAndRun[iEstimator]->GetYaxis()->FindBin( values[kVtxZ] );
-        Int_t runBin = fgAvgMultVsVtxAndRun[iEstimator]->GetXaxis()->FindBin( values[kRunID] );
+      if( ctx->fAvgMultVsVtxAndRun[iEstimator] ){
+        Int_t vtxBin = ctx->fAvgMultVsVtxAndRun[iEstimator]->GetYaxis()->FindBin( values[kVtxZ] );
+        Int_t runBin = ctx->fAvgMultVsVtxAndRun[iEstimator]->GetXaxis()->FindBin( values[kRunID] );
         Double_t multRaw = values[ estimator ];
         for( Int_t iCorrection = 0; iCorrection < kNCorrections; ++iCorrection  ){
           for(Int_t iReference = 0 ; iReference <  kNReferenceMultiplicities; ++iReference ){
@@ -593,8 +709,8 @@ void AliReducedVarManager::FillEventInfo(BASEEVENT* baseEvent, Float_t* values,
             Double_t multCorrSmeared = multRaw;
     // apply vertex and gain loss correction simultaneously
             if( iCorrection == kVertexCorrection2D  ){
-              Double_t localAvg = fgAvgMultVsVtxAndRun[iEstimator]->GetBinContent( vtxBin, runBin);
-              Double_t refMult  = fgRefMultVsVtxAndRun[iEstimator][iReference];
+              Double_t localAvg = ctx->fAvgMultVsVtxAndRun[iEstimator]->GetBinContent( vtxBin, runBin);
+              Double_t refMult  = ctx->fRefMultVsVtxAndRun[iEstimator][iReference];
               multCorr *=  localAvg ?  refMult / localAvg : 1.;
               Double_t deltaM =  localAvg ?  multRaw * ( refMult/localAvg - 1) : 0.;
               multCorrSmeared += (deltaM>0 ? 1. : -1.) * gRandom->Poisson(TMath::Abs(deltaM));
@@ -605,13 +721,13 @@ void AliReducedVarManager::FillEventInfo(BASEEVENT* baseEvent, Float_t* values,
               switch( iCorrection ){
                 case kVertexCorrectionGlobal:
                 case kVertexCorrectionGlobalGainLoss:
-                  localAvgVsVtx = fgAvgMultVsVtxGlobal[iEstimator]->GetBinContent( vtxBin );
-                  refMultVsVtx  = fgRefMultVsVtxGlobal[iEstimator][iReference];
+                  localAvgVsVtx = ctx->fAvgMultVsVtxGlobal[iEstimator]->GetBinContent( vtxBin );
+                  refMultVsVtx  = ctx->fRefMultVsVtxGlobal[iEstimator][iReference];
                   break;
                 case kVertexCorrectionRunwise:
                 case kVertexCorrectionRunwiseGainLoss:
-                  localAvgVsVtx = fgAvgMultVsVtxRunwise[iEstimator]->GetBinContent( vtxBin );
-                  refMultVsVtx  = fgRefMultVsVtxRunwise[iEstimator][iReference];
+                  localAvgVsVtx = ctx->fAvgMultVsVtxRunwise[iEstimator]->GetBinContent( vtxBin );
+                  refMultVsVtx  = ctx->fRefMultVsVtxRunwise[iEstimator][iReference];
                   break;
               }
               multCorr        *= localAvgVsVtx ? refMultVsVtx / localAvgVsVtx : 1.;
@@ -619,8 +735,8 @@ void AliReducedVarManager::FillEventInfo(BASEEVENT* baseEvent, Float_t* values,
               multCorrSmeared += (deltaM>0 ? 1. : -1.) * gRandom->Poisson(TMath::Abs(deltaM));
     // then apply gain loss correction
               if( iCorrection == kVertexCorrectionGlobalGainLoss || iCorrection == kVertexCorrectionRunwiseGainLoss  ){
-                Double_t localAvgVsRun = fgAvgMultVsRun[iEstimator]->GetBinContent( runBin );
-                Double_t refMultVsRun  = fgRefMultVsRun[iEstimator][iReference];
+                Double_t localAvgVsRun = ctx->fAvgMultVsRun[iEstimator]->GetBinContent( runBin );
+                Double_t refMultVsRun  = ctx->fRefMultVsRun[iEstimator][iReference];
                 multCorr        *= localAvgVsRun ? refMultVsRun / localAvgVsRun : 1.;
                 deltaM           = localAvgVsRun ? multCorrSmeared  * ( refMultVsRun/localAvgVsRun - 1) : 0;
                 multCorrSmeared += (deltaM>0 ? 1. : -1.) * gRandom->Poisson(TMath::Abs(deltaM));
@@ -628,8 +744,8 @@ void AliReducedVarManager::FillEventInfo(BASEEVENT* baseEvent, Float_t* values,
             }
             values[ indexNotSmeared ] = multCorr;
             values[ indexSmeared ]    = multCorrSmeared;
-            fgUsedVars [indexNotSmeared] = kTRUE;
-            fgUsedVars [indexSmeared] = kTRUE;
+            ctx->fUsedVars [indexNotSmeared] = kTRUE;
+            ctx->fUsedVars [indexSmeared] = kTRUE;
             
           }
         }
@@ -637,10 +753,10 @@ void AliReducedVarManager::FillEventInfo(BASEEVENT* baseEvent, Float_t* values,
     }  // end else
   }  // end loop over multiplicity estimators
 
-  fgUsedVars[kNTracksITSoutVsSPDtracklets] = kTRUE;  
-  fgUsedVars[kNTracksTPCoutVsSPDtracklets] = kTRUE;
-  fgUsedVars[kNTracksTRDoutVsSPDtracklets] = kTRUE;
-  fgUsedVars[kNTracksTOFoutVsSPDtracklets] = kTRUE;
+  ctx->fUsedVars[kNTracksITSoutVsSPDtracklets] = kTRUE;  
+  ctx->fUsedVars[kNTracksTPCoutVsSPDtracklets] = kTRUE;
+  ctx->fUsedVars[kNTracksTRDoutVsSPDtracklets] = kTRUE;
+  ctx->fUsedVars[kNTracksTOFoutVsSPDtracklets] = kTRUE;
   if(values[kSPDntracklets]>0.01) {
     values[kNTracksITSoutVsSPDtracklets] = values[kNTracksPerTrackingStatus+kITSout] / values[kSPDntracklets];
     values[kNTracksTPCoutVsSPDtracklets] = values[kNTracksPerTrackingStatus+kTPCout] / values[kSPDntracklets];
@@ -648,10 +764,10 @@ void AliReducedVarManager::FillEventInfo(BASEEVENT* baseEvent, Float_t* values,
     values[kNTracksTOFoutVsSPDtracklets] = values[kNTracksPerTrackingStatus+kTOFout] / values[kSPDntracklets];
   }
   else {
-     fgUsedVars[kNTracksITSoutVsSPDtracklets] = kFALSE;  
-     fgUsedVars[kNTracksTPCoutVsSPDtracklets] = kFALSE;
-     fgUsedVars[kNTracksTRDoutVsSPDtracklets] = kFALSE;
-     fgUsedVars[kNTracksTOFoutVsSPDtracklets] = kFALSE;
+     ctx->fUsedVars[kNTracksITSoutVsSPDtracklets] = kFALSE;  
+     ctx->fUsedVars[kNTracksTPCoutVsSPDtracklets] = kFALSE;
+     ctx->fUsedVars[kNTracksTRDoutVsSPDtracklets] = kFALSE;
+     ctx->fUsedVars[kNTracksTOFoutVsSPDtracklets] = kFALSE;
   }
     
   values[kNCaloClusters]   = event->GetNCaloClusters();
@@ -664,45 +780,45 @@ void AliReducedVarManager::FillEventInfo(BASEEVENT* baseEvent, Float_t* values,
   values[kSPDnSingleClusters] = event->SPDnSingleClusters();
 
   //VZERO detector information
-  fgUsedVars[kNTracksTPCoutVsVZEROTotalMult] = kTRUE;
+  ctx->fUsedVars[kNTracksTPCoutVsVZEROTotalMult] = kTRUE;
   if(values[kVZEROTotalMult]>1.0e-5)
      values[kNTracksTPCoutVsVZEROTotalMult] = values[kNTracksPerTrackingStatus+kTPCout] / values[kVZEROTotalMult];
   else
-     fgUsedVars[kNTracksTPCoutVsVZEROTotalMult] = kFALSE;
+     ctx->fUsedVars[kNTracksTPCoutVsVZEROTotalMult] = kFALSE;
   
   values[kVZEROAemptyChannels] = 0;
   values[kVZEROCemptyChannels] = 0;
-  for(Int_t ich=0;ich<64;++ich) fgUsedVars[kVZEROChannelMult+ich] = kTRUE; 
+  for(Int_t ich=0;ich<64;++ich) ctx->fUsedVars[kVZEROChannelMult+ich] = kTRUE; 
   Float_t theta=0.0;
   for(Int_t ich=0;ich<64;++ich) {
-    if(fgUsedVars[kVZEROChannelMult+ich]) {
+    if(ctx->fUsedVars[kVZEROChannelMult+ich]) {
       values[kVZEROChannelMult+ich] = event->MultChannelVZERO(ich);
       if(values[kVZEROChannelMult+ich]<fgkVZEROminMult) {
-        fgUsedVars[kVZEROChannelMult+ich] = kFALSE;   // will not be filled in histograms by the histogram manager
+        ctx->fUsedVars[kVZEROChannelMult+ich] = kFALSE;   // will not be filled in histograms by the histogram manager
         if(ich<32) values[kVZEROCemptyChannels] += 1;
         else values[kVZEROAemptyChannels] += 1;
       }
     }
-    if(fgUsedVars[kVZEROChannelEta+ich]) {
+    if(ctx->fUsedVars[kVZEROChannelEta+ich]) {
       if(ich<32) theta = TMath::ATan(fgkVZEROChannelRadii[ich]/(fgkVZEROCz-values[kVtxZ]));
       else theta = TMath::Pi()-TMath::ATan(fgkVZEROChannelRadii[ich]/(fgkVZEROAz-values[kVtxZ]));
       values[kVZEROChannelEta+ich] = -1.0*TMath::Log(TMath::Tan(theta/2.0));
     }
   }
   
-  fgUsedVars[kNTracksTPCoutFromPileup] = kTRUE;
+  ctx->fUsedVars[kNTracksTPCoutFromPileup] = kTRUE;
   if(values[kVZEROTotalMult]>0.0)
      values[kNTracksTPCoutFromPileup] = values[kNTracksPerTrackingStatus+kTPCout] - (-2.55+TMath::Sqrt(2.55*2.55+4.0e-5*values[kVZEROTotalMult])) / 2.0e-5;
-  else fgUsedVars[kNTracksTPCoutFromPileup] = kFALSE;
+  else ctx->fUsedVars[kNTracksTPCoutFromPileup] = kFALSE;
   
-  if(!eventF && (fgUsedVars[kVZEROQvecX+0*6+1] || fgUsedVars[kVZEROQvecY+0*6+1] || fgUsedVars[kVZERORP+0*6+1])) {
+  if(!eventF && (ctx->fUsedVars[kVZEROQvecX+0*6+1] || ctx->fUsedVars[kVZEROQvecY+0*6+1] || ctx->fUsedVars[kVZERORP+0*6+1])) {
     Double_t qvecVZEROA[EVENTPLANE::fgkNMaxHarmonics][2] = {{0.0}};
     Double_t qvecVZEROC[EVENTPLANE::fgkNMaxHarmonics][2] = {{0.0}};
-    if(fgOptionCalibrateVZEROqVec && fgAvgVZEROChannelMult[0]) {
+    if(ctx->fOptionCalibrateVZEROqVec && ctx->fAvgVZEROChannelMult[0]) {
       Float_t calibVZEROMult[64] = {0.};
       for(Int_t iCh=0; iCh<64; ++iCh) {
          if(event->MultChannelVZERO(iCh)>=fgkVZEROminMult) {
-            Float_t avMult = fgAvgVZEROChannelMult[iCh]->GetBinContent(fgAvgVZEROChannelMult[iCh]->FindBin(event->Vertex(2), event->CentralitySPD()));
+            Float_t avMult = ctx->fAvgVZEROChannelMult[iCh]->GetBinContent(ctx->fAvgVZEROChannelMult[iCh]->FindBin(event->Vertex(2), event->CentralitySPD()));
             calibVZEROMult[iCh] = event->MultChannelVZERO(iCh) / (avMult>1.0e-6 ? avMult : 1.0);
          }
       }
@@ -713,14 +829,14 @@ void AliReducedVarManager::FillEventInfo(BASEEVENT* baseEvent, Float_t* values,
       event->GetVZEROQvector(qvecVZEROA, EVENTPLANE::kVZEROA);
       event->GetVZEROQvector(qvecVZEROC, EVENTPLANE::kVZEROC);
     }
-    if(fgOptionRecenterVZEROqVec && fgVZEROqVecRecentering[0]) {
-       Float_t recenterOffset = fgVZEROqVecRecentering[0]->GetBinContent(fgVZEROqVecRecentering[0]->FindBin(event->CentralitySPD(), event->Vertex(2)));
+    if(ctx->fOptionRecenterVZEROqVec && ctx->fVZEROqVecRecentering[0]) {
+       Float_t recenterOffset = ctx->fVZEROqVecRecentering[0]->GetBinContent(ctx->fVZEROqVecRecentering[0]->FindBin(event->CentralitySPD(), event->Vertex(2)));
        qvecVZEROA[1][0] -= recenterOffset;
-       recenterOffset = fgVZEROqVecRecentering[1]->GetBinContent(fgVZEROqVecRecentering[1]->FindBin(event->CentralitySPD(), event->Vertex(2)));
+       recenterOffset = ctx->fVZEROqVecRecentering[1]->GetBinContent(ctx->fVZEROqVecRecentering[1]->FindBin(event->CentralitySPD(), event->Vertex(2)));
        qvecVZEROA[1][1] -= recenterOffset;
-       recenterOffset = fgVZEROqVecRecentering[2]->GetBinContent(fgVZEROqVecRecentering[2]->FindBin(event->CentralitySPD(), event->Vertex(2)));
+       recenterOffset = ctx->fVZEROqVecRecentering[2]->GetBinContent(ctx->fVZEROqVecRecentering[2]->FindBin(event->CentralitySPD(), event->Vertex(2)));
        qvecVZEROC[1][0] -= recenterOffset;
-       recenterOffset = fgVZEROqVecRecentering[3]->GetBinContent(fgVZEROqVecRecentering[3]->FindBin(event->CentralitySPD(), event->Vertex(2)));
+       recenterOffset = ctx->fVZEROqVecRecentering[3]->GetBinContent(ctx->fVZEROqVecRecentering[3]->FindBin(event->CentralitySPD(), event->Vertex(2)));
        qvecVZEROC[1][1] -= recenterOffset;
     }
     for(Int_t ih=1; ih<2; ++ih) {
@@ -735,7 +851,7 @@ void AliReducedVarManager::FillEventInfo(BASEEVENT* baseEvent, Float_t* values,
        values[kVZEROQvecY+2*6+ih] = qvecVZEROA[ih][1] + qvecVZEROC[ih][1];
        values[kVZERORP   +2*6+ih] = TMath::ATan2(values[kVZEROQvecY+2*6+ih], values[kVZEROQvecX+2*6+ih])/Double_t(ih+1);
      
-       if(fgUsedVars[kVZEROQaQcSP+ih]) {
+       if(ctx->fUsedVars[kVZEROQaQcSP+ih]) {
           values[kVZEROQaQcSP+ih] = TMath::Cos((ih+1)*(values[kVZERORP+0*6+ih]-values[kVZERORP+1*6+ih]));
           values[kVZEROQaQcSP+ih] *= TMath::Sqrt(values[kVZEROQvecX+0*6+ih]*values[kVZEROQvecX+0*6+ih]+
           values[kVZEROQvecY+0*6+ih]*values[kVZEROQvecY+0*6+ih]);
@@ -749,25 +865,25 @@ void AliReducedVarManager::FillEventInfo(BASEEVENT* baseEvent, Float_t* values,
        values[kVZEROQvecY+1*6+ih]*values[kVZEROQvecY+1*6+ih]);
        values[kVZERORP   +2*6+ih] = TMath::ATan2(values[kVZEROQvecY+2*6+ih],values[kVZEROQvecX+2*6+ih])/Double_t(ih+1);
        // cos (n*(psi_A-psi_C))
-       if(fgUsedVars[kVZERORPres + ih]) {
+       if(ctx->fUsedVars[kVZERORPres + ih]) {
           values[kVZERORPres + ih] = DeltaPhi(values[kVZERORP+0*6+ih], values[kVZERORP+1*6+ih]);
           values[kVZERORPres + ih] = TMath::Cos(values[kVZERORPres + ih]*(ih+1));
        }
        // Qx,Qy correlations for VZERO
-       if(fgUsedVars[kVZEROXaXc+ih]) 
+       if(ctx->fUsedVars[kVZEROXaXc+ih]) 
           values[kVZEROXaXc+ih] = qvecVZEROA[ih][0]*qvecVZEROC[ih][0];
-       if(fgUsedVars[kVZEROXaYa+ih]) 
+       if(ctx->fUsedVars[kVZEROXaYa+ih]) 
           values[kVZEROXaYa+ih] = qvecVZEROA[ih][0]*qvecVZEROA[ih][1];
-       if(fgUsedVars[kVZEROXaYc+ih]) 
+       if(ctx->fUsedVars[kVZEROXaYc+ih]) 
           values[kVZEROXaYc+ih] = qvecVZEROA[ih][0]*qvecVZEROC[ih][1];
-       if(fgUsedVars[kVZEROYaXc+ih]) 
+       if(ctx->fUsedVars[kVZEROYaXc+ih]) 
           values[kVZEROYaXc+ih] = qvecVZEROA[ih][1]*qvecVZEROC[ih][0];
-       if(fgUsedVars[kVZEROYaYc+ih]) 
+       if(ctx->fUsedVars[kVZEROYaYc+ih]) 
           values[kVZEROYaYc+ih] = qvecVZEROA[ih][1]*qvecVZEROC[ih][1];
-       if(fgUsedVars[kVZEROXcYc+ih]) 
+       if(ctx->fUsedVars[kVZEROXcYc+ih]) 
           values[kVZEROXcYc+ih] = qvecVZEROC[ih][0]*qvecVZEROC[ih][1];
        // Psi_A - Psi_C
-       if(fgUsedVars[kVZEROdeltaRPac+ih])
+       if(ctx->fUsedVars[kVZEROdeltaRPac+ih])
           values[kVZEROdeltaRPac+ih] = DeltaPhi(values[kVZERORP+0*6+ih], values[kVZERORP+1*6+ih]);
     }    // end loop over harmonics
   }
@@ -781,20 +897,20 @@ void AliReducedVarManager::FillEventInfo(BASEEVENT* baseEvent, Float_t* values,
       for(Int_t iVZEROside=0; iVZEROside<2; ++iVZEROside) {
         values[kVZEROQvecX+iVZEROside*6+ih] = eventF->Qx(EVENTPLANE::kVZEROA+iVZEROside, ih+1);
         values[kVZEROQvecY+iVZEROside*6+ih] = eventF->Qy(EVENTPLANE::kVZEROA+iVZEROside, ih+1);
-        if(fgUsedVars[kVZERORP+iVZEROside*6+ih]) 
+        if(ctx->fUsedVars[kVZERORP+iVZEROside*6+ih]) 
 	  values[kVZERORP+iVZEROside*6+ih] = eventF->EventPlane(EVENTPLANE::kVZEROA+iVZEROside, ih+1);
-	if(fgUsedVars[kVZEROQvecX+2*6+ih])
+	if(ctx->fUsedVars[kVZEROQvecX+2*6+ih])
 	  values[kVZEROQvecX+2*6+ih] += values[kVZEROQvecX+iVZEROside*6+ih];
-	if(fgUsedVars[kVZEROQvecY+2*6+ih])
+	if(ctx->fUsedVars[kVZEROQvecY+2*6+ih])
 	  values[kVZEROQvecY+2*6+ih] += values[kVZEROQvecY+iVZEROside*6+ih];
 	// cos(n(EPtpc-EPvzero A/C))	
-        if(fgUsedVars[kTPCRPres+iVZEROside*6+ih]) {
+        if(ctx->fUsedVars[kTPCRPres+iVZEROside*6+ih]) {
 	  values[kTPCRPres+iVZEROside*6+ih] = DeltaPhi(eventF->EventPlane(EVENTPLANE::kTPC, ih+1), eventF->EventPlane(EVENTPLANE::kVZEROA+iVZEROside, ih+1));
           values[kTPCRPres+iVZEROside*6+ih] = TMath::Cos(values[kTPCRPres+iVZEROside*6+ih]*(ih+1));
 	}
       }
       
-      if(fgUsedVars[kVZEROQaQcSP+ih]) {
+      if(ctx->fUsedVars[kVZEROQaQcSP+ih]) {
         values[kVZEROQaQcSP+ih] = TMath::Cos((ih+1)*(values[kVZERORP+0*6+ih]-values[kVZERORP+1*6+ih]));
         values[kVZEROQaQcSP+ih] *= TMath::Sqrt(values[kVZEROQvecX+0*6+ih]*values[kVZEROQvecX+0*6+ih]+
                                                values[kVZEROQvecY+0*6+ih]*values[kVZEROQvecY+0*6+ih]);
@@ -808,66 +924,66 @@ void AliReducedVarManager::FillEventInfo(BASEEVENT* baseEvent, Float_t* values,
                                              values[kVZEROQvecY+1*6+ih]*values[kVZEROQvecY+1*6+ih]);
       values[kVZERORP   +2*6+ih] = TMath::ATan2(values[kVZEROQvecY+2*6+ih],values[kVZEROQvecX+2*6+ih])/Double_t(ih+1);
       // cos (n*(psi_A-psi_C))
-      if(fgUsedVars[kVZERORPres + ih]) {
+      if(ctx->fUsedVars[kVZERORPres + ih]) {
 	values[kVZERORPres + ih] = DeltaPhi(eventF->EventPlane(EVENTPLANE::kVZEROA, ih+1), 
 					    eventF->EventPlane(EVENTPLANE::kVZEROC, ih+1));
         values[kVZERORPres + ih] = TMath::Cos(values[kVZERORPres + ih]*(ih+1));
       }
       // Qx,Qy correlations for VZERO
-      if(fgUsedVars[kVZEROXaXc+ih]) 
+      if(ctx->fUsedVars[kVZEROXaXc+ih]) 
 	values[kVZEROXaXc+ih] = eventF->Qx(EVENTPLANE::kVZEROA, ih+1)*eventF->Qx(EVENTPLANE::kVZEROC, ih+1);
-      if(fgUsedVars[kVZEROXaYa+ih]) 
+      if(ctx->fUsedVars[kVZEROXaYa+ih]) 
 	values[kVZEROXaYa+ih] = eventF->Qx(EVENTPLANE::kVZEROA, ih+1)*eventF->Qy(EVENTPLANE::kVZEROA, ih+1);
-      if(fgUsedVars[kVZEROXaYc+ih]) 
+      if(ctx->fUsedVars[kVZEROXaYc+ih]) 
 	values[kVZEROXaYc+ih] = eventF->Qx(EVENTPLANE::kVZEROA, ih+1)*eventF->Qy(EVENTPLANE::kVZEROC, ih+1);
-      if(fgUsedVars[kVZEROYaXc+ih]) 
+      if(ctx->fUsedVars[kVZEROYaXc+ih]) 
 	values[kVZEROYaXc+ih] = eventF->Qy(EVENTPLANE::kVZEROA, ih+1)*eventF->Qx(EVENTPLANE::kVZEROC, ih+1);
-      if(fgUsedVars[kVZEROYaYc+ih]) 
+      if(ctx->fUsedVars[kVZEROYaYc+ih]) 
 	values[kVZEROYaYc+ih] = eventF->Qy(EVENTPLANE::kVZEROA, ih+1)*eventF->Qy(EVENTPLANE::kVZEROC, ih+1);
-      if(fgUsedVars[kVZEROXcYc+ih]) 
+      if(ctx->fUsedVars[kVZEROXcYc+ih]) 
 	values[kVZEROXcYc+ih] = eventF->Qx(EVENTPLANE::kVZEROC, ih+1)*eventF->Qy(EVENTPLANE::kVZEROC, ih+1);
       // Psi_A - Psi_C
-      if(fgUsedVars[kVZEROdeltaRPac+ih])
+      if(ctx->fUsedVars[kVZEROdeltaRPac+ih])
         values[kVZEROdeltaRPac+ih] = DeltaPhi(eventF->EventPlane(EVENTPLANE::kVZEROA, ih+1), 
 	  				      eventF->EventPlane(EVENTPLANE::kVZEROC, ih+1));
       
       // TPC event plane
       values[kTPCQvecX+ih] = eventF->Qx(EVENTPLANE::kTPC, ih+1);
       values[kTPCQvecY+ih] = eventF->Qy(EVENTPLANE::kTPC, ih+1);
-      if(fgUsedVars[kTPCRP+ih]) 
+      if(ctx->fUsedVars[kTPCRP+ih]) 
 	values[kTPCRP+ih] = eventF->EventPlane(EVENTPLANE::kTPC, ih+1);
       // TPC VZERO Q-vector correlations
-      if(fgUsedVars[kRPXtpcXvzeroa+ih]) 
+      if(ctx->fUsedVars[kRPXtpcXvzeroa+ih]) 
 	values[kRPXtpcXvzeroa+ih] = values[kTPCQvecX+ih]*values[kVZEROQvecX+ih];
-      if(fgUsedVars[kRPXtpcXvzeroc+ih]) 
+      if(ctx->fUsedVars[kRPXtpcXvzeroc+ih]) 
 	values[kRPXtpcXvzeroc+ih] = values[kTPCQvecX+ih]*values[kVZEROQvecX+6+ih];
-      if(fgUsedVars[kRPYtpcYvzeroa+ih]) 
+      if(ctx->fUsedVars[kRPYtpcYvzeroa+ih]) 
 	values[kRPYtpcYvzeroa+ih] = values[kTPCQvecY+ih]*values[kVZEROQvecY+ih];
-      if(fgUsedVars[kRPYtpcYvzeroc+ih]) 
+      if(ctx->fUsedVars[kRPYtpcYvzeroc+ih]) 
 	values[kRPYtpcYvzeroc+ih] = values[kTPCQvecY+ih]*values[kVZEROQvecY+6+ih];
-      if(fgUsedVars[kRPXtpcYvzeroa+ih]) 
+      if(ctx->fUsedVars[kRPXtpcYvzeroa+ih]) 
 	values[kRPXtpcYvzeroa+ih] = values[kTPCQvecX+ih]*values[kVZEROQvecY+ih];
-      if(fgUsedVars[kRPXtpcYvzeroc+ih]) 
+      if(ctx->fUsedVars[kRPXtpcYvzeroc+ih]) 
 	values[kRPXtpcYvzeroc+ih] = values[kTPCQvecX+ih]*values[kVZEROQvecY+6+ih];
-      if(fgUsedVars[kRPYtpcXvzeroa+ih]) 
+      if(ctx->fUsedVars[kRPYtpcXvzeroa+ih]) 
 	values[kRPYtpcXvzeroa+ih] = values[kTPCQvecY+ih]*values[kVZEROQvecX+ih];
-      if(fgUsedVars[kRPYtpcXvzeroc+ih]) 
+      if(ctx->fUsedVars[kRPYtpcXvzeroc+ih]) 
 	values[kRPYtpcXvzeroc+ih] = values[kTPCQvecY+ih]*values[kVZEROQvecX+6+ih];
       // Psi_TPC - Psi_VZERO A/C      
-      if(fgUsedVars[kRPdeltaVZEROAtpc+ih]) 
+      if(ctx->fUsedVars[kRPdeltaVZEROAtpc+ih]) 
 	values[kRPdeltaVZEROAtpc+ih] = DeltaPhi(values[kVZERORP+0*6+ih], values[kTPCRP+ih]);
-      if(fgUsedVars[kRPdeltaVZEROCtpc+ih])
+      if(ctx->fUsedVars[kRPdeltaVZEROCtpc+ih])
         values[kRPdeltaVZEROCtpc+ih] = DeltaPhi(values[kVZERORP+1*6+ih], values[kTPCRP+ih]);
       // TPC event planes with sub-event method
       values[kTPCQvecXleft+ih] = eventF->Qx(EVENTPLANE::kTPCneg, ih+1);
       values[kTPCQvecYleft+ih] = eventF->Qy(EVENTPLANE::kTPCneg, ih+1);
-      if(fgUsedVars[kTPCRPleft+ih])
+      if(ctx->fUsedVars[kTPCRPleft+ih])
 	values[kTPCRPleft+ih] = eventF->EventPlane(EVENTPLANE::kTPCneg, ih+1);
       values[kTPCQvecXright+ih] = eventF->Qx(EVENTPLANE::kTPCpos, ih+1);
       values[kTPCQvecYright+ih] = eventF->Qy(EVENTPLANE::kTPCpos, ih+1);
-      if(fgUsedVars[kTPCRPright+ih])
+      if(ctx->fUsedVars[kTPCRPright+ih])
         values[kTPCRPright+ih] = eventF->EventPlane(EVENTPLANE::kTPCpos, ih+1); 
-      if(fgUsedVars[kTPCsubResCos+ih]) 
+      if(ctx->fUsedVars[kTPCsubResCos+ih]) 
 	values[kTPCsubResCos+ih] = TMath::Cos(Double_t(ih+1)*(values[kTPCRPleft+ih]-values[kTPCRPright+ih]));
     }  // end loop over harmonics
     
@@ -875,7 +991,7 @@ void AliReducedVarManager::FillEventInfo(BASEEVENT* baseEvent, Float_t* values,
     Double_t vzeroChannelPhi[8] = {0.3927, 1.1781, 1.9635, 2.7489, -2.7489, -1.9635, -1.1781, -0.3927};
     
     for(Int_t ich=0; ich<64; ++ich) {
-      if(fgUsedVars[kVZEROflowV2TPC+ich])
+      if(ctx->fUsedVars[kVZEROflowV2TPC+ich])
 	values[kVZEROflowV2TPC+ich] = values[kVZEROChannelMult+ich]*
                                       TMath::Cos(2.0*DeltaPhi(vzeroChannelPhi[ich%8],values[kTPCRP+1]));
     } 
@@ -920,8 +1036,9 @@ void AliReducedVarManager::FillITSlayerFlag(TRACK* track, Int_t layer, Float_t*
   //
   // fill the ITS layer hit
   //
+  Context* ctx = GetContext();
   values[kITSlayerHit] = -1.0*(layer+1);
-  if(fgUsedVars[kITSlayerHit] && track->ITSLayerHit(layer)) values[kITSlayerHit] = layer+1;
+  if(ctx->fUsedVars[kITSlayerHit] && track->ITSLayerHit(layer)) values[kITSlayerHit] = layer+1;
 }
 
 //_________________________________________________________________
@@ -929,8 +1046,9 @@ void AliReducedVarManager::FillL0TriggerInputs(EVENT* event, Int_t input, Float_
   //
   // fill the L0 trigger inputs
   //
+  Context* ctx = GetContext();
   values[kL0TriggerInput] = -1.0;
-  if(fgUsedVars[kL0TriggerInput] && event->L0TriggerInput(input)) values[kL0TriggerInput] = input;
+  if(ctx->fUsedVars[kL0TriggerInput] && event->L0TriggerInput(input)) values[kL0TriggerInput] = input;
 }
 
 
@@ -939,8 +1057,9 @@ void AliReducedVarManager::FillL1TriggerInputs(EVENT* event, Int_t input, Float_
   //
   // fill the L1 trigger inputs
   //
+  Context* ctx = GetContext();
   values[kL1TriggerInput] = -1.0;
-  if(fgUsedVars[kL1TriggerInput] && event->L1TriggerInput(input)) values[kL1TriggerInput] = input;
+  if(ctx->fUsedVars[kL1TriggerInput] && event->L1TriggerInput(input)) values[kL1TriggerInput] = input;
 }
 
 //_________________________________________________________________
@@ -948,8 +1067,9 @@ void AliReducedVarManager::FillL2TriggerInputs(EVENT* event, Int_t input, Float_
   //
   // fill the L2 trigger inputs
   //
+  Context* ctx = GetContext();
   values[kL2TriggerInput] = -1.0;
-  if(fgUsedVars[kL2TriggerInput] && event->L2TriggerInput(input)) values[kL2TriggerInput] = input;
+  if(ctx->fUsedVars[kL2TriggerInput] && event->L2TriggerInput(input)) values[kL2TriggerInput] = input;
 }
 
 //_________________________________________________________________
@@ -957,8 +1077,9 @@ void AliReducedVarManager::FillEventTagInput(BASEEVENT* event, Int_t input, Floa
   //
   // fill the event tag inputs
   //
+  Context* ctx = GetContext();
   values[kEventTag] = -1.0;
-  if(fgUsedVars[kEventTag] && event->EventTag(input)) values[kEventTag] = input;
+  if(ctx->fUsedVars[kEventTag] && event->EventTag(input)) values[kEventTag] = input;
 }
 
 //_________________________________________________________________
@@ -966,8 +1087,9 @@ void AliReducedVarManager::FillTPCclusterBitFlag(TRACK* track, Int_t bit, Float_
   //
   // fill the TPC cluster map
   //
+  Context* ctx = GetContext();
   values[kTPCclusBitFired] = -1;
-  if(fgUsedVars[kTPCclusBitFired] && track->TPCClusterMapBitFired(bit)) values[kTPCclusBitFired] = bit;
+  if(ctx->fUsedVars[kTPCclusBitFired] && track->TPCClusterMapBitFired(bit)) values[kTPCclusBitFired] = bit;
 }
 
 
@@ -1036,11 +1158,12 @@ void AliReducedVarManager::FillEventOnlineTrigger(UShort_t triggerBit, Float_t*
   //
   // fill the trigger bit input
   //
+  Context* ctx = GetContext();
   if(triggerBit>=64) return;
-  if(!fgEvent) return;
+  if(!ctx->fEvent) return;
   ULong64_t trigger = 1;
   values[kOnlineTrigger] = triggerBit;
-  values[kOnlineTriggerFired] = (((AliReducedEventInfo*)fgEvent)->TriggerMask()&(trigger<<triggerBit) ? 1.0 : 0.0);
+  values[kOnlineTriggerFired] = (((AliReducedEventInfo*)ctx->fEvent)->TriggerMask()&(trigger<<triggerBit) ? 1.0 : 0.0);
   values[kOnlineTriggerFired2] = (values[kOnlineTriggerFired]>0.01 ? triggerBit : -1.0); 
 }
 
@@ -1049,19 +1172,20 @@ void AliReducedVarManager::FillMCTruthInfo(TRACK* p, Float_t* values, TRACK* leg
    //
    //  Fill pure MC truth information
    //
-   if(fgUsedVars[kPtMC]) values[kPtMC] = p->PtMC();
-   if(fgUsedVars[kPMC]) values[kPMC] = p->PMC();
+   Context* ctx = GetContext();
+   if(ctx->fUsedVars[kPtMC]) values[kPtMC] = p->PtMC();
+   if(ctx->fUsedVars[kPMC]) values[kPMC] = p->PMC();
    values[kPxMC] = p->MCmom(0);
    values[kPyMC] = p->MCmom(1);
    values[kPzMC] = p->MCmom(2);
-   if(fgUsedVars[kThetaMC]) values[kThetaMC] = p->ThetaMC();
-   if(fgUsedVars[kEtaMC]) values[kEtaMC] = p->EtaMC();
-   if(fgUsedVars[kPhiMC]) values[kPhiMC] = p->PhiMC();
-   if(fgUsedVars[kMassMC]) {
+   if(ctx->fUsedVars[kThetaMC]) values[kThetaMC] = p->ThetaMC();
+   if(ctx->fUsedVars[kEtaMC]) values[kEtaMC] = p->EtaMC();
+   if(ctx->fUsedVars[kPhiMC]) values[kPhiMC] = p->PhiMC();
+   if(ctx->fUsedVars[kMassMC]) {
       if(TMath::Abs(p->MCPdg(0))==443)
       values[kMassMC] = 3.1;   // TODO: use correct PDG mass
    }
-   if(fgUsedVars[kRapMC]) {
+   if(ctx->fUsedVars[kRapMC]) {
       if(TMath::Abs(p->MCPdg(0))==443)
          values[kRapMC] = p->RapidityMC(3.1);   // TODO: use correct PDG mass
    }
@@ -1069,10 +1193,10 @@ void AliReducedVarManager::FillMCTruthInfo(TRACK* p, Float_t* values, TRACK* leg
    // compute MC truth variables from decay legs, e.g. from the 2 electrons of a J/psi decay
    // NOTE: this may be different from the kinematics of the mother, if not all decay legs are considered / tracked
    Bool_t requestMCfromLegs = kFALSE;
-   if(fgUsedVars[kPtMCfromLegs] || fgUsedVars[kPMCfromLegs] || 
-      fgUsedVars[kPxMCfromLegs] || fgUsedVars[kPyMCfromLegs] || fgUsedVars[kPzMCfromLegs] ||
-      fgUsedVars[kThetaMCfromLegs] || fgUsedVars[kEtaMCfromLegs] || fgUsedVars[kPhiMCfromLegs] ||
-      fgUsedVars[kMassMCfromLegs] || fgUsedVars[kRapMCfromLegs]) 
+   if(ctx->fUsedVars[kPtMCfromLegs] || ctx->fUsedVars[kPMCfromLegs] || 
+      ctx->fUsedVars[kPxMCfromLegs] || ctx->fUsedVars[kPyMCfromLegs] || ctx->fUsedVars[kPzMCfromLegs] ||
+      ctx->fUsedVars[kThetaMCfromLegs] || ctx->fUsedVars[kEtaMCfromLegs] || ctx->fUsedVars[kPhiMCfromLegs] ||
+      ctx->fUsedVars[kMassMCfromLegs] || ctx->fUsedVars[kRapMCfromLegs]) 
       requestMCfromLegs = kTRUE;
    if(leg1 && leg2 && requestMCfromLegs) {
       values[kPxMCfromLegs] = leg1->MCmom(0) + leg2->MCmom(0);
@@ -1116,7 +1240,7 @@ void AliReducedVarManager::FillMCTruthInfo(TRACK* p, Float_t* values, TRACK* leg
    
    // polarization variables
    Bool_t usePolarization=kFALSE;
-   if(leg1 && leg2 && (fgUsedVars[kPairThetaCS] || fgUsedVars[kPairThetaHE] || fgUsedVars[kPairPhiCS] || fgUsedVars[kPairPhiHE]))
+   if(leg1 && leg2 && (ctx->fUsedVars[kPairThetaCS] || ctx->fUsedVars[kPairThetaHE] || ctx->fUsedVars[kPairPhiCS] || ctx->fUsedVars[kPairPhiHE]))
       usePolarization = kTRUE;
    if(usePolarization)
       GetThetaPhiCM(leg1, leg2, values[kPairThetaHE], values[kPairPhiHE], values[kPairThetaCS], values[kPairPhiCS]);
@@ -1127,34 +1251,35 @@ void AliReducedVarManager::FillTrackInfo(BASETRACK* p, Float_t* values) {
   //
   // fill track information
   //
+  Context* ctx = GetContext();
   
   // Fill base track information
-  if(fgUsedVars[kPt])        values[kPt]        = p->Pt();
-  if(fgUsedVars[kPtSquared]) values[kPtSquared] = values[kPt]*values[kPt];
-  if(fgUsedVars[kOneOverSqrtPt]) {
+  if(ctx->fUsedVars[kPt])        values[kPt]        = p->Pt();
+  if(ctx->fUsedVars[kPtSquared]) values[kPtSquared] = values[kPt]*values[kPt];
+  if(ctx->fUsedVars[kOneOverSqrtPt]) {
     values[kOneOverSqrtPt] = values[kPt] > 0. ? 1./TMath::Sqrt(values[kPt]) : 999.;
   }
-  if(fgUsedVars[kP])         values[kP]         = p->P();
-  if(fgUsedVars[kPx])        values[kPx]        = p->Px();
-  if(fgUsedVars[kPy])        values[kPy]        = p->Py();
-  if(fgUsedVars[kPz])        values[kPz]        = p->Pz();
-  if(fgUsedVars[kTheta])     values[kTheta]     = p->Theta();
-  if(fgUsedVars[kPhi])       values[kPhi]       = p->Phi();
-  if(fgUsedVars[kEta])       values[kEta]       = p->Eta();
+  if(ctx->fUsedVars[kP])         values[kP]         = p->P();
+  if(ctx->fUsedVars[kPx])        values[kPx]        = p->Px();
+  if(ctx->fUsedVars[kPy])        values[kPy]        = p->Py();
+  if(ctx->fUsedVars[kPz])        values[kPz]        = p->Pz();
+  if(ctx->fUsedVars[kTheta])     values[kTheta]     = p->Theta();
+  if(ctx->fUsedVars[kPhi])       values[kPhi]       = p->Phi();
+  if(ctx->fUsedVars[kEta])       values[kEta]       = p->Eta();
   for(Int_t ih=1; ih<=6; ++ih) {
-     if(fgUsedVars[kCosNPhi+ih-1]) values[kCosNPhi+ih-1] = TMath::Cos(p->Phi()*ih);
-     if(fgUsedVars[kSinNPhi+ih-1]) values[kSinNPhi+ih-1] = TMath::Sin(p->Phi()*ih);
+     if(ctx->fUsedVars[kCosNPhi+ih-1]) values[kCosNPhi+ih-1] = TMath::Cos(p->Phi()*ih);
+     if(ctx->fUsedVars[kSinNPhi+ih-1]) values[kSinNPhi+ih-1] = TMath::Sin(p->Phi()*ih);
   }
 
   //pair efficiency variables
-  if((fgUsedVars[kPairEff] || fgUsedVars[kOneOverPairEff]) && fgPairEffMap) {
-    Int_t binX = fgPairEffMap->GetXaxis()->FindBin(values[fgEffMapVarDependencyX]);
+  if((ctx->fUsedVars[kPairEff] || ctx->fUsedVars[kOneOverPairEff]) && ctx->fPairEffMap) {
+    Int_t binX = ctx->fPairEffMap->GetXaxis()->FindBin(values[ctx->fEffMapVarDependencyX]);
     if(binX==0) binX = 1;
-    if(binX==fgPairEffMap->GetXaxis()->GetNbins()+1) binX -= 1;
-    Int_t binY = fgPairEffMap->GetYaxis()->FindBin(values[fgEffMapVarDependencyY]);
+    if(binX==ctx->fPairEffMap->GetXaxis()->GetNbins()+1) binX -= 1;
+    Int_t binY = ctx->fPairEffMap->GetYaxis()->FindBin(values[ctx->fEffMapVarDependencyY]);
     if(binY==0) binY=1;
-    if(binY==fgPairEffMap->GetYaxis()->GetNbins()+1) binY -= 1;
-    Float_t pairEff = fgPairEffMap->GetBinContent(binX, binY);
+    if(binY==ctx->fPairEffMap->GetYaxis()->GetNbins()+1) binY -= 1;
+    Float_t pairEff = ctx->fPairEffMap->GetBinContent(binX, binY);
     Float_t oneOverPairEff = 1;
     if (pairEff > 1.0e-6) oneOverPairEff = 1/pairEff;
     values[kPairEff] = pairEff;
@@ -1164,17 +1289,17 @@ void AliReducedVarManager::FillTrackInfo(BASETRACK* p, Float_t* values) {
   // Fill VZERO flow variables
   for(Int_t iVZEROside=0; iVZEROside<3; ++iVZEROside) {
      for(Int_t ih=0; ih<6; ++ih) {
-        if(fgUsedVars[kVZEROFlowVn+iVZEROside*6+ih])
+        if(ctx->fUsedVars[kVZEROFlowVn+iVZEROside*6+ih])
            values[kVZEROFlowVn+iVZEROside*6+ih] = TMath::Cos((values[kPhi]-values[kVZERORP+iVZEROside*6+ih])*(ih+1));
-        if(fgUsedVars[kVZEROFlowSine+iVZEROside*6+ih])
+        if(ctx->fUsedVars[kVZEROFlowSine+iVZEROside*6+ih])
            values[kVZEROFlowSine+iVZEROside*6+ih] = TMath::Sin((values[kPhi]-values[kVZERORP+iVZEROside*6+ih])*(ih+1));
         if(iVZEROside<2) {
-           if(fgUsedVars[kVZEROuQ+iVZEROside*6+ih]) {
+           if(ctx->fUsedVars[kVZEROuQ+iVZEROside*6+ih]) {
               values[kVZEROuQ+iVZEROside*6+ih] = TMath::Cos((values[kPhi]-values[kVZERORP+iVZEROside*6+ih])*(ih+1));
               values[kVZEROuQ+iVZEROside*6+ih] *= TMath::Sqrt(values[kVZEROQvecX+iVZEROside*6+ih]*values[kVZEROQvecX+iVZEROside*6+ih] +
               values[kVZEROQvecY+iVZEROside*6+ih]*values[kVZEROQvecY+iVZEROside*6+ih]); 
            }
-           if(fgUsedVars[kVZEROuQsine+iVZEROside*6+ih]) {
+           if(ctx->fUsedVars[kVZEROuQsine+iVZEROside*6+ih]) {
               values[kVZEROuQsine+iVZEROside*6+ih] = TMath::Sin((values[kPhi]-values[kVZERORP+iVZEROside*6+ih])*(ih+1));
               values[kVZEROuQsine+iVZEROside*6+ih] *= TMath::Sqrt(values[kVZEROQvecX+iVZEROside*6+ih]*values[kVZEROQvecX+iVZEROside*6+ih] +
               values[kVZEROQvecY+iVZEROside*6+ih]*values[kVZEROQvecY+iVZEROside*6+ih]); 
@@ -1187,17 +1312,17 @@ void AliReducedVarManager::FillTrackInfo(BASETRACK* p, Float_t* values) {
   // Subtract the q vector of the track or of the pair legs from the event q-vector 
   Bool_t tpcEPUsed = kFALSE;
   for(Int_t ih=0; ih<6; ++ih) {
-     if(fgUsedVars[kTPCFlowVn+ih]) {tpcEPUsed = kTRUE; break;}
-     if(fgUsedVars[kTPCFlowSine+ih]) {tpcEPUsed = kTRUE; break;}
-     if(fgUsedVars[kTPCuQ+ih]) {tpcEPUsed = kTRUE; break;}
-     if(fgUsedVars[kTPCuQsine+ih]) {tpcEPUsed = kTRUE; break;}
+     if(ctx->fUsedVars[kTPCFlowVn+ih]) {tpcEPUsed = kTRUE; break;}
+     if(ctx->fUsedVars[kTPCFlowSine+ih]) {tpcEPUsed = kTRUE; break;}
+     if(ctx->fUsedVars[kTPCuQ+ih]) {tpcEPUsed = kTRUE; break;}
+     if(ctx->fUsedVars[kTPCuQsine+ih]) {tpcEPUsed = kTRUE; break;}
   }
   if(tpcEPUsed) {
      Float_t tpcEPsubtracted[6] = {0.0};
      Double_t qVec[6][2] = {{0.0}};
      for(Int_t ih=0; ih<6; ++ih) {qVec[ih][0]=values[kTPCQvecXtotal+ih]; qVec[ih][1]=values[kTPCQvecYtotal+ih];}
      EVENT* eventInfo = NULL;
-     if(fgEvent->IsA()==EVENT::Class()) eventInfo = (EVENT*)fgEvent;
+     if(ctx->fEvent->IsA()==EVENT::Class()) eventInfo = (EVENT*)ctx->fEvent;
      if((p->IsA() == AliReducedTrackInfo::Class()) && eventInfo) {
         eventInfo->SubtractParticleFromQvector((AliReducedTrackInfo*)p,qVec,EVENTPLANE::kTPC,-0.8,-0.5*fgkTPCQvecRapGap);
         eventInfo->SubtractParticleFromQvector((AliReducedTrackInfo*)p,qVec,EVENTPLANE::kTPC,0.5*fgkTPCQvecRapGap,0.8);
@@ -1217,15 +1342,15 @@ void AliReducedVarManager::FillTrackInfo(BASETRACK* p, Float_t* values) {
      
      for(Int_t ih=0; ih<6; ++ih) {
         // vn using Psi_n
-        if(fgUsedVars[kTPCFlowVn+ih])
+        if(ctx->fUsedVars[kTPCFlowVn+ih])
            values[kTPCFlowVn+ih] = TMath::Cos(DeltaPhi(values[kPhi],tpcEPsubtracted[ih])*(ih+1));
-        if(fgUsedVars[kTPCFlowSine+ih]) 
+        if(ctx->fUsedVars[kTPCFlowSine+ih]) 
            values[kTPCFlowSine+ih] = TMath::Sin(DeltaPhi(values[kPhi],tpcEPsubtracted[ih])*(ih+1));
-        if(fgUsedVars[kTPCuQ+ih]) {
+        if(ctx->fUsedVars[kTPCuQ+ih]) {
            values[kTPCuQ+ih] = TMath::Cos((values[kPhi]-tpcEPsubtracted[ih])*(ih+1));
            values[kTPCuQ+ih] *= TMath::Sqrt(qVec[ih][0]*qVec[ih][0] + qVec[ih][1]*qVec[ih][1]);
         }
-        if(fgUsedVars[kTPCuQsine+ih]) {
+        if(ctx->fUsedVars[kTPCuQsine+ih]) {
            values[kTPCuQsine+ih] = TMath::Sin((values[kPhi]-tpcEPsubtracted[ih])*(ih+1));
            values[kTPCuQsine+ih] *= TMath::Sqrt(qVec[ih][0]*qVec[ih][0] + qVec[ih][1]*qVec[ih][1]);
         }
@@ -1248,34 +1373,34 @@ void AliReducedVarManager::FillTrackInfo(BASETRACK* p, Float_t* values) {
   values[kDcaZTPC]     = pinfo->DCAzTPC();
   values[kCharge]      = pinfo->Charge();
   
-  if(fgUsedVars[kITSncls]) values[kITSncls] = pinfo->ITSncls();
+  if(ctx->fUsedVars[kITSncls]) values[kITSncls] = pinfo->ITSncls();
   values[kITSsignal] = pinfo->ITSsignal();
   values[kITSchi2] = pinfo->ITSchi2();
 
-  if(fgUsedVars[kITSnclsShared]) values[kITSnclsShared] = pinfo->ITSnSharedCls();
+  if(ctx->fUsedVars[kITSnclsShared]) values[kITSnclsShared] = pinfo->ITSnSharedCls();
   values[kTPCncls] = pinfo->TPCncls();
 
-  if(fgUsedVars[kNclsSFracITS])
+  if(ctx->fUsedVars[kNclsSFracITS])
   values[kNclsSFracITS] = (pinfo-> ITSncls()>0 ? Float_t (pinfo->ITSnSharedCls())/Float_t(pinfo->ITSncls()) :0.0) ;
-  if(fgUsedVars[kTPCnclsRatio]) 
+  if(ctx->fUsedVars[kTPCnclsRatio]) 
     values[kTPCnclsRatio] = (pinfo->TPCFindableNcls()>0 ? Float_t(pinfo->TPCncls())/Float_t(pinfo->TPCFindableNcls()) : 0.0);
-  if(fgUsedVars[kTPCnclsRatio2]) 
+  if(ctx->fUsedVars[kTPCnclsRatio2]) 
     values[kTPCnclsRatio2] = (pinfo->TPCCrossedRows()>0 ? Float_t(pinfo->TPCncls())/Float_t(pinfo->TPCCrossedRows()) : 0.0);
 
-  if(fgUsedVars[kTPCcrossedRowsOverFindableClusters]) { 
+  if(ctx->fUsedVars[kTPCcrossedRowsOverFindableClusters]) { 
      if(pinfo->TPCFindableNcls()>0)
        values[kTPCcrossedRowsOverFindableClusters] = Float_t(pinfo->TPCCrossedRows()) / Float_t(pinfo->TPCFindableNcls());
      else 
         values[kTPCcrossedRowsOverFindableClusters] = 0.0;
   }
-  if(fgUsedVars[kTPCnclsSharedRatio]) {
+  if(ctx->fUsedVars[kTPCnclsSharedRatio]) {
      if(pinfo->TPCncls()>0) 
         values[kTPCnclsSharedRatio] = Float_t(pinfo->TPCnclsShared()) / Float_t(pinfo->TPCncls());
      else
         values[kTPCnclsSharedRatio] = 0.0;
   }
 
-  if(fgUsedVars[kTPCnclsRatio3])
+  if(ctx->fUsedVars[kTPCnclsRatio3])
     values[kTPCnclsRatio3] = (pinfo->TPCFindableNcls()>0 ? Float_t(pinfo->TPCCrossedRows())/Float_t(pinfo->TPCFindableNcls()) : 0.0);
 
   values[kTPCnclsF]       = pinfo->TPCFindableNcls();
@@ -1284,8 +1409,8 @@ void AliReducedVarManager::FillTrackInfo(BASETRACK* p, Float_t* values) {
   values[kTPCsignal]      = pinfo->TPCsignal();
   values[kTPCsignalN]     = pinfo->TPCsignalN();
   values[kTPCchi2] = pinfo->TPCchi2();
-  if(fgUsedVars[kTPCNclusBitsFired]) values[kTPCNclusBitsFired] = pinfo->TPCClusterMapBitsFired();
-  if(fgUsedVars[kTPCclustersPerBit]) {
+  if(ctx->fUsedVars[kTPCNclusBitsFired]) values[kTPCNclusBitsFired] = pinfo->TPCClusterMapBitsFired();
+  if(ctx->fUsedVars[kTPCclustersPerBit]) {
     Int_t nbits = pinfo->TPCClusterMapBitsFired();
     values[kTPCclustersPerBit] = (nbits>0 ? values[kTPCncls]/Float_t(nbits) : 0.0);
   }
@@ -1304,15 +1429,15 @@ void AliReducedVarManager::FillTrackInfo(BASETRACK* p, Float_t* values) {
     values[kTOFnSig+specie] = pinfo->TOFnSig(specie);
     values[kBayes+specie]   = pinfo->GetBayesProb(specie);
   }
-  if(fgUsedVars[kTPCnSigCorrected+kElectron] && fgTPCelectronCentroidMap && fgTPCelectronWidthMap) {
-     Int_t binX = fgTPCelectronCentroidMap->GetXaxis()->FindBin(values[fgVarDependencyX]);
+  if(ctx->fUsedVars[kTPCnSigCorrected+kElectron] && ctx->fTPCelectronCentroidMap && ctx->fTPCelectronWidthMap) {
+     Int_t binX = ctx->fTPCelectronCentroidMap->GetXaxis()->FindBin(values[ctx->fVarDependencyX]);
      if(binX==0) binX = 1;
-     if(binX==fgTPCelectronCentroidMap->GetXaxis()->GetNbins()+1) binX -= 1;
-     Int_t binY = fgTPCelectronCentroidMap->GetYaxis()->FindBin(values[fgVarDependencyY]);
+     if(binX==ctx->fTPCelectronCentroidMap->GetXaxis()->GetNbins()+1) binX -= 1;
+     Int_t binY = ctx->fTPCelectronCentroidMap->GetYaxis()->FindBin(values[ctx->fVarDependencyY]);
      if(binY==0) binY=1;
-     if(binY==fgTPCelectronCentroidMap->GetYaxis()->GetNbins()+1) binY -= 1;
-     Float_t centroid = fgTPCelectronCentroidMap->GetBinContent(binX, binY);
-     Float_t width = fgTPCelectronWidthMap->GetBinContent(binX, binY);
+     if(binY==ctx->fTPCelectronCentroidMap->GetYaxis()->GetNbins()+1) binY -= 1;
+     Float_t centroid = ctx->fTPCelectronCentroidMap->GetBinContent(binX, binY);
+     Float_t width = ctx->fTPCelectronWidthMap->GetBinContent(binX, binY);
      if(TMath::Abs(width)<1.0e-6) width = 1.;
      values[kTPCnSigCorrected+kElectron] = (values[kTPCnSig+kElectron] - centroid)/width;   
   }
@@ -1324,10 +1449,10 @@ void AliReducedVarManager::FillTrackInfo(BASETRACK* p, Float_t* values) {
   values[kTRDntracklets]    = pinfo->TRDntracklets(0);
   values[kTRDntrackletsPID] = pinfo->TRDntracklets(1);
   
-  if(fgUsedVars[kEMCALmatchedEnergy] || fgUsedVars[kEMCALmatchedEOverP]) {
+  if(ctx->fUsedVars[kEMCALmatchedEnergy] || ctx->fUsedVars[kEMCALmatchedEOverP]) {
     values[kEMCALmatchedClusterId] = pinfo->CaloClusterId();
-    if(fgEvent && (fgEvent->IsA()==EVENT::Class())){
-      CLUSTER* cluster = ((EVENT*)fgEvent)->GetCaloCluster(pinfo->CaloClusterId());
+    if(ctx->fEvent && (ctx->fEvent->IsA()==EVENT::Class())){
+      CLUSTER* cluster = ((EVENT*)ctx->fEvent)->GetCaloCluster(pinfo->CaloClusterId());
       values[kEMCALmatchedEnergy] = (cluster ? cluster->Energy() : -999.0);
       Float_t mom = pinfo->P();
       values[kEMCALmatchedEOverP] = (TMath::Abs(mom)>1.e-8 && cluster ? values[kEMCALmatchedEnergy]/mom : -999.0);
@@ -1338,14 +1463,14 @@ void AliReducedVarManager::FillTrackInfo(BASETRACK* p, Float_t* values) {
   //FillTrackingFlags(pinfo,values);
   
   if(pinfo->HasMCTruthInfo()) {
-     if(fgUsedVars[kPtMC]) values[kPtMC] = pinfo->PtMC();
-     if(fgUsedVars[kPMC]) values[kPMC] = pinfo->PMC();
+     if(ctx->fUsedVars[kPtMC]) values[kPtMC] = pinfo->PtMC();
+     if(ctx->fUsedVars[kPMC]) values[kPMC] = pinfo->PMC();
      values[kPxMC] = pinfo->MCmom(0);
      values[kPyMC] = pinfo->MCmom(1);
      values[kPzMC] = pinfo->MCmom(2);
-     if(fgUsedVars[kThetaMC]) values[kThetaMC] = pinfo->ThetaMC();
-     if(fgUsedVars[kEtaMC]) values[kEtaMC] = pinfo->EtaMC();
-     if(fgUsedVars[kPhiMC]) values[kPhiMC] = pinfo->PhiMC();
+     if(ctx->fUsedVars[kThetaMC]) values[kThetaMC] = pinfo->ThetaMC();
+     if(ctx->fUsedVars[kEtaMC]) values[kEtaMC] = pinfo->EtaMC();
+     if(ctx->fUsedVars[kPhiMC]) values[kPhiMC] = pinfo->PhiMC();
      //TODO: add also the massMC and RapMC   
      values[kPdgMC] = pinfo->MCPdg(0);
      values[kPdgMC+1] = pinfo->MCPdg(1);
@@ -1436,12 +1561,13 @@ void AliReducedVarManager::FillPairInfo(PAIR* p, Float_t* values) {
   //
   // fill pair information
   //
+  Context* ctx = GetContext();
   FillTrackInfo(p, values);
   
   values[kCandidateId]   = p->CandidateId();
   values[kPairType]      = p->PairType();
   values[kPairChisquare] = p->Chi2();
-  if(fgUsedVars[kMass]) {
+  if(ctx->fUsedVars[kMass]) {
     values[kMass] = p->Mass();
     if(p->CandidateId()==PAIR::kLambda0ToPPi)  values[kMass] = p->Mass(1);
     if(p->CandidateId()==PAIR::kALambda0ToPPi) values[kMass] = p->Mass(2);
@@ -1456,17 +1582,17 @@ void AliReducedVarManager::FillPairInfo(PAIR* p, Float_t* values) {
   values[kMassV0+2] = p->Mass(2);
   values[kMassV0+3] = p->Mass(3);
   
-  if(fgUsedVars[kRap]) values[kRap]              = p->Rapidity();
+  if(ctx->fUsedVars[kRap]) values[kRap]              = p->Rapidity();
                        values[kPairLxy]          = p->Lxy();
                        values[kPairPointingAngle]= p->PointingAngle();
 
   // polarization variables
   Bool_t usePolarization=kFALSE;
-  if(fgUsedVars[kPairThetaCS] || fgUsedVars[kPairThetaHE] || fgUsedVars[kPairPhiCS] || fgUsedVars[kPairPhiHE])
+  if(ctx->fUsedVars[kPairThetaCS] || ctx->fUsedVars[kPairThetaHE] || ctx->fUsedVars[kPairPhiCS] || ctx->fUsedVars[kPairPhiHE])
     usePolarization = kTRUE;
   if(usePolarization)
-    GetThetaPhiCM(fgEvent->GetTrack(((AliReducedPairInfo*)p)->LegId(0)), 
-		  fgEvent->GetTrack(((AliReducedPairInfo*)p)->LegId(1)), 
+    GetThetaPhiCM(ctx->fEvent->GetTrack(((AliReducedPairInfo*)p)->LegId(0)), 
+		  ctx->fEvent->GetTrack(((AliReducedPairInfo*)p)->LegId(1)), 
 		  values[kPairThetaHE], values[kPairPhiHE], values[kPairThetaCS], values[kPairPhiCS], m1, m2);
 }
 
@@ -1479,6 +1605,7 @@ void AliReducedVarManager::FillPairInfo(BASETRACK* t1, BASETRACK* t2, Int_t type
   // type - Parameter encoding the resonance type 
   //        This is needed for making a mass assumption on the legs
   //
+  Context* ctx = GetContext();
   PAIR p;
   p.PxPyPz(t1->Px()+t2->Px(), t1->Py()+t2->Py(), t1->Pz()+t2->Pz());
   p.CandidateId(type);
@@ -1494,7 +1621,7 @@ void AliReducedVarManager::FillPairInfo(BASETRACK* t1, BASETRACK* t2, Int_t type
   Float_t m1 = 0.0; Float_t m2 = 0.0;
   GetLegMassAssumption(type,m1,m2); 
     
-  if(fgUsedVars[kMass]) {     
+  if(ctx->fUsedVars[kMass]) {     
     values[kMass] = m1*m1+m2*m2 + 
                     2.0*(TMath::Sqrt(m1*m1+t1->P()*t1->P())*TMath::Sqrt(m2*m2+t2->P()*t2->P()) - 
                          t1->Px()*t2->Px() - t1->Py()*t2->Py() - t1->Pz()*t2->Pz());
@@ -1511,7 +1638,7 @@ void AliReducedVarManager::FillPairInfo(BASETRACK* t1, BASETRACK* t2, Int_t type
     p.SetMass(values[kMass]);
   }
 
-  if(fgUsedVars[kRap]) values[kRap] = p.Rapidity();
+  if(ctx->fUsedVars[kRap]) values[kRap] = p.Rapidity();
 
   values[kMassV0]   = -999.0;
   values[kMassV0+1] = -999.0;
@@ -1522,39 +1649,39 @@ void AliReducedVarManager::FillPairInfo(BASETRACK* t1, BASETRACK* t2, Int_t type
   
   // polarization variables
   Bool_t usePolarization=kFALSE;
-  if(fgUsedVars[kPairThetaCS] || fgUsedVars[kPairThetaHE] || fgUsedVars[kPairPhiCS] || fgUsedVars[kPairPhiHE])
+  if(ctx->fUsedVars[kPairThetaCS] || ctx->fUsedVars[kPairThetaHE] || ctx->fUsedVars[kPairPhiCS] || ctx->fUsedVars[kPairPhiHE])
     usePolarization = kTRUE;
   if(usePolarization)
     GetThetaPhiCM(t1, t2, values[kPairThetaHE], values[kPairPhiHE], values[kPairThetaCS], values[kPairPhiCS]);
   
-  if(fgUsedVars[kDMA] && (t1->IsA()==TRACK::Class()) && (t2->IsA()==TRACK::Class())) {
+  if(ctx->fUsedVars[kDMA] && (t1->IsA()==TRACK::Class()) && (t2->IsA()==TRACK::Class())) {
      TRACK* ti1=(TRACK*)t1; TRACK* ti2=(TRACK*)t2;
      values[kDMA]=TMath::Sqrt((ti1->HelixX()-ti2->HelixX())*(ti1->HelixX()-ti2->HelixX())+(ti1->HelixY()-ti2->HelixY())*(ti1->HelixY()-ti2->HelixY()))-ti1->HelixR()-ti2->HelixR();   
   }
   
-  if((fgUsedVars[kPairLegTPCchi2] || fgUsedVars[kPairLegTPCchi2+1]) && (t1->IsA()==TRACK::Class()) && (t2->IsA()==TRACK::Class())) {
+  if((ctx->fUsedVars[kPairLegTPCchi2] || ctx->fUsedVars[kPairLegTPCchi2+1]) && (t1->IsA()==TRACK::Class()) && (t2->IsA()==TRACK::Class())) {
      TRACK* ti1=(TRACK*)t1; TRACK* ti2=(TRACK*)t2;
      values[kPairLegTPCchi2] = ti1->TPCchi2();
      values[kPairLegTPCchi2+1] = ti2->TPCchi2();
   }
-  if((fgUsedVars[kPairLegITSchi2] || fgUsedVars[kPairLegITSchi2+1]) && (t1->IsA()==TRACK::Class()) && (t2->IsA()==TRACK::Class())) {
+  if((ctx->fUsedVars[kPairLegITSchi2] || ctx->fUsedVars[kPairLegITSchi2+1]) && (t1->IsA()==TRACK::Class()) && (t2->IsA()==TRACK::Class())) {
      TRACK* ti1=(TRACK*)t1; TRACK* ti2=(TRACK*)t2;
     values[kPairLegITSchi2] = ti1->ITSchi2();
     values[kPairLegITSchi2+1] = ti2->ITSchi2();
   }
   
-  if((fgUsedVars[kPseudoProperDecayTime] || fgUsedVars[kPairLxy]) &&  
+  if((ctx->fUsedVars[kPseudoProperDecayTime] || ctx->fUsedVars[kPairLxy]) &&  
      (t1->IsA()==TRACK::Class()) && (t2->IsA()==TRACK::Class()) && 
-     (fgEvent->IsA()==EVENT::Class())) {
+     (ctx->fEvent->IsA()==EVENT::Class())) {
      TRACK* ti1=(TRACK*)t1; 
      TRACK* ti2=(TRACK*)t2;
      AliKFParticle pairKF = BuildKFcandidate(ti1,m1,ti2,m2);
      Double_t errPseudoProperTime2;
-     EVENT* eventInfo = (EVENT*)fgEvent;
+     EVENT* eventInfo = (EVENT*)ctx->fEvent;
      AliKFParticle primVtx = BuildKFvertex(eventInfo);
-     if(fgUsedVars[kPseudoProperDecayTime]) 
+     if(ctx->fUsedVars[kPseudoProperDecayTime]) 
         values[kPseudoProperDecayTime] = pairKF.GetPseudoProperDecayTime(primVtx, fgkPairMass[type], &errPseudoProperTime2);
-     if(fgUsedVars[kPairLxy]) values[kPairLxy] =  ( (pairKF.X() - primVtx.X())*p.Px() + (pairKF.Y() - primVtx.Y())*p.Py() )/p.Pt(); // = values[kPseudoProperDecayTime]*(p.Pt()/PAIR::fgkPairMass[type]);
+     if(ctx->fUsedVars[kPairLxy]) values[kPairLxy] =  ( (pairKF.X() - primVtx.X())*p.Px() + (pairKF.Y() - primVtx.Y())*p.Py() )/p.Pt(); // = values[kPseudoProperDecayTime]*(p.Pt()/PAIR::fgkPairMass[type]);
   }
   
   if(p.PairType()==1 && t1->HasMCTruthInfo() && t2->HasMCTruthInfo()) {
@@ -1566,15 +1693,15 @@ void AliReducedVarManager::FillPairInfo(BASETRACK* t1, BASETRACK* t2, Int_t type
      PAIR pMC;
      pMC.PxPyPz(pinfo1->MCmom(0)+pinfo2->MCmom(0), pinfo1->MCmom(1)+pinfo2->MCmom(1), pinfo1->MCmom(2)+pinfo2->MCmom(2));
      pMC.CandidateId(type);
-     if(fgUsedVars[kPtMC]) values[kPtMC] = pMC.Pt();
-     if(fgUsedVars[kPMC]) values[kPMC] = pMC.P();
+     if(ctx->fUsedVars[kPtMC]) values[kPtMC] = pMC.Pt();
+     if(ctx->fUsedVars[kPMC]) values[kPMC] = pMC.P();
      values[kPxMC] = pMC.Px();
      values[kPyMC] = pMC.Py();
      values[kPzMC] = pMC.Pz();
-     if(fgUsedVars[kThetaMC]) values[kThetaMC] = pMC.Theta();
-     if(fgUsedVars[kEtaMC]) values[kEtaMC] = pMC.Eta();
-     if(fgUsedVars[kPhiMC]) values[kPhiMC] = pMC.Phi();
-     if(fgUsedVars[kMassMC]) {
+     if(ctx->fUsedVars[kThetaMC]) values[kThetaMC] = pMC.Theta();
+     if(ctx->fUsedVars[kEtaMC]) values[kEtaMC] = pMC.Eta();
+     if(ctx->fUsedVars[kPhiMC]) values[kPhiMC] = pMC.Phi();
+     if(ctx->fUsedVars[kMassMC]) {
         values[kMassMC] = m1*m1+m2*m2 + 
             2.0*(TMath::Sqrt(m1*m1+pinfo1->PMC()*pinfo1->PMC())*TMath::Sqrt(m2*m2+pinfo2->PMC()*pinfo2->PMC()) - 
             pinfo1->MCmom(0)*pinfo2->MCmom(0) - pinfo1->MCmom(1)*pinfo2->MCmom(1) - pinfo1->MCmom(2)*pinfo2->MCmom(2));
@@ -1591,13 +1718,13 @@ void AliReducedVarManager::FillPairInfo(BASETRACK* t1, BASETRACK* t2, Int_t type
      }
      
      // TODO: think about whether to use the PDG mass or the calculated mass from the legs for rapidity
-     if(fgUsedVars[kRapMC]) {
+     if(ctx->fUsedVars[kRapMC]) {
        pMC.SetMass(values[kMassMC]);
        values[kRapMC] = pMC.Rapidity();   
      }
   }
 
-   if( fgUsedVars[kPairPhiV] ){
+   if( ctx->fUsedVars[kPairPhiV] ){
     // implementation taken from AliDielectronPair.cxx
     Double_t px1=-9999.,py1=-9999.,pz1=-9999.;
     Double_t px2=-9999.,py2=-9999.,pz2=-9999.;
@@ -1708,7 +1835,7 @@ void AliReducedVarManager::FillPairInfo(BASETRACK* t1, BASETRACK* t2, Int_t type
     values[kPairPhiV] = phiv;
   }
 
-  if( fgUsedVars[kPairOpeningAngle] ){
+  if( ctx->fUsedVars[kPairOpeningAngle] ){
     TVector3 v1(t1->Px(), t1->Py(), t1->Pz());
     TVector3 v2(t2->Px(), t2->Py(), t2->Pz());
     values[kPairOpeningAngle] = v1.Angle(v2);
@@ -1722,22 +1849,22 @@ void AliReducedVarManager::FillPairInfo(BASETRACK* t1, BASETRACK* t2, Int_t type
     TRACK* ti1=(TRACK*)t1;
     TRACK* ti2=(TRACK*)t2;
 
-    if( fgUsedVars[kPairDca]   ) values[kPairDca]   = TMath::Sqrt(ti1->DCAxy() * ti1->DCAxy() + ti2->DCAxy() * ti2->DCAxy() + ti1->DCAz() * ti1->DCAz() + ti2->DCAz() * ti2->DCAz());
-    if( fgUsedVars[kPairDcaXY] ) values[kPairDcaXY] = TMath::Sqrt( ti1->DCAxy() * ti1->DCAxy() + ti2->DCAxy() * ti2->DCAxy() );
-    if( fgUsedVars[kPairDcaZ]  ) values[kPairDcaZ]  = TMath::Sqrt(ti1->DCAz() * ti1->DCAz() + ti2->DCAz() * ti2->DCAz() );
+    if( ctx->fUsedVars[kPairDca]   ) values[kPairDca]   = TMath::Sqrt(ti1->DCAxy() * ti1->DCAxy() + ti2->DCAxy() * ti2->DCAxy() + ti1->DCAz() * ti1->DCAz() + ti2->DCAz() * ti2->DCAz());
+    if( ctx->fUsedVars[kPairDcaXY] ) values[kPairDcaXY] = TMath::Sqrt( ti1->DCAxy() * ti1->DCAxy() + ti2->DCAxy() * ti2->DCAxy() );
+    if( ctx->fUsedVars[kPairDcaZ]  ) values[kPairDcaZ]  = TMath::Sqrt(ti1->DCAz() * ti1->DCAz() + ti2->DCAz() * ti2->DCAz() );
 
-    if( fgUsedVars[kPairDcaSqrt]   ) values[kPairDcaSqrt]   = TMath::Power(ti1->DCAxy() * ti1->DCAxy() + ti2->DCAxy() * ti2->DCAxy() + ti1->DCAz() * ti1->DCAz() + ti2->DCAz() * ti2->DCAz(), 0.25);
-    if( fgUsedVars[kPairDcaXYSqrt] ) values[kPairDcaXYSqrt] = TMath::Power( ti1->DCAxy() * ti1->DCAxy() + ti2->DCAxy() * ti2->DCAxy(), 0.25);
-    if( fgUsedVars[kPairDcaZSqrt]  ) values[kPairDcaZSqrt]  = TMath::Power(ti1->DCAz() * ti1->DCAz() + ti2->DCAz() * ti2->DCAz(), 0.25);
+    if( ctx->fUsedVars[kPairDcaSqrt]   ) values[kPairDcaSqrt]   = TMath::Power(ti1->DCAxy() * ti1->DCAxy() + ti2->DCAxy() * ti2->DCAxy() + ti1->DCAz() * ti1->DCAz() + ti2->DCAz() * ti2->DCAz(), 0.25);
+    if( ctx->fUsedVars[kPairDcaXYSqrt] ) values[kPairDcaXYSqrt] = TMath::Power( ti1->DCAxy() * ti1->DCAxy() + ti2->DCAxy() * ti2->DCAxy(), 0.25);
+    if( ctx->fUsedVars[kPairDcaZSqrt]  ) values[kPairDcaZSqrt]  = TMath::Power(ti1->DCAz() * ti1->DCAz() + ti2->DCAz() * ti2->DCAz(), 0.25);
 
-    if( fgUsedVars[kOpAngDcaPtCorr] ) {
+    if( ctx->fUsedVars[kOpAngDcaPtCorr] ) {
       Float_t a = -1.56316e-03;
       Float_t b =  1.22515e-02;
       Float_t c =  3.39455e-03;
       Float_t d =  1.00681e-01;
       values[kOpAngDcaPtCorr] = values[kPairOpeningAngle] - a - b * values[kPairDcaXYSqrt] - c * values[kOneOverSqrtPt] -  d * values[kPairDcaXYSqrt]  * values[kOneOverSqrtPt];
     }
-    if( fgUsedVars[kMassDcaPtCorr] ) {
+    if( ctx->fUsedVars[kMassDcaPtCorr] ) {
       Float_t a =  1.87774e-03;
       Float_t b =  4.53156e-02;
       Float_t c = -9.72947e-05;
@@ -1757,6 +1884,7 @@ void AliReducedVarManager::FillPairInfoME(BASETRACK* t1, BASETRACK* t2, Int_t ty
   // type - Parameter encoding the resonance type 
   //        This is needed for making a mass assumption on the legs
   //
+  Context* ctx = GetContext();
   PAIR p;
   p.PxPyPz(t1->Px()+t2->Px(), t1->Py()+t2->Py(), t1->Pz()+t2->Pz());
   p.CandidateId(type);
@@ -1771,7 +1899,7 @@ void AliReducedVarManager::FillPairInfoME(BASETRACK* t1, BASETRACK* t2, Int_t ty
   Float_t m1 = 0.0; Float_t m2 = 0.0;
   GetLegMassAssumption(type,m1,m2); 
     
-  if(fgUsedVars[kMass]) {     
+  if(ctx->fUsedVars[kMass]) {     
     values[kMass] = m1*m1+m2*m2 + 
                     2.0*(TMath::Sqrt(m1*m1+t1->P()*t1->P())*TMath::Sqrt(m2*m2+t2->P()*t2->P()) - 
                     t1->Px()*t2->Px() - t1->Py()*t2->Py() - t1->Pz()*t2->Pz());
@@ -1791,24 +1919,24 @@ void AliReducedVarManager::FillPairInfoME(BASETRACK* t1, BASETRACK* t2, Int_t ty
   values[kPx] = p.Px();
   values[kPy] = p.Py();
   values[kPz] = p.Pz();
-  if(fgUsedVars[kPt] || fgUsedVars[kPtSquared]) {
+  if(ctx->fUsedVars[kPt] || ctx->fUsedVars[kPtSquared]) {
     values[kPt] = p.Pt();
-    if(fgUsedVars[kPtSquared]) values[kPtSquared] = values[kPt]*values[kPt];
+    if(ctx->fUsedVars[kPtSquared]) values[kPtSquared] = values[kPt]*values[kPt];
   }
-  if(fgUsedVars[kP]) values[kP] = p.P();
-  if(fgUsedVars[kEta]) values[kEta] = p.Eta();
-  if(fgUsedVars[kRap]) values[kRap] = p.Rapidity();
-  if(fgUsedVars[kPhi]) values[kPhi] = p.Phi();
-  if(fgUsedVars[kTheta]) values[kTheta] = p.Theta();
+  if(ctx->fUsedVars[kP]) values[kP] = p.P();
+  if(ctx->fUsedVars[kEta]) values[kEta] = p.Eta();
+  if(ctx->fUsedVars[kRap]) values[kRap] = p.Rapidity();
+  if(ctx->fUsedVars[kPhi]) values[kPhi] = p.Phi();
+  if(ctx->fUsedVars[kTheta]) values[kTheta] = p.Theta();
 
-  if((fgUsedVars[kPairEff] || fgUsedVars[kOneOverPairEff]) && fgPairEffMap) {
-    Int_t binX = fgPairEffMap->GetXaxis()->FindBin(values[fgEffMapVarDependencyX]); //make sure the values[XVar] are filled for EM
+  if((ctx->fUsedVars[kPairEff] || ctx->fUsedVars[kOneOverPairEff]) && ctx->fPairEffMap) {
+    Int_t binX = ctx->fPairEffMap->GetXaxis()->FindBin(values[ctx->fEffMapVarDependencyX]); //make sure the values[XVar] are filled for EM
     if(binX==0) binX = 1;
-    if(binX==fgPairEffMap->GetXaxis()->GetNbins()+1) binX -= 1;
-    Int_t binY = fgPairEffMap->GetYaxis()->FindBin(values[fgEffMapVarDependencyY]); //make sure the values[YVar] are filled for EM
+    if(binX==ctx->fPairEffMap->GetXaxis()->GetNbins()+1) binX -= 1;
+    Int_t binY = ctx->fPairEffMap->GetYaxis()->FindBin(values[ctx->fEffMapVarDependencyY]); //make sure the values[YVar] are filled for EM
     if(binY==0) binY=1;
-    if(binY==fgPairEffMap->GetYaxis()->GetNbins()+1) binY -= 1;
-    Float_t pairEff = fgPairEffMap->GetBinContent(binX, binY);
+    if(binY==ctx->fPairEffMap->GetYaxis()->GetNbins()+1) binY -= 1;
+    Float_t pairEff = ctx->fPairEffMap->GetBinContent(binX, binY);
     Float_t oneOverPairEff = 1;
     if (pairEff > 1.0e-6) oneOverPairEff = 1/pairEff;
     values[kPairEff] = pairEff;
@@ -1829,6 +1957,7 @@ void AliReducedVarManager::FillPairInfo(PAIR* t1, BASETRACK* t2, Int_t type, Flo
   // type - Parameter encoding the resonance type 
   //        This is needed for making a mass assumption on the legs
   //
+  Context* ctx = GetContext();
   PAIR p;
   p.PxPyPz(t1->Px()+t2->Px(), t1->Py()+t2->Py(), t1->Pz()+t2->Pz());
   p.CandidateId(type);
@@ -1840,7 +1969,7 @@ void AliReducedVarManager::FillPairInfo(PAIR* t1, BASETRACK* t2, Int_t type, Flo
   Float_t m1 = 0.0; Float_t m2 = 0.0;
   GetLegMassAssumption(type,m1,m2); 
   
-  if(fgUsedVars[kMass]) {     
+  if(ctx->fUsedVars[kMass]) {     
     values[kMass] = m1*m1+m2*m2 + 
                     2.0*(TMath::Sqrt(m1*m1+t1->P()*t1->P())*TMath::Sqrt(m2*m2+t2->P()*t2->P()) - 
                     t1->Px()*t2->Px() - t1->Py()*t2->Py() - t1->Pz()*t2->Pz());
@@ -1870,17 +1999,18 @@ void AliReducedVarManager::FillCorrelationInfo(PAIR* p, BASETRACK* t, Float_t* v
   //
   // fill pair-track correlation information
   //
-  if(fgUsedVars[kDeltaPhi]) {
+  Context* ctx = GetContext();
+  if(ctx->fUsedVars[kDeltaPhi]) {
     Double_t delta = p->Phi() - t->Phi();
     if(delta>3.0/2.0*TMath::Pi()) delta -= 2.0*TMath::Pi();
     if(delta<-0.5*TMath::Pi()) delta += 2.0*TMath::Pi();
     values[kDeltaPhi] = delta;
   }
   
-  if(fgUsedVars[kDeltaTheta]) 
+  if(ctx->fUsedVars[kDeltaTheta]) 
     values[kDeltaTheta] = p->Theta() - t->Theta();
   
-  if(fgUsedVars[kDeltaEta]) values[kDeltaEta] = p->Eta() - t->Eta();
+  if(ctx->fUsedVars[kDeltaEta]) values[kDeltaEta] = p->Eta() - t->Eta();
 }
 
 //________________________________________________________________
@@ -2601,6 +2731,7 @@ void AliReducedVarManager::SetTPCelectronCorrectionMaps(TH2F* centroidMap, TH2F*
    //
    // initialize the electron TPC pid correction maps
    //
+   Context* ctx = GetContext();
    if(varX>kNVars || varX<=kNothing) {
       cout << "AliReducedVarManager::SetTPCelectronCorrectionMaps() The X-dependency variable is not a valid variable defined in AliReducedVarManager" << endl;
       cout << "                           Correction maps not used! Check it out!" << endl;
@@ -2611,15 +2742,15 @@ void AliReducedVarManager::SetTPCelectronCorrectionMaps(TH2F* centroidMap, TH2F*
       cout << "                           Correction maps not used! Check it out!" << endl;
       return;
    }
-   fgVarDependencyX = varX;
-   fgVarDependencyY = varY;
+   ctx->fVarDependencyX = varX;
+   ctx->fVarDependencyY = varY;
    if(centroidMap) {
-     fgTPCelectronCentroidMap = (TH2F*)centroidMap->Clone(Form("AliReducedVarManager_TPCelectronCentroidMap"));
-     fgTPCelectronCentroidMap->SetDirectory(0x0);
+     ctx->fTPCelectronCentroidMap = (TH2F*)centroidMap->Clone(Form("AliReducedVarManager_TPCelectronCentroidMap"));
+     ctx->fTPCelectronCentroidMap->SetDirectory(0x0);
    }
    if(widthMap) {
-     fgTPCelectronWidthMap = (TH2F*)widthMap->Clone(Form("AliReducedVarManager_TPCelectronWidthMap"));
-     fgTPCelectronWidthMap->SetDirectory(0x0);
+     ctx->fTPCelectronWidthMap = (TH2F*)widthMap->Clone(Form("AliReducedVarManager_TPCelectronWidthMap"));
+     ctx->fTPCelectronWidthMap->SetDirectory(0x0);
    }
 }
 
@@ -2628,6 +2759,7 @@ void AliReducedVarManager::SetPairEfficiencyMap(TH2F* effMap, AliReducedVarManag
   //
   // initialize the pair efficiency map
   //
+  Context* ctx = GetContext();
   if(varX>kNVars || varX<=kNothing) {
     cout << "AliReducedVarManager::SetPairEfficiencyMap() The X-dependency variable is not a valid variable defined in AliReducedVarManager" << endl;
     cout << "                           Efficiency map not used! Check it out!" << endl;
@@ -2638,11 +2770,11 @@ void AliReducedVarManager::SetPairEfficiencyMap(TH2F* effMap, AliReducedVarManag
     cout << "                           Efficiency map not used! Check it out!" << endl;
     return;
   }
-  fgEffMapVarDependencyX = varX; 
-  fgEffMapVarDependencyY = varY;
+  ctx->fEffMapVarDependencyX = varX; 
+  ctx->fEffMapVarDependencyY = varY;
   if(effMap) {
-    fgPairEffMap = (TH2F*)effMap->Clone(Form("AliReducedVarManager_PairEffMap"));
-    fgPairEffMap->SetDirectory(0x0);
+    ctx->fPairEffMap = (TH2F*)effMap->Clone(Form("AliReducedVarManager_PairEffMap"));
+    ctx->fPairEffMap->SetDirectory(0x0);
   }
 }
 
@@ -2651,21 +2783,22 @@ void AliReducedVarManager::SetLHCDataInfo(TH1F* totalLumi, TH1F* totalInt0, TH1F
    //
    // initialize the LHC data histograms
    //
+   Context* ctx = GetContext();
    if(totalLumi) {
-      fgRunTotalLuminosity = (TH1F*)totalLumi->Clone("AliReducedVarManager_TotalLuminosity");
-      fgRunTotalLuminosity->SetDirectory(0x0);
+      ctx->fRunTotalLuminosity = (TH1F*)totalLumi->Clone("AliReducedVarManager_TotalLuminosity");
+      ctx->fRunTotalLuminosity->SetDirectory(0x0);
    }
    if(totalInt0) {
-      fgRunTotalIntensity0 = (TH1F*)totalInt0->Clone("AliReducedVarManager_TotalIntensity0");
-      fgRunTotalIntensity0->SetDirectory(0x0);
+      ctx->fRunTotalIntensity0 = (TH1F*)totalInt0->Clone("AliReducedVarManager_TotalIntensity0");
+      ctx->fRunTotalIntensity0->SetDirectory(0x0);
    }
    if(totalInt1) {
-      fgRunTotalIntensity1 = (TH1F*)totalInt1->Clone("AliReducedVarManager_TotalIntensity1");
-      fgRunTotalIntensity1->SetDirectory(0x0);
+      ctx->fRunTotalIntensity1 = (TH1F*)totalInt1->Clone("AliReducedVarManager_TotalIntensity1");
+      ctx->fRunTotalIntensity1->SetDirectory(0x0);
    }
    if(fillNumber) {
-      fgRunLHCFillNumber = (TH1I*)fillNumber->Clone("AliReducedVarManager_LHCFillNumber");
-      fgRunLHCFillNumber->SetDirectory(0x0);
+      ctx->fRunLHCFillNumber = (TH1I*)fillNumber->Clone("AliReducedVarManager_LHCFillNumber");
+      ctx->fRunLHCFillNumber->SetDirectory(0x0);
    }
 }
 
@@ -2674,31 +2807,33 @@ void AliReducedVarManager::SetGRPDataInfo(TH1I* dipolePolarity, TH1I* l3Polarity
    //
    // initialize the GRP data histograms
    //
+   Context* ctx = GetContext();
    if(dipolePolarity) {
-      fgRunDipolePolarity = (TH1I*)dipolePolarity->Clone("AliReducedVarManager_DipolePolarity");
-      fgRunDipolePolarity->SetDirectory(0x0);
+      ctx->fRunDipolePolarity = (TH1I*)dipolePolarity->Clone("AliReducedVarManager_DipolePolarity");
+      ctx->fRunDipolePolarity->SetDirectory(0x0);
    }
    if(l3Polarity) {
-      fgRunL3Polarity = (TH1I*)l3Polarity->Clone("AliReducedVarManager_L3Polarity");
-      fgRunL3Polarity->SetDirectory(0x0);
+      ctx->fRunL3Polarity = (TH1I*)l3Polarity->Clone("AliReducedVarManager_L3Polarity");
+      ctx->fRunL3Polarity->SetDirectory(0x0);
    }
    if(timeStart) {
-      fgRunTimeStart = (TH1I*)timeStart->Clone("AliReducedVarManager_TimeStart");
-      fgRunTimeStart->SetDirectory(0x0);
+      ctx->fRunTimeStart = (TH1I*)timeStart->Clone("AliReducedVarManager_TimeStart");
+      ctx->fRunTimeStart->SetDirectory(0x0);
    }
    if(timeStop) {
-      fgRunTimeEnd = (TH1I*)timeStop->Clone("AliReducedVarManager_TimeEnd");
-      fgRunTimeEnd->SetDirectory(0x0);
+      ctx->fRunTimeEnd = (TH1I*)timeStop->Clone("AliReducedVarManager_TimeEnd");
+      ctx->fRunTimeEnd->SetDirectory(0x0);
    }
 }
 
 //____________________________________________________________________________________
 void AliReducedVarManager::SetRunNumbers( TString runNumbers ){
+  Context* ctx = GetContext();
   TObjArray* runNumbersArr = runNumbers.Tokenize(";");
   runNumbersArr->SetOwner();
   for( Int_t iRun=0; iRun < runNumbersArr->GetEntries(); ++iRun){
     TString runNumberString = runNumbersArr->At(iRun)->GetName();
-    fgRunNumbers.push_back( runNumberString.Atoi() );
+    ctx->fRunNumbers.push_back( runNumberString.Atoi() );
   }
 }
 
@@ -2707,6 +2842,7 @@ void AliReducedVarManager::SetMultiplicityProfile(TH2* profile, Int_t estimator)
    //
    // initialize the profile for the z-vertex equalization of the multiplicity estimator
    //
+  Context* ctx = GetContext();
   Int_t iEstimator = estimator - kMultiplicity;
   if( iEstimator >= kNMultiplicityEstimators ){
     cout << "Multiplcity estimator " << estimator << " not defined!" <<endl;
@@ -2716,8 +2852,8 @@ void AliReducedVarManager::SetMultiplicityProfile(TH2* profile, Int_t estimator)
     cout <<"AliReducedVarManager::SetMultiplicityProfile : Profile null!"  << endl;
     return;
   }
-  fgAvgMultVsVtxAndRun[iEstimator] = (TH2*)profile->Clone( Form("profile_%d", estimator  ));
-  fgAvgMultVsVtxAndRun[iEstimator]->SetDirectory(0x0);
+  ctx->fAvgMultVsVtxAndRun[iEstimator] = (TH2*)profile->Clone( Form("profile_%d", estimator  ));
+  ctx->fAvgMultVsVtxAndRun[iEstimator]->SetDirectory(0x0);
 }
 
 //____________________________________________________________________________________
@@ -2725,7 +2861,8 @@ void AliReducedVarManager::SetVZEROCalibrationPath(const Char_t* path) {
    //
    // initialize the path to the VZERO calibration histograms
    //
-   fgVZEROCalibrationPath = path;
+   Context* ctx = GetContext();
+   ctx->fVZEROCalibrationPath = path;
 }
 
 //____________________________________________________________________________________
@@ -2733,7 +2870,8 @@ void AliReducedVarManager::SetCalibrateVZEROqVector(Bool_t option) {
    //
    // set the option whether to calibrate the VZERO event plane
    //
-   fgOptionCalibrateVZEROqVec = option;
+   Context* ctx = GetContext();
+   ctx->fOptionCalibrateVZEROqVec = option;
 }
 
 //____________________________________________________________________________________
@@ -2741,8 +2879,9 @@ void AliReducedVarManager::SetRecenterVZEROqVector(Bool_t option) {
    //
    // set the option whether to recenter the VZERO event plane
    //   
-   fgOptionRecenterVZEROqVec = option;
-   //if(fgOptionRecenterVZEROqVec) fgOptionCalibrateVZEROqVec = kTRUE;
+   Context* ctx = GetContext();
+   ctx->fOptionRecenterVZEROqVec = option;
+   //if(ctx->fOptionRecenterVZEROqVec) ctx->fOptionCalibrateVZEROqVec = kTRUE;
 }
 
 //____________________________________________________________________________________
@@ -558,7 +558,63 @@ class AliReducedVarManager : public TObject {
   static const Double_t fgkVZEROCz;    // z-position for VZERO-C
   static const Double_t fgkVZEROminMult;   // minimum VZERO channel multiplicity
   static const Float_t fgkTPCQvecRapGap;    // symmetric interval in the middle of the TPC excluded from EP calculation
-    
+
+  // Per-instance state: current event, event plane, the used variable flags and the
+  // calibration inputs (correction maps, multiplicity profiles, VZERO calibration,
+  // run-wise GRP info) with the run they were resolved for. The static interface works
+  // on the context of the calling thread (the default one unless SetContext() is called),
+  // so that differently configured tasks or worker threads can each own a context.
+  // The Fill functions look the context up once per call.
+  class Context {
+  public:
+    Context();
+    Context(const Context& c);    // copies the used variable flags and the calibration inputs, not the event pointers
+    ~Context();
+
+    AliReducedBaseEvent* fEvent;            // pointer to the current event
+    AliReducedEventPlaneInfo* fEventPlane;  // pointer to the current event plane
+    Bool_t fUsedVars[kNVars];               // array of flags toggled when the corresponding variable is required (e.g., in the histogram manager, in cuts, mixing handler, etc.)
+
+    Int_t fCurrentRunNumber;                // current run number
+    Int_t fRunID;                           // run ID
+    std::vector<Int_t> fRunNumbers;         // vector with run numbers (for histograms vs. run number)
+    TH2F* fTPCelectronCentroidMap;          // TPC electron centroid 2D map (owned)
+    TH2F* fTPCelectronWidthMap;             // TPC electron width 2D map (owned)
+    Variables fVarDependencyX;              // varX in the 2-D electron correction maps
+    Variables fVarDependencyY;              // varY in the 2-D electron correction maps
+    TH2F* fPairEffMap;                      // 2D pair efficiency map (owned)
+    Variables fEffMapVarDependencyX;        // varX in the pair eff maps
+    Variables fEffMapVarDependencyY;        // varY in the pair eff maps
+    TH1F* fRunTotalLuminosity;              // total luminosity, GRP/GRP/LHCData::GetLumiAliceSBDelivered()
+    TH1F* fRunTotalIntensity0;              // total intensity beam 1, GRP/GRP/LHCData::GetTotalIntensity(0)
+    TH1F* fRunTotalIntensity1;              // total intensity beam 2, GRP/GRP/LHCData::GetTotalIntensity(1)
+    TH1I* fRunLHCFillNumber;                // LHC fill number, GRP/GRP/LHCData::GetFillNumber()
+    TH1I* fRunDipolePolarity;               // dipole magnet polarity, GRP/GRP/Data::GetDipolePolarity()
+    TH1I* fRunL3Polarity;                   // L3 magnet polarity, GRP/GRP/Data::GetL3Polarity()
+    TH1I* fRunTimeStart;                    // run start time, GRP/GRP/Data::GetTimeStart()
+    TH1I* fRunTimeEnd;                      // run stop time, GRP/GRP/Data::GetTimeEnd()
+    TH1* fAvgMultVsVtxGlobal      [kNMultiplicityEstimators];   // average multiplicity vs. z-vertex position (global)
+    TH1* fAvgMultVsVtxRunwise     [kNMultiplicityEstimators];   // average multiplicity vs. z-vertex position (run-by-run)
+    TH1* fAvgMultVsRun            [kNMultiplicityEstimators];   // average multiplicity vs. run number
+    TH2* fAvgMultVsVtxAndRun      [kNMultiplicityEstimators];   // 2D : average multiplicity vs. run number and z-vertex position (owned)
+    Double_t fRefMultVsVtxGlobal  [kNMultiplicityEstimators] [kNReferenceMultiplicities];  // reference multiplicity for z-vertex correction (global)
+    Double_t fRefMultVsVtxRunwise [kNMultiplicityEstimators] [kNReferenceMultiplicities];  // reference multiplicity for z-vertex correction (run-by-run)
+    Double_t fRefMultVsRun        [kNMultiplicityEstimators] [kNReferenceMultiplicities];  // reference multiplicity for run correction
+    Double_t fRefMultVsVtxAndRun  [kNMultiplicityEstimators] [kNReferenceMultiplicities];  // reference multiplicity for run, vtx correction
+    TString fVZEROCalibrationPath;          // path to the VZERO calibration histograms
+    TProfile2D* fAvgVZEROChannelMult[64];   // average multiplicity in VZERO channels vs (vtxZ,centSPD) (owned)
+    TProfile2D* fVZEROqVecRecentering[4];   // (vtxZ,centSPD) maps of the VZERO A and C recentering Qvector offsets (owned)
+    Bool_t fOptionCalibrateVZEROqVec;
+    Bool_t fOptionRecenterVZEROqVec;
+
+  private:
+    Context& operator=(const Context& c);
+  };
+
+  static Context* GetDefaultContext() {return &fgDefaultContext;}
+  static Context* GetContext();
+  static Context* SetContext(Context* ctx);
+
   AliReducedVarManager();
   AliReducedVarManager(const Char_t* name);
   virtual ~AliReducedVarManager();
@@ -566,16 +622,17 @@ class AliReducedVarManager : public TObject {
   static void SetBeamMomentum(Float_t beamMom) {fgBeamMomentum = beamMom;}
   static Float_t GetBeamMomentum() {return fgBeamMomentum;}
   
-  static void SetEvent(AliReducedBaseEvent* const ev) {fgEvent = ev;};
-  static void SetEventPlane(AliReducedEventPlaneInfo* const ev) {fgEventPlane = ev;};
-  static void SetUseVariable(Variables var) {fgUsedVars[var] = kTRUE; SetVariableDependencies();}
+  static void SetEvent(AliReducedBaseEvent* const ev) {GetContext()->fEvent = ev;};
+  static void SetEventPlane(AliReducedEventPlaneInfo* const ev) {GetContext()->fEventPlane = ev;};
+  static void SetUseVariable(Variables var) {GetContext()->fUsedVars[var] = kTRUE; SetVariableDependencies();}
   static void SetUseVars(Bool_t* usedVars) {
+    Context* ctx = GetContext();
     for(Int_t i=0;i<kNVars;++i) {
-      if(usedVars[i]) fgUsedVars[i]=kTRUE;    // overwrite only the variables that are being used since there are more channels to modify the used variables array, independently
+      if(usedVars[i]) ctx->fUsedVars[i]=kTRUE;    // overwrite only the variables that are being used since there are more channels to modify the used variables array, independently
     }
     SetVariableDependencies();
   }
-  static Bool_t GetUsedVar(Variables var) {return fgUsedVars[var];}
+  static Bool_t GetUsedVar(Variables var) {return GetContext()->fUsedVars[var];}
   
   static void FillEventInfo(Float_t* values);
   static void FillEventInfo(AliReducedBaseEvent* event, Float_t* values, AliReducedEventPlaneInfo* eventPlane=0x0);
@@ -625,12 +682,8 @@ class AliReducedVarManager : public TObject {
   static Int_t GetCorrectedMultiplicity( Int_t estimator = kMultiplicity, Int_t correction = 0, Int_t reference = 0, Int_t smearing = 0 );
   
  private:
-  static Int_t     fgCurrentRunNumber;               // current run number
   static Float_t fgBeamMomentum;                  // beam energy (needed when calculating polarization angles) 
-  static AliReducedBaseEvent* fgEvent;            // pointer to the current event
-  static AliReducedEventPlaneInfo* fgEventPlane;  // pointer to the current event plane
-  static Bool_t fgUsedVars[kNVars];              // array of flags toggled when the corresponding variable is required (e.g., in the histogram manager, in cuts, mixing handler, etc.) 
-                                                 //   when a variable is used
+  static Context fgDefaultContext;                // context used when none is set
   static void SetVariableDependencies();       // toggle those variables on which other used variables might depend 
   
 
@@ -643,38 +696,6 @@ class AliReducedVarManager : public TObject {
   static AliKFParticle BuildKFcandidate(AliReducedTrackInfo* track1, Float_t mh1, AliReducedTrackInfo* track2, Float_t mh2);
   static AliKFParticle BuildKFvertex( AliReducedEventInfo * event );
   
-  static TH2F* fgTPCelectronCentroidMap;    // TPC electron centroid 2D map
-  static TH2F* fgTPCelectronWidthMap;       // TPC electron width 2D map
-  static Variables fgVarDependencyX;        // varX in the 2-D electron correction maps
-  static Variables fgVarDependencyY;        // varY in the 2-D electron correction maps
-  static TH2F* fgPairEffMap;       // 2D pair efficiency map
-  static Variables fgEffMapVarDependencyX;        // varX in the pair eff maps
-  static Variables fgEffMapVarDependencyY;        // varY in the pair eff maps
-  
-  static TH1F* fgRunTotalLuminosity;      // total luminosity, GRP/GRP/LHCData::GetLumiAliceSBDelivered()
-  static TH1F* fgRunTotalIntensity0;        // total intensity beam 1, GRP/GRP/LHCData::GetTotalIntensity(0)
-  static TH1F* fgRunTotalIntensity1;         // total intensity beam 2, GRP/GRP/LHCData::GetTotalIntensity(1)
-  static TH1I* fgRunLHCFillNumber;         // LHC fill number, GRP/GRP/LHCData::GetFillNumber()
-  static TH1I* fgRunDipolePolarity;          // dipole magnet polarity, GRP/GRP/Data::GetDipolePolarity()
-  static TH1I* fgRunL3Polarity;                // L3 magnet polarity, GRP/GRP/Data::GetL3Polarity()
-  static TH1I* fgRunTimeStart;                // run start time, GRP/GRP/Data::GetTimeStart()
-  static TH1I* fgRunTimeEnd;                  // run stop time, GRP/GRP/Data::GetTimeEnd()
-  static std::vector<Int_t> fgRunNumbers;     // vector with run numbers (for histograms vs. run number)
-  static Int_t fgRunID;                       // run ID
-  static TH1* fgAvgMultVsVtxGlobal      [kNMultiplicityEstimators];        // average multiplicity vs. z-vertex position (global)
-  static TH1* fgAvgMultVsVtxRunwise     [kNMultiplicityEstimators];        // average multiplicity vs. z-vertex position (run-by-run)
-  static TH1* fgAvgMultVsRun            [kNMultiplicityEstimators];           // average multiplicity vs. run number
-  static TH2* fgAvgMultVsVtxAndRun      [kNMultiplicityEstimators];  // 2D : average multiplicity vs. run number and z-vertex position
-  static Double_t fgRefMultVsVtxGlobal  [kNMultiplicityEstimators] [kNReferenceMultiplicities];  // reference multiplicity for z-vertex correction (global)
-  static Double_t fgRefMultVsVtxRunwise [kNMultiplicityEstimators] [kNReferenceMultiplicities];  // reference multiplicity for z-vertex correction (run-by-run)
-  static Double_t fgRefMultVsRun        [kNMultiplicityEstimators] [kNReferenceMultiplicities];  // reference multiplicity for run correction
-  static Double_t fgRefMultVsVtxAndRun  [kNMultiplicityEstimators] [kNReferenceMultiplicities];  // reference multiplicity for run, vtx correction
-  static TString fgVZEROCalibrationPath;       // path to the VZERO calibration histograms
-  static TProfile2D* fgAvgVZEROChannelMult[64];       // average multiplicity in VZERO channels vs (vtxZ,centSPD)
-  static TProfile2D* fgVZEROqVecRecentering[4];       // (vtxZ,centSPD) maps of the VZERO A and C recentering Qvector offsets
-  static Bool_t fgOptionCalibrateVZEROqVec;
-  static Bool_t fgOptionRecenterVZEROqVec;
-  
   AliReducedVarManager(AliReducedVarManager const&);
   AliReducedVarManager& operator=(AliReducedVarManager const&);  
   
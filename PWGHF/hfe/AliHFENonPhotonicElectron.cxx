@@ -33,6 +33,7 @@
 #include "TParticle.h"
 #include "TList.h"
 #include "TDatabasePDG.h"
+#include "TArrayF.h"
 
 #include "AliVEvent.h"
 #include "AliMCEvent.h"
@@ -85,6 +86,9 @@ ClassImp(AliHFENonPhotonicElectron)
     ,fMaxOpening3D	(TMath::Pi())
     ,fMaxInvMass		(1000)
     ,fSetMassConstraint	(kFALSE)
+    ,fUsePairPreFilter	(kFALSE)
+    ,fPreFilterMassMargin	(0.1)
+    ,fPreFilterAngleMargin	(0.2)
     ,fSelectCategory1tracks(kTRUE)
     ,fSelectCategory2tracks(kFALSE)
     ,fITSmeanShift(0.)
@@ -93,6 +97,7 @@ ClassImp(AliHFENonPhotonicElectron)
     ,fminPt(0.1)
     ,fEtaDalitzWeightFactor(1.0)
     ,fArraytrack		(NULL)
+    ,fPoolKinematics	(NULL)
     ,fCounterPoolBackground	(0)
     ,fnumberfound			(0)
     ,fListOutput		(NULL)
@@ -143,6 +148,9 @@ ClassImp(AliHFENonPhotonicElectron)
     ,fMaxOpening3D	(TMath::TwoPi())
     ,fMaxInvMass		(1000)
     ,fSetMassConstraint	(kFALSE)
+    ,fUsePairPreFilter	(kFALSE)
+    ,fPreFilterMassMargin	(0.1)
+    ,fPreFilterAngleMargin	(0.2)
     ,fSelectCategory1tracks(kTRUE)
     ,fSelectCategory2tracks(kFALSE)
     ,fITSmeanShift(0.)
@@ -151,6 +159,7 @@ ClassImp(AliHFENonPhotonicElectron)
     ,fminPt(0.1)
     ,fEtaDalitzWeightFactor(1.0)
     ,fArraytrack		(NULL)
+    ,fPoolKinematics	(NULL)
     ,fCounterPoolBackground	(0)
     ,fnumberfound			(0)
     ,fListOutput		(NULL)
@@ -201,6 +210,9 @@ ClassImp(AliHFENonPhotonicElectron)
     ,fMaxOpening3D	(ref.fMaxOpening3D)
     ,fMaxInvMass		(ref.fMaxInvMass)
     ,fSetMassConstraint	(ref.fSetMassConstraint)
+    ,fUsePairPreFilter	(ref.fUsePairPreFilter)
+    ,fPreFilterMassMargin	(ref.fPreFilterMassMargin)
+    ,fPreFilterAngleMargin	(ref.fPreFilterAngleMargin)
     ,fSelectCategory1tracks(ref.fSelectCategory1tracks)
     ,fSelectCategory2tracks(ref.fSelectCategory2tracks)
     ,fITSmeanShift(ref.fITSmeanShift)
@@ -209,6 +221,7 @@ ClassImp(AliHFENonPhotonicElectron)
     ,fminPt(ref.fminPt)
     ,fEtaDalitzWeightFactor(ref.fEtaDalitzWeightFactor)
     ,fArraytrack		(NULL)
+    ,fPoolKinematics	(NULL)
     ,fCounterPoolBackground	(0)
     ,fnumberfound			(0)
     ,fListOutput		(ref.fListOutput)
@@ -250,6 +263,7 @@ AliHFENonPhotonicElectron::~AliHFENonPhotonicElectron()
     // Destructor
     //
     if(fArraytrack)		delete fArraytrack;
+    if(fPoolKinematics)		delete fPoolKinematics;
     //if(fHFEBackgroundCuts)	delete fHFEBackgroundCuts;
     if(fPIDBackground)		delete fPIDBackground;
     if(fPIDBackgroundQA)		delete fPIDBackgroundQA;
@@ -571,6 +585,10 @@ Int_t AliHFENonPhotonicElectron::FillPoolAssociatedTracks(AliVEvent *inputEvent,
     } else {
         fArraytrack = new TArrayI(nbtracks);
     }
+    if(fUsePairPreFilter){
+        if(!fPoolKinematics) fPoolKinematics = new TArrayF(4*nbtracks);
+        else if(fPoolKinematics->GetSize() < 4*nbtracks) fPoolKinematics->Set(4*nbtracks);
+    }
 
     fCounterPoolBackground = 0;
 
@@ -589,6 +607,14 @@ Int_t AliHFENonPhotonicElectron::FillPoolAssociatedTracks(AliVEvent *inputEvent,
         if(isSelected){
             AliDebug(2,Form("fCounterPoolBackground %d, track %d",fCounterPoolBackground,k));
             fArraytrack->AddAt(k,fCounterPoolBackground);
+            if(fUsePairPreFilter){
+                // kinematics cached once per event for the pair pre-filter
+                Float_t *kine = fPoolKinematics->GetArray() + 4*fCounterPoolBackground;
+                kine[0] = track->Px();
+                kine[1] = track->Py();
+                kine[2] = track->Pz();
+                kine[3] = track->P();
+            }
             fCounterPoolBackground++;
         }
     } // loop tracks
@@ -707,6 +733,7 @@ Int_t AliHFENonPhotonicElectron::LookAtNonHFE(Int_t iTrack1, AliVTrack *track1,
     Double_t invmass(-1);
 
     Float_t fCharge1 = track1->Charge();							//Charge from track1
+    Double_t p1[4] = {track1->Px(), track1->Py(), track1->Pz(), track1->P()};	//Momentum of track1 for the pre-filter
 
     Bool_t kUSignPhotonic = kFALSE;
     Bool_t kLSignPhotonic = kFALSE;
@@ -734,6 +761,16 @@ Int_t AliHFENonPhotonicElectron::LookAtNonHFE(Int_t iTrack1, AliVTrack *track1,
     for(Int_t idex = 0; idex < fCounterPoolBackground; idex++){
         iTrack2 = fArraytrack->At(idex);
         AliDebug(2,Form("track %d",iTrack2));
+
+        // track cuts and PID already done
+
+        // Checking if it is the same Track!
+        if(iTrack2==iTrack1) continue;
+        AliDebug(2,"Different");
+
+        // Pairs which cannot pass the mass and opening angle cuts are not fitted
+        if(fUsePairPreFilter && !PassPairPreFilter(p1, idex)) continue;
+
         track2 = (AliVTrack *)vEvent->GetTrack(iTrack2);
 
         if(!track2){
@@ -750,12 +787,6 @@ Int_t AliHFENonPhotonicElectron::LookAtNonHFE(Int_t iTrack1, AliVTrack *track1,
         valueSign[6] = track2->Pt();
         valueSign[8] = track2->Eta();
 
-        // track cuts and PID already done
-
-        // Checking if it is the same Track!
-        if(iTrack2==iTrack1) continue;
-        AliDebug(2,"Different");
-
         // if MC look
         if(fMCEvent || fAODArrayMCInfo){
             AliDebug(2, "Checking for source");
@@ -1273,6 +1304,31 @@ Bool_t AliHFENonPhotonicElectron::MakePairKF(const AliVTrack *inclusive, const A
     return kTRUE;
 }
 
+//_______________________________________________________________________________________________
+Bool_t AliHFENonPhotonicElectron::PassPairPreFilter(const Double_t *p1, Int_t idex) const {
+    //
+    // Cheap pre-selection of the pairs before the pair fit: invariant mass and
+    // opening angle computed from the momenta at the primary vertex, cut with
+    // the margins fPreFilterMassMargin and fPreFilterAngleMargin to absorb the
+    // difference with respect to the momenta at the pair vertex
+    //
+    const Double_t eMass2 = 0.000511*0.000511;
+    const Float_t *p2 = fPoolKinematics->GetArray() + 4*idex;
+
+    Double_t pp = p1[3]*p2[3];
+    if(pp <= 0.) return kTRUE;
+    Double_t dot = p1[0]*p2[0] + p1[1]*p2[1] + p1[2]*p2[2];
+
+    Double_t cosangle = TMath::Max(-1., TMath::Min(1., dot/pp));
+    if(TMath::ACos(cosangle) > fMaxOpening3D + fPreFilterAngleMargin) return kFALSE;
+
+    Double_t e1 = TMath::Sqrt(p1[3]*p1[3] + eMass2);
+    Double_t e2 = TMath::Sqrt(p2[3]*p2[3] + eMass2);
+    Double_t mass2 = 2.*eMass2 + 2.*(e1*e2 - dot);
+    Double_t maxMass = fMaxInvMass + fPreFilterMassMargin;
+    return mass2 <= maxMass*maxMass;
+}
+
 //_______________________________________________________________________________________________
 Bool_t AliHFENonPhotonicElectron::FilterCategory1Track(const AliVTrack * const track, Bool_t isAOD, Int_t binct){
     //
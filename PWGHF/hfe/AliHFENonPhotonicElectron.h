@@ -30,6 +30,7 @@ class AliKFVertex;
 class AliVEvent;
 class AliVParticle;
 class AliVTrack;
+class TArrayF;
 class THnSparse;
 class TClonesArray;
 class TList;
@@ -79,6 +80,8 @@ class AliHFENonPhotonicElectron : public TNamed {
   void  SetStudyRadius		(Bool_t studyRadius)	 	{ fStudyRadius		= studyRadius; };
   void  SetAlgorithmMA		(Bool_t algorithmMA)	 	{ fAlgorithmMA		= algorithmMA; };
   void  SetMassConstraint	(Bool_t MassConstraint)		{ fSetMassConstraint	= MassConstraint; };
+  void  SetPairPreFilter	(Bool_t usePreFilter = kTRUE, Double_t massMargin = 0.1, Double_t angleMargin = 0.2)
+                                { fUsePairPreFilter = usePreFilter; fPreFilterMassMargin = massMargin; fPreFilterAngleMargin = angleMargin; };
   void  SetITSMeanShift         (Double_t meanshift)            { fITSmeanShift = meanshift; }
   void  SetITSnSigmaHigh        (Double_t nSigmaHigh)           { fITSnSigmaHigh = nSigmaHigh; }
   void  SetITSnSigmaLow         (Double_t nSigmaLow)            { fITSnSigmaLow = nSigmaLow; }
@@ -132,6 +135,7 @@ class AliHFENonPhotonicElectron : public TNamed {
   Int_t    IsMotherOmega	(Int_t tr) const;
   Bool_t MakePairDCA(const AliVTrack *inclusive, const AliVTrack *associated, AliVEvent *vEvent, Bool_t isAOD, Double_t &invMass, Double_t &angle) const;
   Bool_t MakePairKF(const AliVTrack *inclusive, const AliVTrack *associated, AliKFVertex &primV, Double_t &invMass, Double_t &angle) const;
+  Bool_t PassPairPreFilter(const Double_t *p1, Int_t idex) const;
   Bool_t FilterCategory1Track(const AliVTrack * const track, Bool_t isAOD, Int_t binct);
   Bool_t FilterCategory2Track(const AliVTrack * const track, Bool_t isAOD);
 
@@ -156,6 +160,9 @@ class AliHFENonPhotonicElectron : public TNamed {
   Double_t                  fMaxOpening3D;                  // Limit opening 3D
   Double_t                  fMaxInvMass;                    // Limit invariant mass
   Bool_t                    fSetMassConstraint;             // Set mass constraint
+  Bool_t                    fUsePairPreFilter;              // Reject pairs with the analytic mass and opening angle before the pair fit
+  Double_t                  fPreFilterMassMargin;           // Margin on the invariant mass cut in the pre-filter
+  Double_t                  fPreFilterAngleMargin;          // Margin on the opening angle cut in the pre-filter
   Bool_t                    fSelectCategory1tracks;         // Category 1 tracks: Standard track cuts
   Bool_t                    fSelectCategory2tracks;         // Category 2 tracks: tracks below 300 MeV/c
   Double_t                  fITSmeanShift;                  // Shift of the mean in the ITS
@@ -164,6 +171,7 @@ class AliHFENonPhotonicElectron : public TNamed {
   Double_t                  fminPt;                         // min pT cut for the associated leg
   Double_t                  fEtaDalitzWeightFactor;         // Relative modification for the weighting factor for electrons from Eta Dalitz decays (default = 1);
   TArrayI                   *fArraytrack;                   //! list of associated tracks
+  TArrayF                   *fPoolKinematics;               //! px, py, pz, p of the associated tracks
   Int_t                     fCounterPoolBackground;         // number of associated electrons
   Int_t                     fnumberfound;                   // number of inclusive  electrons
   TList                     *fListOutput;                   // List of histos
@@ -187,7 +195,7 @@ class AliHFENonPhotonicElectron : public TNamed {
 
   AliHFENonPhotonicElectron(const AliHFENonPhotonicElectron &ref); 
 
-  ClassDef(AliHFENonPhotonicElectron, 5); //!example of analysis
+  ClassDef(AliHFENonPhotonicElectron, 6); //!example of analysis
 };
 
 #endif
@@ -46,7 +46,8 @@ AliHFEcontainer::AliHFEcontainer():
   fCorrelationMatrices(NULL),
   fVariables(NULL),
   fNVars(0),
-  fNEvents(0)
+  fNEvents(0),
+  fFillBufferSize(0)
 {
   //
   // Default constructor
@@ -60,7 +61,8 @@ AliHFEcontainer::AliHFEcontainer(const Char_t *name):
   fCorrelationMatrices(NULL),
   fVariables(NULL),
   fNVars(0),
-  fNEvents(0)
+  fNEvents(0),
+  fFillBufferSize(0)
 {
   //
   // Default constructor
@@ -76,7 +78,8 @@ AliHFEcontainer::AliHFEcontainer(const Char_t *name, UInt_t nVar):
   fCorrelationMatrices(NULL),
   fVariables(NULL),
   fNVars(0),
-  fNEvents(0)
+  fNEvents(0),
+  fFillBufferSize(0)
 {
   //
   // Constructor
@@ -94,7 +97,8 @@ AliHFEcontainer::AliHFEcontainer(const AliHFEcontainer &ref):
   fCorrelationMatrices(NULL),
   fVariables(NULL),
   fNVars(ref.fNVars),
-  fNEvents(ref.fNEvents)
+  fNEvents(ref.fNEvents),
+  fFillBufferSize(ref.fFillBufferSize)
 {
   //
   // Copy constructor
@@ -139,6 +143,7 @@ AliHFEcontainer &AliHFEcontainer::operator=(const AliHFEcontainer &ref){
   fContainers = new THashList();
   fCorrelationMatrices = NULL;
   fNVars = ref.fNVars;
+  fFillBufferSize = ref.fFillBufferSize;
   if(fNVars){
     fVariables = new TObjArray(fNVars);
     AliHFEvarInfo *vtmp = NULL;
@@ -258,6 +263,7 @@ void AliHFEcontainer::CreateContainer(const Char_t *name, const Char_t *title, U
     }
   }
   delete[] nBins;
+  if(fFillBufferSize) cont->SetFillBufferSize(fFillBufferSize);
   fContainers->Add(cont);
   AliInfo(Form("Container %s created with %d cut steps", name, nStep));
 }
@@ -317,6 +323,20 @@ THnSparseF *AliHFEcontainer::GetCorrelationMatrix(const Char_t *name) const{
 
 }
 
+//__________________________________________________________________
+void AliHFEcontainer::SetFillBufferSize(Int_t size){
+  //
+  // Buffer the fills of the correction framework containers (existing and
+  // created later), see AliCFGridSparse::SetFillBufferSize; 0 disables the buffering
+  //
+  fFillBufferSize = size;
+  AliCFContainer *cont = NULL;
+  for(Int_t ien = 0; ien < fContainers->GetEntries(); ien++){
+    cont = static_cast<AliCFContainer *>(fContainers->At(ien));
+    cont->SetFillBufferSize(size);
+  }
+}
+
 //__________________________________________________________________
 void AliHFEcontainer::FillCFContainer(const Char_t *name, UInt_t step, const Double_t * const content, Double_t weight) const {
   //
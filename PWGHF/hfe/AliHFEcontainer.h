@@ -73,6 +73,7 @@ class AliHFEcontainer : public TNamed{
     void MakeLogarithmicBinning(UInt_t var, UInt_t nBins, Double_t begin, Double_t end);
     void MakeUserDefinedBinning(UInt_t var, UInt_t nBins, const Double_t *binning);
     void Sumw2(const char *contname) const;
+    void SetFillBufferSize(Int_t size);
 
     virtual void Print(const Option_t * opt = NULL) const;
 
@@ -102,8 +103,9 @@ class AliHFEcontainer : public TNamed{
     TObjArray *fVariables;      // Variable Information
     UInt_t fNVars;              // Number of Variables
     Int_t fNEvents;             // Number of Events
+    Int_t fFillBufferSize;      //! Fill buffer size of the CF containers
 
-    ClassDef(AliHFEcontainer, 1)  // HFE Efficiency Container
+    ClassDef(AliHFEcontainer, 2)  // HFE Efficiency Container
 };
 
 //__________________________________________________________________
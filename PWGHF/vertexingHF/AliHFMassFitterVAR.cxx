@@ -79,7 +79,8 @@ AliHFMassFitter(),
   fRawYieldHelp(0),
   fpolbackdegreeTay(4),
   fpolbackdegreeTayHelp(-1),
-  fMassParticle(1.864)
+  fMassParticle(1.864),
+  fForceMinuitFitter(kTRUE)
 {
   // default constructor
 
@@ -112,7 +113,8 @@ AliHFMassFitterVAR::AliHFMassFitterVAR (const TH1F *histoToFit, Double_t minvalu
   fRawYieldHelp(0),
   fpolbackdegreeTay(4),
   fpolbackdegreeTayHelp(-1),
-  fMassParticle(1.864)
+  fMassParticle(1.864),
+  fForceMinuitFitter(kTRUE)
 {
   // standard constructor
 
@@ -165,7 +167,8 @@ AliHFMassFitterVAR::AliHFMassFitterVAR(const AliHFMassFitterVAR &mfit):
   fRawYieldHelp(mfit.fRawYieldHelp),
   fpolbackdegreeTay(mfit.fpolbackdegreeTay),
   fpolbackdegreeTayHelp(mfit.fpolbackdegreeTayHelp),
-  fMassParticle(mfit.fMassParticle)
+  fMassParticle(mfit.fMassParticle),
+  fForceMinuitFitter(mfit.fForceMinuitFitter)
 {
   //copy constructor
   fSignParNames=new TString[fNparSignal];
@@ -252,6 +255,7 @@ AliHFMassFitterVAR& AliHFMassFitterVAR::operator=(const AliHFMassFitterVAR &mfit
   fpolbackdegreeTayHelp=mfit.fpolbackdegreeTayHelp;
 
   fMassParticle=mfit.fMassParticle;
+  fForceMinuitFitter=mfit.fForceMinuitFitter;
 
   delete [] fSignParNames;
   delete [] fBackParNames;
@@ -793,7 +797,7 @@ Bool_t AliHFMassFitterVAR::MassFitter(Bool_t draw){
   // Main method of the class: performs the fit of the histogram
 
   //Set default fitter Minuit in order to use gMinuit in the contour plots    
-  TVirtualFitter::SetDefaultFitter("Minuit");
+  if(fForceMinuitFitter) TVirtualFitter::SetDefaultFitter("Minuit");
 
   Bool_t isBkgOnly=kFALSE;
   Double_t slope1=-1,slope2=1,slope3=1;
@@ -994,7 +998,7 @@ Bool_t AliHFMassFitterVAR::MassFitter(Bool_t draw){
 
   Int_t status;
   Printf("Fitting");
-  status = fhistoInvMass->Fit(massname.Data(),Form("R,%s,+,0",fFitOption.Data()));
+  status = fhistoInvMass->Fit(funcmass,Form("R,%s,+,0",fFitOption.Data()));
   if (status != 0){
     cout<<"Minuit returned "<<status<<endl;
     delete funcbkg;
@@ -1178,7 +1182,7 @@ Bool_t AliHFMassFitterVAR::RefitWithBkgOnly(Bool_t draw){
       fhistoInvMass->GetFunction(funcbkg->GetName())->SetBit(1<<9,kTRUE);
     }
   }
-  else status=fhistoInvMass->Fit(bkgname.Data(),"R,E,+,0");
+  else status=fhistoInvMass->Fit(funcbkg,"R,E,+,0");
   if (status != 0){
     ftypeOfFit4Sgn=typesSave;
     cout<<"Minuit returned "<<status<<endl;
@@ -104,6 +104,8 @@ class AliHFMassFitterVAR : public AliHFMassFitter {
   void     SetFixGaussianMean(Double_t mean=1.865,Bool_t fixpar=kTRUE){fFixParSignExternalValue[1]=fixpar;     fparSignFixExt[1]=mean;} 
   void     SetFixGaussianSigma(Double_t sigma=0.012, Bool_t fixpar=kTRUE){fFixParSignExternalValue[2]=fixpar;     fparSignFixExt[2]=sigma;} 
   void SetBackHighPolDegree(Int_t deg);
+  /// if kFALSE, MassFitter uses the current default minimizer instead of forcing TMinuit (needed for concurrent fits)
+  void     SetForceMinuitFitter(Bool_t opt=kTRUE){fForceMinuitFitter=opt;}
   Double_t BackFitFuncPolHelper(Double_t *x,Double_t *par);
   Bool_t PrepareHighPolFit(TF1 *fback);
   void SetParticlePdgMass(Double_t mass){fMassParticle=mass;}
@@ -163,6 +165,7 @@ class AliHFMassFitterVAR : public AliHFMassFitter {
   Int_t fpolbackdegreeTay; /// degree of polynomial expansion for back fit (option 6 for back)
   Int_t   fpolbackdegreeTayHelp; /// help variable
   Double_t fMassParticle;       /// pdg value of particle mass
+  Bool_t fForceMinuitFitter;    //!<! set TMinuit as default fitter in MassFitter
 /*   TH1F*     fhistoInvMass;     // histogram to fit */
 /*   Double_t  fminMass;          // lower mass limit */
 /*   Double_t  fmaxMass;          // upper mass limit */
@@ -22,6 +22,10 @@
 #include <TF1.h>
 #include <TLatex.h>
 #include <TFile.h>
+#include <TROOT.h>
+#include <Math/MinimizerOptions.h>
+#include <atomic>
+#include <thread>
 #include "AliHFMassFitter.h"
 #include "AliHFMassFitterVAR.h"
 #include "AliHFMultiTrials.h"
@@ -65,6 +69,7 @@ AliHFMultiTrials::AliHFMultiTrials() :
   fUseFixSigFixMean(kTRUE),
   fSaveBkgVal(kFALSE),
   fDrawIndividualFits(kFALSE),
+  fNumOfThreads(1),
   fHistoRawYieldDistAll(0x0),
   fHistoRawYieldTrialAll(0x0),
   fHistoSigmaTrialAll(0x0),
@@ -193,27 +198,25 @@ Bool_t AliHFMultiTrials::DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad){
   Bool_t hOK=CreateHistos();
   if(!hOK) return kFALSE;
 
-  Int_t itrial=0;
-  Int_t types=0;
-  Int_t itrialBC=0;
-  Int_t totTrials=fNumOfRebinSteps*fNumOfFirstBinSteps*fNumOfLowLimFitSteps*fNumOfUpLimFitSteps;
-
   fMinYieldGlob=999999.;
   fMaxYieldGlob=0.;
-  Float_t xnt[15];
 
+  // rebinned histograms, shared by all trials with the same rebin and first bin
+  std::vector<TH1F*> hRebinned(fNumOfRebinSteps*fNumOfFirstBinSteps,0x0);
+  for(Int_t ir=0; ir<fNumOfRebinSteps; ir++){
+    for(Int_t iFirstBin=1; iFirstBin<=fNumOfFirstBinSteps; iFirstBin++) {
+      Int_t firstUse=(fNumOfFirstBinSteps==1) ? -1 : iFirstBin;
+      hRebinned[ir*fNumOfFirstBinSteps+iFirstBin-1]=RebinHisto(hInvMassHisto,fRebinSteps[ir],firstUse);
+    }
+  }
+
+  // enumerate the trial grid in the order of the output
+  std::vector<TrialConfig> trials;
+  Int_t itrial=0;
   for(Int_t ir=0; ir<fNumOfRebinSteps; ir++){
-    Int_t rebin=fRebinSteps[ir];
     for(Int_t iFirstBin=1; iFirstBin<=fNumOfFirstBinSteps; iFirstBin++) {
-      TH1F* hRebinned=0x0;
-      if(fNumOfFirstBinSteps==1) hRebinned=RebinHisto(hInvMassHisto,rebin,-1);
-      else hRebinned=RebinHisto(hInvMassHisto,rebin,iFirstBin);
       for(Int_t iMinMass=0; iMinMass<fNumOfLowLimFitSteps; iMinMass++){
-        Double_t minMassForFit=fLowLimFitSteps[iMinMass];
-        Double_t hmin=TMath::Max(minMassForFit,hRebinned->GetBinLowEdge(2));
         for(Int_t iMaxMass=0; iMaxMass<fNumOfUpLimFitSteps; iMaxMass++){
-          Double_t maxMassForFit=fUpLimFitSteps[iMaxMass];
-          Double_t hmax=TMath::Min(maxMassForFit,hRebinned->GetBinLowEdge(hRebinned->GetNbinsX()));
           ++itrial;
           for(Int_t typeb=0; typeb<kNBkgFuncCases; typeb++){
             if(typeb==kExpoBkg && !fUseExpoBkg) continue;
@@ -231,208 +234,285 @@ Bool_t AliHFMultiTrials::DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad){
               if (igs==kFreeSigFreeMean  && !fUseFreeS) continue;
               if (igs==kFixSigFreeMean  && !fUseFixSigFreeMean) continue;
               if (igs==kFixSigFixMean   && !fUseFixSigFixMean) continue;
-              Int_t theCase=igs*kNBkgFuncCases+typeb;
-              Int_t globBin=itrial+theCase*totTrials;
-              for(Int_t j=0; j<15; j++) xnt[j]=0.;
-
-              Bool_t mustDeleteFitter = kTRUE;
-              AliHFMassFitterVAR*  fitter=0x0;
-              //if D0 Reflection
-              if(fhTemplRefl){
-                fitter=new AliHFMassFitterVAR(hRebinned,hmin,hmax,1,typeb,2);
-                fitter->SetTemplateReflections(fhTemplRefl);
-                fitter->SetFixReflOverS(fFixRefloS,kTRUE);
-              }
-              else {
-                if(typeb<=kPol2Bkg){
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,typeb,types);
-                }else if(typeb==kPowBkg){
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,4,types);
-                }else if(typeb==kPowTimesExpoBkg){
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,5,types);
-                }else{
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,6,types);
-                  if(typeb==kPol3Bkg) fitter->SetBackHighPolDegree(3);
-                  if(typeb==kPol4Bkg) fitter->SetBackHighPolDegree(4);
-                  if(typeb==kPol5Bkg) fitter->SetBackHighPolDegree(5);
-                }
-                fitter->SetReflectionSigmaFactor(0);
-              }
-              if(fFitOption==1) fitter->SetUseChi2Fit();
-              fitter->SetInitialGaussianMean(fMassD);
-              fitter->SetInitialGaussianSigma(fSigmaGausMC);
-              xnt[0]=rebin;
-              xnt[1]=iFirstBin;
-              xnt[2]=minMassForFit;
-              xnt[3]=maxMassForFit;
-              xnt[4]=typeb;
-              xnt[6]=0;
-              if(igs==kFixSigFreeMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
-                xnt[5]=1;
-              }else if(igs==kFixSigUpFreeMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC*(1.+fSigmaMCVariation),kTRUE);
-                xnt[5]=2;
-              }else if(igs==kFixSigDownFreeMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC*(1.-fSigmaMCVariation),kTRUE);
-                xnt[5]=3;
-              }else if(igs==kFreeSigFreeMean){
-                xnt[5]=0;
-              }else if(igs==kFixSigFixMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
-                fitter->SetFixGaussianMean(fMassD,kTRUE);
-                xnt[5]=1;
-                xnt[6]=1;
-              }else if(igs==kFreeSigFixMean){
-                fitter->SetFixGaussianMean(fMassD,kTRUE);
-                xnt[5]=0;
-                xnt[6]=1;
-              }
-              Bool_t out=kFALSE;
-              Double_t chisq=-1.;
-              Double_t sigma=0.;
-              Double_t esigma=0.;
-              Double_t pos=.0;
-              Double_t epos=.0;
-              Double_t ry=.0;
-              Double_t ery=.0;
-              Double_t significance=0.;
-              Double_t erSignif=0.;
-              Double_t bkg=0.;
-              Double_t erbkg=0.;
-              Double_t bkgBEdge=0;
-              Double_t erbkgBEdge=0;
-              TF1* fB1=0x0;
-              if(typeb<kNBkgFuncCases){
-                printf("****** START FIT OF HISTO %s WITH REBIN %d FIRST BIN %d MASS RANGE %f-%f BACKGROUND FIT FUNCTION=%d CONFIG SIGMA/MEAN=%d\n",hInvMassHisto->GetName(),rebin,iFirstBin,minMassForFit,maxMassForFit,typeb,igs);
-                out=fitter->MassFitter(0);
-                chisq=fitter->GetReducedChiSquare();
-                fitter->Significance(fnSigmaForBkgEval,significance,erSignif);
-                sigma=fitter->GetSigma();
-                pos=fitter->GetMean();
-                esigma=fitter->GetSigmaUncertainty();
-                if(esigma<0.00001) esigma=0.0001;
-                epos=fitter->GetMeanUncertainty();
-                if(epos<0.00001) epos=0.0001;
-                ry=fitter->GetRawYield();
-                ery=fitter->GetRawYieldError();
-                fB1=fitter->GetBackgroundFullRangeFunc();
-                fitter->Background(fnSigmaForBkgEval,bkg,erbkg);
-                Double_t minval = hInvMassHisto->GetXaxis()->GetBinLowEdge(hInvMassHisto->FindBin(pos-fnSigmaForBkgEval*sigma));
-                Double_t maxval = hInvMassHisto->GetXaxis()->GetBinUpEdge(hInvMassHisto->FindBin(pos+fnSigmaForBkgEval*sigma));
-                fitter->Background(minval,maxval,bkgBEdge,erbkgBEdge);
-                if(out && fDrawIndividualFits && thePad){
-                  thePad->Clear();
-                  fitter->DrawHere(thePad, fnSigmaForBkgEval);
-                  fMassFitters.push_back(fitter);
-                  mustDeleteFitter = kFALSE;
-                  for (auto format : fInvMassFitSaveAsFormats) {
-                    thePad->SaveAs(Form("FitOutput_%s_Trial%d.%s",hInvMassHisto->GetName(),globBin, format.c_str()));
-                  }
-                }
-              }
-              // else{
-              //   out=DoFitWithPol3Bkg(hRebinned,hmin,hmax,igs);
-              //   if(out && thePad){
-              // 	thePad->Clear();
-              // 	hRebinned->Draw();
-              // 	TF1* fSB=(TF1*)hRebinned->GetListOfFunctions()->FindObject("fSB");
-              // 	fB1=new TF1("fB1","[0]+[1]*x+[2]*x*x+[3]*x*x*x",hmin,hmax);
-              // 	for(Int_t j=0; j<4; j++) fB1->SetParameter(j,fSB->GetParameter(3+j));
-              // 	fB1->SetLineColor(2);
-              // 	fB1->Draw("same");
-              // 	fSB->SetLineColor(4);
-              // 	fSB->Draw("same");
-              // 	thePad->Update();
-              // 	chisq=fSB->GetChisquare()/fSB->GetNDF();;
-              // 	sigma=fSB->GetParameter(2);
-              // 	esigma=fSB->GetParError(2);
-              // 	if(esigma<0.00001) esigma=0.0001;
-              // 	pos=fSB->GetParameter(1);
-              // 	epos=fSB->GetParError(1);
-              // 	if(epos<0.00001) epos=0.0001;
-              // 	ry=fSB->GetParameter(0)/hRebinned->GetBinWidth(1);
-              // 	ery=fSB->GetParError(0)/hRebinned->GetBinWidth(1);
-              //   }
-              // }
-              xnt[7]=chisq;
-              if(out && chisq>0. && sigma>0.5*fSigmaGausMC && sigma<2.0*fSigmaGausMC){
-                xnt[8]=significance;
-                xnt[9]=pos;
-                xnt[10]=epos;
-                xnt[11]=sigma;
-                xnt[12]=esigma;
-                xnt[13]=ry;
-                xnt[14]=ery;
-                fHistoRawYieldDistAll->Fill(ry);
-                fHistoRawYieldTrialAll->SetBinContent(globBin,ry);
-                fHistoRawYieldTrialAll->SetBinError(globBin,ery);
-                fHistoSigmaTrialAll->SetBinContent(globBin,sigma);
-                fHistoSigmaTrialAll->SetBinError(globBin,esigma);
-                fHistoMeanTrialAll->SetBinContent(globBin,pos);
-                fHistoMeanTrialAll->SetBinError(globBin,epos);
-                fHistoChi2TrialAll->SetBinContent(globBin,chisq);
-                fHistoChi2TrialAll->SetBinError(globBin,0.00001);
-                fHistoSignifTrialAll->SetBinContent(globBin,significance);
-                fHistoSignifTrialAll->SetBinError(globBin,erSignif);
-                if(fSaveBkgVal) {
-                  fHistoBkgTrialAll->SetBinContent(globBin,bkg);
-                  fHistoBkgTrialAll->SetBinError(globBin,erbkg);
-                  fHistoBkgInBinEdgesTrialAll->SetBinContent(globBin,bkgBEdge);
-                  fHistoBkgInBinEdgesTrialAll->SetBinError(globBin,erbkgBEdge);
-                }
-
-                if(ry<fMinYieldGlob) fMinYieldGlob=ry;
-                if(ry>fMaxYieldGlob) fMaxYieldGlob=ry;
-                fHistoRawYieldDist[theCase]->Fill(ry);
-                fHistoRawYieldTrial[theCase]->SetBinContent(itrial,ry);
-                fHistoRawYieldTrial[theCase]->SetBinError(itrial,ery);
-                fHistoSigmaTrial[theCase]->SetBinContent(itrial,sigma);
-                fHistoSigmaTrial[theCase]->SetBinError(itrial,esigma);
-                fHistoMeanTrial[theCase]->SetBinContent(itrial,pos);
-                fHistoMeanTrial[theCase]->SetBinError(itrial,epos);
-                fHistoChi2Trial[theCase]->SetBinContent(itrial,chisq);
-                fHistoChi2Trial[theCase]->SetBinError(itrial,0.00001);
-                fHistoSignifTrial[theCase]->SetBinContent(itrial,significance);
-                fHistoSignifTrial[theCase]->SetBinError(itrial,erSignif);
-                if(fSaveBkgVal) {
-                  fHistoBkgTrial[theCase]->SetBinContent(itrial,bkg);
-                  fHistoBkgTrial[theCase]->SetBinError(itrial,erbkg);
-                  fHistoBkgInBinEdgesTrial[theCase]->SetBinContent(itrial,bkgBEdge);
-                  fHistoBkgInBinEdgesTrial[theCase]->SetBinError(itrial,erbkgBEdge);
-                }
-
-                for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
-                  Double_t minMassBC=fMassD-fnSigmaBinCSteps[iStepBC]*sigma;
-                  Double_t maxMassBC=fMassD+fnSigmaBinCSteps[iStepBC]*sigma;
-                  if(minMassBC>minMassForFit &&
-                      maxMassBC<maxMassForFit &&
-                      minMassBC>(hRebinned->GetXaxis()->GetXmin()) &&
-                      maxMassBC<(hRebinned->GetXaxis()->GetXmax())){
-                    Double_t cnts,ecnts;
-                    BinCount(hRebinned,fB1,1,minMassBC,maxMassBC,cnts,ecnts);
-                    ++itrialBC;
-                    fHistoRawYieldDistBinCAll->Fill(cnts);
-                    fHistoRawYieldTrialBinCAll->SetBinContent(globBin,iStepBC+1,cnts);
-                    fHistoRawYieldTrialBinCAll->SetBinError(globBin,iStepBC+1,ecnts);
-                    fHistoRawYieldTrialBinC[theCase]->SetBinContent(itrial,iStepBC+1,cnts);
-                    fHistoRawYieldTrialBinC[theCase]->SetBinError(itrial,iStepBC+1,ecnts);
-                    fHistoRawYieldDistBinC[theCase]->Fill(cnts);
-                  }
-                }
-              }
-              if (mustDeleteFitter) delete fitter;
-              fNtupleMultiTrials->Fill(xnt);
+              TrialConfig conf;
+              conf.fRebinIndex=ir;
+              conf.fFirstBin=iFirstBin;
+              conf.fMinMassIndex=iMinMass;
+              conf.fMaxMassIndex=iMaxMass;
+              conf.fBkgFunc=typeb;
+              conf.fFitConf=igs;
+              conf.fTrial=itrial;
+              trials.push_back(conf);
             }
           }
         }
       }
-      delete hRebinned;
     }
   }
+
+  Bool_t keepFitters=(fDrawIndividualFits && thePad);
+  Int_t nThreads=fNumOfThreads;
+  if(nThreads<=0) nThreads=std::thread::hardware_concurrency();
+  if(nThreads>1 && trials.size()>1){
+    // fits run concurrently, output is filled afterwards in the order of the trial grid
+    std::vector<TrialResult> results(trials.size());
+    RunTrialsParallel(trials,hRebinned,hInvMassHisto,keepFitters,results);
+    for(size_t jt=0; jt<trials.size(); jt++) FillTrialOutput(trials[jt],results[jt],hInvMassHisto,thePad);
+  }else{
+    for(size_t jt=0; jt<trials.size(); jt++){
+      const TrialConfig& conf=trials[jt];
+      TrialResult res;
+      FitTrial(conf,hRebinned[conf.fRebinIndex*fNumOfFirstBinSteps+conf.fFirstBin-1],hInvMassHisto,keepFitters,kTRUE,res);
+      FillTrialOutput(conf,res,hInvMassHisto,thePad);
+    }
+  }
+
+  for(auto h : hRebinned) delete h;
   return kTRUE;
 }
 
+//________________________________________________________________________
+void AliHFMultiTrials::RunTrialsParallel(const std::vector<TrialConfig>& trials, const std::vector<TH1F*>& hRebinned, TH1D* hInvMassHisto, Bool_t keepFitters, std::vector<TrialResult>& results) const{
+  // run the fits of the trial grid in a pool of worker threads
+  // each trial has its own fitter (and clone of the histogram), TMinuit is
+  // replaced by Minuit2 which does not rely on global state
+
+  ROOT::EnableThreadSafety();
+  Bool_t addDirStatus=TH1::AddDirectoryStatus();
+  TH1::AddDirectory(kFALSE);
+  std::string defMinimizer=ROOT::Math::MinimizerOptions::DefaultMinimizerType();
+  ROOT::Math::MinimizerOptions::SetDefaultMinimizer("Minuit2");
+
+  Int_t nThreads=fNumOfThreads;
+  if(nThreads<=0) nThreads=std::thread::hardware_concurrency();
+  if(nThreads>(Int_t)trials.size()) nThreads=trials.size();
+  printf("AliHFMultiTrials: running %d trials on %d threads\n",(Int_t)trials.size(),nThreads);
+
+  std::atomic<size_t> nextTrial(0);
+  auto worker=[&](){
+    for(size_t jt=nextTrial++; jt<trials.size(); jt=nextTrial++){
+      const TrialConfig& conf=trials[jt];
+      FitTrial(conf,hRebinned[conf.fRebinIndex*fNumOfFirstBinSteps+conf.fFirstBin-1],hInvMassHisto,keepFitters,kFALSE,results[jt]);
+    }
+  };
+  std::vector<std::thread> pool;
+  for(Int_t ith=0; ith<nThreads; ith++) pool.emplace_back(worker);
+  for(auto& th : pool) th.join();
+
+  ROOT::Math::MinimizerOptions::SetDefaultMinimizer(defMinimizer.c_str());
+  TH1::AddDirectory(addDirStatus);
+}
+
+//________________________________________________________________________
+void AliHFMultiTrials::FitTrial(const TrialConfig& conf, TH1F* hRebinned, TH1D* hInvMassHisto, Bool_t keepFitter, Bool_t forceMinuit, TrialResult& res) const{
+  // fit of one trial, results are stored in res
+  // the fitter is kept in res only if the fit converged and keepFitter is set
+
+  Int_t types=0;
+  Int_t rebin=fRebinSteps[conf.fRebinIndex];
+  Int_t typeb=conf.fBkgFunc;
+  Int_t igs=conf.fFitConf;
+  Double_t minMassForFit=fLowLimFitSteps[conf.fMinMassIndex];
+  Double_t maxMassForFit=fUpLimFitSteps[conf.fMaxMassIndex];
+  Double_t hmin=TMath::Max(minMassForFit,hRebinned->GetBinLowEdge(2));
+  Double_t hmax=TMath::Min(maxMassForFit,hRebinned->GetBinLowEdge(hRebinned->GetNbinsX()));
+
+  res.fOK=kFALSE;
+  res.fChi2=-1.;
+  res.fSigma=0.;
+  res.fErrSigma=0.;
+  res.fMean=0.;
+  res.fErrMean=0.;
+  res.fRawYield=0.;
+  res.fErrRawYield=0.;
+  res.fSignif=0.;
+  res.fErrSignif=0.;
+  res.fBkg=0.;
+  res.fErrBkg=0.;
+  res.fBkgBEdge=0.;
+  res.fErrBkgBEdge=0.;
+  res.fBinCountOK.assign(fNumOfnSigmaBinCSteps,kFALSE);
+  res.fBinCount.assign(fNumOfnSigmaBinCSteps,0.);
+  res.fErrBinCount.assign(fNumOfnSigmaBinCSteps,0.);
+  res.fFitter=0x0;
+
+  AliHFMassFitterVAR*  fitter=0x0;
+  //if D0 Reflection
+  if(fhTemplRefl){
+    fitter=new AliHFMassFitterVAR(hRebinned,hmin,hmax,1,typeb,2);
+    fitter->SetTemplateReflections(fhTemplRefl);
+    fitter->SetFixReflOverS(fFixRefloS,kTRUE);
+  }
+  else {
+    if(typeb<=kPol2Bkg){
+      fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,typeb,types);
+    }else if(typeb==kPowBkg){
+      fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,4,types);
+    }else if(typeb==kPowTimesExpoBkg){
+      fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,5,types);
+    }else{
+      fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,6,types);
+      if(typeb==kPol3Bkg) fitter->SetBackHighPolDegree(3);
+      if(typeb==kPol4Bkg) fitter->SetBackHighPolDegree(4);
+      if(typeb==kPol5Bkg) fitter->SetBackHighPolDegree(5);
+    }
+    fitter->SetReflectionSigmaFactor(0);
+  }
+  fitter->SetForceMinuitFitter(forceMinuit);
+  if(fFitOption==1) fitter->SetUseChi2Fit();
+  fitter->SetInitialGaussianMean(fMassD);
+  fitter->SetInitialGaussianSigma(fSigmaGausMC);
+  if(igs==kFixSigFreeMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
+  }else if(igs==kFixSigUpFreeMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC*(1.+fSigmaMCVariation),kTRUE);
+  }else if(igs==kFixSigDownFreeMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC*(1.-fSigmaMCVariation),kTRUE);
+  }else if(igs==kFixSigFixMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
+    fitter->SetFixGaussianMean(fMassD,kTRUE);
+  }else if(igs==kFreeSigFixMean){
+    fitter->SetFixGaussianMean(fMassD,kTRUE);
+  }
+
+  printf("****** START FIT OF HISTO %s WITH REBIN %d FIRST BIN %d MASS RANGE %f-%f BACKGROUND FIT FUNCTION=%d CONFIG SIGMA/MEAN=%d\n",hInvMassHisto->GetName(),rebin,conf.fFirstBin,minMassForFit,maxMassForFit,typeb,igs);
+  Bool_t out=fitter->MassFitter(0);
+  res.fOK=out;
+  res.fChi2=fitter->GetReducedChiSquare();
+  fitter->Significance(fnSigmaForBkgEval,res.fSignif,res.fErrSignif);
+  res.fSigma=fitter->GetSigma();
+  res.fMean=fitter->GetMean();
+  res.fErrSigma=fitter->GetSigmaUncertainty();
+  if(res.fErrSigma<0.00001) res.fErrSigma=0.0001;
+  res.fErrMean=fitter->GetMeanUncertainty();
+  if(res.fErrMean<0.00001) res.fErrMean=0.0001;
+  res.fRawYield=fitter->GetRawYield();
+  res.fErrRawYield=fitter->GetRawYieldError();
+  TF1* fB1=fitter->GetBackgroundFullRangeFunc();
+  fitter->Background(fnSigmaForBkgEval,res.fBkg,res.fErrBkg);
+  Double_t minval = hInvMassHisto->GetXaxis()->GetBinLowEdge(hInvMassHisto->FindBin(res.fMean-fnSigmaForBkgEval*res.fSigma));
+  Double_t maxval = hInvMassHisto->GetXaxis()->GetBinUpEdge(hInvMassHisto->FindBin(res.fMean+fnSigmaForBkgEval*res.fSigma));
+  fitter->Background(minval,maxval,res.fBkgBEdge,res.fErrBkgBEdge);
+
+  if(out && res.fChi2>0. && res.fSigma>0.5*fSigmaGausMC && res.fSigma<2.0*fSigmaGausMC){
+    for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
+      Double_t minMassBC=fMassD-fnSigmaBinCSteps[iStepBC]*res.fSigma;
+      Double_t maxMassBC=fMassD+fnSigmaBinCSteps[iStepBC]*res.fSigma;
+      if(minMassBC>minMassForFit &&
+          maxMassBC<maxMassForFit &&
+          minMassBC>(hRebinned->GetXaxis()->GetXmin()) &&
+          maxMassBC<(hRebinned->GetXaxis()->GetXmax())){
+        BinCount(hRebinned,fB1,1,minMassBC,maxMassBC,res.fBinCount[iStepBC],res.fErrBinCount[iStepBC]);
+        res.fBinCountOK[iStepBC]=kTRUE;
+      }
+    }
+  }
+
+  if(out && keepFitter) res.fFitter=fitter;
+  else delete fitter;
+}
+
+//________________________________________________________________________
+void AliHFMultiTrials::FillTrialOutput(const TrialConfig& conf, TrialResult& res, TH1D* hInvMassHisto, TPad* thePad){
+  // fill ntuple and histograms with the result of one trial
+
+  Int_t totTrials=fNumOfRebinSteps*fNumOfFirstBinSteps*fNumOfLowLimFitSteps*fNumOfUpLimFitSteps;
+  Int_t itrial=conf.fTrial;
+  Int_t igs=conf.fFitConf;
+  Int_t theCase=igs*kNBkgFuncCases+conf.fBkgFunc;
+  Int_t globBin=itrial+theCase*totTrials;
+
+  Float_t xnt[15];
+  for(Int_t j=0; j<15; j++) xnt[j]=0.;
+  xnt[0]=fRebinSteps[conf.fRebinIndex];
+  xnt[1]=conf.fFirstBin;
+  xnt[2]=fLowLimFitSteps[conf.fMinMassIndex];
+  xnt[3]=fUpLimFitSteps[conf.fMaxMassIndex];
+  xnt[4]=conf.fBkgFunc;
+  xnt[6]=0;
+  if(igs==kFixSigFreeMean || igs==kFixSigFixMean) xnt[5]=1;
+  else if(igs==kFixSigUpFreeMean) xnt[5]=2;
+  else if(igs==kFixSigDownFreeMean) xnt[5]=3;
+  else xnt[5]=0;
+  if(igs==kFixSigFixMean || igs==kFreeSigFixMean) xnt[6]=1;
+
+  if(res.fFitter && fDrawIndividualFits && thePad){
+    thePad->Clear();
+    res.fFitter->DrawHere(thePad, fnSigmaForBkgEval);
+    fMassFitters.push_back(res.fFitter);
+    res.fFitter=0x0;
+    for (auto format : fInvMassFitSaveAsFormats) {
+      thePad->SaveAs(Form("FitOutput_%s_Trial%d.%s",hInvMassHisto->GetName(),globBin, format.c_str()));
+    }
+  }
+  delete res.fFitter;
+  res.fFitter=0x0;
+
+  Double_t chisq=res.fChi2;
+  Double_t sigma=res.fSigma;
+  Double_t ry=res.fRawYield;
+  xnt[7]=chisq;
+  if(res.fOK && chisq>0. && sigma>0.5*fSigmaGausMC && sigma<2.0*fSigmaGausMC){
+    xnt[8]=res.fSignif;
+    xnt[9]=res.fMean;
+    xnt[10]=res.fErrMean;
+    xnt[11]=sigma;
+    xnt[12]=res.fErrSigma;
+    xnt[13]=ry;
+    xnt[14]=res.fErrRawYield;
+    fHistoRawYieldDistAll->Fill(ry);
+    fHistoRawYieldTrialAll->SetBinContent(globBin,ry);
+    fHistoRawYieldTrialAll->SetBinError(globBin,res.fErrRawYield);
+    fHistoSigmaTrialAll->SetBinContent(globBin,sigma);
+    fHistoSigmaTrialAll->SetBinError(globBin,res.fErrSigma);
+    fHistoMeanTrialAll->SetBinContent(globBin,res.fMean);
+    fHistoMeanTrialAll->SetBinError(globBin,res.fErrMean);
+    fHistoChi2TrialAll->SetBinContent(globBin,chisq);
+    fHistoChi2TrialAll->SetBinError(globBin,0.00001);
+    fHistoSignifTrialAll->SetBinContent(globBin,res.fSignif);
+    fHistoSignifTrialAll->SetBinError(globBin,res.fErrSignif);
+    if(fSaveBkgVal) {
+      fHistoBkgTrialAll->SetBinContent(globBin,res.fBkg);
+      fHistoBkgTrialAll->SetBinError(globBin,res.fErrBkg);
+      fHistoBkgInBinEdgesTrialAll->SetBinContent(globBin,res.fBkgBEdge);
+      fHistoBkgInBinEdgesTrialAll->SetBinError(globBin,res.fErrBkgBEdge);
+    }
+
+    if(ry<fMinYieldGlob) fMinYieldGlob=ry;
+    if(ry>fMaxYieldGlob) fMaxYieldGlob=ry;
+    fHistoRawYieldDist[theCase]->Fill(ry);
+    fHistoRawYieldTrial[theCase]->SetBinContent(itrial,ry);
+    fHistoRawYieldTrial[theCase]->SetBinError(itrial,res.fErrRawYield);
+    fHistoSigmaTrial[theCase]->SetBinContent(itrial,sigma);
+    fHistoSigmaTrial[theCase]->SetBinError(itrial,res.fErrSigma);
+    fHistoMeanTrial[theCase]->SetBinContent(itrial,res.fMean);
+    fHistoMeanTrial[theCase]->SetBinError(itrial,res.fErrMean);
+    fHistoChi2Trial[theCase]->SetBinContent(itrial,chisq);
+    fHistoChi2Trial[theCase]->SetBinError(itrial,0.00001);
+    fHistoSignifTrial[theCase]->SetBinContent(itrial,res.fSignif);
+    fHistoSignifTrial[theCase]->SetBinError(itrial,res.fErrSignif);
+    if(fSaveBkgVal) {
+      fHistoBkgTrial[theCase]->SetBinContent(itrial,res.fBkg);
+      fHistoBkgTrial[theCase]->SetBinError(itrial,res.fErrBkg);
+      fHistoBkgInBinEdgesTrial[theCase]->SetBinContent(itrial,res.fBkgBEdge);
+      fHistoBkgInBinEdgesTrial[theCase]->SetBinError(itrial,res.fErrBkgBEdge);
+    }
+
+    for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
+      if(!res.fBinCountOK[iStepBC]) continue;
+      Double_t cnts=res.fBinCount[iStepBC];
+      Double_t ecnts=res.fErrBinCount[iStepBC];
+      fHistoRawYieldDistBinCAll->Fill(cnts);
+      fHistoRawYieldTrialBinCAll->SetBinContent(globBin,iStepBC+1,cnts);
+      fHistoRawYieldTrialBinCAll->SetBinError(globBin,iStepBC+1,ecnts);
+      fHistoRawYieldTrialBinC[theCase]->SetBinContent(itrial,iStepBC+1,cnts);
+      fHistoRawYieldTrialBinC[theCase]->SetBinError(itrial,iStepBC+1,ecnts);
+      fHistoRawYieldDistBinC[theCase]->Fill(cnts);
+    }
+  }
+  fNtupleMultiTrials->Fill(xnt);
+}
+
 //________________________________________________________________________
 void AliHFMultiTrials::SaveToRoot(TString fileName, TString option) const{
   // save histos in a root file for further analysis
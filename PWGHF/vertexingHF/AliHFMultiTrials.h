@@ -85,6 +85,7 @@ class AliHFMultiTrials : public TNamed {
   void SetSaveBkgValue(Bool_t opt=kTRUE, Double_t nsigma=3) {fSaveBkgVal=opt; fnSigmaForBkgEval=nsigma;}
 
   void SetDrawIndividualFits(Bool_t opt=kTRUE){fDrawIndividualFits=opt;}
+  void SetNumberOfThreads(Int_t nth=0){fNumOfThreads=nth;}
 
   Bool_t DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad=0x0);
   void SaveToRoot(TString fileName, TString option="recreate") const;
@@ -102,8 +103,43 @@ class AliHFMultiTrials : public TNamed {
 
  private:
 
+  /// one point of the trial grid
+  struct TrialConfig {
+    Int_t fRebinIndex;   /// index in fRebinSteps
+    Int_t fFirstBin;     /// first bin used for rebin
+    Int_t fMinMassIndex; /// index in fLowLimFitSteps
+    Int_t fMaxMassIndex; /// index in fUpLimFitSteps
+    Int_t fBkgFunc;      /// background function (EBkgFuncCases)
+    Int_t fFitConf;      /// sigma/mean configuration (EFitParamCases)
+    Int_t fTrial;        /// trial number of the rebin/range combination (1-based)
+  };
+  /// outcome of the fit of one trial
+  struct TrialResult {
+    Bool_t fOK;
+    Double_t fChi2;
+    Double_t fSigma;
+    Double_t fErrSigma;
+    Double_t fMean;
+    Double_t fErrMean;
+    Double_t fRawYield;
+    Double_t fErrRawYield;
+    Double_t fSignif;
+    Double_t fErrSignif;
+    Double_t fBkg;
+    Double_t fErrBkg;
+    Double_t fBkgBEdge;
+    Double_t fErrBkgBEdge;
+    std::vector<Bool_t> fBinCountOK;
+    std::vector<Double_t> fBinCount;
+    std::vector<Double_t> fErrBinCount;
+    AliHFMassFitterVAR* fFitter;
+  };
+
   Bool_t CreateHistos();
   TH1F* RebinHisto(TH1D* hOrig, Int_t reb, Int_t firstUse) const;
+  void FitTrial(const TrialConfig& conf, TH1F* hRebinned, TH1D* hInvMassHisto, Bool_t keepFitter, Bool_t forceMinuit, TrialResult& res) const;
+  void FillTrialOutput(const TrialConfig& conf, TrialResult& res, TH1D* hInvMassHisto, TPad* thePad);
+  void RunTrialsParallel(const std::vector<TrialConfig>& trials, const std::vector<TH1F*>& hRebinned, TH1D* hInvMassHisto, Bool_t keepFitters, std::vector<TrialResult>& results) const;
   void BinCount(TH1F* h, TF1* fB, Int_t rebin, Double_t minMass, Double_t maxMass, Double_t& count, Double_t& ecount) const;
   Bool_t DoFitWithPol3Bkg(TH1F* histoToFit, Double_t  hmin, Double_t  hmax,
 			  Int_t theCase);
@@ -146,6 +182,7 @@ class AliHFMultiTrials : public TNamed {
   Bool_t fSaveBkgVal;		/// switch for saving bkg values in nsigma
 
   Bool_t fDrawIndividualFits; /// flag for drawing fits
+  Int_t fNumOfThreads;        /// number of threads for the fits (1=serial, <=0 hardware concurrency)
 
   TH1F* fHistoRawYieldDistAll;  /// histo with yield from all trials
   TH1F* fHistoRawYieldTrialAll; /// histo with yield from all trials
@@ -180,7 +217,7 @@ class AliHFMultiTrials : public TNamed {
   std::vector<AliHFMassFitterVAR*> fMassFitters; //!<! Mass fitters
 
   /// \cond CLASSIMP
-  ClassDef(AliHFMultiTrials,5); /// class for multiple trials of invariant mass fit
+  ClassDef(AliHFMultiTrials,6); /// class for multiple trials of invariant mass fit
   /// \endcond
 };
 
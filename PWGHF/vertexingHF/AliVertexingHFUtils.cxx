@@ -26,6 +26,7 @@
 #include "AliAODMCHeader.h"
 #include "AliGenEventHeader.h"
 #include "AliAODMCParticle.h"
+#include "AliMCGenealogyIndex.h"
 #include "AliAODRecoDecayHF.h"
 #include "AliVertexingHFUtils.h"
 
@@ -535,28 +536,18 @@ void AliVertexingHFUtils::GetTrackPrimaryGenerator(AliAODTrack *track,AliAODMCHe
 
   Int_t lab=TMath::Abs(track->GetLabel());
   nameGen=GetGenerator(lab,header);
-  
-  //  Int_t countControl=0;
-  
-  while(nameGen.IsWhitespace()){
-    AliAODMCParticle *mcpart= (AliAODMCParticle*)arrayMC->At(lab);
-    if(!mcpart){
-      printf("AliVertexingHFUtils::IsTrackInjected - BREAK: No valid AliAODMCParticle at label %i\n",lab);
-      break;
-    }
-    Int_t mother = mcpart->GetMother();
-    if(mother<0){
-      printf("AliVertexingHFUtils::IsTrackInjected - BREAK: Reached primary particle without valid mother\n");
-      break;
-    }
-    lab=mother;
-    nameGen=GetGenerator(mother,header);
-    // countControl++;
-    // if(countControl>=10){ // 10 = arbitrary number; protection from infinite loops
-    //   printf("AliVertexingHFUtils::IsTrackInjected - BREAK: Protection from infinite loop active\n");
-    //   break;
-    // }
+  if(!nameGen.IsWhitespace()) return;
+
+  // particles produced in the transport are outside the generator ranges:
+  // take the generator of the first particle of the mother chain, resolved once per event
+  AliMCGenealogyIndex* genealogy = AliMCGenealogyIndex::Instance();
+  genealogy->Update(arrayMC);
+  Int_t ancestor = genealogy->GetUltimateAncestor(lab);
+  if(ancestor<0){
+    printf("AliVertexingHFUtils::IsTrackInjected - BREAK: No valid AliAODMCParticle at label %i\n",lab);
+    return;
   }
+  nameGen=GetGenerator(ancestor,header);
   
   return;
 }
@@ -604,65 +595,23 @@ Bool_t AliVertexingHFUtils::HasCascadeCandidateAnyDaughInjected(AliAODRecoCascad
 //____________________________________________________________________________
 Int_t AliVertexingHFUtils::CheckOrigin(AliMCEvent* mcEvent, TParticle *mcPart, Bool_t searchUpToQuark){
   /// checking whether the mother of the particles come from a charm or a bottom quark
+  /// the mother chains are resolved once per event by the shared AliMCGenealogyIndex
 
-  Int_t pdgGranma = 0;
-  Int_t mother = 0;
-  mother = mcPart->GetFirstMother();
-  Int_t istep = 0;
-  Int_t abspdgGranma =0;
-  Bool_t isFromB=kFALSE;
-  Bool_t isQuarkFound=kFALSE;
-  while (mother >0 ){
-    istep++;
-    TParticle* mcGranma = mcEvent->Particle(mother);
-    if (mcGranma){
-      pdgGranma = mcGranma->GetPdgCode();
-      abspdgGranma = TMath::Abs(pdgGranma);
-      if ((abspdgGranma > 500 && abspdgGranma < 600) || (abspdgGranma > 5000 && abspdgGranma < 6000)){
-	isFromB=kTRUE;
-      }
-      if(abspdgGranma==4 || abspdgGranma==5) isQuarkFound=kTRUE;
-      mother = mcGranma->GetFirstMother();
-    }else{
-      printf("CheckOrigin: Failed casting the mother particle!");
-      break;
-    }
-  }
-  if(searchUpToQuark && !isQuarkFound) return 0;
-  if(isFromB) return 5;
-  else return 4;
+  AliMCGenealogyIndex* genealogy = AliMCGenealogyIndex::Instance();
+  genealogy->Update(mcEvent);
+  Int_t mother = mcPart->GetFirstMother();
+  UInt_t chainFlags = mother>0 ? genealogy->GetChainFlags(mother) : 0;
+  return AliMCGenealogyIndex::QuarkOrigin(chainFlags,searchUpToQuark);
 
 }
 //____________________________________________________________________________
 Int_t AliVertexingHFUtils::CheckOrigin(TClonesArray* arrayMC, AliAODMCParticle *mcPart, Bool_t searchUpToQuark){
   /// checking whether the mother of the particles come from a charm or a bottom quark
+  /// the mother chains are resolved once per event by the shared AliMCGenealogyIndex
 
-  Int_t pdgGranma = 0;
-  Int_t mother = 0;
-  mother = mcPart->GetMother();
-  Int_t istep = 0;
-  Int_t abspdgGranma =0;
-  Bool_t isFromB=kFALSE;
-  Bool_t isQuarkFound=kFALSE;
-  while (mother >0 ){
-    istep++;
-    AliAODMCParticle* mcGranma = dynamic_cast<AliAODMCParticle*>(arrayMC->At(mother));
-    if (mcGranma){
-      pdgGranma = mcGranma->GetPdgCode();
-      abspdgGranma = TMath::Abs(pdgGranma);
-      if ((abspdgGranma > 500 && abspdgGranma < 600) || (abspdgGranma > 5000 && abspdgGranma < 6000)){
-	isFromB=kTRUE;
-      }
-      if(abspdgGranma==4 || abspdgGranma==5) isQuarkFound=kTRUE;
-      mother = mcGranma->GetMother();
-    }else{
-      printf("AliVertexingHFUtils::CheckOrigin: Failed casting the mother particle!");
-      break;
-    }
-  }
-  if(searchUpToQuark && !isQuarkFound) return 0;
-  if(isFromB) return 5;
-  else return 4;
+  AliMCGenealogyIndex* genealogy = AliMCGenealogyIndex::Instance();
+  genealogy->Update(arrayMC);
+  return genealogy->GetQuarkOrigin(mcPart->GetLabel(),searchUpToQuark);
 
 }
 //____________________________________________________________________________
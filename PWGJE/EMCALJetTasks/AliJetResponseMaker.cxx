@@ -19,7 +19,10 @@
 
 #include "AliJetResponseMaker.h"
 
+#include <algorithm>
+
 #include <TClonesArray.h>
+#include <TMath.h>
 #include <TH2F.h>
 #include <THnSparse.h>
 
@@ -38,6 +41,70 @@
 
 ClassImp(AliJetResponseMaker)
 
+namespace {
+  // eta-phi cells of a list of jets, used to look for the closest jets in the geometrical matching
+  class AliJetResponseMakerGrid {
+  public:
+    AliJetResponseMakerGrid(const std::vector<AliEmcalJet*> &jets) :
+      fEtaMin(0), fEtaMax(0), fEtaStep(0.2), fPhiStep(TMath::TwoPi()/32), fNEta(1), fNPhi(32), fCells()
+    {
+      for (UInt_t i = 0; i < jets.size(); i++) {
+        if (i == 0 || jets[i]->Eta() < fEtaMin) fEtaMin = jets[i]->Eta();
+        if (i == 0 || jets[i]->Eta() > fEtaMax) fEtaMax = jets[i]->Eta();
+      }
+      fNEta = TMath::Min(Int_t((fEtaMax - fEtaMin) / fEtaStep) + 1, 1000);
+
+      fCells.resize(fNEta * fNPhi);
+      for (UInt_t i = 0; i < jets.size(); i++) {
+        fCells[EtaCell(jets[i]->Eta()) * fNPhi + PhiCell(jets[i]->Phi())].push_back(i);
+      }
+    }
+
+    // larger than the distance between (eta, phi) and any jet of the list
+    Double_t GetMaxDistance(Double_t eta) const
+    {
+      Double_t deta = TMath::Max(TMath::Abs(eta - fEtaMin), TMath::Abs(eta - fEtaMax));
+      return TMath::Sqrt(TMath::Pi() * TMath::Pi() + deta * deta) + fEtaStep;
+    }
+
+    // indices of the jets in the cells overlapping the square of half-size r around (eta, phi), sorted
+    void GetCandidates(Double_t eta, Double_t phi, Double_t r, std::vector<Int_t> &list) const
+    {
+      list.clear();
+      Int_t row0 = TMath::Max(EtaCell(eta - r) - 1, 0);
+      Int_t row1 = TMath::Min(EtaCell(eta + r) + 1, fNEta - 1);
+      Int_t col0 = Int_t(TMath::Floor((phi - r) / fPhiStep)) - 1;
+      Int_t ncol = TMath::Min(Int_t(TMath::Floor((phi + r) / fPhiStep)) + 1 - col0 + 1, fNPhi);
+      for (Int_t row = row0; row <= row1; row++) {
+        for (Int_t icol = 0; icol < ncol; icol++) {
+          const std::vector<Int_t> &cell = fCells[row * fNPhi + Wrap(col0 + icol)];
+          list.insert(list.end(), cell.begin(), cell.end());
+        }
+      }
+      std::sort(list.begin(), list.end());
+    }
+
+  private:
+    Int_t EtaCell(Double_t eta) const
+    {
+      Double_t x = (eta - fEtaMin) / fEtaStep;
+      if (x < 0) return 0;
+      if (x >= fNEta) return fNEta - 1;
+      return Int_t(x);
+    }
+    Int_t PhiCell(Double_t phi) const { return Wrap(Int_t(TMath::Floor(phi / fPhiStep))); }
+    Int_t Wrap(Int_t col) const { col %= fNPhi; return col < 0 ? col + fNPhi : col; }
+
+    Double_t fEtaMin;
+    Double_t fEtaMax;
+    Double_t fEtaStep;
+    Double_t fPhiStep;
+    Int_t    fNEta;
+    Int_t    fNPhi;
+    std::vector<std::vector<Int_t> > fCells;
+  };
+}
+
 //________________________________________________________________________
 AliJetResponseMaker::AliJetResponseMaker() : 
   AliAnalysisTaskEmcalJet("AliJetResponseMaker", kTRUE),
@@ -59,6 +126,13 @@ AliJetResponseMaker::AliJetResponseMaker() :
   fPtgAxis(0),
   fDBCAxis(0),
   fJetRelativeEPAngle(0),
+  fJet1Lookup(0),
+  fJet1LookupType(kNoMatching),
+  fJet1TrackLookup(),
+  fJet1ClusterLookup(),
+  fJet1ConstPt(),
+  fJet1ConstFrac(),
+  fJet1NonMCPt(),
   fIsJet1Rho(kFALSE),
   fIsJet2Rho(kFALSE),
   fHistRejectionReason1(0),
@@ -148,6 +222,13 @@ AliJetResponseMaker::AliJetResponseMaker(const char *name) :
   fPtgAxis(0),
   fDBCAxis(0),
   fJetRelativeEPAngle(0),
+  fJet1Lookup(0),
+  fJet1LookupType(kNoMatching),
+  fJet1TrackLookup(),
+  fJet1ClusterLookup(),
+  fJet1ConstPt(),
+  fJet1ConstFrac(),
+  fJet1NonMCPt(),
   fIsJet1Rho(kFALSE),
   fIsJet2Rho(kFALSE),
   fHistRejectionReason1(0),
@@ -1426,9 +1507,31 @@ void AliJetResponseMaker::DoJetLoop()
   AliEmcalJet* jet1 = 0;
   AliEmcalJet* jet2 = 0;
 
+  fJet1Lookup = 0;
+
   jets2->ResetCurrentID();
   while ((jet2 = jets2->GetNextJet())) jet2->ResetMatching();
 
+  if (fMatching == kGeometrical) {
+    std::vector<AliEmcalJet*> list1;
+    std::vector<AliEmcalJet*> list2;
+
+    jets1->ResetCurrentID();
+    while ((jet1 = jets1->GetNextJet())) {
+      jet1->ResetMatching();
+
+      if (jet1->MCPt() < fMinJetMCPt) continue;
+
+      list1.push_back(jet1);
+    }
+
+    jets2->ResetCurrentID();
+    while ((jet2 = jets2->GetNextJet())) list2.push_back(jet2);
+
+    DoGeometricalJetLoop(list1, list2);
+    return;
+  }
+
   jets1->ResetCurrentID();
   while ((jet1 = jets1->GetNextJet())) {
     jet1->ResetMatching();
@@ -1442,6 +1545,56 @@ void AliJetResponseMaker::DoJetLoop()
   } // jet1 loop
 }
 
+//________________________________________________________________________
+void AliJetResponseMaker::DoGeometricalJetLoop(const std::vector<AliEmcalJet*> &jets1, const std::vector<AliEmcalJet*> &jets2)
+{
+  // Geometrical matching without comparing all the pairs of jets.
+  // For each jet, the jets of the other collection are looked for in eta-phi cells
+  // in a growing square around it, until the two closest ones are found.
+  // The closest and second closest jets are the same as with the full jet loop:
+  // the jets are considered in the same order and only jets farther than
+  // the second closest one are skipped.
+
+  AliJetResponseMakerGrid grid1(jets1);
+  AliJetResponseMakerGrid grid2(jets2);
+
+  std::vector<Int_t> candidates;
+  std::vector<Double_t> distances;
+
+  for (Int_t iset = 0; iset < 2; iset++) {
+    const std::vector<AliEmcalJet*> &jets   = iset == 0 ? jets1 : jets2;
+    const std::vector<AliEmcalJet*> &others = iset == 0 ? jets2 : jets1;
+    const AliJetResponseMakerGrid   &grid   = iset == 0 ? grid2 : grid1;
+
+    for (UInt_t ijet = 0; ijet < jets.size(); ijet++) {
+      AliEmcalJet *jet = jets[ijet];
+      Double_t rmax = grid.GetMaxDistance(jet->Eta());
+      Double_t r = 0.2;
+
+      while (kTRUE) {
+        grid.GetCandidates(jet->Eta(), jet->Phi(), r, candidates);
+
+        distances.resize(candidates.size());
+        Int_t n = 0;
+        for (UInt_t i = 0; i < candidates.size(); i++) {
+          AliEmcalJet *other = others[candidates[i]];
+          // same argument order as GetGeometricalMatchingLevel()
+          distances[i] = iset == 0 ? jet->DeltaR(other) : other->DeltaR(jet);
+          if (distances[i] <= r) n++;
+        }
+
+        if (n >= 2 || r >= rmax) break;
+        r *= 2;
+      }
+
+      for (UInt_t i = 0; i < candidates.size(); i++) {
+        if (distances[i] > r) continue;
+        UpdateClosestJets(jet, others[candidates[i]], distances[i]);
+      }
+    }
+  }
+}
+
 //________________________________________________________________________
 void AliJetResponseMaker::GetGeometricalMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d) const
 {
@@ -1456,122 +1609,127 @@ void AliJetResponseMaker::GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet
 
   if (!jets1 || !jets1->GetArray() || !jets2 || !jets2->GetArray()) return;
 
-  // tracks1 just serves as a proxy to ensure that tracks are in jets1
-  AliParticleContainer *tracks1   = jets1->GetParticleContainer();
-  // tracks2 is used to retrieve MC labels associated with tracks in the container
-  // NOTE: For multiple containers, this would need to be generalized!
-  AliParticleContainer *tracks2   = jets2->GetParticleContainer();
+  // the MC particle index of each jet 1 constituent is computed once per jet 1
+  PrepareJet1Constituents(jet1, kMCLabel);
 
   // d1 and d2 represent the matching level: 0 = maximum level of matching, 1 = the two jets are completely unrelated
   d1 = jet1->Pt();
   d2 = jet2->Pt();
   Double_t totalPt1 = d1; // the total pt of the reconstructed jet will be cleaned from the background
 
-  // remove completely tracks that are not MC particles (label == 0)
-  if (tracks1 && tracks1->GetArray()) {
-    for (Int_t iTrack = 0; iTrack < jet1->GetNumberOfTracks(); iTrack++) {
-      AliVParticle *track = jet1->Track(iTrack);
-      if (!track) {
-        AliWarning(Form("Could not find track %d!", iTrack));
-        continue;
-      }
-
-      Int_t MClabel = TMath::Abs(track->GetLabel());
-      MClabel -= fMCLabelShift;
-      if (MClabel != 0) continue;
-
-      // this is not a MC particle; remove it completely
-      AliDebug(3,Form("Track %d (pT = %f) is not a MC particle (MClabel = %d)!",iTrack,track->Pt(),MClabel));
-      totalPt1 -= track->Pt();
-      d1 -= track->Pt();
-    }
+  // remove completely tracks and clusters that are not MC particles (label == 0)
+  for (UInt_t i = 0; i < fJet1NonMCPt.size(); i++) {
+    totalPt1 -= fJet1NonMCPt[i];
+    d1 -= fJet1NonMCPt[i];
   }
 
-  // remove completely clusters that are not MC particles (label == 0)
-  if (fUseCellsToMatch && fCaloCells) { 
-    for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
-      AliVCluster *clus = jet1->Cluster(iClus);
-      if (!clus) {
-        AliWarning(Form("Could not find cluster %d!", iClus));
-        continue;
-      }
-      AliTLorentzVector part;
-      clus->GetMomentum(part, fVertex);
-
-      for (Int_t iCell = 0; iCell < clus->GetNCells(); iCell++) {
-        Int_t cellId = clus->GetCellAbsId(iCell);
-        Double_t cellFrac = clus->GetCellAmplitudeFraction(iCell);
+  for (Int_t iTrack2 = 0; iTrack2 < jet2->GetNumberOfTracks(); iTrack2++) {
+    Bool_t track2Found = kFALSE;
+    Int_t index2 = jet2->TrackAt(iTrack2);
 
-        Int_t MClabel = TMath::Abs(fCaloCells->GetCellMCLabel(cellId));
-        MClabel -= fMCLabelShift;
-        if (MClabel != 0) continue;
+    // common particles among the tracks, then the clusters (or cells) of jet 1
+    std::vector<std::pair<Int_t,Int_t> >::const_iterator it = std::lower_bound(fJet1TrackLookup.begin(), fJet1TrackLookup.end(), std::make_pair(index2, -1));
+    for (; it != fJet1TrackLookup.end() && it->first == index2; ++it) {
+      // found common particle
+      d1 -= fJet1ConstPt[it->second];
 
-        // this is not a MC particle; remove it completely
-        AliDebug(3,Form("Cell %d (frac = %f) is not a MC particle (MClabel = %d)!",iCell,cellFrac,MClabel));
-        totalPt1 -= part.Pt() * cellFrac;
-        d1 -= part.Pt() * cellFrac;
+      if (!track2Found) { // only if it is not already found (charged particles are most likely found among tracks)
+        AliVParticle *MCpart = jet2->Track(iTrack2);
+        AliDebug(3,Form("Constituent %d of jet 1 is associated with the MC particle %d (pT = %f, eta = %f, phi = %f)!",
+            it->second,index2,MCpart->Pt(),MCpart->Eta(),MCpart->Phi()));
+        d2 -= MCpart->Pt() * fJet1ConstFrac[it->second];
       }
+
+      track2Found = kTRUE;
     }
   }
-  else {
-    for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
-      AliVCluster *clus = jet1->Cluster(iClus);
-      if (!clus) {
-        AliWarning(Form("Could not find cluster %d!", iClus));
-        continue;
-      }
-      TLorentzVector part;
-      clus->GetMomentum(part, fVertex);
 
-      Int_t MClabel = TMath::Abs(clus->GetLabel());
-      MClabel -= fMCLabelShift;
-      if (MClabel != 0) continue;
+  if (d1 < 0)
+    d1 = 0;
+
+  if (d2 < 0)
+    d2 = 0;
+
+  if (totalPt1 < 1)
+    d1 = -1;
+  else
+    d1 /= totalPt1;
+
+  if (jet2->Pt() < 1)
+    d2 = -1;
+  else
+    d2 /= jet2->Pt();
+}
 
-      // this is not a MC particle; remove it completely
-      AliDebug(3,Form("Cluster %d (pT = %f) is not a MC particle (MClabel = %d)!",iClus,part.Pt(),MClabel));
-      totalPt1 -= part.Pt();
-      d1 -= part.Pt();
+//________________________________________________________________________
+void AliJetResponseMaker::PrepareJet1Constituents(AliEmcalJet *jet1, MatchingType matching) const
+{
+  // Build the sorted constituent lookup of jet 1 used by the constituent matching,
+  // so that the constituents of each jet 2 are looked up instead of compared
+  // with all the constituents of jet 1. The lookup is kept until jet 1 changes.
+  //  - kSameCollections: (track index, track number) and (cluster index, cluster number)
+  //  - kMCLabel: (MC particle index, constituent number), with the tracks first and then
+  //    the clusters (or cells), and the pt of the constituents that are not MC particles
+
+  if (jet1 == fJet1Lookup && matching == fJet1LookupType) return;
+
+  fJet1Lookup = jet1;
+  fJet1LookupType = matching;
+  fJet1TrackLookup.clear();
+  fJet1ClusterLookup.clear();
+  fJet1ConstPt.clear();
+  fJet1ConstFrac.clear();
+  fJet1NonMCPt.clear();
+
+  if (matching == kSameCollections) {
+    for (Int_t iTrack1 = 0; iTrack1 < jet1->GetNumberOfTracks(); iTrack1++) {
+      fJet1TrackLookup.push_back(std::make_pair(jet1->TrackAt(iTrack1), iTrack1));
+    }
+    for (Int_t iClus1 = 0; iClus1 < jet1->GetNumberOfClusters(); iClus1++) {
+      fJet1ClusterLookup.push_back(std::make_pair(jet1->ClusterAt(iClus1), iClus1));
     }
   }
+  else if (matching == kMCLabel) {
+    AliJetContainer *jets1 = static_cast<AliJetContainer*>(fJetCollArray.At(0));
+    AliJetContainer *jets2 = static_cast<AliJetContainer*>(fJetCollArray.At(1));
 
-  for (Int_t iTrack2 = 0; iTrack2 < jet2->GetNumberOfTracks(); iTrack2++) {
-    Bool_t track2Found = kFALSE;
-    Int_t index2 = jet2->TrackAt(iTrack2);
+    // tracks1 just serves as a proxy to ensure that tracks are in jets1
+    AliParticleContainer *tracks1   = jets1->GetParticleContainer();
+    // tracks2 is used to retrieve MC labels associated with tracks in the container
+    // NOTE: For multiple containers, this would need to be generalized!
+    AliParticleContainer *tracks2   = jets2->GetParticleContainer();
 
-    // now look for common particles in the track array
     for (Int_t iTrack = 0; iTrack < jet1->GetNumberOfTracks(); iTrack++) {
       AliVParticle *track = jet1->Track(iTrack);
       if (!track) {
         AliWarning(Form("Could not find track %d!", iTrack));
         continue;
       }
+
       Int_t MClabel = TMath::Abs(track->GetLabel());
-      MClabel -= fMCLabelShift;	  
-      if (MClabel <= 0) continue;
+      MClabel -= fMCLabelShift;
 
-      Int_t index = -1;
-      index = tracks2->GetIndexFromLabel(MClabel);
-      if (index < 0) {
-        AliDebug(2,Form("Track %d (pT = %f) does not have an associated MC particle (MClabel = %d)!",iTrack,track->Pt(),MClabel));
+      if (MClabel == 0) {
+        // this is not a MC particle; remove it completely
+        if (tracks1 && tracks1->GetArray()) {
+          AliDebug(3,Form("Track %d (pT = %f) is not a MC particle (MClabel = %d)!",iTrack,track->Pt(),MClabel));
+          fJet1NonMCPt.push_back(track->Pt());
+        }
         continue;
       }
+      if (MClabel < 0) continue;
 
-      if (index2 != index) continue;
-
-      // found common particle
-      d1 -= track->Pt();
-
-      if (!track2Found) {
-        AliVParticle *MCpart = jet2->Track(iTrack2);
-        AliDebug(3,Form("Track %d (pT = %f, eta = %f, phi = %f) is associated with the MC particle %d (pT = %f, eta = %f, phi = %f)!",
-            iTrack,track->Pt(),track->Eta(),track->Phi(),MClabel,MCpart->Pt(),MCpart->Eta(),MCpart->Phi()));
-        d2 -= MCpart->Pt();
+      Int_t index = tracks2->GetIndexFromLabel(MClabel);
+      if (index < 0) {
+        AliDebug(2,Form("Track %d (pT = %f) does not have an associated MC particle (MClabel = %d)!",iTrack,track->Pt(),MClabel));
+        continue;
       }
 
-      track2Found = kTRUE;
+      fJet1TrackLookup.push_back(std::make_pair(index, Int_t(fJet1ConstPt.size())));
+      fJet1ConstPt.push_back(track->Pt());
+      fJet1ConstFrac.push_back(1.);
     }
 
-    // now look for common particles in the cluster array
     if (fUseCellsToMatch && fCaloCells) { // if the cell colection is available, look for cells with a matched MC particle
       for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
         AliVCluster *clus = jet1->Cluster(iClus);
@@ -1588,28 +1746,24 @@ void AliJetResponseMaker::GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet
 
           Int_t MClabel = TMath::Abs(fCaloCells->GetCellMCLabel(cellId));
           MClabel -= fMCLabelShift;
-          if (MClabel <= 0) continue;
 
-          Int_t index1 = -1;
-          index1 = tracks2->GetIndexFromLabel(MClabel);
-          if (index1 < 0) {
-            AliDebug(3,Form("Cell %d (frac = %f) does not have an associated MC particle (MClabel = %d)!",iCell,cellFrac,MClabel));
+          if (MClabel == 0) {
+            // this is not a MC particle; remove it completely
+            AliDebug(3,Form("Cell %d (frac = %f) is not a MC particle (MClabel = %d)!",iCell,cellFrac,MClabel));
+            fJet1NonMCPt.push_back(part.Pt() * cellFrac);
             continue;
           }
+          if (MClabel < 0) continue;
 
-          if (index2 != index1) continue;
-
-          // found common particle
-          d1 -= part.Pt() * cellFrac;
-
-          if (!track2Found) { // only if it is not already found among charged tracks (charged particles are most likely already found)
-            AliVParticle *MCpart = jet2->Track(iTrack2);
-            AliDebug(3,Form("Cell %d belonging to cluster %d (pT = %f, eta = %f, phi = %f) is associated with the MC particle %d (pT = %f, eta = %f, phi = %f)!",
-                iCell,iClus,part.Pt(),part.Eta(),part.Phi_0_2pi(),MClabel,MCpart->Pt(),MCpart->Eta(),MCpart->Phi()));
-            d2 -= MCpart->Pt() * cellFrac;
+          Int_t index1 = tracks2->GetIndexFromLabel(MClabel);
+          if (index1 < 0) {
+            AliDebug(3,Form("Cell %d (frac = %f) does not have an associated MC particle (MClabel = %d)!",iCell,cellFrac,MClabel));
+            continue;
           }
 
-          track2Found = kTRUE;
+          fJet1TrackLookup.push_back(std::make_pair(index1, Int_t(fJet1ConstPt.size())));
+          fJet1ConstPt.push_back(part.Pt() * cellFrac);
+          fJet1ConstFrac.push_back(cellFrac);
         }
       }
     }
@@ -1625,49 +1779,30 @@ void AliJetResponseMaker::GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet
 
         Int_t MClabel = TMath::Abs(clus->GetLabel());
         MClabel -= fMCLabelShift;
-        if (MClabel <= 0) continue;
 
-        Int_t index = -1;
-        index = tracks2->GetIndexFromLabel(MClabel);
+        if (MClabel == 0) {
+          // this is not a MC particle; remove it completely
+          AliDebug(3,Form("Cluster %d (pT = %f) is not a MC particle (MClabel = %d)!",iClus,part.Pt(),MClabel));
+          fJet1NonMCPt.push_back(part.Pt());
+          continue;
+        }
+        if (MClabel < 0) continue;
 
+        Int_t index = tracks2->GetIndexFromLabel(MClabel);
         if (index < 0) {
           AliDebug(3,Form("Cluster %d (pT = %f) does not have an associated MC particle (MClabel = %d)!",iClus,part.Pt(),MClabel));
           continue;
         }
 
-        if (index2 != index) continue;
-
-        // found common particle
-        d1 -= part.Pt();
-
-        if (!track2Found) { // only if it is not already found among charged tracks (charged particles are most likely already found)
-          AliVParticle *MCpart = jet2->Track(iTrack2);
-          AliDebug(3,Form("Cluster %d (pT = %f, eta = %f, phi = %f) is associated with the MC particle %d (pT = %f, eta = %f, phi = %f)!",
-              iClus,part.Pt(),part.Eta(),part.Phi_0_2pi(),MClabel,MCpart->Pt(),MCpart->Eta(),MCpart->Phi()));
-
-          d2 -= MCpart->Pt();
-        }
-
-        track2Found = kTRUE;
+        fJet1TrackLookup.push_back(std::make_pair(index, Int_t(fJet1ConstPt.size())));
+        fJet1ConstPt.push_back(part.Pt());
+        fJet1ConstFrac.push_back(1.);
       }
     }
   }
 
-  if (d1 < 0)
-    d1 = 0;
-
-  if (d2 < 0)
-    d2 = 0;
-
-  if (totalPt1 < 1)
-    d1 = -1;
-  else
-    d1 /= totalPt1;
-
-  if (jet2->Pt() < 1)
-    d2 = -1;
-  else
-    d2 /= jet2->Pt();
+  std::sort(fJet1TrackLookup.begin(), fJet1TrackLookup.end());
+  std::sort(fJet1ClusterLookup.begin(), fJet1ClusterLookup.end());
 }
 
 //________________________________________________________________________
@@ -1688,28 +1823,32 @@ void AliJetResponseMaker::GetSameCollectionsMatchingLevel(AliEmcalJet *jet1, Ali
   d1 = jet1->Pt();
   d2 = jet2->Pt();
 
+  // the constituent indices of jet 1 are sorted once per jet 1
+  PrepareJet1Constituents(jet1, kSameCollections);
+
   if (tracks1 && tracks2) {
 
     for (Int_t iTrack2 = 0; iTrack2 < jet2->GetNumberOfTracks(); iTrack2++) {
       Int_t index2 = jet2->TrackAt(iTrack2);
-      for (Int_t iTrack1 = 0; iTrack1 < jet1->GetNumberOfTracks(); iTrack1++) {
-        Int_t index1 = jet1->TrackAt(iTrack1);
-        if (index2 == index1) { // found common particle
-          AliVParticle *part1 = jet1->Track(iTrack1);
-          if (!part1) {
-            AliWarning(Form("Could not find track %d!", index1));
-            continue;
-          }
-          AliVParticle *part2 = jet2->Track(iTrack2);
-          if (!part2) {
-            AliWarning(Form("Could not find track %d!", index2));
-            continue;
-          }
-
-          d1 -= part1->Pt();
-          d2 -= part2->Pt();
-          break;
+      std::vector<std::pair<Int_t,Int_t> >::const_iterator it = std::lower_bound(fJet1TrackLookup.begin(), fJet1TrackLookup.end(), std::make_pair(index2, -1));
+      for (; it != fJet1TrackLookup.end() && it->first == index2; ++it) {
+        Int_t index1 = it->first;
+        Int_t iTrack1 = it->second;
+        // found common particle
+        AliVParticle *part1 = jet1->Track(iTrack1);
+        if (!part1) {
+          AliWarning(Form("Could not find track %d!", index1));
+          continue;
+        }
+        AliVParticle *part2 = jet2->Track(iTrack2);
+        if (!part2) {
+          AliWarning(Form("Could not find track %d!", index2));
+          continue;
         }
+
+        d1 -= part1->Pt();
+        d2 -= part2->Pt();
+        break;
       }
     }
 
@@ -1822,27 +1961,28 @@ void AliJetResponseMaker::GetSameCollectionsMatchingLevel(AliEmcalJet *jet1, Ali
     else {
       for (Int_t iClus2 = 0; iClus2 < jet2->GetNumberOfClusters(); iClus2++) {
         Int_t index2 = jet2->ClusterAt(iClus2);
-        for (Int_t iClus1 = 0; iClus1 < jet1->GetNumberOfClusters(); iClus1++) {
-          Int_t index1 = jet1->ClusterAt(iClus1);
-          if (index2 == index1) { // found common particle
-            AliVCluster *clus1 = jet1->Cluster(iClus1);
-            if (!clus1) {
-              AliWarning(Form("Could not find cluster %d!", index1));
-              continue;
-            }
-            AliVCluster *clus2 =  jet2->Cluster(iClus2);
-            if (!clus2) {
-              AliWarning(Form("Could not find cluster %d!", index2));
-              continue;
-            }
-            TLorentzVector part1, part2;
-            clus1->GetMomentum(part1, fVertex);
-            clus2->GetMomentum(part2, fVertex);
-
-            d1 -= part1.Pt();
-            d2 -= part2.Pt();
-            break;
+        std::vector<std::pair<Int_t,Int_t> >::const_iterator it = std::lower_bound(fJet1ClusterLookup.begin(), fJet1ClusterLookup.end(), std::make_pair(index2, -1));
+        for (; it != fJet1ClusterLookup.end() && it->first == index2; ++it) {
+          Int_t index1 = it->first;
+          Int_t iClus1 = it->second;
+          // found common particle
+          AliVCluster *clus1 = jet1->Cluster(iClus1);
+          if (!clus1) {
+            AliWarning(Form("Could not find cluster %d!", index1));
+            continue;
+          }
+          AliVCluster *clus2 =  jet2->Cluster(iClus2);
+          if (!clus2) {
+            AliWarning(Form("Could not find cluster %d!", index2));
+            continue;
           }
+          TLorentzVector part1, part2;
+          clus1->GetMomentum(part1, fVertex);
+          clus2->GetMomentum(part2, fVertex);
+
+          d1 -= part1.Pt();
+          d2 -= part2.Pt();
+          break;
         }
       }
     }
@@ -1886,26 +2026,22 @@ void AliJetResponseMaker::SetMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2,
     ;
   }
 
-  if (d1 >= 0) {
+  if (d1 >= 0) UpdateClosestJets(jet1, jet2, d1);
 
-    if (d1 < jet1->ClosestJetDistance()) {
-      jet1->SetSecondClosestJet(jet1->ClosestJet(), jet1->ClosestJetDistance());
-      jet1->SetClosestJet(jet2, d1);
-    }
-    else if (d1 < jet1->SecondClosestJetDistance()) {
-      jet1->SetSecondClosestJet(jet2, d1);
-    }
-  }
+  if (d2 >= 0) UpdateClosestJets(jet2, jet1, d2);
+}
 
-  if (d2 >= 0) {
+//________________________________________________________________________
+void AliJetResponseMaker::UpdateClosestJets(AliEmcalJet *jet, AliEmcalJet *other, Double_t d) const
+{
+  // Update the closest and second closest jets of jet with other at distance d.
 
-    if (d2 < jet2->ClosestJetDistance()) {
-      jet2->SetSecondClosestJet(jet2->ClosestJet(), jet2->ClosestJetDistance());
-      jet2->SetClosestJet(jet1, d2);
-    }
-    else if (d2 < jet2->SecondClosestJetDistance()) {
-      jet2->SetSecondClosestJet(jet1, d2);
-    }
+  if (d < jet->ClosestJetDistance()) {
+    jet->SetSecondClosestJet(jet->ClosestJet(), jet->ClosestJetDistance());
+    jet->SetClosestJet(other, d);
+  }
+  else if (d < jet->SecondClosestJetDistance()) {
+    jet->SetSecondClosestJet(other, d);
   }
 }
 
@@ -1922,6 +2058,8 @@ Bool_t AliJetResponseMaker::FillHistograms()
   AliEmcalJet* jet1 = 0;  
   AliEmcalJet* jet2 = 0;
 
+  fJet1Lookup = 0;
+
   jets2->ResetCurrentID();
   while ((jet2 = jets2->GetNextJet())) {
 
@@ -24,6 +24,9 @@ class TH2;
 class THnSparse;
 class AliNamedArrayI;
 
+#include <vector>
+#include <utility>
+
 #include "AliEmcalJet.h"
 #include "AliAnalysisTaskEmcalJet.h"
 #include "AliEmcalEmbeddingQA.h"
@@ -93,10 +96,13 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
  protected:
   void                        ExecOnce();
   void                        DoJetLoop();
+  void                        DoGeometricalJetLoop(const std::vector<AliEmcalJet*> &jets1, const std::vector<AliEmcalJet*> &jets2);
   Bool_t                      FillHistograms();
   Bool_t                      Run();
   Bool_t                      DoJetMatching();
   void                        SetMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, MatchingType matching);
+  void                        UpdateClosestJets(AliEmcalJet *jet, AliEmcalJet *other, Double_t d) const;
+  void                        PrepareJet1Constituents(AliEmcalJet *jet1, MatchingType matching) const;
   void                        GetGeometricalMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d) const;
   void                        GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d1, Double_t &d2) const;
   void                        GetSameCollectionsMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2, Double_t &d1, Double_t &d2) const;
@@ -125,6 +131,14 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   Int_t                       fDBCAxis;                                // add DBC (number of soft dropped branches) axis in matching THnSparse (default=0)
   Int_t                       fJetRelativeEPAngle;                     ///< add jet angle relative to the EP in matching THnSparse (default=0)
 
+  mutable AliEmcalJet        *fJet1Lookup;                             //!jet 1 for which the constituent lookup below was built
+  mutable MatchingType        fJet1LookupType;                         //!matching type for which the constituent lookup was built
+  mutable std::vector<std::pair<Int_t,Int_t> > fJet1TrackLookup;       //!sorted (track index or MC particle index, constituent) of jet 1
+  mutable std::vector<std::pair<Int_t,Int_t> > fJet1ClusterLookup;     //!sorted (cluster index, constituent) of jet 1
+  mutable std::vector<Double_t> fJet1ConstPt;                          //!pt of each jet 1 constituent associated with a MC particle
+  mutable std::vector<Double_t> fJet1ConstFrac;                        //!fraction of the MC particle pt for each jet 1 constituent
+  mutable std::vector<Double_t> fJet1NonMCPt;                          //!pt of the jet 1 constituents that are not MC particles
+
   Bool_t                      fIsJet1Rho;                              //!whether the jet1 collection has to be average subtracted
   Bool_t                      fIsJet2Rho;                              //!whether the jet2 collection has to be average subtracted
 
@@ -204,6 +218,6 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   AliJetResponseMaker(const AliJetResponseMaker&);            // not implemented
   AliJetResponseMaker &operator=(const AliJetResponseMaker&); // not implemented
 
-  ClassDef(AliJetResponseMaker, 29) // Jet response matrix producing task
+  ClassDef(AliJetResponseMaker, 30) // Jet response matrix producing task
 };
 #endif
@@ -50,6 +50,7 @@
 #include "TFile.h"
 #include "TMatrixD.h"
 #include "TRandom3.h"
+#include "TROOT.h"
 
 #include "AliHeader.h"  
 #include "AliGenEventHeader.h"  
@@ -114,6 +115,13 @@ ClassImp(AliAnalysisTaskFilteredTree)
   , fLowPtTrackDownscaligF(0)
   , fLowPtV0DownscaligF(0)
   , fFriendDownscaling(-3.)   
+  , fOutputCompression(-1)
+  , fOutputAutoFlush(0)
+  , fOutputBasketSize(0)
+  , fOutputCompressionThreads(0)
+  , fOutputDirectory(0)
+  , fNOutputObjects(0)
+  , fConfiguredTrees()
   , fProcessAll(kFALSE)
   , fProcessCosmics(kFALSE)
   , fProcessITSTPCmatchOut(kFALSE)  // swittch to process ITS/TPC standalone tracks
@@ -193,9 +201,38 @@ void AliAnalysisTaskFilteredTree::UserCreateOutputObjects()
   // Create histograms
   // Called once
 
+  //
+  //if set, the environment variables override the downscaling factors of the task configuration
+  //AliAnalysisTaskFilteredTree_fLowPtTrackDownscaligF
+  //AliAnalysisTaskFilteredTree_fLowPtV0DownscaligF
+  //AliAnalysisTaskFilteredTree_fFriendDownscaling
+  //they are read here, on the worker, once per task
+  TString env;
+  env = gSystem->Getenv("AliAnalysisTaskFilteredTree_fLowPtTrackDownscaligF");
+  if (!env.IsNull()){
+    fLowPtTrackDownscaligF=env.Atof();
+    AliInfo(Form("fLowPtTrackDownscaligF=%f",fLowPtTrackDownscaligF));
+  }
+  env = gSystem->Getenv("AliAnalysisTaskFilteredTree_fLowPtV0DownscaligF");
+  if (!env.IsNull()){
+    fLowPtV0DownscaligF=env.Atof();
+    AliInfo(Form("fLowPtV0DownscaligF=%f",fLowPtV0DownscaligF));
+  }
+  env = gSystem->Getenv("AliAnalysisTaskFilteredTree_fFriendDownscaling");
+  if (!env.IsNull()){
+    fFriendDownscaling=env.Atof();
+    AliInfo(Form(" fFriendDownscaling=%f",fFriendDownscaling));
+  }
+
   //
   //get the output file to make sure the trees will be associated to it
-  OpenFile(1);
+  TFile *outputFile = OpenFile(1);
+  if (outputFile && fOutputCompression>=0) outputFile->SetCompressionSettings(fOutputCompression);
+  fOutputDirectory = gDirectory;
+#ifdef R__USE_IMT
+  // baskets of the output trees are compressed by the ROOT thread pool instead of the event loop
+  if (fOutputCompressionThreads>0 && !ROOT::IsImplicitMTEnabled()) ROOT::EnableImplicitMT(fOutputCompressionThreads);
+#endif
   fTreeSRedirector = new TTreeSRedirector();
 
   //
@@ -338,28 +375,9 @@ void AliAnalysisTaskFilteredTree::UserExec(Option_t *)
     return;
   }
 
-  //if set, use the environment variables to set the downscaling factors
-  //AliAnalysisTaskFilteredTree_fLowPtTrackDownscaligF
-  //AliAnalysisTaskFilteredTree_fLowPtV0DownscaligF
-  //AliAnalysisTaskFilteredTree_fFriendDownscaling
-  TString env;
-  env = gSystem->Getenv("AliAnalysisTaskFilteredTree_fLowPtTrackDownscaligF");
-  if (!env.IsNull()){
-    fLowPtTrackDownscaligF=env.Atof();
-    AliInfo(Form("fLowPtTrackDownscaligF=%f",fLowPtTrackDownscaligF));
-  }
-  env = gSystem->Getenv("AliAnalysisTaskFilteredTree_fLowPtV0DownscaligF");
-  if (!env.IsNull()){
-    fLowPtV0DownscaligF=env.Atof();
-    AliInfo(Form("fLowPtV0DownscaligF=%f",fLowPtTrackDownscaligF));
-  }
-  env = gSystem->Getenv("AliAnalysisTaskFilteredTree_fFriendDownscaling");
-  if (!env.IsNull()){
-    fFriendDownscaling=env.Atof();
-    AliInfo(Form(" fFriendDownscaling=%f",fFriendDownscaling));
-  }
-  //
   //
+  // downscaling factors: task configuration, overridden by the environment
+  // variables read in UserCreateOutputObjects()
   //
   if(fProcessAll) { 
     ProcessAll(fESD,fMC,fESDfriend); // all track stages and MC
@@ -377,9 +395,38 @@ void AliAnalysisTaskFilteredTree::UserExec(Option_t *)
     //ProcessMC();  //TODO - enable MC detailed view switch after holidays
   }
   if (fProcessITSTPCmatchOut) ProcessITSTPCmatchOut(fESD, fESDfriend);
+  ConfigureOutputTrees();
   printf("processed event %d\n", Int_t(Entry()));
 }
 
+//_____________________________________________________________________________
+void AliAnalysisTaskFilteredTree::ConfigureOutputTrees()
+{
+  //
+  // Apply the output settings (auto flush, basket size, parallel compression)
+  // to the trees of the redirector. The streams create their tree and branches
+  // on their first write, so the output directory is searched for new trees,
+  // only when objects were added to it since the last call.
+  //
+  if (!fOutputDirectory) return;
+  if (fOutputAutoFlush==0 && fOutputBasketSize<=0 && fOutputCompressionThreads<=0) return;
+  const Int_t nObjects = fOutputDirectory->GetList()->GetSize();
+  if (nObjects==fNOutputObjects) return;
+  fNOutputObjects = nObjects;
+  TIter next(fOutputDirectory->GetList());
+  TObject *object=0;
+  while ((object=next())) {
+    TTree *tree = dynamic_cast<TTree*>(object);
+    if (!tree || tree->GetListOfBranches()->GetEntries()==0) continue;
+    if (!fConfiguredTrees.insert(tree).second) continue;
+    if (fOutputAutoFlush!=0) tree->SetAutoFlush(fOutputAutoFlush);
+    if (fOutputBasketSize>0) tree->SetBasketSize("*",fOutputBasketSize);
+#ifdef R__USE_IMT
+    if (fOutputCompressionThreads>0) tree->SetImplicitMT(kTRUE);
+#endif
+  }
+}
+
 //_____________________________________________________________________________
 void AliAnalysisTaskFilteredTree::ProcessCosmics(AliESDEvent *const event, AliESDfriend* esdFriend)
 {
@@ -2565,6 +2612,9 @@ void AliAnalysisTaskFilteredTree::FinishTaskOutput()
   }
   if (deleteTrees) delete fTreeSRedirector;
   fTreeSRedirector=NULL;
+  fOutputDirectory=NULL;
+  fNOutputObjects=0;
+  fConfiguredTrees.clear();
 }
 
 //_____________________________________________________________________________
@@ -30,7 +30,9 @@ class TTree;
 class TTreeSRedirector;
 class TParticle;
 class TH3D;
+class TDirectory;
 #include <string>
+#include <set>
 
 #include "AliTriggerAnalysis.h"
 #include "AliAnalysisTaskSE.h"
@@ -101,6 +103,12 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   void SetLowPtTrackDownscaligF(Double_t fact) { fLowPtTrackDownscaligF = fact; }
   void SetLowPtV0DownscaligF(Double_t fact)    { fLowPtV0DownscaligF = fact; }
   void SetFriendDownscaling(Double_t fact)    { fFriendDownscaling = fact; }
+
+  // output trees writing
+  void SetOutputCompression(Int_t settings)        { fOutputCompression = settings; }
+  void SetOutputAutoFlush(Long64_t autoFlush)      { fOutputAutoFlush = autoFlush; }
+  void SetOutputBasketSize(Int_t size)             { fOutputBasketSize = size; }
+  void SetOutputCompressionThreads(Int_t nThreads) { fOutputCompressionThreads = nThreads; }
   
   void   SetProcessCosmics(Bool_t flag) { fProcessCosmics = flag; }
   Bool_t GetProcessCosmics() { return fProcessCosmics; }
@@ -124,6 +132,8 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   static Int_t GetMCTrackDiff(const TParticle &particle, const AliExternalTrackParam &param, TClonesArray &trackRefArray, TVectorF &mcDiff); //TODO test before enabling
  private:
 
+  void ConfigureOutputTrees();
+
   AliESDEvent *fESD;    //! ESD event
   AliMCEvent *fMC;      //! MC event
   AliESDfriend *fESDfriend; //! ESDfriend event
@@ -149,6 +159,13 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   Double_t fLowPtTrackDownscaligF; // low pT track downscaling factor
   Double_t fLowPtV0DownscaligF;    // low pT V0 downscaling factor
   Double_t fFriendDownscaling;     // friend info downscaling )absolute value used), Modes>=1 downscaling in respect to the amount of tracks, Mode<=-1 (downscaling in respect to the data volume)
+  Int_t    fOutputCompression;     // compression settings of the output file (algorithm*100+level), <0 - file default
+  Long64_t fOutputAutoFlush;       // auto flush of the output trees (>0 entries, <0 bytes), 0 - ROOT default
+  Int_t    fOutputBasketSize;      // basket size of the output tree branches, <=0 - ROOT default
+  Int_t    fOutputCompressionThreads; // number of threads compressing the output baskets (ROOT implicit MT), 0 - event loop thread
+  TDirectory *fOutputDirectory;    //! directory of the output trees
+  Int_t    fNOutputObjects;        //! number of objects in the output directory at the last ConfigureOutputTrees()
+  std::set<TTree*> fConfiguredTrees; //! output trees with the output settings applied
   Double_t fProcessAll; // Calculate all track properties including MC
   
   Bool_t fProcessCosmics; // look for cosmic pairs from random trigger
@@ -177,7 +194,7 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
 
   AliAnalysisTaskFilteredTree(const AliAnalysisTaskFilteredTree&); // not implemented
   AliAnalysisTaskFilteredTree& operator=(const AliAnalysisTaskFilteredTree&); // not implemented
-  ClassDef(AliAnalysisTaskFilteredTree, 1); // example of analysis
+  ClassDef(AliAnalysisTaskFilteredTree, 2); // example of analysis
 };
 
 #endif
@@ -75,7 +75,7 @@ public :
   //
   // TPC dE/dx 
   //
-  THnSparse* GetDeDxHisto() const {return fDeDxHisto;}
+  THnSparse* GetDeDxHisto() const {FlushSparseFills(); return fDeDxHisto;}
   TObjArray* GetHistos() const { return fFolderObj; }
 
 private:
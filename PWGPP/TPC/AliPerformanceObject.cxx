@@ -31,10 +31,12 @@
 #include "TPostScript.h"
 #include "TList.h"
 #include "TMath.h"
+#include "TObjArray.h"
 
 #include "AliLog.h" 
 #include "AliESDVertex.h" 
 #include "AliPerformanceObject.h" 
+#include "AliCFSparseFillBuffer.h"
 
 using namespace std;
 
@@ -52,7 +54,9 @@ AliPerformanceObject::AliPerformanceObject():
   fHighMultiplicity(kFALSE),
   fUseKinkDaughters(kTRUE),
   fUseCentralityBin(0),
-  fUseTOFBunchCrossing(kTRUE)
+  fUseTOFBunchCrossing(kTRUE),
+  fSparseFillBuffer(0),
+  fSparseFillers(0)
 {
   // constructor
 }
@@ -69,7 +73,9 @@ AliPerformanceObject::AliPerformanceObject(const char* name, const char* title,
   fHighMultiplicity(highMult),
   fUseKinkDaughters(kTRUE),
   fUseCentralityBin(0),
-  fUseTOFBunchCrossing(kTRUE)
+  fUseTOFBunchCrossing(kTRUE),
+  fSparseFillBuffer(0),
+  fSparseFillers(0)
 {
   // constructor
 }
@@ -77,6 +83,43 @@ AliPerformanceObject::AliPerformanceObject(const char* name, const char* title,
 //_____________________________________________________________________________
 AliPerformanceObject::~AliPerformanceObject(){
   // destructor 
+  if(fSparseFillers) delete fSparseFillers;
+}
+
+//_____________________________________________________________________________
+void AliPerformanceObject::FillSparse(THnSparse *hSparse, const Double_t *x)
+{
+  // fill the THnSparse directly or through its buffered filler
+  if(fSparseFillBuffer<=0) {
+    hSparse->Fill(x);
+    return;
+  }
+
+  if(!fSparseFillers) {
+    fSparseFillers = new TObjArray;
+    fSparseFillers->SetOwner();
+  }
+  AliCFSparseFillBuffer *filler = 0;
+  for(Int_t i=0; i<fSparseFillers->GetEntriesFast(); i++) {
+    AliCFSparseFillBuffer *f = static_cast<AliCFSparseFillBuffer*>(fSparseFillers->UncheckedAt(i));
+    if(f->GetHisto()==hSparse) { filler = f; break; }
+  }
+  if(!filler) {
+    filler = new AliCFSparseFillBuffer(hSparse,fSparseFillBuffer);
+    fSparseFillers->Add(filler);
+  }
+  filler->Fill(x);
+}
+
+//_____________________________________________________________________________
+void AliPerformanceObject::FlushSparseFills() const
+{
+  // add the buffered fills to the THnSparse
+  // to be called before the THnSparse are used (projections, merging)
+  if(!fSparseFillers) return;
+  for(Int_t i=0; i<fSparseFillers->GetEntriesFast(); i++) {
+    static_cast<AliCFSparseFillBuffer*>(fSparseFillers->UncheckedAt(i))->Flush();
+  }
 }
 
 //_____________________________________________________________________________
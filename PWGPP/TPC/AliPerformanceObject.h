@@ -20,6 +20,7 @@ class AliRecInfoCuts;
 class AliMCInfoCuts;
 class AliESDfriend;
 class AliESDVertex;
+class TObjArray;
 
 class AliPerformanceObject : public TNamed {
 public :
@@ -105,12 +106,20 @@ public :
   void SetUseTOFBunchCrossing(Bool_t tofBunching = kTRUE) { fUseTOFBunchCrossing = tofBunching; }
   Bool_t IsUseTOFBunchCrossing() { return fUseTOFBunchCrossing; }
 
+  // buffered filling of the THnSparse (0: direct fill)
+  void SetSparseFillBuffer(Int_t size = 10000) { fSparseFillBuffer = size; }
+  Int_t GetSparseFillBuffer() const { return fSparseFillBuffer; }
+  void FlushSparseFills() const;
+
 protected: 
 
   void AddProjection(TObjArray* aFolderObj, TString nameSparse, THnSparse *hSparse, Int_t xDim, TString* selString = 0);
   void AddProjection(TObjArray* aFolderObj, TString nameSparse, THnSparse *hSparse, Int_t xDim, Int_t yDim, TString* selString = 0);
   void AddProjection(TObjArray* aFolderObj, TString nameSparse, THnSparse *hSparse, Int_t xDim, Int_t yDim, Int_t zDim, TString* selString = 0);
 
+  // fill a THnSparse, through the fill buffer if enabled
+  void FillSparse(THnSparse *hSparse, const Double_t *x);
+
   // merge THnSparse
   Bool_t fMergeTHnSparseObj;
   
@@ -137,10 +146,13 @@ protected:
 
   Bool_t fUseTOFBunchCrossing; // use TOFBunchCrossing, default is yes
 
+  Int_t fSparseFillBuffer; // number of THnSparse fills buffered before flushing (0: direct fill)
+  TObjArray *fSparseFillers; //! buffered fillers, one per THnSparse
+
   AliPerformanceObject(const AliPerformanceObject&); // not implemented
   AliPerformanceObject& operator=(const AliPerformanceObject&); // not implemented
 
-  ClassDef(AliPerformanceObject,7);
+  ClassDef(AliPerformanceObject,8);
 };
 
 #endif
@@ -300,10 +300,10 @@ void AliPerformanceRes::ProcessTPC(AliMCEvent* const mcev, AliESDtrack *const es
     else pull1PtTPC = 0.; 
 
     Double_t vResolHisto[10] = {deltaYTPC,deltaZTPC,deltaPhiTPC,deltaLambdaTPC,deltaPtTPC,particle->Vy(),particle->Vz(),mcphi,mceta,mcpt};
-    fResolHisto->Fill(vResolHisto);
+    FillSparse(fResolHisto,vResolHisto);
 
     Double_t vPullHisto[10] = {pullYTPC,pullZTPC,pullPhiTPC,pullLambdaTPC,pull1PtTPC,particle->Vy(),particle->Vz(),mcsnp,mctgl,1./mcpt};
-    fPullHisto->Fill(vPullHisto);
+    FillSparse(fPullHisto,vPullHisto);
   }
 }
 
@@ -393,10 +393,10 @@ void AliPerformanceRes::ProcessTPCITS(AliMCEvent* const mcev, AliESDtrack *const
     else pull1PtTPC = 0.;
 
     Double_t vResolHisto[10] = {deltaYTPC,deltaZTPC,deltaPhiTPC,deltaLambdaTPC,deltaPtTPC,particle->Vy(),particle->Vz(),mcphi,mceta,mcpt};
-    fResolHisto->Fill(vResolHisto);
+    FillSparse(fResolHisto,vResolHisto);
 
     Double_t vPullHisto[10] = {pullYTPC,pullZTPC,pullPhiTPC,pullLambdaTPC,pull1PtTPC,particle->Vy(),particle->Vz(),mcsnp,mctgl,1./mcpt};
-    fPullHisto->Fill(vPullHisto);
+    FillSparse(fPullHisto,vPullHisto);
 
    
     /*
@@ -420,10 +420,10 @@ void AliPerformanceRes::ProcessTPCITS(AliMCEvent* const mcev, AliESDtrack *const
     else pull1PtTPC = 0.;
 
     Double_t vResolHisto[10] = {deltaYTPC,deltaZTPC,deltaPhiTPC,deltaLambdaTPC,delta1PtTPC,particle->Vy(),particle->Vz(),mceta,mcphi,mcpt};
-    fResolHisto->Fill(vResolHisto);
+    FillSparse(fResolHisto,vResolHisto);
 
     Double_t vPullHisto[10] = {pullYTPC,pullZTPC,pullPhiTPC,pullLambdaTPC,pull1PtTPC,particle->Vy(),particle->Vz(),mceta,mcphi,mcpt};
-    fPullHisto->Fill(vPullHisto);
+    FillSparse(fPullHisto,vPullHisto);
     */
   }
 }
@@ -518,10 +518,10 @@ void AliPerformanceRes::ProcessConstrained(AliMCEvent* const mcev, AliESDtrack *
     else pull1PtTPC = 0.;
 
     Double_t vResolHisto[10] = {deltaYTPC,deltaZTPC,deltaPhiTPC,deltaLambdaTPC,deltaPtTPC,particle->Vy(),particle->Vz(),mcphi,mceta,mcpt};
-    fResolHisto->Fill(vResolHisto);
+    FillSparse(fResolHisto,vResolHisto);
 
     Double_t vPullHisto[10] = {pullYTPC,pullZTPC,pullPhiTPC,pullLambdaTPC,pull1PtTPC,particle->Vy(),particle->Vz(),mcsnp,mctgl,1./mcpt};
-    fPullHisto->Fill(vPullHisto);
+    FillSparse(fPullHisto,vPullHisto);
 
     /*
 
@@ -546,10 +546,10 @@ void AliPerformanceRes::ProcessConstrained(AliMCEvent* const mcev, AliESDtrack *
     else pull1PtTPC = 0.;
 
     Double_t vResolHisto[10] = {deltaYTPC,deltaZTPC,deltaPhiTPC,deltaLambdaTPC,delta1PtTPC,particle->Vy(),particle->Vz(),mceta,mcphi,mcpt};
-    fResolHisto->Fill(vResolHisto);
+    FillSparse(fResolHisto,vResolHisto);
 
     Double_t vPullHisto[10] = {pullYTPC,pullZTPC,pullPhiTPC,pullLambdaTPC,pull1PtTPC,particle->Vy(),particle->Vz(),mceta,mcphi,mcpt};
-    fPullHisto->Fill(vPullHisto);
+    FillSparse(fPullHisto,vPullHisto);
 
     */
   }
@@ -689,10 +689,10 @@ void AliPerformanceRes::ProcessInnerTPC(AliMCEvent *const mcEvent, AliESDtrack *
     else pull1PtTPC = 0.;
 
     Double_t vResolHisto[10] = {deltaYTPC,deltaZTPC,deltaPhiTPC,deltaLambdaTPC,deltaPtTPC,ref0->Y(),ref0->Z(),mcphi,mceta,mcpt};
-    fResolHisto->Fill(vResolHisto);
+    FillSparse(fResolHisto,vResolHisto);
 
     Double_t vPullHisto[10] = {pullYTPC,pullZTPC,pullPhiTPC,pullLambdaTPC,pull1PtTPC,ref0->Y(),ref0->Z(),mcsnp,mctgl,1./mcpt};
-    fPullHisto->Fill(vPullHisto);
+    FillSparse(fPullHisto,vPullHisto);
   }
 
   if(track) delete track;
@@ -810,10 +810,10 @@ void AliPerformanceRes::ProcessOuterTPC(AliMCEvent *const mcEvent, AliESDtrack *
     else pull1PtTPC = 0.;
 
     Double_t vResolHisto[10] = {deltaYTPC,deltaZTPC,deltaPhiTPC,deltaLambdaTPC,deltaPtTPC,ref0->Y(),ref0->Z(),mcphi,mceta,mcpt};
-    fResolHisto->Fill(vResolHisto);
+    FillSparse(fResolHisto,vResolHisto);
 
     Double_t vPullHisto[10] = {pullYTPC,pullZTPC,pullPhiTPC,pullLambdaTPC,pull1PtTPC,ref0->Y(),ref0->Z(),mcsnp,mctgl,1./mcpt};
-    fPullHisto->Fill(vPullHisto);
+    FillSparse(fPullHisto,vPullHisto);
   }
 
   if(track) delete track;
@@ -1001,6 +1001,7 @@ void AliPerformanceRes::Analyse() {
   // Analyse comparison information and store output histograms
   // in the folder "folderRes"
   //
+  FlushSparseFills();
   TH1::AddDirectory(kFALSE);
   TH1F *h=0;
   TH2F *h2D=0;
@@ -1155,6 +1156,8 @@ Long64_t AliPerformanceRes::Merge(TCollection* const list)
   if (list->IsEmpty())
   return 1;
 
+  FlushSparseFills();
+
   TIterator* iter = list->MakeIterator();
   TObject* obj = 0;
 
@@ -1164,6 +1167,7 @@ Long64_t AliPerformanceRes::Merge(TCollection* const list)
   {
   AliPerformanceRes* entry = dynamic_cast<AliPerformanceRes*>(obj);
   if (entry == 0) continue; 
+  entry->FlushSparseFills();
   if (fResolHisto->GetEntries()<fgkMergeEntriesCut){
     fResolHisto->Add(entry->fResolHisto);  
     fPullHisto->Add(entry->fPullHisto);
@@ -76,8 +76,8 @@ public :
 
   // getters
   //
-  THnSparse *GetResolHisto() const  { return fResolHisto; }
-  THnSparse *GetPullHisto()  const  { return fPullHisto; }
+  THnSparse *GetResolHisto() const  { FlushSparseFills(); return fResolHisto; }
+  THnSparse *GetPullHisto()  const  { FlushSparseFills(); return fPullHisto; }
   static void SetMergeEntriesCut(Double_t entriesCut){fgkMergeEntriesCut = entriesCut;}
 
 private:
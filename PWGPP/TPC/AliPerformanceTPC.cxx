@@ -348,7 +348,7 @@ void AliPerformanceTPC::ProcessTPC(AliMCEvent* const mcev, AliESDtrack *const es
 
   //Double_t vTPCTrackHisto[10] = {nClust,chi2PerCluster,clustPerFindClust,dca[0],dca[1],eta,phi,pt,qpt,vertStatus};
   Double_t vTPCTrackHisto[10] = {static_cast<Double_t>(nClust),static_cast<Double_t>(chi2PerCluster),static_cast<Double_t>(clustPerFindClust),static_cast<Double_t>(dca[0]),static_cast<Double_t>(dca[1]),static_cast<Double_t>(eta),static_cast<Double_t>(phi),static_cast<Double_t>(pt),static_cast<Double_t>(q),static_cast<Double_t>(vertStatus)};
-  fTPCTrackHisto->Fill(vTPCTrackHisto); 
+  FillSparse(fTPCTrackHisto,vTPCTrackHisto); 
  
   //
   // Fill rec vs MC information
@@ -419,7 +419,7 @@ void AliPerformanceTPC::ProcessTPCITS(AliMCEvent* const mcev, AliESDtrack *const
   if(!fCutsRC->GetDCAToVertex2D() && TMath::Abs(dca[1]) > fCutsRC->GetMaxDCAToVertexZ()) return;
 
   Double_t vTPCTrackHisto[10] = {static_cast<Double_t>(nClust),static_cast<Double_t>(chi2PerCluster),static_cast<Double_t>(clustPerFindClust),static_cast<Double_t>(dca[0]),static_cast<Double_t>(dca[1]),static_cast<Double_t>(eta),static_cast<Double_t>(phi),static_cast<Double_t>(pt),static_cast<Double_t>(q),static_cast<Double_t>(vertStatus)};
-  fTPCTrackHisto->Fill(vTPCTrackHisto); 
+  FillSparse(fTPCTrackHisto,vTPCTrackHisto); 
  
   //
   // Fill rec vs MC information
@@ -550,7 +550,7 @@ void AliPerformanceTPC::Exec(AliMCEvent* const mcEvent, AliESDEvent *const esdEv
              //Int_t detector = cluster->GetDetector();
              //Double_t vTPCClust[6] = { irow, phi, TPCside, pad, detector, gclf[2] };
              Double_t vTPCClust[3] = { static_cast<Double_t>(irow), phi, static_cast<Double_t>(TPCside) };
-             fTPCClustHisto->Fill(vTPCClust);
+             FillSparse(fTPCClustHisto,vTPCClust);
         }
       }
     }
@@ -596,7 +596,7 @@ void AliPerformanceTPC::Exec(AliMCEvent* const mcEvent, AliESDEvent *const esdEv
   }
 
   Double_t vTPCEvent[7] = {vtxESD->GetX(),vtxESD->GetY(),vtxESD->GetZ(),static_cast<Double_t>(mult),static_cast<Double_t>(multP),static_cast<Double_t>(multN),static_cast<Double_t>(vtxESD->GetStatus())};
-  fTPCEventHisto->Fill(vTPCEvent);
+  FillSparse(fTPCEventHisto,vTPCEvent);
 }
 
 
@@ -607,6 +607,7 @@ void AliPerformanceTPC::Analyse()
     // Analyse comparison information and store output histograms
     // in the folder "folderTPC"
     //
+    FlushSparseFills();
     TH1::AddDirectory(kFALSE);
     TH1::SetDefaultSumw2(kFALSE);
     TObjArray *aFolderObj = new TObjArray;
@@ -771,6 +772,8 @@ Long64_t AliPerformanceTPC::Merge(TCollection* const list)
 
   if (list->IsEmpty())
   return 1;
+
+  FlushSparseFills();
   
   Bool_t merge = ((fgUseMergeTHnSparse && fgMergeTHnSparse) || (!fgUseMergeTHnSparse && fMergeTHnSparseObj));
 
@@ -785,6 +788,7 @@ Long64_t AliPerformanceTPC::Merge(TCollection* const list)
   {
     AliPerformanceTPC* entry = dynamic_cast<AliPerformanceTPC*>(obj);
     if (entry == 0) continue; 
+    entry->FlushSparseFills();
     if (merge) {
         if ((fTPCClustHisto) && (entry->fTPCClustHisto)) { fTPCClustHisto->Add(entry->fTPCClustHisto); }
         if ((fTPCEventHisto) && (entry->fTPCEventHisto)) { fTPCEventHisto->Add(entry->fTPCEventHisto); }
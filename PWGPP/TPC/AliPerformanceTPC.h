@@ -71,9 +71,9 @@ public :
 
   // getters
   //
-  THnSparse *GetTPCClustHisto() const  { return fTPCClustHisto; }
-  THnSparse *GetTPCEventHisto() const  { return fTPCEventHisto; }
-  THnSparse *GetTPCTrackHisto() const  { return fTPCTrackHisto; }
+  THnSparse *GetTPCClustHisto() const  { FlushSparseFills(); return fTPCClustHisto; }
+  THnSparse *GetTPCEventHisto() const  { FlushSparseFills(); return fTPCEventHisto; }
+  THnSparse *GetTPCTrackHisto() const  { FlushSparseFills(); return fTPCTrackHisto; }
   
   TObjArray* GetHistos() const { return fFolderObj; }
   
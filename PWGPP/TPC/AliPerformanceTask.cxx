@@ -336,6 +336,7 @@ void AliPerformanceTask::FinishTaskOutput()
       itOut->Reset();
       while(( pObj = dynamic_cast<AliPerformanceObject*>(itOut->Next())) != NULL) {
           pObj->SetRunNumber(fCurrentRunNumber);
+          pObj->FlushSparseFills();
           pObj->Analyse();
       }
       
@@ -41,7 +41,11 @@ AliTender::AliTender():
            fESDhandler(NULL),
            fESD(NULL),
            fSupplies(NULL),
-           fCDBSettings(NULL)
+           fCDBSettings(NULL),
+           fRequested(0),
+           fNEvents(0),
+           fSupplyRun(),
+           fSupplyEvent()
 {
 // Dummy constructor
 }
@@ -58,7 +62,11 @@ AliTender::AliTender(const char* name):
            fESDhandler(NULL),
            fESD(NULL),
            fSupplies(NULL),
-           fCDBSettings(NULL)
+           fCDBSettings(NULL),
+           fRequested(0),
+           fNEvents(0),
+           fSupplyRun(),
+           fSupplyEvent()
 {
 // Default constructor
   DefineOutput(1,  AliESDEvent::Class());
@@ -170,9 +178,18 @@ void AliTender::UserExec(Option_t* option)
       fCDBkey = fCDB->SetLock(kTRUE, fCDBkey);
     } 
   }
-  TIter next(fSupplies);
-  AliTenderSupply *supply;
-  while ((supply=(AliTenderSupply*)next())) supply->ProcessEvent();
+  fNEvents++;
+  Int_t nsupplies = fSupplies ? fSupplies->GetEntriesFast() : 0;
+  if ((Int_t)fSupplyRun.size() != nsupplies) {
+    fSupplyRun.assign(nsupplies, -1);
+    fSupplyEvent.assign(nsupplies, -1);
+  }
+  if (TObject::TestBit(kLazySupplies)) {
+    // The other supplies run only if a wagon asks for their products
+    Provide(fRequested);
+  } else {
+    for (Int_t i=0; i<nsupplies; i++) RunSupply(i);
+  }
   fRunChanged = kFALSE;
 
   if (TObject::TestBit(kCheckEventSelection)) fESDhandler->CheckSelectionMask();
@@ -181,6 +198,45 @@ void AliTender::UserExec(Option_t* option)
   if (!opt.Contains("NoPost")) PostData(1, fESD);
 }
 
+//______________________________________________________________________________
+void AliTender::RunSupply(Int_t isupply)
+{
+// Process the current event with one supply. A supply that did not process
+// the first event of the current run (lazy mode) still sees RunChanged().
+  AliTenderSupply *supply = (AliTenderSupply*)fSupplies->UncheckedAt(isupply);
+  Bool_t runChanged = fRunChanged;
+  fRunChanged = runChanged || fSupplyRun[isupply] != fRun;
+  if (fRunChanged) supply->InitRun();
+  supply->ProcessEvent();
+  fSupplyRun[isupply] = fRun;
+  fSupplyEvent[isupply] = fNEvents;
+  fRunChanged = runChanged;
+}
+
+//______________________________________________________________________________
+Bool_t AliTender::Provide(UInt_t products)
+{
+// Run on the current event the supplies not yet executed that modify the
+// requested products, together with the earlier supplies modifying their
+// inputs. The supplies run in insertion order. To be called by the wagons
+// after the tender when lazy execution is enabled.
+  if (!fESD || !fNEvents) return kFALSE;
+  Int_t nsupplies = fSupplyEvent.size();
+  std::vector<Bool_t> torun(nsupplies, kFALSE);
+  UInt_t needed = products;
+  for (Int_t i=nsupplies-1; i>=0; i--) {
+    if (fSupplyEvent[i] == fNEvents) continue;
+    AliTenderSupply *supply = (AliTenderSupply*)fSupplies->UncheckedAt(i);
+    if (!(supply->GetOutputs() & needed)) continue;
+    torun[i] = kTRUE;
+    needed |= supply->GetInputs();
+  }
+  for (Int_t i=0; i<nsupplies; i++) {
+    if (torun[i]) RunSupply(i);
+  }
+  return kTRUE;
+}
+
 //______________________________________________________________________________
 void AliTender::SetDefaultCDBStorage(const char *dbString)
 {
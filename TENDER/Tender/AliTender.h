@@ -25,11 +25,14 @@ class AliESDEvent;
 class AliESDInputHandler;
 class AliTenderSupply;
 
+#include <vector>
+
 class AliTender : public AliAnalysisTaskSE {
 
 public:
 enum ETenderFlags {
-   kCheckEventSelection = BIT(18) // up to 18 used by AliAnalysisTask
+   kCheckEventSelection = BIT(18), // up to 18 used by AliAnalysisTask
+   kLazySupplies        = BIT(19)  // run only the supplies producing the requested products
 };
    
 private:
@@ -43,6 +46,12 @@ private:
   AliESDEvent              *fESD;            //! Pointer to current ESD event
   TObjArray                *fSupplies;       // Array of tender supplies
   TObjArray                *fCDBSettings;    // Array with CDB configuration
+  UInt_t                    fRequested;      // Products provided at each event in lazy mode
+  Long64_t                  fNEvents;        //! Number of processed events
+  std::vector<Int_t>        fSupplyRun;      //! Run of the last event processed by each supply
+  std::vector<Long64_t>     fSupplyEvent;    //! Last event processed by each supply
+  
+  void                      RunSupply(Int_t isupply);
   
   AliTender(const AliTender &other);
   AliTender& operator=(const AliTender &other);
@@ -60,6 +69,12 @@ public:
   TObjArray                *GetSupplies() const {return fSupplies;}
   void                      SetCheckEventSelection(Bool_t flag=kTRUE) {TObject::SetBit(kCheckEventSelection,flag);}
   Bool_t                    RunChanged() const {return fRunChanged;}
+  // Lazy execution: only the supplies producing the requested products
+  // (AliTenderSupply::ETenderProduct bits) run, the others on demand via Provide()
+  void                      SetLazySupplies(Bool_t flag=kTRUE) {TObject::SetBit(kLazySupplies,flag);}
+  void                      RequestProducts(UInt_t products) {fRequested |= products;}
+  UInt_t                    GetRequestedProducts() const {return fRequested;}
+  Bool_t                    Provide(UInt_t products);
   // Configuration
   void                      SetDefaultCDBStorage(const char *dbString="local://$ALICE_ROOT/OCDB");
   /**
@@ -75,6 +90,6 @@ public:
 //  virtual Bool_t            Notify() {return kTRUE;}
   virtual void              UserExec(Option_t *option);
     
-  ClassDef(AliTender,4)  // Class describing the tender car for ESD analysis
+  ClassDef(AliTender,5)  // Class describing the tender car for ESD analysis
 };
 #endif
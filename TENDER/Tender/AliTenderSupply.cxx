@@ -23,7 +23,9 @@ ClassImp(AliTenderSupply)
 //______________________________________________________________________________
 AliTenderSupply::AliTenderSupply()
                 :TNamed(),
-                 fTender(NULL)
+                 fTender(NULL),
+                 fInputs(0),
+                 fOutputs(kAllProducts)
 {
 // Dummy constructor
 }
@@ -31,16 +33,21 @@ AliTenderSupply::AliTenderSupply()
 //______________________________________________________________________________
 AliTenderSupply::AliTenderSupply(const char* name, const AliTender *tender)
                 :TNamed(name, "ESD analysis tender car"),
-                 fTender(tender)
+                 fTender(tender),
+                 fInputs(0),
+                 fOutputs(kAllProducts)
 {
-// Default constructor
+// Default constructor. A supply that does not declare its products with
+// SetProducts() is assumed to modify everything.
 }
 
 //______________________________________________________________________________
 AliTenderSupply::AliTenderSupply(const AliTenderSupply &other)
                 :TNamed(other),
-                 fTender(other.fTender)
-                 
+                 fTender(other.fTender),
+                 fInputs(other.fInputs),
+                 fOutputs(other.fOutputs)
+
 {
 // Copy constructor
 }
@@ -58,5 +65,7 @@ AliTenderSupply& AliTenderSupply::operator=(const AliTenderSupply &other)
    if (&other == this) return *this;
    TNamed::operator=(other);
    fTender = other.fTender;
+   fInputs = other.fInputs;
+   fOutputs = other.fOutputs;
    return *this;
 }
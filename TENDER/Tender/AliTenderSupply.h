@@ -18,8 +18,23 @@ class AliTender;
 
 class AliTenderSupply : public TNamed {
 
+public:
+// ESD information read or modified by a supply, used by the tender to decide
+// which supplies have to run when only some products are requested
+enum ETenderProduct {
+   kTrackParams  = BIT(0),  // track parameters and covariance
+   kTrackPID     = BIT(1),  // detector PID signals and responses of the tracks
+   kVertex       = BIT(2),  // primary vertex
+   kCaloClusters = BIT(3),  // EMCAL/PHOS cells and clusters
+   kVZERO        = BIT(4),  // VZERO signals and decisions
+   kTOFCalib     = BIT(5),  // TOF calibration and event start time
+   kAllProducts  = 0xffffffff
+};
+
 protected:
   const AliTender          *fTender;         // Tender car
+  UInt_t                    fInputs;         // Products read by the supply (ETenderProduct bits)
+  UInt_t                    fOutputs;        // Products modified by the supply (ETenderProduct bits)
   
 public:  
   AliTenderSupply();
@@ -31,9 +46,14 @@ public:
   // Run control
   virtual void              Init() = 0;
   virtual void              ProcessEvent() = 0;
+  virtual void              InitRun() {}
   
   void                      SetTender(const AliTender *tender) {fTender = tender;}
+  // Metadata
+  void                      SetProducts(UInt_t inputs, UInt_t outputs) {fInputs = inputs; fOutputs = outputs;}
+  UInt_t                    GetInputs() const  {return fInputs;}
+  UInt_t                    GetOutputs() const {return fOutputs;}
     
-  ClassDef(AliTenderSupply,1)  // Base class for tender user algorithms
+  ClassDef(AliTenderSupply,2)  // Base class for tender user algorithms
 };
 #endif
@@ -184,6 +184,7 @@ AliEMCALTenderSupply::AliEMCALTenderSupply(const char *name, const AliTender *te
   for(Int_t i = 0; i < AliEMCALGeoParams::fgkEMCALModules; i++) fEMCALMatrix[i] = 0 ;
   for(Int_t j = 0; j < fgkTotalCellNumber;                 j++) 
   { fOrgClusterCellId[j] =-1; fCellLabels[j] =-1 ; }
+  SetProducts(kTrackParams|kVertex, kCaloClusters);
 }
 
 //_____________________________________________________
@@ -255,6 +256,7 @@ AliEMCALTenderSupply::AliEMCALTenderSupply(const char *name, AliAnalysisTaskSE *
   for(Int_t i = 0; i < AliEMCALGeoParams::fgkEMCALModules; i++) fEMCALMatrix[i] = 0 ;
   for(Int_t j = 0; j < fgkTotalCellNumber;                 j++) 
   { fOrgClusterCellId[j] =-1; fCellLabels[j] =-1 ; }
+  SetProducts(kTrackParams|kVertex, kCaloClusters);
 }
 
 //_____________________________________________________
@@ -52,6 +52,7 @@ AliTenderSupply(name,tender)
   //
   // named ctor
   //
+  SetProducts(kTrackParams, kTrackPID);
 }
 
 //_____________________________________________________
@@ -48,6 +48,7 @@ AliPIDTenderSupply::AliPIDTenderSupply(const char *name, const AliTender *tender
   //
   // named ctor
   //
+  SetProducts(kTrackPID|kTOFCalib, kTrackPID);
 }
 
 //_____________________________________________________
@@ -106,6 +106,7 @@ fRecoPass(0)
   //
   // named ctor
   //
+  SetProducts(kTrackParams|kVertex, kTrackPID);
 }
 
 //_____________________________________________________
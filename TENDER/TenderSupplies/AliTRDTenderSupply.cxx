@@ -123,6 +123,7 @@ AliTRDTenderSupply::AliTRDTenderSupply(const char *name, const AliTender *tender
   //
   memset(fSlicesForPID, 0, sizeof(UInt_t) * 2);
   memset(fBadChamberID, 0, sizeof(Int_t) * kNChambers);
+  SetProducts(kTrackParams, kTrackPID);
 }
 
 //_____________________________________________________
@@ -55,6 +55,7 @@ AliTrackFixTenderSupply::AliTrackFixTenderSupply(const char *name, const AliTend
 {
   // named ctor
   //
+  SetProducts(0, kTrackParams);
 }
 
 //_____________________________________________________
@@ -67,6 +67,7 @@ AliVZEROTenderSupply::AliVZEROTenderSupply(const char *name, const AliTender *te
   //
   // named ctor
   //
+  SetProducts(0, kVZERO);
 }
 
 //_____________________________________________________
@@ -53,6 +53,7 @@ AliVtxTenderSupply::AliVtxTenderSupply(const char *name, const AliTender *tender
   //
   // named ctor
   //
+  SetProducts(kTrackParams, kVertex);
 }
 
 //_____________________________________________________